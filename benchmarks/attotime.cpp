@@ -0,0 +1,121 @@
+#include "benchmark/benchmark_api.h"
+#include "osdcomm.h"
+#include "eminline.h"
+#include <assert.h>
+#include <stdio.h>
+#include "attotime.h"
+
+// a spread of times covering sub-second, multi-second and never values
+static const attotime s_times[8] =
+{
+	attotime(0, ATTOSECONDS_PER_SECOND / 3),
+	attotime(1, ATTOSECONDS_PER_SECOND / 7),
+	attotime(0, 16666666666666666LL),
+	attotime(12, 999999999999999999LL),
+	attotime(0, 1),
+	attotime(3, 500000000000000000LL),
+	attotime(0, 279365079365LL),
+	attotime::never
+};
+
+static void BM_attotime_add(benchmark::State& state) {
+	attotime sum = attotime::zero;
+	int index = 0;
+	while (state.KeepRunning()) {
+		sum += s_times[index++ & 7];
+		if (sum.seconds() > 1000)
+			sum = attotime::zero;
+	}
+	benchmark::DoNotOptimize(sum);
+}
+BENCHMARK(BM_attotime_add);
+
+static void BM_attotime_subtract(benchmark::State& state) {
+	attotime diff = attotime(100000, 0);
+	int index = 0;
+	while (state.KeepRunning()) {
+		diff = diff - s_times[index++ & 7];
+		if (diff.seconds() < 0 || diff.is_never())
+			diff = attotime(100000, 0);
+	}
+	benchmark::DoNotOptimize(diff);
+}
+BENCHMARK(BM_attotime_subtract);
+
+static void BM_attotime_compare(benchmark::State& state) {
+	int count = 0;
+	int index = 0;
+	while (state.KeepRunning()) {
+		count += (s_times[index & 7] < s_times[(index + 3) & 7]);
+		index++;
+	}
+	benchmark::DoNotOptimize(count);
+}
+BENCHMARK(BM_attotime_compare);
+
+static void BM_attotime_multiply(benchmark::State& state) {
+	UINT32 factor = 1;
+	int index = 0;
+	attotime result;
+	while (state.KeepRunning()) {
+		result = s_times[index++ & 7] * factor;
+		factor = (factor * 7) & 0xffff;
+		benchmark::DoNotOptimize(result);
+	}
+}
+BENCHMARK(BM_attotime_multiply);
+
+static void BM_attotime_divide(benchmark::State& state) {
+	UINT32 factor = 1;
+	int index = 0;
+	attotime result;
+	while (state.KeepRunning()) {
+		result = s_times[index++ & 7] / factor;
+		factor = (factor * 7) & 0xffff;
+		benchmark::DoNotOptimize(result);
+	}
+}
+BENCHMARK(BM_attotime_divide);
+
+static void BM_attotime_as_ticks(benchmark::State& state) {
+	UINT64 total = 0;
+	int index = 0;
+	while (state.KeepRunning())
+		total += s_times[index++ & 7].as_ticks(33868800);
+	benchmark::DoNotOptimize(total);
+}
+BENCHMARK(BM_attotime_as_ticks);
+
+static void BM_attotime_from_ticks(benchmark::State& state) {
+	UINT64 ticks = 1;
+	attotime result;
+	while (state.KeepRunning()) {
+		result = attotime::from_ticks(ticks, 33868800);
+		ticks = ticks * 3 + 1;
+		if (ticks > 33868800ULL * 1000)
+			ticks = 1;
+		benchmark::DoNotOptimize(result);
+	}
+}
+BENCHMARK(BM_attotime_from_ticks);
+
+// the inner loop of device_scheduler::timeslice: compare against a target,
+// advance a local time by a cycle count and clamp the target
+static void BM_attotime_timeslice(benchmark::State& state) {
+	const attoseconds_t attoseconds_per_cycle = HZ_TO_ATTOSECONDS(33868800);
+	attotime localtime = attotime::zero;
+	attotime basetime = attotime::zero;
+	UINT32 ran = 1;
+	while (state.KeepRunning()) {
+		attotime target = basetime + attotime(0, ATTOSECONDS_PER_SECOND / 60 / 4);
+		if (target >= localtime) {
+			localtime += attotime(0, attoseconds_per_cycle * ran);
+			if (localtime < target)
+				target = max(localtime, basetime);
+		}
+		basetime = target;
+		ran = (ran * 5 + 1) & 0xffff;
+	}
+	benchmark::DoNotOptimize(basetime);
+}
+BENCHMARK(BM_attotime_timeslice);
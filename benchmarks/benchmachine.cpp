@@ -0,0 +1,36 @@
+#include "benchmachine.h"
+#include "drivenum.h"
+#include "xmlfile.h"
+
+GAME_EXTERN(benchdrc);
+GAME_EXTERN(benchmem);
+GAME_EXTERN(benchmips3);
+GAME_EXTERN(benchtimer);
+
+// the benchmark binary's driver list, normally generated by makelist.py; keep
+// it sorted by name
+const game_driver * const driver_list::s_drivers_sorted[4] =
+{
+	&GAME_NAME(benchdrc),
+	&GAME_NAME(benchmem),
+	&GAME_NAME(benchmips3),
+	&GAME_NAME(benchtimer)
+};
+
+int driver_list::s_driver_count = 4;
+
+// the benchmark binary stands alone, with no frontend
+int emulator_info::start_frontend(emu_options &options, osd_interface &osd, int argc, char *argv[]) { return 0; }
+const char * emulator_info::get_bare_build_version() { return nullptr; }
+const char * emulator_info::get_build_version() { return nullptr; }
+void emulator_info::display_ui_chooser(running_machine& machine) { }
+void emulator_info::draw_user_interface(running_machine& machine) { }
+void emulator_info::periodic_check() { }
+bool emulator_info::frame_hook() { return false; }
+void emulator_info::layout_file_cb(xml_data_node &layout) { }
+const char * emulator_info::get_appname() { return nullptr; }
+const char * emulator_info::get_appname_lower() { return "benchmarks"; }
+const char * emulator_info::get_configname() { return nullptr; }
+const char * emulator_info::get_copyright() { return nullptr; }
+const char * emulator_info::get_copyright_info() { return nullptr; }
+bool emulator_info::standalone() { return true; }
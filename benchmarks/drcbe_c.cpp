@@ -0,0 +1,134 @@
+#include "benchmark/benchmark_api.h"
+#include "benchmachine.h"
+#include "cpu/drcuml.h"
+#include <functional>
+
+using namespace uml;
+
+// Runs UML loops through drcbe_c.  The ALU loop is made of instructions
+// that get threaded handlers (MOV, ADD, SUB, AND, OR, XOR, the shifts,
+// ROLAND, ROLINS and JMP) with register, memory and immediate operands,
+// with and without flags.  The mixed loop adds instructions that stay on
+// the opcode switch (LOAD, STORE, MULU, conditional MOV), so it also shows
+// what falling back costs.  Items are UML instructions executed.
+
+static const int LOOP_COUNT = 10000;
+
+
+//-------------------------------------------------
+//  a machine with nothing but the root device
+//-------------------------------------------------
+
+static MACHINE_CONFIG_START( bench_drc, driver_device )
+MACHINE_CONFIG_END
+
+ROM_START( benchdrc )
+ROM_END
+
+GAME( 2016, benchdrc, 0, bench_drc, 0, driver_device, 0, ROT0, "MAME", "C back-end benchmark", MACHINE_NO_SOUND_HW )
+
+
+//-------------------------------------------------
+//  a loop block on drcbe_c
+//-------------------------------------------------
+
+struct bench_block
+{
+	bench_block()
+		: m_machine(GAME_NAME(benchdrc)),
+			m_cache(4 * 1024 * 1024),
+			m_drcuml(init_options(m_machine), m_cache, 0, 1, 32, 0),
+			m_data(reinterpret_cast<UINT64 *>(m_cache.alloc(sizeof(UINT64) * 64))),
+			m_entry(*m_drcuml.handle_alloc("entry"))
+	{
+		memset(m_data, 0, sizeof(UINT64) * 64);
+		m_drcuml.reset();
+	}
+
+	// generate() needs drcbe_c, which is chosen when drcuml_state is built
+	static device_t &init_options(bench_machine &machine)
+	{
+		std::string error;
+		machine.m_options.set_value(OPTION_DRC_USE_C, 1, OPTION_PRIORITY_CMDLINE, error);
+		return machine.m_machine.root_device();
+	}
+
+	parameter mem(int index) { return parameter::make_memory(&m_data[index]); }
+
+	// wrap the body in a counted loop; returns the instructions per pass
+	int build(std::function<int (drcuml_block &)> body)
+	{
+		drcuml_block &block = *m_drcuml.begin_block(256);
+		block.append().handle(m_entry);
+		block.append().mov(I0, LOOP_COUNT);
+		block.append().label(1);
+		int const count = body(block);
+		block.append().sub(I0, I0, 1);
+		block.append().jmp(COND_NZ, 1);
+		block.append().exit(0);
+		block.end();
+		return count + 2;
+	}
+
+	void run(benchmark::State &state, int count)
+	{
+		while (state.KeepRunning())
+			m_drcuml.execute(m_entry);
+		state.SetItemsProcessed(state.iterations() * LOOP_COUNT * count);
+	}
+
+	bench_machine   m_machine;
+	drc_cache       m_cache;
+	drcuml_state    m_drcuml;
+	UINT64 *        m_data;
+	code_handle &   m_entry;
+};
+
+
+//-------------------------------------------------
+//  benchmarks
+//-------------------------------------------------
+
+static void BM_drcbe_c_alu(benchmark::State& state)
+{
+	bench_block bench;
+	int const count = bench.build([&bench](drcuml_block &block) {
+		block.append().add(I1, I1, I2);
+		block.append()._and(I3, I1, 0x00ff00ff);
+		block.append()._xor(I4, I4, I3);
+		block.append().shl(I5, I4, 3);
+		block.append()._or(bench.mem(0), bench.mem(0), I5);
+		block.append().sub(I2, I2, bench.mem(1));
+		block.append().dadd(I6, I6, I1);
+		block.append().dshr(I7, I6, 7);
+		block.append().roland(I8, I1, 8, 0xff);
+		block.append().rolins(I9, I8, 4, 0xf0);
+		block.append().mov(bench.mem(2), I9);
+		block.append().sar(I9, I9, 1);
+		block.append().mov(I3, I1);
+		block.append().dmov(I4, I7);
+		return 14;
+	});
+	bench.run(state, count);
+}
+
+static void BM_drcbe_c_mixed(benchmark::State& state)
+{
+	bench_block bench;
+	int const count = bench.build([&bench](drcuml_block &block) {
+		block.append().add(I1, I1, 0x12345);
+		block.append()._and(I3, I1, 0x3f);
+		block.append().load(I4, bench.m_data, I3, SIZE_DWORD, SCALE_x4);
+		block.append().mulu(I5, I5, I4, I1);
+		block.append()._xor(I6, I6, I5);
+		block.append().store(bench.m_data, I3, I6, SIZE_DWORD, SCALE_x4);
+		block.append().cmp(I6, I4);
+		block.append().mov(COND_A, I7, I6);
+		block.append().dadd(I8, I8, I7);
+		return 9;
+	});
+	bench.run(state, count);
+}
+
+BENCHMARK(BM_drcbe_c_alu);
+BENCHMARK(BM_drcbe_c_mixed);
@@ -1,13 +1,7 @@
 #include "benchmark/benchmark_api.h"
-#include <time.h>
 #include "osdcore.h"
 #include "osdcomm.h"
 #define MAME_NOASM 1
-osd_ticks_t osd_ticks(void)
-{
-	// use the standard library clock function
-	return clock();
-}
 #include "eminline.h"
 
 static void BM_count_leading_zeros_noasm(benchmark::State& state) {
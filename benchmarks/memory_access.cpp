@@ -0,0 +1,178 @@
+#include "benchmark/benchmark_api.h"
+#include "benchmachine.h"
+#include "machine/bankdev.h"
+
+// Streams data accesses through real address_space objects mapping 64KB of
+// RAM, one per data width and endianness.  The dispatch path is the
+// previous one: a virtual call into address_space_specific, which walks the
+// lookup table and shifts/masks subunits out of the native word.  The
+// inline path is the current one: read_byte() and friends check the cached
+// RAM range and only misses take the virtual call.
+// Each iteration streams 1e8 accesses over the RAM.
+
+static const int ACCESSES_PER_ITERATION = 100000000;
+static const offs_t RAM_BYTES = 0x10000;
+
+
+//-------------------------------------------------
+//  a machine with nothing but RAM spaces
+//-------------------------------------------------
+
+static ADDRESS_MAP_START( bench_map8, AS_PROGRAM, 8, address_map_bank_device )
+	AM_RANGE(0x0000, 0xffff) AM_RAM
+ADDRESS_MAP_END
+
+static ADDRESS_MAP_START( bench_map16, AS_PROGRAM, 16, address_map_bank_device )
+	AM_RANGE(0x0000, 0xffff) AM_RAM
+ADDRESS_MAP_END
+
+static ADDRESS_MAP_START( bench_map32, AS_PROGRAM, 32, address_map_bank_device )
+	AM_RANGE(0x0000, 0xffff) AM_RAM
+ADDRESS_MAP_END
+
+static ADDRESS_MAP_START( bench_map64, AS_PROGRAM, 64, address_map_bank_device )
+	AM_RANGE(0x0000, 0xffff) AM_RAM
+ADDRESS_MAP_END
+
+#define MCFG_BENCH_SPACE_ADD(_tag, _map, _endianness, _width) \
+	MCFG_DEVICE_ADD(_tag, ADDRESS_MAP_BANK, 0) \
+	MCFG_DEVICE_PROGRAM_MAP(_map) \
+	MCFG_ADDRESS_MAP_BANK_ENDIANNESS(_endianness) \
+	MCFG_ADDRESS_MAP_BANK_DATABUS_WIDTH(_width) \
+	MCFG_ADDRESS_MAP_BANK_ADDRBUS_WIDTH(16)
+
+static MACHINE_CONFIG_START( bench_memory, driver_device )
+	MCFG_BENCH_SPACE_ADD("le8", bench_map8, ENDIANNESS_LITTLE, 8)
+	MCFG_BENCH_SPACE_ADD("be8", bench_map8, ENDIANNESS_BIG, 8)
+	MCFG_BENCH_SPACE_ADD("le16", bench_map16, ENDIANNESS_LITTLE, 16)
+	MCFG_BENCH_SPACE_ADD("be16", bench_map16, ENDIANNESS_BIG, 16)
+	MCFG_BENCH_SPACE_ADD("le32", bench_map32, ENDIANNESS_LITTLE, 32)
+	MCFG_BENCH_SPACE_ADD("be32", bench_map32, ENDIANNESS_BIG, 32)
+	MCFG_BENCH_SPACE_ADD("le64", bench_map64, ENDIANNESS_LITTLE, 64)
+	MCFG_BENCH_SPACE_ADD("be64", bench_map64, ENDIANNESS_BIG, 64)
+MACHINE_CONFIG_END
+
+ROM_START( benchmem )
+ROM_END
+
+GAME( 2016, benchmem, 0, bench_memory, 0, driver_device, 0, ROT0, "MAME", "Memory access benchmark", MACHINE_NO_SOUND_HW )
+
+static running_machine &bench_get_machine()
+{
+	static bench_machine machine(GAME_NAME(benchmem));
+	return machine.m_machine;
+}
+
+template<typename _NativeType, endianness_t _Endian>
+static address_space &bench_space()
+{
+	std::string tag = string_format("%s%d", (_Endian == ENDIANNESS_LITTLE) ? "le" : "be", int(8 * sizeof(_NativeType)));
+	address_space &space = bench_get_machine().root_device().subdevice(tag.c_str())->memory().space(AS_PROGRAM);
+	for (offs_t index = 0; index < RAM_BYTES; index++)
+		space.write_byte(index, index * 0x9d);
+	return space;
+}
+
+// reaches the out-of-line accessors the inline ones fall back to
+class bench_dispatch : public address_space
+{
+public:
+	static UINT8 read_byte(address_space &space, offs_t address) { return (space.*&bench_dispatch::read_byte_dispatch)(address); }
+	static UINT16 read_word(address_space &space, offs_t address) { return (space.*&bench_dispatch::read_word_dispatch)(address); }
+	static UINT32 read_dword(address_space &space, offs_t address) { return (space.*&bench_dispatch::read_dword_dispatch)(address); }
+	static UINT64 read_qword(address_space &space, offs_t address) { return (space.*&bench_dispatch::read_qword_dispatch)(address); }
+};
+
+
+//-------------------------------------------------
+//  streaming benchmarks
+//-------------------------------------------------
+
+template<typename _NativeType>
+static _NativeType read_native_dispatch(address_space &space, offs_t address)
+{
+	if (sizeof(_NativeType) == 1) return bench_dispatch::read_byte(space, address);
+	if (sizeof(_NativeType) == 2) return bench_dispatch::read_word(space, address);
+	if (sizeof(_NativeType) == 4) return bench_dispatch::read_dword(space, address);
+	return bench_dispatch::read_qword(space, address);
+}
+
+template<typename _NativeType>
+static _NativeType read_native_inline(address_space &space, offs_t address)
+{
+	if (sizeof(_NativeType) == 1) return space.read_byte(address);
+	if (sizeof(_NativeType) == 2) return space.read_word(address);
+	if (sizeof(_NativeType) == 4) return space.read_dword(address);
+	return space.read_qword(address);
+}
+
+template<typename _NativeType, endianness_t _Endian>
+static void BM_read_byte_dispatch(benchmark::State& state)
+{
+	address_space &space = bench_space<_NativeType, _Endian>();
+	while (state.KeepRunning())
+	{
+		UINT32 sum = 0;
+		for (int count = 0; count < ACCESSES_PER_ITERATION; count++)
+			sum += bench_dispatch::read_byte(space, count & (RAM_BYTES - 1));
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * ACCESSES_PER_ITERATION);
+}
+
+template<typename _NativeType, endianness_t _Endian>
+static void BM_read_byte_inline(benchmark::State& state)
+{
+	address_space &space = bench_space<_NativeType, _Endian>();
+	while (state.KeepRunning())
+	{
+		UINT32 sum = 0;
+		for (int count = 0; count < ACCESSES_PER_ITERATION; count++)
+			sum += space.read_byte(count & (RAM_BYTES - 1));
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * ACCESSES_PER_ITERATION);
+}
+
+template<typename _NativeType, endianness_t _Endian>
+static void BM_read_native_dispatch(benchmark::State& state)
+{
+	address_space &space = bench_space<_NativeType, _Endian>();
+	while (state.KeepRunning())
+	{
+		_NativeType sum = 0;
+		for (int count = 0; count < ACCESSES_PER_ITERATION; count++)
+			sum += read_native_dispatch<_NativeType>(space, (count * sizeof(_NativeType)) & (RAM_BYTES - 1));
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * ACCESSES_PER_ITERATION);
+}
+
+template<typename _NativeType, endianness_t _Endian>
+static void BM_read_native_inline(benchmark::State& state)
+{
+	address_space &space = bench_space<_NativeType, _Endian>();
+	while (state.KeepRunning())
+	{
+		_NativeType sum = 0;
+		for (int count = 0; count < ACCESSES_PER_ITERATION; count++)
+			sum += read_native_inline<_NativeType>(space, (count * sizeof(_NativeType)) & (RAM_BYTES - 1));
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * ACCESSES_PER_ITERATION);
+}
+
+#define BENCHMARK_SPACE(_Type, _Endian) \
+	BENCHMARK_TEMPLATE2(BM_read_byte_dispatch, _Type, _Endian); \
+	BENCHMARK_TEMPLATE2(BM_read_byte_inline, _Type, _Endian); \
+	BENCHMARK_TEMPLATE2(BM_read_native_dispatch, _Type, _Endian); \
+	BENCHMARK_TEMPLATE2(BM_read_native_inline, _Type, _Endian);
+
+BENCHMARK_SPACE(UINT8,  ENDIANNESS_LITTLE)
+BENCHMARK_SPACE(UINT8,  ENDIANNESS_BIG)
+BENCHMARK_SPACE(UINT16, ENDIANNESS_LITTLE)
+BENCHMARK_SPACE(UINT16, ENDIANNESS_BIG)
+BENCHMARK_SPACE(UINT32, ENDIANNESS_LITTLE)
+BENCHMARK_SPACE(UINT32, ENDIANNESS_BIG)
+BENCHMARK_SPACE(UINT64, ENDIANNESS_LITTLE)
+BENCHMARK_SPACE(UINT64, ENDIANNESS_BIG)
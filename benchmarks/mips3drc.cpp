@@ -0,0 +1,140 @@
+#include "benchmark/benchmark_api.h"
+#include "benchmachine.h"
+#include "cpu/mips/mips3.h"
+
+// Runs small R4600 loops on the MIPS3 recompiler through the scheduler.
+// The core keeps r2-r4 in UML I4-I6 when the back-end has host registers
+// for them, so the loops work on those.  The ALU loop makes no calls out of
+// generated code.  The memory loop also stores and reloads a word through
+// the address space handlers, a call to C code per access; with fastram
+// the same accesses are inlined.  Items are emulated cycles.
+
+static const int SLICES_PER_ITERATION = 10;
+
+
+//-------------------------------------------------
+//  a machine with one R4600 and RAM for code
+//  and data
+//-------------------------------------------------
+
+class bench_r4600_device : public r4600le_device
+{
+public:
+	bench_r4600_device(const machine_config &mconfig, const char *tag, device_t *owner, UINT32 clock)
+		: r4600le_device(mconfig, tag, owner, clock) { }
+
+	using device_t::start;
+};
+
+static const device_type BENCH_R4600 = &device_creator<bench_r4600_device>;
+
+static ADDRESS_MAP_START( bench_map, AS_PROGRAM, 32, driver_device )
+	AM_RANGE(0x00000000, 0x0000ffff) AM_RAM AM_SHARE("data")
+	AM_RANGE(0x1fc00000, 0x1fc0ffff) AM_RAM
+ADDRESS_MAP_END
+
+static MACHINE_CONFIG_START( bench_mips3, driver_device )
+	MCFG_CPU_ADD("maincpu", BENCH_R4600, 100000000)
+	MCFG_MIPS3_ICACHE_SIZE(16384)
+	MCFG_MIPS3_DCACHE_SIZE(16384)
+	MCFG_CPU_PROGRAM_MAP(bench_map)
+MACHINE_CONFIG_END
+
+ROM_START( benchmips3 )
+ROM_END
+
+GAME( 2016, benchmips3, 0, bench_mips3, 0, driver_device, 0, ROT0, "MAME", "MIPS3 recompiler benchmark", MACHINE_NO_SOUND_HW )
+
+
+//-------------------------------------------------
+//  programs, loaded at the reset vector
+//-------------------------------------------------
+
+static const UINT32 s_alu_loop[] =
+{
+	0x3c05a000,                             // lui     r5,$a000
+	0x24020000,                             // li      r2,0
+	0x24030001,                             // li      r3,1
+	0x24040003,                             // li      r4,3
+	0x00431021,                             // addu    r2,r2,r3
+	0x00822026,                             // xor     r4,r4,r2
+	0x00031840,                             // sll     r3,r3,1
+	0x00641821,                             // addu    r3,r3,r4
+	0x1000fffb,                             // b       $bfc00010
+	0x00000000                              // nop
+};
+
+static const UINT32 s_memory_loop[] =
+{
+	0x3c05a000,                             // lui     r5,$a000
+	0x24020000,                             // li      r2,0
+	0x24030001,                             // li      r3,1
+	0x24040003,                             // li      r4,3
+	0x00431021,                             // addu    r2,r2,r3
+	0x00822026,                             // xor     r4,r4,r2
+	0xaca20000,                             // sw      r2,0(r5)
+	0x00031840,                             // sll     r3,r3,1
+	0x8ca60000,                             // lw      r6,0(r5)
+	0x00661821,                             // addu    r3,r3,r6
+	0x1000fff9,                             // b       $bfc00010
+	0x00000000                              // nop
+};
+
+struct bench_mips3_machine
+{
+	template<int N>
+	bench_mips3_machine(const UINT32 (&program)[N], bool fastram)
+		: m_machine(GAME_NAME(benchmips3)),
+			m_cpu(downcast<bench_r4600_device &>(*m_machine.m_machine.root_device().subdevice("maincpu")))
+	{
+		address_space &space = m_cpu.space(AS_PROGRAM);
+		for (int index = 0; index < N; index++)
+			space.write_dword(0x1fc00000 + index * 4, program[index]);
+
+		// a periodic timer ends each timeslice
+		m_machine.m_machine.scheduler().timer_alloc(timer_expired_delegate())->adjust(attotime::from_msec(1), 0, attotime::from_msec(1));
+		m_cpu.start();
+		if (fastram)
+			m_cpu.add_fastram(0x00000000, 0x0000ffff, FALSE, m_machine.m_machine.root_device().memshare("data")->ptr());
+		m_cpu.reset();
+	}
+
+	void run(benchmark::State &state)
+	{
+		UINT64 const start = m_cpu.total_cycles();
+		while (state.KeepRunning())
+			for (int slice = 0; slice < SLICES_PER_ITERATION; slice++)
+				m_machine.m_machine.scheduler().timeslice();
+		state.SetItemsProcessed(m_cpu.total_cycles() - start);
+	}
+
+	bench_machine           m_machine;
+	bench_r4600_device &    m_cpu;
+};
+
+
+//-------------------------------------------------
+//  benchmarks
+//-------------------------------------------------
+
+static void BM_mips3drc_alu(benchmark::State& state)
+{
+	bench_mips3_machine bench(s_alu_loop, false);
+	bench.run(state);
+}
+
+static void BM_mips3drc_memory(benchmark::State& state)
+{
+	bench_mips3_machine bench(s_memory_loop, false);
+	bench.run(state);
+}
+
+static void BM_mips3drc_fastram(benchmark::State& state)
+{
+	bench_mips3_machine bench(s_memory_loop, true);
+	bench.run(state);
+}
+
+BENCHMARK(BM_mips3drc_alu);
+BENCHMARK(BM_mips3drc_memory);
+BENCHMARK(BM_mips3drc_fastram);
@@ -0,0 +1,140 @@
+#include "benchmark/benchmark_api.h"
+#include "benchmachine.h"
+#include <vector>
+
+// Keeps N live timers and re-adjusts one of them to a pseudo-random future
+// expiration time per step.  The sorted linked list models the scheduler's
+// previous implementation; the current one is measured through
+// emu_timer::adjust() on a device_scheduler with nothing else running.
+
+struct bench_timer
+{
+	bench_timer *   m_next;
+	bench_timer *   m_prev;
+	UINT64          m_expire;
+};
+
+static inline UINT64 next_random(UINT64 &seed)
+{
+	seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+	return seed >> 33;
+}
+
+
+//-------------------------------------------------
+//  sorted linked list
+//-------------------------------------------------
+
+struct timer_list
+{
+	bench_timer *m_head = nullptr;
+
+	void insert(bench_timer &timer)
+	{
+		bench_timer *prev = nullptr;
+		for (bench_timer *cur = m_head; cur != nullptr; prev = cur, cur = cur->m_next)
+			if (cur->m_expire > timer.m_expire)
+			{
+				timer.m_prev = cur->m_prev;
+				timer.m_next = cur;
+				if (cur->m_prev != nullptr)
+					cur->m_prev->m_next = &timer;
+				else
+					m_head = &timer;
+				cur->m_prev = &timer;
+				return;
+			}
+		if (prev != nullptr)
+			prev->m_next = &timer;
+		else
+			m_head = &timer;
+		timer.m_prev = prev;
+		timer.m_next = nullptr;
+	}
+
+	void remove(bench_timer &timer)
+	{
+		if (timer.m_prev != nullptr)
+			timer.m_prev->m_next = timer.m_next;
+		else
+			m_head = timer.m_next;
+		if (timer.m_next != nullptr)
+			timer.m_next->m_prev = timer.m_prev;
+	}
+
+	void adjust(bench_timer &timer, UINT64 expire)
+	{
+		remove(timer);
+		timer.m_expire = expire;
+		insert(timer);
+	}
+};
+
+
+//-------------------------------------------------
+//  a machine with nothing but the scheduler
+//-------------------------------------------------
+
+static MACHINE_CONFIG_START( bench_timer, driver_device )
+MACHINE_CONFIG_END
+
+ROM_START( benchtimer )
+ROM_END
+
+GAME( 2016, benchtimer, 0, bench_timer, 0, driver_device, 0, ROT0, "MAME", "Timer queue benchmark", MACHINE_NO_SOUND_HW )
+
+
+//-------------------------------------------------
+//  benchmarks
+//-------------------------------------------------
+
+static void BM_timer_adjust_list(benchmark::State& state)
+{
+	const int count = state.range_x();
+	std::vector<bench_timer> timers(count);
+	timer_list queue;
+	UINT64 seed = 1;
+	for (bench_timer &timer : timers)
+	{
+		timer.m_expire = next_random(seed);
+		queue.insert(timer);
+	}
+
+	UINT64 now = 0;
+	while (state.KeepRunning())
+	{
+		bench_timer &timer = timers[next_random(seed) % count];
+		queue.adjust(timer, now + next_random(seed));
+		now++;
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_timer_adjust_scheduler(benchmark::State& state)
+{
+	// timers are only freed with the scheduler, so each run gets a new machine
+	const int count = state.range_x();
+	bench_machine machine(GAME_NAME(benchtimer));
+	device_scheduler &scheduler = machine.m_machine.scheduler();
+	std::vector<emu_timer *> timers(count);
+	UINT64 seed = 1;
+	for (emu_timer *&timer : timers)
+	{
+		timer = scheduler.timer_alloc(timer_expired_delegate());
+		timer->adjust(attotime(0, next_random(seed)));
+	}
+
+	// machine time stands still, so adding the step count to the delay
+	// gives the same expiration times as the list
+	UINT64 now = 0;
+	while (state.KeepRunning())
+	{
+		emu_timer &timer = *timers[next_random(seed) % count];
+		timer.adjust(attotime(0, now + next_random(seed)));
+		now++;
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_timer_adjust_list)->Range(16, 1024);
+BENCHMARK(BM_timer_adjust_scheduler)->Range(16, 1024);
@@ -248,6 +248,11 @@ newoption {
 	description = "Force DRC C backend.",
 }
 
+newoption {
+	trigger = "ARM64_DRC",
+	description = "Build the arm64 DRC backend and use it on arm64 targets (not yet run on hardware).",
+}
+
 newoption {
 	trigger = "NOWERROR",
 	description = "NOWERROR",
@@ -663,6 +668,11 @@ if not _OPTIONS["FORCE_DRC_C_BACKEND"] then
 				"NATIVE_DRC=drcbe_x86",
 			}
 		configuration {  }
+		if _OPTIONS["PLATFORM"]=="arm64" and _OPTIONS["ARM64_DRC"]=="1" then
+			defines {
+				"NATIVE_DRC=drcbe_arm64",
+			}
+		end
 	end
 end
 
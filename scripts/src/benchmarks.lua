@@ -59,16 +59,61 @@ project("benchmarks")
 
 	links {
 		"benchmark",
+		"emu",
+		"utils",
+		ext_lib("expat"),
+		"7z",
+		ext_lib("zlib"),
+		ext_lib("flac"),
+		"softfloat",
+		"osd_" .. _OPTIONS["osd"],
+		"ocore_" .. _OPTIONS["osd"],
 	}
 
 	includedirs {
 		MAME_DIR .. "3rdparty/benchmark/include",
 		MAME_DIR .. "src/osd",
+		MAME_DIR .. "src/emu",
+		MAME_DIR .. "src/devices",
+		MAME_DIR .. "src/lib",
+		MAME_DIR .. "src/lib/util",
+		MAME_DIR .. "3rdparty",
+		ext_includedir("expat"),
+		ext_includedir("zlib"),
 	}
 
 	files {
 		MAME_DIR .. "benchmarks/main.cpp",
+		MAME_DIR .. "benchmarks/benchmachine.cpp",
 		MAME_DIR .. "benchmarks/eminline_native.cpp",
 		MAME_DIR .. "benchmarks/eminline_noasm.cpp",
+		MAME_DIR .. "benchmarks/timer_queue.cpp",
+		MAME_DIR .. "benchmarks/attotime.cpp",
+		MAME_DIR .. "benchmarks/memory_access.cpp",
+		MAME_DIR .. "benchmarks/drcbe_c.cpp",
+		MAME_DIR .. "benchmarks/mips3drc.cpp",
+		MAME_DIR .. "src/devices/machine/bankdev.cpp",
+		MAME_DIR .. "src/devices/cpu/drcbec.cpp",
+		MAME_DIR .. "src/devices/cpu/drcbeut.cpp",
+		MAME_DIR .. "src/devices/cpu/drccache.cpp",
+		MAME_DIR .. "src/devices/cpu/drcuml.cpp",
+		MAME_DIR .. "src/devices/cpu/drcumlopt.cpp",
+		MAME_DIR .. "src/devices/cpu/drcverify.cpp",
+		MAME_DIR .. "src/devices/cpu/uml.cpp",
+		MAME_DIR .. "src/devices/cpu/i386/i386dasm.cpp",
+		MAME_DIR .. "src/devices/cpu/x86log.cpp",
+		MAME_DIR .. "src/devices/cpu/drcbex86.cpp",
+		MAME_DIR .. "src/devices/cpu/drcbex64.cpp",
+		MAME_DIR .. "src/devices/cpu/drcfe.cpp",
+		MAME_DIR .. "src/devices/cpu/mips/mips3com.cpp",
+		MAME_DIR .. "src/devices/cpu/mips/mips3.cpp",
+		MAME_DIR .. "src/devices/cpu/mips/mips3fe.cpp",
+		MAME_DIR .. "src/devices/cpu/mips/mips3drc.cpp",
+		MAME_DIR .. "src/devices/cpu/mips/mips3dsm.cpp",
 	}
 
+	if _OPTIONS["ARM64_DRC"]=="1" then
+		files {
+			MAME_DIR .. "src/devices/cpu/drcbearm64.cpp",
+		}
+	end
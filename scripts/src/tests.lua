@@ -61,17 +61,27 @@ project("mametests")
 
 	links {
 		"gtest",
+		"osd_" .. _OPTIONS["osd"],
+		"emu",
 		"utils",
 		ext_lib("expat"),
+		"softfloat",
+		ext_lib("jpeg"),
+		"7z",
 		ext_lib("zlib"),
+		ext_lib("flac"),
 		"ocore_" .. _OPTIONS["osd"],
 	}
 
 	includedirs {
 		MAME_DIR .. "3rdparty/googletest/googletest/include",
+		MAME_DIR .. "tests/emu",
 		MAME_DIR .. "src/osd",
 		MAME_DIR .. "src/emu",
+		MAME_DIR .. "src/devices",
+		MAME_DIR .. "src/lib",
 		MAME_DIR .. "src/lib/util",
+		MAME_DIR .. "3rdparty",
 		ext_includedir("expat"),
 		ext_includedir("zlib"),
 	}
@@ -80,5 +90,40 @@ project("mametests")
 		MAME_DIR .. "tests/main.cpp",
 		MAME_DIR .. "tests/lib/util/corestr.cpp",
 		MAME_DIR .. "tests/emu/attotime.cpp",
+		MAME_DIR .. "tests/emu/schedule.cpp",
+		MAME_DIR .. "tests/emu/testmachine.cpp",
+		MAME_DIR .. "tests/devices/cpu/drcumlopt.cpp",
+		MAME_DIR .. "tests/devices/cpu/drcbe.cpp",
+		MAME_DIR .. "tests/devices/cpu/m68kdrc.cpp",
+		MAME_DIR .. "tests/devices/cpu/arm7drc.cpp",
+		MAME_DIR .. "src/devices/cpu/drcbec.cpp",
+		MAME_DIR .. "src/devices/cpu/drcbeut.cpp",
+		MAME_DIR .. "src/devices/cpu/drccache.cpp",
+		MAME_DIR .. "src/devices/cpu/drcfe.cpp",
+		MAME_DIR .. "src/devices/cpu/drcuml.cpp",
+		MAME_DIR .. "src/devices/cpu/drcumlopt.cpp",
+		MAME_DIR .. "src/devices/cpu/drcverify.cpp",
+		MAME_DIR .. "src/devices/cpu/uml.cpp",
+		MAME_DIR .. "src/devices/cpu/i386/i386dasm.cpp",
+		MAME_DIR .. "src/devices/cpu/x86log.cpp",
+		MAME_DIR .. "src/devices/cpu/drcbex86.cpp",
+		MAME_DIR .. "src/devices/cpu/drcbex64.cpp",
+		MAME_DIR .. "src/devices/cpu/m68000/m68kcpu.cpp",
+		MAME_DIR .. "src/devices/cpu/m68000/m68kdrc.cpp",
+		MAME_DIR .. "src/devices/cpu/m68000/m68kfe.cpp",
+		MAME_DIR .. "src/devices/cpu/m68000/m68kops.cpp",
+		MAME_DIR .. "src/devices/cpu/m68000/m68kdasm.cpp",
+		MAME_DIR .. "src/devices/cpu/arm7/arm7.cpp",
+		MAME_DIR .. "src/devices/cpu/arm7/arm7thmb.cpp",
+		MAME_DIR .. "src/devices/cpu/arm7/arm7ops.cpp",
+		MAME_DIR .. "src/devices/cpu/arm7/arm7fe.cpp",
+		MAME_DIR .. "src/devices/cpu/arm7/arm7dasm.cpp",
+		MAME_DIR .. "src/devices/machine/bankdev.cpp",
 	}
 
+	if _OPTIONS["ARM64_DRC"]=="1" then
+		files {
+			MAME_DIR .. "src/devices/cpu/drcbearm64.cpp",
+		}
+	end
+
@@ -437,6 +437,43 @@ configuration { }
 
 strip()
 
+--------------------------------------------------
+-- memtrace
+--------------------------------------------------
+
+project("memtrace")
+uuid ("fe356690-890f-43e2-bd18-639645b283f5")
+kind "ConsoleApp"
+
+flags {
+	"Symbols", -- always include minimum symbols for executables
+}
+
+if _OPTIONS["SEPARATE_BIN"]~="1" then
+	targetdir(MAME_DIR)
+end
+
+links {
+	"utils",
+	"ocore_" .. _OPTIONS["osd"],
+}
+
+includedirs {
+	MAME_DIR .. "src/osd",
+	MAME_DIR .. "src/lib/util",
+}
+
+files {
+	MAME_DIR .. "src/tools/memtrace.cpp",
+}
+
+configuration { "mingw*" or "vs*" }
+	targetextension ".exe"
+
+configuration { }
+
+strip()
+
 --------------------------------------------------
 -- pngcmp
 --------------------------------------------------
@@ -0,0 +1,646 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    arm64emit.h
+
+    Generic AArch64 code emitters.
+
+****************************************************************************
+
+    Every instruction is a single 32-bit word, so the emitters here only
+    assemble the fields; it is up to the caller to make sure immediates
+    fit (see the is_*_immediate helpers) and to keep the instruction
+    cache coherent once code has been written.
+
+    Register number 31 is either the zero register or the stack pointer
+    depending on the instruction; REG_ZR and REG_SP are both provided so
+    the intent is clear at the call site.
+
+***************************************************************************/
+
+#pragma once
+
+#ifndef __ARM64EMIT_H__
+#define __ARM64EMIT_H__
+
+
+// put emitters into their own namespace so they don't clash
+namespace arm64emit
+{
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// use arm64code * to reference generated code
+typedef UINT32      arm64code;
+
+// this structure tracks information about a forward branch
+struct arm64_link
+{
+	arm64code *     target;
+};
+
+
+
+//**************************************************************************
+//  CONSTANTS
+//**************************************************************************
+
+// general purpose registers
+const UINT8 REG_X0          = 0;
+const UINT8 REG_X1          = 1;
+const UINT8 REG_X2          = 2;
+const UINT8 REG_X3          = 3;
+const UINT8 REG_X4          = 4;
+const UINT8 REG_X5          = 5;
+const UINT8 REG_X6          = 6;
+const UINT8 REG_X7          = 7;
+const UINT8 REG_X8          = 8;
+const UINT8 REG_X9          = 9;
+const UINT8 REG_X10         = 10;
+const UINT8 REG_X11         = 11;
+const UINT8 REG_X12         = 12;
+const UINT8 REG_X13         = 13;
+const UINT8 REG_X14         = 14;
+const UINT8 REG_X15         = 15;
+const UINT8 REG_X16         = 16;
+const UINT8 REG_X17         = 17;
+const UINT8 REG_X18         = 18;
+const UINT8 REG_X19         = 19;
+const UINT8 REG_X20         = 20;
+const UINT8 REG_X21         = 21;
+const UINT8 REG_X22         = 22;
+const UINT8 REG_X23         = 23;
+const UINT8 REG_X24         = 24;
+const UINT8 REG_X25         = 25;
+const UINT8 REG_X26         = 26;
+const UINT8 REG_X27         = 27;
+const UINT8 REG_X28         = 28;
+const UINT8 REG_FP          = 29;
+const UINT8 REG_LR          = 30;
+const UINT8 REG_ZR          = 31;
+const UINT8 REG_SP          = 31;
+
+const int REG_MAX           = 32;
+
+// floating point/SIMD registers
+const UINT8 REG_D0          = 0;
+const UINT8 REG_D1          = 1;
+const UINT8 REG_D2          = 2;
+const UINT8 REG_D3          = 3;
+const UINT8 REG_D4          = 4;
+const UINT8 REG_D5          = 5;
+const UINT8 REG_D6          = 6;
+const UINT8 REG_D7          = 7;
+const UINT8 REG_D8          = 8;
+const UINT8 REG_D9          = 9;
+const UINT8 REG_D10         = 10;
+const UINT8 REG_D11         = 11;
+const UINT8 REG_D12         = 12;
+const UINT8 REG_D13         = 13;
+const UINT8 REG_D14         = 14;
+const UINT8 REG_D15         = 15;
+const UINT8 REG_D16         = 16;
+const UINT8 REG_D17         = 17;
+const UINT8 REG_D18         = 18;
+
+// condition codes
+const UINT8 COND_EQ         = 0x0;
+const UINT8 COND_NE         = 0x1;
+const UINT8 COND_CS         = 0x2;
+const UINT8 COND_CC         = 0x3;
+const UINT8 COND_MI         = 0x4;
+const UINT8 COND_PL         = 0x5;
+const UINT8 COND_VS         = 0x6;
+const UINT8 COND_VC         = 0x7;
+const UINT8 COND_HI         = 0x8;
+const UINT8 COND_LS         = 0x9;
+const UINT8 COND_GE         = 0xa;
+const UINT8 COND_LT         = 0xb;
+const UINT8 COND_GT         = 0xc;
+const UINT8 COND_LE         = 0xd;
+const UINT8 COND_AL         = 0xe;
+
+// shift types for shifted register operands
+const UINT8 SHIFT_LSL       = 0;
+const UINT8 SHIFT_LSR       = 1;
+const UINT8 SHIFT_ASR       = 2;
+const UINT8 SHIFT_ROR       = 3;
+
+// extend types for extended register operands
+const UINT8 EXTEND_UXTB     = 0;
+const UINT8 EXTEND_UXTH     = 1;
+const UINT8 EXTEND_UXTW     = 2;
+const UINT8 EXTEND_UXTX     = 3;
+const UINT8 EXTEND_SXTB     = 4;
+const UINT8 EXTEND_SXTH     = 5;
+const UINT8 EXTEND_SXTW     = 6;
+const UINT8 EXTEND_SXTX     = 7;
+
+// NZCV bits as seen by MRS/MSR
+const UINT32 NZCV_N         = 0x80000000;
+const UINT32 NZCV_Z         = 0x40000000;
+const UINT32 NZCV_C         = 0x20000000;
+const UINT32 NZCV_V         = 0x10000000;
+
+// FPCR rounding mode field
+const UINT32 FPCR_RMODE_MASK    = 0x00c00000;
+const UINT32 FPCR_RMODE_RN      = 0x00000000;
+const UINT32 FPCR_RMODE_RP      = 0x00400000;
+const UINT32 FPCR_RMODE_RM      = 0x00800000;
+const UINT32 FPCR_RMODE_RZ      = 0x00c00000;
+
+// a nop, for padding patchable sequences
+const UINT32 INSN_NOP       = 0xd503201f;
+
+
+
+//**************************************************************************
+//  IMMEDIATE HELPERS
+//**************************************************************************
+
+//-------------------------------------------------
+//  invert_condition - return the opposite of a
+//  condition code
+//-------------------------------------------------
+
+inline UINT8 invert_condition(UINT8 cond)
+{
+	assert(cond < COND_AL);
+	return cond ^ 1;
+}
+
+
+//-------------------------------------------------
+//  is_arith_immediate - return true if the value
+//  can be encoded by ADD/SUB (12 bits, optionally
+//  shifted left by 12)
+//-------------------------------------------------
+
+inline bool is_arith_immediate(UINT64 value)
+{
+	return (value & ~U64(0xfff)) == 0 || (value & ~U64(0xfff000)) == 0;
+}
+
+
+//-------------------------------------------------
+//  encode_logical_immediate - compute the N:immr:
+//  imms field for a bitmask immediate, returning
+//  false if the value can't be represented
+//-------------------------------------------------
+
+inline bool encode_logical_immediate(UINT64 value, bool is64, UINT32 &encoded)
+{
+	// 32-bit operations see the low word replicated
+	if (!is64)
+		value = (value & 0xffffffff) | (value << 32);
+	if (value == 0 || value == ~U64(0))
+		return false;
+
+	// find the smallest element that repeats across the whole value
+	int size = 64;
+	while (size > 2)
+	{
+		int half = size / 2;
+		UINT64 halfmask = (U64(1) << half) - 1;
+		if ((value & halfmask) != ((value >> half) & halfmask))
+			break;
+		size = half;
+	}
+	UINT64 mask = (size == 64) ? ~U64(0) : ((U64(1) << size) - 1);
+	UINT64 elem = value & mask;
+
+	// the element must be a rotated run of ones
+	int ones = 0;
+	for (UINT64 temp = elem; temp != 0; temp &= temp - 1)
+		ones++;
+	UINT64 run = (U64(1) << ones) - 1;
+	int rotation;
+	for (rotation = 0; rotation < size; rotation++)
+	{
+		UINT64 rotated = (rotation == 0) ? elem : (((elem >> rotation) | (elem << (size - rotation))) & mask);
+		if (rotated == run)
+			break;
+	}
+	if (rotation == size)
+		return false;
+
+	UINT32 immr = (size - rotation) & (size - 1);
+	UINT32 imms = (~(size * 2 - 1) | (ones - 1)) & 0x3f;
+	encoded = ((size == 64) << 12) | (immr << 6) | imms;
+	return true;
+}
+
+
+//-------------------------------------------------
+//  is_logical_immediate - return true if the
+//  value can be encoded as a bitmask immediate
+//-------------------------------------------------
+
+inline bool is_logical_immediate(UINT64 value, bool is64)
+{
+	UINT32 encoded;
+	return encode_logical_immediate(value, is64, encoded);
+}
+
+
+//-------------------------------------------------
+//  is_branch_target - return true if the target
+//  is in range of a B/BL from the given address
+//-------------------------------------------------
+
+inline bool is_branch_target(const arm64code *source, const void *target)
+{
+	INT64 delta = (const UINT8 *)target - (const UINT8 *)source;
+	return (delta >= -(INT64(1) << 27) && delta < (INT64(1) << 27));
+}
+
+
+
+//**************************************************************************
+//  INTEGER DATA PROCESSING
+//**************************************************************************
+
+inline UINT32 sf(bool is64) { return is64 ? 0x80000000 : 0; }
+
+// ADD/SUB/ADDS/SUBS (immediate); 31 is SP for rn, and for rd unless setting flags
+inline void emit_addsub_imm(arm64code *&dst, UINT32 op, bool is64, UINT8 rd, UINT8 rn, UINT32 imm)
+{
+	assert(is_arith_immediate(imm));
+	if ((imm & ~0xfff) != 0)
+		*dst++ = op | sf(is64) | 0x00400000 | ((imm >> 12) << 10) | (rn << 5) | rd;
+	else
+		*dst++ = op | sf(is64) | (imm << 10) | (rn << 5) | rd;
+}
+inline void emit_add_imm(arm64code *&dst, bool is64, UINT8 rd, UINT8 rn, UINT32 imm)  { emit_addsub_imm(dst, 0x11000000, is64, rd, rn, imm); }
+inline void emit_adds_imm(arm64code *&dst, bool is64, UINT8 rd, UINT8 rn, UINT32 imm) { emit_addsub_imm(dst, 0x31000000, is64, rd, rn, imm); }
+inline void emit_sub_imm(arm64code *&dst, bool is64, UINT8 rd, UINT8 rn, UINT32 imm)  { emit_addsub_imm(dst, 0x51000000, is64, rd, rn, imm); }
+inline void emit_subs_imm(arm64code *&dst, bool is64, UINT8 rd, UINT8 rn, UINT32 imm) { emit_addsub_imm(dst, 0x71000000, is64, rd, rn, imm); }
+inline void emit_cmp_imm(arm64code *&dst, bool is64, UINT8 rn, UINT32 imm)             { emit_subs_imm(dst, is64, REG_ZR, rn, imm); }
+
+// ADD/SUB/ADDS/SUBS (shifted register); 31 is ZR
+inline void emit_addsub_reg(arm64code *&dst, UINT32 op, bool is64, UINT8 rd, UINT8 rn, UINT8 rm, UINT8 shift, UINT8 amount)
+{
+	assert(amount < (is64 ? 64 : 32));
+	*dst++ = op | sf(is64) | (shift << 22) | (rm << 16) | (amount << 10) | (rn << 5) | rd;
+}
+inline void emit_add_reg(arm64code *&dst, bool is64, UINT8 rd, UINT8 rn, UINT8 rm, UINT8 shift = SHIFT_LSL, UINT8 amount = 0)  { emit_addsub_reg(dst, 0x0b000000, is64, rd, rn, rm, shift, amount); }
+inline void emit_adds_reg(arm64code *&dst, bool is64, UINT8 rd, UINT8 rn, UINT8 rm, UINT8 shift = SHIFT_LSL, UINT8 amount = 0) { emit_addsub_reg(dst, 0x2b000000, is64, rd, rn, rm, shift, amount); }
+inline void emit_sub_reg(arm64code *&dst, bool is64, UINT8 rd, UINT8 rn, UINT8 rm, UINT8 shift = SHIFT_LSL, UINT8 amount = 0)  { emit_addsub_reg(dst, 0x4b000000, is64, rd, rn, rm, shift, amount); }
+inline void emit_subs_reg(arm64code *&dst, bool is64, UINT8 rd, UINT8 rn, UINT8 rm, UINT8 shift = SHIFT_LSL, UINT8 amount = 0) { emit_addsub_reg(dst, 0x6b000000, is64, rd, rn, rm, shift, amount); }
+inline void emit_cmp_reg(arm64code *&dst, bool is64, UINT8 rn, UINT8 rm, UINT8 shift = SHIFT_LSL, UINT8 amount = 0)             { emit_subs_reg(dst, is64, REG_ZR, rn, rm, shift, amount); }
+inline void emit_neg(arm64code *&dst, bool is64, UINT8 rd, UINT8 rm)                                                                 { emit_sub_reg(dst, is64, rd, REG_ZR, rm); }
+
+// ADD/SUBS (extended register); 31 is SP for rd (ADD only) and rn
+inline void emit_add_ext(arm64code *&dst, bool is64, UINT8 rd, UINT8 rn, UINT8 rm, UINT8 extend, UINT8 amount)
+{
+	assert(amount <= 4);
+	*dst++ = 0x0b200000 | sf(is64) | (rm << 16) | (extend << 13) | (amount << 10) | (rn << 5) | rd;
+}
+inline void emit_cmp_ext(arm64code *&dst, bool is64, UINT8 rn, UINT8 rm, UINT8 extend)
+{
+	*dst++ = 0x6b200000 | sf(is64) | (rm << 16) | (extend << 13) | (rn << 5) | REG_ZR;
+}
+
+// ADC/ADCS/SBC/SBCS
+inline void emit_adc(arm64code *&dst, bool is64, UINT8 rd, UINT8 rn, UINT8 rm)  { *dst++ = 0x1a000000 | sf(is64) | (rm << 16) | (rn << 5) | rd; }
+inline void emit_adcs(arm64code *&dst, bool is64, UINT8 rd, UINT8 rn, UINT8 rm) { *dst++ = 0x3a000000 | sf(is64) | (rm << 16) | (rn << 5) | rd; }
+inline void emit_sbc(arm64code *&dst, bool is64, UINT8 rd, UINT8 rn, UINT8 rm)  { *dst++ = 0x5a000000 | sf(is64) | (rm << 16) | (rn << 5) | rd; }
+inline void emit_sbcs(arm64code *&dst, bool is64, UINT8 rd, UINT8 rn, UINT8 rm) { *dst++ = 0x7a000000 | sf(is64) | (rm << 16) | (rn << 5) | rd; }
+
+// logical (shifted register); 31 is ZR
+inline void emit_logical_reg(arm64code *&dst, UINT32 op, bool is64, UINT8 rd, UINT8 rn, UINT8 rm, UINT8 shift, UINT8 amount)
+{
+	assert(amount < (is64 ? 64 : 32));
+	*dst++ = op | sf(is64) | (shift << 22) | (rm << 16) | (amount << 10) | (rn << 5) | rd;
+}
+inline void emit_and_reg(arm64code *&dst, bool is64, UINT8 rd, UINT8 rn, UINT8 rm, UINT8 shift = SHIFT_LSL, UINT8 amount = 0)  { emit_logical_reg(dst, 0x0a000000, is64, rd, rn, rm, shift, amount); }
+inline void emit_bic_reg(arm64code *&dst, bool is64, UINT8 rd, UINT8 rn, UINT8 rm, UINT8 shift = SHIFT_LSL, UINT8 amount = 0)  { emit_logical_reg(dst, 0x0a200000, is64, rd, rn, rm, shift, amount); }
+inline void emit_orr_reg(arm64code *&dst, bool is64, UINT8 rd, UINT8 rn, UINT8 rm, UINT8 shift = SHIFT_LSL, UINT8 amount = 0)  { emit_logical_reg(dst, 0x2a000000, is64, rd, rn, rm, shift, amount); }
+inline void emit_orn_reg(arm64code *&dst, bool is64, UINT8 rd, UINT8 rn, UINT8 rm, UINT8 shift = SHIFT_LSL, UINT8 amount = 0)  { emit_logical_reg(dst, 0x2a200000, is64, rd, rn, rm, shift, amount); }
+inline void emit_eor_reg(arm64code *&dst, bool is64, UINT8 rd, UINT8 rn, UINT8 rm, UINT8 shift = SHIFT_LSL, UINT8 amount = 0)  { emit_logical_reg(dst, 0x4a000000, is64, rd, rn, rm, shift, amount); }
+inline void emit_ands_reg(arm64code *&dst, bool is64, UINT8 rd, UINT8 rn, UINT8 rm, UINT8 shift = SHIFT_LSL, UINT8 amount = 0) { emit_logical_reg(dst, 0x6a000000, is64, rd, rn, rm, shift, amount); }
+inline void emit_tst_reg(arm64code *&dst, bool is64, UINT8 rn, UINT8 rm)                                                         { emit_ands_reg(dst, is64, REG_ZR, rn, rm); }
+inline void emit_mov_reg(arm64code *&dst, bool is64, UINT8 rd, UINT8 rm)                                                         { emit_orr_reg(dst, is64, rd, REG_ZR, rm); }
+inline void emit_mvn_reg(arm64code *&dst, bool is64, UINT8 rd, UINT8 rm)                                                         { emit_orn_reg(dst, is64, rd, REG_ZR, rm); }
+
+// logical (immediate); 31 is SP for rd unless setting flags, ZR for rn
+inline void emit_logical_imm(arm64code *&dst, UINT32 op, bool is64, UINT8 rd, UINT8 rn, UINT64 imm)
+{
+	UINT32 encoded = 0;
+	bool valid = encode_logical_immediate(imm, is64, encoded);
+	assert(valid);
+	(void)valid;
+	*dst++ = op | sf(is64) | (encoded << 10) | (rn << 5) | rd;
+}
+inline void emit_and_imm(arm64code *&dst, bool is64, UINT8 rd, UINT8 rn, UINT64 imm)  { emit_logical_imm(dst, 0x12000000, is64, rd, rn, imm); }
+inline void emit_orr_imm(arm64code *&dst, bool is64, UINT8 rd, UINT8 rn, UINT64 imm)  { emit_logical_imm(dst, 0x32000000, is64, rd, rn, imm); }
+inline void emit_eor_imm(arm64code *&dst, bool is64, UINT8 rd, UINT8 rn, UINT64 imm)  { emit_logical_imm(dst, 0x52000000, is64, rd, rn, imm); }
+inline void emit_ands_imm(arm64code *&dst, bool is64, UINT8 rd, UINT8 rn, UINT64 imm) { emit_logical_imm(dst, 0x72000000, is64, rd, rn, imm); }
+inline void emit_tst_imm(arm64code *&dst, bool is64, UINT8 rn, UINT64 imm)             { emit_ands_imm(dst, is64, REG_ZR, rn, imm); }
+
+// move wide
+inline void emit_movz(arm64code *&dst, bool is64, UINT8 rd, UINT16 imm, int shift) { assert(shift % 16 == 0 && shift < (is64 ? 64 : 32)); *dst++ = 0x52800000 | sf(is64) | ((shift / 16) << 21) | (imm << 5) | rd; }
+inline void emit_movn(arm64code *&dst, bool is64, UINT8 rd, UINT16 imm, int shift) { assert(shift % 16 == 0 && shift < (is64 ? 64 : 32)); *dst++ = 0x12800000 | sf(is64) | ((shift / 16) << 21) | (imm << 5) | rd; }
+inline void emit_movk(arm64code *&dst, bool is64, UINT8 rd, UINT16 imm, int shift) { assert(shift % 16 == 0 && shift < (is64 ? 64 : 32)); *dst++ = 0x72800000 | sf(is64) | ((shift / 16) << 21) | (imm << 5) | rd; }
+
+// bitfield moves and their aliases
+inline void emit_bitfield(arm64code *&dst, UINT32 op, bool is64, UINT8 rd, UINT8 rn, UINT8 immr, UINT8 imms)
+{
+	*dst++ = op | sf(is64) | (is64 ? 0x00400000 : 0) | (immr << 16) | (imms << 10) | (rn << 5) | rd;
+}
+inline void emit_sbfm(arm64code *&dst, bool is64, UINT8 rd, UINT8 rn, UINT8 immr, UINT8 imms) { emit_bitfield(dst, 0x13000000, is64, rd, rn, immr, imms); }
+inline void emit_bfm(arm64code *&dst, bool is64, UINT8 rd, UINT8 rn, UINT8 immr, UINT8 imms)  { emit_bitfield(dst, 0x33000000, is64, rd, rn, immr, imms); }
+inline void emit_ubfm(arm64code *&dst, bool is64, UINT8 rd, UINT8 rn, UINT8 immr, UINT8 imms) { emit_bitfield(dst, 0x53000000, is64, rd, rn, immr, imms); }
+
+inline void emit_lsl_imm(arm64code *&dst, bool is64, UINT8 rd, UINT8 rn, UINT8 shift)
+{
+	int bits = is64 ? 64 : 32;
+	assert(shift < bits);
+	emit_ubfm(dst, is64, rd, rn, (bits - shift) & (bits - 1), bits - 1 - shift);
+}
+inline void emit_lsr_imm(arm64code *&dst, bool is64, UINT8 rd, UINT8 rn, UINT8 shift)            { emit_ubfm(dst, is64, rd, rn, shift, is64 ? 63 : 31); }
+inline void emit_asr_imm(arm64code *&dst, bool is64, UINT8 rd, UINT8 rn, UINT8 shift)            { emit_sbfm(dst, is64, rd, rn, shift, is64 ? 63 : 31); }
+inline void emit_ubfx(arm64code *&dst, bool is64, UINT8 rd, UINT8 rn, UINT8 lsb, UINT8 width)    { assert(width > 0); emit_ubfm(dst, is64, rd, rn, lsb, lsb + width - 1); }
+inline void emit_bfi(arm64code *&dst, bool is64, UINT8 rd, UINT8 rn, UINT8 lsb, UINT8 width)
+{
+	int bits = is64 ? 64 : 32;
+	assert(width > 0);
+	emit_bfm(dst, is64, rd, rn, (bits - lsb) & (bits - 1), width - 1);
+}
+inline void emit_sxtb(arm64code *&dst, bool is64, UINT8 rd, UINT8 rn)  { emit_sbfm(dst, is64, rd, rn, 0, 7); }
+inline void emit_sxth(arm64code *&dst, bool is64, UINT8 rd, UINT8 rn)  { emit_sbfm(dst, is64, rd, rn, 0, 15); }
+inline void emit_sxtw(arm64code *&dst, UINT8 rd, UINT8 rn)             { emit_sbfm(dst, true, rd, rn, 0, 31); }
+inline void emit_uxtb(arm64code *&dst, UINT8 rd, UINT8 rn)             { emit_ubfm(dst, false, rd, rn, 0, 7); }
+inline void emit_uxth(arm64code *&dst, UINT8 rd, UINT8 rn)             { emit_ubfm(dst, false, rd, rn, 0, 15); }
+
+// EXTR, and ROR (immediate) which is EXTR with both sources the same
+inline void emit_extr(arm64code *&dst, bool is64, UINT8 rd, UINT8 rn, UINT8 rm, UINT8 lsb)
+{
+	assert(lsb < (is64 ? 64 : 32));
+	*dst++ = (is64 ? 0x93c00000 : 0x13800000) | (rm << 16) | (lsb << 10) | (rn << 5) | rd;
+}
+inline void emit_ror_imm(arm64code *&dst, bool is64, UINT8 rd, UINT8 rn, UINT8 shift) { emit_extr(dst, is64, rd, rn, rn, shift); }
+
+// data processing (2 source)
+inline void emit_dp2(arm64code *&dst, UINT32 opcode, bool is64, UINT8 rd, UINT8 rn, UINT8 rm) { *dst++ = 0x1ac00000 | sf(is64) | (rm << 16) | (opcode << 10) | (rn << 5) | rd; }
+inline void emit_udiv(arm64code *&dst, bool is64, UINT8 rd, UINT8 rn, UINT8 rm) { emit_dp2(dst, 0x02, is64, rd, rn, rm); }
+inline void emit_sdiv(arm64code *&dst, bool is64, UINT8 rd, UINT8 rn, UINT8 rm) { emit_dp2(dst, 0x03, is64, rd, rn, rm); }
+inline void emit_lslv(arm64code *&dst, bool is64, UINT8 rd, UINT8 rn, UINT8 rm) { emit_dp2(dst, 0x08, is64, rd, rn, rm); }
+inline void emit_lsrv(arm64code *&dst, bool is64, UINT8 rd, UINT8 rn, UINT8 rm) { emit_dp2(dst, 0x09, is64, rd, rn, rm); }
+inline void emit_asrv(arm64code *&dst, bool is64, UINT8 rd, UINT8 rn, UINT8 rm) { emit_dp2(dst, 0x0a, is64, rd, rn, rm); }
+inline void emit_rorv(arm64code *&dst, bool is64, UINT8 rd, UINT8 rn, UINT8 rm) { emit_dp2(dst, 0x0b, is64, rd, rn, rm); }
+
+// data processing (1 source)
+inline void emit_dp1(arm64code *&dst, UINT32 opcode, bool is64, UINT8 rd, UINT8 rn) { *dst++ = 0x5ac00000 | sf(is64) | (opcode << 10) | (rn << 5) | rd; }
+inline void emit_rbit(arm64code *&dst, bool is64, UINT8 rd, UINT8 rn) { emit_dp1(dst, 0x00, is64, rd, rn); }
+inline void emit_rev(arm64code *&dst, bool is64, UINT8 rd, UINT8 rn)  { emit_dp1(dst, is64 ? 0x03 : 0x02, is64, rd, rn); }
+inline void emit_clz(arm64code *&dst, bool is64, UINT8 rd, UINT8 rn)  { emit_dp1(dst, 0x04, is64, rd, rn); }
+
+// data processing (3 source)
+inline void emit_madd(arm64code *&dst, bool is64, UINT8 rd, UINT8 rn, UINT8 rm, UINT8 ra) { *dst++ = 0x1b000000 | sf(is64) | (rm << 16) | (ra << 10) | (rn << 5) | rd; }
+inline void emit_msub(arm64code *&dst, bool is64, UINT8 rd, UINT8 rn, UINT8 rm, UINT8 ra) { *dst++ = 0x1b008000 | sf(is64) | (rm << 16) | (ra << 10) | (rn << 5) | rd; }
+inline void emit_mul(arm64code *&dst, bool is64, UINT8 rd, UINT8 rn, UINT8 rm)            { emit_madd(dst, is64, rd, rn, rm, REG_ZR); }
+inline void emit_smull(arm64code *&dst, UINT8 rd, UINT8 rn, UINT8 rm)                      { *dst++ = 0x9b200000 | (rm << 16) | (REG_ZR << 10) | (rn << 5) | rd; }
+inline void emit_umull(arm64code *&dst, UINT8 rd, UINT8 rn, UINT8 rm)                      { *dst++ = 0x9ba00000 | (rm << 16) | (REG_ZR << 10) | (rn << 5) | rd; }
+inline void emit_smulh(arm64code *&dst, UINT8 rd, UINT8 rn, UINT8 rm)                      { *dst++ = 0x9b400000 | (rm << 16) | (REG_ZR << 10) | (rn << 5) | rd; }
+inline void emit_umulh(arm64code *&dst, UINT8 rd, UINT8 rn, UINT8 rm)                      { *dst++ = 0x9bc00000 | (rm << 16) | (REG_ZR << 10) | (rn << 5) | rd; }
+
+// conditional select
+inline void emit_csel(arm64code *&dst, bool is64, UINT8 rd, UINT8 rn, UINT8 rm, UINT8 cond)  { *dst++ = 0x1a800000 | sf(is64) | (rm << 16) | (cond << 12) | (rn << 5) | rd; }
+inline void emit_csinc(arm64code *&dst, bool is64, UINT8 rd, UINT8 rn, UINT8 rm, UINT8 cond) { *dst++ = 0x1a800400 | sf(is64) | (rm << 16) | (cond << 12) | (rn << 5) | rd; }
+inline void emit_cset(arm64code *&dst, bool is64, UINT8 rd, UINT8 cond)                      { emit_csinc(dst, is64, rd, REG_ZR, REG_ZR, invert_condition(cond)); }
+
+// system registers
+inline void emit_mrs_nzcv(arm64code *&dst, UINT8 rt) { *dst++ = 0xd53b4200 | rt; }
+inline void emit_msr_nzcv(arm64code *&dst, UINT8 rt) { *dst++ = 0xd51b4200 | rt; }
+inline void emit_mrs_fpcr(arm64code *&dst, UINT8 rt) { *dst++ = 0xd53b4400 | rt; }
+inline void emit_msr_fpcr(arm64code *&dst, UINT8 rt) { *dst++ = 0xd51b4400 | rt; }
+
+inline void emit_nop(arm64code *&dst) { *dst++ = INSN_NOP; }
+
+
+
+//**************************************************************************
+//  LOADS AND STORES
+//**************************************************************************
+
+// opcodes for the unsigned offset forms; the register offset forms are derived from these
+const UINT32 LDST_STRB      = 0x39000000;
+const UINT32 LDST_LDRB      = 0x39400000;
+const UINT32 LDST_LDRSB     = 0x39800000;
+const UINT32 LDST_LDRSBW    = 0x39c00000;
+const UINT32 LDST_STRH      = 0x79000000;
+const UINT32 LDST_LDRH      = 0x79400000;
+const UINT32 LDST_LDRSH     = 0x79800000;
+const UINT32 LDST_LDRSHW    = 0x79c00000;
+const UINT32 LDST_STRW      = 0xb9000000;
+const UINT32 LDST_LDRW      = 0xb9400000;
+const UINT32 LDST_LDRSW     = 0xb9800000;
+const UINT32 LDST_STRX      = 0xf9000000;
+const UINT32 LDST_LDRX      = 0xf9400000;
+const UINT32 LDST_STRS      = 0xbd000000;
+const UINT32 LDST_LDRS      = 0xbd400000;
+const UINT32 LDST_STRD      = 0xfd000000;
+const UINT32 LDST_LDRD      = 0xfd400000;
+
+// return the log2 of the access size encoded in a load/store opcode
+inline int ldst_scale(UINT32 op) { return op >> 30; }
+
+// [rn,#offset], with the offset a multiple of the access size
+inline bool is_ldst_offset(UINT32 op, INT64 offset)
+{
+	int scale = ldst_scale(op);
+	return offset >= 0 && (offset & ((1 << scale) - 1)) == 0 && (offset >> scale) < 4096;
+}
+inline void emit_ldst_offset(arm64code *&dst, UINT32 op, UINT8 rt, UINT8 rn, INT64 offset)
+{
+	assert(is_ldst_offset(op, offset));
+	*dst++ = op | ((offset >> ldst_scale(op)) << 10) | (rn << 5) | rt;
+}
+
+// [rn,rm{,extend {#scale}}], with the index optionally scaled by the access size
+inline void emit_ldst_index(arm64code *&dst, UINT32 op, UINT8 rt, UINT8 rn, UINT8 rm, UINT8 extend, bool scaled)
+{
+	*dst++ = (op & ~0x01000000) | 0x00200800 | (rm << 16) | (extend << 13) | (scaled << 12) | (rn << 5) | rt;
+}
+
+// 64-bit single register pre/post-indexed, for the stack
+inline void emit_str_x_pre(arm64code *&dst, UINT8 rt, UINT8 rn, int offset)  { assert(offset >= -256 && offset < 256); *dst++ = 0xf8000c00 | ((offset & 0x1ff) << 12) | (rn << 5) | rt; }
+inline void emit_ldr_x_post(arm64code *&dst, UINT8 rt, UINT8 rn, int offset) { assert(offset >= -256 && offset < 256); *dst++ = 0xf8400400 | ((offset & 0x1ff) << 12) | (rn << 5) | rt; }
+
+// 64-bit register pairs
+inline void emit_ldstp(arm64code *&dst, UINT32 op, UINT8 rt, UINT8 rt2, UINT8 rn, int offset)
+{
+	assert((offset & 7) == 0 && offset >= -512 && offset < 512);
+	*dst++ = op | (((offset / 8) & 0x7f) << 15) | (rt2 << 10) | (rn << 5) | rt;
+}
+inline void emit_stp_x(arm64code *&dst, UINT8 rt, UINT8 rt2, UINT8 rn, int offset)      { emit_ldstp(dst, 0xa9000000, rt, rt2, rn, offset); }
+inline void emit_ldp_x(arm64code *&dst, UINT8 rt, UINT8 rt2, UINT8 rn, int offset)      { emit_ldstp(dst, 0xa9400000, rt, rt2, rn, offset); }
+inline void emit_stp_x_pre(arm64code *&dst, UINT8 rt, UINT8 rt2, UINT8 rn, int offset)  { emit_ldstp(dst, 0xa9800000, rt, rt2, rn, offset); }
+inline void emit_ldp_x_post(arm64code *&dst, UINT8 rt, UINT8 rt2, UINT8 rn, int offset) { emit_ldstp(dst, 0xa8c00000, rt, rt2, rn, offset); }
+inline void emit_stp_d(arm64code *&dst, UINT8 rt, UINT8 rt2, UINT8 rn, int offset)      { emit_ldstp(dst, 0x6d000000, rt, rt2, rn, offset); }
+inline void emit_ldp_d(arm64code *&dst, UINT8 rt, UINT8 rt2, UINT8 rn, int offset)      { emit_ldstp(dst, 0x6d400000, rt, rt2, rn, offset); }
+
+// PC-relative addresses
+inline void emit_adr(arm64code *&dst, UINT8 rd, const void *target)
+{
+	INT64 delta = (const UINT8 *)target - (const UINT8 *)dst;
+	assert(delta >= -(1 << 20) && delta < (1 << 20));
+	*dst++ = 0x10000000 | ((delta & 3) << 29) | (((delta >> 2) & 0x7ffff) << 5) | rd;
+}
+inline bool is_adrp_target(const arm64code *source, const void *target)
+{
+	INT64 delta = (INT64)((FPTR)target >> 12) - (INT64)((FPTR)source >> 12);
+	return delta >= -(1 << 20) && delta < (1 << 20);
+}
+inline void emit_adrp(arm64code *&dst, UINT8 rd, const void *target)
+{
+	assert(is_adrp_target(dst, target));
+	INT64 delta = (INT64)((FPTR)target >> 12) - (INT64)((FPTR)dst >> 12);
+	*dst++ = 0x90000000 | ((delta & 3) << 29) | (((delta >> 2) & 0x7ffff) << 5) | rd;
+}
+
+
+
+//**************************************************************************
+//  BRANCHES
+//**************************************************************************
+
+inline void emit_b(arm64code *&dst, const void *target)
+{
+	assert(is_branch_target(dst, target));
+	*dst = 0x14000000 | ((((const UINT8 *)target - (const UINT8 *)dst) >> 2) & 0x3ffffff);
+	dst++;
+}
+inline void emit_bl(arm64code *&dst, const void *target)
+{
+	assert(is_branch_target(dst, target));
+	*dst = 0x94000000 | ((((const UINT8 *)target - (const UINT8 *)dst) >> 2) & 0x3ffffff);
+	dst++;
+}
+inline void emit_br(arm64code *&dst, UINT8 rn)  { *dst++ = 0xd61f0000 | (rn << 5); }
+inline void emit_blr(arm64code *&dst, UINT8 rn) { *dst++ = 0xd63f0000 | (rn << 5); }
+inline void emit_ret(arm64code *&dst)           { *dst++ = 0xd65f0000 | (REG_LR << 5); }
+
+// conditional branches; these reach +/-1MB
+inline void emit_b_cond(arm64code *&dst, UINT8 cond, const void *target)
+{
+	INT64 delta = ((const UINT8 *)target - (const UINT8 *)dst) >> 2;
+	assert(delta >= -(1 << 18) && delta < (1 << 18));
+	*dst++ = 0x54000000 | ((delta & 0x7ffff) << 5) | cond;
+}
+inline void emit_cbz(arm64code *&dst, bool is64, UINT8 rt, const void *target)
+{
+	INT64 delta = ((const UINT8 *)target - (const UINT8 *)dst) >> 2;
+	assert(delta >= -(1 << 18) && delta < (1 << 18));
+	*dst++ = 0x34000000 | sf(is64) | ((delta & 0x7ffff) << 5) | rt;
+}
+inline void emit_cbnz(arm64code *&dst, bool is64, UINT8 rt, const void *target)
+{
+	INT64 delta = ((const UINT8 *)target - (const UINT8 *)dst) >> 2;
+	assert(delta >= -(1 << 18) && delta < (1 << 18));
+	*dst++ = 0x35000000 | sf(is64) | ((delta & 0x7ffff) << 5) | rt;
+}
+
+
+//-------------------------------------------------
+//  set_branch_target - repoint an already emitted
+//  B, BL, B.cond, CBZ or CBNZ
+//-------------------------------------------------
+
+inline void set_branch_target(arm64code *branch, const void *target)
+{
+	INT64 delta = ((const UINT8 *)target - (const UINT8 *)branch) >> 2;
+	if ((*branch & 0x7c000000) == 0x14000000)
+	{
+		assert(delta >= -(1 << 25) && delta < (1 << 25));
+		*branch = (*branch & 0xfc000000) | (delta & 0x3ffffff);
+	}
+	else
+	{
+		assert(delta >= -(1 << 18) && delta < (1 << 18));
+		*branch = (*branch & 0xff00001f) | ((delta & 0x7ffff) << 5);
+	}
+}
+
+
+//-------------------------------------------------
+//  forward branches to be resolved later
+//-------------------------------------------------
+
+inline void resolve_link(arm64code *&destptr, const arm64_link &linkinfo)
+{
+	set_branch_target(linkinfo.target, destptr);
+}
+
+inline void emit_b_link(arm64code *&dst, arm64_link &linkinfo)
+{
+	linkinfo.target = dst;
+	*dst++ = 0x14000000;
+}
+
+inline void emit_b_cond_link(arm64code *&dst, UINT8 cond, arm64_link &linkinfo)
+{
+	linkinfo.target = dst;
+	*dst++ = 0x54000000 | cond;
+}
+
+inline void emit_cbz_link(arm64code *&dst, bool is64, UINT8 rt, arm64_link &linkinfo)
+{
+	linkinfo.target = dst;
+	*dst++ = 0x34000000 | sf(is64) | rt;
+}
+
+inline void emit_cbnz_link(arm64code *&dst, bool is64, UINT8 rt, arm64_link &linkinfo)
+{
+	linkinfo.target = dst;
+	*dst++ = 0x35000000 | sf(is64) | rt;
+}
+
+
+
+//**************************************************************************
+//  FLOATING POINT
+//**************************************************************************
+
+// the ftype field selects single or double precision
+inline UINT32 ftype(bool isdouble) { return isdouble ? 0x00400000 : 0; }
+
+// data processing (1 source)
+inline void emit_fp1(arm64code *&dst, UINT32 opcode, bool isdouble, UINT8 rd, UINT8 rn) { *dst++ = 0x1e204000 | ftype(isdouble) | (opcode << 15) | (rn << 5) | rd; }
+inline void emit_fmov(arm64code *&dst, bool isdouble, UINT8 rd, UINT8 rn)   { emit_fp1(dst, 0x00, isdouble, rd, rn); }
+inline void emit_fabs(arm64code *&dst, bool isdouble, UINT8 rd, UINT8 rn)   { emit_fp1(dst, 0x01, isdouble, rd, rn); }
+inline void emit_fneg(arm64code *&dst, bool isdouble, UINT8 rd, UINT8 rn)   { emit_fp1(dst, 0x02, isdouble, rd, rn); }
+inline void emit_fsqrt(arm64code *&dst, bool isdouble, UINT8 rd, UINT8 rn)  { emit_fp1(dst, 0x03, isdouble, rd, rn); }
+inline void emit_fcvt_sd(arm64code *&dst, UINT8 rd, UINT8 rn)               { emit_fp1(dst, 0x05, false, rd, rn); }  // double <- single
+inline void emit_fcvt_ds(arm64code *&dst, UINT8 rd, UINT8 rn)               { emit_fp1(dst, 0x04, true, rd, rn); }   // single <- double
+inline void emit_frinti(arm64code *&dst, bool isdouble, UINT8 rd, UINT8 rn) { emit_fp1(dst, 0x0f, isdouble, rd, rn); }
+
+// data processing (2 source)
+inline void emit_fp2(arm64code *&dst, UINT32 opcode, bool isdouble, UINT8 rd, UINT8 rn, UINT8 rm) { *dst++ = 0x1e200800 | ftype(isdouble) | (rm << 16) | (opcode << 12) | (rn << 5) | rd; }
+inline void emit_fmul(arm64code *&dst, bool isdouble, UINT8 rd, UINT8 rn, UINT8 rm) { emit_fp2(dst, 0x0, isdouble, rd, rn, rm); }
+inline void emit_fdiv(arm64code *&dst, bool isdouble, UINT8 rd, UINT8 rn, UINT8 rm) { emit_fp2(dst, 0x1, isdouble, rd, rn, rm); }
+inline void emit_fadd(arm64code *&dst, bool isdouble, UINT8 rd, UINT8 rn, UINT8 rm) { emit_fp2(dst, 0x2, isdouble, rd, rn, rm); }
+inline void emit_fsub(arm64code *&dst, bool isdouble, UINT8 rd, UINT8 rn, UINT8 rm) { emit_fp2(dst, 0x3, isdouble, rd, rn, rm); }
+
+// compare
+inline void emit_fcmp(arm64code *&dst, bool isdouble, UINT8 rn, UINT8 rm) { *dst++ = 0x1e202000 | ftype(isdouble) | (rm << 16) | (rn << 5); }
+
+// immediate; only 1.0 is needed here
+inline void emit_fmov_one(arm64code *&dst, bool isdouble, UINT8 rd) { *dst++ = 0x1e201000 | ftype(isdouble) | (0x70 << 13) | rd; }
+
+// conversions to and from integer registers
+inline void emit_fpint(arm64code *&dst, UINT32 rmode_opcode, bool is64, bool isdouble, UINT8 rd, UINT8 rn) { *dst++ = 0x1e200000 | sf(is64) | ftype(isdouble) | (rmode_opcode << 16) | (rn << 5) | rd; }
+inline void emit_fcvtns(arm64code *&dst, bool is64, bool isdouble, UINT8 rd, UINT8 rn) { emit_fpint(dst, 0x00, is64, isdouble, rd, rn); }
+inline void emit_fcvtps(arm64code *&dst, bool is64, bool isdouble, UINT8 rd, UINT8 rn) { emit_fpint(dst, 0x08, is64, isdouble, rd, rn); }
+inline void emit_fcvtms(arm64code *&dst, bool is64, bool isdouble, UINT8 rd, UINT8 rn) { emit_fpint(dst, 0x10, is64, isdouble, rd, rn); }
+inline void emit_fcvtzs(arm64code *&dst, bool is64, bool isdouble, UINT8 rd, UINT8 rn) { emit_fpint(dst, 0x18, is64, isdouble, rd, rn); }
+inline void emit_scvtf(arm64code *&dst, bool is64, bool isdouble, UINT8 rd, UINT8 rn)  { emit_fpint(dst, 0x02, is64, isdouble, rd, rn); }
+inline void emit_fmov_to_gp(arm64code *&dst, bool is64, UINT8 rd, UINT8 rn)            { emit_fpint(dst, 0x06, is64, is64, rd, rn); }
+inline void emit_fmov_from_gp(arm64code *&dst, bool is64, UINT8 rd, UINT8 rn)          { emit_fpint(dst, 0x07, is64, is64, rd, rn); }
+
+} // namespace arm64emit
+
+#endif /* __ARM64EMIT_H__ */
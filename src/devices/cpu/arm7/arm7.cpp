@@ -30,6 +30,7 @@ TODO:
 
 *****************************************************************************/
 #include "emu.h"
+#include "emuopts.h"
 #include "debugger.h"
 #include "arm7.h"
 #include "arm7core.h"   //include arm7 core
@@ -550,6 +551,8 @@ void arm7_cpu_device::device_start()
 	state_add( ARM7_USPSR, "UR16", m_r[eSPSR_UND]).formatstr("%08X");
 
 	state_add(STATE_GENFLAGS, "GENFLAGS", m_r[eCPSR]).formatstr("%13s").noshow();
+
+	drc_init();
 }
 
 
@@ -605,7 +608,7 @@ void arm7_cpu_device::device_reset()
 	SwitchMode(eARM7_MODE_SVC);
 	m_r[eR15] = 0;
 
-	m_impstate.cache_dirty = TRUE;
+	m_drc_dirty = true;
 }
 
 
@@ -613,136 +616,148 @@ void arm7_cpu_device::device_reset()
 	m_r[eR15] += 4; \
 	m_icount +=2; /* Any unexecuted instruction only takes 1 cycle (page 193) */
 
-void arm7_cpu_device::execute_run()
+// fetch, check the condition of and execute the instruction at the PC
+void arm7_cpu_device::arm7_execute_instruction()
 {
 	UINT32 insn;
+	UINT32 pc = GET_PC;
 
-	do
+	/* handle Thumb instructions if active */
+	if (T_IS_SET(m_r[eCPSR]))
 	{
-		UINT32 pc = GET_PC;
-
-		debugger_instruction_hook(this, pc);
+		offs_t raddr;
 
-		/* handle Thumb instructions if active */
-		if (T_IS_SET(m_r[eCPSR]))
-		{
-			offs_t raddr;
-
-			pc = m_r[eR15];
+		pc = m_r[eR15];
 
-			// "In Thumb state, bit [0] is undefined and must be ignored. Bits [31:1] contain the PC."
-			raddr = pc & (~1);
+		// "In Thumb state, bit [0] is undefined and must be ignored. Bits [31:1] contain the PC."
+		raddr = pc & (~1);
 
-			if ( m_control & COPRO_CTRL_MMU_EN )
+		if ( m_control & COPRO_CTRL_MMU_EN )
+		{
+			if (!arm7_tlb_translate(raddr, ARM7_TLB_ABORT_P | ARM7_TLB_READ))
 			{
-				if (!arm7_tlb_translate(raddr, ARM7_TLB_ABORT_P | ARM7_TLB_READ))
-				{
-					goto skip_exec;
-				}
+				return;
 			}
+		}
 
-			insn = m_direct->read_word(raddr);
-			(this->*thumb_handler[(insn & 0xffc0) >> 6])(pc, insn);
+		insn = m_direct->read_word(raddr);
+		(this->*thumb_handler[(insn & 0xffc0) >> 6])(pc, insn);
 
-		}
-		else
-		{
-			offs_t raddr;
+	}
+	else
+	{
+		offs_t raddr;
 
-			/* load 32 bit instruction */
+		/* load 32 bit instruction */
 
-			// "In ARM state, bits [1:0] of r15 are undefined and must be ignored. Bits [31:2] contain the PC."
-			raddr = pc & (~3);
+		// "In ARM state, bits [1:0] of r15 are undefined and must be ignored. Bits [31:2] contain the PC."
+		raddr = pc & (~3);
 
-			if ( m_control & COPRO_CTRL_MMU_EN )
+		if ( m_control & COPRO_CTRL_MMU_EN )
+		{
+			if (!arm7_tlb_translate(raddr, ARM7_TLB_ABORT_P | ARM7_TLB_READ))
 			{
-				if (!arm7_tlb_translate(raddr, ARM7_TLB_ABORT_P | ARM7_TLB_READ))
-				{
-					goto skip_exec;
-				}
+				return;
 			}
+		}
 
 #if 0
-			if (MODE26)
-			{
-				UINT32 temp1, temp2;
-				temp1 = GET_CPSR & 0xF00000C3;
-				temp2 = (R15 & 0xF0000000) | ((R15 & 0x0C000000) >> (26 - 6)) | (R15 & 0x00000003);
-				if (temp1 != temp2) fatalerror( "%08X: 32-bit and 26-bit modes are out of sync (%08X %08X)\n", pc, temp1, temp2);
-			}
+		if (MODE26)
+		{
+			UINT32 temp1, temp2;
+			temp1 = GET_CPSR & 0xF00000C3;
+			temp2 = (R15 & 0xF0000000) | ((R15 & 0x0C000000) >> (26 - 6)) | (R15 & 0x00000003);
+			if (temp1 != temp2) fatalerror( "%08X: 32-bit and 26-bit modes are out of sync (%08X %08X)\n", pc, temp1, temp2);
+		}
 #endif
 
-			insn = m_direct->read_dword(raddr);
+		insn = m_direct->read_dword(raddr);
 
-			/* process condition codes for this instruction */
-			switch (insn >> INSN_COND_SHIFT)
-			{
-				case COND_EQ:
-					if (Z_IS_CLEAR(m_r[eCPSR]))
-						{ UNEXECUTED();  goto skip_exec; }
-					break;
-				case COND_NE:
-					if (Z_IS_SET(m_r[eCPSR]))
-						{ UNEXECUTED();  goto skip_exec; }
-					break;
-				case COND_CS:
-					if (C_IS_CLEAR(m_r[eCPSR]))
-						{ UNEXECUTED();  goto skip_exec; }
-					break;
-				case COND_CC:
-					if (C_IS_SET(m_r[eCPSR]))
-						{ UNEXECUTED();  goto skip_exec; }
-					break;
-				case COND_MI:
-					if (N_IS_CLEAR(m_r[eCPSR]))
-						{ UNEXECUTED();  goto skip_exec; }
-					break;
-				case COND_PL:
-					if (N_IS_SET(m_r[eCPSR]))
-						{ UNEXECUTED();  goto skip_exec; }
-					break;
-				case COND_VS:
-					if (V_IS_CLEAR(m_r[eCPSR]))
-						{ UNEXECUTED();  goto skip_exec; }
-					break;
-				case COND_VC:
-					if (V_IS_SET(m_r[eCPSR]))
-						{ UNEXECUTED();  goto skip_exec; }
-					break;
-				case COND_HI:
-					if (C_IS_CLEAR(m_r[eCPSR]) || Z_IS_SET(m_r[eCPSR]))
-						{ UNEXECUTED();  goto skip_exec; }
-					break;
-				case COND_LS:
-					if (C_IS_SET(m_r[eCPSR]) && Z_IS_CLEAR(m_r[eCPSR]))
-						{ UNEXECUTED();  goto skip_exec; }
-					break;
-				case COND_GE:
-					if (!(m_r[eCPSR] & N_MASK) != !(m_r[eCPSR] & V_MASK)) /* Use x ^ (x >> ...) method */
-						{ UNEXECUTED();  goto skip_exec; }
-					break;
-				case COND_LT:
-					if (!(m_r[eCPSR] & N_MASK) == !(m_r[eCPSR] & V_MASK))
-						{ UNEXECUTED();  goto skip_exec; }
-					break;
-				case COND_GT:
-					if (Z_IS_SET(m_r[eCPSR]) || (!(m_r[eCPSR] & N_MASK) != !(m_r[eCPSR] & V_MASK)))
-						{ UNEXECUTED();  goto skip_exec; }
-					break;
-				case COND_LE:
-					if (Z_IS_CLEAR(m_r[eCPSR]) && (!(m_r[eCPSR] & N_MASK) == !(m_r[eCPSR] & V_MASK)))
-						{ UNEXECUTED();  goto skip_exec; }
-					break;
-				case COND_NV:
-					{ UNEXECUTED();  goto skip_exec; }
-			}
-			/*******************************************************************/
-			/* If we got here - condition satisfied, so decode the instruction */
-			/*******************************************************************/
-			(this->*ops_handler[((insn & 0xF000000) >> 24)])(insn);
+		/* process condition codes for this instruction */
+		switch (insn >> INSN_COND_SHIFT)
+		{
+			case COND_EQ:
+				if (Z_IS_CLEAR(m_r[eCPSR]))
+					{ UNEXECUTED();  return; }
+				break;
+			case COND_NE:
+				if (Z_IS_SET(m_r[eCPSR]))
+					{ UNEXECUTED();  return; }
+				break;
+			case COND_CS:
+				if (C_IS_CLEAR(m_r[eCPSR]))
+					{ UNEXECUTED();  return; }
+				break;
+			case COND_CC:
+				if (C_IS_SET(m_r[eCPSR]))
+					{ UNEXECUTED();  return; }
+				break;
+			case COND_MI:
+				if (N_IS_CLEAR(m_r[eCPSR]))
+					{ UNEXECUTED();  return; }
+				break;
+			case COND_PL:
+				if (N_IS_SET(m_r[eCPSR]))
+					{ UNEXECUTED();  return; }
+				break;
+			case COND_VS:
+				if (V_IS_CLEAR(m_r[eCPSR]))
+					{ UNEXECUTED();  return; }
+				break;
+			case COND_VC:
+				if (V_IS_SET(m_r[eCPSR]))
+					{ UNEXECUTED();  return; }
+				break;
+			case COND_HI:
+				if (C_IS_CLEAR(m_r[eCPSR]) || Z_IS_SET(m_r[eCPSR]))
+					{ UNEXECUTED();  return; }
+				break;
+			case COND_LS:
+				if (C_IS_SET(m_r[eCPSR]) && Z_IS_CLEAR(m_r[eCPSR]))
+					{ UNEXECUTED();  return; }
+				break;
+			case COND_GE:
+				if (!(m_r[eCPSR] & N_MASK) != !(m_r[eCPSR] & V_MASK)) /* Use x ^ (x >> ...) method */
+					{ UNEXECUTED();  return; }
+				break;
+			case COND_LT:
+				if (!(m_r[eCPSR] & N_MASK) == !(m_r[eCPSR] & V_MASK))
+					{ UNEXECUTED();  return; }
+				break;
+			case COND_GT:
+				if (Z_IS_SET(m_r[eCPSR]) || (!(m_r[eCPSR] & N_MASK) != !(m_r[eCPSR] & V_MASK)))
+					{ UNEXECUTED();  return; }
+				break;
+			case COND_LE:
+				if (Z_IS_CLEAR(m_r[eCPSR]) && (!(m_r[eCPSR] & N_MASK) == !(m_r[eCPSR] & V_MASK)))
+					{ UNEXECUTED();  return; }
+				break;
+			case COND_NV:
+				{ UNEXECUTED();  return; }
 		}
+		/*******************************************************************/
+		/* If we got here - condition satisfied, so decode the instruction */
+		/*******************************************************************/
+		(this->*ops_handler[((insn & 0xF000000) >> 24)])(insn);
+	}
+}
 
-skip_exec:
+
+void arm7_cpu_device::execute_run()
+{
+	/* the verifier compares cycles, which the scheduler refills between timeslices */
+	if (m_verifier != nullptr)
+		m_verifier->discard();
+
+	/* the recompiler runs the timeslice unless the CPU is in a state it doesn't handle */
+	if (m_isdrc && execute_run_drc())
+		return;
+
+	do
+	{
+		debugger_instruction_hook(this, GET_PC);
+
+		arm7_execute_instruction();
 
 		arm7_check_irq_state();
 
@@ -1119,7 +1134,10 @@ void arm7_cpu_device::arm7_cpu_write32(UINT32 addr, UINT32 data)
 	}
 
 	addr &= ~3;
-	m_program->write_dword(addr, data);
+	if (m_verifier != nullptr)
+		m_verifier->write(4, addr, data, 0xffffffff);
+	else
+		m_program->write_dword(addr, data);
 }
 
 
@@ -1134,7 +1152,10 @@ void arm7_cpu_device::arm7_cpu_write16(UINT32 addr, UINT16 data)
 	}
 
 	addr &= ~1;
-	m_program->write_word(addr, data);
+	if (m_verifier != nullptr)
+		m_verifier->write(2, addr, data, 0xffff);
+	else
+		m_program->write_word(addr, data);
 }
 
 void arm7_cpu_device::arm7_cpu_write8(UINT32 addr, UINT8 data)
@@ -1147,7 +1168,10 @@ void arm7_cpu_device::arm7_cpu_write8(UINT32 addr, UINT8 data)
 		}
 	}
 
-	m_program->write_byte(addr, data);
+	if (m_verifier != nullptr)
+		m_verifier->write(1, addr, data, 0xff);
+	else
+		m_program->write_byte(addr, data);
 }
 
 UINT32 arm7_cpu_device::arm7_cpu_read32(UINT32 addr)
@@ -1162,15 +1186,15 @@ UINT32 arm7_cpu_device::arm7_cpu_read32(UINT32 addr)
 		}
 	}
 
+	if (m_verifier != nullptr)
+		result = m_verifier->read(4, addr & ~3, 0xffffffff);
+	else
+		result = m_program->read_dword(addr & ~3);
+
 	if (addr & 3)
 	{
-		result = m_program->read_dword(addr & ~3);
 		result = (result >> (8 * (addr & 3))) | (result << (32 - (8 * (addr & 3))));
 	}
-	else
-	{
-		result = m_program->read_dword(addr);
-	}
 
 	return result;
 }
@@ -1187,7 +1211,10 @@ UINT16 arm7_cpu_device::arm7_cpu_read16(UINT32 addr)
 		}
 	}
 
-	result = m_program->read_word(addr & ~1);
+	if (m_verifier != nullptr)
+		result = m_verifier->read(2, addr & ~1, 0xffff);
+	else
+		result = m_program->read_word(addr & ~1);
 
 	if (addr & 1)
 	{
@@ -1208,6 +1235,8 @@ UINT8 arm7_cpu_device::arm7_cpu_read8(UINT32 addr)
 	}
 
 	// Handle through normal 8 bit handler (for 32 bit cpu)
+	if (m_verifier != nullptr)
+		return m_verifier->read(1, addr, 0xff);
 	return m_program->read_byte(addr);
 }
 
@@ -26,10 +26,7 @@
 #include "cpu/drcfe.h"
 #include "cpu/drcuml.h"
 #include "cpu/drcumlsh.h"
-
-
-#define ARM7_MAX_FASTRAM       4
-#define ARM7_MAX_HOTSPOTS      16
+#include "cpu/drcverify.h"
 
 
 /***************************************************************************
@@ -37,15 +34,16 @@
 ***************************************************************************/
 
 #define ARM7DRC_STRICT_VERIFY      0x0001          /* verify all instructions */
-#define ARM7DRC_FLUSH_PC           0x0008          /* flush the PC value before each memory access */
 
-#define ARM7DRC_COMPATIBLE_OPTIONS (ARM7DRC_STRICT_VERIFY | ARM7DRC_FLUSH_PC)
+#define ARM7DRC_COMPATIBLE_OPTIONS (ARM7DRC_STRICT_VERIFY)
 #define ARM7DRC_FASTEST_OPTIONS    (0)
 
 /****************************************************************************************************
  *  PUBLIC FUNCTIONS
  ***************************************************************************************************/
 
+class arm7_frontend;
+
 class arm7_cpu_device : public cpu_device
 {
 public:
@@ -53,6 +51,8 @@ public:
 	arm7_cpu_device(const machine_config &mconfig, const char *tag, device_t *owner, UINT32 clock);
 	arm7_cpu_device(const machine_config &mconfig, device_type type, const char *name, const char *tag, device_t *owner, UINT32 clock, const char *shortname, const char *source, UINT8 archRev, UINT8 archFlags, endianness_t endianness = ENDIANNESS_LITTLE);
 
+	void arm7drc_set_options(UINT32 options);
+
 protected:
 	// device-level overrides
 	virtual void device_start() override;
@@ -270,218 +270,112 @@ protected:
 	// DRC
 	//
 
-	/* fast RAM info */
-	struct fast_ram_info
-	{
-		offs_t              start;                      /* start of the RAM block */
-		offs_t              end;                        /* end of the RAM block */
-		UINT8               readonly;                   /* TRUE if read-only */
-		void *              base;                       /* base in memory where the RAM lives */
-	};
+	friend class arm7_frontend;
 
-	struct hotspot_info
+	/* registers the recompiled code works on; kept in the DRC cache so the backend can reach them */
+	struct drc_state
 	{
-		UINT32             pc;
-		UINT32             opcode;
-		UINT32             cycles;
+		UINT32  r[16];          /* registers of the current mode */
+		UINT32  cpsr;
+		UINT32  mode;           /* hash mode: 1 in Thumb state, 0 in ARM state */
+		INT32   icount;
+		UINT32  exit;           /* set by interpreted instructions that need to leave the recompiler */
 	};
 
 	/* internal compiler state */
 	struct compiler_state
 	{
-		UINT32              cycles;                     /* accumulated cycles */
-		UINT8               checkints;                  /* need to check interrupts before next instruction */
-		UINT8               checksoftints;              /* need to check software interrupts before next instruction */
-		uml::code_label  labelnum;                   /* index for local labels */
+		UINT32          cycles;                     /* accumulated cycles */
+		UINT32          mode;                       /* hash mode of the block being compiled */
+		uml::code_label labelnum;                   /* index for local labels */
 	};
 
-	/* ARM7 registers */
-	struct arm7imp_state
+	bool                            m_isdrc;
+	std::unique_ptr<drc_cache>      m_drccache;     /* DRC code cache, allocated only when the recompiler is in use */
+	std::unique_ptr<drcuml_state>   m_drcuml;       /* DRC UML generator state */
+	std::unique_ptr<arm7_frontend>  m_drcfe;        /* DRC front-end state */
+	UINT32                          m_drcoptions;   /* configurable DRC options */
+	bool                            m_drc_dirty;    /* true if we need to flush the cache */
+	drc_state *                     m_drcstate;     /* state shared with the recompiled code */
+
+	uml::code_handle *              m_entry;        /* entry point */
+	uml::code_handle *              m_nocode;       /* nocode exception handler */
+	uml::code_handle *              m_out_of_cycles; /* out of cycles exception handler */
+
+	void arm7_execute_instruction();
+	void drc_init();
+	bool drc_can_run() const;
+	bool execute_run_drc();
+	void drc_capture_state(drc_state &state);
+	void drc_restore_state(const drc_state &state);
+	offs_t drc_disassemble(char *buffer, offs_t pc, UINT32 op, bool thumb);
+
+public:
+	void func_interpret();
+
+	/* lockstep verification against the interpreter; the memory handlers route through it */
+	class verifier : public drc_verifier
 	{
-		/* core state */
-		drc_cache *         cache;                      /* pointer to the DRC code cache */
-		drcuml_state *      drcuml;                     /* DRC UML generator state */
-		//arm7_frontend *     drcfe;                      /* pointer to the DRC front-end state */
-		UINT32              drcoptions;                 /* configurable DRC options */
-
-		/* internal stuff */
-		UINT8               cache_dirty;                /* true if we need to flush the cache */
-		UINT32              jmpdest;                    /* destination jump target */
-
-		/* parameters for subroutines */
-		UINT64              numcycles;                  /* return value from gettotalcycles */
-		UINT32              mode;                       /* current global mode */
-		const char *        format;                     /* format string for print_debug */
-		UINT32              arg0;                       /* print_debug argument 1 */
-		UINT32              arg1;                       /* print_debug argument 2 */
-
-		/* register mappings */
-		uml::parameter   regmap[/*NUM_REGS*/37];               /* parameter to register mappings for all 16 integer registers */
-
-		/* subroutines */
-		uml::code_handle *   entry;                      /* entry point */
-		uml::code_handle *   nocode;                     /* nocode exception handler */
-		uml::code_handle *   out_of_cycles;              /* out of cycles exception handler */
-		uml::code_handle *   tlb_translate;              /* tlb translation handler */
-		uml::code_handle *   detect_fault;               /* tlb fault detection handler */
-		uml::code_handle *   check_irq;                  /* irq check handler */
-		uml::code_handle *   read8;                      /* read byte */
-		uml::code_handle *   write8;                     /* write byte */
-		uml::code_handle *   read16;                     /* read half */
-		uml::code_handle *   write16;                    /* write half */
-		uml::code_handle *   read32;                     /* read word */
-		uml::code_handle *   write32;                    /* write word */
-
-		/* fast RAM */
-		UINT32              fastram_select;
-		fast_ram_info       fastram[ARM7_MAX_FASTRAM];
-
-		/* hotspots */
-		UINT32              hotspot_select;
-		hotspot_info        hotspot[ARM7_MAX_HOTSPOTS];
-	} m_impstate;
-
-	typedef void ( arm7_cpu_device::*arm7thumb_drcophandler)(drcuml_block*, compiler_state*, const opcode_desc*);
-	static const arm7thumb_drcophandler drcthumb_handler[0x40*0x10];
-
-	void drctg00_0(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* Shift left */
-	void drctg00_1(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* Shift right */
-	void drctg01_0(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
-	void drctg01_10(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
-	void drctg01_11(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* SUB Rd, Rs, Rn */
-	void drctg01_12(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* ADD Rd, Rs, #imm */
-	void drctg01_13(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* SUB Rd, Rs, #imm */
-	void drctg02_0(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
-	void drctg02_1(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
-	void drctg03_0(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* ADD Rd, #Offset8 */
-	void drctg03_1(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* SUB Rd, #Offset8 */
-	void drctg04_00_00(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* AND Rd, Rs */
-	void drctg04_00_01(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* EOR Rd, Rs */
-	void drctg04_00_02(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* LSL Rd, Rs */
-	void drctg04_00_03(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* LSR Rd, Rs */
-	void drctg04_00_04(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* ASR Rd, Rs */
-	void drctg04_00_05(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* ADC Rd, Rs */
-	void drctg04_00_06(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);  /* SBC Rd, Rs */
-	void drctg04_00_07(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* ROR Rd, Rs */
-	void drctg04_00_08(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* TST Rd, Rs */
-	void drctg04_00_09(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* NEG Rd, Rs */
-	void drctg04_00_0a(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* CMP Rd, Rs */
-	void drctg04_00_0b(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* CMN Rd, Rs - check flags, add dasm */
-	void drctg04_00_0c(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* ORR Rd, Rs */
-	void drctg04_00_0d(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* MUL Rd, Rs */
-	void drctg04_00_0e(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* BIC Rd, Rs */
-	void drctg04_00_0f(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* MVN Rd, Rs */
-	void drctg04_01_00(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
-	void drctg04_01_01(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* ADD Rd, HRs */
-	void drctg04_01_02(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* ADD HRd, Rs */
-	void drctg04_01_03(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* Add HRd, HRs */
-	void drctg04_01_10(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);  /* CMP Rd, Rs */
-	void drctg04_01_11(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* CMP Rd, Hs */
-	void drctg04_01_12(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* CMP Hd, Rs */
-	void drctg04_01_13(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* CMP Hd, Hs */
-	void drctg04_01_20(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* MOV Rd, Rs (undefined) */
-	void drctg04_01_21(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* MOV Rd, Hs */
-	void drctg04_01_22(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* MOV Hd, Rs */
-	void drctg04_01_23(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* MOV Hd, Hs */
-	void drctg04_01_30(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
-	void drctg04_01_31(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
-	void drctg04_01_32(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
-	void drctg04_01_33(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
-	void drctg04_0203(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
-	void drctg05_0(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);  /* STR Rd, [Rn, Rm] */
-	void drctg05_1(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);  /* STRH Rd, [Rn, Rm] */
-	void drctg05_2(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);  /* STRB Rd, [Rn, Rm] */
-	void drctg05_3(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);  /* LDSB Rd, [Rn, Rm] todo, add dasm */
-	void drctg05_4(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);  /* LDR Rd, [Rn, Rm] */
-	void drctg05_5(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);  /* LDRH Rd, [Rn, Rm] */
-	void drctg05_6(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);  /* LDRB Rd, [Rn, Rm] */
-	void drctg05_7(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);  /* LDSH Rd, [Rn, Rm] */
-	void drctg06_0(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* Store */
-	void drctg06_1(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* Load */
-	void drctg07_0(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* Store */
-	void drctg07_1(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);  /* Load */
-	void drctg08_0(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* Store */
-	void drctg08_1(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* Load */
-	void drctg09_0(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* Store */
-	void drctg09_1(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* Load */
-	void drctg0a_0(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);  /* ADD Rd, PC, #nn */
-	void drctg0a_1(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* ADD Rd, SP, #nn */
-	void drctg0b_0(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* ADD SP, #imm */
-	void drctg0b_1(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
-	void drctg0b_2(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
-	void drctg0b_3(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
-	void drctg0b_4(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* PUSH {Rlist} */
-	void drctg0b_5(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* PUSH {Rlist}{LR} */
-	void drctg0b_6(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
-	void drctg0b_7(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
-	void drctg0b_8(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
-	void drctg0b_9(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
-	void drctg0b_a(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
-	void drctg0b_b(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
-	void drctg0b_c(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* POP {Rlist} */
-	void drctg0b_d(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* POP {Rlist}{PC} */
-	void drctg0b_e(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
-	void drctg0b_f(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
-	void drctg0c_0(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* Store */
-	void drctg0c_1(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* Load */
-	void drctg0d_0(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); // COND_EQ:
-	void drctg0d_1(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); // COND_NE:
-	void drctg0d_2(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); // COND_CS:
-	void drctg0d_3(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); // COND_CC:
-	void drctg0d_4(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); // COND_MI:
-	void drctg0d_5(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); // COND_PL:
-	void drctg0d_6(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); // COND_VS:
-	void drctg0d_7(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); // COND_VC:
-	void drctg0d_8(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); // COND_HI:
-	void drctg0d_9(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); // COND_LS:
-	void drctg0d_a(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); // COND_GE:
-	void drctg0d_b(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); // COND_LT:
-	void drctg0d_c(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); // COND_GT:
-	void drctg0d_d(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); // COND_LE:
-	void drctg0d_e(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); // COND_AL:
-	void drctg0d_f(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); // SWI (this is sort of a "hole" in the opcode encoding)
-	void drctg0e_0(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
-	void drctg0e_1(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
-	void drctg0f_0(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
-	void drctg0f_1(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* BL */
-
-	void load_fast_iregs(drcuml_block *block);
-	void save_fast_iregs(drcuml_block *block);
-	void arm7_drc_init();
-	void arm7_drc_exit();
-	void execute_run_drc();
-	void arm7drc_set_options(UINT32 options);
-	void arm7drc_add_fastram(offs_t start, offs_t end, UINT8 readonly, void *base);
-	void arm7drc_add_hotspot(offs_t pc, UINT32 opcode, UINT32 cycles);
+	public:
+		verifier(arm7_cpu_device &cpu);
+
+	protected:
+		virtual void save_state(std::vector<UINT8> &buffer) override;
+		virtual void restore_state(const std::vector<UINT8> &buffer) override;
+		virtual offs_t pc() override;
+		virtual void set_pc(offs_t pc) override;
+		virtual void step() override;
+
+	private:
+		arm7_cpu_device &       m_arm;
+	};
+	std::unique_ptr<verifier> m_verifier;
+
+protected:
 	void code_flush_cache();
 	void code_compile_block(UINT8 mode, offs_t pc);
-	void cfunc_get_cycles();
-	void cfunc_unimplemented();
+	void alloc_handle(uml::code_handle **handleptr, const char *name);
 	void static_generate_entry_point();
-	void static_generate_check_irq();
 	void static_generate_nocode_handler();
 	void static_generate_out_of_cycles();
-	void static_generate_detect_fault(uml::code_handle **handleptr);
-	void static_generate_tlb_translate(uml::code_handle **handleptr);
-	void static_generate_memory_accessor(int size, bool istlb, bool iswrite, const char *name, uml::code_handle **handleptr);
-	void generate_update_cycles(drcuml_block *block, compiler_state *compiler, uml::parameter param);
+	void log_opcode_desc(const opcode_desc *desclist);
+	void log_add_disasm_comment(drcuml_block *block, const opcode_desc *desc);
+	void generate_update_cycles(drcuml_block *block, compiler_state *compiler, uml::parameter param, bool allow_exception);
 	void generate_checksum_block(drcuml_block *block, compiler_state *compiler, const opcode_desc *seqhead, const opcode_desc *seqlast);
 	void generate_sequence_instruction(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
-	void generate_delay_slot_and_branch(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT8 linkreg);
+	void generate_interpret(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
+	void generate_branch_to(drcuml_block *block, compiler_state *compiler, offs_t targetpc);
+	void generate_condition(drcuml_block *block, int cond);
+	void generate_logic_flags(drcuml_block *block, int carry);
+	void generate_arith_flags(drcuml_block *block, bool sub);
+	int generate_shift_imm(drcuml_block *block, UINT32 insn, offs_t pc, bool wantcarry);
+	void generate_alu(drcuml_block *block, int opcode, int rd, uml::parameter op1, uml::parameter op2, bool setflags, int carry);
+	void generate_arm_opcode(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
+	void generate_thumb_opcode(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
+};
+
 
-	typedef bool ( arm7_cpu_device::*drcarm7ops_ophandler)(drcuml_block*, compiler_state*, const opcode_desc*, UINT32);
-	static const drcarm7ops_ophandler drcops_handler[0x10];
+class arm7_frontend : public drc_frontend
+{
+public:
+	arm7_frontend(arm7_cpu_device *device, UINT32 window_start, UINT32 window_end, UINT32 max_sequence);
+
+	/* userflags for instructions that are compiled rather than handed to the interpreter */
+	static const UINT32 USERFLAG_NATIVE = 0x0001;
+
+	/* select ARM or Thumb decoding for the next describe_code() */
+	void set_thumb(bool thumb) { m_thumb = thumb; }
+
+protected:
+	virtual bool describe(opcode_desc &desc, const opcode_desc *prev) override;
 
-	void saturate_qbit_overflow(drcuml_block *block);
-	bool drcarm7ops_0123(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT32 op);
-	bool drcarm7ops_4567(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT32 op);
-	bool drcarm7ops_89(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT32 op);
-	bool drcarm7ops_ab(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT32 op);
-	bool drcarm7ops_cd(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT32 op);
-	bool drcarm7ops_e(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT32 op);
-	bool drcarm7ops_f(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT32 op);
-	int generate_opcode(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
+private:
+	bool describe_arm(opcode_desc &desc, UINT32 op);
+	bool describe_thumb(opcode_desc &desc, UINT32 op);
+	bool code_is_fixed(offs_t start, offs_t end);
 
+	arm7_cpu_device *m_arm;
+	bool m_thumb;
 };
 
 
@@ -2,7 +2,7 @@
 // copyright-holders:Steve Ellenoff,R. Belmont,Ryan Holtz
 /*****************************************************************************
  *
- *   arm7drc.inc
+ *   arm7drc.hxx
  *   Portable CPU Emulator for 32-bit ARM v3/4/5/6
  *
  *   Copyright Steve Ellenoff, all rights reserved.
@@ -18,103 +18,77 @@
 /******************************************************************************
  *  Notes:
 
-    ** This is a plain vanilla implementation of an ARM7 cpu which incorporates my ARM7 core.
-       It can be used as is, or used to demonstrate how to utilize the arm7 core to create a cpu
-       that uses the core, since there are numerous different mcu packages that incorporate an arm7 core.
-
-       See the notes in the arm7core.c file itself regarding issues/limitations of the arm7 core.
+    ** The recompiler runs alongside the interpreter rather than replacing it:
+       data processing instructions and branches that the front end marks as
+       native are compiled to UML, and everything else (loads and stores,
+       multiplies, PSR and coprocessor access, mode changes) is run one
+       instruction at a time through the interpreter's own handlers.
+
+       The compiled code works on a copy of the sixteen registers visible in
+       the current mode plus the CPSR.  Native instructions never change the
+       mode, T, I or F bits, so the banked registers are only swapped in and
+       out through sRegisterTable when handing over to the interpreter.
+       The hash mode of a block is its T bit.
+
+       Whenever the MMU is enabled, the CPU is in 26-bit mode or the debugger
+       is active, the rest of the timeslice is left to the interpreter.
+
+       The recompiler is still experimental, so it is only used with
+       -drc_experimental.
+
+       With -drc_verify, every stretch between sequence heads is replayed on
+       the interpreter by a drc_verifier, as for the MIPS III and SH-2
+       recompilers, and the cycles left are compared along with the
+       registers.  Interpreted instructions go through the memory handlers,
+       so their accesses are logged and replayed like those of native code.
     **
 *****************************************************************************/
 
 
-/***************************************************************************
-    DEBUGGING
-***************************************************************************/
-
-#define SINGLE_INSTRUCTION_MODE         (0)
-
 /***************************************************************************
     CONSTANTS
 ***************************************************************************/
 
-#include "arm7tdrc.hxx"
-
-/* map variables */
-#define MAPVAR_PC                       uml::M0
-#define MAPVAR_CYCLES                   uml::M1
-
 /* size of the execution code cache */
 #define CACHE_SIZE                      (32 * 1024 * 1024)
 
 /* compilation boundaries -- how far back/forward does the analysis extend? */
 #define COMPILE_BACKWARDS_BYTES         128
 #define COMPILE_FORWARDS_BYTES          512
-#define COMPILE_MAX_INSTRUCTIONS        ((COMPILE_BACKWARDS_BYTES/4) + (COMPILE_FORWARDS_BYTES/4))
 #define COMPILE_MAX_SEQUENCE            64
 
 /* exit codes */
 #define EXECUTE_OUT_OF_CYCLES           0
 #define EXECUTE_MISSING_CODE            1
-#define EXECUTE_UNMAPPED_CODE           2
-#define EXECUTE_RESET_CACHE             3
+#define EXECUTE_INTERPRET               2
+
+/* where the shifter carry out ends up */
+#define CARRY_UNCHANGED                 -1      /* C keeps its old value */
+#define CARRY_CLEAR                     0       /* C is cleared */
+#define CARRY_SET                       1       /* C is set */
+#define CARRY_IN_I2                     2       /* C is bit 0 of I2 */
 
 
 /***************************************************************************
-    INLINE FUNCTIONS
+    MACROS
 ***************************************************************************/
 
-/*-------------------------------------------------
-    epc - compute the exception PC from a
-    descriptor
--------------------------------------------------*/
-
-static inline UINT32 epc(const opcode_desc *desc)
-{
-	return desc->pc;
-}
+#define DRC_REG(reg)    uml::mem(&m_drcstate->r[(reg)])
+#define DRC_CPSR        uml::mem(&m_drcstate->cpsr)
+#define DRC_PC          DRC_REG(eR15)
 
 
-/*-------------------------------------------------
-    alloc_handle - allocate a handle if not
-    already allocated
--------------------------------------------------*/
-
-static inline void alloc_handle(drcuml_state *drcuml, uml::code_handle **handleptr, const char *name)
-{
-	if (*handleptr == nullptr)
-		*handleptr = drcuml->handle_alloc(name);
-}
-
-
-/*-------------------------------------------------
-    load_fast_iregs - load any fast integer
-    registers
--------------------------------------------------*/
+/***************************************************************************
+    C CALLBACKS
+***************************************************************************/
 
-void arm7_cpu_device::load_fast_iregs(drcuml_block *block)
+static void cfunc_arm7_interpret(void *param)
 {
-	int regnum;
-
-	for (regnum = 0; regnum < ARRAY_LENGTH(m_impstate.regmap); regnum++)
-		if (m_impstate.regmap[regnum].is_int_register())
-			UML_DMOV(block, uml::ireg(m_impstate.regmap[regnum].ireg() - uml::REG_I0), uml::mem(&m_r[regnum]));
+	((arm7_cpu_device *)param)->func_interpret();
 }
 
 
-/*-------------------------------------------------
-    save_fast_iregs - save any fast integer
-    registers
--------------------------------------------------*/
-
-void arm7_cpu_device::save_fast_iregs(drcuml_block *block)
-{
-	int regnum;
-
-	for (regnum = 0; regnum < ARRAY_LENGTH(m_impstate.regmap); regnum++)
-		if (m_impstate.regmap[regnum].is_int_register())
-			UML_DMOV(block, uml::mem(&m_r[regnum]), uml::ireg(m_impstate.regmap[regnum].ireg() - uml::REG_I0));
-}
-
+#include "arm7tdrc.hxx"
 
 
 /***************************************************************************
@@ -122,164 +96,172 @@ void arm7_cpu_device::save_fast_iregs(drcuml_block *block)
 ***************************************************************************/
 
 /*-------------------------------------------------
-    arm7_init - initialize the processor
+    drc_init - set up the recompiler if it is
+    enabled for this CPU
 -------------------------------------------------*/
 
-void arm7_cpu_device::arm7_drc_init()
+void arm7_cpu_device::drc_init()
 {
-	drc_cache *cache;
-	drcbe_info beinfo;
-	UINT32 flags = 0;
-
-	/* allocate enough space for the cache and the core */
-	cache = auto_alloc(machine(), drc_cache(CACHE_SIZE));
-	if (cache == nullptr)
-		fatalerror("Unable to allocate cache of size %d\n", (UINT32)(CACHE_SIZE));
-
-	/* allocate the implementation-specific state from the full cache */
-	memset(&m_impstate, 0, sizeof(m_impstate));
-	m_impstate.cache = cache;
-
-	/* initialize the UML generator */
-	m_impstate.drcuml = new drcuml_state(*this, *cache, flags, 1, 32, 1);
+	m_isdrc = allow_drc() && mconfig().options().drc_experimental();
+	m_drcoptions = ARM7DRC_COMPATIBLE_OPTIONS;
+	m_drc_dirty = true;
+	m_entry = nullptr;
+	m_nocode = nullptr;
+	m_out_of_cycles = nullptr;
+	if (!m_isdrc)
+		return;
+
+	/* allocate the cache and the state the generated code works on */
+	m_drccache = std::make_unique<drc_cache>(CACHE_SIZE + sizeof(drc_state));
+	m_drcstate = (drc_state *)m_drccache->alloc_near(sizeof(drc_state));
+	memset(m_drcstate, 0, sizeof(*m_drcstate));
+
+	/* initialize the UML generator; mode 1 is Thumb, and Thumb PCs only ignore bit 0 once aligned */
+	m_drcuml = std::make_unique<drcuml_state>(*this, *m_drccache, 0, 2, 32, 0);
 
 	/* add symbols for our stuff */
-	m_impstate.drcuml->symbol_add(&m_icount, sizeof(m_icount), "icount");
-	for (int regnum = 0; regnum < 37; regnum++)
+	for (int regnum = 0; regnum < 16; regnum++)
 	{
 		char buf[10];
 		sprintf(buf, "r%d", regnum);
-		m_impstate.drcuml->symbol_add(&m_r[regnum], sizeof(m_r[regnum]), buf);
+		m_drcuml->symbol_add(&m_drcstate->r[regnum], sizeof(m_drcstate->r[regnum]), buf);
 	}
-	m_impstate.drcuml->symbol_add(&m_impstate.mode, sizeof(m_impstate.mode), "mode");
-	m_impstate.drcuml->symbol_add(&m_impstate.arg0, sizeof(m_impstate.arg0), "arg0");
-	m_impstate.drcuml->symbol_add(&m_impstate.arg1, sizeof(m_impstate.arg1), "arg1");
-	m_impstate.drcuml->symbol_add(&m_impstate.numcycles, sizeof(m_impstate.numcycles), "numcycles");
-	//m_impstate.drcuml->symbol_add(&m_impstate.fpmode, sizeof(m_impstate.fpmode), "fpmode"); // TODO
+	m_drcuml->symbol_add(&m_drcstate->cpsr, sizeof(m_drcstate->cpsr), "cpsr");
+	m_drcuml->symbol_add(&m_drcstate->mode, sizeof(m_drcstate->mode), "mode");
+	m_drcuml->symbol_add(&m_drcstate->icount, sizeof(m_drcstate->icount), "icount");
 
 	/* initialize the front-end helper */
-	//m_impstate.drcfe = auto_alloc(machine(), arm7_frontend(this, COMPILE_BACKWARDS_BYTES, COMPILE_FORWARDS_BYTES, SINGLE_INSTRUCTION_MODE ? 1 : COMPILE_MAX_SEQUENCE));
+	m_drcfe = std::make_unique<arm7_frontend>(this, COMPILE_BACKWARDS_BYTES, COMPILE_FORWARDS_BYTES, COMPILE_MAX_SEQUENCE);
 
-	/* allocate memory for cache-local state and initialize it */
-	//memcpy(&m_impstate.fpmode, fpmode_source, sizeof(fpmode_source)); // TODO
+	/* check against the interpreter if asked to */
+	if (drc_verifier::requested(*this))
+		m_verifier = std::make_unique<verifier>(*this);
+}
 
-	/* compute the register parameters */
-	for (int regnum = 0; regnum < 37; regnum++)
-	{
-		m_impstate.regmap[regnum] = (regnum == 0) ? uml::parameter(0) : uml::parameter::make_memory(&m_r[regnum]);
-	}
 
-	/* if we have registers to spare, assign r2, r3, r4 to leftovers */
-	//if (!DISABLE_FAST_REGISTERS) // TODO
-	{
-		m_impstate.drcuml->get_backend_info(beinfo);
-		if (beinfo.direct_iregs > 4)
-		{   // PC
-			m_impstate.regmap[eR15] = uml::I4;
-		}
-		if (beinfo.direct_iregs > 5)
-		{   // Status
-			m_impstate.regmap[eCPSR] = uml::I5;
-		}
-		if (beinfo.direct_iregs > 6)
-		{   // SP
-			m_impstate.regmap[eR13] = uml::I6;
-		}
-	}
+/*-------------------------------------------------
+    arm7drc_set_options - configure DRC options
+-------------------------------------------------*/
 
-	/* mark the cache dirty so it is updated on next execute */
-	m_impstate.cache_dirty = TRUE;
+void arm7_cpu_device::arm7drc_set_options(UINT32 options)
+{
+	if (!m_isdrc)
+		return;
+	m_drcoptions = options;
+	m_drc_dirty = true;
 }
 
 
 /*-------------------------------------------------
-    arm7_execute - execute the CPU for the
-    specified number of cycles
+    drc_can_run - return true if the CPU is in a
+    state the recompiled code can handle
 -------------------------------------------------*/
 
-void arm7_cpu_device::execute_run_drc()
+bool arm7_cpu_device::drc_can_run() const
 {
-	drcuml_state *drcuml = m_impstate.drcuml;
-	int execute_result;
+	return !(m_control & COPRO_CTRL_MMU_EN) && MODE32 &&
+			!(machine().debug_flags & DEBUG_FLAG_ENABLED);
+}
+
+
+/*-------------------------------------------------
+    execute_run_drc - run recompiled code until
+    out of cycles; returns false if the
+    interpreter must run the rest of the timeslice
+-------------------------------------------------*/
+
+bool arm7_cpu_device::execute_run_drc()
+{
+	if (!drc_can_run())
+		return false;
 
 	/* reset the cache if dirty */
-	if (m_impstate.cache_dirty)
+	if (m_drc_dirty)
 		code_flush_cache();
-	m_impstate.cache_dirty = FALSE;
 
 	/* execute */
+	int execute_result;
+	drc_capture_state(*m_drcstate);
+	m_drcstate->exit = 0;
 	do
 	{
 		/* run as much as we can */
-		execute_result = drcuml->execute(*m_impstate.entry);
+		execute_result = m_drcuml->execute(*m_entry);
 
 		/* if we need to recompile, do it */
 		if (execute_result == EXECUTE_MISSING_CODE)
-			code_compile_block(m_impstate.mode, m_r[eR15]);
-		else if (execute_result == EXECUTE_UNMAPPED_CODE)
-			fatalerror("Attempted to execute unmapped code at PC=%08X\n", m_r[eR15]);
-		else if (execute_result == EXECUTE_RESET_CACHE)
-			code_flush_cache();
+			code_compile_block(m_drcstate->mode, m_drcstate->r[eR15]);
+	} while (execute_result == EXECUTE_MISSING_CODE);
+	drc_restore_state(*m_drcstate);
 
-	} while (execute_result != EXECUTE_OUT_OF_CYCLES);
+	return (execute_result == EXECUTE_OUT_OF_CYCLES);
 }
 
+
 /*-------------------------------------------------
-    arm7_exit - cleanup from execution
+    drc_capture_state - copy the registers of the
+    current mode out of the CPU
 -------------------------------------------------*/
 
-void arm7_cpu_device::arm7_drc_exit()
+void arm7_cpu_device::drc_capture_state(drc_state &state)
 {
-	/* clean up the DRC */
-	//auto_free(machine(), m_impstate.drcfe);
-	delete m_impstate.drcuml;
-	auto_free(machine(), m_impstate.cache);
+	for (int regnum = 0; regnum < 16; regnum++)
+		state.r[regnum] = GET_REGISTER(regnum);
+	state.cpsr = GET_CPSR;
+	state.mode = T_IS_SET(GET_CPSR) ? 1 : 0;
+	state.icount = m_icount;
 }
 
 
 /*-------------------------------------------------
-    arm7drc_set_options - configure DRC options
+    drc_restore_state - copy the registers of the
+    current mode back into the CPU
 -------------------------------------------------*/
 
-void arm7_cpu_device::arm7drc_set_options(UINT32 options)
+void arm7_cpu_device::drc_restore_state(const drc_state &state)
 {
-	m_impstate.drcoptions = options;
+	/* the mode bits select the register bank, so they go first */
+	GET_CPSR = state.cpsr;
+	for (int regnum = 0; regnum < 16; regnum++)
+		SET_REGISTER(regnum, state.r[regnum]);
+	m_icount = state.icount;
 }
 
 
 /*-------------------------------------------------
-    arm7drc_add_fastram - add a new fastram
-    region
+    drc_disassemble - disassemble an ARM or Thumb
+    opcode
 -------------------------------------------------*/
 
-void arm7_cpu_device::arm7drc_add_fastram(offs_t start, offs_t end, UINT8 readonly, void *base)
+offs_t arm7_cpu_device::drc_disassemble(char *buffer, offs_t pc, UINT32 op, bool thumb)
 {
-	if (m_impstate.fastram_select < ARRAY_LENGTH(m_impstate.fastram))
-	{
-		m_impstate.fastram[m_impstate.fastram_select].start = start;
-		m_impstate.fastram[m_impstate.fastram_select].end = end;
-		m_impstate.fastram[m_impstate.fastram_select].readonly = readonly;
-		m_impstate.fastram[m_impstate.fastram_select].base = base;
-		m_impstate.fastram_select++;
-	}
+	extern CPU_DISASSEMBLE( arm7arm );
+	extern CPU_DISASSEMBLE( arm7thumb );
+
+	/* the opcode is already fetched, so hand it over in the disassembler's little-endian order */
+	UINT8 bytes[4] = { UINT8(op), UINT8(op >> 8), UINT8(op >> 16), UINT8(op >> 24) };
+	if (thumb)
+		return CPU_DISASSEMBLE_NAME(arm7thumb)(this, buffer, pc, bytes, bytes, 0);
+	return CPU_DISASSEMBLE_NAME(arm7arm)(this, buffer, pc, bytes, bytes, 0);
 }
 
 
 /*-------------------------------------------------
-    arm7drc_add_hotspot - add a new hotspot
+    func_interpret - run the instruction at the
+    PC through the interpreter
 -------------------------------------------------*/
 
-void arm7_cpu_device::arm7drc_add_hotspot(offs_t pc, UINT32 opcode, UINT32 cycles)
+void arm7_cpu_device::func_interpret()
 {
-	if (m_impstate.hotspot_select < ARRAY_LENGTH(m_impstate.hotspot))
-	{
-		m_impstate.hotspot[m_impstate.hotspot_select].pc = pc;
-		m_impstate.hotspot[m_impstate.hotspot_select].opcode = opcode;
-		m_impstate.hotspot[m_impstate.hotspot_select].cycles = cycles;
-		m_impstate.hotspot_select++;
-	}
-}
+	drc_restore_state(*m_drcstate);
 
+	arm7_execute_instruction();
+	arm7_check_irq_state();
+	m_icount -= 3;
+
+	drc_capture_state(*m_drcstate);
+	m_drcstate->exit = !drc_can_run();
+}
 
 
 /***************************************************************************
@@ -293,72 +275,87 @@ void arm7_cpu_device::arm7drc_add_hotspot(offs_t pc, UINT32 opcode, UINT32 cycle
 
 void arm7_cpu_device::code_flush_cache()
 {
+	drcuml_state *drcuml = m_drcuml.get();
+
 	/* empty the transient cache contents */
-	m_impstate.drcuml->reset();
+	drcuml->reset();
+
+	/* describe everything that affects generated code to the persistent block cache */
+	drcuml->persist_signature(m_archRev);
+	drcuml->persist_signature(m_archFlags);
+	drcuml->persist_signature(m_endian);
+	drcuml->persist_signature(m_drcoptions);
+	drcuml->persist_signature(m_verifier != nullptr);
+	drcuml->persist_region(this, sizeof(*this));
+	drcuml->persist_region(m_drcstate, sizeof(*m_drcstate));
 
 	try
 	{
-		/* generate the entry point and out-of-cycles handlers */
-		static_generate_entry_point();
+		/* generate the entry point and exception handlers */
 		static_generate_nocode_handler();
 		static_generate_out_of_cycles();
-		static_generate_tlb_translate(nullptr); // TODO FIXME
-		static_generate_detect_fault(nullptr); // TODO FIXME
-		//static_generate_tlb_mismatch();
-
-		/* add subroutines for memory accesses */
-		static_generate_memory_accessor(1, FALSE, FALSE, "read8",       &m_impstate.read8);
-		static_generate_memory_accessor(1, TRUE,  FALSE, "write8",      &m_impstate.write8);
-		static_generate_memory_accessor(2, FALSE, FALSE, "read16",      &m_impstate.read16);
-		static_generate_memory_accessor(2, TRUE,  FALSE, "write16",     &m_impstate.write16);
-		static_generate_memory_accessor(4, FALSE, FALSE, "read32",      &m_impstate.read32);
-		static_generate_memory_accessor(4, TRUE,  FALSE, "write32",     &m_impstate.write32);
+		static_generate_entry_point();
 	}
 	catch (drcuml_block::abort_compilation &)
 	{
-		fatalerror("Unrecoverable error generating static code\n");
+		fatalerror("Unable to generate ARM7 static code\n");
 	}
+
+	m_drc_dirty = false;
 }
 
 
 /*-------------------------------------------------
-    code_compile_block - compile a block of the
-    given mode at the specified pc
+    code_compile_block - compile a block of code
+    starting at the specified pc
 -------------------------------------------------*/
 
 void arm7_cpu_device::code_compile_block(UINT8 mode, offs_t pc)
 {
-	drcuml_state *drcuml = m_impstate.drcuml;
+	drcuml_state *drcuml = m_drcuml.get();
 	compiler_state compiler = { 0 };
-	const opcode_desc *seqlast;
-	int override = FALSE;
+	const opcode_desc *seqhead, *seqlast;
+	const opcode_desc *desclist = nullptr;
+	bool override = false;
+	drcuml_block *block;
 
 	g_profiler.start(PROFILER_DRC_COMPILE);
 
-	/* get a description of this sequence */
-	// TODO FIXME
-	const opcode_desc *desclist = nullptr; //m_impstate.drcfe->describe_code(pc); // TODO
-//  if (drcuml->logging() || drcuml->logging_native())
-//      log_opcode_desc(drcuml, desclist, 0);
-
-	/* if we get an error back, flush the cache and try again */
 	bool succeeded = false;
 	while (!succeeded)
 	{
 		try
 		{
+			/* reuse the persisted block if the code hasn't changed */
+			if (drcuml->persist_restore(mode, pc))
+			{
+				g_profiler.stop();
+				return;
+			}
+
+			/* get a description of this sequence */
+			if (desclist == nullptr)
+			{
+				m_drcfe->set_thumb(mode != 0);
+				desclist = m_drcfe->describe_code(pc);
+				if (drcuml->logging() || drcuml->logging_native())
+					log_opcode_desc(desclist);
+			}
+
 			/* start the block */
-			drcuml_block *block = drcuml->begin_block(4096);
+			block = drcuml->begin_block(4096);
+			compiler.cycles = 0;
+			compiler.mode = mode;
 
 			/* loop until we get through all instruction sequences */
-			for (const opcode_desc *seqhead = desclist; seqhead != nullptr; seqhead = seqlast->next())
+			for (seqhead = desclist; seqhead != nullptr; seqhead = seqlast->next())
 			{
 				const opcode_desc *curdesc;
 				UINT32 nextpc;
 
 				/* add a code log entry */
 				if (drcuml->logging())
-					block->append_comment("-------------------------");                     // comment
+					block->append_comment("-------------------------");                 // comment
 
 				/* determine the last instruction in this sequence */
 				for (seqlast = seqhead; seqlast != nullptr; seqlast = seqlast->next())
@@ -366,7 +363,7 @@ void arm7_cpu_device::code_compile_block(UINT8 mode, offs_t pc)
 						break;
 				assert(seqlast != nullptr);
 
-				/* if we don't have a hash for this mode/pc, or if we are overriding all, add one */
+				/* if we don't have a hash for this PC, or if we are overriding all, add one */
 				if (override || !drcuml->hash_exists(mode, seqhead->pc))
 					UML_HASH(block, mode, seqhead->pc);                                     // hash    mode,pc
 
@@ -374,7 +371,7 @@ void arm7_cpu_device::code_compile_block(UINT8 mode, offs_t pc)
 				/* are recompiling due to being out of sync and allow future overrides */
 				else if (seqhead == desclist)
 				{
-					override = TRUE;
+					override = true;
 					UML_HASH(block, mode, seqhead->pc);                                     // hash    mode,pc
 				}
 
@@ -382,8 +379,7 @@ void arm7_cpu_device::code_compile_block(UINT8 mode, offs_t pc)
 				else
 				{
 					UML_LABEL(block, seqhead->pc | 0x80000000);                             // label   seqhead->pc | 0x80000000
-					UML_HASHJMP(block, 0, seqhead->pc, *m_impstate.nocode);
-																							// hashjmp <mode>,seqhead->pc,nocode
+					UML_HASHJMP(block, mode, seqhead->pc, *m_nocode);                       // hashjmp mode,seqhead->pc,nocode
 					continue;
 				}
 
@@ -395,28 +391,33 @@ void arm7_cpu_device::code_compile_block(UINT8 mode, offs_t pc)
 				if (seqhead->flags & OPFLAG_IS_BRANCH_TARGET)
 					UML_LABEL(block, seqhead->pc | 0x80000000);                             // label   seqhead->pc | 0x80000000
 
+				/* let the verifier check everything since the last sequence */
+				if (m_verifier != nullptr)
+				{
+					UML_MOV(block, uml::mem(m_verifier->boundary_pc()), seqhead->pc);       // mov     [boundary_pc],seqhead->pc
+					UML_CALLC(block, drc_verifier::static_block_start, m_verifier.get());   // callc   block_start,verifier
+				}
+
 				/* iterate over instructions in the sequence and compile them */
 				for (curdesc = seqhead; curdesc != seqlast->next(); curdesc = curdesc->next())
 					generate_sequence_instruction(block, &compiler, curdesc);
 
+				/* note the guest code covered */
+				for (curdesc = seqhead; curdesc != seqlast->next(); curdesc = curdesc->next())
+					block->add_code_range(curdesc->pc, curdesc->pc + curdesc->length - 1);
+
 				/* if we need to return to the start, do it */
 				if (seqlast->flags & OPFLAG_RETURN_TO_START)
 					nextpc = pc;
 
 				/* otherwise we just go to the next instruction */
 				else
-					nextpc = seqlast->pc + (seqlast->skipslots + 1) * 4;
+					nextpc = seqlast->pc + seqlast->length;
 
 				/* count off cycles and go there */
-				generate_update_cycles(block, &compiler, nextpc);          // <subtract cycles>
-
-				/* if the last instruction can change modes, use a variable mode; otherwise, assume the same mode */
-				/*if (seqlast->flags & OPFLAG_CAN_CHANGE_MODES)
-				    UML_HASHJMP(block, uml::mem(&m_impstate.mode), nextpc, *m_impstate.nocode);
-				                                                                            // hashjmp <mode>,nextpc,nocode
-				else*/ if (seqlast->next() == nullptr || seqlast->next()->pc != nextpc)
-					UML_HASHJMP(block, m_impstate.mode, nextpc, *m_impstate.nocode);
-																							// hashjmp <mode>,nextpc,nocode
+				generate_update_cycles(block, &compiler, nextpc, true);                     // <subtract cycles>
+				if (seqlast->next() == nullptr || seqlast->next()->pc != nextpc)
+					UML_HASHJMP(block, mode, nextpc, *m_nocode);                            // hashjmp mode,nextpc,nocode
 			}
 
 			/* end the sequence */
@@ -433,36 +434,21 @@ void arm7_cpu_device::code_compile_block(UINT8 mode, offs_t pc)
 
 
 /***************************************************************************
-    C FUNCTION CALLBACKS
+    STATIC CODEGEN
 ***************************************************************************/
 
 /*-------------------------------------------------
-    cfunc_get_cycles - compute the total number
-    of cycles executed so far
--------------------------------------------------*/
-
-void arm7_cpu_device::cfunc_get_cycles()
-{
-	m_impstate.numcycles = total_cycles();
-}
-
-
-/*-------------------------------------------------
-    cfunc_unimplemented - handler for
-    unimplemented opcdes
+    alloc_handle - allocate a handle if not
+    already allocated
 -------------------------------------------------*/
 
-void arm7_cpu_device::cfunc_unimplemented()
+void arm7_cpu_device::alloc_handle(uml::code_handle **handleptr, const char *name)
 {
-	UINT32 opcode = m_impstate.arg0;
-	fatalerror("PC=%08X: Unimplemented op %08X\n", m_r[eR15], opcode);
+	if (*handleptr == nullptr)
+		*handleptr = m_drcuml->handle_alloc(name);
 }
 
 
-/***************************************************************************
-    STATIC CODEGEN
-***************************************************************************/
-
 /*-------------------------------------------------
     static_generate_entry_point - generate a
     static entry point
@@ -470,209 +456,24 @@ void arm7_cpu_device::cfunc_unimplemented()
 
 void arm7_cpu_device::static_generate_entry_point()
 {
-	drcuml_state *drcuml = m_impstate.drcuml;
-	uml::code_label nodabt;
-	uml::code_label nofiq;
-	uml::code_label noirq;
-	uml::code_label irq32;
-	uml::code_label nopabd;
-	uml::code_label nound;
-	uml::code_label swi32;
-	uml::code_label irqadjust;
-	uml::code_label done;
 	drcuml_block *block;
 
-	block = drcuml->begin_block(110);
+	/* begin generating */
+	block = m_drcuml->begin_block(20);
 
 	/* forward references */
-	//alloc_handle(drcuml, &m_impstate.exception_norecover[EXCEPTION_INTERRUPT], "interrupt_norecover");
-	alloc_handle(drcuml, &m_impstate.nocode, "nocode");
-	alloc_handle(drcuml, &m_impstate.detect_fault, "detect_fault");
-	alloc_handle(drcuml, &m_impstate.tlb_translate, "tlb_translate");
-
-	alloc_handle(drcuml, &m_impstate.entry, "entry");
-	UML_HANDLE(block, *m_impstate.entry);                           // handle  entry
+	alloc_handle(&m_nocode, "nocode");
 
-	/* load fast integer registers */
-	load_fast_iregs(block);
-
-	UML_CALLH(block, *m_impstate.check_irq);
+	alloc_handle(&m_entry, "entry");
+	UML_HANDLE(block, *m_entry);                                                        // handle  entry
 
 	/* generate a hash jump via the current mode and PC */
-	UML_HASHJMP(block, 0, uml::mem(&m_pc), *m_impstate.nocode);       // hashjmp 0,<pc>,nocode
-	block->end();
-}
-
-
-/*-------------------------------------------------
-    static_generate_check_irq - generate a handler
-    to check IRQs
--------------------------------------------------*/
-
-void arm7_cpu_device::static_generate_check_irq()
-{
-	drcuml_state *drcuml = m_impstate.drcuml;
-	drcuml_block *block;
-	uml::code_label noirq;
-	int nodabt = 0;
-	int nopabt = 0;
-	int irqadjust = 0;
-	int nofiq = 0;
-	int irq32 = 0;
-	int swi32 = 0;
-	int done = 0;
-	int label = 1;
-
-	/* begin generating */
-	block = drcuml->begin_block(120);
-
-	/* generate a hash jump via the current mode and PC */
-	alloc_handle(drcuml, &m_impstate.check_irq, "check_irq");
-	UML_HANDLE(block, *m_impstate.check_irq);                       // handle  check_irq
-	/* Exception priorities:
-
-	    Reset
-	    Data abort
-	    FIRQ
-	    IRQ
-	    Prefetch abort
-	    Undefined instruction
-	    Software Interrupt
-	*/
-
-	UML_ADD(block, uml::I0, uml::mem(&R15), 4);                                   // add      i0, PC, 4  ;insn pc
-
-	// Data Abort
-	UML_TEST(block, uml::mem(&m_pendingAbtD), 1);                          // test     pendingAbtD, 1
-	UML_JMPc(block, uml::COND_Z, nodabt = label++);                          // jmpz     nodabt
-
-	UML_ROLINS(block, uml::mem(&GET_CPSR), eARM7_MODE_ABT, 0, MODE_FLAG);     // rolins   CPSR, eARM7_MODE_ABT, 0, MODE_FLAG
-	UML_MOV(block, uml::mem(&GET_REGISTER(14)), uml::I0);                    // mov      LR, i0
-	UML_MOV(block, uml::mem(&GET_REGISTER(SPSR)), uml::mem(&GET_CPSR));      // mov      SPSR, CPSR
-	UML_OR(block, uml::mem(&GET_CPSR), uml::mem(&GET_CPSR), I_MASK);              // or       CPSR, CPSR, I_MASK
-	UML_ROLAND(block, uml::mem(&GET_CPSR), uml::mem(&GET_CPSR), 0, ~T_MASK);      // roland   CPSR, CPSR, 0, ~T_MASK
-	UML_MOV(block, uml::mem(&R15), 0x00000010);                              // mov      PC, 0x10 (Data Abort vector address)
-	UML_MOV(block, uml::mem(&m_pendingAbtD), 0);                           // mov      pendingAbtD, 0
-	UML_JMP(block, irqadjust = label++);                                // jmp      irqadjust
-
-	UML_LABEL(block, nodabt);                                           // nodabt:
-
-	// FIQ
-	UML_TEST(block, uml::mem(&m_pendingFiq), 1);                           // test     pendingFiq, 1
-	UML_JMPc(block, uml::COND_Z, nofiq = label++);                           // jmpz     nofiq
-	UML_TEST(block, uml::mem(&GET_CPSR), F_MASK);                            // test     CPSR, F_MASK
-	UML_JMPc(block, uml::COND_Z, nofiq);                                     // jmpz     nofiq
-
-	UML_MOV(block, uml::mem(&GET_REGISTER(14)), uml::I0);                    // mov      LR, i0
-	UML_MOV(block, uml::mem(&GET_REGISTER(SPSR)), uml::mem(&GET_CPSR));      // mov      SPSR, CPSR
-	UML_OR(block, uml::mem(&GET_CPSR), uml::mem(&GET_CPSR), I_MASK | F_MASK);     // or       CPSR, CPSR, I_MASK | F_MASK
-	UML_ROLAND(block, uml::mem(&GET_CPSR), uml::mem(&GET_CPSR), 0, ~T_MASK);          // roland   CPSR, CPSR, 0, ~T_MASK
-	UML_MOV(block, uml::mem(&R15), 0x0000001c);                              // mov      PC, 0x1c (FIQ vector address)
-	UML_MOV(block, uml::mem(&m_pendingFiq), 0);                            // mov      pendingFiq, 0
-	UML_JMP(block, irqadjust);                                          // jmp      irqadjust
-
-	UML_LABEL(block, nofiq);                                            // nofiq:
-
-	// IRQ
-	UML_TEST(block, uml::mem(&m_pendingIrq), 1);                           // test     pendingIrq, 1
-	UML_JMPc(block, uml::COND_Z, noirq = label++);                           // jmpz     noirq
-	UML_TEST(block, uml::mem(&GET_CPSR), I_MASK);                            // test     CPSR, I_MASK
-	UML_JMPc(block, uml::COND_Z, noirq);                                     // jmpz     noirq
-
-	UML_MOV(block, uml::mem(&GET_REGISTER(14)), uml::I0);                    // mov      LR, i0
-	UML_TEST(block, uml::mem(&GET_CPSR), SR_MODE32);                         // test     CPSR, MODE32
-	UML_JMPc(block, uml::COND_NZ, irq32 = label++);                          // jmpnz    irq32
-	UML_AND(block, uml::I1, uml::I0, 0xf4000000);                                 // and      i1, i0, 0xf4000000
-	UML_OR(block, uml::mem(&R15), uml::I1, 0x0800001a);                           // or       PC, i1, 0x0800001a
-	UML_AND(block, uml::I1, uml::mem(&GET_CPSR), 0x0fffff3f);                     // and      i1, CPSR, 0x0fffff3f
-	UML_ROLAND(block, uml::I0, uml::mem(&R15), 32-20, 0x0000000c);                // roland   i0, R15, 32-20, 0x0000000c
-	UML_ROLINS(block, uml::I0, uml::mem(&R15), 0, 0xf0000000);                    // rolins   i0, R15, 0, 0xf0000000
-	UML_OR(block, uml::mem(&GET_CPSR), uml::I0, uml::I1);                              // or       CPSR, i0, i1
-	UML_JMP(block, irqadjust);                                          // jmp      irqadjust
-
-	UML_LABEL(block, irq32);                                            // irq32:
-	UML_MOV(block, uml::mem(&GET_REGISTER(SPSR)), uml::mem(&GET_CPSR));      // mov      SPSR, CPSR
-	UML_OR(block, uml::mem(&GET_CPSR), uml::mem(&GET_CPSR), I_MASK);              // or       CPSR, CPSR, I_MASK
-	UML_ROLAND(block, uml::mem(&GET_CPSR), uml::mem(&GET_CPSR), 0, ~T_MASK);          // roland   CPSR, CPSR, 0, ~T_MASK
-	UML_MOV(block, uml::mem(&R15), 0x00000018);                              // mov      PC, 0x18 (IRQ vector address)
-
-	UML_JMP(block, irqadjust);                                          // jmp      irqadjust
-
-	UML_LABEL(block, noirq);                                            // noirq:
-
-	// Prefetch Abort
-	UML_TEST(block, uml::mem(&m_pendingAbtP), 1);                          // test     pendingAbtP, 1
-	UML_JMPc(block, uml::COND_Z, nopabt = label++);                          // jmpz     nopabt
-
-	UML_ROLINS(block, uml::mem(&GET_CPSR), eARM7_MODE_ABT, 0, MODE_FLAG);     // rolins   CPSR, eARM7_MODE_ABT, 0, MODE_FLAG
-	UML_MOV(block, uml::mem(&GET_REGISTER(14)), uml::I0);                    // mov      LR, i0
-	UML_MOV(block, uml::mem(&GET_REGISTER(SPSR)), uml::mem(&GET_CPSR));      // mov      SPSR, CPSR
-	UML_OR(block, uml::mem(&GET_CPSR), uml::mem(&GET_CPSR), I_MASK);              // or       CPSR, CPSR, I_MASK
-	UML_ROLAND(block, uml::mem(&GET_CPSR), uml::mem(&GET_CPSR), 0, ~T_MASK);          // roland   CPSR, CPSR, 0, ~T_MASK
-	UML_MOV(block, uml::mem(&R15), 0x0000000c);                              // mov      PC, 0x0c (Prefetch Abort vector address)
-	UML_MOV(block, uml::mem(&m_pendingAbtP), 0);                           // mov      pendingAbtP, 0
-	UML_JMP(block, irqadjust);                                          // jmp      irqadjust
-
-	UML_LABEL(block, nopabt);                                           // nopabt:
-
-	// Undefined instruction
-	UML_TEST(block, uml::mem(&m_pendingUnd), 1);                           // test     pendingUnd, 1
-	UML_JMPc(block, uml::COND_Z, nopabt = label++);                          // jmpz     nound
-
-	UML_ROLINS(block, uml::mem(&GET_CPSR), eARM7_MODE_UND, 0, MODE_FLAG);     // rolins   CPSR, eARM7_MODE_UND, 0, MODE_FLAG
-	UML_MOV(block, uml::I1, (UINT64)-4);                                             // mov      i1, -4
-	UML_TEST(block, uml::mem(&GET_CPSR), T_MASK);                            // test     CPSR, T_MASK
-	UML_MOVc(block, uml::COND_NZ, uml::I1, (UINT64)-2);                                   // movnz    i1, -2
-	UML_ADD(block, uml::mem(&GET_REGISTER(14)), uml::I0, uml::I1);                // add      LR, i0, i1
-	UML_MOV(block, uml::mem(&GET_REGISTER(SPSR)), uml::mem(&GET_CPSR));      // mov      SPSR, CPSR
-	UML_OR(block, uml::mem(&GET_CPSR), uml::mem(&GET_CPSR), I_MASK);              // or       CPSR, CPSR, I_MASK
-	UML_ROLAND(block, uml::mem(&GET_CPSR), uml::mem(&GET_CPSR), 0, ~T_MASK);          // roland   CPSR, CPSR, 0, ~T_MASK
-	UML_MOV(block, uml::mem(&R15), 0x00000004);                              // mov      PC, 0x0c (Undefined Insn vector address)
-	UML_MOV(block, uml::mem(&m_pendingUnd), 0);                            // mov      pendingUnd, 0
-	UML_JMP(block, irqadjust);                                          // jmp      irqadjust
-
-	UML_LABEL(block, nopabt);                                           // nopabt:
-
-	// Software Interrupt
-	UML_TEST(block, uml::mem(&m_pendingSwi), 1);                           // test     pendingSwi, 1
-	UML_JMPc(block, uml::COND_Z, done = label++);                            // jmpz     done
-
-	UML_ROLINS(block, uml::mem(&GET_CPSR), eARM7_MODE_SVC, 0, MODE_FLAG);     // rolins   CPSR, eARM7_MODE_SVC, 0, MODE_FLAG
-	UML_MOV(block, uml::I1, (UINT64)-4);                                             // mov      i1, -4
-	UML_TEST(block, uml::mem(&GET_CPSR), T_MASK);                            // test     CPSR, T_MASK
-	UML_MOVc(block, uml::COND_NZ, uml::I1, (UINT64)-2);                                   // movnz    i1, -2
-	UML_ADD(block, uml::mem(&GET_REGISTER(14)), uml::I0, uml::I1);                // add      LR, i0, i1
-
-	UML_TEST(block, uml::mem(&GET_CPSR), SR_MODE32);                         // test     CPSR, MODE32
-	UML_JMPc(block, uml::COND_NZ, swi32 = label++);                          // jmpnz    swi32
-	UML_AND(block, uml::I1, uml::I0, 0xf4000000);                                 // and      i1, i0, 0xf4000000
-	UML_OR(block, uml::mem(&R15), uml::I1, 0x0800001b);                           // or       PC, i1, 0x0800001b
-	UML_AND(block, uml::I1, uml::mem(&GET_CPSR), 0x0fffff3f);                     // and      i1, CPSR, 0x0fffff3f
-	UML_ROLAND(block, uml::I0, uml::mem(&R15), 32-20, 0x0000000c);                // roland   i0, R15, 32-20, 0x0000000c
-	UML_ROLINS(block, uml::I0, uml::mem(&R15), 0, 0xf0000000);                    // rolins   i0, R15, 0, 0xf0000000
-	UML_OR(block, uml::mem(&GET_CPSR), uml::I0, uml::I1);                              // or       CPSR, i0, i1
-	UML_MOV(block, uml::mem(&m_pendingSwi), 0);                            // mov      pendingSwi, 0
-	UML_JMP(block, irqadjust);                                          // jmp      irqadjust
-
-	UML_LABEL(block, swi32);                                            // irq32:
-	UML_MOV(block, uml::mem(&GET_REGISTER(SPSR)), uml::mem(&GET_CPSR));      // mov      SPSR, CPSR
-	UML_OR(block, uml::mem(&GET_CPSR), uml::mem(&GET_CPSR), I_MASK);              // or       CPSR, CPSR, I_MASK
-	UML_ROLAND(block, uml::mem(&GET_CPSR), uml::mem(&GET_CPSR), 0, ~T_MASK);          // roland   CPSR, CPSR, 0, ~T_MASK
-	UML_MOV(block, uml::mem(&R15), 0x00000008);                              // mov      PC, 0x08 (SWI vector address)
-	UML_MOV(block, uml::mem(&m_pendingSwi), 0);                            // mov      pendingSwi, 0
-	UML_JMP(block, irqadjust);                                          // jmp      irqadjust
-
-	UML_LABEL(block, irqadjust);                                        // irqadjust:
-	UML_MOV(block, uml::I1, 0);                                              // mov      i1, 0
-	UML_TEST(block, uml::mem(&COPRO_CTRL), COPRO_CTRL_MMU_EN | COPRO_CTRL_INTVEC_ADJUST);    // test COPRO_CTRL, MMU_EN | INTVEC_ADJUST
-	UML_MOVc(block, uml::COND_NZ, uml::I1, 0xffff0000);                           // movnz    i1, 0xffff0000
-	UML_OR(block, uml::mem(&R15), uml::mem(&R15), uml::I1);                             // or       PC, i1
-
-	UML_LABEL(block, done);                                             // done:
+	UML_HASHJMP(block, uml::mem(&m_drcstate->mode), DRC_PC, *m_nocode);                 // hashjmp <mode>,<pc>,nocode
 
 	block->end();
 }
 
+
 /*-------------------------------------------------
     static_generate_nocode_handler - generate an
     exception handler for "out of code"
@@ -680,19 +481,17 @@ void arm7_cpu_device::static_generate_check_irq()
 
 void arm7_cpu_device::static_generate_nocode_handler()
 {
-	drcuml_state *drcuml = m_impstate.drcuml;
 	drcuml_block *block;
 
 	/* begin generating */
-	block = drcuml->begin_block(10);
+	block = m_drcuml->begin_block(10);
 
-	/* generate a hash jump via the current mode and PC */
-	alloc_handle(drcuml, &m_impstate.nocode, "nocode");
-	UML_HANDLE(block, *m_impstate.nocode);                                  // handle  nocode
-	UML_GETEXP(block, uml::I0);                                                      // getexp  i0
-	UML_MOV(block, uml::mem(&R15), uml::I0);                                              // mov     [pc],i0
-	save_fast_iregs(block);
-	UML_EXIT(block, EXECUTE_MISSING_CODE);                                      // exit    EXECUTE_MISSING_CODE
+	/* the mode never changes in recompiled code, so only the PC needs saving */
+	alloc_handle(&m_nocode, "nocode");
+	UML_HANDLE(block, *m_nocode);                                                       // handle  nocode
+	UML_GETEXP(block, uml::I0);                                                         // getexp  i0
+	UML_MOV(block, DRC_PC, uml::I0);                                                    // mov     [pc],i0
+	UML_EXIT(block, EXECUTE_MISSING_CODE);                                              // exit    EXECUTE_MISSING_CODE
 
 	block->end();
 }
@@ -705,455 +504,66 @@ void arm7_cpu_device::static_generate_nocode_handler()
 
 void arm7_cpu_device::static_generate_out_of_cycles()
 {
-	drcuml_state *drcuml = m_impstate.drcuml;
 	drcuml_block *block;
 
 	/* begin generating */
-	block = drcuml->begin_block(10);
+	block = m_drcuml->begin_block(10);
 
-	/* generate a hash jump via the current mode and PC */
-	alloc_handle(drcuml, &m_impstate.out_of_cycles, "out_of_cycles");
-	UML_HANDLE(block, *m_impstate.out_of_cycles);                       // handle  out_of_cycles
-	UML_GETEXP(block, uml::I0);                                                  // getexp  i0
-	UML_MOV(block, uml::mem(&R15), uml::I0);                                          // mov     <pc>,i0
-	save_fast_iregs(block);
-	UML_EXIT(block, EXECUTE_OUT_OF_CYCLES);                                 // exit    EXECUTE_OUT_OF_CYCLES
+	alloc_handle(&m_out_of_cycles, "out_of_cycles");
+	UML_HANDLE(block, *m_out_of_cycles);                                                // handle  out_of_cycles
+	UML_GETEXP(block, uml::I0);                                                         // getexp  i0
+	UML_MOV(block, DRC_PC, uml::I0);                                                    // mov     [pc],i0
+	UML_EXIT(block, EXECUTE_OUT_OF_CYCLES);                                             // exit    EXECUTE_OUT_OF_CYCLES
 
 	block->end();
 }
 
 
-/*------------------------------------------------------------------
-    static_generate_tlb_translate
-------------------------------------------------------------------*/
-
-void arm7_cpu_device::static_generate_detect_fault(uml::code_handle **handleptr)
-{
-	/* on entry, flags are in I2, vaddr is in I3, desc_lvl1 is in I4, ap is in R5 */
-	/* on exit, fault result is in I6 */
-	drcuml_state *drcuml = m_impstate.drcuml;
-	drcuml_block *block;
-	int donefault = 0;
-	int checkuser = 0;
-	int label = 1;
-
-	/* begin generating */
-	block = drcuml->begin_block(1024);
-
-	/* add a global entry for this */
-	alloc_handle(drcuml, &m_impstate.detect_fault, "detect_fault");
-	UML_HANDLE(block, *m_impstate.detect_fault);                // handle   detect_fault
-
-	UML_ROLAND(block, uml::I6, uml::I4, 32-4, 0x0f<<1);                       // roland   i6, i4, 32-4, 0xf<<1
-	UML_ROLAND(block, uml::I6, uml::mem(&COPRO_DOMAIN_ACCESS_CONTROL), uml::I6, 3);// roland   i6, COPRO_DOMAIN_ACCESS_CONTROL, i6, 3
-	// if permission == 3, FAULT_NONE
-	UML_CMP(block, uml::I6, 3);                                          // cmp      i6, 3
-	UML_MOVc(block, uml::COND_E, uml::I6, FAULT_NONE);                        // move     i6, FAULT_NONE
-	UML_JMPc(block, uml::COND_E, donefault = label++);                   // jmpe     donefault
-	// if permission == 0 || permission == 2, FAULT_DOMAIN
-	UML_CMP(block, uml::I6, 1);                                          // cmp      i6, 1
-	UML_MOVc(block, uml::COND_NE, uml::I6, FAULT_DOMAIN);                     // movne    i6, FAULT_DOMAIN
-	UML_JMPc(block, uml::COND_NE, donefault);                            // jmpne    donefault
-
-	// if permission == 1
-	UML_CMP(block, uml::I5, 3);                                          // cmp      i5, 3
-	UML_MOVc(block, uml::COND_E, uml::I6, FAULT_NONE);                        // move     i6, FAULT_NONE
-	UML_JMPc(block, uml::COND_E, donefault);                             // jmpe     donefault
-	UML_CMP(block, uml::I5, 0);                                          // cmp      i5, 1
-	UML_JMPc(block, uml::COND_NE, checkuser = label++);                  // jmpne    checkuser
-	UML_ROLAND(block, uml::I6, uml::mem(&COPRO_CTRL),                         // roland   i6, COPRO_CTRL, 32 - COPRO_CTRL_SYSTEM_SHIFT,
-				32 - COPRO_CTRL_SYSTEM_SHIFT,                       //          COPRO_CTRL_SYSTEM | COPRO_CTRL_ROM
-				COPRO_CTRL_SYSTEM | COPRO_CTRL_ROM);
-	// if s == 0 && r == 0, FAULT_PERMISSION
-	UML_CMP(block, uml::I6, 0);                                          // cmp      i6, 0
-	UML_MOVc(block, uml::COND_E, uml::I6, FAULT_PERMISSION);                  // move     i6, FAULT_PERMISSION
-	UML_JMPc(block, uml::COND_E, donefault);                             // jmpe     donefault
-	// if s == 1 && r == 1, FAULT_PERMISSION
-	UML_CMP(block, uml::I6, 3);                                          // cmp      i6, 3
-	UML_MOVc(block, uml::COND_E, uml::I6, FAULT_PERMISSION);                  // move     i6, FAULT_PERMISSION
-	UML_JMPc(block, uml::COND_E, donefault);                             // jmpe     donefault
-	// if flags & TLB_WRITE, FAULT_PERMISSION
-	UML_TEST(block, uml::I2, ARM7_TLB_WRITE);                            // test     i2, ARM7_TLB_WRITE
-	UML_MOVc(block, uml::COND_NZ, uml::I6, FAULT_PERMISSION);                 // move     i6, FAULT_PERMISSION
-	UML_JMPc(block, uml::COND_NZ, donefault);                            // jmpe     donefault
-	// if r == 1 && s == 0, FAULT_NONE
-	UML_CMP(block, uml::I6, 2);                                          // cmp      i6, 2
-	UML_MOVc(block, uml::COND_E, uml::I6, FAULT_NONE);                        // move     i6, FAULT_NONE
-	UML_JMPc(block, uml::COND_E, donefault);                             // jmpe     donefault
-	UML_AND(block, uml::I6, uml::mem(&GET_CPSR), MODE_FLAG);                  // and      i6, GET_CPSR, MODE_FLAG
-	UML_CMP(block, uml::I6, eARM7_MODE_USER);                            // cmp      i6, eARM7_MODE_USER
-	// if r == 0 && s == 1 && usermode, FAULT_PERMISSION
-	UML_MOVc(block, uml::COND_E, uml::I6, FAULT_PERMISSION);                  // move     i6, FAULT_PERMISSION
-	UML_MOVc(block, uml::COND_NE, uml::I6, FAULT_NONE);                       // movne    i6, FAULT_NONE
-	UML_JMP(block, donefault);                                      // jmp      donefault
-
-	UML_LABEL(block, checkuser);                                    // checkuser:
-	// if !write, FAULT_NONE
-	UML_TEST(block, uml::I2, ARM7_TLB_WRITE);                            // test     i2, ARM7_TLB_WRITE
-	UML_MOVc(block, uml::COND_Z, uml::I6, FAULT_NONE);                        // movz     i6, FAULT_NONE
-	UML_JMPc(block, uml::COND_Z, donefault);                             // jmp      donefault
-	UML_AND(block, uml::I6, uml::mem(&GET_CPSR), MODE_FLAG);                  // and      i6, GET_CPSR, MODE_FLAG
-	UML_CMP(block, uml::I6, eARM7_MODE_USER);                            // cmp      i6, eARM7_MODE_USER
-	UML_MOVc(block, uml::COND_E, uml::I6, FAULT_PERMISSION);                  // move     i6, FAULT_PERMISSION
-	UML_MOVc(block, uml::COND_NE, uml::I6, FAULT_NONE);                       // move     i6, FAULT_NONE
-
-	UML_LABEL(block, donefault);                                    // donefault:
-	UML_RET(block);                                                 // ret
-}
-
-/*------------------------------------------------------------------
-    static_generate_tlb_translate
-------------------------------------------------------------------*/
-
-void arm7_cpu_device::static_generate_tlb_translate(uml::code_handle **handleptr)
-{
-	/* on entry, address is in I0 and flags are in I2 */
-	/* on exit, translated address is in I0 and success/failure is in I2 */
-	/* routine trashes I4-I7 */
-	drcuml_state *drcuml = m_impstate.drcuml;
-	drcuml_block *block;
-	uml::code_label smallfault;
-	uml::code_label smallprefetch;
-	int nopid = 0;
-	int nounmapped = 0;
-	int nounmapped2 = 0;
-	int nocoarse = 0;
-	int nofine = 0;
-	int nosection = 0;
-	int nolargepage = 0;
-	int nosmallpage = 0;
-	int notinypage = 0;
-	int handlefault = 0;
-	int level2 = 0;
-	int prefetch = 0;
-	int prefetch2 = 0;
-	int label = 1;
-
-	/* begin generating */
-	block = drcuml->begin_block(170);
-
-	alloc_handle(drcuml, &m_impstate.tlb_translate, "tlb_translate");
-	UML_HANDLE(block, *m_impstate.tlb_translate);               // handle   tlb_translate
-
-	// I3: vaddr
-	UML_CMP(block, uml::I0, 32 * 1024 * 1024);                           // cmp      i0, 32*1024*1024
-	UML_JMPc(block, uml::COND_GE, nopid = label++);                      // jmpge    nopid
-	UML_AND(block, uml::I3, uml::mem(&COPRO_FCSE_PID), 0xfe000000);           // and      i3, COPRO_FCSE_PID, 0xfe000000
-	UML_ADD(block, uml::I3, uml::I3, uml::I0);                                     // add      i3, i3, i0
-
-	// I4: desc_lvl1
-	UML_AND(block, uml::I4, uml::mem(&COPRO_TLB_BASE), COPRO_TLB_BASE_MASK);  // and      i4, COPRO_TLB_BASE, COPRO_TLB_BASE_MASK
-	UML_ROLINS(block, uml::I4, uml::I3, 32 - COPRO_TLB_VADDR_FLTI_MASK_SHIFT, // rolins   i4, i3, 32-COPRO_TLB_VADDR_FLTI_MASK_SHIFT,
-				COPRO_TLB_VADDR_FLTI_MASK);                         //          COPRO_TLB_VADDR_FLTI_MASK
-	UML_READ(block, uml::I4, uml::I4, uml::SIZE_DWORD, uml::SPACE_PROGRAM);             // read32   i4, i4, PROGRAM
-
-	// I7: desc_lvl1 & 3
-	UML_AND(block, uml::I7, uml::I4, 3);                                      // and      i7, i4, 3
-
-	UML_CMP(block, uml::I7, COPRO_TLB_UNMAPPED);                         // cmp      i7, COPRO_TLB_UNMAPPED
-	UML_JMPc(block, uml::COND_NE, nounmapped = label++);                 // jmpne    nounmapped
-
-	// TLB Unmapped
-	UML_TEST(block, uml::I2, ARM7_TLB_ABORT_D);                          // test     i2, ARM7_TLB_ABORT_D
-	UML_MOVc(block, uml::COND_E, uml::mem(&COPRO_FAULT_STATUS_D), (5 << 0));  // move     COPRO_FAULT_STATUS_D, (5 << 0)
-	UML_MOVc(block, uml::COND_E, uml::mem(&COPRO_FAULT_ADDRESS), uml::I3);         // move     COPRO_FAULT_ADDRESS, i3
-	UML_MOVc(block, uml::COND_E, uml::mem(&m_pendingAbtD), 1);             // move     pendingAbtD, 1
-	UML_MOVc(block, uml::COND_E, uml::I2, 0);                                 // move     i2, 0
-	UML_RETc(block, uml::COND_E);                                        // rete
-
-	UML_TEST(block, uml::I2, ARM7_TLB_ABORT_P);                          // test     i2, ARM7_TLB_ABORT_P
-	UML_MOVc(block, uml::COND_E, uml::mem(&m_pendingAbtP), 1);             // move     pendingAbtP, 1
-	UML_MOV(block, uml::I2, 0);                                          // mov      i2, 0
-	UML_RET(block);                                                 // ret
-
-	UML_LABEL(block, nounmapped);                                   // nounmapped:
-	UML_CMP(block, uml::I7, COPRO_TLB_COARSE_TABLE);                     // cmp      i7, COPRO_TLB_COARSE_TABLE
-	UML_JMPc(block, uml::COND_NE, nocoarse = label++);                   // jmpne    nocoarse
-
-	UML_ROLAND(block, uml::I5, uml::I4, 32-4, 0x0f<<1);                       // roland   i5, i4, 32-4, 0xf<<1
-	UML_ROLAND(block, uml::I5, uml::mem(&COPRO_DOMAIN_ACCESS_CONTROL), uml::I5, 3);// roland   i5, COPRO_DOMAIN_ACCESS_CONTROL, i5, 3
-	UML_CMP(block, uml::I5, 1);                                          // cmp      i5, 1
-	UML_JMPc(block, uml::COND_E, level2 = label++);                      // jmpe     level2
-	UML_CMP(block, uml::I5, 3);                                          // cmp      i5, 3
-	UML_JMPc(block, uml::COND_NE, nofine = label++);                     // jmpne    nofine
-	UML_LABEL(block, level2);                                       // level2:
-
-	// I7: desc_level2
-	UML_AND(block, uml::I7, uml::I4, COPRO_TLB_CFLD_ADDR_MASK);               // and      i7, i4, COPRO_TLB_CFLD_ADDR_MASK
-	UML_ROLINS(block, uml::I7, uml::I3, 32 - COPRO_TLB_VADDR_CSLTI_MASK_SHIFT,// rolins   i7, i3, 32 - COPRO_TLB_VADDR_CSLTI_MASK_SHIFT
-				COPRO_TLB_VADDR_CSLTI_MASK);                        //          COPRO_TLB_VADDR_CSLTI_MASK
-	UML_READ(block, uml::I7, uml::I7, uml::SIZE_DWORD, uml::SPACE_PROGRAM);             // read32   i7, i7, PROGRAM
-	UML_JMP(block, nofine);                                         // jmp      nofine
-
-	UML_LABEL(block, nocoarse);                                     // nocoarse:
-	UML_CMP(block, uml::I7, COPRO_TLB_SECTION_TABLE);                    // cmp      i7, COPRO_TLB_SECTION_TABLE
-	UML_JMPc(block, uml::COND_NE, nosection = label++);                  // jmpne    nosection
-
-	UML_ROLAND(block, uml::I5, uml::I4, 32-10, 3);                            // roland   i7, i4, 32-10, 3
-	// result in I6
-	UML_CALLH(block, *m_impstate.detect_fault);                 // callh    detect_fault
-	UML_CMP(block, uml::I6, FAULT_NONE);                                 // cmp      i6, FAULT_NONE
-	UML_JMPc(block, uml::COND_NE, handlefault = label++);                // jmpne    handlefault
-
-	// no fault, return translated address
-	UML_AND(block, uml::I0, uml::I3, ~COPRO_TLB_SECTION_PAGE_MASK);           // and      i0, i3, ~COPRO_TLB_SECTION_PAGE_MASK
-	UML_ROLINS(block, uml::I0, uml::I4, 0, COPRO_TLB_SECTION_PAGE_MASK);      // rolins   i0, i4, COPRO_TLB_SECTION_PAGE_MASK
-	UML_MOV(block, uml::I2, 1);                                          // mov      i2, 1
-	UML_RET(block);                                                 // ret
-
-	UML_LABEL(block, handlefault);                                  // handlefault:
-	UML_TEST(block, uml::I2, ARM7_TLB_ABORT_D);                          // test     i2, ARM7_TLB_ABORT_D
-	UML_JMPc(block, uml::COND_Z, prefetch = label++);                    // jmpz     prefetch
-	UML_MOV(block, uml::mem(&COPRO_FAULT_ADDRESS), uml::I3);                  // mov      COPRO_FAULT_ADDRESS, i3
-	UML_MOV(block, uml::mem(&m_pendingAbtD), 1);                      // mov      m_pendingAbtD, 1
-	UML_ROLAND(block, uml::I5, uml::I4, 31, 0xf0);                            // roland   i5, i4, 31, 0xf0
-	UML_CMP(block, uml::I6, FAULT_DOMAIN);                               // cmp      i6, FAULT_DOMAIN
-	UML_MOVc(block, uml::COND_E, uml::I6, 9 << 0);                            // move     i6, 9 << 0
-	UML_MOVc(block, uml::COND_NE, uml::I6, 13 << 0);                          // movne    i6, 13 << 0
-	UML_OR(block, uml::mem(&COPRO_FAULT_STATUS_D), uml::I5, uml::I6);              // or       COPRO_FAULT_STATUS_D, i5, i6
-	UML_MOV(block, uml::I2, 0);                                          // mov      i2, 0
-	UML_RET(block);                                                 // ret
-
-	UML_LABEL(block, prefetch);                                     // prefetch:
-	UML_MOV(block, uml::mem(&m_pendingAbtP), 1);                      // mov      m_pendingAbtP, 1
-	UML_MOV(block, uml::I2, 0);                                          // mov      i2, 0
-	UML_RET(block);                                                 // ret
-
-	UML_LABEL(block, nosection);                                    // nosection:
-	UML_CMP(block, uml::I7, COPRO_TLB_FINE_TABLE);                       // cmp      i7, COPRO_TLB_FINE_TABLE
-	UML_JMPc(block, uml::COND_NE, nofine);                               // jmpne    nofine
-
-	// Not yet implemented
-	UML_MOV(block, uml::I2, 1);                                          // mov      i2, 1
-	UML_RET(block);                                                 // ret
-
-	UML_LABEL(block, nofine);                                       // nofine:
-
-	// I7: desc_lvl2
-	UML_AND(block, uml::I6, uml::I7, 3);                                      // and      i6, i7, 3
-	UML_CMP(block, uml::I6, COPRO_TLB_UNMAPPED);                         // cmp      i6, COPRO_TLB_UNMAPPED
-	UML_JMPc(block, uml::COND_NE, nounmapped2 = label++);                // jmpne    nounmapped2
-
-	UML_TEST(block, uml::I2, ARM7_TLB_ABORT_D);                          // test     i2, ARM7_TLB_ABORT_D
-	UML_JMPc(block, uml::COND_Z, prefetch2 = label++);                   // jmpz     prefetch2
-	UML_MOV(block, uml::mem(&COPRO_FAULT_ADDRESS), uml::I3);                  // mov      COPRO_FAULT_ADDRESS, i3
-	UML_MOV(block, uml::mem(&m_pendingAbtD), 1);                      // mov      m_pendingAbtD, 1
-	UML_ROLAND(block, uml::I5, uml::I4, 31, 0xf0);                            // roland   i5, i4, 31, 0xf0
-	UML_OR(block, uml::I5, uml::I5, 7 << 0);                                  // or       i5, i5, 7 << 0
-	UML_OR(block, uml::mem(&COPRO_FAULT_STATUS_D), uml::I5, uml::I6);              // or       COPRO_FAULT_STATUS_D, i5, i6
-	UML_MOV(block, uml::I2, 0);                                          // mov      i2, 0
-	UML_RET(block);                                                 // ret
-
-	UML_LABEL(block, prefetch2);                                    // prefetch2:
-	UML_MOV(block, uml::mem(&m_pendingAbtP), 1);                      // mov      m_pendingAbtP, 1
-	UML_MOV(block, uml::I2, 0);                                          // mov      i2, 0
-	UML_RET(block);                                                 // ret
-
-	UML_LABEL(block, nounmapped2);                                  // nounmapped2:
-	UML_CMP(block, uml::I6, COPRO_TLB_LARGE_PAGE);                       // cmp      i6, COPRO_TLB_LARGE_PAGE
-	UML_JMPc(block, uml::COND_NE, nolargepage = label++);                // jmpne    nolargepage
-
-	UML_AND(block, uml::I0, uml::I3, ~COPRO_TLB_LARGE_PAGE_MASK);             // and      i0, i3, ~COPRO_TLB_LARGE_PAGE_MASK
-	UML_ROLINS(block, uml::I0, uml::I7, 0, COPRO_TLB_LARGE_PAGE_MASK);        // rolins   i0, i7, 0, COPRO_TLB_LARGE_PAGE_MASK
-	UML_MOV(block, uml::I2, 1);                                          // mov      i2, 1
-	UML_RET(block);                                                 // ret
-
-	UML_LABEL(block, nolargepage);                                  // nolargepage:
-	UML_CMP(block, uml::I6, COPRO_TLB_SMALL_PAGE);                       // cmp      i6, COPRO_TLB_SMALL_PAGE
-	UML_JMPc(block, uml::COND_NE, nosmallpage = label++);                // jmpne    nosmallpage
-
-	UML_ROLAND(block, uml::I5, uml::I3, 32-9, 3<<1);                          // roland   i5, i3, 32-9, 3<<1
-	UML_ROLAND(block, uml::I6, uml::I7, 32-4, 0xff);                          // roland   i6, i7, 32-4, 0xff
-	UML_SHR(block, uml::I5, uml::I7, uml::I5);                                     // shr      i5, i7, i5
-	UML_AND(block, uml::I5, uml::I5, 3);                                      // and      i5, i5, 3
-	// result in I6
-	UML_CALLH(block, *m_impstate.detect_fault);                 // callh    detect_fault
-
-	UML_CMP(block, uml::I6, FAULT_NONE);                                 // cmp      i6, FAULT_NONE
-	UML_JMPc(block, uml::COND_NE, smallfault = label++);                 // jmpne    smallfault
-	UML_AND(block, uml::I0, uml::I7, COPRO_TLB_SMALL_PAGE_MASK);              // and      i0, i7, COPRO_TLB_SMALL_PAGE_MASK
-	UML_ROLINS(block, uml::I0, uml::I3, 0, ~COPRO_TLB_SMALL_PAGE_MASK);       // rolins   i0, i3, 0, ~COPRO_TLB_SMALL_PAGE_MASK
-	UML_MOV(block, uml::I2, 1);                                          // mov      i2, 1
-	UML_RET(block);                                                 // ret
-
-	UML_LABEL(block, smallfault);                                   // smallfault:
-	UML_TEST(block, uml::I2, ARM7_TLB_ABORT_D);                          // test     i2, ARM7_TLB_ABORT_D
-	UML_JMPc(block, uml::COND_NZ, smallprefetch = label++);              // jmpnz    smallprefetch
-	UML_MOV(block, uml::mem(&COPRO_FAULT_ADDRESS), uml::I3);                  // mov      COPRO_FAULT_ADDRESS, i3
-	UML_MOV(block, uml::mem(&m_pendingAbtD), 1);                      // mov      pendingAbtD, 1
-	UML_CMP(block, uml::I6, FAULT_DOMAIN);                               // cmp      i6, FAULT_DOMAIN
-	UML_MOVc(block, uml::COND_E, uml::I5, 11 << 0);                           // move     i5, 11 << 0
-	UML_MOVc(block, uml::COND_NE, uml::I5, 15 << 0);                          // movne    i5, 15 << 0
-	UML_ROLINS(block, uml::I5, uml::I4, 31, 0xf0);                            // rolins   i5, i4, 31, 0xf0
-	UML_MOV(block, uml::mem(&COPRO_FAULT_STATUS_D), uml::I5);                 // mov      COPRO_FAULT_STATUS_D, i5
-	UML_MOV(block, uml::I2, 0);                                          // mov      i2, 0
-	UML_RET(block);                                                 // ret
-
-	UML_LABEL(block, smallprefetch);                                // smallprefetch:
-	UML_MOV(block, uml::mem(&m_pendingAbtP), 1);                      // mov      pendingAbtP, 1
-	UML_MOV(block, uml::I2, 0);                                          // mov      i2, 0
-	UML_RET(block);                                                 // ret
-
-	UML_LABEL(block, nosmallpage);                                  // nosmallpage:
-	UML_CMP(block, uml::I6, COPRO_TLB_TINY_PAGE);                        // cmp      i6, COPRO_TLB_TINY_PAGE
-	UML_JMPc(block, uml::COND_NE, notinypage = label++);                 // jmpne    notinypage
-
-	UML_AND(block, uml::I0, uml::I3, ~COPRO_TLB_TINY_PAGE_MASK);              // and      i0, i3, ~COPRO_TLB_TINY_PAGE_MASK
-	UML_ROLINS(block, uml::I0, uml::I7, 0, COPRO_TLB_TINY_PAGE_MASK);         // rolins   i0, i7, 0, COPRO_TLB_TINY_PAGE_MASK
-	UML_MOV(block, uml::I2, 1);                                          // mov      i2, 1
-	UML_RET(block);                                                 // ret
-
-	UML_LABEL(block, notinypage);                                   // notinypage:
-	UML_MOV(block, uml::I0, uml::I3);                                         // mov      i0, i3
-	UML_RET(block);                                                 // ret
-
-	block->end();
-}
+/***************************************************************************
+    CODE LOGGING HELPERS
+***************************************************************************/
 
-/*------------------------------------------------------------------
-    static_generate_memory_accessor
-------------------------------------------------------------------*/
+/*-------------------------------------------------
+    log_opcode_desc - log a list of descriptions
+-------------------------------------------------*/
 
-void arm7_cpu_device::static_generate_memory_accessor(int size, bool istlb, bool iswrite, const char *name, uml::code_handle **handleptr)
+void arm7_cpu_device::log_opcode_desc(const opcode_desc *desclist)
 {
-	/* on entry, address is in I0; data for writes is in I1, fetch type in I2 */
-	/* on exit, read result is in I0 */
-	/* routine trashes I0-I3 */
-	drcuml_state *drcuml = m_impstate.drcuml;
-	drcuml_block *block;
-	//int tlbmiss = 0;
-	int label = 1;
+	m_drcuml->log_printf("\nDescriptor list @ %08X\n", desclist->pc);
 
-	/* begin generating */
-	block = drcuml->begin_block(1024);
-
-	/* add a global entry for this */
-	alloc_handle(drcuml, handleptr, name);
-	UML_HANDLE(block, **handleptr);                                         // handle  *handleptr
-
-	if (istlb)
+	/* output each descriptor */
+	for ( ; desclist != nullptr; desclist = desclist->next())
 	{
-		UML_TEST(block, uml::mem(&COPRO_CTRL), COPRO_CTRL_MMU_EN);               // test     COPRO_CTRL, COPRO_CTRL_MMU_EN
-		if (iswrite)
-		{
-			UML_MOVc(block, uml::COND_NZ, uml::I3, ARM7_TLB_WRITE);                   // movnz    i3, ARM7_TLB_WRITE
-		}
-		else
-		{
-			UML_MOVc(block, uml::COND_NZ, uml::I3, ARM7_TLB_READ);                    // movnz    i3, ARM7_TLB_READ
-		}
-		UML_OR(block, uml::I2, uml::I2, uml::I3);                                          // or       i2, i2, i3
-		UML_CALLHc(block, uml::COND_NZ, *m_impstate.tlb_translate);          // callhnz  tlb_translate
+		char buffer[256];
+		drc_disassemble(buffer, desclist->pc, desclist->opptr.l[0], desclist->length == 2);
+		m_drcuml->log_printf("%08X t:%08X f:%08X %c %s\n", desclist->pc, desclist->targetpc, desclist->flags,
+				(desclist->userflags & arm7_frontend::USERFLAG_NATIVE) ? 'N' : 'I', buffer);
+
+		/* at the end of a sequence add a dividing line */
+		if (desclist->flags & OPFLAG_END_SEQUENCE)
+			m_drcuml->log_printf("-----\n");
 	}
+}
 
-	/* general case: assume paging and perform a translation */
-	if ((machine().debug_flags & DEBUG_FLAG_ENABLED) == 0)
-	{
-		for (int ramnum = 0; ramnum < ARM7_MAX_FASTRAM; ramnum++)
-		{
-			if (m_impstate.fastram[ramnum].base != nullptr && (!iswrite || !m_impstate.fastram[ramnum].readonly))
-			{
-				void *fastbase = (UINT8 *)m_impstate.fastram[ramnum].base - m_impstate.fastram[ramnum].start;
-				UINT32 skip = label++;
-				if (m_impstate.fastram[ramnum].end != 0xffffffff)
-				{
-					UML_CMP(block, uml::I0, m_impstate.fastram[ramnum].end);     // cmp     i0, end
-					UML_JMPc(block, uml::COND_A, skip);                              // ja      skip
-				}
-				if (m_impstate.fastram[ramnum].start != 0x00000000)
-				{
-					UML_CMP(block, uml::I0, m_impstate.fastram[ramnum].start);   // cmp     i0, fastram_start
-					UML_JMPc(block, uml::COND_B, skip);                              // jb      skip
-				}
-
-				if (!iswrite)
-				{
-					if (size == 1)
-					{
-						UML_XOR(block, uml::I0, uml::I0, (m_endian == ENDIANNESS_BIG) ? BYTE4_XOR_BE(0) : BYTE4_XOR_LE(0));
-																						// xor     i0, i0, bytexor
-						UML_LOAD(block, uml::I0, fastbase, uml::I0, uml::SIZE_BYTE, uml::SCALE_x1);         // load    i0, fastbase, i0, byte
-					}
-					else if (size == 2)
-					{
-						UML_XOR(block, uml::I0, uml::I0, (m_endian == ENDIANNESS_BIG) ? WORD_XOR_BE(0) : WORD_XOR_LE(0));
-																						// xor     i0, i0, wordxor
-						UML_LOAD(block, uml::I0, fastbase, uml::I0, uml::SIZE_WORD, uml::SCALE_x1);         // load    i0, fastbase, i0, word_x1
-					}
-					else if (size == 4)
-					{
-						UML_LOAD(block, uml::I0, fastbase, uml::I0, uml::SIZE_DWORD, uml::SCALE_x1);        // load    i0, fastbase, i0, dword_x1
-					}
-					UML_RET(block);                                                     // ret
-				}
-				else
-				{
-					if (size == 1)
-					{
-						UML_XOR(block, uml::I0, uml::I0, (m_endian == ENDIANNESS_BIG) ? BYTE4_XOR_BE(0) : BYTE4_XOR_LE(0));
-																						// xor     i0, i0, bytexor
-						UML_STORE(block, fastbase, uml::I0, uml::I1, uml::SIZE_BYTE, uml::SCALE_x1);        // store   fastbase, i0, i1, byte
-					}
-					else if (size == 2)
-					{
-						UML_XOR(block, uml::I0, uml::I0, (m_endian == ENDIANNESS_BIG) ? WORD_XOR_BE(0) : WORD_XOR_LE(0));
-																						// xor     i0, i0, wordxor
-						UML_STORE(block, fastbase, uml::I0, uml::I1, uml::SIZE_WORD, uml::SCALE_x1);        // store   fastbase, i0, i1, word_x1
-					}
-					else if (size == 4)
-					{
-						UML_STORE(block, fastbase, uml::I0, uml::I1, uml::SIZE_DWORD, uml::SCALE_x1);       // store   fastbase,i0,i1,dword_x1
-					}
-					UML_RET(block);                                                     // ret
-				}
 
-				UML_LABEL(block, skip);                                                 // skip:
-			}
-		}
-	}
+/*-------------------------------------------------
+    log_add_disasm_comment - add a comment
+    including disassembly of an instruction
+-------------------------------------------------*/
 
-	switch (size)
+void arm7_cpu_device::log_add_disasm_comment(drcuml_block *block, const opcode_desc *desc)
+{
+	if (m_drcuml->logging())
 	{
-		case 1:
-			if (iswrite)
-			{
-				UML_WRITE(block, uml::I0, uml::I1, uml::SIZE_BYTE, uml::SPACE_PROGRAM);                 // write   i0, i1, program_byte
-			}
-			else
-			{
-				UML_READ(block, uml::I0, uml::I0, uml::SIZE_BYTE, uml::SPACE_PROGRAM);                  // read    i0, i0, program_byte
-			}
-			break;
-
-		case 2:
-			if (iswrite)
-			{
-				UML_WRITE(block, uml::I0, uml::I1, uml::SIZE_WORD, uml::SPACE_PROGRAM);                 // write   i0,i1,program_word
-			}
-			else
-			{
-				UML_READ(block, uml::I0, uml::I0, uml::SIZE_WORD, uml::SPACE_PROGRAM);                  // read    i0,i0,program_word
-			}
-			break;
-
-		case 4:
-			if (iswrite)
-			{
-				UML_WRITE(block, uml::I0, uml::I1, uml::SIZE_DWORD, uml::SPACE_PROGRAM);                // write   i0,i1,program_dword
-			}
-			else
-			{
-				UML_READ(block, uml::I0, uml::I0, uml::SIZE_DWORD, uml::SPACE_PROGRAM);                 // read    i0,i0,program_dword
-			}
-			break;
+		char buffer[256];
+		drc_disassemble(buffer, desc->pc, desc->opptr.l[0], desc->length == 2);
+		block->append_comment("%08X: %s", desc->pc, buffer);                             // comment
 	}
-	UML_RET(block);                                                                 // ret
-
-	block->end();
 }
 
+
 /***************************************************************************
-    CODE GENERATION
+    INSTRUCTION CODEGEN
 ***************************************************************************/
 
 /*-------------------------------------------------
@@ -1162,23 +572,13 @@ void arm7_cpu_device::static_generate_memory_accessor(int size, bool istlb, bool
     an exception if out
 -------------------------------------------------*/
 
-void arm7_cpu_device::generate_update_cycles(drcuml_block *block, compiler_state *compiler, uml::parameter param)
+void arm7_cpu_device::generate_update_cycles(drcuml_block *block, compiler_state *compiler, uml::parameter param, bool allow_exception)
 {
-	/* check full interrupts if pending */
-	if (compiler->checkints)
-	{
-		uml::code_label skip;
-
-		compiler->checkints = FALSE;
-		UML_CALLH(block, *m_impstate.check_irq);
-	}
-
-	/* account for cycles */
-	if (compiler->cycles > 0)
+	if (compiler->cycles != 0)
 	{
-		UML_SUB(block, uml::mem(&m_icount), uml::mem(&m_icount), MAPVAR_CYCLES);    // sub     icount,icount,cycles
-		UML_MAPVAR(block, MAPVAR_CYCLES, 0);                                    // mapvar  cycles,0
-		UML_EXHc(block, uml::COND_S, *m_impstate.out_of_cycles, param);          // exh     out_of_cycles,nextpc
+		UML_SUB(block, uml::mem(&m_drcstate->icount), uml::mem(&m_drcstate->icount), compiler->cycles); // sub     icount,icount,cycles
+		if (allow_exception)
+			UML_EXHc(block, uml::COND_LE, *m_out_of_cycles, param);                     // exh     out_of_cycles,nextpc
 	}
 	compiler->cycles = 0;
 }
@@ -1186,65 +586,48 @@ void arm7_cpu_device::generate_update_cycles(drcuml_block *block, compiler_state
 
 /*-------------------------------------------------
     generate_checksum_block - generate code to
-    validate a sequence of opcodes
+    validate the natively compiled instructions
+    in a sequence
 -------------------------------------------------*/
 
 void arm7_cpu_device::generate_checksum_block(drcuml_block *block, compiler_state *compiler, const opcode_desc *seqhead, const opcode_desc *seqlast)
 {
 	const opcode_desc *curdesc;
-	if (m_impstate.drcuml->logging())
-	{
-		block->append_comment("[Validation for %08X]", seqhead->pc);                // comment
-	}
+	UINT32 sum = 0;
+	bool first = true;
 
-	/* loose verify or single instruction: just compare and fail */
-	if (!(m_impstate.drcoptions & ARM7DRC_STRICT_VERIFY) || seqhead->next() == nullptr)
-	{
-		if (!(seqhead->flags & OPFLAG_VIRTUAL_NOOP))
-		{
-			UINT32 sum = seqhead->opptr.l[0];
-			void *base = m_direct->read_ptr(seqhead->physpc);
-			UML_LOAD(block, uml::I0, base, 0, uml::SIZE_DWORD, uml::SCALE_x4);             // load    i0,base,0,dword
+	if (m_drcuml->logging())
+		block->append_comment("[Validation for %08X]", seqhead->pc);                    // comment
 
-			if (seqhead->delay.first() != nullptr && seqhead->physpc != seqhead->delay.first()->physpc)
+	/* interpreted instructions always fetch what is in memory, so only native ones need checking */
+	for (curdesc = seqhead; curdesc != seqlast->next(); curdesc = curdesc->next())
+		if (curdesc->userflags & arm7_frontend::USERFLAG_NATIVE)
+		{
+			if (curdesc->length == 2)
 			{
-				base = m_direct->read_ptr(seqhead->delay.first()->physpc);
-				UML_LOAD(block, uml::I1, base, 0, uml::SIZE_DWORD, uml::SCALE_x4);         // load    i1,base,dword
-				UML_ADD(block, uml::I0, uml::I0, uml::I1);                                 // add     i0,i0,i1
-
-				sum += seqhead->delay.first()->opptr.l[0];
+				/* halfwords live inside native-order dwords */
+				void *base = m_direct->read_ptr(curdesc->physpc, (m_endian == ENDIANNESS_LITTLE) ? WORD_XOR_LE(0) : WORD_XOR_BE(0));
+				UML_LOAD(block, first ? uml::I0 : uml::I1, base, 0, uml::SIZE_WORD, uml::SCALE_x2); // load    i0/i1,base,word
 			}
-
-			UML_CMP(block, uml::I0, sum);                                        // cmp     i0,opptr[0]
-			UML_EXHc(block, uml::COND_NE, *m_impstate.nocode, epc(seqhead)); // exne    nocode,seqhead->pc
+			else
+			{
+				void *base = m_direct->read_ptr(curdesc->physpc);
+				UML_LOAD(block, first ? uml::I0 : uml::I1, base, 0, uml::SIZE_DWORD, uml::SCALE_x4); // load    i0/i1,base,dword
+			}
+			if (!first)
+				UML_ADD(block, uml::I0, uml::I0, uml::I1);                                  // add     i0,i0,i1
+			sum += curdesc->opptr.l[0];
+			first = false;
+
+			/* without strict verification, only the first native instruction is checked */
+			if (!(m_drcoptions & ARM7DRC_STRICT_VERIFY))
+				break;
 		}
-	}
 
-	/* full verification; sum up everything */
-	else
+	if (!first)
 	{
-		UINT32 sum = 0;
-		void *base = m_direct->read_ptr(seqhead->physpc);
-		UML_LOAD(block, uml::I0, base, 0, uml::SIZE_DWORD, uml::SCALE_x4);                 // load    i0,base,0,dword
-		sum += seqhead->opptr.l[0];
-		for (curdesc = seqhead->next(); curdesc != seqlast->next(); curdesc = curdesc->next())
-			if (!(curdesc->flags & OPFLAG_VIRTUAL_NOOP))
-			{
-				base = m_direct->read_ptr(curdesc->physpc);
-				UML_LOAD(block, uml::I1, base, 0, uml::SIZE_DWORD, uml::SCALE_x4);         // load    i1,base,dword
-				UML_ADD(block, uml::I0, uml::I0, uml::I1);                                 // add     i0,i0,i1
-				sum += curdesc->opptr.l[0];
-
-				if (curdesc->delay.first() != nullptr && (curdesc == seqlast || (curdesc->next() != nullptr && curdesc->next()->physpc != curdesc->delay.first()->physpc)))
-				{
-					base = m_direct->read_ptr(curdesc->delay.first()->physpc);
-					UML_LOAD(block, uml::I1, base, 0, uml::SIZE_DWORD, uml::SCALE_x4);     // load    i1,base,dword
-					UML_ADD(block, uml::I0, uml::I0, uml::I1);                             // add     i0,i0,i1
-					sum += curdesc->delay.first()->opptr.l[0];
-				}
-			}
-		UML_CMP(block, uml::I0, sum);                                            // cmp     i0,sum
-		UML_EXHc(block, uml::COND_NE, *m_impstate.nocode, epc(seqhead));     // exne    nocode,seqhead->pc
+		UML_CMP(block, uml::I0, sum);                                                   // cmp     i0,sum
+		UML_EXHc(block, uml::COND_NE, *m_nocode, seqhead->pc);                          // exne    nocode,seqhead->pc
 	}
 }
 
@@ -1256,579 +639,552 @@ void arm7_cpu_device::generate_checksum_block(drcuml_block *block, compiler_stat
 
 void arm7_cpu_device::generate_sequence_instruction(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc)
 {
-	//offs_t expc;
-	int hotnum;
-
 	/* add an entry for the log */
-	// TODO FIXME
-//  if (m_impstate.drcuml->logging() && !(desc->flags & OPFLAG_VIRTUAL_NOOP))
-//      log_add_disasm_comment(block, desc->pc, desc->opptr.l[0]);
+	log_add_disasm_comment(block, desc);
 
-	/* set the PC map variable */
-	//expc = (desc->flags & OPFLAG_IN_DELAY_SLOT) ? desc->pc - 3 : desc->pc;
-	UML_MAPVAR(block, MAPVAR_PC, desc->pc);                                 // mapvar  PC,pc
+	/* everything outside the native set goes to the interpreter, which counts its own cycles */
+	if (!(desc->userflags & arm7_frontend::USERFLAG_NATIVE))
+	{
+		generate_interpret(block, compiler, desc);
+		return;
+	}
 
 	/* accumulate total cycles */
 	compiler->cycles += desc->cycles;
 
-	/* update the icount map variable */
-	UML_MAPVAR(block, MAPVAR_CYCLES, compiler->cycles);                     // mapvar  CYCLES,compiler->cycles
+	if (compiler->mode != 0)
+		generate_thumb_opcode(block, compiler, desc);
+	else
+		generate_arm_opcode(block, compiler, desc);
+}
 
-	/* is this a hotspot? */
-	for (hotnum = 0; hotnum < ARM7_MAX_HOTSPOTS; hotnum++)
-	{
-		if (m_impstate.hotspot[hotnum].pc != 0 && desc->pc == m_impstate.hotspot[hotnum].pc && desc->opptr.l[0] == m_impstate.hotspot[hotnum].opcode)
-		{
-			compiler->cycles += m_impstate.hotspot[hotnum].cycles;
-			break;
-		}
-	}
 
-	/* update the icount map variable */
-	UML_MAPVAR(block, MAPVAR_CYCLES, compiler->cycles);                     // mapvar  CYCLES,compiler->cycles
+/*-------------------------------------------------
+    generate_interpret - generate code to run an
+    instruction through the interpreter
+-------------------------------------------------*/
 
-	/* if we are debugging, call the debugger */
-	if ((machine().debug_flags & DEBUG_FLAG_ENABLED) != 0)
+void arm7_cpu_device::generate_interpret(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc)
+{
+	/* the interpreter counts its own cycles, so settle ours first */
+	generate_update_cycles(block, compiler, desc->pc, true);                            // <subtract cycles>
+
+	UML_MOV(block, DRC_PC, desc->pc);                                                   // mov     [pc],desc->pc
+	UML_CALLC(block, cfunc_arm7_interpret, this);                                       // callc   interpret,this
+	UML_CMP(block, uml::mem(&m_drcstate->exit), 0);                                     // cmp     [exit],0
+	UML_EXITc(block, uml::COND_NE, EXECUTE_INTERPRET);                                  // exitne  EXECUTE_INTERPRET
+	UML_CMP(block, uml::mem(&m_drcstate->icount), 0);                                   // cmp     [icount],0
+	UML_EXITc(block, uml::COND_LE, EXECUTE_OUT_OF_CYCLES);                              // exitle  EXECUTE_OUT_OF_CYCLES
+
+	/* go wherever the instruction went, carrying on inline if that is the next one in the same state */
+	if (!(desc->flags & OPFLAG_IS_UNCONDITIONAL_BRANCH))
 	{
-		UML_MOV(block, uml::mem(&R15), desc->pc);                                // mov     [pc],desc->pc
-		save_fast_iregs(block);
-		UML_DEBUG(block, desc->pc);                                         // debug   desc->pc
+		uml::code_label redispatch = compiler->labelnum++;
+		uml::code_label skip = compiler->labelnum++;
+		UML_CMP(block, uml::mem(&m_drcstate->mode), compiler->mode);                    // cmp     [mode],mode
+		UML_JMPc(block, uml::COND_NE, redispatch);                                      // jne     redispatch
+		UML_CMP(block, DRC_PC, desc->pc + desc->length);                                // cmp     [pc],nextpc
+		UML_JMPc(block, uml::COND_E, skip);                                             // je      skip
+		UML_LABEL(block, redispatch);                                                   // redispatch:
+		UML_HASHJMP(block, uml::mem(&m_drcstate->mode), DRC_PC, *m_nocode);             // hashjmp [mode],[pc],nocode
+		UML_LABEL(block, skip);                                                         // skip:
 	}
+	else
+		UML_HASHJMP(block, uml::mem(&m_drcstate->mode), DRC_PC, *m_nocode);             // hashjmp [mode],[pc],nocode
+}
 
-	/* if we hit an unmapped address, fatal error */
-	if (desc->flags & OPFLAG_COMPILER_UNMAPPED)
+
+/*-------------------------------------------------
+    generate_branch_to - generate code to leave
+    the sequence for a fixed target
+-------------------------------------------------*/
+
+void arm7_cpu_device::generate_branch_to(drcuml_block *block, compiler_state *compiler, offs_t targetpc)
+{
+	generate_update_cycles(block, compiler, targetpc, true);                            // <subtract cycles>
+	UML_HASHJMP(block, compiler->mode, targetpc, *m_nocode);                            // hashjmp mode,targetpc,nocode
+}
+
+
+/*-------------------------------------------------
+    generate_condition - generate code to set I0
+    to 1 if the given ARM condition holds, 0 if
+    not
+-------------------------------------------------*/
+
+void arm7_cpu_device::generate_condition(drcuml_block *block, int cond)
+{
+	switch (cond & ~1)
 	{
-		UML_MOV(block, uml::mem(&R15), desc->pc);                                // mov     R15,desc->pc
-		save_fast_iregs(block);
-		UML_EXIT(block, EXECUTE_UNMAPPED_CODE);                             // exit    EXECUTE_UNMAPPED_CODE
+		case COND_EQ:   // EQ/NE
+			UML_TEST(block, DRC_CPSR, Z_MASK);                                          // test    cpsr,Z_MASK
+			UML_SETc(block, uml::COND_NZ, uml::I0);                                     // setnz   i0
+			break;
+
+		case COND_CS:   // CS/CC
+			UML_TEST(block, DRC_CPSR, C_MASK);                                          // test    cpsr,C_MASK
+			UML_SETc(block, uml::COND_NZ, uml::I0);                                     // setnz   i0
+			break;
+
+		case COND_MI:   // MI/PL
+			UML_TEST(block, DRC_CPSR, N_MASK);                                          // test    cpsr,N_MASK
+			UML_SETc(block, uml::COND_NZ, uml::I0);                                     // setnz   i0
+			break;
+
+		case COND_VS:   // VS/VC
+			UML_TEST(block, DRC_CPSR, V_MASK);                                          // test    cpsr,V_MASK
+			UML_SETc(block, uml::COND_NZ, uml::I0);                                     // setnz   i0
+			break;
+
+		case COND_HI:   // HI/LS
+			UML_AND(block, uml::I0, DRC_CPSR, C_MASK | Z_MASK);                         // and     i0,cpsr,C_MASK | Z_MASK
+			UML_CMP(block, uml::I0, C_MASK);                                            // cmp     i0,C_MASK
+			UML_SETc(block, uml::COND_E, uml::I0);                                      // sete    i0
+			break;
+
+		case COND_GE:   // GE/LT
+			UML_SHR(block, uml::I0, DRC_CPSR, N_BIT - V_BIT);                           // shr     i0,cpsr,N_BIT - V_BIT
+			UML_XOR(block, uml::I0, uml::I0, DRC_CPSR);                                 // xor     i0,i0,cpsr
+			UML_TEST(block, uml::I0, V_MASK);                                           // test    i0,V_MASK
+			UML_SETc(block, uml::COND_Z, uml::I0);                                      // setz    i0
+			break;
+
+		case COND_GT:   // GT/LE
+			UML_SHR(block, uml::I0, DRC_CPSR, N_BIT - V_BIT);                           // shr     i0,cpsr,N_BIT - V_BIT
+			UML_XOR(block, uml::I0, uml::I0, DRC_CPSR);                                 // xor     i0,i0,cpsr
+			UML_AND(block, uml::I0, uml::I0, V_MASK);                                   // and     i0,i0,V_MASK
+			UML_AND(block, uml::I1, DRC_CPSR, Z_MASK);                                  // and     i1,cpsr,Z_MASK
+			UML_OR(block, uml::I0, uml::I0, uml::I1);                                   // or      i0,i0,i1
+			UML_CMP(block, uml::I0, 0);                                                 // cmp     i0,0
+			UML_SETc(block, uml::COND_E, uml::I0);                                      // sete    i0
+			break;
+
+		case COND_AL:   // AL/NV
+			UML_MOV(block, uml::I0, 1);                                                 // mov     i0,1
+			break;
 	}
 
-	/* otherwise, unless this is a virtual no-op, it's a regular instruction */
-	else if (!(desc->flags & OPFLAG_VIRTUAL_NOOP))
+	/* the code above computes the even-numbered condition of each pair */
+	if (cond & 1)
+		UML_XOR(block, uml::I0, uml::I0, 1);                                            // xor     i0,i0,1
+}
+
+
+/*-------------------------------------------------
+    generate_logic_flags - set N and Z from the
+    32-bit result in I0, and C as described by
+    the shifter carry
+-------------------------------------------------*/
+
+void arm7_cpu_device::generate_logic_flags(drcuml_block *block, int carry)
+{
+	UINT32 mask = N_MASK | Z_MASK;
+
+	UML_AND(block, uml::I3, uml::I0, N_MASK);                                           // and     i3,i0,N_MASK
+	UML_CMP(block, uml::I0, 0);                                                         // cmp     i0,0
+	UML_SETc(block, uml::COND_E, uml::I1);                                              // sete    i1
+	UML_SHL(block, uml::I1, uml::I1, Z_BIT);                                            // shl     i1,i1,Z_BIT
+	UML_OR(block, uml::I3, uml::I3, uml::I1);                                           // or      i3,i3,i1
+	if (carry != CARRY_UNCHANGED)
 	{
-		/* compile the instruction */
-		if (!generate_opcode(block, compiler, desc))
+		mask |= C_MASK;
+		if (carry == CARRY_IN_I2)
 		{
-			UML_MOV(block, uml::mem(&R15), desc->pc);                            // mov     R15,desc->pc
-			UML_MOV(block, uml::mem(&m_impstate.arg0), desc->opptr.l[0]);    // mov     [arg0],desc->opptr.l
-			//UML_CALLC(block, cfunc_unimplemented, arm);                     // callc   cfunc_unimplemented // TODO FIXME
+			UML_SHL(block, uml::I2, uml::I2, C_BIT);                                    // shl     i2,i2,C_BIT
+			UML_OR(block, uml::I3, uml::I3, uml::I2);                                   // or      i3,i3,i2
 		}
+		else if (carry == CARRY_SET)
+			UML_OR(block, uml::I3, uml::I3, C_MASK);                                    // or      i3,i3,C_MASK
 	}
+	UML_AND(block, DRC_CPSR, DRC_CPSR, ~mask);                                          // and     cpsr,cpsr,~mask
+	UML_OR(block, DRC_CPSR, DRC_CPSR, uml::I3);                                         // or      cpsr,cpsr,i3
+}
+
+
+/*-------------------------------------------------
+    generate_arith_flags - set NZCV from the
+    32-bit result in I0 of the UML add or sub
+    just generated
+-------------------------------------------------*/
+
+void arm7_cpu_device::generate_arith_flags(drcuml_block *block, bool sub)
+{
+	/* ARM's carry after a subtract is the inverse of the borrow */
+	UML_SETc(block, sub ? uml::COND_NC : uml::COND_C, uml::I2);                         // setc    i2
+	UML_SETc(block, uml::COND_V, uml::I3);                                              // setv    i3
+	UML_SHL(block, uml::I2, uml::I2, C_BIT);                                            // shl     i2,i2,C_BIT
+	UML_SHL(block, uml::I3, uml::I3, V_BIT);                                            // shl     i3,i3,V_BIT
+	UML_OR(block, uml::I3, uml::I3, uml::I2);                                           // or      i3,i3,i2
+	UML_AND(block, uml::I2, uml::I0, N_MASK);                                           // and     i2,i0,N_MASK
+	UML_OR(block, uml::I3, uml::I3, uml::I2);                                           // or      i3,i3,i2
+	UML_CMP(block, uml::I0, 0);                                                         // cmp     i0,0
+	UML_SETc(block, uml::COND_E, uml::I1);                                              // sete    i1
+	UML_SHL(block, uml::I1, uml::I1, Z_BIT);                                            // shl     i1,i1,Z_BIT
+	UML_OR(block, uml::I3, uml::I3, uml::I1);                                           // or      i3,i3,i1
+	UML_AND(block, DRC_CPSR, DRC_CPSR, ~(N_MASK | Z_MASK | C_MASK | V_MASK));           // and     cpsr,cpsr,~NZCV
+	UML_OR(block, DRC_CPSR, DRC_CPSR, uml::I3);                                         // or      cpsr,cpsr,i3
 }
 
 
-/*------------------------------------------------------------------
-    generate_delay_slot_and_branch
-------------------------------------------------------------------*/
+/*-------------------------------------------------
+    generate_shift_imm - generate code to put a
+    register shifted by an immediate into I1,
+    returning where the shifter carry ends up
+-------------------------------------------------*/
 
-void arm7_cpu_device::generate_delay_slot_and_branch(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT8 linkreg)
+int arm7_cpu_device::generate_shift_imm(drcuml_block *block, UINT32 insn, offs_t pc, bool wantcarry)
 {
-	compiler_state compiler_temp = *compiler;
+	int rm = insn & INSN_OP2_RM;
+	UINT32 k = (insn & INSN_OP2_SHIFT) >> INSN_OP2_SHIFT_SHIFT;
+	uml::parameter src = DRC_REG(rm);
 
-	/* update the cycles and jump through the hash table to the target */
-	if (desc->targetpc != BRANCH_TARGET_DYNAMIC)
+	/* the PC reads as the address of the instruction plus 8 */
+	if (rm == eR15)
 	{
-		generate_update_cycles(block, &compiler_temp, desc->targetpc);   // <subtract cycles>
-		UML_HASHJMP(block, 0, desc->targetpc, *m_impstate.nocode);
-																					// hashjmp 0,desc->targetpc,nocode
+		UML_MOV(block, uml::I0, pc + 8);                                                // mov     i0,pc+8
+		src = uml::I0;
 	}
-	else
+
+	switch ((insn & INSN_OP2_SHIFT_TYPE) >> (INSN_OP2_SHIFT_TYPE_SHIFT + 1))
 	{
-		generate_update_cycles(block, &compiler_temp, uml::mem(&m_impstate.jmpdest));
-																					// <subtract cycles>
-		UML_HASHJMP(block, 0, uml::mem(&m_impstate.jmpdest), *m_impstate.nocode);// hashjmp 0,<rsreg>,nocode
-	}
+		case 0:     /* LSL */
+			if (k == 0)
+			{
+				UML_MOV(block, uml::I1, src);                                           // mov     i1,rm
+				return CARRY_UNCHANGED;
+			}
+			if (wantcarry)
+			{
+				UML_SHR(block, uml::I2, src, 32 - k);                                   // shr     i2,rm,32-k
+				UML_AND(block, uml::I2, uml::I2, 1);                                    // and     i2,i2,1
+			}
+			UML_SHL(block, uml::I1, src, k);                                            // shl     i1,rm,k
+			break;
 
-	/* update the label */
-	compiler->labelnum = compiler_temp.labelnum;
+		case 1:     /* LSR; #0 means #32 */
+			if (wantcarry)
+				UML_SHR(block, uml::I2, src, (k == 0) ? 31 : k - 1);                    // shr     i2,rm,k-1
+			if (k == 0)
+				UML_MOV(block, uml::I1, 0);                                             // mov     i1,0
+			else
+				UML_SHR(block, uml::I1, src, k);                                        // shr     i1,rm,k
+			break;
+
+		case 2:     /* ASR; #0 means #32 */
+			if (wantcarry)
+				UML_SHR(block, uml::I2, src, (k == 0) ? 31 : k - 1);                    // shr     i2,rm,k-1
+			UML_SAR(block, uml::I1, src, (k == 0) ? 31 : k);                            // sar     i1,rm,k
+			break;
 
-	/* reset the mapvar to the current cycles and account for skipped slots */
-	compiler->cycles += desc->skipslots;
-	UML_MAPVAR(block, MAPVAR_CYCLES, compiler->cycles);                             // mapvar  CYCLES,compiler->cycles
+		case 3:     /* ROR; #0 means RRX */
+			if (wantcarry)
+				UML_SHR(block, uml::I2, src, (k == 0) ? 0 : k - 1);                     // shr     i2,rm,k-1
+			if (k == 0)
+			{
+				UML_AND(block, uml::I3, DRC_CPSR, C_MASK);                              // and     i3,cpsr,C_MASK
+				UML_SHL(block, uml::I3, uml::I3, 31 - C_BIT);                           // shl     i3,i3,31-C_BIT
+				UML_SHR(block, uml::I1, src, 1);                                        // shr     i1,rm,1
+				UML_OR(block, uml::I1, uml::I1, uml::I3);                               // or      i1,i1,i3
+			}
+			else
+				UML_ROR(block, uml::I1, src, k);                                        // ror     i1,rm,k
+			break;
+	}
+
+	if (wantcarry && (insn & INSN_OP2_SHIFT_TYPE) != 0)
+		UML_AND(block, uml::I2, uml::I2, 1);                                            // and     i2,i2,1
+	return CARRY_IN_I2;
 }
 
 
-const arm7_cpu_device::drcarm7ops_ophandler arm7_cpu_device::drcops_handler[0x10] =
-{
-	&arm7_cpu_device::drcarm7ops_0123, &arm7_cpu_device::drcarm7ops_0123, &arm7_cpu_device::drcarm7ops_0123, &arm7_cpu_device::drcarm7ops_0123,
-	&arm7_cpu_device::drcarm7ops_4567, &arm7_cpu_device::drcarm7ops_4567, &arm7_cpu_device::drcarm7ops_4567, &arm7_cpu_device::drcarm7ops_4567,
-	&arm7_cpu_device::drcarm7ops_89,   &arm7_cpu_device::drcarm7ops_89,   &arm7_cpu_device::drcarm7ops_ab,   &arm7_cpu_device::drcarm7ops_ab,
-	&arm7_cpu_device::drcarm7ops_cd,   &arm7_cpu_device::drcarm7ops_cd,   &arm7_cpu_device::drcarm7ops_e,    &arm7_cpu_device::drcarm7ops_f,
-};
+/*-------------------------------------------------
+    generate_alu - generate code for a data
+    processing operation on op1 and op2, using
+    the ARM opcode numbering
+-------------------------------------------------*/
 
-void arm7_cpu_device::saturate_qbit_overflow(drcuml_block *block)
+void arm7_cpu_device::generate_alu(drcuml_block *block, int opcode, int rd, uml::parameter op1, uml::parameter op2, bool setflags, int carry)
 {
-	UML_MOV(block, uml::I1, 0);
-	UML_DCMP(block, uml::I0, 0x000000007fffffffL);
-	UML_MOVc(block, uml::COND_G, uml::I1, Q_MASK);
-	UML_MOVc(block, uml::COND_G, uml::I0, 0x7fffffff);
-	UML_DCMP(block, uml::I0, U64(0xffffffff80000000));
-	UML_MOVc(block, uml::COND_L, uml::I1, Q_MASK);
-	UML_MOVc(block, uml::COND_L, uml::I0, 0x80000000);
-	UML_OR(block, DRC_CPSR, DRC_CPSR, uml::I1);
-}
+	bool arith = true;
+	bool sub = false;
 
-bool arm7_cpu_device::drcarm7ops_0123(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT32 insn)
-{
-	uml::code_label done;
-	/* Branch and Exchange (BX) */
-	if ((insn & 0x0ffffff0) == 0x012fff10)     // bits 27-4 == 000100101111111111110001
+	switch (opcode)
 	{
-		UML_MOV(block, DRC_PC, DRC_REG(insn & 0x0f));
-		UML_TEST(block, DRC_PC, 1);
-		UML_JMPc(block, uml::COND_Z, done = compiler->labelnum++);
-		UML_OR(block, DRC_CPSR, DRC_CPSR, T_MASK);
-		UML_AND(block, DRC_PC, DRC_PC, ~1);
-	}
-	else if ((insn & 0x0ff000f0) == 0x01600010) // CLZ - v5
-	{
-		UINT32 rm = insn&0xf;
-		UINT32 rd = (insn>>12)&0xf;
+		case OPCODE_AND:
+		case OPCODE_TST:
+			UML_AND(block, uml::I0, op1, op2);                                          // and     i0,rn,op2
+			arith = false;
+			break;
 
-		UML_LZCNT(block, DRC_REG(rd), DRC_REG(rm));
-		UML_ADD(block, DRC_PC, DRC_PC, 4);
-	}
-	else if ((insn & 0x0ff000f0) == 0x01000050) // QADD - v5
-	{
-		UINT32 rm = insn&0xf;
-		UINT32 rn = (insn>>16)&0xf;
-		UINT32 rd = (insn>>12)&0xf;
-		UML_DSEXT(block, uml::I0, DRC_REG(rm), uml::SIZE_DWORD);
-		UML_DSEXT(block, uml::I1, DRC_REG(rn), uml::SIZE_DWORD);
-		UML_DADD(block, uml::I0, uml::I0, uml::I1);
-		saturate_qbit_overflow(block);
-		UML_MOV(block, DRC_REG(rd), uml::I0);
-		UML_ADD(block, DRC_PC, DRC_PC, 4);
-	}
-	else if ((insn & 0x0ff000f0) == 0x01400050) // QDADD - v5
-	{
-		UINT32 rm = insn&0xf;
-		UINT32 rn = (insn>>16)&0xf;
-		UINT32 rd = (insn>>12)&0xf;
-
-		UML_DSEXT(block, uml::I1, DRC_REG(rn), uml::SIZE_DWORD);
-		UML_DADD(block, uml::I0, uml::I1, uml::I1);
-		saturate_qbit_overflow(block);
-
-		UML_DSEXT(block, uml::I0, DRC_REG(rm), uml::SIZE_DWORD);
-		UML_DSEXT(block, uml::I1, DRC_REG(rn), uml::SIZE_DWORD);
-		UML_DADD(block, uml::I1, uml::I1, uml::I1);
-		UML_DADD(block, uml::I0, uml::I0, uml::I1);
-		saturate_qbit_overflow(block);
-		UML_MOV(block, DRC_REG(rd), uml::I0);
-
-		UML_ADD(block, DRC_PC, DRC_PC, 4);
-	}
-	else if ((insn & 0x0ff000f0) == 0x01200050) // QSUB - v5
-	{
-		UINT32 rm = insn&0xf;
-		UINT32 rn = (insn>>16)&0xf;
-		UINT32 rd = (insn>>12)&0xf;
-
-		UML_DSEXT(block, uml::I0, DRC_REG(rm), uml::SIZE_DWORD);
-		UML_DSEXT(block, uml::I1, DRC_REG(rn), uml::SIZE_DWORD);
-		UML_DSUB(block, uml::I0, uml::I0, uml::I1);
-		saturate_qbit_overflow(block);
-		UML_MOV(block, DRC_REG(rd), uml::I0);
-		UML_ADD(block, DRC_PC, DRC_PC, 4);
-	}
-	else if ((insn & 0x0ff000f0) == 0x01600050) // QDSUB - v5
-	{
-		UINT32 rm = insn&0xf;
-		UINT32 rn = (insn>>16)&0xf;
-		UINT32 rd = (insn>>12)&0xf;
-
-		UML_DSEXT(block, uml::I1, DRC_REG(rn), uml::SIZE_DWORD);
-		UML_DADD(block, uml::I0, uml::I1, uml::I1);
-		saturate_qbit_overflow(block);
-
-		UML_DSEXT(block, uml::I0, DRC_REG(rm), uml::SIZE_DWORD);
-		UML_DSEXT(block, uml::I1, DRC_REG(rn), uml::SIZE_DWORD);
-		UML_DADD(block, uml::I1, uml::I1, uml::I1);
-		UML_DSUB(block, uml::I0, uml::I0, uml::I1);
-		saturate_qbit_overflow(block);
-		UML_MOV(block, DRC_REG(rd), uml::I0);
-
-		UML_ADD(block, DRC_PC, DRC_PC, 4);
-	}
-	else if ((insn & 0x0ff00090) == 0x01000080) // SMLAxy - v5
-	{
-		UINT32 rm = insn&0xf;
-		UINT32 rn = (insn>>8)&0xf;
-		UINT32 rd = (insn>>16)&0xf;
-		UINT32 ra = (insn>>12)&0xf;
+		case OPCODE_EOR:
+		case OPCODE_TEQ:
+			UML_XOR(block, uml::I0, op1, op2);                                          // xor     i0,rn,op2
+			arith = false;
+			break;
 
-		UML_MOV(block, uml::I0, DRC_REG(rm));
-		UML_MOV(block, uml::I1, DRC_REG(rn));
+		case OPCODE_SUB:
+		case OPCODE_CMP:
+			UML_SUB(block, uml::I0, op1, op2);                                          // sub     i0,rn,op2
+			sub = true;
+			break;
 
-		// select top and bottom halves of src1/src2 and sign extend if necessary
-		if (insn & 0x20)
-		{
-			UML_SHR(block, uml::I0, uml::I0, 16);
-		}
-		UML_SEXT(block, uml::I0, uml::I0, uml::SIZE_WORD);
+		case OPCODE_RSB:
+			UML_SUB(block, uml::I0, op2, op1);                                          // sub     i0,op2,rn
+			sub = true;
+			break;
 
-		if (insn & 0x40)
-		{
-			UML_SHR(block, uml::I1, uml::I1, 16);
-		}
-		UML_SEXT(block, uml::I0, uml::I0, uml::SIZE_WORD);
-
-		// do the signed multiply
-		UML_MULS(block, uml::I0, uml::I1, uml::I0, uml::I1);
-		UML_DSHL(block, uml::I0, uml::I0, 32);
-		UML_DOR(block, uml::I0, uml::I0, uml::I1);
-		UML_MOV(block, uml::I1, DRC_REG(ra));
-		UML_DADD(block, uml::I0, uml::I0, uml::I1);
-		// and the accumulate.  NOTE: only the accumulate can cause an overflow, which is why we do it this way.
-		saturate_qbit_overflow(block);
-		UML_MOV(block, DRC_REG(rd), uml::I0);
-		UML_ADD(block, DRC_PC, DRC_PC, 4);
-	}
-	else if ((insn & 0x0ff00090) == 0x01400080) // SMLALxy - v5
-	{
-		UINT32 rm = insn&0xf;
-		UINT32 rn = (insn>>8)&0xf;
-		UINT32 rdh = (insn>>16)&0xf;
-		UINT32 rdl = (insn>>12)&0xf;
-
-		UML_DSEXT(block, uml::I0, DRC_REG(rm), uml::SIZE_DWORD);
-		UML_DSEXT(block, uml::I1, DRC_REG(rn), uml::SIZE_DWORD);
-		// do the signed multiply
-		UML_DMULS(block, uml::I2, uml::I3, uml::I0, uml::I1);
-
-		UML_MOV(block, uml::I0, DRC_REG(rdh));
-		UML_MOV(block, uml::I1, DRC_REG(rdl));
-		UML_DSHL(block, uml::I0, uml::I0, 32);
-		UML_DOR(block, uml::I0, uml::I0, uml::I1);
-		UML_DADD(block, uml::I0, uml::I0, uml::I2);
-		UML_MOV(block, DRC_REG(rdl), uml::I0);
-		UML_DSHR(block, uml::I0, uml::I0, 32);
-		UML_MOV(block, DRC_REG(rdh), uml::I0);
-	}
-	else if ((insn & 0x0ff00090) == 0x01600080) // SMULxy - v5
-	{
-		INT32 src1 = GET_REGISTER(insn&0xf);
-		INT32 src2 = GET_REGISTER((insn>>8)&0xf);
-		INT32 res;
+		case OPCODE_ADD:
+		case OPCODE_CMN:
+			UML_ADD(block, uml::I0, op1, op2);                                          // add     i0,rn,op2
+			break;
 
-		// select top and bottom halves of src1/src2 and sign extend if necessary
-		if (insn & 0x20)
-		{
-			src1 >>= 16;
-		}
+		case OPCODE_ADC:
+			UML_CARRY(block, DRC_CPSR, C_BIT);                                          // carry   cpsr,C_BIT
+			UML_ADDC(block, uml::I0, op1, op2);                                         // addc    i0,rn,op2
+			break;
 
-		src1 &= 0xffff;
-		if (src1 & 0x8000)
-		{
-			src1 |= 0xffff0000;
-		}
+		case OPCODE_SBC:
+			UML_XOR(block, uml::I3, DRC_CPSR, C_MASK);                                  // xor     i3,cpsr,C_MASK
+			UML_CARRY(block, uml::I3, C_BIT);                                           // carry   i3,C_BIT
+			UML_SUBB(block, uml::I0, op1, op2);                                         // subb    i0,rn,op2
+			sub = true;
+			break;
 
-		if (insn & 0x40)
-		{
-			src2 >>= 16;
-		}
+		case OPCODE_RSC:
+			UML_XOR(block, uml::I3, DRC_CPSR, C_MASK);                                  // xor     i3,cpsr,C_MASK
+			UML_CARRY(block, uml::I3, C_BIT);                                           // carry   i3,C_BIT
+			UML_SUBB(block, uml::I0, op2, op1);                                         // subb    i0,op2,rn
+			sub = true;
+			break;
 
-		src2 &= 0xffff;
-		if (src2 & 0x8000)
-		{
-			src2 |= 0xffff0000;
-		}
+		case OPCODE_ORR:
+			UML_OR(block, uml::I0, op1, op2);                                           // or      i0,rn,op2
+			arith = false;
+			break;
 
-		res = src1 * src2;
-		SET_REGISTER((insn>>16)&0xf, res);
-		R15 += 4;
-	}
-	else if ((insn & 0x0ff000b0) == 0x012000a0) // SMULWy - v5
-	{
-		INT32 src1 = GET_REGISTER(insn&0xf);
-		INT32 src2 = GET_REGISTER((insn>>8)&0xf);
-		INT64 res;
+		case OPCODE_MOV:
+			UML_MOV(block, uml::I0, op2);                                               // mov     i0,op2
+			arith = false;
+			break;
 
-		if (insn & 0x40)
-		{
-			src2 >>= 16;
-		}
-		else
-		{
-			src2 &= 0xffff;
-			if (src2 & 0x8000)
+		case OPCODE_BIC:
+			if (op2.is_immediate())
+				UML_AND(block, uml::I0, op1, UINT32(~op2.immediate()));                  // and     i0,rn,~op2
+			else
 			{
-				src2 |= 0xffff;
+				UML_XOR(block, uml::I1, op2, ~0U);                                      // xor     i1,op2,~0
+				UML_AND(block, uml::I0, op1, uml::I1);                                  // and     i0,rn,i1
 			}
-		}
+			arith = false;
+			break;
 
-		res = (INT64)src1 * (INT64)src2;
-		res >>= 16;
-		SET_REGISTER((insn>>16)&0xf, (UINT32)res);
+		case OPCODE_MVN:
+			UML_XOR(block, uml::I0, op2, ~0U);                                          // xor     i0,op2,~0
+			arith = false;
+			break;
 	}
-	else if ((insn & 0x0ff000b0) == 0x01200080) // SMLAWy - v5
-	{
-		INT32 src1 = GET_REGISTER(insn&0xf);
-		INT32 src2 = GET_REGISTER((insn>>8)&0xf);
-		INT32 src3 = GET_REGISTER((insn>>12)&0xf);
-		INT64 res;
 
-		if (insn & 0x40)
-		{
-			src2 >>= 16;
-		}
+	if (setflags)
+	{
+		if (arith)
+			generate_arith_flags(block, sub);
 		else
-		{
-			src2 &= 0xffff;
-			if (src2 & 0x8000)
-			{
-				src2 |= 0xffff;
-			}
-		}
+			generate_logic_flags(block, carry);
+	}
 
-		res = (INT64)src1 * (INT64)src2;
-		res >>= 16;
+	/* TST, TEQ, CMP and CMN only set flags */
+	if ((opcode & 0xc) != 0x8)
+		UML_MOV(block, DRC_REG(rd), uml::I0);                                           // mov     rd,i0
+}
 
-		// check for overflow and set the Q bit
-		saturate_qbit_overflow((INT64)src3 + res);
 
-		// do the real accumulate
-		src3 += (INT32)res;
+/*-------------------------------------------------
+    generate_arm_opcode - generate code for a
+    natively compiled ARM instruction
+-------------------------------------------------*/
 
-		// write the result back
-		SET_REGISTER((insn>>16)&0xf, (UINT32)res);
+void arm7_cpu_device::generate_arm_opcode(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc)
+{
+	UINT32 op = desc->opptr.l[0];
+	int cond = op >> INSN_COND_SHIFT;
+	uml::code_label skip = compiler->labelnum++;
+
+	/* an instruction whose condition fails only takes one cycle */
+	if (cond != COND_AL)
+	{
+		generate_condition(block, cond);                                                // <i0 = condition>
+		UML_TEST(block, uml::I0, 1);                                                    // test    i0,1
+		UML_JMPc(block, uml::COND_Z, skip);                                             // jz      skip
 	}
-	else
-	/* Multiply OR Swap OR Half Word Data Transfer */
-	if ((insn & 0x0e000000) == 0 && (insn & 0x80) && (insn & 0x10))  // bits 27-25=000 bit 7=1 bit 4=1
+
+	/* B/BL */
+	if (desc->flags & OPFLAG_IS_BRANCH)
 	{
-		/* Half Word Data Transfer */
-		if (insn & 0x60)         // bits = 6-5 != 00
-		{
-			HandleHalfWordDT(insn);
-		}
-		else
-		/* Swap */
-		if (insn & 0x01000000)   // bit 24 = 1
-		{
-			HandleSwap(insn);
-		}
-		/* Multiply Or Multiply Long */
-		else
+		if (op & INSN_BL)
+			UML_MOV(block, DRC_REG(eR14), desc->pc + 4);                                // mov     r14,pc+4
+
+		compiler_state taken = *compiler;
+		generate_branch_to(block, &taken, desc->targetpc);
+
+		if (cond != COND_AL)
 		{
-			/* multiply long */
-			if (insn & 0x800000) // Bit 23 = 1 for Multiply Long
-			{
-				/* Signed? */
-				if (insn & 0x00400000)
-					HandleSMulLong(insn);
-				else
-					HandleUMulLong(insn);
-			}
-			/* multiply */
-			else
-			{
-				HandleMul(insn);
-			}
-			R15 += 4;
+			UML_LABEL(block, skip);                                                     // skip:
+			compiler->cycles -= desc->cycles - 1;
 		}
+		return;
 	}
-	/* Data Processing OR PSR Transfer */
-	else if ((insn & 0x0c000000) == 0)   // bits 27-26 == 00 - This check can only exist properly after Multiplication check above
+
+	/* everything else the front end passes is data processing without a PC destination */
+	int opcode = (op & INSN_OPCODE) >> INSN_OPCODE_SHIFT;
+	int rn = (op & INSN_RN) >> INSN_RN_SHIFT;
+	int rd = (op & INSN_RD) >> INSN_RD_SHIFT;
+	bool setflags = (op & INSN_S) != 0;
+	bool logical = (opcode & 6) == 0 || opcode >= OPCODE_TST;
+	uml::parameter op2;
+	int carry;
+
+	if (op & INSN_I)
 	{
-		/* PSR Transfer (MRS & MSR) */
-		if (((insn & 0x00100000) == 0) && ((insn & 0x01800000) == 0x01000000)) // S bit must be clear, and bit 24,23 = 10
-		{
-			HandlePSRTransfer(insn);
-			ARM7_ICOUNT += 2;       // PSR only takes 1 - S Cycle, so we add + 2, since at end, we -3..
-			R15 += 4;
-		}
-		/* Data Processing */
-		else
-		{
-			HandleALU(insn);
-		}
+		UINT32 by = ((op & INSN_OP2_ROTATE) >> INSN_OP2_ROTATE_SHIFT) << 1;
+		UINT32 imm = ROR(op & INSN_OP2_IMM, by);
+		if (by == 0)
+			imm = op & INSN_OP2_IMM;
+		op2 = imm;
+		carry = (by == 0) ? CARRY_UNCHANGED : (imm >> 31) ? CARRY_SET : CARRY_CLEAR;
+	}
+	else
+	{
+		carry = generate_shift_imm(block, op, desc->pc, setflags && logical);
+		op2 = uml::I1;
 	}
 
-	UML_LABEL(block, done);
-	return true;
-}
+	uml::parameter op1 = DRC_REG(rn);
+	if (rn == eR15)
+	{
+		UML_MOV(block, uml::I0, desc->pc + 8);                                          // mov     i0,pc+8
+		op1 = uml::I0;
+	}
 
-bool arm7_cpu_device::drcarm7ops_4567(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT32 op)
-{
-	return false;
-}
+	generate_alu(block, opcode, rd, op1, op2, setflags, carry);
 
-bool arm7_cpu_device::drcarm7ops_89(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT32 op)
-{
-	return false;
+	if (cond != COND_AL)
+	{
+		compiler->cycles -= desc->cycles - 1;
+		if (desc->cycles > 1)
+			UML_SUB(block, uml::mem(&m_drcstate->icount), uml::mem(&m_drcstate->icount), desc->cycles - 1); // sub     icount,icount,cycles-1
+		UML_LABEL(block, skip);                                                         // skip:
+	}
 }
 
-bool arm7_cpu_device::drcarm7ops_ab(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT32 op)
-{
-	return false;
-}
 
-bool arm7_cpu_device::drcarm7ops_cd(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT32 op)
-{
-	return false;
-}
 
-bool arm7_cpu_device::drcarm7ops_e(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT32 op)
-{
-	return false;
-}
+/***************************************************************************
+    LOCKSTEP VERIFICATION
+***************************************************************************/
 
-bool arm7_cpu_device::drcarm7ops_f(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT32 op)
+/*-------------------------------------------------
+    verifier - constructor
+-------------------------------------------------*/
+
+arm7_cpu_device::verifier::verifier(arm7_cpu_device &cpu)
+	: drc_verifier(cpu, *cpu.m_drcuml, *cpu.m_program),
+		m_arm(cpu)
 {
-	return false;
+	/* the CPSR isn't shown, but holds the flags most native instructions set */
+	compare_register(STATE_GENFLAGS);
+
+	/* native instructions are charged what the interpreter would charge */
+	compare_cycles(cpu.m_icount);
 }
 
+
 /*-------------------------------------------------
-    generate_opcode - generate code for a specific
-    opcode
+    save_state - snapshot everything the
+    interpreter and recompiler can change
 -------------------------------------------------*/
 
-int arm7_cpu_device::generate_opcode(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc)
+void arm7_cpu_device::verifier::save_state(std::vector<UINT8> &buffer)
 {
-	//int in_delay_slot = ((desc->flags & OPFLAG_IN_DELAY_SLOT) != 0);
-	UINT32 op = desc->opptr.l[0];
-	UINT8 opswitch = op >> 26;
-	uml::code_label skip;
-	uml::code_label contdecode;
-	uml::code_label unexecuted;
+	arm7_cpu_device &arm = m_arm;
+
+	buffer.clear();
+	save_item(buffer, arm.m_r);
+	save_item(buffer, arm.m_pendingIrq);
+	save_item(buffer, arm.m_pendingFiq);
+	save_item(buffer, arm.m_pendingAbtD);
+	save_item(buffer, arm.m_pendingAbtP);
+	save_item(buffer, arm.m_pendingUnd);
+	save_item(buffer, arm.m_pendingSwi);
+	save_item(buffer, arm.m_icount);
+	save_item(buffer, arm.m_control);
+	save_item(buffer, arm.m_tlbBase);
+	save_item(buffer, arm.m_faultStatus);
+	save_item(buffer, arm.m_faultAddress);
+	save_item(buffer, arm.m_fcsePID);
+	save_item(buffer, arm.m_domainAccessControl);
+}
 
-	if (T_IS_SET(GET_CPSR))
-	{
-		// "In Thumb state, bit [0] is undefined and must be ignored. Bits [31:1] contain the PC."
-		UML_AND(block, uml::I0, DRC_PC, ~1);
-	}
-	else
-	{
-		UML_AND(block, uml::I0, DRC_PC, ~3);
-	}
 
-	UML_TEST(block, uml::mem(&COPRO_CTRL), COPRO_CTRL_MMU_EN);                       // test     COPRO_CTRL, COPRO_CTRL_MMU_EN
-	UML_MOVc(block, uml::COND_NZ, uml::I2, ARM7_TLB_ABORT_P | ARM7_TLB_READ);             // movnz    i0, ARM7_TLB_ABORT_P | ARM7_TLB_READ
-	UML_CALLHc(block, uml::COND_NZ, *m_impstate.tlb_translate);                  // callhnz  tlb_translate);
+/*-------------------------------------------------
+    restore_state - restore a snapshot, and hand
+    it to the recompiled code as well
+-------------------------------------------------*/
 
-	if (T_IS_SET(GET_CPSR))
-	{
-		//UML_CALLH(block, *m_impstate.drcthumb[(op & 0xffc0) >> 6]);          // callh    drcthumb[op] // TODO FIXME
-		return TRUE;
-	}
+void arm7_cpu_device::verifier::restore_state(const std::vector<UINT8> &buffer)
+{
+	arm7_cpu_device &arm = m_arm;
+
+	const UINT8 *data = &buffer[0];
+	restore_item(data, arm.m_r);
+	restore_item(data, arm.m_pendingIrq);
+	restore_item(data, arm.m_pendingFiq);
+	restore_item(data, arm.m_pendingAbtD);
+	restore_item(data, arm.m_pendingAbtP);
+	restore_item(data, arm.m_pendingUnd);
+	restore_item(data, arm.m_pendingSwi);
+	restore_item(data, arm.m_icount);
+	restore_item(data, arm.m_control);
+	restore_item(data, arm.m_tlbBase);
+	restore_item(data, arm.m_faultStatus);
+	restore_item(data, arm.m_faultAddress);
+	restore_item(data, arm.m_fcsePID);
+	restore_item(data, arm.m_domainAccessControl);
+
+	arm.drc_capture_state(*arm.m_drcstate);
+}
 
-	switch (op >> INSN_COND_SHIFT)
-	{
-		case COND_EQ:
-			UML_TEST(block, DRC_CPSR, Z_MASK);
-			UML_JMPc(block, uml::COND_Z, unexecuted = compiler->labelnum++);
-			break;
-		case COND_NE:
-			UML_TEST(block, DRC_CPSR, Z_MASK);
-			UML_JMPc(block, uml::COND_NZ, unexecuted = compiler->labelnum++);
-			break;
-		case COND_CS:
-			UML_TEST(block, DRC_CPSR, C_MASK);
-			UML_JMPc(block, uml::COND_Z, unexecuted = compiler->labelnum++);
-			break;
-		case COND_CC:
-			UML_TEST(block, DRC_CPSR, C_MASK);
-			UML_JMPc(block, uml::COND_NZ, unexecuted = compiler->labelnum++);
-			break;
-		case COND_MI:
-			UML_TEST(block, DRC_CPSR, N_MASK);
-			UML_JMPc(block, uml::COND_Z, unexecuted = compiler->labelnum++);
-			break;
-		case COND_PL:
-			UML_TEST(block, DRC_CPSR, N_MASK);
-			UML_JMPc(block, uml::COND_NZ, unexecuted = compiler->labelnum++);
-			break;
-		case COND_VS:
-			UML_TEST(block, DRC_CPSR, V_MASK);
-			UML_JMPc(block, uml::COND_Z, unexecuted = compiler->labelnum++);
-			break;
-		case COND_VC:
-			UML_TEST(block, DRC_CPSR, V_MASK);
-			UML_JMPc(block, uml::COND_NZ, unexecuted = compiler->labelnum++);
-			break;
-		case COND_HI:
-			UML_TEST(block, DRC_CPSR, Z_MASK);
-			UML_JMPc(block, uml::COND_NZ, unexecuted = compiler->labelnum++);
-			UML_TEST(block, DRC_CPSR, C_MASK);
-			UML_JMPc(block, uml::COND_Z, unexecuted = compiler->labelnum++);
-			break;
-		case COND_LS:
-			UML_TEST(block, DRC_CPSR, Z_MASK);
-			UML_JMPc(block, uml::COND_NZ, contdecode = compiler->labelnum++);
-			UML_TEST(block, DRC_CPSR, C_MASK);
-			UML_JMPc(block, uml::COND_Z, contdecode);
-			UML_JMP(block, unexecuted);
-			break;
-		case COND_GE:
-			UML_TEST(block, DRC_CPSR, N_MASK);
-			UML_MOVc(block, uml::COND_Z, uml::I0, 0);
-			UML_MOVc(block, uml::COND_NZ, uml::I0, 1);
-			UML_TEST(block, DRC_CPSR, V_MASK);
-			UML_MOVc(block, uml::COND_Z, uml::I1, 0);
-			UML_MOVc(block, uml::COND_NZ, uml::I1, 1);
-			UML_CMP(block, uml::I0, uml::I1);
-			UML_JMPc(block, uml::COND_NE, unexecuted);
-			break;
-		case COND_LT:
-			UML_TEST(block, DRC_CPSR, N_MASK);
-			UML_MOVc(block, uml::COND_Z, uml::I0, 0);
-			UML_MOVc(block, uml::COND_NZ, uml::I0, 1);
-			UML_TEST(block, DRC_CPSR, V_MASK);
-			UML_MOVc(block, uml::COND_Z, uml::I1, 0);
-			UML_MOVc(block, uml::COND_NZ, uml::I1, 1);
-			UML_CMP(block, uml::I0, uml::I1);
-			UML_JMPc(block, uml::COND_E, unexecuted);
-			break;
-		case COND_GT:
-			UML_TEST(block, DRC_CPSR, Z_MASK);
-			UML_JMPc(block, uml::COND_NZ, unexecuted);
-			UML_TEST(block, DRC_CPSR, N_MASK);
-			UML_MOVc(block, uml::COND_Z, uml::I0, 0);
-			UML_MOVc(block, uml::COND_NZ, uml::I0, 1);
-			UML_TEST(block, DRC_CPSR, V_MASK);
-			UML_MOVc(block, uml::COND_Z, uml::I1, 0);
-			UML_MOVc(block, uml::COND_NZ, uml::I1, 1);
-			UML_CMP(block, uml::I0, uml::I1);
-			UML_JMPc(block, uml::COND_NE, unexecuted);
-			break;
-		case COND_LE:
-			UML_TEST(block, DRC_CPSR, N_MASK);
-			UML_MOVc(block, uml::COND_Z, uml::I0, 0);
-			UML_MOVc(block, uml::COND_NZ, uml::I0, 1);
-			UML_TEST(block, DRC_CPSR, V_MASK);
-			UML_MOVc(block, uml::COND_Z, uml::I1, 0);
-			UML_MOVc(block, uml::COND_NZ, uml::I1, 1);
-			UML_CMP(block, uml::I0, uml::I1);
-			UML_JMPc(block, uml::COND_NE, contdecode);
-			UML_TEST(block, DRC_CPSR, Z_MASK);
-			UML_JMPc(block, uml::COND_Z, unexecuted);
-			break;
-		case COND_NV:
-			UML_JMP(block, unexecuted);
-			break;
-	}
 
-	UML_LABEL(block, contdecode);
+/*-------------------------------------------------
+    pc - return the interpreter's PC
+-------------------------------------------------*/
 
-	(this->*drcops_handler[(op & 0xF000000) >> 24])(block, compiler, desc, op);
+offs_t arm7_cpu_device::verifier::pc()
+{
+	return m_arm.m_r[eR15];
+}
 
-	UML_LABEL(block, unexecuted);
-	UML_ADD(block, DRC_PC, DRC_PC, 4);
-	UML_ADD(block, MAPVAR_CYCLES, MAPVAR_CYCLES, 2);                                // add      cycles, cycles, 2
 
-	UML_LABEL(block, skip);
+/*-------------------------------------------------
+    set_pc - set the PC at a sequence boundary;
+    the recompiled code only keeps its registers
+    in the DRC state, so copy them back first
+-------------------------------------------------*/
 
-	switch (opswitch)
-	{
-		/* ----- sub-groups ----- */
+void arm7_cpu_device::verifier::set_pc(offs_t pc)
+{
+	m_arm.m_drcstate->r[eR15] = pc;
+	m_arm.drc_restore_state(*m_arm.m_drcstate);
+}
 
-		case 0x00:  /* SPECIAL - MIPS I */
-			return TRUE;
 
-		// TODO: FINISH ME
-	}
+/*-------------------------------------------------
+    step - run one instruction on the interpreter,
+    as execute_run does
+-------------------------------------------------*/
 
-	return FALSE;
+void arm7_cpu_device::verifier::step()
+{
+	m_arm.arm7_execute_instruction();
+	m_arm.arm7_check_irq_state();
+	m_arm.m_icount -= 3;
 }
@@ -0,0 +1,258 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    arm7fe.cpp
+
+    Front end for the ARM7 recompiler.
+
+    Data processing instructions that don't write the PC, and branches
+    whose target is known at compile time, are marked for native
+    compilation in both ARM and Thumb state; everything else is only
+    described well enough for the recompiler to hand it to the
+    interpreter.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "arm7.h"
+#include "arm7core.h"
+
+
+/***************************************************************************
+    INSTRUCTION PARSERS
+***************************************************************************/
+
+arm7_frontend::arm7_frontend(arm7_cpu_device *device, UINT32 window_start, UINT32 window_end, UINT32 max_sequence)
+	: drc_frontend(*device, window_start, window_end, max_sequence)
+	, m_arm(device)
+	, m_thumb(false)
+{
+}
+
+
+/*-------------------------------------------------
+    describe - build a description of a single
+    instruction
+-------------------------------------------------*/
+
+bool arm7_frontend::describe(opcode_desc &desc, const opcode_desc *prev)
+{
+	UINT32 op;
+
+	if (m_thumb)
+	{
+		/* bit 0 of the PC is ignored in Thumb state */
+		op = m_arm->m_direct->read_word(desc.physpc & ~1);
+		desc.length = 2;
+		desc.cycles = 3;
+	}
+	else
+	{
+		/* as are bits 0 and 1 in ARM state */
+		op = m_arm->m_direct->read_dword(desc.physpc & ~3);
+		desc.length = 4;
+		desc.cycles = 3;
+	}
+	desc.opptr.l[0] = op;
+
+	/* misaligned PCs are left to the interpreter, which knows how it fetches them */
+	bool aligned = (desc.pc & (desc.length - 1)) == 0;
+
+	/* compile natively only where the code can't be swapped out from under us */
+	if (aligned && code_is_fixed(desc.physpc, desc.physpc + desc.length - 1) &&
+		(m_thumb ? describe_thumb(desc, op) : describe_arm(desc, op)))
+	{
+		desc.userflags |= USERFLAG_NATIVE;
+		return true;
+	}
+
+	/* interpreted instructions that never continue to the next one */
+	if (m_thumb)
+	{
+		if ((op & 0xff00) == 0x4700 ||          // BX
+			(op & 0xff00) == 0xbd00 ||          // POP {rlist,PC}
+			(op & 0xff00) == 0xdf00 ||          // SWI
+			(op & 0xfd87) == 0x4487 ||          // ADD/MOV PC,Rs
+			(op & 0xf800) == 0xe800)            // BLX suffix
+		{
+			desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+		}
+	}
+	else if ((op >> INSN_COND_SHIFT) == COND_AL)
+	{
+		if ((op & 0x0ffffff0) == 0x012fff10 ||  // BX
+			((op & 0x0c000000) == 0x00000000 && (op & INSN_RD) == 0x0000f000 && ((op >> INSN_OPCODE_SHIFT) & 0xc) != 0x8) || // data processing to PC
+			(op & 0x0c10f000) == 0x0410f000 ||  // LDR PC
+			(op & 0x0e108000) == 0x08108000 ||  // LDM with PC
+			(op & 0x0f000000) == 0x0f000000)    // SWI
+		{
+			desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+		}
+	}
+	desc.flags |= OPFLAG_CAN_CAUSE_EXCEPTION;
+	return true;
+}
+
+
+/*-------------------------------------------------
+    describe_arm - check whether an ARM
+    instruction is one the recompiler generates
+    code for, and describe its flow if so
+-------------------------------------------------*/
+
+bool arm7_frontend::describe_arm(opcode_desc &desc, UINT32 op)
+{
+	int cond = op >> INSN_COND_SHIFT;
+
+	/* the NV space holds ARMv5 extensions */
+	if (cond == COND_NV)
+		return false;
+
+	/* B/BL */
+	if ((op & 0x0e000000) == 0x0a000000)
+	{
+		desc.targetpc = desc.pc + 8 + (((INT32)(op << 8)) >> 6);
+		desc.cycles = 3;
+		if (cond == COND_AL)
+			desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+		else
+			desc.flags |= OPFLAG_IS_CONDITIONAL_BRANCH;
+		return true;
+	}
+
+	/* data processing, not writing the PC and with op2 an immediate or a register shifted by an immediate */
+	if ((op & 0x0c000000) != 0)
+		return false;
+	if ((op & INSN_RD) == 0x0000f000)
+		return false;
+
+	int opcode = (op & INSN_OPCODE) >> INSN_OPCODE_SHIFT;
+
+	/* the test opcodes without S are PSR transfers, and miscellaneous instructions share the space */
+	if ((opcode & 0xc) == 0x8 && !(op & INSN_S))
+		return false;
+
+	/* 1S: HandleALU gives back 2 of the 3 cycles every instruction is charged */
+	if (op & INSN_I)
+	{
+		desc.cycles = 1;
+		return true;
+	}
+
+	/* bit 4 set means a register specified shift, or multiplies and halfword transfers */
+	if (op & 0x00000010)
+		return false;
+
+	/* the register operand costs an extra internal cycle */
+	desc.cycles = 2;
+	return true;
+}
+
+
+/*-------------------------------------------------
+    describe_thumb - check whether a Thumb
+    instruction is one the recompiler generates
+    code for, and describe its flow if so
+-------------------------------------------------*/
+
+bool arm7_frontend::describe_thumb(opcode_desc &desc, UINT32 op)
+{
+	/* shifts by an immediate, and three operand ADD/SUB */
+	if ((op & 0xe000) == 0x0000)
+		return true;
+
+	/* MOV/CMP/ADD/SUB with an 8-bit immediate */
+	if ((op & 0xe000) == 0x2000)
+		return true;
+
+	/* ALU operations, apart from shifts by register, ADC, SBC, ROR and MUL */
+	if ((op & 0xfc00) == 0x4000)
+	{
+		switch ((op >> 6) & 0xf)
+		{
+			case 0x0: case 0x1: case 0x8: case 0x9: case 0xa:
+			case 0xb: case 0xc: case 0xe: case 0xf:
+				return true;
+		}
+		return false;
+	}
+
+	/* high register ADD/CMP/MOV, as long as the PC isn't involved */
+	if ((op & 0xfc00) == 0x4400)
+	{
+		int sub = (op >> 8) & 3;
+		int rd = (op & 7) | ((op >> 4) & 8);
+		int rs = (op >> 3) & 0xf;
+
+		/* ADD with two low registers is undefined */
+		if (sub == 3 || rd == 15 || rs == 15 || (sub == 0 && (op & 0x00c0) == 0))
+			return false;
+		return true;
+	}
+
+	/* ADD Rd,PC/SP,#imm and ADD SP,#imm */
+	if ((op & 0xf000) == 0xa000 || (op & 0xff00) == 0xb000)
+		return true;
+
+	/* Bcc; conditions 14 and 15 are undefined and SWI */
+	if ((op & 0xf000) == 0xd000)
+	{
+		if (((op >> 8) & 0xf) >= 14)
+			return false;
+		desc.targetpc = desc.pc + 4 + ((INT8)(op & 0xff) << 1);
+		desc.flags |= OPFLAG_IS_CONDITIONAL_BRANCH;
+		return true;
+	}
+
+	/* B */
+	if ((op & 0xf800) == 0xe000)
+	{
+		INT32 offs = (op & 0x7ff) << 1;
+		if (offs & 0x800)
+			offs |= 0xfffff800;
+		desc.targetpc = desc.pc + 4 + offs;
+		desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+		return true;
+	}
+
+	/* BL prefix */
+	if ((op & 0xf800) == 0xf000)
+		return true;
+
+	/* BL suffix; the target depends on LR so it is only known at runtime */
+	if ((op & 0xf800) == 0xf800)
+	{
+		desc.targetpc = BRANCH_TARGET_DYNAMIC;
+		desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+		return true;
+	}
+
+	return false;
+}
+
+
+/*-------------------------------------------------
+    code_is_fixed - return true if the given range
+    of code can only change by being written,
+    which the recompiler can check for; switchable
+    banks and handler-backed memory are left to
+    the interpreter
+-------------------------------------------------*/
+
+bool arm7_frontend::code_is_fixed(offs_t start, offs_t end)
+{
+	address_space &space = *m_arm->m_program;
+
+	/* every instruction must be directly readable */
+	for (offs_t address = start; address <= end; address += 2)
+		if (m_arm->m_direct->read_ptr(address) == nullptr)
+			return false;
+
+	/* and not part of a bank that can be pointed elsewhere */
+	for (auto &bank : m_arm->machine().memory().banks())
+		if (!bank.second->anonymous() && bank.second->references_space(space, ROW_READ) && bank.second->straddles((start > 0) ? start - 1 : 0, end + 1))
+			return false;
+
+	return true;
+}
@@ -0,0 +1,3872 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    drcbearm64.cpp
+
+    64-bit ARM (AArch64) back-end for the universal machine language.
+
+****************************************************************************
+
+    Future improvements/changes:
+
+    * Keep more of the flags in NZCV across C calls rather than relying
+        on the front ends not to expect them to survive
+
+    * Use CSEL/CINC for short conditional sequences instead of
+        branching around them
+
+    * Support a W^X code cache for platforms that require it
+
+****************************************************************************
+
+    ---------------------------
+    ABI/conventions (AAPCS64)
+    ---------------------------
+
+    Registers:
+        X0-X7      - volatile, integer function parameters/return value
+        X8         - volatile, indirect result location
+        X9-X15     - volatile
+        X16-X17    - volatile, intra-procedure-call scratch
+        X18        - platform register, not to be touched
+        X19-X28    - non-volatile
+        X29        - frame pointer
+        X30        - link register
+        SP         - stack pointer, 16 byte aligned at all times
+
+        D0-D7      - volatile, FP function parameters/return value
+        D8-D15     - non-volatile (low 64 bits only)
+        D16-D31    - volatile
+
+
+    ---------------
+    Execution model
+    ---------------
+
+    Registers:
+        X0-X3      - function parameters
+        X9-X15     - scratch registers
+        X16        - scratch register, used for calls and flag shuffling
+        X17        - scratch register, used to form addresses
+        X19        - maps to I0
+        X20        - maps to I1
+        X21        - maps to I2
+        X22        - maps to I3
+        X23        - maps to I4
+        X24        - maps to I5
+        X25        - maps to I6
+        X26        - maps to I7
+        X27        - maps to I8
+        X28        - pointer to the near cache
+        X29        - stack pointer at entry
+
+        D8-D15     - map to F0-F7
+        D16-D18    - scratch registers
+
+    Flags:
+        UML flags are kept in NZCV, with S in N, Z in Z and V in V; U
+        shares V, as it is only ever set by FCMP.  C is kept inverted
+        so that SUBS/SBC/CMP match UML's borrow semantics directly, and
+        additions invert it afterwards when it is requested.
+
+    Entry point:
+        Assumes 2 parameters passed: the near cache pointer and the
+        codeptr of the code to execute once the environment is set up.
+
+    Exit point:
+        Assumes exit value is in W0.
+
+    Runtime stack:
+        [x29]      - saved x29/x30
+        [x29+16]   - saved x19-x28
+        [x29+96]   - saved d8-d15
+
+        Handles push the link register on entry, so the return address
+        of the most recent handle called from the top level code is at
+        [x29-16].
+
+***************************************************************************/
+
+#include <stddef.h>
+#include "emu.h"
+#include "debugger.h"
+#include "emuopts.h"
+#include "drcuml.h"
+#include "drcbearm64.h"
+
+namespace drc {
+using namespace uml;
+using namespace arm64emit;
+
+
+
+//**************************************************************************
+//  DEBUGGING
+//**************************************************************************
+
+#define LOG_HASHJMPS            (0)
+
+
+
+//**************************************************************************
+//  CONSTANTS
+//**************************************************************************
+
+const UINT32 PTYPE_M    = 1 << parameter::PTYPE_MEMORY;
+const UINT32 PTYPE_I    = 1 << parameter::PTYPE_IMMEDIATE;
+const UINT32 PTYPE_R    = 1 << parameter::PTYPE_INT_REGISTER;
+const UINT32 PTYPE_F    = 1 << parameter::PTYPE_FLOAT_REGISTER;
+//const UINT32 PTYPE_MI   = PTYPE_M | PTYPE_I;
+//const UINT32 PTYPE_RI   = PTYPE_R | PTYPE_I;
+const UINT32 PTYPE_MR   = PTYPE_M | PTYPE_R;
+const UINT32 PTYPE_MRI  = PTYPE_M | PTYPE_R | PTYPE_I;
+const UINT32 PTYPE_MF   = PTYPE_M | PTYPE_F;
+
+// size of a patchable HASHJMP call site, in instructions
+const int LINK_SITE_SIZE = 3;
+
+// size of the frame built by the entry point
+const int FRAME_SIZE    = 160;
+
+const UINT8 REG_PARAM1  = REG_X0;
+const UINT8 REG_PARAM2  = REG_X1;
+const UINT8 REG_PARAM3  = REG_X2;
+const UINT8 REG_PARAM4  = REG_X3;
+
+const UINT8 REG_SCRATCH1 = REG_X9;
+const UINT8 REG_SCRATCH2 = REG_X10;
+const UINT8 REG_SCRATCH3 = REG_X11;
+const UINT8 REG_SCRATCH4 = REG_X12;
+const UINT8 REG_SCRATCH5 = REG_X13;
+const UINT8 REG_SCRATCH6 = REG_X14;
+const UINT8 REG_SCRATCH7 = REG_X15;
+
+const UINT8 REG_TEMP    = REG_X16;
+const UINT8 REG_ADDR    = REG_X17;
+const UINT8 REG_BASE    = REG_X28;
+
+const UINT8 REG_FSCRATCH1 = REG_D16;
+const UINT8 REG_FSCRATCH2 = REG_D17;
+const UINT8 REG_FSCRATCH3 = REG_D18;
+
+// opc field values for the logical instructions
+const int LOGICAL_AND   = 0;
+const int LOGICAL_ORR   = 1;
+const int LOGICAL_EOR   = 2;
+const int LOGICAL_ANDS  = 3;
+
+
+
+//**************************************************************************
+//  MACROS
+//**************************************************************************
+
+#define A64_CONDITION(condition)        (condition_map[condition - uml::COND_Z])
+#define A64_NOT_CONDITION(condition)    (condition_map[condition - uml::COND_Z] ^ 1)
+
+#define assert_no_condition(inst)       assert((inst).condition() == uml::COND_ALWAYS)
+#define assert_any_condition(inst)      assert((inst).condition() == uml::COND_ALWAYS || ((inst).condition() >= uml::COND_Z && (inst).condition() < uml::COND_MAX))
+#define assert_no_flags(inst)           assert((inst).flags() == 0)
+#define assert_flags(inst, valid)       assert(((inst).flags() & ~(valid)) == 0)
+
+
+
+//**************************************************************************
+//  GLOBAL VARIABLES
+//**************************************************************************
+
+drcbe_arm64::opcode_generate_func drcbe_arm64::s_opcode_table[OP_MAX];
+
+// register mapping tables
+static const UINT8 int_register_map[REG_I_COUNT] =
+{
+	REG_X19, REG_X20, REG_X21, REG_X22, REG_X23, REG_X24, REG_X25, REG_X26, REG_X27, 0
+};
+
+static const UINT8 float_register_map[REG_F_COUNT] =
+{
+	REG_D8, REG_D9, REG_D10, REG_D11, REG_D12, REG_D13, REG_D14, REG_D15, 0, 0
+};
+
+// condition mapping table; C is held inverted, and U shares V
+static const UINT8 condition_map[uml::COND_MAX - uml::COND_Z] =
+{
+	arm64emit::COND_EQ,     // COND_Z = 0x80,    requires Z
+	arm64emit::COND_NE,     // COND_NZ,          requires Z
+	arm64emit::COND_MI,     // COND_S,           requires S
+	arm64emit::COND_PL,     // COND_NS,          requires S
+	arm64emit::COND_CC,     // COND_C,           requires C
+	arm64emit::COND_CS,     // COND_NC,          requires C
+	arm64emit::COND_VS,     // COND_V,           requires V
+	arm64emit::COND_VC,     // COND_NV,          requires V
+	arm64emit::COND_VS,     // COND_U,           requires U
+	arm64emit::COND_VC,     // COND_NU,          requires U
+	arm64emit::COND_HI,     // COND_A,           requires CZ
+	arm64emit::COND_LS,     // COND_BE,          requires CZ
+	arm64emit::COND_GT,     // COND_G,           requires SVZ
+	arm64emit::COND_LE,     // COND_LE,          requires SVZ
+	arm64emit::COND_LT,     // COND_L,           requires SV
+	arm64emit::COND_GE,     // COND_GE,          requires SV
+};
+
+
+
+//**************************************************************************
+//  TABLES
+//**************************************************************************
+
+const drcbe_arm64::opcode_table_entry drcbe_arm64::s_opcode_table_source[] =
+{
+	// Compile-time opcodes
+	{ uml::OP_HANDLE,  &drcbe_arm64::op_handle },   // HANDLE  handle
+	{ uml::OP_HASH,    &drcbe_arm64::op_hash },     // HASH    mode,pc
+	{ uml::OP_LABEL,   &drcbe_arm64::op_label },    // LABEL   imm
+	{ uml::OP_COMMENT, &drcbe_arm64::op_comment },  // COMMENT string
+	{ uml::OP_MAPVAR,  &drcbe_arm64::op_mapvar },   // MAPVAR  mapvar,value
+
+	// Control Flow Operations
+	{ uml::OP_NOP,     &drcbe_arm64::op_nop },      // NOP
+	{ uml::OP_DEBUG,   &drcbe_arm64::op_debug },    // DEBUG   pc
+	{ uml::OP_EXIT,    &drcbe_arm64::op_exit },     // EXIT    src1[,c]
+	{ uml::OP_HASHJMP, &drcbe_arm64::op_hashjmp },  // HASHJMP mode,pc,handle
+	{ uml::OP_JMP,     &drcbe_arm64::op_jmp },      // JMP     imm[,c]
+	{ uml::OP_EXH,     &drcbe_arm64::op_exh },      // EXH     handle,param[,c]
+	{ uml::OP_CALLH,   &drcbe_arm64::op_callh },    // CALLH   handle[,c]
+	{ uml::OP_RET,     &drcbe_arm64::op_ret },      // RET     [c]
+	{ uml::OP_CALLC,   &drcbe_arm64::op_callc },    // CALLC   func,ptr[,c]
+	{ uml::OP_RECOVER, &drcbe_arm64::op_recover },  // RECOVER dst,mapvar
+
+	// Internal Register Operations
+	{ uml::OP_SETFMOD, &drcbe_arm64::op_setfmod },  // SETFMOD src
+	{ uml::OP_GETFMOD, &drcbe_arm64::op_getfmod },  // GETFMOD dst
+	{ uml::OP_GETEXP,  &drcbe_arm64::op_getexp },   // GETEXP  dst
+	{ uml::OP_GETFLGS, &drcbe_arm64::op_getflgs },  // GETFLGS dst[,f]
+	{ uml::OP_SAVE,    &drcbe_arm64::op_save },     // SAVE    dst
+	{ uml::OP_RESTORE, &drcbe_arm64::op_restore },  // RESTORE dst
+
+	// Integer Operations
+	{ uml::OP_LOAD,    &drcbe_arm64::op_load },     // LOAD    dst,base,index,size
+	{ uml::OP_LOADS,   &drcbe_arm64::op_loads },    // LOADS   dst,base,index,size
+	{ uml::OP_STORE,   &drcbe_arm64::op_store },    // STORE   base,index,src,size
+	{ uml::OP_READ,    &drcbe_arm64::op_read },     // READ    dst,src1,spacesize
+	{ uml::OP_READM,   &drcbe_arm64::op_readm },    // READM   dst,src1,mask,spacesize
+	{ uml::OP_WRITE,   &drcbe_arm64::op_write },    // WRITE   dst,src1,spacesize
+	{ uml::OP_WRITEM,  &drcbe_arm64::op_writem },   // WRITEM  dst,src1,spacesize
+	{ uml::OP_CARRY,   &drcbe_arm64::op_carry },    // CARRY   src,bitnum
+	{ uml::OP_SET,     &drcbe_arm64::op_set },      // SET     dst,c
+	{ uml::OP_MOV,     &drcbe_arm64::op_mov },      // MOV     dst,src[,c]
+	{ uml::OP_SEXT,    &drcbe_arm64::op_sext },     // SEXT    dst,src
+	{ uml::OP_ROLAND,  &drcbe_arm64::op_roland },   // ROLAND  dst,src1,src2,src3
+	{ uml::OP_ROLINS,  &drcbe_arm64::op_rolins },   // ROLINS  dst,src1,src2,src3
+	{ uml::OP_ADD,     &drcbe_arm64::op_add },      // ADD     dst,src1,src2[,f]
+	{ uml::OP_ADDC,    &drcbe_arm64::op_addc },     // ADDC    dst,src1,src2[,f]
+	{ uml::OP_SUB,     &drcbe_arm64::op_sub },      // SUB     dst,src1,src2[,f]
+	{ uml::OP_SUBB,    &drcbe_arm64::op_subc },     // SUBB    dst,src1,src2[,f]
+	{ uml::OP_CMP,     &drcbe_arm64::op_cmp },      // CMP     src1,src2[,f]
+	{ uml::OP_MULU,    &drcbe_arm64::op_mulu },     // MULU    dst,edst,src1,src2[,f]
+	{ uml::OP_MULS,    &drcbe_arm64::op_muls },     // MULS    dst,edst,src1,src2[,f]
+	{ uml::OP_DIVU,    &drcbe_arm64::op_divu },     // DIVU    dst,edst,src1,src2[,f]
+	{ uml::OP_DIVS,    &drcbe_arm64::op_divs },     // DIVS    dst,edst,src1,src2[,f]
+	{ uml::OP_AND,     &drcbe_arm64::op_and },      // AND     dst,src1,src2[,f]
+	{ uml::OP_TEST,    &drcbe_arm64::op_test },     // TEST    src1,src2[,f]
+	{ uml::OP_OR,      &drcbe_arm64::op_or },       // OR      dst,src1,src2[,f]
+	{ uml::OP_XOR,     &drcbe_arm64::op_xor },      // XOR     dst,src1,src2[,f]
+	{ uml::OP_LZCNT,   &drcbe_arm64::op_lzcnt },    // LZCNT   dst,src[,f]
+	{ uml::OP_TZCNT,   &drcbe_arm64::op_tzcnt },    // TZCNT   dst,src[,f]
+	{ uml::OP_BSWAP,   &drcbe_arm64::op_bswap },    // BSWAP   dst,src
+	{ uml::OP_SHL,     &drcbe_arm64::op_shl },      // SHL     dst,src,count[,f]
+	{ uml::OP_SHR,     &drcbe_arm64::op_shr },      // SHR     dst,src,count[,f]
+	{ uml::OP_SAR,     &drcbe_arm64::op_sar },      // SAR     dst,src,count[,f]
+	{ uml::OP_ROL,     &drcbe_arm64::op_rol },      // ROL     dst,src,count[,f]
+	{ uml::OP_ROLC,    &drcbe_arm64::op_rolc },     // ROLC    dst,src,count[,f]
+	{ uml::OP_ROR,     &drcbe_arm64::op_ror },      // ROR     dst,src,count[,f]
+	{ uml::OP_RORC,    &drcbe_arm64::op_rorc },     // RORC    dst,src,count[,f]
+
+	// Floating Point Operations
+	{ uml::OP_FLOAD,   &drcbe_arm64::op_fload },    // FLOAD   dst,base,index
+	{ uml::OP_FSTORE,  &drcbe_arm64::op_fstore },   // FSTORE  base,index,src
+	{ uml::OP_FREAD,   &drcbe_arm64::op_fread },    // FREAD   dst,space,src1
+	{ uml::OP_FWRITE,  &drcbe_arm64::op_fwrite },   // FWRITE  space,dst,src1
+	{ uml::OP_FMOV,    &drcbe_arm64::op_fmov },     // FMOV    dst,src1[,c]
+	{ uml::OP_FTOINT,  &drcbe_arm64::op_ftoint },   // FTOINT  dst,src1,size,round
+	{ uml::OP_FFRINT,  &drcbe_arm64::op_ffrint },   // FFRINT  dst,src1,size
+	{ uml::OP_FFRFLT,  &drcbe_arm64::op_ffrflt },   // FFRFLT  dst,src1,size
+	{ uml::OP_FRNDS,   &drcbe_arm64::op_frnds },    // FRNDS   dst,src1
+	{ uml::OP_FADD,    &drcbe_arm64::op_fadd },     // FADD    dst,src1,src2
+	{ uml::OP_FSUB,    &drcbe_arm64::op_fsub },     // FSUB    dst,src1,src2
+	{ uml::OP_FCMP,    &drcbe_arm64::op_fcmp },     // FCMP    src1,src2
+	{ uml::OP_FMUL,    &drcbe_arm64::op_fmul },     // FMUL    dst,src1,src2
+	{ uml::OP_FDIV,    &drcbe_arm64::op_fdiv },     // FDIV    dst,src1,src2
+	{ uml::OP_FNEG,    &drcbe_arm64::op_fneg },     // FNEG    dst,src1
+	{ uml::OP_FABS,    &drcbe_arm64::op_fabs },     // FABS    dst,src1
+	{ uml::OP_FSQRT,   &drcbe_arm64::op_fsqrt },    // FSQRT   dst,src1
+	{ uml::OP_FRECIP,  &drcbe_arm64::op_frecip },   // FRECIP  dst,src1
+	{ uml::OP_FRSQRT,  &drcbe_arm64::op_frsqrt },   // FRSQRT  dst,src1
+	{ uml::OP_FCOPYI,  &drcbe_arm64::op_fcopyi },   // FCOPYI  dst,src
+	{ uml::OP_ICOPYF,  &drcbe_arm64::op_icopyf }    // ICOPYF  dst,src
+};
+
+
+
+//**************************************************************************
+//  INLINE FUNCTIONS
+//**************************************************************************
+
+//-------------------------------------------------
+//  param_normalize - convert a full parameter
+//  into a reduced set
+//-------------------------------------------------
+
+drcbe_arm64::be_parameter::be_parameter(drcbe_arm64 &drcbe, const parameter &param, UINT32 allowed)
+{
+	int regnum;
+
+	switch (param.type())
+	{
+		// immediates pass through
+		case parameter::PTYPE_IMMEDIATE:
+			assert(allowed & PTYPE_I);
+			*this = param.immediate();
+			break;
+
+		// memory passes through
+		case parameter::PTYPE_MEMORY:
+			assert(allowed & PTYPE_M);
+			*this = make_memory(param.memory());
+			break;
+
+		// if a register maps to a register, keep it as a register; otherwise map it to memory
+		case parameter::PTYPE_INT_REGISTER:
+			assert(allowed & PTYPE_R);
+			assert(allowed & PTYPE_M);
+			regnum = int_register_map[param.ireg() - REG_I0];
+			if (regnum != 0)
+				*this = make_ireg(regnum);
+			else
+				*this = make_memory(&drcbe.m_state.r[param.ireg() - REG_I0]);
+			break;
+
+		// if a register maps to a register, keep it as a register; otherwise map it to memory
+		case parameter::PTYPE_FLOAT_REGISTER:
+			assert(allowed & PTYPE_F);
+			assert(allowed & PTYPE_M);
+			regnum = float_register_map[param.freg() - REG_F0];
+			if (regnum != 0)
+				*this = make_freg(regnum);
+			else
+				*this = make_memory(&drcbe.m_state.f[param.freg() - REG_F0]);
+			break;
+
+		// everything else is unexpected
+		default:
+			fatalerror("Unexpected parameter type\n");
+	}
+}
+
+
+//-------------------------------------------------
+//  select_register - select a register to use,
+//  avoiding conflicts with the optional
+//  checkparam
+//-------------------------------------------------
+
+inline int drcbe_arm64::be_parameter::select_register(int defreg) const
+{
+	if (m_type == PTYPE_INT_REGISTER || m_type == PTYPE_FLOAT_REGISTER)
+		return m_value;
+	return defreg;
+}
+
+inline int drcbe_arm64::be_parameter::select_register(int defreg, const be_parameter &checkparam) const
+{
+	if (*this == checkparam)
+		return defreg;
+	return select_register(defreg);
+}
+
+inline int drcbe_arm64::be_parameter::select_register(int defreg, const be_parameter &checkparam, const be_parameter &checkparam2) const
+{
+	if (*this == checkparam || *this == checkparam2)
+		return defreg;
+	return select_register(defreg);
+}
+
+
+//-------------------------------------------------
+//  normalize_commutative - push memory and
+//  immediate operands of a commutative operation
+//  to the outer parameter
+//-------------------------------------------------
+
+inline void drcbe_arm64::normalize_commutative(be_parameter &inner, be_parameter &outer)
+{
+	// if the inner parameter is a memory operand, push it to the outer
+	if (inner.is_memory())
+	{
+		be_parameter temp = inner;
+		inner = outer;
+		outer = temp;
+	}
+
+	// if the inner parameter is an immediate, push it to the outer
+	if (inner.is_immediate())
+	{
+		be_parameter temp = inner;
+		inner = outer;
+		outer = temp;
+	}
+}
+
+
+//-------------------------------------------------
+//  emit_mov_r64_imm - load an arbitrary 64-bit
+//  immediate into a register in as few
+//  instructions as possible
+//-------------------------------------------------
+
+void drcbe_arm64::emit_mov_r64_imm(arm64code *&dst, UINT8 reg, UINT64 imm)
+{
+	// count the halfwords that MOVZ and MOVN give us for free
+	int zeroes = 0, ones = 0;
+	for (int shift = 0; shift < 64; shift += 16)
+	{
+		UINT16 half = imm >> shift;
+		if (half == 0x0000)
+			zeroes++;
+		else if (half == 0xffff)
+			ones++;
+	}
+
+	// a single ORR if it is a bitmask that would otherwise take three or more instructions
+	if (zeroes < 3 && ones < 3 && is_logical_immediate(imm, true))
+	{
+		emit_orr_imm(dst, true, reg, REG_ZR, imm);                                      // orr   reg,xzr,imm
+		return;
+	}
+
+	// otherwise MOVN or MOVZ the first halfword that differs from the fill, and MOVK the rest
+	bool inverted = (ones > zeroes);
+	UINT16 fill = inverted ? 0xffff : 0x0000;
+	bool first = true;
+	for (int shift = 0; shift < 64; shift += 16)
+	{
+		UINT16 half = imm >> shift;
+		if (half == fill)
+			continue;
+		if (!first)
+			emit_movk(dst, true, reg, half, shift);                                     // movk  reg,half,lsl #shift
+		else if (inverted)
+			emit_movn(dst, true, reg, ~half, shift);                                    // movn  reg,~half,lsl #shift
+		else
+			emit_movz(dst, true, reg, half, shift);                                     // movz  reg,half,lsl #shift
+		first = false;
+	}
+
+	// all halfwords were the fill
+	if (first)
+	{
+		if (inverted)
+			emit_movn(dst, true, reg, 0, 0);                                            // movn  reg,#0
+		else
+			emit_movz(dst, true, reg, 0, 0);                                            // movz  reg,#0
+	}
+}
+
+
+//-------------------------------------------------
+//  emit_load_address - load the address of
+//  something into a register, relative to the
+//  near cache or the PC where possible
+//-------------------------------------------------
+
+void drcbe_arm64::emit_load_address(arm64code *&dst, UINT8 reg, const void *ptr)
+{
+	INT64 delta = (const UINT8 *)ptr - m_basevalue;
+	INT64 pcdelta = (const UINT8 *)ptr - (const UINT8 *)dst;
+
+	// things in the near cache are a couple of ADDs away
+	if (delta >= 0 && delta <= 0xffffff)
+	{
+		if ((delta & 0xfff000) != 0)
+		{
+			emit_add_imm(dst, true, reg, REG_BASE, delta & 0xfff000);                   // add   reg,x28,delta_hi
+			if ((delta & 0xfff) != 0)
+				emit_add_imm(dst, true, reg, reg, delta & 0xfff);                       // add   reg,reg,delta_lo
+		}
+		else
+			emit_add_imm(dst, true, reg, REG_BASE, delta);                              // add   reg,x28,delta
+	}
+
+	// the rest of the cache is usually in range of ADR or ADRP
+	else if (pcdelta >= -(1 << 20) && pcdelta < (1 << 20))
+		emit_adr(dst, reg, ptr);                                                        // adr   reg,ptr
+	else if (is_adrp_target(dst, ptr))
+	{
+		emit_adrp(dst, reg, ptr);                                                       // adrp  reg,ptr
+		if (((FPTR)ptr & 0xfff) != 0)
+			emit_add_imm(dst, true, reg, reg, (FPTR)ptr & 0xfff);                       // add   reg,reg,lo12(ptr)
+	}
+
+	// anything else is an absolute address
+	else
+		emit_mov_r64_imm(dst, reg, (FPTR)ptr);                                          // mov   reg,ptr
+}
+
+
+//-------------------------------------------------
+//  emit_ldst_abs - load or store a register from
+//  or to an absolute address, using x17 to form
+//  the address if it is out of reach of x28
+//-------------------------------------------------
+
+void drcbe_arm64::emit_ldst_abs(arm64code *&dst, UINT32 op, UINT8 reg, const void *ptr)
+{
+	INT64 delta = (const UINT8 *)ptr - m_basevalue;
+	UINT32 lo12 = (FPTR)ptr & 0xfff;
+
+	if (is_ldst_offset(op, delta))
+		emit_ldst_offset(dst, op, reg, REG_BASE, delta);                                // ldr/str reg,[x28,#delta]
+	else if (is_adrp_target(dst, ptr) && is_ldst_offset(op, lo12))
+	{
+		emit_adrp(dst, REG_ADDR, ptr);                                                  // adrp  x17,ptr
+		emit_ldst_offset(dst, op, reg, REG_ADDR, lo12);                                 // ldr/str reg,[x17,#lo12(ptr)]
+	}
+	else
+	{
+		emit_mov_r64_imm(dst, REG_ADDR, (FPTR)ptr);                                     // mov   x17,ptr
+		emit_ldst_offset(dst, op, reg, REG_ADDR, 0);                                    // ldr/str reg,[x17]
+	}
+}
+
+
+//-------------------------------------------------
+//  emit_ldst_indexed - load or store a register
+//  from or to base + (index << scale), with the
+//  index extended as given
+//-------------------------------------------------
+
+void drcbe_arm64::emit_ldst_indexed(arm64code *&dst, UINT32 op, UINT8 reg, const void *base, const be_parameter &indp, int scale, UINT8 extend)
+{
+	// immediate indexes fold into the address
+	if (indp.is_immediate())
+	{
+		INT64 index = (extend == EXTEND_SXTW) ? (INT64)(INT32)indp.immediate() : (INT64)(UINT32)indp.immediate();
+		emit_ldst_abs(dst, op, reg, (const UINT8 *)base + (index << scale));            // ldr/str reg,[base + index << scale]
+		return;
+	}
+
+	// otherwise use the register offset form if the scale matches the access size
+	UINT8 indreg = emit_load_p(dst, false, REG_SCRATCH2, indp);                         // mov   w10,indp
+	emit_load_address(dst, REG_ADDR, base);                                             // mov   x17,base
+	if (scale == 0 || scale == ldst_scale(op))
+		emit_ldst_index(dst, op, reg, REG_ADDR, indreg, extend, scale != 0);            // ldr/str reg,[x17,indreg,extend #scale]
+	else
+	{
+		emit_add_ext(dst, true, REG_ADDR, REG_ADDR, indreg, extend, scale);             // add   x17,x17,indreg,extend #scale
+		emit_ldst_offset(dst, op, reg, REG_ADDR, 0);                                    // ldr/str reg,[x17]
+	}
+}
+
+
+//-------------------------------------------------
+//  emit_smart_branch - generate a branch either
+//  directly or through a register
+//-------------------------------------------------
+
+void drcbe_arm64::emit_smart_branch(arm64code *&dst, const void *target)
+{
+	if (is_branch_target(dst, target))
+		emit_b(dst, target);                                                            // b     target
+	else
+	{
+		emit_mov_r64_imm(dst, REG_TEMP, (FPTR)target);                                  // mov   x16,target
+		emit_br(dst, REG_TEMP);                                                         // br    x16
+	}
+}
+
+
+//-------------------------------------------------
+//  emit_smart_call - generate a call either
+//  directly or through a register
+//-------------------------------------------------
+
+void drcbe_arm64::emit_smart_call(arm64code *&dst, const void *target)
+{
+	if (is_branch_target(dst, target))
+		emit_bl(dst, target);                                                           // bl    target
+	else
+	{
+		emit_mov_r64_imm(dst, REG_TEMP, (FPTR)target);                                  // mov   x16,target
+		emit_blr(dst, REG_TEMP);                                                        // blr   x16
+	}
+}
+
+
+//-------------------------------------------------
+//  emit_call_m64 - generate a call through a
+//  pointer held in memory
+//-------------------------------------------------
+
+void drcbe_arm64::emit_call_m64(arm64code *&dst, const void *targetptr)
+{
+	emit_ldst_abs(dst, LDST_LDRX, REG_TEMP, targetptr);                                 // ldr   x16,[targetptr]
+	emit_blr(dst, REG_TEMP);                                                            // blr   x16
+}
+
+
+//-------------------------------------------------
+//  emit_hash_index - extract one level of hash
+//  table index from a PC
+//-------------------------------------------------
+
+void drcbe_arm64::emit_hash_index(arm64code *&dst, UINT8 reg, UINT8 pcreg, int shift, int bits)
+{
+	if (shift + bits > 32)
+		bits = 32 - shift;
+	if (bits <= 0)
+		emit_mov_reg(dst, false, reg, REG_ZR);                                          // mov   reg,wzr
+	else
+		emit_ubfx(dst, false, reg, pcreg, shift, bits);                                 // ubfx  reg,pcreg,#shift,#bits
+}
+
+
+
+//**************************************************************************
+//  BACKEND CALLBACKS
+//**************************************************************************
+
+//-------------------------------------------------
+//  drcbe_arm64 - constructor
+//-------------------------------------------------
+
+drcbe_arm64::drcbe_arm64(drcuml_state &drcuml, device_t &device, drc_cache &cache, UINT32 flags, int modes, int addrbits, int ignorebits)
+	: drcbe_interface(drcuml, cache, device),
+		m_hash(cache, modes, addrbits, ignorebits),
+		m_map(cache, 0),
+		m_labels(cache),
+		m_basevalue(cache.near()),
+		m_entry(nullptr),
+		m_exit(nullptr),
+		m_nocode(nullptr),
+		m_fixup_label(FUNC(drcbe_arm64::fixup_label), this),
+		m_near(*(near_state *)cache.alloc_near(sizeof(m_near)))
+{
+	// get pointers to C functions we need to call
+	m_near.debug_cpu_instruction_hook = (arm64code *)debugger_instruction_hook;
+	if (LOG_HASHJMPS)
+	{
+		m_near.debug_log_hashjmp = (arm64code *)debug_log_hashjmp;
+		m_near.debug_log_hashjmp_fail = (arm64code *)debug_log_hashjmp_fail;
+	}
+	m_near.drcmap_get_value = (arm64code *)&drc_map_variables::static_get_value;
+
+	// build the flags map; the index is NZCV shifted down, with C inverted
+	for (int entry = 0; entry < ARRAY_LENGTH(m_near.flagsmap); entry++)
+	{
+		UINT8 flags = 0;
+		if (!(entry & 0x2)) flags |= FLAG_C;
+		if (entry & 0x1) flags |= FLAG_V | FLAG_U;
+		if (entry & 0x4) flags |= FLAG_Z;
+		if (entry & 0x8) flags |= FLAG_S;
+		m_near.flagsmap[entry] = flags;
+	}
+	for (int entry = 0; entry < ARRAY_LENGTH(m_near.flagsunmap); entry++)
+	{
+		UINT64 flags = 0;
+		if (!(entry & FLAG_C)) flags |= NZCV_C;
+		if (entry & (FLAG_V | FLAG_U)) flags |= NZCV_V;
+		if (entry & FLAG_Z) flags |= NZCV_Z;
+		if (entry & FLAG_S) flags |= NZCV_N;
+		m_near.flagsunmap[entry] = flags;
+	}
+
+	// build the opcode table (static but it doesn't hurt to regenerate it)
+	for (auto & elem : s_opcode_table_source)
+		s_opcode_table[elem.opcode] = elem.func;
+}
+
+
+//-------------------------------------------------
+//  ~drcbe_arm64 - destructor
+//-------------------------------------------------
+
+drcbe_arm64::~drcbe_arm64()
+{
+}
+
+
+//-------------------------------------------------
+//  reset - reset back-end specific state
+//-------------------------------------------------
+
+void drcbe_arm64::reset()
+{
+	// generate a little bit of glue code to set up the environment
+	drccodeptr *cachetop = m_cache.begin_codegen(500);
+	if (cachetop == nullptr)
+		fatalerror("Out of cache space after a reset!\n");
+
+	arm64code *start = (arm64code *)(((FPTR)*cachetop + 3) & ~3);
+	arm64code *dst = start;
+
+	// generate an entry point
+	m_entry = (arm64_entry_point_func)dst;
+	emit_stp_x_pre(dst, REG_FP, REG_LR, REG_SP, -FRAME_SIZE);                           // stp   x29,x30,[sp,#-160]!
+	emit_stp_x(dst, REG_X19, REG_X20, REG_SP, 16);                                      // stp   x19,x20,[sp,#16]
+	emit_stp_x(dst, REG_X21, REG_X22, REG_SP, 32);                                      // stp   x21,x22,[sp,#32]
+	emit_stp_x(dst, REG_X23, REG_X24, REG_SP, 48);                                      // stp   x23,x24,[sp,#48]
+	emit_stp_x(dst, REG_X25, REG_X26, REG_SP, 64);                                      // stp   x25,x26,[sp,#64]
+	emit_stp_x(dst, REG_X27, REG_X28, REG_SP, 80);                                      // stp   x27,x28,[sp,#80]
+	emit_stp_d(dst, REG_D8, REG_D9, REG_SP, 96);                                        // stp   d8,d9,[sp,#96]
+	emit_stp_d(dst, REG_D10, REG_D11, REG_SP, 112);                                     // stp   d10,d11,[sp,#112]
+	emit_stp_d(dst, REG_D12, REG_D13, REG_SP, 128);                                     // stp   d12,d13,[sp,#128]
+	emit_stp_d(dst, REG_D14, REG_D15, REG_SP, 144);                                     // stp   d14,d15,[sp,#144]
+	emit_add_imm(dst, true, REG_FP, REG_SP, 0);                                         // mov   x29,sp
+	emit_mov_reg(dst, true, REG_BASE, REG_PARAM1);                                      // mov   x28,param1
+	emit_mrs_fpcr(dst, REG_TEMP);                                                       // mrs   x16,fpcr
+	emit_ldst_abs(dst, LDST_STRX, REG_TEMP, &m_near.fpcrsave);                          // str   x16,[fpcrsave]
+	emit_br(dst, REG_PARAM2);                                                           // br    param2
+
+	// generate an exit point
+	m_exit = dst;
+	emit_ldst_abs(dst, LDST_LDRX, REG_TEMP, &m_near.fpcrsave);                          // ldr   x16,[fpcrsave]
+	emit_msr_fpcr(dst, REG_TEMP);                                                       // msr   fpcr,x16
+	emit_add_imm(dst, true, REG_SP, REG_FP, 0);                                         // mov   sp,x29
+	emit_ldp_d(dst, REG_D14, REG_D15, REG_SP, 144);                                     // ldp   d14,d15,[sp,#144]
+	emit_ldp_d(dst, REG_D12, REG_D13, REG_SP, 128);                                     // ldp   d12,d13,[sp,#128]
+	emit_ldp_d(dst, REG_D10, REG_D11, REG_SP, 112);                                     // ldp   d10,d11,[sp,#112]
+	emit_ldp_d(dst, REG_D8, REG_D9, REG_SP, 96);                                        // ldp   d8,d9,[sp,#96]
+	emit_ldp_x(dst, REG_X27, REG_X28, REG_SP, 80);                                      // ldp   x27,x28,[sp,#80]
+	emit_ldp_x(dst, REG_X25, REG_X26, REG_SP, 64);                                      // ldp   x25,x26,[sp,#64]
+	emit_ldp_x(dst, REG_X23, REG_X24, REG_SP, 48);                                      // ldp   x23,x24,[sp,#48]
+	emit_ldp_x(dst, REG_X21, REG_X22, REG_SP, 32);                                      // ldp   x21,x22,[sp,#32]
+	emit_ldp_x(dst, REG_X19, REG_X20, REG_SP, 16);                                      // ldp   x19,x20,[sp,#16]
+	emit_ldp_x_post(dst, REG_FP, REG_LR, REG_SP, FRAME_SIZE);                           // ldp   x29,x30,[sp],#160
+	emit_ret(dst);                                                                      // ret
+
+	// generate a no code point
+	m_nocode = dst;
+	emit_ret(dst);                                                                      // ret
+
+	// finish up codegen
+	*cachetop = (drccodeptr)dst;
+	m_cache.end_codegen();
+	flush_icache(start, dst);
+
+	// reset our hash tables, forgetting any linked jumps
+	m_hash.reset();
+	m_link_sites.clear();
+	m_hash.set_default_codeptr((drccodeptr)m_nocode);
+}
+
+
+//-------------------------------------------------
+//  execute - execute a block of code referenced
+//  by the given handle
+//-------------------------------------------------
+
+int drcbe_arm64::execute(code_handle &entry)
+{
+	// call our entry point which will jump to the destination
+	return (*m_entry)(m_basevalue, (arm64code *)entry.codeptr());
+}
+
+
+//-------------------------------------------------
+//  generate - generate code
+//-------------------------------------------------
+
+void drcbe_arm64::generate(drcuml_block &block, const instruction *instlist, UINT32 numinst)
+{
+	// tell all of our utility objects that a block is beginning
+	m_hash.block_begin(block, instlist, numinst);
+	m_labels.block_begin(block);
+	m_map.block_begin(block);
+
+	// begin codegen; fail if we can't
+	drccodeptr *cachetop = m_cache.begin_codegen(numinst * 32 * 4);
+	if (cachetop == nullptr)
+		block.abort();
+
+	// compute the base by aligning the cache top to a cache line (assumed to be 64 bytes)
+	arm64code *base = (arm64code *)(((FPTR)*cachetop + 63) & ~63);
+	arm64code *dst = base;
+
+	// generate code
+	for (int inum = 0; inum < numinst; inum++)
+	{
+		const instruction &inst = instlist[inum];
+		assert(inst.opcode() < ARRAY_LENGTH(s_opcode_table));
+
+		// generate code
+		(this->*s_opcode_table[inst.opcode()])(dst, inst);
+	}
+
+	// complete codegen; this resolves any forward label references
+	*cachetop = (drccodeptr)dst;
+	m_cache.end_codegen();
+	flush_icache(base, m_cache.top());
+
+	// link any jumps waiting on this block's entry points
+	for (int inum = 0; inum < numinst; inum++)
+		if (instlist[inum].opcode() == OP_HASH)
+			update_link_sites(instlist[inum].param(0).immediate(), instlist[inum].param(1).immediate());
+
+	// tell all of our utility objects that the block is finished
+	m_hash.block_end(block);
+	m_labels.block_end(block);
+	m_map.block_end(block);
+}
+
+
+//-------------------------------------------------
+//  hash_exists - return true if the given mode/pc
+//  exists in the hash table
+//-------------------------------------------------
+
+bool drcbe_arm64::hash_exists(UINT32 mode, UINT32 pc)
+{
+	return m_hash.code_exists(mode, pc);
+}
+
+
+//-------------------------------------------------
+//  invalidate_code - drop the hash entries of any
+//  blocks compiled from the given guest code range
+//-------------------------------------------------
+
+int drcbe_arm64::invalidate_code(offs_t start, offs_t end)
+{
+	// unlink any jumps to the dropped entries so they go back through the hash table
+	std::vector<std::pair<UINT32, UINT32>> dropped;
+	int count = m_hash.invalidate_range(start, end, &dropped);
+	for (auto &entry : dropped)
+		update_link_sites(entry.first, entry.second);
+	return count;
+}
+
+
+//-------------------------------------------------
+//  write_link_site - write a HASHJMP call site,
+//  calling the target directly if it has been
+//  compiled or through its hash table entry if not
+//-------------------------------------------------
+
+void drcbe_arm64::write_link_site(arm64code *site, UINT32 mode, UINT32 pc)
+{
+	drccodeptr *entry = &m_hash.base()[mode][(pc >> m_hash.l1shift()) & m_hash.l1mask()][(pc >> m_hash.l2shift()) & m_hash.l2mask()];
+	arm64code *dst = site;
+
+	// both forms are the same size and return to the same place
+	if (*entry != nullptr && *entry != (drccodeptr)m_nocode && is_branch_target(site + LINK_SITE_SIZE - 1, *entry))
+	{
+		emit_nop(dst);                                                                  // nop
+		emit_nop(dst);                                                                  // nop
+		emit_bl(dst, *entry);                                                           // bl    target
+	}
+	else
+	{
+		emit_adrp(dst, REG_TEMP, entry);                                                // adrp  x16,entry
+		emit_ldst_offset(dst, LDST_LDRX, REG_TEMP, REG_TEMP, (FPTR)entry & 0xfff);      // ldr   x16,[x16,#lo12(entry)]
+		emit_blr(dst, REG_TEMP);                                                        // blr   x16
+	}
+	assert(dst == site + LINK_SITE_SIZE);
+}
+
+
+//-------------------------------------------------
+//  update_link_sites - relink every HASHJMP call
+//  site targeting the given mode/PC
+//-------------------------------------------------
+
+void drcbe_arm64::update_link_sites(UINT32 mode, UINT32 pc)
+{
+	auto found = m_link_sites.find((UINT64(mode) << 32) | pc);
+	if (found != m_link_sites.end())
+		for (arm64code *site : found->second)
+		{
+			write_link_site(site, mode, pc);
+			flush_icache(site, site + LINK_SITE_SIZE);
+		}
+}
+
+
+//-------------------------------------------------
+//  get_info - return information about the
+//  back-end implementation
+//-------------------------------------------------
+
+void drcbe_arm64::get_info(drcbe_info &info)
+{
+	for (info.direct_iregs = 0; info.direct_iregs < REG_I_COUNT; info.direct_iregs++)
+		if (int_register_map[info.direct_iregs] == 0)
+			break;
+	for (info.direct_fregs = 0; info.direct_fregs < REG_F_COUNT; info.direct_fregs++)
+		if (float_register_map[info.direct_fregs] == 0)
+			break;
+}
+
+
+//-------------------------------------------------
+//  flush_icache - make newly written code visible
+//  to instruction fetch
+//-------------------------------------------------
+
+void drcbe_arm64::flush_icache(const void *start, const void *end)
+{
+#if defined(__GNUC__)
+	__builtin___clear_cache((char *)start, (char *)end);
+#endif
+}
+
+
+
+
+/***************************************************************************
+    PARAMETER HELPERS
+***************************************************************************/
+
+//-------------------------------------------------
+//  emit_load_p - return a register holding the
+//  value of a parameter, loading it into defreg
+//  if it isn't already in one
+//-------------------------------------------------
+
+UINT8 drcbe_arm64::emit_load_p(arm64code *&dst, bool is64, UINT8 defreg, const be_parameter &param)
+{
+	if (param.is_int_register())
+		return param.ireg();
+	emit_mov_r_p(dst, is64, defreg, param);
+	return defreg;
+}
+
+
+//-------------------------------------------------
+//  emit_mov_r_p - move a parameter into a
+//  register; 32-bit moves zero the upper half
+//-------------------------------------------------
+
+void drcbe_arm64::emit_mov_r_p(arm64code *&dst, bool is64, UINT8 reg, const be_parameter &param)
+{
+	assert(!param.is_float_register());
+	if (param.is_immediate())
+	{
+		if (is64)
+			emit_mov_r64_imm(dst, reg, param.immediate());                              // mov   reg,param
+		else
+		{
+			UINT32 imm = param.immediate();
+			if ((imm >> 16) == 0xffff)
+				emit_movn(dst, false, reg, ~imm, 0);                                    // movn  reg,~param
+			else if ((imm & 0xffff) != 0 && (imm >> 16) != 0 && is_logical_immediate(imm, false))
+				emit_orr_imm(dst, false, reg, REG_ZR, imm);                             // orr   reg,wzr,param
+			else
+			{
+				emit_movz(dst, false, reg, imm & 0xffff, 0);                            // movz  reg,param & 0xffff
+				if ((imm >> 16) != 0)
+					emit_movk(dst, false, reg, imm >> 16, 16);                          // movk  reg,param >> 16,lsl #16
+			}
+		}
+	}
+	else if (param.is_memory())
+		emit_ldst_abs(dst, is64 ? LDST_LDRX : LDST_LDRW, reg, param.memory());          // ldr   reg,[param]
+	else if (param.is_int_register())
+	{
+		if (reg != param.ireg())
+			emit_mov_reg(dst, is64, reg, param.ireg());                                 // mov   reg,param
+	}
+}
+
+
+//-------------------------------------------------
+//  emit_store_p - move a register into a
+//  parameter
+//-------------------------------------------------
+
+void drcbe_arm64::emit_store_p(arm64code *&dst, bool is64, const be_parameter &param, UINT8 reg)
+{
+	assert(!param.is_immediate());
+	if (param.is_memory())
+		emit_ldst_abs(dst, is64 ? LDST_STRX : LDST_STRW, reg, param.memory());          // str   reg,[param]
+	else if (param.is_int_register())
+	{
+		if (reg != param.ireg())
+			emit_mov_reg(dst, is64, param.ireg(), reg);                                 // mov   param,reg
+	}
+}
+
+
+//-------------------------------------------------
+//  emit_fload_p - return a register holding the
+//  value of a floating point parameter, loading
+//  it into defreg if it isn't already in one
+//-------------------------------------------------
+
+UINT8 drcbe_arm64::emit_fload_p(arm64code *&dst, bool isdouble, UINT8 defreg, const be_parameter &param)
+{
+	assert(param.is_memory() || param.is_float_register());
+	if (param.is_float_register())
+		return param.freg();
+	emit_ldst_abs(dst, isdouble ? LDST_LDRD : LDST_LDRS, defreg, param.memory());       // ldr   defreg,[param]
+	return defreg;
+}
+
+
+//-------------------------------------------------
+//  emit_fstore_p - move a floating point register
+//  into a parameter
+//-------------------------------------------------
+
+void drcbe_arm64::emit_fstore_p(arm64code *&dst, bool isdouble, const be_parameter &param, UINT8 reg)
+{
+	assert(param.is_memory() || param.is_float_register());
+	if (param.is_memory())
+		emit_ldst_abs(dst, isdouble ? LDST_STRD : LDST_STRS, reg, param.memory());      // str   reg,[param]
+	else if (reg != param.freg())
+		emit_fmov(dst, isdouble, param.freg(), reg);                                    // fmov  param,reg
+}
+
+
+
+/***************************************************************************
+    FLAGS HELPERS
+***************************************************************************/
+
+//-------------------------------------------------
+//  emit_invert_carry - flip the host carry, for
+//  converting between add and subtract senses
+//-------------------------------------------------
+
+void drcbe_arm64::emit_invert_carry(arm64code *&dst)
+{
+	emit_mrs_nzcv(dst, REG_TEMP);                                                       // mrs   x16,nzcv
+	emit_eor_imm(dst, true, REG_TEMP, REG_TEMP, NZCV_C);                                // eor   x16,x16,#NZCV_C
+	emit_msr_nzcv(dst, REG_TEMP);                                                       // msr   nzcv,x16
+}
+
+
+//-------------------------------------------------
+//  emit_insert_carry - set the UML carry flag
+//  from bit 0 of a register, leaving the other
+//  flags alone
+//-------------------------------------------------
+
+void drcbe_arm64::emit_insert_carry(arm64code *&dst, UINT8 carryreg)
+{
+	emit_mrs_nzcv(dst, REG_TEMP);                                                       // mrs   x16,nzcv
+	emit_bfi(dst, true, REG_TEMP, carryreg, 29, 1);                                     // bfi   x16,carryreg,#29,#1
+	emit_eor_imm(dst, true, REG_TEMP, REG_TEMP, NZCV_C);                                // eor   x16,x16,#NZCV_C
+	emit_msr_nzcv(dst, REG_TEMP);                                                       // msr   nzcv,x16
+}
+
+
+//-------------------------------------------------
+//  emit_set_fpcr_rounding - set the FPCR rounding
+//  mode from a UML rounding mode in a register;
+//  adding 3 maps TRUNC/ROUND/CEIL/FLOOR onto
+//  RZ/RN/RP/RM
+//-------------------------------------------------
+
+void drcbe_arm64::emit_set_fpcr_rounding(arm64code *&dst, UINT8 modereg)
+{
+	emit_add_imm(dst, false, REG_SCRATCH2, modereg, 3);                                 // add   w10,modereg,#3
+	emit_mrs_fpcr(dst, REG_TEMP);                                                       // mrs   x16,fpcr
+	emit_bfi(dst, true, REG_TEMP, REG_SCRATCH2, 22, 2);                                 // bfi   x16,x10,#22,#2
+	emit_msr_fpcr(dst, REG_TEMP);                                                       // msr   fpcr,x16
+}
+
+
+//-------------------------------------------------
+//  emit_skip_unless - branch around the code that
+//  follows unless the instruction's condition
+//  holds; the caller resolves the link
+//-------------------------------------------------
+
+void drcbe_arm64::emit_skip_unless(arm64code *&dst, const instruction &inst, arm64_link &skip)
+{
+	skip.target = nullptr;
+	if (inst.condition() != uml::COND_ALWAYS)
+		emit_b_cond_link(dst, A64_NOT_CONDITION(inst.condition()), skip);               // b.!cond skip
+}
+
+
+
+/***************************************************************************
+    OUT-OF-BAND CODE FIXUP CALLBACKS
+***************************************************************************/
+
+//-------------------------------------------------
+//  fixup_label - callback to fixup forward-
+//  referenced labels
+//-------------------------------------------------
+
+void drcbe_arm64::fixup_label(void *parameter, drccodeptr labelcodeptr)
+{
+	arm64code *src = (arm64code *)parameter;
+
+	// B, B.cond and CBZ/CBNZ are the only branches we emit to labels
+	if ((*src & 0x7c000000) == 0x14000000 || (*src & 0xff000010) == 0x54000000 || (*src & 0x7e000000) == 0x34000000)
+		set_branch_target(src, labelcodeptr);
+	else
+		fatalerror("fixup_label called with invalid jmp source!\n");
+}
+
+
+
+//**************************************************************************
+//  DEBUG HELPERS
+//**************************************************************************
+
+//-------------------------------------------------
+//  debug_log_hashjmp - callback to handle
+//  logging of hashjmps
+//-------------------------------------------------
+
+void drcbe_arm64::debug_log_hashjmp(offs_t pc, int mode)
+{
+	printf("mode=%d PC=%08X\n", mode, pc);
+}
+
+
+//-------------------------------------------------
+//  debug_log_hashjmp - callback to handle
+//  logging of hashjmps
+//-------------------------------------------------
+
+void drcbe_arm64::debug_log_hashjmp_fail()
+{
+	printf("  (FAIL)\n");
+}
+
+
+
+/***************************************************************************
+    COMPILE-TIME OPCODES
+***************************************************************************/
+
+//-------------------------------------------------
+//  op_handle - process a HANDLE opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_handle(arm64code *&dst, const instruction &inst)
+{
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+	assert(inst.numparams() == 1);
+	assert(inst.param(0).is_code_handle());
+
+	// emit a jump around the stack adjust in case code falls through here
+	arm64_link skip;
+	emit_b_link(dst, skip);                                                             // b     skip
+
+	// register the current pointer for the handle
+	inst.param(0).handle().set_codeptr((drccodeptr)dst);
+
+	// by default, the handle points to prolog code that saves the return address
+	emit_str_x_pre(dst, REG_LR, REG_SP, -16);                                           // str   x30,[sp,#-16]!
+	resolve_link(dst, skip);                                                            // skip:
+}
+
+
+//-------------------------------------------------
+//  op_hash - process a HASH opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_hash(arm64code *&dst, const instruction &inst)
+{
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+	assert(inst.numparams() == 2);
+	assert(inst.param(0).is_immediate());
+	assert(inst.param(1).is_immediate());
+
+	// register the current pointer for the mode/PC
+	m_hash.set_codeptr(inst.param(0).immediate(), inst.param(1).immediate(), (drccodeptr)dst);
+}
+
+
+//-------------------------------------------------
+//  op_label - process a LABEL opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_label(arm64code *&dst, const instruction &inst)
+{
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+	assert(inst.numparams() == 1);
+	assert(inst.param(0).is_code_label());
+
+	// register the current pointer for the label
+	m_labels.set_codeptr(inst.param(0).label(), (drccodeptr)dst);
+}
+
+
+//-------------------------------------------------
+//  op_comment - process a COMMENT opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_comment(arm64code *&dst, const instruction &inst)
+{
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+	assert(inst.numparams() == 1);
+	assert(inst.param(0).is_string());
+
+	// do nothing
+}
+
+
+//-------------------------------------------------
+//  op_mapvar - process a MAPVAR opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_mapvar(arm64code *&dst, const instruction &inst)
+{
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+	assert(inst.numparams() == 2);
+	assert(inst.param(0).is_mapvar());
+	assert(inst.param(1).is_immediate());
+
+	// set the value of the specified mapvar
+	m_map.set_value((drccodeptr)dst, inst.param(0).mapvar(), inst.param(1).immediate());
+}
+
+
+
+/***************************************************************************
+    CONTROL FLOW OPCODES
+***************************************************************************/
+
+//-------------------------------------------------
+//  op_nop - process a NOP opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_nop(arm64code *&dst, const instruction &inst)
+{
+	// nothing
+}
+
+
+//-------------------------------------------------
+//  op_debug - process a DEBUG opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_debug(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	if ((m_device.machine().debug_flags & DEBUG_FLAG_ENABLED) != 0)
+	{
+		// normalize parameters
+		be_parameter pcp(*this, inst.param(0), PTYPE_MRI);
+
+		// test and branch
+		emit_mov_r64_imm(dst, REG_TEMP, (FPTR)&m_device.machine().debug_flags);         // mov   x16,&debug_flags
+		emit_ldst_offset(dst, LDST_LDRW, REG_TEMP, REG_TEMP, 0);                        // ldr   w16,[x16]
+		emit_tst_imm(dst, false, REG_TEMP, DEBUG_FLAG_CALL_HOOK);                       // tst   w16,DEBUG_FLAG_CALL_HOOK
+		arm64_link skip;
+		emit_b_cond_link(dst, arm64emit::COND_EQ, skip);                                // b.eq  skip
+
+		// push the parameter
+		emit_mov_r64_imm(dst, REG_PARAM1, (FPTR)&m_device);                             // mov   param1,device
+		emit_mov_r_p(dst, false, REG_PARAM2, pcp);                                      // mov   param2,pcp
+		emit_call_m64(dst, &m_near.debug_cpu_instruction_hook);                         // call  debug_cpu_instruction_hook
+
+		resolve_link(dst, skip);                                                        // skip:
+	}
+}
+
+
+//-------------------------------------------------
+//  op_exit - process an EXIT opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_exit(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_any_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter retp(*this, inst.param(0), PTYPE_MRI);
+
+	// the exit point may be out of range of B.cond, so branch around it instead
+	arm64_link skip;
+	emit_skip_unless(dst, inst, skip);                                                  // b.!cond skip
+
+	// load the parameter into W0
+	emit_mov_r_p(dst, false, REG_X0, retp);                                             // mov   w0,retp
+	emit_smart_branch(dst, m_exit);                                                     // b     exit
+
+	if (inst.condition() != uml::COND_ALWAYS)
+		resolve_link(dst, skip);                                                        // skip:
+}
+
+
+//-------------------------------------------------
+//  op_hashjmp - process a HASHJMP opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_hashjmp(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter modep(*this, inst.param(0), PTYPE_MRI);
+	be_parameter pcp(*this, inst.param(1), PTYPE_MRI);
+	const parameter &exp = inst.param(2);
+	assert(exp.is_code_handle());
+
+	if (LOG_HASHJMPS)
+	{
+		emit_mov_r_p(dst, false, REG_PARAM1, pcp);
+		emit_mov_r_p(dst, false, REG_PARAM2, modep);
+		emit_call_m64(dst, &m_near.debug_log_hashjmp);
+	}
+
+	// reset the stack to the top level before calling the target
+	emit_add_imm(dst, true, REG_SP, REG_FP, 0);                                         // mov   sp,x29
+
+	// the hash masks are always contiguous low bits
+	int l1bits = 0, l2bits = 0;
+	for (offs_t mask = m_hash.l1mask(); mask != 0; mask >>= 1)
+		l1bits++;
+	for (offs_t mask = m_hash.l2mask(); mask != 0; mask >>= 1)
+		l2bits++;
+
+	// fixed mode cases
+	if (modep.is_immediate() && m_hash.is_mode_populated(modep.immediate()))
+	{
+		// a straight immediate jump is direct, and can be linked to the target later
+		if (pcp.is_immediate())
+		{
+			UINT32 mode = modep.immediate();
+			UINT32 pc = pcp.immediate();
+			m_link_sites[(UINT64(mode) << 32) | pc].push_back(dst);
+			write_link_site(dst, mode, pc);                                             // call  hash[modep][l1val][l2val]
+			dst += LINK_SITE_SIZE;                                                      // or  bl    target
+		}
+
+		// a fixed mode but variable PC
+		else
+		{
+			UINT8 pcreg = emit_load_p(dst, false, REG_SCRATCH1, pcp);                   // mov   w9,pcp
+			emit_hash_index(dst, REG_SCRATCH2, pcreg, m_hash.l1shift(), l1bits);        // ubfx  w10,pcreg,#l1shift,#l1bits
+			emit_hash_index(dst, REG_SCRATCH3, pcreg, m_hash.l2shift(), l2bits);        // ubfx  w11,pcreg,#l2shift,#l2bits
+			emit_load_address(dst, REG_TEMP, m_hash.base()[modep.immediate()]);         // mov   x16,hash[modep]
+			emit_ldst_index(dst, LDST_LDRX, REG_TEMP, REG_TEMP, REG_SCRATCH2, EXTEND_UXTW, true);
+																						// ldr   x16,[x16,w10,uxtw #3]
+			emit_ldst_index(dst, LDST_LDRX, REG_TEMP, REG_TEMP, REG_SCRATCH3, EXTEND_UXTW, true);
+																						// ldr   x16,[x16,w11,uxtw #3]
+			emit_blr(dst, REG_TEMP);                                                    // blr   x16
+		}
+	}
+	else
+	{
+		// variable mode
+		UINT8 modereg = emit_load_p(dst, false, REG_SCRATCH4, modep);                   // mov   w12,modep
+		emit_load_address(dst, REG_TEMP, m_hash.base());                                // mov   x16,hash
+		emit_ldst_index(dst, LDST_LDRX, REG_TEMP, REG_TEMP, modereg, EXTEND_UXTW, true);// ldr   x16,[x16,modereg,uxtw #3]
+
+		// fixed PC
+		if (pcp.is_immediate())
+		{
+			UINT32 l1val = (pcp.immediate() >> m_hash.l1shift()) & m_hash.l1mask();
+			UINT32 l2val = (pcp.immediate() >> m_hash.l2shift()) & m_hash.l2mask();
+			if (is_ldst_offset(LDST_LDRX, l1val * 8))
+				emit_ldst_offset(dst, LDST_LDRX, REG_TEMP, REG_TEMP, l1val * 8);        // ldr   x16,[x16,#l1val*8]
+			else
+			{
+				emit_mov_r_p(dst, false, REG_SCRATCH2, be_parameter(l1val));            // mov   w10,l1val
+				emit_ldst_index(dst, LDST_LDRX, REG_TEMP, REG_TEMP, REG_SCRATCH2, EXTEND_UXTW, true);
+																						// ldr   x16,[x16,w10,uxtw #3]
+			}
+			if (is_ldst_offset(LDST_LDRX, l2val * 8))
+				emit_ldst_offset(dst, LDST_LDRX, REG_TEMP, REG_TEMP, l2val * 8);        // ldr   x16,[x16,#l2val*8]
+			else
+			{
+				emit_mov_r_p(dst, false, REG_SCRATCH3, be_parameter(l2val));            // mov   w11,l2val
+				emit_ldst_index(dst, LDST_LDRX, REG_TEMP, REG_TEMP, REG_SCRATCH3, EXTEND_UXTW, true);
+																						// ldr   x16,[x16,w11,uxtw #3]
+			}
+		}
+
+		// variable PC
+		else
+		{
+			UINT8 pcreg = emit_load_p(dst, false, REG_SCRATCH1, pcp);                   // mov   w9,pcp
+			emit_hash_index(dst, REG_SCRATCH2, pcreg, m_hash.l1shift(), l1bits);        // ubfx  w10,pcreg,#l1shift,#l1bits
+			emit_hash_index(dst, REG_SCRATCH3, pcreg, m_hash.l2shift(), l2bits);        // ubfx  w11,pcreg,#l2shift,#l2bits
+			emit_ldst_index(dst, LDST_LDRX, REG_TEMP, REG_TEMP, REG_SCRATCH2, EXTEND_UXTW, true);
+																						// ldr   x16,[x16,w10,uxtw #3]
+			emit_ldst_index(dst, LDST_LDRX, REG_TEMP, REG_TEMP, REG_SCRATCH3, EXTEND_UXTW, true);
+																						// ldr   x16,[x16,w11,uxtw #3]
+		}
+		emit_blr(dst, REG_TEMP);                                                        // blr   x16
+	}
+
+	// in all cases, if there is no code, we return here to generate the exception
+	if (LOG_HASHJMPS)
+		emit_call_m64(dst, &m_near.debug_log_hashjmp_fail);
+
+	UINT8 pcreg = emit_load_p(dst, false, REG_SCRATCH1, pcp);                           // mov   w9,pcp
+	emit_ldst_abs(dst, LDST_STRW, pcreg, &m_state.exp);                                 // str   w9,[exp]
+	emit_call_m64(dst, exp.handle().codeptr_addr());                                    // call  [exp]
+}
+
+
+//-------------------------------------------------
+//  op_jmp - process a JMP opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_jmp(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_any_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	const parameter &labelp = inst.param(0);
+	assert(labelp.is_code_label());
+
+	// look up the jump target and jump there; unresolved targets are patched by fixup_label
+	arm64code *jmptarget = (arm64code *)m_labels.get_codeptr(labelp.label(), m_fixup_label, dst);
+	if (jmptarget == nullptr)
+		jmptarget = dst;
+	if (inst.condition() == uml::COND_ALWAYS)
+		emit_b(dst, jmptarget);                                                         // b     target
+	else
+		emit_b_cond(dst, A64_CONDITION(inst.condition()), jmptarget);                   // b.cond target
+}
+
+
+//-------------------------------------------------
+//  op_exh - process an EXH opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_exh(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_any_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	const parameter &handp = inst.param(0);
+	assert(handp.is_code_handle());
+	be_parameter exp(*this, inst.param(1), PTYPE_MRI);
+
+	// look up the handle target
+	drccodeptr *targetptr = handp.handle().codeptr_addr();
+
+	// skip if conditional; the call is short enough that it isn't worth moving out of line
+	arm64_link skip;
+	emit_skip_unless(dst, inst, skip);                                                  // b.!cond skip
+
+	// perform the exception processing
+	UINT8 expreg = emit_load_p(dst, false, REG_SCRATCH1, exp);                          // mov   w9,exp
+	emit_ldst_abs(dst, LDST_STRW, expreg, &m_state.exp);                                // str   w9,[exp]
+	if (*targetptr != nullptr)
+		emit_smart_call(dst, *targetptr);                                               // bl    *targetptr
+	else
+		emit_call_m64(dst, targetptr);                                                  // call  [targetptr]
+
+	// resolve the conditional link
+	if (inst.condition() != uml::COND_ALWAYS)
+		resolve_link(dst, skip);                                                        // skip:
+}
+
+
+//-------------------------------------------------
+//  op_callh - process a CALLH opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_callh(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_any_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	const parameter &handp = inst.param(0);
+	assert(handp.is_code_handle());
+
+	// look up the handle target
+	drccodeptr *targetptr = handp.handle().codeptr_addr();
+
+	// skip if conditional
+	arm64_link skip;
+	emit_skip_unless(dst, inst, skip);                                                  // b.!cond skip
+
+	// jump through the handle; directly if a normal jump
+	if (*targetptr != nullptr)
+		emit_smart_call(dst, *targetptr);                                               // bl    *targetptr
+	else
+		emit_call_m64(dst, targetptr);                                                  // call  [targetptr]
+
+	// resolve the conditional link
+	if (inst.condition() != uml::COND_ALWAYS)
+		resolve_link(dst, skip);                                                        // skip:
+}
+
+
+//-------------------------------------------------
+//  op_ret - process a RET opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_ret(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_any_condition(inst);
+	assert_no_flags(inst);
+	assert(inst.numparams() == 0);
+
+	// skip if conditional
+	arm64_link skip;
+	emit_skip_unless(dst, inst, skip);                                                  // b.!cond skip
+
+	// return
+	emit_ldr_x_post(dst, REG_LR, REG_SP, 16);                                           // ldr   x30,[sp],#16
+	emit_ret(dst);                                                                      // ret
+
+	// resolve the conditional link
+	if (inst.condition() != uml::COND_ALWAYS)
+		resolve_link(dst, skip);                                                        // skip:
+}
+
+
+//-------------------------------------------------
+//  op_callc - process a CALLC opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_callc(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_any_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	const parameter &funcp = inst.param(0);
+	assert(funcp.is_c_function());
+	be_parameter paramp(*this, inst.param(1), PTYPE_M);
+
+	// skip if conditional
+	arm64_link skip;
+	emit_skip_unless(dst, inst, skip);                                                  // b.!cond skip
+
+	// perform the call
+	emit_mov_r64_imm(dst, REG_PARAM1, (FPTR)paramp.memory());                           // mov   param1,paramp
+	emit_smart_call(dst, (const void *)(FPTR)funcp.cfunc());                            // bl    funcp
+
+	// resolve the conditional link
+	if (inst.condition() != uml::COND_ALWAYS)
+		resolve_link(dst, skip);                                                        // skip:
+}
+
+
+//-------------------------------------------------
+//  op_recover - process a RECOVER opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_recover(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+
+	// call the recovery code with the return address the handle saved just below the top level frame
+	emit_sub_imm(dst, true, REG_PARAM2, REG_FP, 16);                                    // sub   x1,x29,#16
+	emit_ldst_offset(dst, LDST_LDRX, REG_PARAM2, REG_PARAM2, 0);                        // ldr   x1,[x1]
+	emit_sub_imm(dst, true, REG_PARAM2, REG_PARAM2, 4);                                 // sub   x1,x1,#4
+	emit_mov_r64_imm(dst, REG_PARAM1, (FPTR)&m_map);                                    // mov   param1,m_map
+	emit_mov_r64_imm(dst, REG_PARAM3, inst.param(1).mapvar());                          // mov   param3,param[1].value
+	emit_call_m64(dst, &m_near.drcmap_get_value);                                       // call  drcmap_get_value
+	emit_store_p(dst, false, dstp, REG_X0);                                             // mov   dstp,w0
+}
+
+
+
+/***************************************************************************
+    INTERNAL REGISTER OPCODES
+***************************************************************************/
+
+//-------------------------------------------------
+//  op_setfmod - process a SETFMOD opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_setfmod(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter srcp(*this, inst.param(0), PTYPE_MRI);
+
+	// immediate case
+	if (srcp.is_immediate())
+		emit_movz(dst, false, REG_SCRATCH1, srcp.immediate() & 3, 0);                   // movz  w9,srcp & 3
+
+	// register/memory case
+	else
+	{
+		emit_mov_r_p(dst, false, REG_SCRATCH1, srcp);                                   // mov   w9,srcp
+		emit_and_imm(dst, false, REG_SCRATCH1, REG_SCRATCH1, 3);                        // and   w9,w9,3
+	}
+	emit_ldst_abs(dst, LDST_STRB, REG_SCRATCH1, &m_state.fmod);                         // strb  w9,[fmod]
+	emit_set_fpcr_rounding(dst, REG_SCRATCH1);                                          // <set fpcr rounding from w9>
+}
+
+
+//-------------------------------------------------
+//  op_getfmod - process a GETFMOD opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_getfmod(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	int dstreg = dstp.select_register(REG_SCRATCH1);
+
+	emit_ldst_abs(dst, LDST_LDRB, dstreg, &m_state.fmod);                               // ldrb  dstreg,[fmod]
+	emit_store_p(dst, false, dstp, dstreg);                                             // mov   dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  op_getexp - process a GETEXP opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_getexp(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	int dstreg = dstp.select_register(REG_SCRATCH1);
+
+	emit_ldst_abs(dst, LDST_LDRW, dstreg, &m_state.exp);                                // ldr   dstreg,[exp]
+	emit_store_p(dst, false, dstp, dstreg);                                             // mov   dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  op_getflgs - process a GETFLGS opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_getflgs(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter maskp(*this, inst.param(1), PTYPE_I);
+
+	// pick a target register for the general case
+	int dstreg = dstp.select_register(REG_SCRATCH1);
+	UINT32 mask = maskp.immediate() & (FLAG_C | FLAG_V | FLAG_Z | FLAG_S | FLAG_U);
+
+	if (mask == 0)
+		emit_mov_reg(dst, false, dstreg, REG_ZR);                                       // mov   dstreg,wzr
+	else
+	{
+		// look up NZCV in the flags map
+		emit_mrs_nzcv(dst, REG_TEMP);                                                   // mrs   x16,nzcv
+		emit_lsr_imm(dst, true, REG_TEMP, REG_TEMP, 28);                                // lsr   x16,x16,#28
+		emit_load_address(dst, REG_ADDR, &m_near.flagsmap[0]);                          // mov   x17,flags_map
+		emit_ldst_index(dst, LDST_LDRB, dstreg, REG_ADDR, REG_TEMP, EXTEND_UXTX, false);// ldrb  dstreg,[x17,x16]
+
+		// and keep only the flags asked for
+		if (mask != (FLAG_C | FLAG_V | FLAG_Z | FLAG_S | FLAG_U))
+		{
+			if (is_logical_immediate(mask, false))
+				emit_and_imm(dst, false, dstreg, dstreg, mask);                         // and   dstreg,dstreg,mask
+			else
+			{
+				emit_movz(dst, false, REG_TEMP, mask, 0);                               // movz  w16,mask
+				emit_and_reg(dst, false, dstreg, dstreg, REG_TEMP);                     // and   dstreg,dstreg,w16
+			}
+		}
+	}
+
+	emit_store_p(dst, false, dstp, dstreg);                                             // mov   dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  op_save - process a SAVE opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_save(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_M);
+
+	// copy live state to the destination
+	emit_mov_r64_imm(dst, REG_SCRATCH1, (FPTR)dstp.memory());                           // mov   x9,dstp
+
+	// copy flags
+	emit_mrs_nzcv(dst, REG_TEMP);                                                       // mrs   x16,nzcv
+	emit_lsr_imm(dst, true, REG_TEMP, REG_TEMP, 28);                                    // lsr   x16,x16,#28
+	emit_load_address(dst, REG_ADDR, &m_near.flagsmap[0]);                              // mov   x17,flags_map
+	emit_ldst_index(dst, LDST_LDRB, REG_TEMP, REG_ADDR, REG_TEMP, EXTEND_UXTX, false);  // ldrb  w16,[x17,x16]
+	emit_ldst_offset(dst, LDST_STRB, REG_TEMP, REG_SCRATCH1, offsetof(drcuml_machine_state, flags));
+																						// strb  w16,state->flags
+
+	// copy fmod and exp
+	emit_ldst_abs(dst, LDST_LDRB, REG_TEMP, &m_state.fmod);                             // ldrb  w16,[fmod]
+	emit_ldst_offset(dst, LDST_STRB, REG_TEMP, REG_SCRATCH1, offsetof(drcuml_machine_state, fmod));
+																						// strb  w16,state->fmod
+	emit_ldst_abs(dst, LDST_LDRW, REG_TEMP, &m_state.exp);                              // ldr   w16,[exp]
+	emit_ldst_offset(dst, LDST_STRW, REG_TEMP, REG_SCRATCH1, offsetof(drcuml_machine_state, exp));
+																						// str   w16,state->exp
+
+	// copy integer registers
+	int regoffs = offsetof(drcuml_machine_state, r);
+	for (int regnum = 0; regnum < ARRAY_LENGTH(m_state.r); regnum++)
+	{
+		if (int_register_map[regnum] != 0)
+			emit_ldst_offset(dst, LDST_STRX, int_register_map[regnum], REG_SCRATCH1, regoffs + 8 * regnum);
+		else
+		{
+			emit_ldst_abs(dst, LDST_LDRX, REG_TEMP, &m_state.r[regnum].d);
+			emit_ldst_offset(dst, LDST_STRX, REG_TEMP, REG_SCRATCH1, regoffs + 8 * regnum);
+		}
+	}
+
+	// copy FP registers
+	regoffs = offsetof(drcuml_machine_state, f);
+	for (int regnum = 0; regnum < ARRAY_LENGTH(m_state.f); regnum++)
+	{
+		if (float_register_map[regnum] != 0)
+			emit_ldst_offset(dst, LDST_STRD, float_register_map[regnum], REG_SCRATCH1, regoffs + 8 * regnum);
+		else
+		{
+			emit_ldst_abs(dst, LDST_LDRX, REG_TEMP, &m_state.f[regnum].d);
+			emit_ldst_offset(dst, LDST_STRX, REG_TEMP, REG_SCRATCH1, regoffs + 8 * regnum);
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  op_restore - process a RESTORE opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_restore(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_no_condition(inst);
+
+	// normalize parameters
+	be_parameter srcp(*this, inst.param(0), PTYPE_M);
+
+	// copy live state from the destination
+	emit_mov_r64_imm(dst, REG_SCRATCH1, (FPTR)srcp.memory());                           // mov   x9,srcp
+
+	// copy integer registers
+	int regoffs = offsetof(drcuml_machine_state, r);
+	for (int regnum = 0; regnum < ARRAY_LENGTH(m_state.r); regnum++)
+	{
+		if (int_register_map[regnum] != 0)
+			emit_ldst_offset(dst, LDST_LDRX, int_register_map[regnum], REG_SCRATCH1, regoffs + 8 * regnum);
+		else
+		{
+			emit_ldst_offset(dst, LDST_LDRX, REG_TEMP, REG_SCRATCH1, regoffs + 8 * regnum);
+			emit_ldst_abs(dst, LDST_STRX, REG_TEMP, &m_state.r[regnum].d);
+		}
+	}
+
+	// copy FP registers
+	regoffs = offsetof(drcuml_machine_state, f);
+	for (int regnum = 0; regnum < ARRAY_LENGTH(m_state.f); regnum++)
+	{
+		if (float_register_map[regnum] != 0)
+			emit_ldst_offset(dst, LDST_LDRD, float_register_map[regnum], REG_SCRATCH1, regoffs + 8 * regnum);
+		else
+		{
+			emit_ldst_offset(dst, LDST_LDRX, REG_TEMP, REG_SCRATCH1, regoffs + 8 * regnum);
+			emit_ldst_abs(dst, LDST_STRX, REG_TEMP, &m_state.f[regnum].d);
+		}
+	}
+
+	// copy fmod and exp
+	emit_ldst_offset(dst, LDST_LDRB, REG_SCRATCH3, REG_SCRATCH1, offsetof(drcuml_machine_state, fmod));
+																						// ldrb  w11,state->fmod
+	emit_and_imm(dst, false, REG_SCRATCH3, REG_SCRATCH3, 3);                            // and   w11,w11,3
+	emit_ldst_abs(dst, LDST_STRB, REG_SCRATCH3, &m_state.fmod);                         // strb  w11,[fmod]
+	emit_set_fpcr_rounding(dst, REG_SCRATCH3);                                          // <set fpcr rounding from w11>
+	emit_ldst_offset(dst, LDST_LDRW, REG_SCRATCH3, REG_SCRATCH1, offsetof(drcuml_machine_state, exp));
+																						// ldr   w11,state->exp
+	emit_ldst_abs(dst, LDST_STRW, REG_SCRATCH3, &m_state.exp);                          // str   w11,[exp]
+
+	// copy flags
+	emit_ldst_offset(dst, LDST_LDRB, REG_SCRATCH3, REG_SCRATCH1, offsetof(drcuml_machine_state, flags));
+																						// ldrb  w11,state->flags
+	emit_and_imm(dst, false, REG_SCRATCH3, REG_SCRATCH3, 0x1f);                         // and   w11,w11,0x1f
+	emit_load_address(dst, REG_ADDR, &m_near.flagsunmap[0]);                            // mov   x17,flags_unmap
+	emit_ldst_index(dst, LDST_LDRX, REG_TEMP, REG_ADDR, REG_SCRATCH3, EXTEND_UXTW, true);
+																						// ldr   x16,[x17,w11,uxtw #3]
+	emit_msr_nzcv(dst, REG_TEMP);                                                       // msr   nzcv,x16
+}
+
+
+
+/***************************************************************************
+    INTEGER OPERATIONS
+***************************************************************************/
+
+//-------------------------------------------------
+//  op_load - process a LOAD opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_load(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter basep(*this, inst.param(1), PTYPE_M);
+	be_parameter indp(*this, inst.param(2), PTYPE_MRI);
+	const parameter &scalesizep = inst.param(3);
+	assert(scalesizep.is_size_scale());
+	int scale = scalesizep.scale();
+	int size = scalesizep.size();
+
+	// pick a target register for the general case
+	int dstreg = dstp.select_register(REG_SCRATCH1);
+
+	// byte, word and dword loads zero-extend all the way
+	static const UINT32 s_load_op[] = { LDST_LDRB, LDST_LDRH, LDST_LDRW, LDST_LDRX };
+	UINT32 op = s_load_op[size];
+	if (inst.size() == 4 && op == LDST_LDRX)
+		op = LDST_LDRW;
+	emit_ldst_indexed(dst, op, dstreg, basep.memory(), indp, scale, EXTEND_SXTW);       // ldr   dstreg,[basep + scale*indp]
+
+	// store the result
+	emit_store_p(dst, inst.size() == 8, dstp, dstreg);                                  // mov   dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  op_loads - process a LOADS opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_loads(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter basep(*this, inst.param(1), PTYPE_M);
+	be_parameter indp(*this, inst.param(2), PTYPE_MRI);
+	const parameter &scalesizep = inst.param(3);
+	assert(scalesizep.is_size_scale());
+	int scale = scalesizep.scale();
+	int size = scalesizep.size();
+
+	// pick a target register for the general case
+	int dstreg = dstp.select_register(REG_SCRATCH1);
+
+	// sign-extend to the size of the instruction
+	static const UINT32 s_load32_op[] = { LDST_LDRSBW, LDST_LDRSHW, LDST_LDRW, LDST_LDRW };
+	static const UINT32 s_load64_op[] = { LDST_LDRSB, LDST_LDRSH, LDST_LDRSW, LDST_LDRX };
+	UINT32 op = (inst.size() == 4) ? s_load32_op[size] : s_load64_op[size];
+	emit_ldst_indexed(dst, op, dstreg, basep.memory(), indp, scale, EXTEND_SXTW);       // ldrs  dstreg,[basep + scale*indp]
+
+	// store the result
+	emit_store_p(dst, inst.size() == 8, dstp, dstreg);                                  // mov   dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  op_store - process a STORE opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_store(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter basep(*this, inst.param(0), PTYPE_M);
+	be_parameter indp(*this, inst.param(1), PTYPE_MRI);
+	be_parameter srcp(*this, inst.param(2), PTYPE_MRI);
+	const parameter &scalesizep = inst.param(3);
+	int scale = scalesizep.scale();
+	int size = scalesizep.size();
+
+	// zero comes for free from the zero register
+	UINT8 srcreg = REG_ZR;
+	if (!srcp.is_immediate_value(0))
+		srcreg = emit_load_p(dst, size == SIZE_QWORD, REG_SCRATCH1, srcp);              // mov   w9,srcp
+
+	static const UINT32 s_store_op[] = { LDST_STRB, LDST_STRH, LDST_STRW, LDST_STRX };
+	emit_ldst_indexed(dst, s_store_op[size], srcreg, basep.memory(), indp, scale, EXTEND_SXTW);
+																						// str   srcreg,[basep + scale*indp]
+}
+
+
+//-------------------------------------------------
+//  op_read - process a READ opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_read(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter addrp(*this, inst.param(1), PTYPE_MRI);
+	const parameter &spacesizep = inst.param(2);
+	assert(spacesizep.is_size_space());
+
+	// set up a call to the read byte handler
+	emit_mov_r64_imm(dst, REG_PARAM1, (FPTR)(m_space[spacesizep.space()]));             // mov   param1,space
+	emit_mov_r_p(dst, false, REG_PARAM2, addrp);                                        // mov   param2,addrp
+	if (spacesizep.size() == SIZE_BYTE)
+	{
+		emit_call_m64(dst, &m_accessors[spacesizep.space()].read_byte);                 // call  read_byte
+		emit_uxtb(dst, REG_X0, REG_X0);                                                 // uxtb  w0,w0
+	}
+	else if (spacesizep.size() == SIZE_WORD)
+	{
+		emit_call_m64(dst, &m_accessors[spacesizep.space()].read_word);                 // call  read_word
+		emit_uxth(dst, REG_X0, REG_X0);                                                 // uxth  w0,w0
+	}
+	else if (spacesizep.size() == SIZE_DWORD)
+	{
+		emit_call_m64(dst, &m_accessors[spacesizep.space()].read_dword);                // call  read_dword
+		if (inst.size() == 8)
+			emit_mov_reg(dst, false, REG_X0, REG_X0);                                   // mov   w0,w0
+	}
+	else if (spacesizep.size() == SIZE_QWORD)
+		emit_call_m64(dst, &m_accessors[spacesizep.space()].read_qword);                // call  read_qword
+
+	// store the result
+	emit_store_p(dst, inst.size() == 8, dstp, REG_X0);                                  // mov   dstp,x0
+}
+
+
+//-------------------------------------------------
+//  op_readm - process a READM opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_readm(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter addrp(*this, inst.param(1), PTYPE_MRI);
+	be_parameter maskp(*this, inst.param(2), PTYPE_MRI);
+	const parameter &spacesizep = inst.param(3);
+	assert(spacesizep.is_size_space());
+
+	// set up a call to the read handler
+	emit_mov_r64_imm(dst, REG_PARAM1, (FPTR)(m_space[spacesizep.space()]));             // mov   param1,space
+	emit_mov_r_p(dst, false, REG_PARAM2, addrp);                                        // mov   param2,addrp
+	emit_mov_r_p(dst, spacesizep.size() == SIZE_QWORD, REG_PARAM3, maskp);              // mov   param3,maskp
+	if (spacesizep.size() == SIZE_WORD)
+	{
+		emit_call_m64(dst, &m_accessors[spacesizep.space()].read_word_masked);          // call  read_word_masked
+		emit_uxth(dst, REG_X0, REG_X0);                                                 // uxth  w0,w0
+	}
+	else if (spacesizep.size() == SIZE_DWORD)
+	{
+		emit_call_m64(dst, &m_accessors[spacesizep.space()].read_dword_masked);         // call  read_dword_masked
+		if (inst.size() == 8)
+			emit_mov_reg(dst, false, REG_X0, REG_X0);                                   // mov   w0,w0
+	}
+	else if (spacesizep.size() == SIZE_QWORD)
+		emit_call_m64(dst, &m_accessors[spacesizep.space()].read_qword_masked);         // call  read_qword_masked
+
+	// store the result
+	emit_store_p(dst, inst.size() == 8, dstp, REG_X0);                                  // mov   dstp,x0
+}
+
+
+//-------------------------------------------------
+//  op_write - process a WRITE opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_write(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter addrp(*this, inst.param(0), PTYPE_MRI);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MRI);
+	const parameter &spacesizep = inst.param(2);
+	assert(spacesizep.is_size_space());
+
+	// set up a call to the write handler
+	emit_mov_r64_imm(dst, REG_PARAM1, (FPTR)(m_space[spacesizep.space()]));             // mov   param1,space
+	emit_mov_r_p(dst, false, REG_PARAM2, addrp);                                        // mov   param2,addrp
+	emit_mov_r_p(dst, spacesizep.size() == SIZE_QWORD, REG_PARAM3, srcp);               // mov   param3,srcp
+	if (spacesizep.size() == SIZE_BYTE)
+		emit_call_m64(dst, &m_accessors[spacesizep.space()].write_byte);                // call  write_byte
+	else if (spacesizep.size() == SIZE_WORD)
+		emit_call_m64(dst, &m_accessors[spacesizep.space()].write_word);                // call  write_word
+	else if (spacesizep.size() == SIZE_DWORD)
+		emit_call_m64(dst, &m_accessors[spacesizep.space()].write_dword);               // call  write_dword
+	else if (spacesizep.size() == SIZE_QWORD)
+		emit_call_m64(dst, &m_accessors[spacesizep.space()].write_qword);               // call  write_qword
+}
+
+
+//-------------------------------------------------
+//  op_writem - process a WRITEM opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_writem(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter addrp(*this, inst.param(0), PTYPE_MRI);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MRI);
+	be_parameter maskp(*this, inst.param(2), PTYPE_MRI);
+	const parameter &spacesizep = inst.param(3);
+	assert(spacesizep.is_size_space());
+
+	// set up a call to the write handler
+	emit_mov_r64_imm(dst, REG_PARAM1, (FPTR)(m_space[spacesizep.space()]));             // mov   param1,space
+	emit_mov_r_p(dst, false, REG_PARAM2, addrp);                                        // mov   param2,addrp
+	emit_mov_r_p(dst, spacesizep.size() == SIZE_QWORD, REG_PARAM3, srcp);               // mov   param3,srcp
+	emit_mov_r_p(dst, spacesizep.size() == SIZE_QWORD, REG_PARAM4, maskp);              // mov   param4,maskp
+	if (spacesizep.size() == SIZE_WORD)
+		emit_call_m64(dst, &m_accessors[spacesizep.space()].write_word_masked);         // call  write_word_masked
+	else if (spacesizep.size() == SIZE_DWORD)
+		emit_call_m64(dst, &m_accessors[spacesizep.space()].write_dword_masked);        // call  write_dword_masked
+	else if (spacesizep.size() == SIZE_QWORD)
+		emit_call_m64(dst, &m_accessors[spacesizep.space()].write_qword_masked);        // call  write_qword_masked
+}
+
+
+//-------------------------------------------------
+//  op_carry - process a CARRY opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_carry(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_C);
+
+	// normalize parameters
+	be_parameter srcp(*this, inst.param(0), PTYPE_MRI);
+	be_parameter bitp(*this, inst.param(1), PTYPE_MRI);
+	bool is64 = (inst.size() == 8);
+
+	// shift the bit down to bit 0 of w9
+	if (bitp.is_immediate())
+	{
+		UINT8 srcreg = emit_load_p(dst, is64, REG_SCRATCH1, srcp);                      // mov   x9,srcp
+		emit_lsr_imm(dst, is64, REG_SCRATCH1, srcreg, bitp.immediate() & (inst.size() * 8 - 1));
+																						// lsr   x9,srcreg,bitp
+	}
+	else
+	{
+		UINT8 bitreg = emit_load_p(dst, false, REG_SCRATCH2, bitp);                     // mov   w10,bitp
+		UINT8 srcreg = emit_load_p(dst, is64, REG_SCRATCH1, srcp);                      // mov   x9,srcp
+		emit_lsrv(dst, is64, REG_SCRATCH1, srcreg, bitreg);                             // lsr   x9,srcreg,bitreg
+	}
+
+	// and set the carry from it without disturbing the other flags
+	emit_insert_carry(dst, REG_SCRATCH1);                                               // <C = w9 & 1>
+}
+
+
+//-------------------------------------------------
+//  op_set - process a SET opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_set(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_any_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+
+	// pick a target register for the general case
+	int dstreg = dstp.select_register(REG_SCRATCH1);
+
+	// set to 1 or 0 depending on the condition
+	if (inst.condition() == uml::COND_ALWAYS)
+		emit_movz(dst, false, dstreg, 1, 0);                                            // movz  dstreg,#1
+	else
+		emit_cset(dst, false, dstreg, A64_CONDITION(inst.condition()));                 // cset  dstreg,cond
+	emit_store_p(dst, inst.size() == 8, dstp, dstreg);                                  // mov   dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  op_mov - process a MOV opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_mov(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_any_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MRI);
+	bool is64 = (inst.size() == 8);
+
+	// skip if conditional; none of this touches the flags
+	arm64_link skip;
+	emit_skip_unless(dst, inst, skip);                                                  // b.!cond skip
+
+	// register destinations are loaded directly
+	if (dstp.is_int_register())
+		emit_mov_r_p(dst, is64, dstp.ireg(), srcp);                                     // mov   dstp,srcp
+
+	// memory destinations go through a register, or the zero register
+	else
+	{
+		UINT8 srcreg = REG_ZR;
+		if (!srcp.is_immediate_value(0))
+			srcreg = emit_load_p(dst, is64, REG_SCRATCH1, srcp);                        // mov   x9,srcp
+		emit_store_p(dst, is64, dstp, srcreg);                                          // mov   dstp,srcreg
+	}
+
+	// resolve the conditional link
+	if (inst.condition() != uml::COND_ALWAYS)
+		resolve_link(dst, skip);                                                        // skip:
+}
+
+
+//-------------------------------------------------
+//  op_sext - process a SEXT opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_sext(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_S | FLAG_Z);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MRI);
+	const parameter &sizep = inst.param(2);
+	assert(sizep.is_size());
+	bool is64 = (inst.size() == 8);
+
+	// pick a target register for the general case
+	int dstreg = dstp.select_register(REG_SCRATCH1);
+
+	// memory sources can be sign-extended as they are loaded
+	if (srcp.is_memory())
+	{
+		static const UINT32 s_load32_op[] = { LDST_LDRSBW, LDST_LDRSHW, LDST_LDRW, LDST_LDRW };
+		static const UINT32 s_load64_op[] = { LDST_LDRSB, LDST_LDRSH, LDST_LDRSW, LDST_LDRX };
+		emit_ldst_abs(dst, is64 ? s_load64_op[sizep.size()] : s_load32_op[sizep.size()], dstreg, srcp.memory());
+																						// ldrs  dstreg,[srcp]
+	}
+	else
+	{
+		UINT8 srcreg = emit_load_p(dst, is64, dstreg, srcp);                            // mov   dstreg,srcp
+		if (sizep.size() == SIZE_BYTE)
+			emit_sxtb(dst, is64, dstreg, srcreg);                                       // sxtb  dstreg,srcreg
+		else if (sizep.size() == SIZE_WORD)
+			emit_sxth(dst, is64, dstreg, srcreg);                                       // sxth  dstreg,srcreg
+		else if (sizep.size() == SIZE_DWORD && is64)
+			emit_sxtw(dst, dstreg, srcreg);                                             // sxtw  dstreg,srcreg
+		else if (dstreg != srcreg)
+			emit_mov_reg(dst, is64, dstreg, srcreg);                                    // mov   dstreg,srcreg
+	}
+	if (inst.flags() != 0)
+		emit_tst_reg(dst, is64, dstreg, dstreg);                                        // tst   dstreg,dstreg
+
+	emit_store_p(dst, is64, dstp, dstreg);                                              // mov   dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  op_roland - process an ROLAND opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_roland(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_S | FLAG_Z);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MRI);
+	be_parameter shiftp(*this, inst.param(2), PTYPE_MRI);
+	be_parameter maskp(*this, inst.param(3), PTYPE_MRI);
+	bool is64 = (inst.size() == 8);
+	int bits = inst.size() * 8;
+
+	// pick a target register for the general case
+	int dstreg = dstp.select_register(REG_SCRATCH1, shiftp, maskp);
+
+	// rotate left by rotating right the other way
+	UINT8 srcreg = emit_load_p(dst, is64, REG_SCRATCH1, srcp);                          // mov   x9,srcp
+	if (shiftp.is_immediate())
+	{
+		int shift = shiftp.immediate() & (bits - 1);
+		if (shift != 0)
+			emit_ror_imm(dst, is64, dstreg, srcreg, bits - shift);                      // ror   dstreg,srcreg,#bits-shiftp
+		else if (dstreg != srcreg)
+			emit_mov_reg(dst, is64, dstreg, srcreg);                                    // mov   dstreg,srcreg
+	}
+	else
+	{
+		UINT8 shiftreg = emit_load_p(dst, false, REG_SCRATCH2, shiftp);                 // mov   w10,shiftp
+		emit_neg(dst, false, REG_SCRATCH2, shiftreg);                                   // neg   w10,shiftreg
+		emit_rorv(dst, is64, dstreg, srcreg, REG_SCRATCH2);                             // ror   dstreg,srcreg,w10
+	}
+
+	// then mask, setting the flags if asked
+	UINT64 mask = maskp.is_immediate() ? (is64 ? maskp.immediate() : (UINT32)maskp.immediate()) : 0;
+	if (maskp.is_immediate() && is_logical_immediate(mask, is64))
+	{
+		if (inst.flags() != 0)
+			emit_ands_imm(dst, is64, dstreg, dstreg, mask);                             // ands  dstreg,dstreg,maskp
+		else
+			emit_and_imm(dst, is64, dstreg, dstreg, mask);                              // and   dstreg,dstreg,maskp
+	}
+	else
+	{
+		UINT8 maskreg = emit_load_p(dst, is64, REG_SCRATCH3, maskp);                    // mov   x11,maskp
+		if (inst.flags() != 0)
+			emit_ands_reg(dst, is64, dstreg, dstreg, maskreg);                          // ands  dstreg,dstreg,maskreg
+		else
+			emit_and_reg(dst, is64, dstreg, dstreg, maskreg);                           // and   dstreg,dstreg,maskreg
+	}
+
+	emit_store_p(dst, is64, dstp, dstreg);                                              // mov   dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  op_rolins - process an ROLINS opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_rolins(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_S | FLAG_Z);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MRI);
+	be_parameter shiftp(*this, inst.param(2), PTYPE_MRI);
+	be_parameter maskp(*this, inst.param(3), PTYPE_MRI);
+	bool is64 = (inst.size() == 8);
+	int bits = inst.size() * 8;
+
+	// rotate the source into x9
+	UINT8 srcreg = emit_load_p(dst, is64, REG_SCRATCH1, srcp);                          // mov   x9,srcp
+	if (shiftp.is_immediate())
+	{
+		int shift = shiftp.immediate() & (bits - 1);
+		if (shift != 0)
+			emit_ror_imm(dst, is64, REG_SCRATCH1, srcreg, bits - shift);                // ror   x9,srcreg,#bits-shiftp
+		else if (srcreg != REG_SCRATCH1)
+			emit_mov_reg(dst, is64, REG_SCRATCH1, srcreg);                              // mov   x9,srcreg
+	}
+	else
+	{
+		UINT8 shiftreg = emit_load_p(dst, false, REG_SCRATCH2, shiftp);                 // mov   w10,shiftp
+		emit_neg(dst, false, REG_SCRATCH2, shiftreg);                                   // neg   w10,shiftreg
+		emit_rorv(dst, is64, REG_SCRATCH1, srcreg, REG_SCRATCH2);                       // ror   x9,srcreg,w10
+	}
+
+	// load the destination
+	int dstreg = dstp.select_register(REG_SCRATCH4);
+	emit_mov_r_p(dst, is64, dstreg, dstp);                                              // mov   dstreg,dstp
+
+	// mask both and combine them
+	UINT64 mask = maskp.is_immediate() ? (is64 ? maskp.immediate() : (UINT32)maskp.immediate()) : 0;
+	UINT64 invmask = is64 ? ~mask : (~mask & 0xffffffff);
+	if (maskp.is_immediate() && is_logical_immediate(mask, is64))
+	{
+		emit_and_imm(dst, is64, REG_SCRATCH1, REG_SCRATCH1, mask);                      // and   x9,x9,maskp
+		emit_and_imm(dst, is64, dstreg, dstreg, invmask);                               // and   dstreg,dstreg,~maskp
+	}
+	else
+	{
+		UINT8 maskreg = emit_load_p(dst, is64, REG_SCRATCH3, maskp);                    // mov   x11,maskp
+		emit_and_reg(dst, is64, REG_SCRATCH1, REG_SCRATCH1, maskreg);                   // and   x9,x9,maskreg
+		emit_bic_reg(dst, is64, dstreg, dstreg, maskreg);                               // bic   dstreg,dstreg,maskreg
+	}
+	if (inst.flags() != 0)
+		emit_adds_reg(dst, is64, dstreg, dstreg, REG_SCRATCH1);                         // adds  dstreg,dstreg,x9
+	else
+		emit_orr_reg(dst, is64, dstreg, dstreg, REG_SCRATCH1);                          // orr   dstreg,dstreg,x9
+
+	emit_store_p(dst, is64, dstp, dstreg);                                              // mov   dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  emit_arith - shared code for ADD, ADDC, SUB,
+//  SUBB and CMP; the host carry is the inverse of
+//  the UML carry, so additions flip it around
+//-------------------------------------------------
+
+void drcbe_arm64::emit_arith(arm64code *&dst, const instruction &inst, bool subtract, bool carryin)
+{
+	// CMP has no destination
+	bool has_dest = (inst.opcode() != OP_CMP);
+	int pnum = has_dest ? 1 : 0;
+
+	// a CMP nobody looks at does nothing
+	if (!has_dest && inst.flags() == 0)
+		return;
+
+	// normalize parameters
+	be_parameter dstp = has_dest ? be_parameter(*this, inst.param(0), PTYPE_MR) : be_parameter();
+	be_parameter src1p(*this, inst.param(pnum), PTYPE_MRI);
+	be_parameter src2p(*this, inst.param(pnum + 1), PTYPE_MRI);
+	if (!subtract)
+		normalize_commutative(src1p, src2p);
+	bool is64 = (inst.size() == 8);
+	bool setflags = (inst.flags() != 0);
+
+	// pick a target register for the general case
+	int dstreg = has_dest ? dstp.select_register(REG_SCRATCH1) : REG_ZR;
+
+	// immediate forms, trading add for subtract when that makes the immediate fit
+	if (!carryin && src2p.is_immediate())
+	{
+		UINT64 imm = is64 ? src2p.immediate() : (UINT32)src2p.immediate();
+		UINT64 negimm = is64 ? -imm : (UINT32)-imm;
+		bool negate = false;
+		if (!is_arith_immediate(imm) && !setflags && is_arith_immediate(negimm))
+		{
+			imm = negimm;
+			negate = true;
+		}
+		if (is_arith_immediate(imm))
+		{
+			UINT8 src1reg = emit_load_p(dst, is64, REG_SCRATCH1, src1p);                // mov   x9,src1p
+			if (subtract != negate)
+			{
+				if (setflags)
+					emit_subs_imm(dst, is64, dstreg, src1reg, imm);                     // subs  dstreg,src1reg,src2p
+				else
+					emit_sub_imm(dst, is64, dstreg, src1reg, imm);                      // sub   dstreg,src1reg,src2p
+			}
+			else
+			{
+				if (setflags)
+					emit_adds_imm(dst, is64, dstreg, src1reg, imm);                     // adds  dstreg,src1reg,src2p
+				else
+					emit_add_imm(dst, is64, dstreg, src1reg, imm);                      // add   dstreg,src1reg,src2p
+			}
+
+			// additions produce the host sense of the carry
+			if (!subtract && (inst.flags() & FLAG_C))
+				emit_invert_carry(dst);                                                 // <flip C>
+			if (has_dest)
+				emit_store_p(dst, is64, dstp, dstreg);                                  // mov   dstp,dstreg
+			return;
+		}
+	}
+
+	// general case; zero comes from the zero register
+	UINT8 src1reg = REG_ZR;
+	if (!src1p.is_immediate_value(0))
+		src1reg = emit_load_p(dst, is64, REG_SCRATCH1, src1p);                          // mov   x9,src1p
+	UINT8 src2reg = REG_ZR;
+	if (!src2p.is_immediate_value(0))
+		src2reg = emit_load_p(dst, is64, REG_SCRATCH2, src2p);                          // mov   x10,src2p
+
+	if (subtract)
+	{
+		// SBC consumes the host carry as "no borrow", which is the UML carry inverted
+		if (carryin)
+		{
+			if (setflags)
+				emit_sbcs(dst, is64, dstreg, src1reg, src2reg);                         // sbcs  dstreg,src1reg,src2reg
+			else
+				emit_sbc(dst, is64, dstreg, src1reg, src2reg);                          // sbc   dstreg,src1reg,src2reg
+		}
+		else if (setflags)
+			emit_subs_reg(dst, is64, dstreg, src1reg, src2reg);                         // subs  dstreg,src1reg,src2reg
+		else
+			emit_sub_reg(dst, is64, dstreg, src1reg, src2reg);                          // sub   dstreg,src1reg,src2reg
+	}
+	else
+	{
+		// ADC wants the carry in the host sense, so flip it going in
+		if (carryin)
+		{
+			emit_invert_carry(dst);                                                     // <flip C>
+			if (setflags)
+				emit_adcs(dst, is64, dstreg, src1reg, src2reg);                         // adcs  dstreg,src1reg,src2reg
+			else
+				emit_adc(dst, is64, dstreg, src1reg, src2reg);                          // adc   dstreg,src1reg,src2reg
+		}
+		else if (setflags)
+			emit_adds_reg(dst, is64, dstreg, src1reg, src2reg);                         // adds  dstreg,src1reg,src2reg
+		else
+			emit_add_reg(dst, is64, dstreg, src1reg, src2reg);                          // add   dstreg,src1reg,src2reg
+
+		// and flip it back coming out
+		if (inst.flags() & FLAG_C)
+			emit_invert_carry(dst);                                                     // <flip C>
+	}
+
+	if (has_dest)
+		emit_store_p(dst, is64, dstp, dstreg);                                          // mov   dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  op_add - process a ADD opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_add(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_C | FLAG_V | FLAG_Z | FLAG_S);
+
+	emit_arith(dst, inst, false, false);
+}
+
+
+//-------------------------------------------------
+//  op_addc - process a ADDC opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_addc(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_C | FLAG_V | FLAG_Z | FLAG_S);
+
+	emit_arith(dst, inst, false, true);
+}
+
+
+//-------------------------------------------------
+//  op_sub - process a SUB opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_sub(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_C | FLAG_V | FLAG_Z | FLAG_S);
+
+	emit_arith(dst, inst, true, false);
+}
+
+
+//-------------------------------------------------
+//  op_subc - process a SUBC opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_subc(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_C | FLAG_V | FLAG_Z | FLAG_S);
+
+	emit_arith(dst, inst, true, true);
+}
+
+
+//-------------------------------------------------
+//  op_cmp - process a CMP opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_cmp(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_C | FLAG_V | FLAG_Z | FLAG_S);
+
+	emit_arith(dst, inst, true, false);
+}
+
+
+//-------------------------------------------------
+//  emit_mul - shared code for MULU and MULS
+//-------------------------------------------------
+
+void drcbe_arm64::emit_mul(arm64code *&dst, const instruction &inst, bool is_signed)
+{
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter edstp(*this, inst.param(1), PTYPE_MR);
+	be_parameter src1p(*this, inst.param(2), PTYPE_MRI);
+	be_parameter src2p(*this, inst.param(3), PTYPE_MRI);
+	normalize_commutative(src1p, src2p);
+	bool compute_hi = (dstp != edstp);
+	bool is64 = (inst.size() == 8);
+
+	UINT8 src1reg = emit_load_p(dst, is64, REG_SCRATCH1, src1p);                        // mov   x9,src1p
+	UINT8 src2reg = emit_load_p(dst, is64, REG_SCRATCH2, src2p);                        // mov   x10,src2p
+
+	// 32-bit form: the whole product fits in x11
+	if (!is64)
+	{
+		if (is_signed)
+			emit_smull(dst, REG_SCRATCH3, src1reg, src2reg);                            // smull x11,src1reg,src2reg
+		else
+			emit_umull(dst, REG_SCRATCH3, src1reg, src2reg);                            // umull x11,src1reg,src2reg
+
+		// compute flags
+		if (inst.flags() != 0)
+		{
+			// V means the product didn't fit in 32 bits
+			if (is_signed)
+				emit_cmp_ext(dst, true, REG_SCRATCH3, REG_SCRATCH3, EXTEND_SXTW);       // cmp   x11,w11,sxtw
+			else
+				emit_cmp_reg(dst, true, REG_ZR, REG_SCRATCH3, SHIFT_LSR, 32);           // cmp   xzr,x11,lsr #32
+			emit_cset(dst, false, REG_SCRATCH4, arm64emit::COND_NE);                    // cset  w12,ne
+			emit_tst_reg(dst, compute_hi, REG_SCRATCH3, REG_SCRATCH3);                  // tst   x11,x11
+			emit_mrs_nzcv(dst, REG_TEMP);                                               // mrs   x16,nzcv
+			emit_bfi(dst, true, REG_TEMP, REG_SCRATCH4, 28, 1);                         // bfi   x16,x12,#28,#1
+			emit_msr_nzcv(dst, REG_TEMP);                                               // msr   nzcv,x16
+		}
+
+		emit_store_p(dst, false, dstp, REG_SCRATCH3);                                   // mov   dstp,w11
+		if (compute_hi)
+		{
+			emit_lsr_imm(dst, true, REG_SCRATCH3, REG_SCRATCH3, 32);                    // lsr   x11,x11,#32
+			emit_store_p(dst, false, edstp, REG_SCRATCH3);                              // mov   edstp,w11
+		}
+	}
+
+	// 64-bit form: low half in x11, high half in x12
+	else
+	{
+		arm64emit::emit_mul(dst, true, REG_SCRATCH3, src1reg, src2reg);                 // mul   x11,src1reg,src2reg
+		if (compute_hi || inst.flags() != 0)
+		{
+			if (is_signed)
+				emit_smulh(dst, REG_SCRATCH4, src1reg, src2reg);                        // smulh x12,src1reg,src2reg
+			else
+				emit_umulh(dst, REG_SCRATCH4, src1reg, src2reg);                        // umulh x12,src1reg,src2reg
+		}
+
+		// compute flags
+		if (inst.flags() != 0)
+		{
+			// V means the high half is more than an extension of the low half
+			if (is_signed)
+				emit_cmp_reg(dst, true, REG_SCRATCH4, REG_SCRATCH3, SHIFT_ASR, 63);     // cmp   x12,x11,asr #63
+			else
+				emit_cmp_reg(dst, true, REG_SCRATCH4, REG_ZR);                          // cmp   x12,xzr
+			emit_cset(dst, false, REG_SCRATCH5, arm64emit::COND_NE);                    // cset  w13,ne
+
+			// Z and S come from the full 128-bit product when both halves are wanted
+			if (compute_hi)
+			{
+				emit_cmp_reg(dst, true, REG_SCRATCH3, REG_ZR);                          // cmp   x11,xzr
+				emit_cset(dst, false, REG_SCRATCH7, arm64emit::COND_NE);                // cset  w15,ne
+				emit_orr_reg(dst, true, REG_SCRATCH6, REG_SCRATCH4, REG_SCRATCH7);      // orr   x14,x12,x15
+				emit_tst_reg(dst, true, REG_SCRATCH6, REG_SCRATCH6);                    // tst   x14,x14
+			}
+			else
+				emit_tst_reg(dst, true, REG_SCRATCH3, REG_SCRATCH3);                    // tst   x11,x11
+			emit_mrs_nzcv(dst, REG_TEMP);                                               // mrs   x16,nzcv
+			emit_bfi(dst, true, REG_TEMP, REG_SCRATCH5, 28, 1);                         // bfi   x16,x13,#28,#1
+			emit_msr_nzcv(dst, REG_TEMP);                                               // msr   nzcv,x16
+		}
+
+		emit_store_p(dst, true, dstp, REG_SCRATCH3);                                    // mov   dstp,x11
+		if (compute_hi)
+			emit_store_p(dst, true, edstp, REG_SCRATCH4);                               // mov   edstp,x12
+	}
+}
+
+
+//-------------------------------------------------
+//  op_mulu - process a MULU opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_mulu(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_V | FLAG_Z | FLAG_S);
+
+	emit_mul(dst, inst, false);
+}
+
+
+//-------------------------------------------------
+//  op_muls - process a MULS opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_muls(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_V | FLAG_Z | FLAG_S);
+
+	emit_mul(dst, inst, true);
+}
+
+
+//-------------------------------------------------
+//  emit_div - shared code for DIVU and DIVS; a
+//  zero divisor leaves the destinations alone and
+//  sets V
+//-------------------------------------------------
+
+void drcbe_arm64::emit_div(arm64code *&dst, const instruction &inst, bool is_signed)
+{
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter edstp(*this, inst.param(1), PTYPE_MR);
+	be_parameter src1p(*this, inst.param(2), PTYPE_MRI);
+	be_parameter src2p(*this, inst.param(3), PTYPE_MRI);
+	bool compute_rem = (dstp != edstp);
+	bool is64 = (inst.size() == 8);
+
+	UINT8 src2reg = emit_load_p(dst, is64, REG_SCRATCH2, src2p);                        // mov   x10,src2p
+	if (inst.flags() != 0)
+	{
+		emit_movz(dst, false, REG_TEMP, (NZCV_V | NZCV_C) >> 16, 16);                   // movz  w16,#(V|C) >> 16,lsl #16
+		emit_msr_nzcv(dst, REG_TEMP);                                                   // msr   nzcv,x16
+	}
+	arm64_link skip;
+	emit_cbz_link(dst, is64, src2reg, skip);                                            // cbz   src2reg,skip
+	UINT8 src1reg = emit_load_p(dst, is64, REG_SCRATCH1, src1p);                        // mov   x9,src1p
+	if (is_signed)
+		emit_sdiv(dst, is64, REG_SCRATCH3, src1reg, src2reg);                           // sdiv  x11,src1reg,src2reg
+	else
+		emit_udiv(dst, is64, REG_SCRATCH3, src1reg, src2reg);                           // udiv  x11,src1reg,src2reg
+	if (compute_rem)
+		emit_msub(dst, is64, REG_SCRATCH4, REG_SCRATCH3, src2reg, src1reg);             // msub  x12,x11,src2reg,src1reg
+	if (inst.flags() != 0)
+		emit_tst_reg(dst, is64, REG_SCRATCH3, REG_SCRATCH3);                            // tst   x11,x11
+	emit_store_p(dst, is64, dstp, REG_SCRATCH3);                                        // mov   dstp,x11
+	if (compute_rem)
+		emit_store_p(dst, is64, edstp, REG_SCRATCH4);                                   // mov   edstp,x12
+	resolve_link(dst, skip);                                                            // skip:
+}
+
+
+//-------------------------------------------------
+//  op_divu - process a DIVU opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_divu(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_V | FLAG_Z | FLAG_S);
+
+	emit_div(dst, inst, false);
+}
+
+
+//-------------------------------------------------
+//  op_divs - process a DIVS opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_divs(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_V | FLAG_Z | FLAG_S);
+
+	emit_div(dst, inst, true);
+}
+
+
+//-------------------------------------------------
+//  emit_logical - shared code for AND, OR, XOR
+//  and TEST; only AND can set flags directly
+//-------------------------------------------------
+
+void drcbe_arm64::emit_logical(arm64code *&dst, const instruction &inst, int opc)
+{
+	// TEST has no destination
+	bool has_dest = (inst.opcode() != OP_TEST);
+	int pnum = has_dest ? 1 : 0;
+
+	// normalize parameters
+	be_parameter dstp = has_dest ? be_parameter(*this, inst.param(0), PTYPE_MR) : be_parameter();
+	be_parameter src1p(*this, inst.param(pnum), PTYPE_MRI);
+	be_parameter src2p(*this, inst.param(pnum + 1), PTYPE_MRI);
+	normalize_commutative(src1p, src2p);
+	bool is64 = (inst.size() == 8);
+
+	// ANDS sets flags for free; the others need a separate test
+	bool separate_test = false;
+	if (opc == LOGICAL_AND && inst.flags() != 0)
+		opc = LOGICAL_ANDS;
+	else if (opc != LOGICAL_ANDS && inst.flags() != 0)
+		separate_test = true;
+	UINT32 regop = 0x0a000000 | (opc << 29);
+	UINT32 immop = 0x12000000 | (opc << 29);
+
+	// pick a target register for the general case
+	int dstreg = has_dest ? dstp.select_register(REG_SCRATCH1) : REG_ZR;
+
+	UINT8 src1reg = REG_ZR;
+	if (!src1p.is_immediate_value(0))
+		src1reg = emit_load_p(dst, is64, REG_SCRATCH1, src1p);                          // mov   x9,src1p
+
+	// immediate form if it can be encoded
+	UINT64 imm = src2p.is_immediate() ? (is64 ? src2p.immediate() : (UINT32)src2p.immediate()) : 0;
+	if (src2p.is_immediate() && is_logical_immediate(imm, is64))
+		emit_logical_imm(dst, immop, is64, dstreg, src1reg, imm);                       // op    dstreg,src1reg,src2p
+
+	// register form otherwise
+	else
+	{
+		UINT8 src2reg = REG_ZR;
+		if (!src2p.is_immediate_value(0))
+			src2reg = emit_load_p(dst, is64, REG_SCRATCH2, src2p);                      // mov   x10,src2p
+		emit_logical_reg(dst, regop, is64, dstreg, src1reg, src2reg, SHIFT_LSL, 0);     // op    dstreg,src1reg,src2reg
+	}
+	if (separate_test)
+		emit_tst_reg(dst, is64, dstreg, dstreg);                                        // tst   dstreg,dstreg
+
+	if (has_dest)
+		emit_store_p(dst, is64, dstp, dstreg);                                          // mov   dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  op_and - process a AND opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_and(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_Z | FLAG_S);
+
+	emit_logical(dst, inst, LOGICAL_AND);
+}
+
+
+//-------------------------------------------------
+//  op_test - process a TEST opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_test(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_Z | FLAG_S);
+
+	emit_logical(dst, inst, LOGICAL_ANDS);
+}
+
+
+//-------------------------------------------------
+//  op_or - process a OR opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_or(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_Z | FLAG_S);
+
+	emit_logical(dst, inst, LOGICAL_ORR);
+}
+
+
+//-------------------------------------------------
+//  op_xor - process a XOR opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_xor(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_Z | FLAG_S);
+
+	emit_logical(dst, inst, LOGICAL_EOR);
+}
+
+
+//-------------------------------------------------
+//  op_lzcnt - process a LZCNT opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_lzcnt(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_Z | FLAG_S);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MRI);
+	bool is64 = (inst.size() == 8);
+
+	// pick a target register for the general case
+	int dstreg = dstp.select_register(REG_SCRATCH1);
+
+	UINT8 srcreg = emit_load_p(dst, is64, REG_SCRATCH1, srcp);                          // mov   x9,srcp
+	emit_clz(dst, is64, dstreg, srcreg);                                                // clz   dstreg,srcreg
+	if (inst.flags() != 0)
+		emit_tst_reg(dst, is64, dstreg, dstreg);                                        // tst   dstreg,dstreg
+	emit_store_p(dst, is64, dstp, dstreg);                                              // mov   dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  op_tzcnt - process a TZCNT opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_tzcnt(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_Z | FLAG_S);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MRI);
+	bool is64 = (inst.size() == 8);
+
+	// pick a target register for the general case
+	int dstreg = dstp.select_register(REG_SCRATCH1);
+
+	UINT8 srcreg = emit_load_p(dst, is64, REG_SCRATCH1, srcp);                          // mov   x9,srcp
+	emit_rbit(dst, is64, dstreg, srcreg);                                               // rbit  dstreg,srcreg
+	emit_clz(dst, is64, dstreg, dstreg);                                                // clz   dstreg,dstreg
+
+	// Z is set only for a zero source, where the count is the full width
+	if (inst.flags() != 0)
+	{
+		emit_eor_imm(dst, is64, REG_TEMP, dstreg, inst.size() * 8);                     // eor   x16,dstreg,#bits
+		emit_tst_reg(dst, is64, REG_TEMP, REG_TEMP);                                    // tst   x16,x16
+	}
+	emit_store_p(dst, is64, dstp, dstreg);                                              // mov   dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  op_bswap - process a BSWAP opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_bswap(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_Z | FLAG_S);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MRI);
+	bool is64 = (inst.size() == 8);
+
+	// pick a target register for the general case
+	int dstreg = dstp.select_register(REG_SCRATCH1);
+
+	UINT8 srcreg = emit_load_p(dst, is64, REG_SCRATCH1, srcp);                          // mov   x9,srcp
+	emit_rev(dst, is64, dstreg, srcreg);                                                // rev   dstreg,srcreg
+	if (inst.flags() != 0)
+		emit_tst_reg(dst, is64, dstreg, dstreg);                                        // tst   dstreg,dstreg
+	emit_store_p(dst, is64, dstp, dstreg);                                              // mov   dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  emit_shift - shared code for SHL, SHR, SAR, ROL
+//  and ROR; a zero count leaves the flags alone
+//-------------------------------------------------
+
+void drcbe_arm64::emit_shift(arm64code *&dst, const instruction &inst)
+{
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MRI);
+	be_parameter shiftp(*this, inst.param(2), PTYPE_MRI);
+	bool is64 = (inst.size() == 8);
+	int bits = inst.size() * 8;
+	opcode_t opcode = inst.opcode();
+	bool wantcarry = ((inst.flags() & FLAG_C) != 0);
+
+	// pick a target register for the general case
+	int dstreg = dstp.select_register(REG_SCRATCH1);
+	UINT8 srcreg = emit_load_p(dst, is64, REG_SCRATCH1, srcp);                          // mov   x9,srcp
+
+	// immediate count
+	if (shiftp.is_immediate())
+	{
+		int shift = shiftp.immediate() & (bits - 1);
+		if (shift == 0)
+		{
+			if (dstreg != srcreg)
+				emit_mov_reg(dst, is64, dstreg, srcreg);                                // mov   dstreg,srcreg
+			emit_store_p(dst, is64, dstp, dstreg);                                      // mov   dstp,dstreg
+			return;
+		}
+
+		// shifts take the carry from the last bit shifted out of the source
+		if (wantcarry && opcode == OP_SHL)
+			emit_lsr_imm(dst, is64, REG_SCRATCH4, srcreg, bits - shift);                // lsr   x12,srcreg,#bits-shift
+		else if (wantcarry && (opcode == OP_SHR || opcode == OP_SAR))
+			emit_lsr_imm(dst, is64, REG_SCRATCH4, srcreg, shift - 1);                   // lsr   x12,srcreg,#shift-1
+
+		switch (opcode)
+		{
+			case OP_SHL: emit_lsl_imm(dst, is64, dstreg, srcreg, shift); break;         // lsl   dstreg,srcreg,#shift
+			case OP_SHR: emit_lsr_imm(dst, is64, dstreg, srcreg, shift); break;         // lsr   dstreg,srcreg,#shift
+			case OP_SAR: emit_asr_imm(dst, is64, dstreg, srcreg, shift); break;         // asr   dstreg,srcreg,#shift
+			case OP_ROL: emit_ror_imm(dst, is64, dstreg, srcreg, bits - shift); break;  // ror   dstreg,srcreg,#bits-shift
+			case OP_ROR: emit_ror_imm(dst, is64, dstreg, srcreg, shift); break;         // ror   dstreg,srcreg,#shift
+			default:        break;
+		}
+	}
+
+	// variable count
+	else
+	{
+		UINT8 shiftreg = emit_load_p(dst, false, REG_SCRATCH2, shiftp);                 // mov   w10,shiftp
+
+		// without flags the hardware's own masking of the count is enough
+		if (inst.flags() == 0)
+		{
+			switch (opcode)
+			{
+				case OP_SHL: emit_lslv(dst, is64, dstreg, srcreg, shiftreg); break;     // lsl   dstreg,srcreg,shiftreg
+				case OP_SHR: emit_lsrv(dst, is64, dstreg, srcreg, shiftreg); break;     // lsr   dstreg,srcreg,shiftreg
+				case OP_SAR: emit_asrv(dst, is64, dstreg, srcreg, shiftreg); break;     // asr   dstreg,srcreg,shiftreg
+				case OP_ROR: emit_rorv(dst, is64, dstreg, srcreg, shiftreg); break;     // ror   dstreg,srcreg,shiftreg
+				case OP_ROL:
+					emit_neg(dst, false, REG_SCRATCH2, shiftreg);                       // neg   w10,shiftreg
+					emit_rorv(dst, is64, dstreg, srcreg, REG_SCRATCH2);                 // ror   dstreg,srcreg,w10
+					break;
+				default:
+					break;
+			}
+			emit_store_p(dst, is64, dstp, dstreg);                                      // mov   dstp,dstreg
+			return;
+		}
+
+		// with flags we need the masked count to test for zero
+		emit_and_imm(dst, false, REG_SCRATCH2, shiftreg, bits - 1);                     // and   w10,shiftreg,#bits-1
+		if (wantcarry && opcode == OP_SHL)
+		{
+			emit_neg(dst, false, REG_SCRATCH3, REG_SCRATCH2);                           // neg   w11,w10
+			emit_lsrv(dst, is64, REG_SCRATCH4, srcreg, REG_SCRATCH3);                   // lsr   x12,srcreg,w11
+		}
+		else if (wantcarry && (opcode == OP_SHR || opcode == OP_SAR))
+		{
+			emit_sub_imm(dst, false, REG_SCRATCH3, REG_SCRATCH2, 1);                    // sub   w11,w10,#1
+			emit_lsrv(dst, is64, REG_SCRATCH4, srcreg, REG_SCRATCH3);                   // lsr   x12,srcreg,w11
+		}
+
+		switch (opcode)
+		{
+			case OP_SHL: emit_lslv(dst, is64, dstreg, srcreg, REG_SCRATCH2); break;     // lsl   dstreg,srcreg,w10
+			case OP_SHR: emit_lsrv(dst, is64, dstreg, srcreg, REG_SCRATCH2); break;     // lsr   dstreg,srcreg,w10
+			case OP_SAR: emit_asrv(dst, is64, dstreg, srcreg, REG_SCRATCH2); break;     // asr   dstreg,srcreg,w10
+			case OP_ROR: emit_rorv(dst, is64, dstreg, srcreg, REG_SCRATCH2); break;     // ror   dstreg,srcreg,w10
+			case OP_ROL:
+				emit_neg(dst, false, REG_SCRATCH3, REG_SCRATCH2);                       // neg   w11,w10
+				emit_rorv(dst, is64, dstreg, srcreg, REG_SCRATCH3);                     // ror   dstreg,srcreg,w11
+				break;
+			default:
+				break;
+		}
+	}
+
+	// compute flags, skipping them entirely for a zero count
+	if (inst.flags() != 0)
+	{
+		arm64_link skip;
+		skip.target = nullptr;
+		if (!shiftp.is_immediate())
+			emit_cbz_link(dst, false, REG_SCRATCH2, skip);                              // cbz   w10,skip
+
+		// rotates take the carry from the result
+		if (wantcarry && opcode == OP_ROR)
+			emit_lsr_imm(dst, is64, REG_SCRATCH4, dstreg, bits - 1);                    // lsr   x12,dstreg,#bits-1
+		emit_tst_reg(dst, is64, dstreg, dstreg);                                        // tst   dstreg,dstreg
+		if (wantcarry)
+			emit_insert_carry(dst, (opcode == OP_ROL) ? dstreg : REG_SCRATCH4);         // <C = w12 & 1>
+
+		if (skip.target != nullptr)
+			resolve_link(dst, skip);                                                    // skip:
+	}
+
+	emit_store_p(dst, is64, dstp, dstreg);                                              // mov   dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  op_shl - process a SHL opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_shl(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_C | FLAG_Z | FLAG_S);
+
+	emit_shift(dst, inst);
+}
+
+
+//-------------------------------------------------
+//  op_shr - process a SHR opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_shr(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_C | FLAG_Z | FLAG_S);
+
+	emit_shift(dst, inst);
+}
+
+
+//-------------------------------------------------
+//  op_sar - process a SAR opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_sar(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_C | FLAG_Z | FLAG_S);
+
+	emit_shift(dst, inst);
+}
+
+
+//-------------------------------------------------
+//  op_rol - process a ROL opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_rol(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_C | FLAG_Z | FLAG_S);
+
+	emit_shift(dst, inst);
+}
+
+
+//-------------------------------------------------
+//  op_ror - process a ROR opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_ror(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_C | FLAG_Z | FLAG_S);
+
+	emit_shift(dst, inst);
+}
+
+
+//-------------------------------------------------
+//  emit_rotate_carry - shared code for ROLC and
+//  RORC, rotating through a bits+1 wide value
+//  built from the source and the UML carry
+//-------------------------------------------------
+
+void drcbe_arm64::emit_rotate_carry(arm64code *&dst, const instruction &inst, bool left)
+{
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MRI);
+	be_parameter shiftp(*this, inst.param(2), PTYPE_MRI);
+	bool is64 = (inst.size() == 8);
+	int bits = inst.size() * 8;
+
+	// the result builds up in x11
+	UINT8 srcreg = emit_load_p(dst, is64, REG_SCRATCH1, srcp);                          // mov   x9,srcp
+
+	// immediate count
+	if (shiftp.is_immediate())
+	{
+		int shift = shiftp.immediate() & (bits - 1);
+		if (shift == 0)
+		{
+			emit_store_p(dst, is64, dstp, srcreg);                                      // mov   dstp,srcreg
+			return;
+		}
+
+		emit_cset(dst, false, REG_SCRATCH5, arm64emit::COND_CC);                        // cset  w13,cc
+		if (left)
+		{
+			emit_lsr_imm(dst, is64, REG_SCRATCH4, srcreg, bits - shift);                // lsr   x12,srcreg,#bits-shift
+			emit_lsl_imm(dst, is64, REG_SCRATCH3, srcreg, shift);                       // lsl   x11,srcreg,#shift
+			emit_orr_reg(dst, is64, REG_SCRATCH3, REG_SCRATCH3, REG_SCRATCH5, SHIFT_LSL, shift - 1);
+																						// orr   x11,x11,x13,lsl #shift-1
+			if (shift > 1)
+				emit_orr_reg(dst, is64, REG_SCRATCH3, REG_SCRATCH3, srcreg, SHIFT_LSR, bits + 1 - shift);
+																						// orr   x11,x11,srcreg,lsr #bits+1-shift
+		}
+		else
+		{
+			emit_lsr_imm(dst, is64, REG_SCRATCH4, srcreg, shift - 1);                   // lsr   x12,srcreg,#shift-1
+			emit_lsr_imm(dst, is64, REG_SCRATCH3, srcreg, shift);                       // lsr   x11,srcreg,#shift
+			emit_orr_reg(dst, is64, REG_SCRATCH3, REG_SCRATCH3, REG_SCRATCH5, SHIFT_LSL, bits - shift);
+																						// orr   x11,x11,x13,lsl #bits-shift
+			if (shift > 1)
+				emit_orr_reg(dst, is64, REG_SCRATCH3, REG_SCRATCH3, srcreg, SHIFT_LSL, bits + 1 - shift);
+																						// orr   x11,x11,srcreg,lsl #bits+1-shift
+		}
+		if (inst.flags() != 0)
+		{
+			emit_tst_reg(dst, is64, REG_SCRATCH3, REG_SCRATCH3);                        // tst   x11,x11
+			if (inst.flags() & FLAG_C)
+				emit_insert_carry(dst, REG_SCRATCH4);                                   // <C = w12 & 1>
+		}
+	}
+
+	// variable count
+	else
+	{
+		UINT8 shiftreg = emit_load_p(dst, false, REG_SCRATCH2, shiftp);                 // mov   w10,shiftp
+		emit_and_imm(dst, false, REG_SCRATCH2, shiftreg, bits - 1);                     // and   w10,shiftreg,#bits-1
+		emit_mov_reg(dst, is64, REG_SCRATCH3, srcreg);                                  // mov   x11,srcreg
+		emit_cset(dst, false, REG_SCRATCH5, arm64emit::COND_CC);                        // cset  w13,cc
+		arm64_link skip;
+		emit_cbz_link(dst, false, REG_SCRATCH2, skip);                                  // cbz   w10,skip
+
+		// w14 = bits - count, which is all the hardware sees of -count
+		emit_neg(dst, false, REG_SCRATCH6, REG_SCRATCH2);                               // neg   w14,w10
+		if (left)
+		{
+			emit_lsrv(dst, is64, REG_SCRATCH4, srcreg, REG_SCRATCH6);                   // lsr   x12,srcreg,w14
+			emit_lslv(dst, is64, REG_SCRATCH3, srcreg, REG_SCRATCH2);                   // lsl   x11,srcreg,w10
+			emit_lsr_imm(dst, is64, REG_SCRATCH7, srcreg, 1);                           // lsr   x15,srcreg,#1
+			emit_lsrv(dst, is64, REG_SCRATCH7, REG_SCRATCH7, REG_SCRATCH6);             // lsr   x15,x15,w14
+			emit_orr_reg(dst, is64, REG_SCRATCH3, REG_SCRATCH3, REG_SCRATCH7);          // orr   x11,x11,x15
+			emit_sub_imm(dst, false, REG_SCRATCH6, REG_SCRATCH2, 1);                    // sub   w14,w10,#1
+			emit_lslv(dst, is64, REG_SCRATCH7, REG_SCRATCH5, REG_SCRATCH6);             // lsl   x15,x13,w14
+			emit_orr_reg(dst, is64, REG_SCRATCH3, REG_SCRATCH3, REG_SCRATCH7);          // orr   x11,x11,x15
+		}
+		else
+		{
+			emit_lsrv(dst, is64, REG_SCRATCH3, srcreg, REG_SCRATCH2);                   // lsr   x11,srcreg,w10
+			emit_lslv(dst, is64, REG_SCRATCH7, REG_SCRATCH5, REG_SCRATCH6);             // lsl   x15,x13,w14
+			emit_orr_reg(dst, is64, REG_SCRATCH3, REG_SCRATCH3, REG_SCRATCH7);          // orr   x11,x11,x15
+			emit_lsl_imm(dst, is64, REG_SCRATCH7, srcreg, 1);                           // lsl   x15,srcreg,#1
+			emit_lslv(dst, is64, REG_SCRATCH7, REG_SCRATCH7, REG_SCRATCH6);             // lsl   x15,x15,w14
+			emit_orr_reg(dst, is64, REG_SCRATCH3, REG_SCRATCH3, REG_SCRATCH7);          // orr   x11,x11,x15
+			emit_sub_imm(dst, false, REG_SCRATCH6, REG_SCRATCH2, 1);                    // sub   w14,w10,#1
+			emit_lsrv(dst, is64, REG_SCRATCH4, srcreg, REG_SCRATCH6);                   // lsr   x12,srcreg,w14
+		}
+		if (inst.flags() != 0)
+		{
+			emit_tst_reg(dst, is64, REG_SCRATCH3, REG_SCRATCH3);                        // tst   x11,x11
+			if (inst.flags() & FLAG_C)
+				emit_insert_carry(dst, REG_SCRATCH4);                                   // <C = w12 & 1>
+		}
+		resolve_link(dst, skip);                                                        // skip:
+	}
+
+	emit_store_p(dst, is64, dstp, REG_SCRATCH3);                                        // mov   dstp,x11
+}
+
+
+//-------------------------------------------------
+//  op_rolc - process a ROLC opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_rolc(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_C | FLAG_Z | FLAG_S);
+
+	emit_rotate_carry(dst, inst, true);
+}
+
+
+//-------------------------------------------------
+//  op_rorc - process a RORC opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_rorc(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_C | FLAG_Z | FLAG_S);
+
+	emit_rotate_carry(dst, inst, false);
+}
+
+
+
+
+/***************************************************************************
+    FLOATING POINT OPERATIONS
+***************************************************************************/
+
+//-------------------------------------------------
+//  op_fload - process a FLOAD opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_fload(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MF);
+	be_parameter basep(*this, inst.param(1), PTYPE_M);
+	be_parameter indp(*this, inst.param(2), PTYPE_MRI);
+	bool isdouble = (inst.size() == 8);
+
+	// pick a target register for the general case
+	int dstreg = dstp.select_register(REG_FSCRATCH1);
+
+	emit_ldst_indexed(dst, isdouble ? LDST_LDRD : LDST_LDRS, dstreg, basep.memory(), indp, isdouble ? 3 : 2, EXTEND_UXTW);
+																						// ldr   dstreg,[basep + size*indp]
+	emit_fstore_p(dst, isdouble, dstp, dstreg);                                         // str   dstreg,dstp
+}
+
+
+//-------------------------------------------------
+//  op_fstore - process a FSTORE opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_fstore(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter basep(*this, inst.param(0), PTYPE_M);
+	be_parameter indp(*this, inst.param(1), PTYPE_MRI);
+	be_parameter srcp(*this, inst.param(2), PTYPE_MF);
+	bool isdouble = (inst.size() == 8);
+
+	UINT8 srcreg = emit_fload_p(dst, isdouble, REG_FSCRATCH1, srcp);                    // ldr   d16,srcp
+	emit_ldst_indexed(dst, isdouble ? LDST_STRD : LDST_STRS, srcreg, basep.memory(), indp, isdouble ? 3 : 2, EXTEND_UXTW);
+																						// str   srcreg,[basep + size*indp]
+}
+
+
+//-------------------------------------------------
+//  op_fread - process a FREAD opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_fread(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MF);
+	be_parameter addrp(*this, inst.param(1), PTYPE_MRI);
+	const parameter &spacep = inst.param(2);
+	assert(spacep.is_size_space());
+	assert((1 << spacep.size()) == inst.size());
+	bool isdouble = (inst.size() == 8);
+
+	// set up a call to the read dword/qword handler
+	emit_mov_r64_imm(dst, REG_PARAM1, (FPTR)(m_space[spacep.space()]));                 // mov   param1,space
+	emit_mov_r_p(dst, false, REG_PARAM2, addrp);                                        // mov   param2,addrp
+	if (isdouble)
+		emit_call_m64(dst, &m_accessors[spacep.space()].read_qword);                    // call  read_qword
+	else
+		emit_call_m64(dst, &m_accessors[spacep.space()].read_dword);                    // call  read_dword
+
+	// store result
+	if (dstp.is_memory())
+		emit_store_p(dst, isdouble, dstp, REG_X0);                                      // str   x0,[dstp]
+	else
+		emit_fmov_from_gp(dst, isdouble, dstp.freg(), REG_X0);                          // fmov  dstp,x0
+}
+
+
+//-------------------------------------------------
+//  op_fwrite - process a FWRITE opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_fwrite(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter addrp(*this, inst.param(0), PTYPE_MRI);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MF);
+	const parameter &spacep = inst.param(2);
+	assert(spacep.is_size_space());
+	assert((1 << spacep.size()) == inst.size());
+	bool isdouble = (inst.size() == 8);
+
+	// set up a call to the write dword/qword handler
+	emit_mov_r64_imm(dst, REG_PARAM1, (FPTR)(m_space[spacep.space()]));                 // mov   param1,space
+	emit_mov_r_p(dst, false, REG_PARAM2, addrp);                                        // mov   param2,addrp
+	if (srcp.is_memory())
+		emit_ldst_abs(dst, isdouble ? LDST_LDRX : LDST_LDRW, REG_PARAM3, srcp.memory());// ldr   param3,[srcp]
+	else
+		emit_fmov_to_gp(dst, isdouble, REG_PARAM3, srcp.freg());                        // fmov  param3,srcp
+	if (isdouble)
+		emit_call_m64(dst, &m_accessors[spacep.space()].write_qword);                   // call  write_qword
+	else
+		emit_call_m64(dst, &m_accessors[spacep.space()].write_dword);                   // call  write_dword
+}
+
+
+//-------------------------------------------------
+//  op_fmov - process a FMOV opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_fmov(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_any_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MF);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MF);
+	bool isdouble = (inst.size() == 8);
+
+	// skip if conditional
+	arm64_link skip;
+	emit_skip_unless(dst, inst, skip);                                                  // b.!cond skip
+
+	UINT8 srcreg = emit_fload_p(dst, isdouble, REG_FSCRATCH1, srcp);                    // ldr   d16,srcp
+	emit_fstore_p(dst, isdouble, dstp, srcreg);                                         // str   srcreg,dstp
+
+	// resolve the jump
+	if (inst.condition() != uml::COND_ALWAYS)
+		resolve_link(dst, skip);                                                        // skip:
+}
+
+
+//-------------------------------------------------
+//  op_ftoint - process a FTOINT opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_ftoint(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MF);
+	const parameter &sizep = inst.param(2);
+	assert(sizep.is_size());
+	const parameter &roundp = inst.param(3);
+	assert(roundp.is_rounding());
+	bool isdouble = (inst.size() == 8);
+	bool is64 = (sizep.size() == SIZE_QWORD);
+
+	// pick a target register for the general case
+	int dstreg = dstp.select_register(REG_SCRATCH1);
+	UINT8 srcreg = emit_fload_p(dst, isdouble, REG_FSCRATCH1, srcp);                    // ldr   d16,srcp
+
+	// every fixed rounding mode has its own conversion, so FPCR only matters for the default
+	switch (roundp.rounding())
+	{
+		case ROUND_TRUNC:
+			emit_fcvtzs(dst, is64, isdouble, dstreg, srcreg);                           // fcvtzs dstreg,srcreg
+			break;
+
+		case ROUND_ROUND:
+			emit_fcvtns(dst, is64, isdouble, dstreg, srcreg);                           // fcvtns dstreg,srcreg
+			break;
+
+		case ROUND_CEIL:
+			emit_fcvtps(dst, is64, isdouble, dstreg, srcreg);                           // fcvtps dstreg,srcreg
+			break;
+
+		case ROUND_FLOOR:
+			emit_fcvtms(dst, is64, isdouble, dstreg, srcreg);                           // fcvtms dstreg,srcreg
+			break;
+
+		case ROUND_DEFAULT:
+		default:
+			emit_frinti(dst, isdouble, REG_FSCRATCH2, srcreg);                          // frinti d17,srcreg
+			emit_fcvtzs(dst, is64, isdouble, dstreg, REG_FSCRATCH2);                    // fcvtzs dstreg,d17
+			break;
+	}
+
+	emit_store_p(dst, is64, dstp, dstreg);                                              // mov   dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  op_ffrint - process a FFRINT opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_ffrint(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MF);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MRI);
+	const parameter &sizep = inst.param(2);
+	assert(sizep.is_size());
+	bool isdouble = (inst.size() == 8);
+	bool is64 = (sizep.size() == SIZE_QWORD);
+
+	// pick a target register for the general case
+	int dstreg = dstp.select_register(REG_FSCRATCH1);
+
+	UINT8 srcreg = emit_load_p(dst, is64, REG_SCRATCH1, srcp);                          // mov   x9,srcp
+	emit_scvtf(dst, is64, isdouble, dstreg, srcreg);                                    // scvtf dstreg,srcreg
+	emit_fstore_p(dst, isdouble, dstp, dstreg);                                         // str   dstreg,dstp
+}
+
+
+//-------------------------------------------------
+//  op_ffrflt - process a FFRFLT opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_ffrflt(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MF);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MF);
+	const parameter &sizep = inst.param(2);
+	assert(sizep.is_size());
+
+	// pick a target register for the general case
+	int dstreg = dstp.select_register(REG_FSCRATCH1);
+
+	// single-to-double
+	if (inst.size() == 8 && sizep.size() == SIZE_DWORD)
+	{
+		UINT8 srcreg = emit_fload_p(dst, false, REG_FSCRATCH2, srcp);                   // ldr   s17,srcp
+		emit_fcvt_sd(dst, dstreg, srcreg);                                              // fcvt  dstreg,srcreg
+		emit_fstore_p(dst, true, dstp, dstreg);                                         // str   dstreg,dstp
+	}
+
+	// double-to-single
+	else if (inst.size() == 4 && sizep.size() == SIZE_QWORD)
+	{
+		UINT8 srcreg = emit_fload_p(dst, true, REG_FSCRATCH2, srcp);                    // ldr   d17,srcp
+		emit_fcvt_ds(dst, dstreg, srcreg);                                              // fcvt  dstreg,srcreg
+		emit_fstore_p(dst, false, dstp, dstreg);                                        // str   dstreg,dstp
+	}
+}
+
+
+//-------------------------------------------------
+//  op_frnds - process a FRNDS opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_frnds(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MF);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MF);
+
+	// pick a target register for the general case
+	int dstreg = dstp.select_register(REG_FSCRATCH1);
+
+	UINT8 srcreg = emit_fload_p(dst, true, REG_FSCRATCH2, srcp);                        // ldr   d17,srcp
+	emit_fcvt_ds(dst, REG_FSCRATCH2, srcreg);                                           // fcvt  s17,srcreg
+	emit_fcvt_sd(dst, dstreg, REG_FSCRATCH2);                                           // fcvt  dstreg,s17
+	emit_fstore_p(dst, true, dstp, dstreg);                                             // str   dstreg,dstp
+}
+
+
+//-------------------------------------------------
+//  emit_float_binary - shared code for FADD,
+//  FSUB, FMUL and FDIV
+//-------------------------------------------------
+
+void drcbe_arm64::emit_float_binary(arm64code *&dst, const instruction &inst, UINT32 opcode)
+{
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MF);
+	be_parameter src1p(*this, inst.param(1), PTYPE_MF);
+	be_parameter src2p(*this, inst.param(2), PTYPE_MF);
+	bool isdouble = (inst.size() == 8);
+
+	// pick a target register for the general case
+	int dstreg = dstp.select_register(REG_FSCRATCH1);
+
+	UINT8 src1reg = emit_fload_p(dst, isdouble, REG_FSCRATCH2, src1p);                  // ldr   d17,src1p
+	UINT8 src2reg = emit_fload_p(dst, isdouble, REG_FSCRATCH3, src2p);                  // ldr   d18,src2p
+	emit_fp2(dst, opcode, isdouble, dstreg, src1reg, src2reg);                          // fop   dstreg,src1reg,src2reg
+	emit_fstore_p(dst, isdouble, dstp, dstreg);                                         // str   dstreg,dstp
+}
+
+
+//-------------------------------------------------
+//  emit_float_unary - shared code for FNEG, FABS
+//  and FSQRT
+//-------------------------------------------------
+
+void drcbe_arm64::emit_float_unary(arm64code *&dst, const instruction &inst, UINT32 opcode)
+{
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MF);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MF);
+	bool isdouble = (inst.size() == 8);
+
+	// pick a target register for the general case
+	int dstreg = dstp.select_register(REG_FSCRATCH1);
+
+	UINT8 srcreg = emit_fload_p(dst, isdouble, REG_FSCRATCH2, srcp);                    // ldr   d17,srcp
+	emit_fp1(dst, opcode, isdouble, dstreg, srcreg);                                    // fop   dstreg,srcreg
+	emit_fstore_p(dst, isdouble, dstp, dstreg);                                         // str   dstreg,dstp
+}
+
+
+//-------------------------------------------------
+//  op_fadd - process a FADD opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_fadd(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	emit_float_binary(dst, inst, 0x2);
+}
+
+
+//-------------------------------------------------
+//  op_fsub - process a FSUB opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_fsub(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	emit_float_binary(dst, inst, 0x3);
+}
+
+
+//-------------------------------------------------
+//  op_fcmp - process a FCMP opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_fcmp(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_C | FLAG_Z | FLAG_U);
+
+	// normalize parameters
+	be_parameter src1p(*this, inst.param(0), PTYPE_MF);
+	be_parameter src2p(*this, inst.param(1), PTYPE_MF);
+	bool isdouble = (inst.size() == 8);
+
+	UINT8 src1reg = emit_fload_p(dst, isdouble, REG_FSCRATCH1, src1p);                  // ldr   d16,src1p
+	UINT8 src2reg = emit_fload_p(dst, isdouble, REG_FSCRATCH2, src2p);                  // ldr   d17,src2p
+	emit_fcmp(dst, isdouble, src1reg, src2reg);                                         // fcmp  src1reg,src2reg
+
+	// unordered results also report Z and C, as they do on x86
+	arm64_link skip;
+	emit_b_cond_link(dst, arm64emit::COND_VC, skip);                                    // b.vc  skip
+	emit_movz(dst, false, REG_TEMP, (NZCV_Z | NZCV_V) >> 16, 16);                       // movz  w16,#(Z|V) >> 16,lsl #16
+	emit_msr_nzcv(dst, REG_TEMP);                                                       // msr   nzcv,x16
+	resolve_link(dst, skip);                                                            // skip:
+}
+
+
+//-------------------------------------------------
+//  op_fmul - process a FMUL opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_fmul(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	emit_float_binary(dst, inst, 0x0);
+}
+
+
+//-------------------------------------------------
+//  op_fdiv - process a FDIV opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_fdiv(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	emit_float_binary(dst, inst, 0x1);
+}
+
+
+//-------------------------------------------------
+//  op_fneg - process a FNEG opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_fneg(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	emit_float_unary(dst, inst, 0x2);
+}
+
+
+//-------------------------------------------------
+//  op_fabs - process a FABS opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_fabs(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	emit_float_unary(dst, inst, 0x1);
+}
+
+
+//-------------------------------------------------
+//  op_fsqrt - process a FSQRT opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_fsqrt(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	emit_float_unary(dst, inst, 0x3);
+}
+
+
+//-------------------------------------------------
+//  op_frecip - process a FRECIP opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_frecip(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MF);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MF);
+	bool isdouble = (inst.size() == 8);
+
+	// pick a target register for the general case
+	int dstreg = dstp.select_register(REG_FSCRATCH1);
+
+	UINT8 srcreg = emit_fload_p(dst, isdouble, REG_FSCRATCH3, srcp);                    // ldr   d18,srcp
+	emit_fmov_one(dst, isdouble, REG_FSCRATCH2);                                        // fmov  d17,#1.0
+	emit_fdiv(dst, isdouble, dstreg, REG_FSCRATCH2, srcreg);                            // fdiv  dstreg,d17,srcreg
+	emit_fstore_p(dst, isdouble, dstp, dstreg);                                         // str   dstreg,dstp
+}
+
+
+//-------------------------------------------------
+//  op_frsqrt - process a FRSQRT opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_frsqrt(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MF);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MF);
+	bool isdouble = (inst.size() == 8);
+
+	// pick a target register for the general case
+	int dstreg = dstp.select_register(REG_FSCRATCH1);
+
+	UINT8 srcreg = emit_fload_p(dst, isdouble, REG_FSCRATCH3, srcp);                    // ldr   d18,srcp
+	emit_fsqrt(dst, isdouble, REG_FSCRATCH3, srcreg);                                   // fsqrt d18,srcreg
+	emit_fmov_one(dst, isdouble, REG_FSCRATCH2);                                        // fmov  d17,#1.0
+	emit_fdiv(dst, isdouble, dstreg, REG_FSCRATCH2, REG_FSCRATCH3);                     // fdiv  dstreg,d17,d18
+	emit_fstore_p(dst, isdouble, dstp, dstreg);                                         // str   dstreg,dstp
+}
+
+
+//-------------------------------------------------
+//  op_fcopyi - process a FCOPYI opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_fcopyi(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MF);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MR);
+	bool is64 = (inst.size() == 8);
+
+	UINT8 srcreg = emit_load_p(dst, is64, REG_SCRATCH1, srcp);                          // mov   x9,srcp
+	if (dstp.is_memory())
+		emit_store_p(dst, is64, dstp, srcreg);                                          // str   srcreg,[dstp]
+	else
+		emit_fmov_from_gp(dst, is64, dstp.freg(), srcreg);                              // fmov  dstp,srcreg
+}
+
+
+//-------------------------------------------------
+//  op_icopyf - process a ICOPYF opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_icopyf(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MF);
+	bool is64 = (inst.size() == 8);
+
+	// pick a target register for the general case
+	int dstreg = dstp.select_register(REG_SCRATCH1);
+
+	if (srcp.is_memory())
+		emit_ldst_abs(dst, is64 ? LDST_LDRX : LDST_LDRW, dstreg, srcp.memory());        // ldr   dstreg,[srcp]
+	else
+		emit_fmov_to_gp(dst, is64, dstreg, srcp.freg());                                // fmov  dstreg,srcp
+	emit_store_p(dst, is64, dstp, dstreg);                                              // mov   dstp,dstreg
+}
+
+} // namespace drc
@@ -0,0 +1,280 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    drcbearm64.h
+
+    64-bit ARM (AArch64) back-end for the universal machine language.
+
+***************************************************************************/
+
+#pragma once
+
+#ifndef MAME_DEVICES_CPU_DRCBEARM64_H
+#define MAME_DEVICES_CPU_DRCBEARM64_H
+
+#include "drcuml.h"
+#include "drcbeut.h"
+#include "arm64emit.h"
+
+
+namespace drc {
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+class drcbe_arm64 : public drcbe_interface
+{
+	typedef arm64emit::arm64code arm64code;
+	typedef UINT32 (*arm64_entry_point_func)(UINT8 *basevalue, arm64code *entry);
+
+public:
+	// construction/destruction
+	drcbe_arm64(drcuml_state &drcuml, device_t &device, drc_cache &cache, UINT32 flags, int modes, int addrbits, int ignorebits);
+	virtual ~drcbe_arm64();
+
+	// required overrides
+	virtual void reset() override;
+	virtual int execute(uml::code_handle &entry) override;
+	virtual void generate(drcuml_block &block, const uml::instruction *instlist, UINT32 numinst) override;
+	virtual bool hash_exists(UINT32 mode, UINT32 pc) override;
+	virtual int invalidate_code(offs_t start, offs_t end) override;
+	virtual void get_info(drcbe_info &info) override;
+
+private:
+	// a be_parameter is similar to a uml::parameter but maps to native registers/memory
+	class be_parameter
+	{
+	public:
+		// parameter types
+		enum be_parameter_type
+		{
+			PTYPE_NONE = 0,                     // invalid
+			PTYPE_IMMEDIATE,                    // immediate; value = sign-extended to 64 bits
+			PTYPE_INT_REGISTER,                 // integer register; value = 0-REG_MAX
+			PTYPE_FLOAT_REGISTER,               // floating point register; value = 0-REG_MAX
+			PTYPE_MEMORY,                       // memory; value = pointer to memory
+			PTYPE_MAX
+		};
+
+		// represents the value of a parameter
+		typedef UINT64 be_parameter_value;
+
+		// construction
+		be_parameter() : m_type(PTYPE_NONE), m_value(0) { }
+		be_parameter(const be_parameter &param) : m_type(param.m_type), m_value(param.m_value) { }
+		be_parameter(UINT64 val) : m_type(PTYPE_IMMEDIATE), m_value(val) { }
+		be_parameter(drcbe_arm64 &drcbe, const uml::parameter &param, UINT32 allowed);
+
+		// creators for types that don't safely default
+		static inline be_parameter make_ireg(int regnum) { assert(regnum >= 0 && regnum < arm64emit::REG_MAX); return be_parameter(PTYPE_INT_REGISTER, regnum); }
+		static inline be_parameter make_freg(int regnum) { assert(regnum >= 0 && regnum < arm64emit::REG_MAX); return be_parameter(PTYPE_FLOAT_REGISTER, regnum); }
+		static inline be_parameter make_memory(void *base) { return be_parameter(PTYPE_MEMORY, reinterpret_cast<be_parameter_value>(base)); }
+		static inline be_parameter make_memory(const void *base) { return be_parameter(PTYPE_MEMORY, reinterpret_cast<be_parameter_value>(const_cast<void *>(base))); }
+
+		// operators
+		bool operator==(const be_parameter &rhs) const { return (m_type == rhs.m_type && m_value == rhs.m_value); }
+		bool operator!=(const be_parameter &rhs) const { return (m_type != rhs.m_type || m_value != rhs.m_value); }
+
+		// getters
+		be_parameter_type type() const { return m_type; }
+		UINT64 immediate() const { assert(m_type == PTYPE_IMMEDIATE); return m_value; }
+		int ireg() const { assert(m_type == PTYPE_INT_REGISTER); assert(m_value < arm64emit::REG_MAX); return m_value; }
+		int freg() const { assert(m_type == PTYPE_FLOAT_REGISTER); assert(m_value < arm64emit::REG_MAX); return m_value; }
+		void *memory() const { assert(m_type == PTYPE_MEMORY); return reinterpret_cast<void *>(m_value); }
+
+		// type queries
+		bool is_immediate() const { return (m_type == PTYPE_IMMEDIATE); }
+		bool is_int_register() const { return (m_type == PTYPE_INT_REGISTER); }
+		bool is_float_register() const { return (m_type == PTYPE_FLOAT_REGISTER); }
+		bool is_memory() const { return (m_type == PTYPE_MEMORY); }
+
+		// other queries
+		bool is_immediate_value(UINT64 value) const { return (m_type == PTYPE_IMMEDIATE && m_value == value); }
+
+		// helpers
+		int select_register(int defreg) const;
+		int select_register(int defreg, const be_parameter &checkparam) const;
+		int select_register(int defreg, const be_parameter &checkparam, const be_parameter &checkparam2) const;
+
+	private:
+		// private constructor
+		be_parameter(be_parameter_type type, be_parameter_value value) : m_type(type), m_value(value) { }
+
+		// internals
+		be_parameter_type   m_type;             // parameter type
+		be_parameter_value  m_value;            // parameter value
+	};
+
+	// helpers
+	void normalize_commutative(be_parameter &inner, be_parameter &outer);
+	void emit_mov_r64_imm(arm64code *&dst, UINT8 reg, UINT64 imm);
+	void emit_load_address(arm64code *&dst, UINT8 reg, const void *ptr);
+	void emit_ldst_abs(arm64code *&dst, UINT32 op, UINT8 reg, const void *ptr);
+	void emit_ldst_indexed(arm64code *&dst, UINT32 op, UINT8 reg, const void *base, const be_parameter &indp, int scale, UINT8 extend);
+	void emit_smart_branch(arm64code *&dst, const void *target);
+	void emit_smart_call(arm64code *&dst, const void *target);
+	void emit_call_m64(arm64code *&dst, const void *targetptr);
+	void emit_hash_index(arm64code *&dst, UINT8 reg, UINT8 pcreg, int shift, int bits);
+	void write_link_site(arm64code *site, UINT32 mode, UINT32 pc);
+	void update_link_sites(UINT32 mode, UINT32 pc);
+
+	void fixup_label(void *parameter, drccodeptr labelcodeptr);
+
+	static void flush_icache(const void *start, const void *end);
+	static void debug_log_hashjmp(offs_t pc, int mode);
+	static void debug_log_hashjmp_fail();
+
+	// code generators
+	void op_handle(arm64code *&dst, const uml::instruction &inst);
+	void op_hash(arm64code *&dst, const uml::instruction &inst);
+	void op_label(arm64code *&dst, const uml::instruction &inst);
+	void op_comment(arm64code *&dst, const uml::instruction &inst);
+	void op_mapvar(arm64code *&dst, const uml::instruction &inst);
+
+	void op_nop(arm64code *&dst, const uml::instruction &inst);
+	void op_debug(arm64code *&dst, const uml::instruction &inst);
+	void op_exit(arm64code *&dst, const uml::instruction &inst);
+	void op_hashjmp(arm64code *&dst, const uml::instruction &inst);
+	void op_jmp(arm64code *&dst, const uml::instruction &inst);
+	void op_exh(arm64code *&dst, const uml::instruction &inst);
+	void op_callh(arm64code *&dst, const uml::instruction &inst);
+	void op_ret(arm64code *&dst, const uml::instruction &inst);
+	void op_callc(arm64code *&dst, const uml::instruction &inst);
+	void op_recover(arm64code *&dst, const uml::instruction &inst);
+
+	void op_setfmod(arm64code *&dst, const uml::instruction &inst);
+	void op_getfmod(arm64code *&dst, const uml::instruction &inst);
+	void op_getexp(arm64code *&dst, const uml::instruction &inst);
+	void op_getflgs(arm64code *&dst, const uml::instruction &inst);
+	void op_save(arm64code *&dst, const uml::instruction &inst);
+	void op_restore(arm64code *&dst, const uml::instruction &inst);
+
+	void op_load(arm64code *&dst, const uml::instruction &inst);
+	void op_loads(arm64code *&dst, const uml::instruction &inst);
+	void op_store(arm64code *&dst, const uml::instruction &inst);
+	void op_read(arm64code *&dst, const uml::instruction &inst);
+	void op_readm(arm64code *&dst, const uml::instruction &inst);
+	void op_write(arm64code *&dst, const uml::instruction &inst);
+	void op_writem(arm64code *&dst, const uml::instruction &inst);
+	void op_carry(arm64code *&dst, const uml::instruction &inst);
+	void op_set(arm64code *&dst, const uml::instruction &inst);
+	void op_mov(arm64code *&dst, const uml::instruction &inst);
+	void op_sext(arm64code *&dst, const uml::instruction &inst);
+	void op_roland(arm64code *&dst, const uml::instruction &inst);
+	void op_rolins(arm64code *&dst, const uml::instruction &inst);
+	void op_add(arm64code *&dst, const uml::instruction &inst);
+	void op_addc(arm64code *&dst, const uml::instruction &inst);
+	void op_sub(arm64code *&dst, const uml::instruction &inst);
+	void op_subc(arm64code *&dst, const uml::instruction &inst);
+	void op_cmp(arm64code *&dst, const uml::instruction &inst);
+	void op_mulu(arm64code *&dst, const uml::instruction &inst);
+	void op_muls(arm64code *&dst, const uml::instruction &inst);
+	void op_divu(arm64code *&dst, const uml::instruction &inst);
+	void op_divs(arm64code *&dst, const uml::instruction &inst);
+	void op_and(arm64code *&dst, const uml::instruction &inst);
+	void op_test(arm64code *&dst, const uml::instruction &inst);
+	void op_or(arm64code *&dst, const uml::instruction &inst);
+	void op_xor(arm64code *&dst, const uml::instruction &inst);
+	void op_lzcnt(arm64code *&dst, const uml::instruction &inst);
+	void op_tzcnt(arm64code *&dst, const uml::instruction &inst);
+	void op_bswap(arm64code *&dst, const uml::instruction &inst);
+	void op_shl(arm64code *&dst, const uml::instruction &inst);
+	void op_shr(arm64code *&dst, const uml::instruction &inst);
+	void op_sar(arm64code *&dst, const uml::instruction &inst);
+	void op_ror(arm64code *&dst, const uml::instruction &inst);
+	void op_rol(arm64code *&dst, const uml::instruction &inst);
+	void op_rorc(arm64code *&dst, const uml::instruction &inst);
+	void op_rolc(arm64code *&dst, const uml::instruction &inst);
+
+	void op_fload(arm64code *&dst, const uml::instruction &inst);
+	void op_fstore(arm64code *&dst, const uml::instruction &inst);
+	void op_fread(arm64code *&dst, const uml::instruction &inst);
+	void op_fwrite(arm64code *&dst, const uml::instruction &inst);
+	void op_fmov(arm64code *&dst, const uml::instruction &inst);
+	void op_ftoint(arm64code *&dst, const uml::instruction &inst);
+	void op_ffrint(arm64code *&dst, const uml::instruction &inst);
+	void op_ffrflt(arm64code *&dst, const uml::instruction &inst);
+	void op_frnds(arm64code *&dst, const uml::instruction &inst);
+	void op_fadd(arm64code *&dst, const uml::instruction &inst);
+	void op_fsub(arm64code *&dst, const uml::instruction &inst);
+	void op_fcmp(arm64code *&dst, const uml::instruction &inst);
+	void op_fmul(arm64code *&dst, const uml::instruction &inst);
+	void op_fdiv(arm64code *&dst, const uml::instruction &inst);
+	void op_fneg(arm64code *&dst, const uml::instruction &inst);
+	void op_fabs(arm64code *&dst, const uml::instruction &inst);
+	void op_fsqrt(arm64code *&dst, const uml::instruction &inst);
+	void op_frecip(arm64code *&dst, const uml::instruction &inst);
+	void op_frsqrt(arm64code *&dst, const uml::instruction &inst);
+	void op_fcopyi(arm64code *&dst, const uml::instruction &inst);
+	void op_icopyf(arm64code *&dst, const uml::instruction &inst);
+
+	// shared code generators
+	void emit_skip_unless(arm64code *&dst, const uml::instruction &inst, arm64emit::arm64_link &skip);
+	void emit_arith(arm64code *&dst, const uml::instruction &inst, bool subtract, bool carryin);
+	void emit_logical(arm64code *&dst, const uml::instruction &inst, int opc);
+	void emit_shift(arm64code *&dst, const uml::instruction &inst);
+	void emit_rotate_carry(arm64code *&dst, const uml::instruction &inst, bool left);
+	void emit_mul(arm64code *&dst, const uml::instruction &inst, bool is_signed);
+	void emit_div(arm64code *&dst, const uml::instruction &inst, bool is_signed);
+	void emit_float_binary(arm64code *&dst, const uml::instruction &inst, UINT32 opcode);
+	void emit_float_unary(arm64code *&dst, const uml::instruction &inst, UINT32 opcode);
+
+	// parameter emission helpers
+	UINT8 emit_load_p(arm64code *&dst, bool is64, UINT8 defreg, const be_parameter &param);
+	void emit_mov_r_p(arm64code *&dst, bool is64, UINT8 reg, const be_parameter &param);
+	void emit_store_p(arm64code *&dst, bool is64, const be_parameter &param, UINT8 reg);
+	UINT8 emit_fload_p(arm64code *&dst, bool isdouble, UINT8 defreg, const be_parameter &param);
+	void emit_fstore_p(arm64code *&dst, bool isdouble, const be_parameter &param, UINT8 reg);
+
+	// flags emission helpers
+	void emit_invert_carry(arm64code *&dst);
+	void emit_insert_carry(arm64code *&dst, UINT8 carryreg);
+	void emit_set_fpcr_rounding(arm64code *&dst, UINT8 modereg);
+
+	// internal state
+	drc_hash_table          m_hash;                 // hash table state
+	drc_map_variables       m_map;                  // code map
+	drc_label_list          m_labels;               // label list
+	std::unordered_map<UINT64, std::vector<arm64code *>> m_link_sites; // patchable HASHJMP call sites by target mode/PC
+
+	UINT8 *                 m_basevalue;            // value of the base register
+
+	arm64_entry_point_func  m_entry;                // entry point
+	arm64code *             m_exit;                 // exit point
+	arm64code *             m_nocode;               // nocode handler
+
+	drc_label_fixup_delegate m_fixup_label;         // precomputed delegate for fixups
+
+	// state to live in the near cache
+	struct near_state
+	{
+		arm64code *         debug_cpu_instruction_hook;// debugger callback
+		arm64code *         debug_log_hashjmp;      // hashjmp debugging
+		arm64code *         debug_log_hashjmp_fail; // hashjmp debugging
+		arm64code *         drcmap_get_value;       // map lookup helper
+
+		UINT64              fpcrsave;               // saved FPCR
+
+		UINT8               flagsmap[0x10];         // flags map, indexed by NZCV
+		UINT64              flagsunmap[0x20];       // flags unmapper
+	};
+	near_state &            m_near;
+
+	// globals
+	typedef void (drcbe_arm64::*opcode_generate_func)(arm64code *&dst, const uml::instruction &inst);
+	struct opcode_table_entry
+	{
+		uml::opcode_t           opcode;             // opcode in question
+		opcode_generate_func    func;               // function pointer to the work
+	};
+	static const opcode_table_entry s_opcode_table_source[];
+	static opcode_generate_func s_opcode_table[uml::OP_MAX];
+};
+
+} // namespace drc
+
+using drc::drcbe_arm64;
+
+
+#endif /* MAME_DEVICES_CPU_DRCBEARM64_H */
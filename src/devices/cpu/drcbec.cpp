@@ -133,6 +133,13 @@ enum
 //  MACROS
 //**************************************************************************
 
+//
+// instruction format:
+//
+//  every instruction begins with a handler word; if non-null, the handler
+//  executes the instruction directly from its pre-decoded operands and
+//  returns the next instruction; if null, an opcode word and its parameters
+//  follow and are processed by the general dispatcher in execute()
 //
 // opcode format:
 //
@@ -227,10 +234,62 @@ union drcbec_instruction
 	const code_handle * handle;
 	const drcbec_instruction *inst;
 	const drcbec_instruction **pinst;
+	drcbec_handler      handler;
+	FPTR                imm;
 };
 
 
 
+//**************************************************************************
+//  INLINE FUNCTIONS
+//**************************************************************************
+
+//-------------------------------------------------
+//  threaded_source - fetch a source operand that
+//  is either a pointer or an inline immediate
+//-------------------------------------------------
+
+template<typename T, bool Immediate>
+static inline T threaded_source(const drcbec_instruction &param)
+{
+	return Immediate ? T(param.imm) : *(const T *)param.v;
+}
+
+
+//-------------------------------------------------
+//  threaded_flags_* - size-specific flag helpers
+//  for the threaded handlers
+//-------------------------------------------------
+
+static inline UINT8 threaded_flags_nz(UINT32 r) { return FLAGS32_NZ(r); }
+static inline UINT8 threaded_flags_nz(UINT64 r) { return FLAGS64_NZ(r); }
+static inline UINT8 threaded_flags_add(UINT32 r, UINT32 a, UINT32 b) { return FLAGS32_NZCV_ADD(r, a, b); }
+static inline UINT8 threaded_flags_add(UINT64 r, UINT64 a, UINT64 b) { return FLAGS64_NZCV_ADD(r, a, b); }
+static inline UINT8 threaded_flags_sub(UINT32 r, UINT32 a, UINT32 b) { return FLAGS32_NZCV_SUB(r, a, b); }
+static inline UINT8 threaded_flags_sub(UINT64 r, UINT64 a, UINT64 b) { return FLAGS64_NZCV_SUB(r, a, b); }
+static inline UINT32 threaded_sar(UINT32 v, int shift) { return (INT32)v >> shift; }
+static inline UINT64 threaded_sar(UINT64 v, int shift) { return (INT64)v >> shift; }
+
+
+//-------------------------------------------------
+//  round_float - round to an integral value in a
+//  UML rounding mode; halfway cases round to even
+//  as the SSE conversions do
+//-------------------------------------------------
+
+static inline double round_float(double value, int mode)
+{
+	switch (mode)
+	{
+		case ROUND_TRUNC:   return std::trunc(value);
+		case ROUND_ROUND:   return value - std::remainder(value, 1.0);
+		case ROUND_CEIL:    return std::ceil(value);
+		default:            return std::floor(value);
+	}
+}
+
+
+
 //**************************************************************************
 //  GLOBAL VARIABLES
 //**************************************************************************
@@ -326,7 +385,7 @@ void drcbe_c::generate(drcuml_block &block, const instruction *instlist, UINT32
 	m_map.block_begin(block);
 
 	// begin codegen; fail if we can't
-	drccodeptr *cachetop = m_cache.begin_codegen(numinst * sizeof(drcbec_instruction) * 4);
+	drccodeptr *cachetop = m_cache.begin_codegen(numinst * sizeof(drcbec_instruction) * 5);
 	if (cachetop == nullptr)
 		block.abort();
 
@@ -371,7 +430,13 @@ void drcbe_c::generate(drcuml_block &block, const instruction *instlist, UINT32
 
 			// JMP instructions need to resolve their labels
 			case OP_JMP:
-				(dst++)->i = MAKE_OPCODE_FULL(opcode, inst.size(), inst.condition(), inst.flags(), 1);
+				if (inst.condition() == COND_ALWAYS)
+					(dst++)->handler = &drcbe_c::threaded_jmp<false>;
+				else
+				{
+					(dst++)->handler = &drcbe_c::threaded_jmp<true>;
+					(dst++)->i = MAKE_OPCODE_FULL(opcode, inst.size(), inst.condition(), inst.flags(), 1);
+				}
 				dst->inst = (drcbec_instruction *)m_labels.get_codeptr(inst.param(0).label(), m_fixup_delegate, dst);
 				dst++;
 				break;
@@ -379,6 +444,13 @@ void drcbe_c::generate(drcuml_block &block, const instruction *instlist, UINT32
 			// generically handle everything else
 			default:
 
+				// common operations get a specialized handler with pre-decoded operands
+				if (output_threaded(&dst, inst))
+					break;
+
+				// everything else goes through the general dispatcher
+				(dst++)->handler = nullptr;
+
 				// determine the operand size for each operand; mostly this is just the instruction size
 				for (int pnum = 0; pnum < inst.numparams(); pnum++)
 					psize[pnum] = inst.size();
@@ -470,6 +542,17 @@ bool drcbe_c::hash_exists(UINT32 mode, UINT32 pc)
 }
 
 
+//-------------------------------------------------
+//  invalidate_code - drop the hash entries of any
+//  blocks compiled from the given guest code range
+//-------------------------------------------------
+
+int drcbe_c::invalidate_code(offs_t start, offs_t end)
+{
+	return m_hash.invalidate_range(start, end);
+}
+
+
 //-------------------------------------------------
 //  get_info - return information about the
 //  back-end implementation
@@ -503,6 +586,12 @@ int drcbe_c::execute(code_handle &entry)
 	UINT8 sp = 0;
 	while (true)
 	{
+		// run threaded handlers until we reach an instruction that needs the dispatcher
+		drcbec_handler handler;
+		while ((handler = inst->handler) != nullptr)
+			inst = (*handler)(inst, flags);
+		inst++;
+
 		UINT32 opcode = (inst++)->i;
 
 		switch (OPCODE_GET_SHORT(opcode))
@@ -590,7 +679,7 @@ int drcbe_c::execute(code_handle &entry)
 				newinst = (const drcbec_instruction *)inst[0].handle->codeptr();
 				assert_in_cache(m_cache, newinst);
 				m_state.exp = PARAM1;
-				callstack[sp++] = inst;
+				callstack[sp++] = inst + OPCODE_GET_PWORDS(opcode);
 				inst = newinst;
 				continue;
 
@@ -605,7 +694,7 @@ int drcbe_c::execute(code_handle &entry)
 
 			case MAKE_OPCODE_SHORT(OP_RECOVER, 4, 0):   // RECOVER dst,mapvar
 				assert(sp > 0);
-				PARAM0 = m_map.get_value((drccodeptr)callstack[0], MAPVAR_M0 + PARAM1);
+				PARAM0 = m_map.get_value((drccodeptr)callstack[0] - 1, MAPVAR_M0 + PARAM1);
 				break;
 
 
@@ -901,19 +990,9 @@ int drcbe_c::execute(code_handle &entry)
 				break;
 
 			case MAKE_OPCODE_SHORT(OP_ADDC, 4, 1):
-				temp32 = PARAM1 + PARAM2 + (flags & FLAG_C);
-				if (PARAM2 + 1 != 0)
-					flags = FLAGS32_NZCV_ADD(temp32, PARAM1, PARAM2 + (flags & FLAG_C));
-				else
-				{
-					if ((PARAM2 == 0xffffffff) && (flags & FLAG_C))
-					{
-						flags = FLAGS32_NZCV_ADD(temp32, PARAM1 + (flags & FLAG_C), PARAM2);
-						flags |= FLAG_C;
-					}
-					else
-						flags = FLAGS32_NZCV_ADD(temp32, PARAM1 + (flags & FLAG_C), PARAM2);
-				}
+				temp64 = (UINT64)PARAM1 + (UINT64)PARAM2 + (flags & FLAG_C);
+				temp32 = (UINT32)temp64;
+				flags = FLAGS32_NZ(temp32) | ((temp64 >> 32) & FLAG_C) | FLAGS32_V_ADD(temp32, PARAM1, PARAM2);
 				PARAM0 = temp32;
 				break;
 
@@ -932,17 +1011,9 @@ int drcbe_c::execute(code_handle &entry)
 				break;
 
 			case MAKE_OPCODE_SHORT(OP_SUBB, 4, 1):
-				temp32 = PARAM1 - PARAM2 - (flags & FLAG_C);
-				temp64 = (UINT64)PARAM1 - (UINT64)PARAM2 - (UINT64)(flags & FLAG_C);
-				if (PARAM2 + 1 != 0)
-					flags = FLAGS32_NZCV_SUB(temp32, PARAM1, PARAM2 + (flags & FLAG_C));
-				else
-				{
-					flags = FLAGS32_NZCV_SUB(temp32, PARAM1 - (flags & FLAG_C), PARAM2);
-					flags &= ~(FLAG_C | FLAG_V);
-					flags |= ((temp64>>32) & 1) ? FLAG_C : 0;
-					flags |= (((PARAM1) ^ (PARAM2)) & ((PARAM1) ^ (temp64)) & 0x80000000) ? FLAG_V : 0;
-				}
+				temp64 = (UINT64)PARAM1 - (UINT64)PARAM2 - (flags & FLAG_C);
+				temp32 = (UINT32)temp64;
+				flags = FLAGS32_NZ(temp32) | ((temp64 >> 32) & FLAG_C) | FLAGS32_V_SUB(temp32, PARAM1, PARAM2);
 				PARAM0 = temp32;
 				break;
 
@@ -960,7 +1031,7 @@ int drcbe_c::execute(code_handle &entry)
 
 			case MAKE_OPCODE_SHORT(OP_MULU, 4, 1):
 				temp64 = (UINT64)(UINT32)PARAM2 * (UINT64)(UINT32)PARAM3;
-				flags = FLAGS64_NZ(temp64);
+				flags = (inst[0].puint32 == inst[1].puint32) ? FLAGS32_NZ((UINT32)temp64) : FLAGS64_NZ(temp64);
 				PARAM1 = temp64 >> 32;
 				PARAM0 = (UINT32)temp64;
 				if (temp64 != (UINT32)temp64)
@@ -975,8 +1046,7 @@ int drcbe_c::execute(code_handle &entry)
 
 			case MAKE_OPCODE_SHORT(OP_MULS, 4, 1):
 				temp64 = (INT64)(INT32)PARAM2 * (INT64)(INT32)PARAM3;
-				temp32 = (INT32)temp64;
-				flags = FLAGS32_NZ(temp32);
+				flags = (inst[0].puint32 == inst[1].puint32) ? FLAGS32_NZ((UINT32)temp64) : FLAGS64_NZ(temp64);
 				PARAM1 = temp64 >> 32;
 				PARAM0 = (UINT32)temp64;
 				if (temp64 != (INT32)temp64)
@@ -1086,9 +1156,9 @@ int drcbe_c::execute(code_handle &entry)
 				break;
 
 			case MAKE_OPCODE_SHORT(OP_BSWAP, 4, 1):
-				temp32 = PARAM1;
+				temp32 = FLIPENDIAN_INT32(PARAM1);
 				flags = FLAGS32_NZ(temp32);
-				PARAM0 = FLIPENDIAN_INT32(temp32);
+				PARAM0 = temp32;
 				break;
 
 			case MAKE_OPCODE_SHORT(OP_SHL, 4, 0):       // SHL     dst,src,count[,f]
@@ -1189,17 +1259,17 @@ int drcbe_c::execute(code_handle &entry)
 			case MAKE_OPCODE_SHORT(OP_RORC, 4, 0):      // RORC    dst,src,count[,f]
 				shift = PARAM2 & 31;
 				if (shift > 1)
-					PARAM0 = (PARAM1 >> shift) | (((flags & FLAG_C) << 31) >> (shift - 1)) | (PARAM1 << (33 - shift));
+					PARAM0 = (PARAM1 >> shift) | ((((UINT32)flags & FLAG_C) << 31) >> (shift - 1)) | (PARAM1 << (33 - shift));
 				else if (shift == 1)
-					PARAM0 = (PARAM1 >> shift) | ((flags & FLAG_C) << 31);
+					PARAM0 = (PARAM1 >> shift) | (((UINT32)flags & FLAG_C) << 31);
 				break;
 
 			case MAKE_OPCODE_SHORT(OP_RORC, 4, 1):
 				shift = PARAM2 & 31;
 				if (shift > 1)
-					temp32 = (PARAM1 >> shift) | (((flags & FLAG_C) << 31) >> (shift - 1)) | (PARAM1 << (33 - shift));
+					temp32 = (PARAM1 >> shift) | ((((UINT32)flags & FLAG_C) << 31) >> (shift - 1)) | (PARAM1 << (33 - shift));
 				else if (shift == 1)
-					temp32 = (PARAM1 >> shift) | ((flags & FLAG_C) << 31);
+					temp32 = (PARAM1 >> shift) | (((UINT32)flags & FLAG_C) << 31);
 				else
 					temp32 = PARAM1;
 				flags = FLAGS32_NZ(temp32);
@@ -1427,7 +1497,7 @@ int drcbe_c::execute(code_handle &entry)
 				break;
 
 			case MAKE_OPCODE_SHORT(OP_READM8, 8, 0):    // DREADM  dst,src1,mask,space_QWORD
-				DPARAM0 = m_space[PARAM3]->read_qword(PARAM1, PARAM2);
+				DPARAM0 = m_space[PARAM3]->read_qword(PARAM1, DPARAM2);
 				break;
 
 			case MAKE_OPCODE_SHORT(OP_WRITE1, 8, 0):    // DWRITE  dst,src1,space_BYTE
@@ -1458,7 +1528,7 @@ int drcbe_c::execute(code_handle &entry)
 				m_space[PARAM3]->write_qword(PARAM0, DPARAM1, DPARAM2);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_CARRY, 8, 0):     // DCARRY  src,bitnum
+			case MAKE_OPCODE_SHORT(OP_CARRY, 8, 1):     // DCARRY  src,bitnum
 				flags = (flags & ~FLAG_C) | ((DPARAM0 >> (DPARAM1 & 63)) & FLAG_C);
 				break;
 
@@ -1545,10 +1615,7 @@ int drcbe_c::execute(code_handle &entry)
 
 			case MAKE_OPCODE_SHORT(OP_ADDC, 8, 1):
 				temp64 = DPARAM1 + DPARAM2 + (flags & FLAG_C);
-				if (DPARAM2 + 1 != 0)
-					flags = FLAGS64_NZCV_ADD(temp64, DPARAM1, DPARAM2 + (flags & FLAG_C));
-				else
-					flags = FLAGS64_NZCV_ADD(temp64, DPARAM1 + (flags & FLAG_C), DPARAM2);
+				flags = FLAGS64_NZ(temp64) | (temp64 < DPARAM1 || ((flags & FLAG_C) && temp64 == DPARAM1)) | FLAGS64_V_ADD(temp64, DPARAM1, DPARAM2);
 				DPARAM0 = temp64;
 				break;
 
@@ -1568,10 +1635,7 @@ int drcbe_c::execute(code_handle &entry)
 
 			case MAKE_OPCODE_SHORT(OP_SUBB, 8, 1):
 				temp64 = DPARAM1 - DPARAM2 - (flags & FLAG_C);
-				if (DPARAM2 + 1 != 0)
-					flags = FLAGS64_NZCV_SUB(temp64, DPARAM1, DPARAM2 + (flags & FLAG_C));
-				else
-					flags = FLAGS64_NZCV_SUB(temp64, DPARAM1 - (flags & FLAG_C), DPARAM2);
+				flags = FLAGS64_NZ(temp64) | (DPARAM1 < DPARAM2 || ((flags & FLAG_C) && DPARAM1 == DPARAM2)) | FLAGS64_V_SUB(temp64, DPARAM1, DPARAM2);
 				DPARAM0 = temp64;
 				break;
 
@@ -1649,7 +1713,7 @@ int drcbe_c::execute(code_handle &entry)
 				break;
 
 			case MAKE_OPCODE_SHORT(OP_TEST, 8, 1):      // DTEST   src1,src2[,f]
-				temp64 = DPARAM1 & DPARAM2;
+				temp64 = DPARAM0 & DPARAM1;
 				flags = FLAGS64_NZ(temp64);
 				break;
 
@@ -1705,9 +1769,9 @@ int drcbe_c::execute(code_handle &entry)
 				break;
 
 			case MAKE_OPCODE_SHORT(OP_BSWAP, 8, 1):
-				temp64 = DPARAM1;
+				temp64 = FLIPENDIAN_INT64(DPARAM1);
 				flags = FLAGS64_NZ(temp64);
-				DPARAM0 = FLIPENDIAN_INT64(temp64);
+				DPARAM0 = temp64;
 				break;
 
 			case MAKE_OPCODE_SHORT(OP_SHL, 8, 0):       // DSHL    dst,src,count[,f]
@@ -1740,14 +1804,14 @@ int drcbe_c::execute(code_handle &entry)
 
 			case MAKE_OPCODE_SHORT(OP_SAR, 8, 1):
 				shift = DPARAM2 & 63;
-				temp64 = (INT32)DPARAM1 >> shift;
+				temp64 = (INT64)DPARAM1 >> shift;
 				flags = FLAGS64_NZ(temp64);
 				if (shift != 0) flags |= (DPARAM1 >> (shift - 1)) & FLAG_C;
 				DPARAM0 = temp64;
 				break;
 
 			case MAKE_OPCODE_SHORT(OP_ROL, 8, 0):       // DROL    dst,src,count[,f]
-				shift = DPARAM2 & 31;
+				shift = DPARAM2 & 63;
 				DPARAM0 = (DPARAM1 << shift) | (DPARAM1 >> ((64 - shift) & 63));
 				break;
 
@@ -1762,7 +1826,7 @@ int drcbe_c::execute(code_handle &entry)
 			case MAKE_OPCODE_SHORT(OP_ROLC, 8, 0):      // DROLC   dst,src,count[,f]
 				shift = DPARAM2 & 63;
 				if (shift > 1)
-					DPARAM0 = (DPARAM1 << shift) | ((flags & FLAG_C) << (shift - 1)) | (DPARAM1 >> (65 - shift));
+					DPARAM0 = (DPARAM1 << shift) | (((UINT64)flags & FLAG_C) << (shift - 1)) | (DPARAM1 >> (65 - shift));
 				else if (shift == 1)
 					DPARAM0 = (DPARAM1 << shift) | (flags & FLAG_C);
 				break;
@@ -1770,7 +1834,7 @@ int drcbe_c::execute(code_handle &entry)
 			case MAKE_OPCODE_SHORT(OP_ROLC, 8, 1):
 				shift = DPARAM2 & 63;
 				if (shift > 1)
-					temp64 = (DPARAM1 << shift) | ((flags & FLAG_C) << (shift - 1)) | (DPARAM1 >> (65 - shift));
+					temp64 = (DPARAM1 << shift) | (((UINT64)flags & FLAG_C) << (shift - 1)) | (DPARAM1 >> (65 - shift));
 				else if (shift == 1)
 					temp64 = (DPARAM1 << shift) | (flags & FLAG_C);
 				else
@@ -1850,10 +1914,7 @@ int drcbe_c::execute(code_handle &entry)
 				break;
 
 			case MAKE_OPCODE_SHORT(OP_FTOI4R, 4, 0):    // FSTOI4R dst,src1
-				if (FSPARAM1 >= 0)
-					*inst[0].pint32 = floor(FSPARAM1 + 0.5f);
-				else
-					*inst[0].pint32 = ceil(FSPARAM1 - 0.5f);
+				*inst[0].pint32 = round_float(FSPARAM1, ROUND_ROUND);
 				break;
 
 			case MAKE_OPCODE_SHORT(OP_FTOI4F, 4, 0):    // FSTOI4F dst,src1
@@ -1865,7 +1926,7 @@ int drcbe_c::execute(code_handle &entry)
 				break;
 
 			case MAKE_OPCODE_SHORT(OP_FTOI4, 4, 0):     // FSTOI4  dst,src1
-				*inst[0].pint32 = FSPARAM1;
+				*inst[0].pint32 = round_float(FSPARAM1, m_state.fmod);
 				break;
 
 			case MAKE_OPCODE_SHORT(OP_FTOI8T, 4, 0):    // FSTOI8T dst,src1
@@ -1876,10 +1937,7 @@ int drcbe_c::execute(code_handle &entry)
 				break;
 
 			case MAKE_OPCODE_SHORT(OP_FTOI8R, 4, 0):    // FSTOI8R dst,src1
-				if (FSPARAM1 >= 0)
-					*inst[0].pint64 = floor(FSPARAM1 + 0.5f);
-				else
-					*inst[0].pint64 = ceil(FSPARAM1 - 0.5f);
+				*inst[0].pint64 = round_float(FSPARAM1, ROUND_ROUND);
 				break;
 
 			case MAKE_OPCODE_SHORT(OP_FTOI8F, 4, 0):    // FSTOI8F dst,src1
@@ -1891,7 +1949,7 @@ int drcbe_c::execute(code_handle &entry)
 				break;
 
 			case MAKE_OPCODE_SHORT(OP_FTOI8, 4, 0):     // FSTOI8  dst,src1
-				*inst[0].pint64 = FSPARAM1;
+				*inst[0].pint64 = round_float(FSPARAM1, m_state.fmod);
 				break;
 
 			case MAKE_OPCODE_SHORT(OP_FFRI4, 4, 0):     // FSFRI4  dst,src1
@@ -1916,7 +1974,7 @@ int drcbe_c::execute(code_handle &entry)
 
 			case MAKE_OPCODE_SHORT(OP_FCMP, 4, 1):      // FSCMP   src1,src2
 				if (std::isnan(FSPARAM0) || std::isnan(FSPARAM1))
-					flags = FLAG_U;
+					flags = FLAG_U | FLAG_Z | FLAG_C;       // unordered, as on x86
 				else
 					flags = (FSPARAM0 < FSPARAM1) | ((FSPARAM0 == FSPARAM1) << 2);
 				break;
@@ -1993,10 +2051,7 @@ int drcbe_c::execute(code_handle &entry)
 				break;
 
 			case MAKE_OPCODE_SHORT(OP_FTOI4R, 8, 0):    // FDTOI4R dst,src1
-				if (FDPARAM1 >= 0)
-					*inst[0].pint32 = floor(FDPARAM1 + 0.5);
-				else
-					*inst[0].pint32 = ceil(FDPARAM1 - 0.5);
+				*inst[0].pint32 = round_float(FDPARAM1, ROUND_ROUND);
 				break;
 
 			case MAKE_OPCODE_SHORT(OP_FTOI4F, 8, 0):    // FDTOI4F dst,src1
@@ -2008,7 +2063,7 @@ int drcbe_c::execute(code_handle &entry)
 				break;
 
 			case MAKE_OPCODE_SHORT(OP_FTOI4, 8, 0):     // FDTOI4  dst,src1
-				*inst[0].pint32 = FDPARAM1;
+				*inst[0].pint32 = round_float(FDPARAM1, m_state.fmod);
 				break;
 
 			case MAKE_OPCODE_SHORT(OP_FTOI8T, 8, 0):    // FDTOI8T dst,src1
@@ -2019,10 +2074,7 @@ int drcbe_c::execute(code_handle &entry)
 				break;
 
 			case MAKE_OPCODE_SHORT(OP_FTOI8R, 8, 0):    // FDTOI8R  dst,src1
-				if (FDPARAM1 >= 0)
-					*inst[0].pint64 = floor(FDPARAM1 + 0.5);
-				else
-					*inst[0].pint64 = ceil(FDPARAM1 - 0.5);
+				*inst[0].pint64 = round_float(FDPARAM1, ROUND_ROUND);
 				break;
 
 			case MAKE_OPCODE_SHORT(OP_FTOI8F, 8, 0):    // FDTOI8F dst,src1
@@ -2034,7 +2086,7 @@ int drcbe_c::execute(code_handle &entry)
 				break;
 
 			case MAKE_OPCODE_SHORT(OP_FTOI8, 8, 0):     // FDTOI8  dst,src1
-				*inst[0].pint64 = FDPARAM1;
+				*inst[0].pint64 = round_float(FDPARAM1, m_state.fmod);
 				break;
 
 			case MAKE_OPCODE_SHORT(OP_FFRI4, 8, 0):     // FDFRI4  dst,src1
@@ -2063,7 +2115,7 @@ int drcbe_c::execute(code_handle &entry)
 
 			case MAKE_OPCODE_SHORT(OP_FCMP, 8, 1):      // FDCMP   src1,src2
 				if (std::isnan(FDPARAM0) || std::isnan(FDPARAM1))
-					flags = FLAG_U;
+					flags = FLAG_U | FLAG_Z | FLAG_C;       // unordered, as on x86
 				else
 					flags = (FDPARAM0 < FDPARAM1) | ((FDPARAM0 == FDPARAM1) << 2);
 				break;
@@ -2204,6 +2256,110 @@ void drcbe_c::output_parameter(drcbec_instruction **dstptr, void **immedptr, int
 }
 
 
+//-------------------------------------------------
+//  output_threaded - emit a common instruction
+//  with a specialized handler; returns false if
+//  the general dispatcher must be used instead
+//-------------------------------------------------
+
+bool drcbe_c::output_threaded(drcbec_instruction **dstptr, const instruction &inst)
+{
+	// conditional instructions always go through the dispatcher
+	if (inst.condition() != COND_ALWAYS)
+		return false;
+
+	// resolve mapvars to their current values
+	parameter param[instruction::MAX_PARAMS];
+	for (int pnum = 0; pnum < inst.numparams(); pnum++)
+	{
+		param[pnum] = inst.param(pnum);
+		if (param[pnum].is_mapvar())
+			param[pnum] = m_map.get_last_value(param[pnum].mapvar());
+	}
+
+	// determine which parameters may be inline immediates
+	int firstimm;
+	switch (inst.opcode())
+	{
+		case OP_MOV:
+		case OP_CMP:
+		case OP_TEST:
+			firstimm = 1;
+			break;
+
+		case OP_ADD:
+		case OP_SUB:
+		case OP_AND:
+		case OP_OR:
+		case OP_XOR:
+		case OP_SHL:
+		case OP_SHR:
+		case OP_SAR:
+		case OP_ROLAND:
+		case OP_ROLINS:
+			firstimm = 2;
+			break;
+
+		default:
+			return false;
+	}
+
+	// the immediate parameters must be all immediates or all pointers, and 64-bit
+	// immediates can only be stored inline if a pointer is large enough to hold them
+	bool immediate = param[firstimm].is_immediate();
+	if (immediate && inst.size() > sizeof(FPTR))
+		return false;
+	for (int pnum = 0; pnum < inst.numparams(); pnum++)
+	{
+		bool wantimm = (pnum >= firstimm && immediate);
+		if (param[pnum].is_immediate() != wantimm)
+			return false;
+		if (!wantimm && !param[pnum].is_int_register() && !param[pnum].is_memory())
+			return false;
+	}
+
+	// select the handler; a few flag-setting forms are left to the dispatcher
+	bool flags = (inst.flags() != 0);
+	bool quad = (inst.size() == 8);
+	drcbec_handler handler;
+	switch (inst.opcode())
+	{
+#define THREADED_SELECT(op) (quad ? threaded_select<UINT64, op>(flags, immediate) : threaded_select<UINT32, op>(flags, immediate))
+		case OP_MOV:    handler = THREADED_SELECT(OP_MOV);                                      break;
+		case OP_ADD:    handler = THREADED_SELECT(OP_ADD);                                      break;
+		case OP_SUB:    handler = THREADED_SELECT(OP_SUB);                                      break;
+		case OP_CMP:    handler = flags ? THREADED_SELECT(OP_CMP) : nullptr;                    break;
+		case OP_AND:    handler = THREADED_SELECT(OP_AND);                                      break;
+		case OP_OR:     handler = THREADED_SELECT(OP_OR);                                       break;
+		case OP_XOR:    handler = THREADED_SELECT(OP_XOR);                                      break;
+		case OP_TEST:   handler = (flags && !quad) ? THREADED_SELECT(OP_TEST) : nullptr;        break;
+		case OP_SHL:    handler = THREADED_SELECT(OP_SHL);                                      break;
+		case OP_SHR:    handler = THREADED_SELECT(OP_SHR);                                      break;
+		case OP_SAR:    handler = (!flags || !quad) ? THREADED_SELECT(OP_SAR) : nullptr;        break;
+		case OP_ROLAND: handler = THREADED_SELECT(OP_ROLAND);                                   break;
+		case OP_ROLINS: handler = THREADED_SELECT(OP_ROLINS);                                   break;
+		default:        handler = nullptr;                                                      break;
+#undef THREADED_SELECT
+	}
+	if (handler == nullptr)
+		return false;
+
+	// output the handler followed by the operands
+	drcbec_instruction *dst = *dstptr;
+	void *immed = nullptr;
+	(dst++)->handler = handler;
+	for (int pnum = 0; pnum < inst.numparams(); pnum++)
+	{
+		if (param[pnum].is_immediate())
+			(dst++)->imm = (FPTR)param[pnum].immediate();
+		else
+			output_parameter(&dst, &immed, inst.size(), param[pnum]);
+	}
+	*dstptr = dst;
+	return true;
+}
+
+
 //-------------------------------------------------
 //  fixup_label - callback to fixup forward-
 //  referenced labels
@@ -2216,6 +2372,124 @@ void drcbe_c::fixup_label(void *parameter, drccodeptr labelcodeptr)
 }
 
 
+//-------------------------------------------------
+//  threaded_select - return the handler for the
+//  given opcode, flags and operand kind
+//-------------------------------------------------
+
+template<typename T, int Opcode>
+drcbec_handler drcbe_c::threaded_select(bool flags, bool immediate)
+{
+	if (flags)
+		return immediate ? &drcbe_c::threaded_op<T, Opcode, true, true> : &drcbe_c::threaded_op<T, Opcode, true, false>;
+	else
+		return immediate ? &drcbe_c::threaded_op<T, Opcode, false, true> : &drcbe_c::threaded_op<T, Opcode, false, false>;
+}
+
+
+//-------------------------------------------------
+//  threaded_op - execute a common operation from
+//  its pre-decoded operands; the flag results
+//  match the general dispatcher exactly
+//-------------------------------------------------
+
+template<typename T, int Opcode, bool Flags, bool Immediate>
+const drcbec_instruction *drcbe_c::threaded_op(const drcbec_instruction *inst, UINT8 &flags)
+{
+	const int mask = sizeof(T) * 8 - 1;
+	T src1, src2, result;
+	int shift;
+
+	switch (Opcode)
+	{
+		case OP_MOV:                                // MOV     dst,src
+			*(T *)inst[1].v = threaded_source<T, Immediate>(inst[2]);
+			return inst + 3;
+
+		case OP_CMP:                                // CMP     src1,src2,f
+			src1 = *(const T *)inst[1].v;
+			src2 = threaded_source<T, Immediate>(inst[2]);
+			flags = threaded_flags_sub(T(src1 - src2), src1, src2);
+			return inst + 3;
+
+		case OP_TEST:                               // TEST    src1,src2,f
+			result = *(const T *)inst[1].v & threaded_source<T, Immediate>(inst[2]);
+			flags = threaded_flags_nz(result);
+			return inst + 3;
+
+		case OP_ADD:                                // ADD     dst,src1,src2[,f]
+		case OP_SUB:                                // SUB     dst,src1,src2[,f]
+			src1 = *(const T *)inst[2].v;
+			src2 = threaded_source<T, Immediate>(inst[3]);
+			result = (Opcode == OP_ADD) ? T(src1 + src2) : T(src1 - src2);
+			if (Flags)
+				flags = (Opcode == OP_ADD) ? threaded_flags_add(result, src1, src2) : threaded_flags_sub(result, src1, src2);
+			*(T *)inst[1].v = result;
+			return inst + 4;
+
+		case OP_AND:                                // AND     dst,src1,src2[,f]
+		case OP_OR:                                 // OR      dst,src1,src2[,f]
+		case OP_XOR:                                // XOR     dst,src1,src2[,f]
+			src1 = *(const T *)inst[2].v;
+			src2 = threaded_source<T, Immediate>(inst[3]);
+			result = (Opcode == OP_AND) ? (src1 & src2) : (Opcode == OP_OR) ? (src1 | src2) : (src1 ^ src2);
+			if (Flags)
+				flags = threaded_flags_nz(result);
+			*(T *)inst[1].v = result;
+			return inst + 4;
+
+		case OP_SHL:                                // SHL     dst,src,count[,f]
+		case OP_SHR:                                // SHR     dst,src,count[,f]
+		case OP_SAR:                                // SAR     dst,src,count[,f]
+			src1 = *(const T *)inst[2].v;
+			shift = threaded_source<T, Immediate>(inst[3]) & mask;
+			result = (Opcode == OP_SHL) ? T(src1 << shift) : (Opcode == OP_SHR) ? T(src1 >> shift) : threaded_sar(src1, shift);
+
+			// 32-bit shifts by zero leave the flags alone; 64-bit shifts always update N and Z
+			if (Flags && (shift != 0 || sizeof(T) == 8))
+			{
+				flags = threaded_flags_nz(result);
+				if (shift != 0)
+					flags |= ((Opcode == OP_SHL) ? T(T(src1 << (shift - 1)) >> mask) : T(src1 >> (shift - 1))) & FLAG_C;
+			}
+			*(T *)inst[1].v = result;
+			return inst + 4;
+
+		case OP_ROLAND:                             // ROLAND  dst,src,count,mask[,f]
+		case OP_ROLINS:                             // ROLINS  dst,src,count,mask[,f]
+			src1 = *(const T *)inst[2].v;
+			shift = threaded_source<T, Immediate>(inst[3]) & mask;
+			src2 = threaded_source<T, Immediate>(inst[4]);
+			result = T(src1 << shift) | T(src1 >> ((mask + 1 - shift) & mask));
+			if (Opcode == OP_ROLAND)
+				result &= src2;
+			else
+				result = (*(const T *)inst[1].v & ~src2) | (result & src2);
+			if (Flags)
+				flags = threaded_flags_nz(result);
+			*(T *)inst[1].v = result;
+			return inst + 5;
+
+		default:
+			fatalerror("Unexpected threaded opcode\n");
+	}
+}
+
+
+//-------------------------------------------------
+//  threaded_jmp - execute a JMP to a resolved
+//  label, optionally testing a condition
+//-------------------------------------------------
+
+template<bool Conditional>
+const drcbec_instruction *drcbe_c::threaded_jmp(const drcbec_instruction *inst, UINT8 &flags)
+{
+	if (!Conditional)
+		return inst[1].inst;
+	return OPCODE_PASS_CONDITION(inst[1].i, flags) ? inst[2].inst : inst + 3;
+}
+
+
 //-------------------------------------------------
 //  dmulu - perform a double-wide unsigned multiply
 //-------------------------------------------------
@@ -2253,10 +2527,11 @@ int drcbe_c::dmulu(UINT64 &dstlo, UINT64 &dsthi, UINT64 src1, UINT64 src2, int f
 	lo += temp << 32;
 	hi += (temp >> 32) + (lo < prevlo);
 
-	// store the results
+	// store the results; S and Z come from the low half alone if that is all we keep
+	bool lowonly = (&dstlo == &dsthi);
 	dsthi = hi;
 	dstlo = lo;
-	return ((hi >> 60) & FLAG_S) | ((dsthi != 0) << 1);
+	return (lowonly ? FLAGS64_NZ(lo) : ((hi >> 60) & FLAG_S)) | ((hi != 0) << 1);
 }
 
 
@@ -2304,10 +2579,11 @@ int drcbe_c::dmuls(UINT64 &dstlo, UINT64 &dsthi, INT64 src1, INT64 src2, int fla
 		lo = ~lo + 1;
 	}
 
-	// store the results
+	// store the results; S and Z come from the low half alone if that is all we keep
+	bool lowonly = (&dstlo == &dsthi);
 	dsthi = hi;
 	dstlo = lo;
-	return ((hi >> 60) & FLAG_S) | ((dsthi != ((INT64)lo >> 63)) << 1);
+	return (lowonly ? FLAGS64_NZ(lo) : ((hi >> 60) & FLAG_S)) | ((hi != (UINT64)((INT64)lo >> 63)) << 1);
 }
 
 UINT32 drcbe_c::tzcount32(UINT32 value)
@@ -24,6 +24,9 @@
 
 union drcbec_instruction;
 
+// threaded-code handler: executes one pre-decoded instruction and returns the next
+typedef const drcbec_instruction *(*drcbec_handler)(const drcbec_instruction *inst, UINT8 &flags);
+
 class drcbe_c : public drcbe_interface
 {
 public:
@@ -36,17 +39,24 @@ public:
 	virtual int execute(uml::code_handle &entry) override;
 	virtual void generate(drcuml_block &block, const uml::instruction *instlist, UINT32 numinst) override;
 	virtual bool hash_exists(UINT32 mode, UINT32 pc) override;
+	virtual int invalidate_code(offs_t start, offs_t end) override;
 	virtual void get_info(drcbe_info &info) override;
 
 private:
 	// helpers
 	void output_parameter(drcbec_instruction **dstptr, void **immedptr, int size, const uml::parameter &param);
+	bool output_threaded(drcbec_instruction **dstptr, const uml::instruction &inst);
 	void fixup_label(void *parameter, drccodeptr labelcodeptr);
 	int dmulu(UINT64 &dstlo, UINT64 &dsthi, UINT64 src1, UINT64 src2, int flags);
 	int dmuls(UINT64 &dstlo, UINT64 &dsthi, INT64 src1, INT64 src2, int flags);
 	UINT32 tzcount32(UINT32 value);
 	UINT64 tzcount64(UINT64 value);
 
+	// threaded-code handlers
+	template<typename T, int Opcode, bool Flags, bool Immediate> static const drcbec_instruction *threaded_op(const drcbec_instruction *inst, UINT8 &flags);
+	template<bool Conditional> static const drcbec_instruction *threaded_jmp(const drcbec_instruction *inst, UINT8 &flags);
+	template<typename T, int Opcode> static drcbec_handler threaded_select(bool flags, bool immediate);
+
 	// internal state
 	drc_hash_table          m_hash;                 // hash table state
 	drc_map_variables       m_map;                  // code map
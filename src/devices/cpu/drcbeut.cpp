@@ -55,6 +55,9 @@ drc_hash_table::drc_hash_table(drc_cache &cache, UINT32 modes, UINT8 addrbits, U
 
 bool drc_hash_table::reset()
 {
+	// every block is gone, so forget which pages they covered
+	m_pagemap.clear();
+
 	// allocate an empty l2 hash table
 	m_emptyl2 = (drccodeptr *)m_cache.alloc_temporary(sizeof(drccodeptr) << m_l2bits);
 	if (m_emptyl2 == nullptr)
@@ -87,6 +90,8 @@ bool drc_hash_table::reset()
 
 void drc_hash_table::block_begin(drcuml_block &block, const uml::instruction *instlist, UINT32 numinst)
 {
+	std::vector<page_entry> entries;
+
 	// before generating code, pre-allocate any hash entries; we do this by setting dummy hash values
 	for (int inum = 0; inum < numinst; inum++)
 	{
@@ -100,6 +105,10 @@ void drc_hash_table::block_begin(drcuml_block &block, const uml::instruction *in
 			// if we fail to allocate, we must abort the block
 			if (!set_codeptr(inst.param(0).immediate(), inst.param(1).immediate(), nullptr))
 				block.abort();
+
+			// remember the entry so the pages it covers can invalidate it
+			page_entry entry = { UINT32(inst.param(0).immediate()), UINT32(inst.param(1).immediate()) };
+			entries.push_back(entry);
 		}
 
 		// if the opcode is a hashjmp to a fixed location, make sure we preallocate the tables
@@ -111,6 +120,21 @@ void drc_hash_table::block_begin(drcuml_block &block, const uml::instruction *in
 				block.abort();
 		}
 	}
+
+	// every page the block was compiled from maps to all of its entry points; blocks
+	// that don't report their guest code are assumed to cover just their entry points
+	std::vector<std::pair<offs_t, offs_t>> ranges = block.code_ranges();
+	if (ranges.empty())
+		for (const page_entry &entry : entries)
+			ranges.push_back(std::make_pair(entry.pc, entry.pc));
+	for (auto &range : ranges)
+		for (offs_t page = range.first >> PAGE_SHIFT; page <= range.second >> PAGE_SHIFT; page++)
+		{
+			std::vector<page_entry> &pagelist = m_pagemap[page];
+			for (const page_entry &entry : entries)
+				if (std::find_if(pagelist.begin(), pagelist.end(), [&entry](const page_entry &existing) { return existing.mode == entry.mode && existing.pc == entry.pc; }) == pagelist.end())
+					pagelist.push_back(entry);
+		}
 }
 
 
@@ -188,6 +212,42 @@ bool drc_hash_table::set_codeptr(UINT32 mode, UINT32 pc, drccodeptr code)
 }
 
 
+//-------------------------------------------------
+//  invalidate_range - point every entry of the
+//  blocks compiled from the given range of guest
+//  code back at the recompile handler; the code
+//  itself stays in the cache until the next flush,
+//  and the dropped entries are optionally
+//  reported so back-ends can unlink them
+//-------------------------------------------------
+
+int drc_hash_table::invalidate_range(offs_t start, offs_t end, std::vector<std::pair<UINT32, UINT32>> *dropped)
+{
+	int count = 0;
+	for (offs_t page = start >> PAGE_SHIFT; page <= end >> PAGE_SHIFT; page++)
+	{
+		auto found = m_pagemap.find(page);
+		if (found == m_pagemap.end())
+			continue;
+
+		// the tables for these entries were allocated when the block began
+		for (const page_entry &entry : found->second)
+		{
+			drccodeptr &code = m_base[entry.mode][(entry.pc >> m_l1shift) & m_l1mask][(entry.pc >> m_l2shift) & m_l2mask];
+			if (code != m_nocodeptr)
+			{
+				code = m_nocodeptr;
+				count++;
+				if (dropped != nullptr)
+					dropped->push_back(std::make_pair(entry.mode, entry.pc));
+			}
+		}
+		m_pagemap.erase(found);
+	}
+	return count;
+}
+
+
 
 //**************************************************************************
 //  DRC MAP VARIABLES
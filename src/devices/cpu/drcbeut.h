@@ -14,6 +14,7 @@
 #define __DRCBEUT_H__
 
 #include "drcuml.h"
+#include <unordered_map>
 
 
 //**************************************************************************
@@ -52,7 +53,20 @@ public:
 	drccodeptr get_codeptr(UINT32 mode, UINT32 pc) { assert(mode < m_modes); return m_base[mode][(pc >> m_l1shift) & m_l1mask][(pc >> m_l2shift) & m_l2mask]; }
 	bool code_exists(UINT32 mode, UINT32 pc) { return get_codeptr(mode, pc) != m_nocodeptr; }
 
+	// selective invalidation
+	int invalidate_range(offs_t start, offs_t end, std::vector<std::pair<UINT32, UINT32>> *dropped = nullptr);
+
 private:
+	// guest code is tracked in pages of this size
+	static const int PAGE_SHIFT = 12;
+
+	// a hash entry belonging to a block that covers a page
+	struct page_entry
+	{
+		UINT32          mode;                   // mode of the entry
+		UINT32          pc;                     // PC of the entry
+	};
+
 	// internal state
 	drc_cache &     m_cache;                // cache where allocations come from
 	UINT32          m_modes;                // number of modes supported
@@ -69,6 +83,8 @@ private:
 	drccodeptr ***  m_base;                 // pointer to the l1 table for each mode
 	drccodeptr **   m_emptyl1;              // pointer to empty l1 hash table
 	drccodeptr *    m_emptyl2;              // pointer to empty l2 hash table
+
+	std::unordered_map<offs_t, std::vector<page_entry>> m_pagemap; // guest code page to hash entries of the blocks covering it
 };
 
 
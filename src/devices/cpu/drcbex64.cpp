@@ -115,7 +115,7 @@
         RBP        - pointer to code cache
         R8         - scratch register
         R9         - scratch register
-        R10        - scratch register
+        R10        - maps to I7, saved around calls
         R11        - scratch register
         R12        - maps to I3
         R13        - maps to I4
@@ -130,9 +130,9 @@
         RSI        - unused
         RDI        - unused
         RBP        - pointer to code cache
-        R8         - scratch register
-        R9         - scratch register
-        R10        - scratch register
+        R8         - maps to I5, saved around calls
+        R9         - maps to I6, saved around calls
+        R10        - maps to I7, saved around calls
         R11        - scratch register
         R12        - maps to I1
         R13        - maps to I2
@@ -229,6 +229,9 @@ const UINT32 PTYPE_MR   = PTYPE_M | PTYPE_R;
 const UINT32 PTYPE_MRI  = PTYPE_M | PTYPE_R | PTYPE_I;
 const UINT32 PTYPE_MF   = PTYPE_M | PTYPE_F;
 
+// size of a patchable HASHJMP call site
+const int LINK_SITE_SIZE = 6;
+
 #ifdef X64_WINDOWS_ABI
 
 const int REG_PARAM1    = REG_RCX;
@@ -279,12 +282,20 @@ drcbe_x64::opcode_generate_func drcbe_x64::s_opcode_table[OP_MAX];
 static const UINT8 int_register_map[REG_I_COUNT] =
 {
 #ifdef X64_WINDOWS_ABI
-	REG_RBX, REG_RSI, REG_RDI, REG_R12, REG_R13, REG_R14, REG_R15
+	REG_RBX, REG_RSI, REG_RDI, REG_R12, REG_R13, REG_R14, REG_R15, REG_R10
 #else
-	REG_RBX, REG_R12, REG_R13, REG_R14, REG_R15
+	REG_RBX, REG_R12, REG_R13, REG_R14, REG_R15, REG_R8, REG_R9, REG_R10
 #endif
 };
 
+// mapped integer registers that live in caller-saved host registers; these
+// are spilled before calls out to C code and reloaded at the next label,
+// branch or handle call
+static inline bool is_volatile_host_register(UINT8 reg)
+{
+	return (reg == REG_R8 || reg == REG_R9 || reg == REG_R10);
+}
+
 static UINT8 float_register_map[REG_F_COUNT] =
 {
 	REG_XMM6, REG_XMM7, REG_XMM8, REG_XMM9, REG_XMM10, REG_XMM11, REG_XMM12, REG_XMM13, REG_XMM14, REG_XMM15
@@ -453,7 +464,7 @@ drcbe_x64::be_parameter::be_parameter(drcbe_x64 &drcbe, const parameter &param,
 			assert(allowed & PTYPE_R);
 			assert(allowed & PTYPE_M);
 			regnum = int_register_map[param.ireg() - REG_I0];
-			if (regnum != 0)
+			if (regnum != 0 && (drcbe.m_spilled & (1 << (param.ireg() - REG_I0))) == 0)
 				*this = make_ireg(regnum);
 			else
 				*this = make_memory(&drcbe.m_state.r[param.ireg() - REG_I0]);
@@ -574,6 +585,8 @@ inline int drcbe_x64::get_base_register_and_offset(x86code *&dst, void *target,
 
 inline void drcbe_x64::emit_smart_call_r64(x86code *&dst, x86code *target, UINT8 reg)
 {
+	UINT32 const live = m_callsave & ~m_spilled;
+	emit_spill_volatile_iregs(dst, live);
 	INT64 delta = target - (dst + 5);
 	if (short_immediate(delta))
 		emit_call(dst, target);                                                         // call  target
@@ -582,6 +595,7 @@ inline void drcbe_x64::emit_smart_call_r64(x86code *&dst, x86code *target, UINT8
 		emit_mov_r64_imm(dst, reg, (FPTR)target);                                       // mov   reg,target
 		emit_call_r64(dst, reg);                                                        // call  reg
 	}
+	emit_fill_volatile_iregs(dst, live);
 }
 
 
@@ -592,11 +606,41 @@ inline void drcbe_x64::emit_smart_call_r64(x86code *&dst, x86code *target, UINT8
 
 inline void drcbe_x64::emit_smart_call_m64(x86code *&dst, x86code **target)
 {
+	UINT32 const live = m_callsave & ~m_spilled;
+	emit_spill_volatile_iregs(dst, live);
 	INT64 delta = *target - (dst + 5);
 	if (short_immediate(delta))
 		emit_call(dst, *target);                                                        // call  *target
 	else
 		emit_call_m64(dst, MABS(target));                                               // call  [target]
+	emit_fill_volatile_iregs(dst, live);
+}
+
+
+//-------------------------------------------------
+//  emit_spill_volatile_iregs - store the given
+//  mapped integer registers held in caller-saved
+//  host registers ahead of a call out to C code
+//-------------------------------------------------
+
+void drcbe_x64::emit_spill_volatile_iregs(x86code *&dst, UINT32 mask)
+{
+	for (int regnum = 0; regnum < REG_I_COUNT; regnum++)
+		if ((mask & (1 << regnum)) != 0)
+			emit_mov_m64_r64(dst, MABS(&m_state.r[regnum]), int_register_map[regnum]);   // mov   [r[regnum]],reg
+}
+
+
+//-------------------------------------------------
+//  emit_fill_volatile_iregs - reload the given
+//  registers spilled by emit_spill_volatile_iregs
+//-------------------------------------------------
+
+void drcbe_x64::emit_fill_volatile_iregs(x86code *&dst, UINT32 mask)
+{
+	for (int regnum = 0; regnum < REG_I_COUNT; regnum++)
+		if ((mask & (1 << regnum)) != 0)
+			emit_mov_r64_m64(dst, int_register_map[regnum], MABS(&m_state.r[regnum]));   // mov   reg,[r[regnum]]
 }
 
 
@@ -616,8 +660,13 @@ drcbe_x64::drcbe_x64(drcuml_state &drcuml, device_t &device, drc_cache &cache, U
 		m_labels(cache),
 		m_log(nullptr),
 		m_sse41(false),
-		m_absmask32((UINT32 *)cache.alloc_near(16*2 + 15)),
+		m_volatile_iregs(0),
+		m_callsave(0),
+		m_spilled(0),
+		m_absmask32((UINT32 *)cache.alloc_near(16*4 + 15)),
 		m_absmask64(nullptr),
+		m_signmask32(nullptr),
+		m_signmask64(nullptr),
 		m_rbpvalue(cache.near() + 0x80),
 		m_entry(nullptr),
 		m_exit(nullptr),
@@ -638,11 +687,20 @@ drcbe_x64::drcbe_x64(drcuml_state &drcuml, device_t &device, drc_cache &cache, U
 	m_near.single1 = 1.0f;
 	m_near.double1 = 1.0;
 
-	// create absolute value masks that are aligned to SSE boundaries
+	// note which mapped integer registers the ABI lets C code clobber
+	for (int regnum = 0; regnum < REG_I_COUNT; regnum++)
+		if (int_register_map[regnum] != 0 && is_volatile_host_register(int_register_map[regnum]))
+			m_volatile_iregs |= 1 << regnum;
+
+	// create absolute value and sign masks that are aligned to SSE boundaries
 	m_absmask32 = (UINT32 *)(((FPTR)m_absmask32 + 15) & ~15);
 	m_absmask32[0] = m_absmask32[1] = m_absmask32[2] = m_absmask32[3] = 0x7fffffff;
 	m_absmask64 = (UINT64 *)&m_absmask32[4];
 	m_absmask64[0] = m_absmask64[1] = U64(0x7fffffffffffffff);
+	m_signmask32 = &m_absmask32[8];
+	m_signmask32[0] = m_signmask32[1] = m_signmask32[2] = m_signmask32[3] = 0x80000000;
+	m_signmask64 = (UINT64 *)&m_absmask32[12];
+	m_signmask64[0] = m_signmask64[1] = U64(0x8000000000000000);
 
 	// get pointers to C functions we need to call
 	m_near.debug_cpu_instruction_hook = (x86code *)debugger_instruction_hook;
@@ -745,7 +803,7 @@ void drcbe_x64::reset()
 	emit_sub_r64_imm(dst, REG_RSP, 8);                                                  // sub   rsp,8
 	emit_mov_m64_r64(dst, MABS(&m_near.stacksave), REG_RSP);                            // mov   [stacksave],rsp
 	emit_stmxcsr_m32(dst, MABS(&m_near.ssemode));                                       // stmxcsr [ssemode]
-	emit_jmp_r64(dst, REG_PARAM2);                                                      // jmp   param2
+	emit_call_r64(dst, REG_PARAM2);                                                     // call  param2
 	if (m_log != nullptr)
 		x86log_disasm_code_range(m_log, "entry_point", (x86code *)m_entry, dst);
 
@@ -776,8 +834,9 @@ void drcbe_x64::reset()
 	*cachetop = (drccodeptr)dst;
 	m_cache.end_codegen();
 
-	// reset our hash tables
+	// reset our hash tables, forgetting any linked jumps
 	m_hash.reset();
+	m_link_sites.clear();
 	m_hash.set_default_codeptr(m_nocode);
 }
 
@@ -814,6 +873,9 @@ void drcbe_x64::generate(drcuml_block &block, const instruction *instlist, UINT3
 	x86code *base = (x86code *)(((FPTR)*cachetop + 63) & ~63);
 	x86code *dst = base;
 
+	// registers held in caller-saved host registers are preserved across calls from block code
+	m_callsave = m_volatile_iregs;
+
 	// generate code
 	const char *blockname = nullptr;
 	for (int inum = 0; inum < numinst; inum++)
@@ -837,14 +899,58 @@ void drcbe_x64::generate(drcuml_block &block, const instruction *instlist, UINT3
 				blockname = string_format("Code: mode=%d PC=%08X", (UINT32)inst.param(0).immediate(), (offs_t)inst.param(1).immediate()).c_str();
 		}
 
+		// after a call out to C code the volatile registers stay in memory,
+		// where operands find them, until control flow needs them back
+		switch (inst.opcode())
+		{
+			case OP_DEBUG:
+			case OP_CALLC:
+			case OP_RECOVER:
+			case OP_READ:
+			case OP_READM:
+			case OP_WRITE:
+			case OP_WRITEM:
+			case OP_FREAD:
+			case OP_FWRITE:
+				emit_spill_volatile_iregs(dst, m_callsave & ~m_spilled);
+				m_spilled = m_callsave;
+				break;
+
+			case OP_HANDLE:
+			case OP_HASH:
+			case OP_LABEL:
+			case OP_EXIT:
+			case OP_HASHJMP:
+			case OP_JMP:
+			case OP_EXH:
+			case OP_CALLH:
+			case OP_RET:
+			case OP_SAVE:
+			case OP_RESTORE:
+				emit_fill_volatile_iregs(dst, m_spilled);
+				m_spilled = 0;
+				break;
+
+			default:
+				break;
+		}
+
 		// generate code
 		(this->*s_opcode_table[inst.opcode()])(dst, inst);
 	}
+	emit_fill_volatile_iregs(dst, m_spilled);
+	m_spilled = 0;
+	m_callsave = 0;
 
 	// complete codegen
 	*cachetop = (drccodeptr)dst;
 	m_cache.end_codegen();
 
+	// link any jumps waiting on this block's entry points
+	for (int inum = 0; inum < numinst; inum++)
+		if (instlist[inum].opcode() == OP_HASH)
+			update_link_sites(instlist[inum].param(0).immediate(), instlist[inum].param(1).immediate());
+
 	// log it
 	if (m_log != nullptr)
 		x86log_disasm_code_range(m_log, (blockname == nullptr) ? "Unknown block" : blockname, base, m_cache.top());
@@ -867,6 +973,62 @@ bool drcbe_x64::hash_exists(UINT32 mode, UINT32 pc)
 }
 
 
+//-------------------------------------------------
+//  invalidate_code - drop the hash entries of any
+//  blocks compiled from the given guest code range
+//-------------------------------------------------
+
+int drcbe_x64::invalidate_code(offs_t start, offs_t end)
+{
+	// unlink any jumps to the dropped entries so they go back through the hash table
+	std::vector<std::pair<UINT32, UINT32>> dropped;
+	int count = m_hash.invalidate_range(start, end, &dropped);
+	for (auto &entry : dropped)
+		update_link_sites(entry.first, entry.second);
+	return count;
+}
+
+
+//-------------------------------------------------
+//  write_link_site - write a HASHJMP call site,
+//  calling the target directly if it has been
+//  compiled or through its hash table entry if not
+//-------------------------------------------------
+
+void drcbe_x64::write_link_site(x86code *site, UINT32 mode, UINT32 pc)
+{
+	drccodeptr *entry = &m_hash.base()[mode][(pc >> m_hash.l1shift()) & m_hash.l1mask()][(pc >> m_hash.l2shift()) & m_hash.l2mask()];
+
+	// both forms are the same size and return to the same place
+	if (*entry != nullptr && *entry != m_nocode)
+	{
+		site[0] = 0x90;                                                                 // nop
+		site[1] = 0xe8;                                                                 // call  target
+		*(INT32 *)&site[2] = *entry - (site + LINK_SITE_SIZE);
+	}
+	else
+	{
+		site[0] = 0xff;                                                                 // call  [rbp+disp32]
+		site[1] = 0x95;
+		*(INT32 *)&site[2] = offset_from_rbp(entry);
+	}
+}
+
+
+//-------------------------------------------------
+//  update_link_sites - relink every HASHJMP call
+//  site targeting the given mode/PC
+//-------------------------------------------------
+
+void drcbe_x64::update_link_sites(UINT32 mode, UINT32 pc)
+{
+	auto found = m_link_sites.find((UINT64(mode) << 32) | pc);
+	if (found != m_link_sites.end())
+		for (x86code *site : found->second)
+			write_link_site(site, mode, pc);
+}
+
+
 //-------------------------------------------------
 //  get_info - return information about the
 //  back-end implementation
@@ -2053,8 +2215,16 @@ void drcbe_x64::emit_test_r64_p64(x86code *&dst, UINT8 reg, const be_parameter &
 
 void drcbe_x64::emit_test_m64_p64(x86code *&dst, x86_memref memref, const be_parameter &param, const instruction &inst)
 {
-	if (param.is_immediate() && short_immediate(param.immediate()))
-		emit_test_m64_imm(dst, memref, param.immediate());                          // test  [dest],param
+	if (param.is_immediate())
+	{
+		if (short_immediate(param.immediate()))
+			emit_test_m64_imm(dst, memref, param.immediate());                      // test  [dest],param
+		else
+		{
+			emit_mov_r64_imm(dst, REG_R11, param.immediate());                          // mov   r11,param
+			emit_test_m64_r64(dst, memref, REG_R11);                                    // test  [dest],r11
+		}
+	}
 	else if (param.is_memory())
 	{
 		emit_mov_r64_p64(dst, REG_EAX, param);                                          // mov   reg,param
@@ -2132,7 +2302,7 @@ void drcbe_x64::emit_xor_r64_p64(x86code *&dst, UINT8 reg, const be_parameter &p
 	{
 		if (inst.flags() != 0 || param.immediate() != 0)
 		{
-			if (param.immediate() == U64(0xffffffffffffffff))
+			if (inst.flags() == 0 && param.immediate() == U64(0xffffffffffffffff))
 				emit_not_r64(dst, reg);                                                 // not   reg
 			else if (short_immediate(param.immediate()))
 				emit_xor_r64_imm(dst, reg, param.immediate());                          // xor   reg,param
@@ -2161,7 +2331,7 @@ void drcbe_x64::emit_xor_m64_p64(x86code *&dst, x86_memref memref, const be_para
 	{
 		if (inst.flags() != 0 || param.immediate() != 0)
 		{
-			if (param.immediate() == U64(0xffffffffffffffff))
+			if (inst.flags() == 0 && param.immediate() == U64(0xffffffffffffffff))
 				emit_not_m64(dst, memref);                                          // not   [mem]
 			else if (short_immediate(param.immediate()))
 				emit_xor_m64_imm(dst, memref, param.immediate());                   // xor   [mem],param
@@ -2490,6 +2660,38 @@ void drcbe_x64::emit_rcr_m64_p64(x86code *&dst, x86_memref memref, const be_para
 
 
 
+//-------------------------------------------------
+//  emit_rotate_flags - merge S and Z from the
+//  rotated result into the host flags; x86
+//  rotates only update C and O
+//-------------------------------------------------
+
+void drcbe_x64::emit_rotate_flags(x86code *&dst, const be_parameter &param, const instruction &inst)
+{
+	if ((inst.flags() & (FLAG_S | FLAG_Z)) == 0)
+		return;
+
+	emit_pushf(dst);                                                                    // pushf
+	if (inst.size() == 4)
+	{
+		emit_mov_r32_p32_keepflags(dst, REG_R11, param);                                // mov   r11d,param
+		emit_test_r32_r32(dst, REG_R11, REG_R11);                                       // test  r11d,r11d
+	}
+	else
+	{
+		emit_mov_r64_p64_keepflags(dst, REG_R11, param);                                // mov   r11,param
+		emit_test_r64_r64(dst, REG_R11, REG_R11);                                       // test  r11,r11
+	}
+	emit_pushf(dst);                                                                    // pushf
+	emit_pop_r64(dst, REG_R11);                                                         // pop   r11
+	emit_and_r32_imm(dst, REG_R11, 0xc0);                                               // and   r11d,0xc0
+	emit_and_m64_imm(dst, MBD(REG_RSP, 0), ~0xc0);                                      // and   [rsp],~0xc0
+	emit_or_m64_r64(dst, MBD(REG_RSP, 0), REG_R11);                                     // or    [rsp],r11
+	emit_popf(dst);                                                                     // popf
+}
+
+
+
 /***************************************************************************
     EMITTERS FOR FLOATING POINT OPERATIONS WITH PARAMETERS
 ***************************************************************************/
@@ -2820,8 +3022,8 @@ void drcbe_x64::op_exit(x86code *&dst, const instruction &inst)
 	// normalize parameters
 	be_parameter retp(*this, inst.param(0), PTYPE_MRI);
 
-	// load the parameter into EAX
-	emit_mov_r32_p32(dst, REG_EAX, retp);                                               // mov   eax,retp
+	// load the parameter into EAX, keeping the flags for a conditional exit
+	emit_mov_r32_p32_keepflags(dst, REG_EAX, retp);                                     // mov   eax,retp
 	if (inst.condition() == uml::COND_ALWAYS)
 		emit_jmp(dst, m_exit);                                                          // jmp   exit
 	else
@@ -2862,10 +3064,11 @@ void drcbe_x64::op_hashjmp(x86code *&dst, const instruction &inst)
 		// a straight immediate jump is direct, though we need the PC in EAX in case of failure
 		if (pcp.is_immediate())
 		{
-			UINT32 l1val = (pcp.immediate() >> m_hash.l1shift()) & m_hash.l1mask();
-			UINT32 l2val = (pcp.immediate() >> m_hash.l2shift()) & m_hash.l2mask();
-			emit_call_m64(dst, MABS(&m_hash.base()[modep.immediate()][l1val][l2val]));
-																						// call  hash[modep][l1val][l2val]
+			UINT32 mode = modep.immediate();
+			UINT32 pc = pcp.immediate();
+			m_link_sites[(UINT64(mode) << 32) | pc].push_back(dst);
+			write_link_site(dst, mode, pc);                                             // call  hash[modep][l1val][l2val]
+			dst += LINK_SITE_SIZE;                                                      //   or  call  target
 		}
 
 		// a fixed mode but variable PC
@@ -3930,11 +4133,12 @@ void drcbe_x64::op_carry(x86code *&dst, const instruction &inst)
 	// degenerate case: source is immediate
 	if (srcp.is_immediate() && bitp.is_immediate())
 	{
-		if (srcp.immediate() & ((UINT64)1 << bitp.immediate()))
+		if (srcp.immediate() & ((UINT64)1 << (bitp.immediate() & (inst.size() * 8 - 1))))
 			emit_stc(dst);
 		else
 			emit_clc(dst);
-		}
+		return;
+	}
 
 	// load non-immediate bit numbers into a register
 	if (!bitp.is_immediate())
@@ -3943,6 +4147,13 @@ void drcbe_x64::op_carry(x86code *&dst, const instruction &inst)
 		emit_and_r32_imm(dst, REG_ECX, inst.size() * 8 - 1);
 	}
 
+	// bt has no immediate source form, so load immediate sources into a register
+	if (srcp.is_immediate())
+	{
+		emit_mov_r64_imm(dst, REG_RAX, srcp.immediate());                               // mov    rax,srcp
+		srcp = be_parameter::make_ireg(REG_RAX);
+	}
+
 	// 32-bit form
 	if (inst.size() == 4)
 	{
@@ -4162,6 +4373,15 @@ void drcbe_x64::op_sext(x86code *&dst, const instruction &inst)
 			else if (sizep.size() == SIZE_DWORD)
 				emit_mov_r32_r32(dst, dstreg, srcp.ireg());                             // mov   dstreg,srcp
 		}
+		else if (srcp.is_immediate())
+		{
+			if (sizep.size() == SIZE_BYTE)
+				emit_mov_r32_imm(dst, dstreg, (INT8)srcp.immediate());                  // mov   dstreg,param
+			else if (sizep.size() == SIZE_WORD)
+				emit_mov_r32_imm(dst, dstreg, (INT16)srcp.immediate());                 // mov   dstreg,param
+			else if (sizep.size() == SIZE_DWORD)
+				emit_mov_r32_imm(dst, dstreg, srcp.immediate());                        // mov   dstreg,param
+		}
 		emit_mov_p32_r32(dst, dstp, dstreg);                                            // mov   dstp,dstreg
 		if (inst.flags() != 0)
 			emit_test_r32_r32(dst, dstreg, dstreg);                                     // test  dstreg,dstreg
@@ -4193,6 +4413,17 @@ void drcbe_x64::op_sext(x86code *&dst, const instruction &inst)
 			else if (sizep.size() == SIZE_QWORD)
 				emit_mov_r64_r64(dst, dstreg, srcp.ireg());                             // mov   dstreg,srcp
 		}
+		else if (srcp.is_immediate())
+		{
+			if (sizep.size() == SIZE_BYTE)
+				emit_mov_r64_imm(dst, dstreg, (INT8)srcp.immediate());                  // mov   dstreg,param
+			else if (sizep.size() == SIZE_WORD)
+				emit_mov_r64_imm(dst, dstreg, (INT16)srcp.immediate());                 // mov   dstreg,param
+			else if (sizep.size() == SIZE_DWORD)
+				emit_mov_r64_imm(dst, dstreg, (INT32)srcp.immediate());                 // mov   dstreg,param
+			else if (sizep.size() == SIZE_QWORD)
+				emit_mov_r64_imm(dst, dstreg, srcp.immediate());                        // mov   dstreg,param
+		}
 		emit_mov_p64_r64(dst, dstp, dstreg);                                            // mov   dstp,dstreg
 		if (inst.flags() != 0)
 			emit_test_r64_r64(dst, dstreg, dstreg);                                     // test  dstreg,dstreg
@@ -4752,13 +4983,15 @@ void drcbe_x64::op_muls(x86code *&dst, const instruction &inst)
 	normalize_commutative(src1p, src2p);
 	bool compute_hi = (dstp != edstp);
 
+	// the low-only forms multiply into the destination register
+	int dstreg = dstp.is_int_register() ? dstp.ireg() : REG_EAX;
+
 	// 32-bit form
 	if (inst.size() == 4)
 	{
 		// 32-bit destination with memory/immediate or register/immediate
 		if (!compute_hi && !src1p.is_immediate() && src2p.is_immediate())
 		{
-			int dstreg = dstp.is_int_register() ? dstp.ireg() : REG_EAX;
 			if (src1p.is_memory())
 				emit_imul_r32_m32_imm(dst, dstreg, MABS(src1p.memory()), src2p.immediate()); // imul  dstreg,[src1p],src2p
 			else if (src1p.is_int_register())
@@ -4769,12 +5002,13 @@ void drcbe_x64::op_muls(x86code *&dst, const instruction &inst)
 		// 32-bit destination, general case
 		else if (!compute_hi)
 		{
-			int dstreg = dstp.is_int_register() ? dstp.ireg() : REG_EAX;
 			emit_mov_r32_p32(dst, dstreg, src1p);                                       // mov   dstreg,src1p
 			if (src2p.is_memory())
 				emit_imul_r32_m32(dst, dstreg, MABS(src2p.memory()));                   // imul  dstreg,[src2p]
 			else if (src2p.is_int_register())
 				emit_imul_r32_r32(dst, dstreg, src2p.ireg());                           // imul  dstreg,src2p
+			else if (src2p.is_immediate())
+				emit_imul_r32_r32_imm(dst, dstreg, dstreg, src2p.immediate());          // imul  dstreg,dstreg,src2p
 			emit_mov_p32_r32(dst, dstp, dstreg);                                        // mov   dstp,dstreg
 		}
 
@@ -4817,7 +5051,7 @@ void drcbe_x64::op_muls(x86code *&dst, const instruction &inst)
 					}
 				}
 				else
-					emit_test_r32_r32(dst, REG_EAX, REG_EAX);                           // test  eax,eax
+					emit_test_r32_r32(dst, dstreg, dstreg);                             // test  dstreg,dstreg
 
 				// we rely on the fact that OF is cleared by all logical operations above
 				if (vflag)
@@ -4838,7 +5072,6 @@ void drcbe_x64::op_muls(x86code *&dst, const instruction &inst)
 		// 64-bit destination with memory/immediate or register/immediate
 		if (!compute_hi && !src1p.is_immediate() && src2p.is_immediate() && short_immediate(src2p.immediate()))
 		{
-			int dstreg = dstp.is_int_register() ? dstp.ireg() : REG_RAX;
 			if (src1p.is_memory())
 				emit_imul_r64_m64_imm(dst, dstreg, MABS(src1p.memory()), src2p.immediate());// imul  dstreg,[src1p],src2p
 			else if (src1p.is_int_register())
@@ -4849,12 +5082,16 @@ void drcbe_x64::op_muls(x86code *&dst, const instruction &inst)
 		// 64-bit destination, general case
 		else if (!compute_hi)
 		{
-			int dstreg = dstp.is_int_register() ? dstp.ireg() : REG_RAX;
 			emit_mov_r64_p64(dst, dstreg, src1p);                                       // mov   dstreg,src1p
 			if (src2p.is_memory())
 				emit_imul_r64_m64(dst, dstreg, MABS(src2p.memory()));                   // imul  dstreg,[src2p]
 			else if (src2p.is_int_register())
 				emit_imul_r64_r64(dst, dstreg, src2p.ireg());                           // imul  dstreg,src2p
+			else if (src2p.is_immediate())
+			{
+				emit_mov_r64_imm(dst, REG_R11, src2p.immediate());                      // mov   r11,src2p
+				emit_imul_r64_r64(dst, dstreg, REG_R11);                                // imul  dstreg,r11
+			}
 			emit_mov_p64_r64(dst, dstp, dstreg);                                        // mov   dstp,dstreg
 		}
 
@@ -4897,7 +5134,7 @@ void drcbe_x64::op_muls(x86code *&dst, const instruction &inst)
 					}
 				}
 				else
-					emit_test_r64_r64(dst, REG_RAX, REG_RAX);                           // test  rax,rax
+					emit_test_r64_r64(dst, dstreg, dstreg);                             // test  dstreg,dstreg
 
 				// we rely on the fact that OF is cleared by all logical operations above
 				if (vflag)
@@ -5673,6 +5910,9 @@ void drcbe_x64::op_rol(x86code *&dst, const instruction &inst)
 			emit_mov_p64_r64(dst, dstp, dstreg);                                        // mov   dstp,dstreg
 		}
 	}
+
+	// x86 rotates leave S and Z untouched
+	emit_rotate_flags(dst, dstp, inst);                                                 // merge S/Z
 }
 
 
@@ -5726,6 +5966,9 @@ void drcbe_x64::op_ror(x86code *&dst, const instruction &inst)
 			emit_mov_p64_r64(dst, dstp, dstreg);                                        // mov   dstp,dstreg
 		}
 	}
+
+	// x86 rotates leave S and Z untouched
+	emit_rotate_flags(dst, dstp, inst);                                                 // merge S/Z
 }
 
 
@@ -5779,6 +6022,9 @@ void drcbe_x64::op_rolc(x86code *&dst, const instruction &inst)
 			emit_mov_p64_r64(dst, dstp, dstreg);                                        // mov   dstp,dstreg
 		}
 	}
+
+	// x86 rotates leave S and Z untouched
+	emit_rotate_flags(dst, dstp, inst);                                                 // merge S/Z
 }
 
 
@@ -5832,6 +6078,9 @@ void drcbe_x64::op_rorc(x86code *&dst, const instruction &inst)
 			emit_mov_p64_r64(dst, dstp, dstreg);                                        // mov   dstp,dstreg
 		}
 	}
+
+	// x86 rotates leave S and Z untouched
+	emit_rotate_flags(dst, dstp, inst);                                                 // merge S/Z
 }
 
 
@@ -6605,22 +6854,16 @@ void drcbe_x64::op_fneg(x86code *&dst, const instruction &inst)
 	// 32-bit form
 	if (inst.size() == 4)
 	{
-		emit_xorps_r128_r128(dst, dstreg, dstreg);                                      // xorps dstreg,dstreg
-		if (srcp.is_memory())
-			emit_subss_r128_m32(dst, dstreg, MABS(srcp.memory()));                      // subss dstreg,[srcp]
-		else if (srcp.is_float_register())
-			emit_subss_r128_r128(dst, dstreg, srcp.freg());                             // subss dstreg,srcp
+		emit_movss_r128_p32(dst, dstreg, srcp);                                         // movss dstreg,srcp
+		emit_xorps_r128_m128(dst, dstreg, MABS(m_signmask32));                          // xorps dstreg,[signmask32]
 		emit_movss_p32_r128(dst, dstp, dstreg);                                         // movss dstp,dstreg
 	}
 
 	// 64-bit form
 	else if (inst.size() == 8)
 	{
-		emit_xorpd_r128_r128(dst, dstreg, dstreg);                                      // xorpd dstreg,dstreg
-		if (srcp.is_memory())
-			emit_subsd_r128_m64(dst, dstreg, MABS(srcp.memory()));                      // subsd dstreg,[srcp]
-		else if (srcp.is_float_register())
-			emit_subsd_r128_r128(dst, dstreg, srcp.freg());                             // subsd dstreg,srcp
+		emit_movsd_r128_p64(dst, dstreg, srcp);                                         // movsd dstreg,srcp
+		emit_xorpd_r128_m128(dst, dstreg, MABS(m_signmask64));                          // xorpd dstreg,[signmask64]
 		emit_movsd_p64_r128(dst, dstp, dstreg);                                         // movsd dstp,dstreg
 	}
 }
@@ -40,6 +40,7 @@ public:
 	virtual int execute(uml::code_handle &entry) override;
 	virtual void generate(drcuml_block &block, const uml::instruction *instlist, UINT32 numinst) override;
 	virtual bool hash_exists(UINT32 mode, UINT32 pc) override;
+	virtual int invalidate_code(offs_t start, offs_t end) override;
 	virtual void get_info(drcbe_info &info) override;
 	virtual bool logging() const override { return m_log != nullptr; }
 
@@ -120,6 +121,10 @@ private:
 	int get_base_register_and_offset(x86code *&dst, void *target, UINT8 reg, INT32 &offset);
 	void emit_smart_call_r64(x86code *&dst, x86code *target, UINT8 reg);
 	void emit_smart_call_m64(x86code *&dst, x86code **target);
+	void emit_spill_volatile_iregs(x86code *&dst, UINT32 mask);
+	void emit_fill_volatile_iregs(x86code *&dst, UINT32 mask);
+	void write_link_site(x86code *site, UINT32 mode, UINT32 pc);
+	void update_link_sites(UINT32 mode, UINT32 pc);
 
 	void fixup_label(void *parameter, drccodeptr labelcodeptr);
 	void fixup_exception(drccodeptr *codeptr, void *param1, void *param2);
@@ -286,6 +291,7 @@ private:
 	void emit_rcl_m64_p64(x86code *&dst, x86_memref memref, const be_parameter &param, const uml::instruction &inst);
 	void emit_rcr_r64_p64(x86code *&dst, UINT8 reg, const be_parameter &param, const uml::instruction &inst);
 	void emit_rcr_m64_p64(x86code *&dst, x86_memref memref, const be_parameter &param, const uml::instruction &inst);
+	void emit_rotate_flags(x86code *&dst, const be_parameter &param, const uml::instruction &inst);
 
 	// floating-point code emission helpers
 	void emit_movss_r128_p32(x86code *&dst, UINT8 reg, const be_parameter &param);
@@ -299,9 +305,15 @@ private:
 	drc_label_list          m_labels;               // label list
 	x86log_context *        m_log;                  // logging
 	bool                    m_sse41;                // do we have SSE4.1 support?
+	UINT32                  m_volatile_iregs;       // mask of integer registers mapped to caller-saved host registers
+	UINT32                  m_callsave;             // mask of registers to preserve across calls in block code
+	UINT32                  m_spilled;              // mask of those currently held in m_state instead
+	std::unordered_map<UINT64, std::vector<x86code *>> m_link_sites; // patchable HASHJMP call sites by target mode/PC
 
 	UINT32 *                m_absmask32;            // absolute value mask (32-bit)
 	UINT64 *                m_absmask64;            // absolute value mask (32-bit)
+	UINT32 *                m_signmask32;           // sign bit mask (32-bit)
+	UINT64 *                m_signmask64;           // sign bit mask (64-bit)
 	UINT8 *                 m_rbpvalue;             // value of RBP
 
 	x86_entry_point_func    m_entry;                // entry point
@@ -836,6 +836,17 @@ bool drcbe_x86::hash_exists(UINT32 mode, UINT32 pc)
 }
 
 
+//-------------------------------------------------
+//  invalidate_code - drop the hash entries of any
+//  blocks compiled from the given guest code range
+//-------------------------------------------------
+
+int drcbe_x86::invalidate_code(offs_t start, offs_t end)
+{
+	return m_hash.invalidate_range(start, end);
+}
+
+
 //-------------------------------------------------
 //  drcbex86_get_info - return information about
 //  the back-end implementation
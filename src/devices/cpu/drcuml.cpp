@@ -10,9 +10,6 @@
 
     Future improvements/changes:
 
-    * UML optimizer:
-        - constant folding
-
     * Write a back-end validator:
         - checks all combinations of memory/register/immediate on all params
         - checks behavior of all opcodes
@@ -37,6 +34,8 @@
 #include "drcbec.h"
 #include "drcbex86.h"
 #include "drcbex64.h"
+#include "drcbearm64.h"
+#include "drcverify.h"
 
 using namespace uml;
 
@@ -51,6 +50,15 @@ using namespace uml;
 
 
 
+//**************************************************************************
+//  CONSTANTS
+//**************************************************************************
+
+// persistent cache file format version
+const UINT32 PERSIST_VERSION = 1;
+
+
+
 //**************************************************************************
 //  TYPE DEFINITIONS
 //**************************************************************************
@@ -131,7 +139,12 @@ drcuml_state::drcuml_state(device_t &device, drc_cache &cache, UINT32 flags, int
 			std::unique_ptr<drcbe_interface>{ std::make_unique<drcbe_c>(*this, device, cache, flags, modes, addrbits, ignorebits) } :
 			std::unique_ptr<drcbe_interface>{ std::make_unique<drcbe_native>(*this, device, cache, flags, modes, addrbits, ignorebits) }),
 		m_beintf(*m_drcbe_interface.get()),
-		m_umllog(nullptr)
+		m_umllog(nullptr),
+		m_verifier(nullptr),
+		m_persist(device.machine().options().drc_cache()[0] != 0),
+		m_persist_signature(0),
+		m_persist_generation(0),
+		m_persist_restoring(false)
 {
 	// if we're to log, create the logfile
 	if (device.machine().options().drc_log_uml())
@@ -139,6 +152,13 @@ drcuml_state::drcuml_state(device_t &device, drc_cache &cache, UINT32 flags, int
 		std::string filename = std::string("drcuml_").append(m_device.shortname()).append(".asm");
 		m_umllog = fopen(filename.c_str(), "w");
 	}
+
+	// if we have a persistent cache, load it now and save it on the way out
+	if (m_persist)
+	{
+		persist_load();
+		device.machine().add_notifier(MACHINE_NOTIFY_EXIT, machine_notify_delegate(FUNC(drcuml_state::persist_save), this));
+	}
 }
 
 
@@ -150,7 +170,10 @@ drcuml_state::~drcuml_state()
 {
 	// close any files
 	if (m_umllog != nullptr)
+	{
+		log_optimizer_stats("total", m_optimizer.total_stats());
 		fclose(m_umllog);
+	}
 }
 
 
@@ -174,6 +197,18 @@ void drcuml_state::reset()
 		// call the backend to reset
 		m_beintf.reset();
 
+		// generated code is gone, so the verifier's copies are stale
+		if (m_verifier != nullptr)
+			m_verifier->cache_reset();
+
+		// no guest code is compiled any more
+		m_code_pages.clear();
+
+		// the core must describe its configuration again before blocks persist
+		m_persist_signature = 0;
+		m_persist_regions.clear();
+		m_persist_generation++;
+
 		// do a one-time validation if requested
 /*      if (VALIDATE_BACKEND)
         {
@@ -192,6 +227,31 @@ void drcuml_state::reset()
 }
 
 
+//-------------------------------------------------
+//  invalidate_code_pages - drop compiled code
+//  from the guest code pages the filter selects,
+//  returning the number of hash entries dropped
+//-------------------------------------------------
+
+int drcuml_state::invalidate_code_pages(const std::function<bool (offs_t start, offs_t end)> &filter)
+{
+	int count = 0;
+	for (auto page = m_code_pages.begin(); page != m_code_pages.end(); )
+	{
+		offs_t start = *page << CODE_PAGE_SHIFT;
+		offs_t end = start + (1 << CODE_PAGE_SHIFT) - 1;
+		if (filter(start, end))
+		{
+			count += invalidate_code(start, end);
+			page = m_code_pages.erase(page);
+		}
+		else
+			++page;
+	}
+	return count;
+}
+
+
 //-------------------------------------------------
 //  begin_block - begin a new code block
 //-------------------------------------------------
@@ -265,6 +325,492 @@ const char *drcuml_state::symbol_find(void *base, UINT32 *offset)
 }
 
 
+//-------------------------------------------------
+//  persist_anchor - reference point for C
+//  function pointers in the persistent cache;
+//  never called
+//-------------------------------------------------
+
+static void persist_anchor(void *param)
+{
+	fatalerror("persist_anchor called\n");
+}
+
+
+//-------------------------------------------------
+//  persist_put - append a value of the given
+//  size to a buffer
+//-------------------------------------------------
+
+static void persist_put(std::vector<UINT8> &data, UINT64 value, int bytes)
+{
+	for (int index = 0; index < bytes; index++)
+		data.push_back(value >> (8 * index));
+}
+
+
+//-------------------------------------------------
+//  persist_get - fetch a value of the given size
+//  from a buffer
+//-------------------------------------------------
+
+static bool persist_get(const UINT8 *&data, const UINT8 *end, int bytes, UINT64 &value)
+{
+	if (end - data < bytes)
+		return false;
+	value = 0;
+	for (int index = bytes - 1; index >= 0; index--)
+		value = (value << 8) | data[index];
+	data += bytes;
+	return true;
+}
+
+
+//-------------------------------------------------
+//  persist_signature - fold a value describing
+//  the core's configuration into the signature
+//  that persisted blocks must match; blocks are
+//  only persisted after the core calls this
+//  following a reset
+//-------------------------------------------------
+
+void drcuml_state::persist_signature(UINT64 value)
+{
+	if (!m_persist)
+		return;
+
+	// the first call registers the machine's memory, which checksums and fast paths point into
+	if (m_persist_signature == 0)
+	{
+		m_persist_signature = U64(0xcbf29ce484222325) ^ (m_device.machine().debug_flags & DEBUG_FLAG_ENABLED);
+		for (auto &block : m_device.machine().memory().blocks())
+			persist_region(block->data(), block->byteend() - block->bytestart() + 1);
+
+		std::vector<memory_region *> regions;
+		for (auto &region : m_device.machine().memory().regions())
+			regions.push_back(region.second.get());
+		std::sort(regions.begin(), regions.end(), [](memory_region *a, memory_region *b) { return strcmp(a->name(), b->name()) < 0; });
+		for (memory_region *region : regions)
+			persist_region(region->base(), region->bytes());
+	}
+	m_persist_signature = (m_persist_signature ^ value) * U64(0x100000001b3);
+}
+
+
+//-------------------------------------------------
+//  persist_region - register a range of host
+//  memory that UML memory parameters may point
+//  into; the near cache is always included
+//-------------------------------------------------
+
+void drcuml_state::persist_region(const void *base, size_t length)
+{
+	if (!m_persist || m_persist_signature == 0)
+		return;
+
+	m_persist_regions.push_back(std::make_pair(reinterpret_cast<const UINT8 *>(base), length));
+	m_persist_signature = (m_persist_signature ^ length) * U64(0x100000001b3);
+}
+
+
+//-------------------------------------------------
+//  persist_restore - if a persisted block starts
+//  at the given mode/PC and the code it was
+//  compiled from is unchanged, generate it and
+//  return true
+//-------------------------------------------------
+
+bool drcuml_state::persist_restore(UINT32 mode, offs_t pc)
+{
+	if (!m_persist || m_persist_signature == 0)
+		return false;
+	auto found = m_persist_records.find((UINT64(mode) << 32) | pc);
+	if (found == m_persist_records.end())
+		return false;
+
+	for (persist_record &record : found->second)
+	{
+		// restore each record at most once per cache generation, so that a block
+		// whose checksums fail is compiled from scratch rather than restored again
+		if (record.signature != m_persist_signature || record.generation == m_persist_generation)
+			continue;
+		sha1_t codehash;
+		if (!persist_hash_code(record.ranges, codehash) || codehash != record.codehash)
+			continue;
+		record.generation = m_persist_generation;
+
+		// decode the instructions before starting the block
+		std::vector<instruction> instlist(record.numinst);
+		const UINT8 *data = &record.data[0];
+		const UINT8 *end = data + record.data.size();
+		bool valid = true;
+		for (UINT32 inum = 0; inum < record.numinst && valid; inum++)
+			valid = persist_decode(data, end, instlist[inum]);
+		if (!valid)
+			continue;
+
+		// generate it
+		drcuml_block *block = begin_block(record.numinst);
+		for (auto &range : record.ranges)
+			block->add_code_range(range.first, range.second);
+		for (const instruction &inst : instlist)
+			block->append() = inst;
+		m_persist_restoring = true;
+		try
+		{
+			block->end();
+		}
+		catch (drcuml_block::abort_compilation &)
+		{
+			m_persist_restoring = false;
+			throw;
+		}
+		m_persist_restoring = false;
+		return true;
+	}
+	return false;
+}
+
+
+//-------------------------------------------------
+//  persist_capture - save a newly compiled block
+//  to the persistent cache, if it can be
+//-------------------------------------------------
+
+void drcuml_state::persist_capture(drcuml_block &block, const instruction *instlist, UINT32 numinst)
+{
+	if (!m_persist || m_persist_signature == 0 || m_persist_restoring || block.code_ranges().empty())
+		return;
+
+	// the first hash entry identifies the block
+	const instruction *first = std::find_if(instlist, instlist + numinst, [](const instruction &inst) { return inst.opcode() == OP_HASH; });
+	if (first == instlist + numinst)
+		return;
+
+	// encode the instructions; comments are dropped and anything that can't be relocated prevents saving
+	persist_record record;
+	record.signature = m_persist_signature;
+	record.ranges = block.code_ranges();
+	record.numinst = 0;
+	record.generation = m_persist_generation;
+	if (!persist_hash_code(record.ranges, record.codehash))
+		return;
+	for (UINT32 inum = 0; inum < numinst; inum++)
+		if (instlist[inum].opcode() != OP_COMMENT)
+		{
+			if (!persist_encode(instlist[inum], record.data))
+				return;
+			record.numinst++;
+		}
+
+	// replace any record for the same configuration
+	std::vector<persist_record> &records = m_persist_records[(first->param(0).immediate() << 32) | UINT32(first->param(1).immediate())];
+	records.erase(std::remove_if(records.begin(), records.end(), [&record](const persist_record &existing) { return existing.signature == record.signature; }), records.end());
+	records.push_back(std::move(record));
+}
+
+
+//-------------------------------------------------
+//  persist_hash_code - hash the guest code in the
+//  given ranges along with its physical location
+//-------------------------------------------------
+
+bool drcuml_state::persist_hash_code(const std::vector<std::pair<offs_t, offs_t>> &ranges, sha1_t &hash)
+{
+	device_memory_interface *memory;
+	if (!m_device.interface(memory) || !memory->has_space(AS_PROGRAM))
+		return false;
+	address_space &space = memory->space(AS_PROGRAM);
+
+	std::vector<UINT8> buffer;
+	for (auto &range : ranges)
+	{
+		offs_t physbase = 0;
+		for (offs_t address = range.first; ; address++)
+		{
+			// translate once per page, hashing the physical page with the code
+			if (address == range.first || (address & 0xfff) == 0)
+			{
+				physbase = address & ~0xfff;
+				if (!memory->translate(AS_PROGRAM, TRANSLATE_FETCH_DEBUG, physbase))
+					return false;
+				persist_put(buffer, physbase, 4);
+			}
+
+			// only code in RAM or ROM can be checked without side effects
+			const UINT8 *ptr = reinterpret_cast<const UINT8 *>(space.get_read_ptr(physbase | (address & 0xfff)));
+			if (ptr == nullptr)
+				return false;
+			buffer.push_back(*ptr);
+			if (address == range.second)
+				break;
+		}
+	}
+	hash = sha1_creator::simple(&buffer[0], buffer.size());
+	return true;
+}
+
+
+//-------------------------------------------------
+//  persist_encode - encode an instruction,
+//  relocating any host pointers
+//-------------------------------------------------
+
+bool drcuml_state::persist_encode(const instruction &inst, std::vector<UINT8> &data)
+{
+	persist_put(data, inst.m_opcode, 1);
+	persist_put(data, inst.m_condition, 1);
+	persist_put(data, inst.m_flags, 1);
+	persist_put(data, inst.m_size, 1);
+	persist_put(data, inst.m_numparams, 1);
+	for (int pnum = 0; pnum < inst.m_numparams; pnum++)
+	{
+		const parameter &param = inst.m_param[pnum];
+		UINT64 value = param.m_value;
+		persist_put(data, param.m_type, 1);
+		switch (param.m_type)
+		{
+			// memory is relative to the near cache or a registered region
+			case parameter::PTYPE_MEMORY:
+			{
+				const UINT8 *ptr = reinterpret_cast<const UINT8 *>(param.m_value);
+				int regnum;
+				if (m_cache.contains_pointer(ptr))
+				{
+					regnum = 0;
+					value = ptr - m_cache.near();
+				}
+				else
+				{
+					for (regnum = 0; regnum < m_persist_regions.size(); regnum++)
+						if (ptr >= m_persist_regions[regnum].first && ptr < m_persist_regions[regnum].first + m_persist_regions[regnum].second)
+							break;
+					if (regnum == m_persist_regions.size() || regnum >= 0xff)
+						return false;
+					value = ptr - m_persist_regions[regnum++].first;
+				}
+				persist_put(data, regnum, 1);
+				break;
+			}
+
+			// handles are identified by allocation order
+			case parameter::PTYPE_CODE_HANDLE:
+				if (m_handlelist.indexof(param.handle()) < 0)
+					return false;
+				value = m_handlelist.indexof(param.handle());
+				break;
+
+			// C functions are relative to a function in the same module
+			case parameter::PTYPE_C_FUNCTION:
+				value = param.m_value - FPTR(&persist_anchor);
+				break;
+
+			// strings can't be relocated
+			case parameter::PTYPE_STRING:
+				return false;
+
+			default:
+				break;
+		}
+		persist_put(data, value, 8);
+	}
+	return true;
+}
+
+
+//-------------------------------------------------
+//  persist_decode - decode an instruction,
+//  relocating any host pointers
+//-------------------------------------------------
+
+bool drcuml_state::persist_decode(const UINT8 *&data, const UINT8 *end, instruction &inst)
+{
+	UINT64 opcode, condition, flags, size, numparams;
+	if (!persist_get(data, end, 1, opcode) || !persist_get(data, end, 1, condition) || !persist_get(data, end, 1, flags)
+		|| !persist_get(data, end, 1, size) || !persist_get(data, end, 1, numparams) || opcode >= OP_MAX || numparams > instruction::MAX_PARAMS)
+		return false;
+	inst.m_opcode = opcode_t(opcode);
+	inst.m_condition = condition_t(condition);
+	inst.m_flags = flags;
+	inst.m_size = size;
+	inst.m_numparams = numparams;
+
+	// handles are only ever added, so refresh the lookup when new ones appear
+	if (m_persist_handles.size() != m_handlelist.count())
+	{
+		m_persist_handles.clear();
+		for (code_handle *handle = m_handlelist.first(); handle != nullptr; handle = handle->next())
+			m_persist_handles.push_back(handle);
+	}
+
+	for (int pnum = 0; pnum < numparams; pnum++)
+	{
+		UINT64 type, regnum = 0, value;
+		if (!persist_get(data, end, 1, type) || type >= parameter::PTYPE_MAX)
+			return false;
+		if (type == parameter::PTYPE_MEMORY && !persist_get(data, end, 1, regnum))
+			return false;
+		if (!persist_get(data, end, 8, value))
+			return false;
+
+		switch (type)
+		{
+			case parameter::PTYPE_MEMORY:
+				if (regnum == 0 && value < m_cache.size())
+					value = FPTR(m_cache.near() + value);
+				else if (regnum != 0 && regnum <= m_persist_regions.size() && value < m_persist_regions[regnum - 1].second)
+					value = FPTR(m_persist_regions[regnum - 1].first + value);
+				else
+					return false;
+				break;
+
+			case parameter::PTYPE_CODE_HANDLE:
+				if (value >= m_persist_handles.size())
+					return false;
+				value = FPTR(m_persist_handles[value]);
+				break;
+
+			case parameter::PTYPE_C_FUNCTION:
+				value += FPTR(&persist_anchor);
+				break;
+
+			case parameter::PTYPE_STRING:
+				return false;
+
+			default:
+				break;
+		}
+		inst.m_param[pnum] = parameter(parameter::parameter_type(type), value);
+	}
+	return true;
+}
+
+
+//-------------------------------------------------
+//  persist_filename - return the name of the
+//  persistent cache file for this device
+//-------------------------------------------------
+
+std::string drcuml_state::persist_filename() const
+{
+	std::string filename = std::string(m_device.machine().basename()).append(PATH_SEPARATOR).append(m_device.tag() + 1).append(".uml");
+	std::replace(filename.begin(), filename.end(), ':', '_');
+	return filename;
+}
+
+
+//-------------------------------------------------
+//  persist_fingerprint - identify the build, since
+//  C function offsets are only valid within it
+//-------------------------------------------------
+
+static void persist_fingerprint(std::vector<UINT8> &data)
+{
+	const char *version = emulator_info::get_build_version();
+	persist_put(data, strlen(version), 2);
+	data.insert(data.end(), version, version + strlen(version));
+	persist_put(data, FPTR(&osd_ticks) - FPTR(&persist_anchor), 8);
+	persist_put(data, FPTR(&fatalerror) - FPTR(&persist_anchor), 8);
+}
+
+
+//-------------------------------------------------
+//  persist_load - read the persistent cache file
+//  for this device, if one matches this build
+//-------------------------------------------------
+
+void drcuml_state::persist_load()
+{
+	emu_file file(m_device.machine().options().drc_cache(), OPEN_FLAG_READ);
+	if (file.open(persist_filename().c_str()) != osd_file::error::NONE)
+		return;
+	std::vector<UINT8> buffer(file.size());
+	if (buffer.empty() || file.read(&buffer[0], buffer.size()) != buffer.size())
+		return;
+	const UINT8 *data = &buffer[0];
+	const UINT8 *end = data + buffer.size();
+
+	// verify the header and fingerprint
+	std::vector<UINT8> header;
+	persist_put(header, PERSIST_VERSION, 4);
+	persist_fingerprint(header);
+	if (end - data < 8 + header.size() || memcmp(data, "MAMEUMLC", 8) != 0 || memcmp(data + 8, &header[0], header.size()) != 0)
+		return;
+	data += 8 + header.size();
+
+	// read the records; the instruction streams are only checked when restored
+	UINT64 count;
+	if (!persist_get(data, end, 4, count))
+		return;
+	while (count-- != 0)
+	{
+		persist_record record;
+		UINT64 mode, pc, numranges, numinst, length;
+		if (!persist_get(data, end, 4, mode) || !persist_get(data, end, 4, pc) || !persist_get(data, end, 8, record.signature)
+			|| end - data < sizeof(record.codehash.m_raw))
+			return;
+		memcpy(record.codehash.m_raw, data, sizeof(record.codehash.m_raw));
+		data += sizeof(record.codehash.m_raw);
+		if (!persist_get(data, end, 4, numranges))
+			return;
+		while (numranges-- != 0)
+		{
+			UINT64 start, rangeend;
+			if (!persist_get(data, end, 4, start) || !persist_get(data, end, 4, rangeend) || start > rangeend)
+				return;
+			record.ranges.push_back(std::make_pair(offs_t(start), offs_t(rangeend)));
+		}
+		if (!persist_get(data, end, 4, numinst) || !persist_get(data, end, 4, length) || end - data < length || length == 0 || record.ranges.empty())
+			return;
+		record.numinst = numinst;
+		record.data.assign(data, data + length);
+		record.generation = 0;
+		data += length;
+		m_persist_records[(mode << 32) | pc].push_back(std::move(record));
+	}
+}
+
+
+//-------------------------------------------------
+//  persist_save - write every known block to the
+//  persistent cache file for this device
+//-------------------------------------------------
+
+void drcuml_state::persist_save()
+{
+	std::vector<UINT8> buffer(8);
+	memcpy(&buffer[0], "MAMEUMLC", 8);
+	persist_put(buffer, PERSIST_VERSION, 4);
+	persist_fingerprint(buffer);
+
+	UINT32 count = 0;
+	for (auto &key : m_persist_records)
+		count += key.second.size();
+	persist_put(buffer, count, 4);
+	for (auto &key : m_persist_records)
+		for (const persist_record &record : key.second)
+		{
+			persist_put(buffer, key.first >> 32, 4);
+			persist_put(buffer, UINT32(key.first), 4);
+			persist_put(buffer, record.signature, 8);
+			buffer.insert(buffer.end(), record.codehash.m_raw, record.codehash.m_raw + sizeof(record.codehash.m_raw));
+			persist_put(buffer, record.ranges.size(), 4);
+			for (auto &range : record.ranges)
+			{
+				persist_put(buffer, range.first, 4);
+				persist_put(buffer, range.second, 4);
+			}
+			persist_put(buffer, record.numinst, 4);
+			persist_put(buffer, record.data.size(), 4);
+			buffer.insert(buffer.end(), record.data.begin(), record.data.end());
+		}
+
+	emu_file file(m_device.machine().options().drc_cache(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+	if (file.open(persist_filename().c_str()) == osd_file::error::NONE)
+		file.write(&buffer[0], buffer.size());
+}
+
+
 //-------------------------------------------------
 //  log_printf - directly printf to the UML log
 //  if generated
@@ -286,6 +832,21 @@ void drcuml_state::log_printf(const char *format, ...)
 }
 
 
+//-------------------------------------------------
+//  log_optimizer_stats - write a summary of what
+//  each optimizer pass changed to the log
+//-------------------------------------------------
+
+void drcuml_state::log_optimizer_stats(const char *label, const drcuml_optimizer_stats &stats)
+{
+	log_printf("\n; optimizer %s: %d blocks, %d instructions, %d removed\n", label, stats.blocks, stats.instructions, stats.removed);
+	log_printf(";   flags:     %d instructions trimmed\n", stats.flags_trimmed);
+	log_printf(";   constants: %d operands propagated, %d instructions folded\n", stats.consts_propagated, stats.consts_folded);
+	log_printf(";   memory:    %d loads forwarded, %d stores removed\n", stats.loads_forwarded, stats.stores_removed);
+	log_printf(";   moves:     %d dead moves removed\n", stats.moves_removed);
+}
+
+
 
 //**************************************************************************
 //  DRCUML BLOCK
@@ -301,7 +862,8 @@ drcuml_block::drcuml_block(drcuml_state &drcuml, UINT32 maxinst)
 		m_nextinst(0),
 		m_maxinst(maxinst * 3/2),
 		m_inst(m_maxinst),
-		m_inuse(false)
+		m_inuse(false),
+		m_persist_exclude(false)
 {
 }
 
@@ -324,6 +886,24 @@ void drcuml_block::begin()
 	// set up the block information and return it
 	m_inuse = true;
 	m_nextinst = 0;
+	m_code_ranges.clear();
+	m_persist_exclude = false;
+}
+
+
+//-------------------------------------------------
+//  add_code_range - note a range of guest code
+//  compiled into this block, so that writes to
+//  it can invalidate the block
+//-------------------------------------------------
+
+void drcuml_block::add_code_range(offs_t start, offs_t end)
+{
+	// extend the previous range if this one follows on directly
+	if (!m_code_ranges.empty() && m_code_ranges.back().second + 1 == start)
+		m_code_ranges.back().second = end;
+	else
+		m_code_ranges.push_back(std::make_pair(start, end));
 }
 
 
@@ -339,13 +919,33 @@ void drcuml_block::end()
 	// optimize the resulting code first
 	optimize();
 
-	// if we have a logfile, generate a disassembly of the block
+	// offer it to the persistent cache
+	if (!m_persist_exclude)
+		m_drcuml.persist_capture(*this, &m_inst[0], m_nextinst);
+
+	// if we have a logfile or a verifier, generate a disassembly of the block
+	std::string disasm;
+	if (m_drcuml.logging() || m_drcuml.m_verifier != nullptr)
+		disasm = disassemble();
 	if (m_drcuml.logging())
-		disassemble();
+	{
+		fputs(disasm.c_str(), m_drcuml.m_umllog);
+		m_drcuml.log_flush();
+	}
 
 	// generate the code via the back-end
+	drccodeptr codestart = m_drcuml.m_cache.top();
 	m_drcuml.generate(*this, &m_inst[0], m_nextinst);
 
+	// let the verifier keep the UML and native code for its reports
+	if (m_drcuml.m_verifier != nullptr)
+		m_drcuml.m_verifier->block_generated(&m_inst[0], m_nextinst, std::move(disasm), codestart, m_drcuml.m_cache.top());
+
+	// remember which guest code pages now have compiled code
+	for (auto &range : m_code_ranges)
+		for (offs_t page = range.first >> drcuml_state::CODE_PAGE_SHIFT; page <= range.second >> drcuml_state::CODE_PAGE_SHIFT; page++)
+			m_drcuml.m_code_pages.insert(page);
+
 	// block is no longer in use
 	m_inuse = false;
 }
@@ -389,53 +989,22 @@ uml::instruction &drcuml_block::append()
 
 void drcuml_block::optimize()
 {
-	UINT32 mapvar[MAPVAR_COUNT] = { 0 };
-
-	// iterate over instructions
-	for (int instnum = 0; instnum < m_nextinst; instnum++)
-	{
-		instruction &inst = m_inst[instnum];
+	m_nextinst = m_drcuml.m_optimizer.optimize(&m_inst[0], m_nextinst);
 
-		// first compute what flags we need
-		UINT8 accumflags = 0;
-		UINT8 remainingflags = inst.output_flags();
-
-		// scan ahead until we run out of possible remaining flags
-		for (int scannum = instnum + 1; remainingflags != 0 && scannum < m_nextinst; scannum++)
-		{
-			// any input flags are required
-			const instruction &scan = m_inst[scannum];
-			accumflags |= scan.input_flags();
-
-			// if the scanahead instruction is unconditional, assume his flags are modified
-			if (scan.condition() == COND_ALWAYS)
-				remainingflags &= ~scan.modified_flags();
-		}
-		inst.set_flags(accumflags);
-
-		// track mapvars
-		if (inst.opcode() == OP_MAPVAR)
-			mapvar[inst.param(0).mapvar() - MAPVAR_M0] = inst.param(1).immediate();
-
-		// convert all mapvar parameters to immediates
-		else if (inst.opcode() != OP_RECOVER)
-			for (int pnum = 0; pnum < inst.numparams(); pnum++)
-				if (inst.param(pnum).is_mapvar())
-					inst.set_mapvar(pnum, mapvar[inst.param(pnum).mapvar() - MAPVAR_M0]);
-
-		// now that flags are correct, simplify the instruction
-		inst.simplify();
-	}
+	// note what each pass did in the log
+	if (m_drcuml.logging())
+		m_drcuml.log_optimizer_stats("block", m_drcuml.m_optimizer.block_stats());
 }
 
 
 //-------------------------------------------------
 //  disassemble - disassemble a block of
-//  instructions to the log
+//  instructions to text
 //-------------------------------------------------
 
-void drcuml_block::disassemble()
+std::string drcuml_block::disassemble()
 {
+	std::string result;
 	std::string comment;
 
 	// iterate over instructions and output
@@ -454,11 +1023,11 @@ void drcuml_block::disassemble()
 
 		// print labels, handles, and hashes left justified
 		else if (inst.opcode() == OP_LABEL)
-			m_drcuml.log_printf("$%X:\n", UINT32(inst.param(0).label()));
+			result.append(string_format("$%X:\n", UINT32(inst.param(0).label())));
 		else if (inst.opcode() == OP_HANDLE)
-			m_drcuml.log_printf("%s:\n", inst.param(0).handle().string());
+			result.append(string_format("%s:\n", inst.param(0).handle().string()));
 		else if (inst.opcode() == OP_HASH)
-			m_drcuml.log_printf("(%X,%X):\n", UINT32(inst.param(0).immediate()), UINT32(inst.param(1).immediate()));
+			result.append(string_format("(%X,%X):\n", UINT32(inst.param(0).immediate()), UINT32(inst.param(1).immediate())));
 
 		// indent everything else with a tab
 		else
@@ -468,12 +1037,12 @@ void drcuml_block::disassemble()
 			// include the first accumulated comment with this line
 			if (firstcomment != -1)
 			{
-				m_drcuml.log_printf("\t%-50.50s; %s\n", dasm.c_str(), get_comment_text(m_inst[firstcomment], comment));
+				result.append(string_format("\t%-50.50s; %s\n", dasm.c_str(), get_comment_text(m_inst[firstcomment], comment)));
 				firstcomment++;
 				flushcomments = TRUE;
 			}
 			else
-				m_drcuml.log_printf("\t%s\n", dasm.c_str());
+				result.append("\t").append(dasm).append("\n");
 		}
 
 		// flush any comments pending
@@ -483,13 +1052,12 @@ void drcuml_block::disassemble()
 			{
 				const char *text = get_comment_text(m_inst[firstcomment++], comment);
 				if (text != nullptr)
-					m_drcuml.log_printf("\t%50s; %s\n", "", text);
+					result.append(string_format("\t%50s; %s\n", "", text));
 			}
 			firstcomment = -1;
 		}
 	}
-	m_drcuml.log_printf("\n\n");
-	m_drcuml.log_flush();
+	return result.append("\n\n");
 }
 
 
@@ -15,6 +15,11 @@
 
 #include "drccache.h"
 #include "uml.h"
+#include "drcumlopt.h"
+#include "hashing.h"
+#include <functional>
+#include <set>
+#include <unordered_map>
 
 
 //**************************************************************************
@@ -31,6 +36,7 @@
 
 // opaque structure describing UML generation state
 class drcuml_state;
+class drc_verifier;
 
 
 // an integer register, with low/high parts
@@ -90,12 +96,19 @@ public:
 	drcuml_block *next() const { return m_next; }
 	bool inuse() const { return m_inuse; }
 	UINT32 maxinst() const { return m_maxinst; }
+	const std::vector<std::pair<offs_t, offs_t>> &code_ranges() const { return m_code_ranges; }
 
 	// code generation
 	void begin();
 	void end();
 	void abort();
 
+	// guest code covered by the block, for selective invalidation
+	void add_code_range(offs_t start, offs_t end);
+
+	// the block embeds host pointers as immediates, so it can't be persisted
+	void persist_exclude() { m_persist_exclude = true; }
+
 	// instruction appending
 	uml::instruction &append();
 	template <typename Format, typename... Params> void append_comment(Format &&fmt, Params &&... args);
@@ -110,7 +123,7 @@ public:
 private:
 	// internal helpers
 	void optimize();
-	void disassemble();
+	std::string disassemble();
 	const char *get_comment_text(const uml::instruction &inst, std::string &comment);
 
 	// internal state
@@ -120,6 +133,8 @@ private:
 	UINT32                  m_maxinst;          // maximum number of instructions
 	std::vector<uml::instruction> m_inst;     // pointer to the instruction list
 	bool                    m_inuse;            // this block is in use
+	std::vector<std::pair<offs_t, offs_t>> m_code_ranges; // guest code ranges compiled into the block
+	bool                    m_persist_exclude;  // keep this block out of the persistent cache
 };
 
 
@@ -136,6 +151,7 @@ public:
 	virtual int execute(uml::code_handle &entry) = 0;
 	virtual void generate(drcuml_block &block, const uml::instruction *instlist, UINT32 numinst) = 0;
 	virtual bool hash_exists(UINT32 mode, UINT32 pc) = 0;
+	virtual int invalidate_code(offs_t start, offs_t end) = 0;
 	virtual void get_info(drcbe_info &info) = 0;
 	virtual bool logging() const { return false; }
 
@@ -153,6 +169,8 @@ protected:
 // structure describing UML generation state
 class drcuml_state
 {
+	friend class drcuml_block;
+
 public:
 	// construction/destruction
 	drcuml_state(device_t &device, drc_cache &cache, UINT32 flags, int modes, int addrbits, int ignorebits);
@@ -169,9 +187,16 @@ public:
 	// code generation
 	drcuml_block *begin_block(UINT32 maxinst);
 
+	// persistent block cache
+	void persist_signature(UINT64 value);
+	void persist_region(const void *base, size_t length);
+	bool persist_restore(UINT32 mode, offs_t pc);
+
 	// back-end interface
 	void get_backend_info(drcbe_info &info) { m_beintf.get_info(info); }
 	bool hash_exists(UINT32 mode, UINT32 pc) { return m_beintf.hash_exists(mode, pc); }
+	int invalidate_code(offs_t start, offs_t end) { return m_beintf.invalidate_code(start, end); }
+	int invalidate_code_pages(const std::function<bool (offs_t start, offs_t end)> &filter);
 	void generate(drcuml_block &block, uml::instruction *instructions, UINT32 count) { m_beintf.generate(block, instructions, count); }
 
 	// handle management
@@ -184,9 +209,14 @@ public:
 	// logging
 	bool logging() const { return (m_umllog != nullptr); }
 	void log_printf(const char *format, ...) ATTR_PRINTF(2,3);
+	void log_optimizer_stats(const char *label, const drcuml_optimizer_stats &stats);
 	void log_flush() { if (logging()) fflush(m_umllog); }
 	bool logging_native() const { return m_beintf.logging(); }
 
+	// lockstep verification
+	void set_verifier(drc_verifier *verifier) { m_verifier = verifier; }
+	drc_verifier *verifier() const { return m_verifier; }
+
 private:
 	// symbol class
 	class symbol
@@ -213,15 +243,50 @@ private:
 		std::string             m_name;             // name of the symbol
 	};
 
+	// a block saved to the persistent cache
+	struct persist_record
+	{
+		UINT64                  signature;          // configuration the block was compiled under
+		sha1_t                  codehash;           // hash of the guest code it was compiled from
+		std::vector<std::pair<offs_t, offs_t>> ranges; // guest code ranges it covers
+		UINT32                  numinst;            // number of instructions
+		std::vector<UINT8>      data;               // encoded instruction stream
+		UINT32                  generation;         // last cache generation it was restored in
+	};
+
+	// guest code pages are tracked at the same granularity as in drc_hash_table
+	static const int CODE_PAGE_SHIFT = 12;
+
+	// persistent block cache helpers
+	void persist_capture(drcuml_block &block, const uml::instruction *instlist, UINT32 numinst);
+	bool persist_hash_code(const std::vector<std::pair<offs_t, offs_t>> &ranges, sha1_t &hash);
+	bool persist_encode(const uml::instruction &inst, std::vector<UINT8> &data);
+	bool persist_decode(const UINT8 *&data, const UINT8 *end, uml::instruction &inst);
+	std::string persist_filename() const;
+	void persist_load();
+	void persist_save();
+
 	// internal state
 	device_t &                  m_device;           // CPU device we are associated with
 	drc_cache &                 m_cache;            // pointer to the codegen cache
 	std::unique_ptr<drcbe_interface> m_drcbe_interface;
 	drcbe_interface &           m_beintf;           // backend interface pointer
 	FILE *                      m_umllog;           // handle to the UML logfile
+	drc_verifier *              m_verifier;         // lockstep verifier, if any
 	simple_list<drcuml_block>   m_blocklist;        // list of active blocks
 	simple_list<uml::code_handle> m_handlelist;     // list of active handles
 	simple_list<symbol>         m_symlist;          // list of symbols
+	drcuml_optimizer            m_optimizer;        // block optimizer
+	std::set<offs_t>            m_code_pages;       // guest code pages compiled since the last reset
+
+	// persistent block cache
+	bool                        m_persist;          // is the persistent cache enabled?
+	UINT64                      m_persist_signature; // signature of the current configuration, or 0
+	std::vector<std::pair<const UINT8 *, size_t>> m_persist_regions; // host memory that parameters may point into
+	UINT32                      m_persist_generation; // incremented on each reset
+	bool                        m_persist_restoring; // are we generating a restored block?
+	std::vector<uml::code_handle *> m_persist_handles; // handles by allocation order
+	std::unordered_map<UINT64, std::vector<persist_record>> m_persist_records; // records by mode and PC
 };
 
 
@@ -0,0 +1,561 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    drcumlopt.cpp
+
+    Block-level optimizer for the universal machine language.
+
+****************************************************************************
+
+    The optimizer runs a fixed sequence of passes over each block once
+    the front-end has finished appending to it:
+
+        - map variables are resolved to immediates
+        - flag liveness is computed backwards over the whole block,
+          following branches to local labels, and each instruction
+          only produces the flags that are consumed later
+        - known register constants are propagated forward into
+          instruction operands and the instructions simplified,
+          which folds fully-constant operations into moves
+        - loads from a memory slot whose value is already held in a
+          register or immediate are forwarded, and stores of a value
+          the slot already holds are dropped
+        - moves into registers that are overwritten before being read
+          are dropped
+
+    Registers are global state shared between blocks, so register
+    information never survives across labels, handles, calls or
+    anything else that can transfer control.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "drcumlopt.h"
+#include <unordered_map>
+
+using namespace uml;
+
+
+
+//**************************************************************************
+//  CONSTANTS
+//**************************************************************************
+
+const UINT8 ALL_FLAGS = FLAG_C | FLAG_V | FLAG_Z | FLAG_S | FLAG_U;
+const UINT32 ALL_IREGS = (1 << REG_I_COUNT) - 1;
+
+
+
+//**************************************************************************
+//  INLINE FUNCTIONS
+//**************************************************************************
+
+//-------------------------------------------------
+//  is_barrier - return true if register and
+//  memory knowledge cannot be carried past the
+//  given instruction
+//-------------------------------------------------
+
+static inline bool is_barrier(const instruction &inst)
+{
+	switch (inst.opcode())
+	{
+		case OP_HANDLE:
+		case OP_HASH:
+		case OP_LABEL:
+		case OP_DEBUG:
+		case OP_EXIT:
+		case OP_HASHJMP:
+		case OP_JMP:
+		case OP_EXH:
+		case OP_CALLH:
+		case OP_RET:
+		case OP_CALLC:
+		case OP_RECOVER:
+		case OP_SAVE:
+		case OP_RESTORE:
+			return true;
+
+		default:
+			return false;
+	}
+}
+
+
+//-------------------------------------------------
+//  can_propagate_into - return true if a constant
+//  may replace the given register operand
+//-------------------------------------------------
+
+static inline bool can_propagate_into(const instruction &inst, int pnum, UINT64 value)
+{
+	switch (inst.opcode())
+	{
+		// plain data movement and arithmetic
+		case OP_MOV:
+		case OP_SEXT:
+		case OP_ADD:
+		case OP_ADDC:
+		case OP_SUB:
+		case OP_SUBB:
+		case OP_CMP:
+		case OP_MULU:
+		case OP_MULS:
+		case OP_AND:
+		case OP_TEST:
+		case OP_OR:
+		case OP_XOR:
+		case OP_LZCNT:
+		case OP_BSWAP:
+		case OP_READ:
+		case OP_READM:
+		case OP_WRITE:
+		case OP_WRITEM:
+			return true;
+
+		// shift and rotate counts must stay in range, or folding would
+		// disagree with the hardware masking done by the back-ends
+		case OP_SHL:
+		case OP_SHR:
+		case OP_SAR:
+		case OP_ROL:
+		case OP_ROR:
+		case OP_ROLC:
+		case OP_RORC:
+		case OP_ROLAND:
+		case OP_ROLINS:
+			return (pnum != 2 || value < inst.size() * 8);
+
+		// everything else is left alone
+		default:
+			return false;
+	}
+}
+
+
+
+//**************************************************************************
+//  OPTIMIZER STATISTICS
+//**************************************************************************
+
+//-------------------------------------------------
+//  reset - clear all counters
+//-------------------------------------------------
+
+void drcuml_optimizer_stats::reset()
+{
+	blocks = 0;
+	instructions = 0;
+	flags_trimmed = 0;
+	consts_propagated = 0;
+	consts_folded = 0;
+	loads_forwarded = 0;
+	stores_removed = 0;
+	moves_removed = 0;
+	removed = 0;
+}
+
+
+//-------------------------------------------------
+//  operator+= - accumulate another set of
+//  counters
+//-------------------------------------------------
+
+drcuml_optimizer_stats &drcuml_optimizer_stats::operator+=(const drcuml_optimizer_stats &rhs)
+{
+	blocks += rhs.blocks;
+	instructions += rhs.instructions;
+	flags_trimmed += rhs.flags_trimmed;
+	consts_propagated += rhs.consts_propagated;
+	consts_folded += rhs.consts_folded;
+	loads_forwarded += rhs.loads_forwarded;
+	stores_removed += rhs.stores_removed;
+	moves_removed += rhs.moves_removed;
+	removed += rhs.removed;
+	return *this;
+}
+
+
+
+//**************************************************************************
+//  UML OPTIMIZER
+//**************************************************************************
+
+//-------------------------------------------------
+//  optimize - run all passes over a block of
+//  instructions
+//-------------------------------------------------
+
+UINT32 drcuml_optimizer::optimize(instruction *inst, UINT32 numinst)
+{
+	m_block.reset();
+	m_block.blocks = 1;
+	m_block.instructions = numinst;
+
+	// flags must be settled before anything is simplified
+	resolve_mapvars(inst, numinst);
+	eliminate_dead_flags(inst, numinst);
+	propagate_constants(inst, numinst);
+	forward_memory(inst, numinst);
+	remove_dead_moves(inst, numinst);
+	numinst = remove_nops(inst, numinst);
+
+	m_total += m_block;
+	return numinst;
+}
+
+
+//-------------------------------------------------
+//  resolve_mapvars - convert all map variable
+//  parameters to immediates
+//-------------------------------------------------
+
+void drcuml_optimizer::resolve_mapvars(instruction *inst, UINT32 numinst)
+{
+	UINT32 mapvar[MAPVAR_COUNT] = { 0 };
+
+	for (int instnum = 0; instnum < numinst; instnum++)
+	{
+		instruction &curinst = inst[instnum];
+
+		// track mapvars
+		if (curinst.opcode() == OP_MAPVAR)
+			mapvar[curinst.param(0).mapvar() - MAPVAR_M0] = curinst.param(1).immediate();
+
+		// convert all mapvar parameters to immediates
+		else if (curinst.opcode() != OP_RECOVER)
+			for (int pnum = 0; pnum < curinst.numparams(); pnum++)
+				if (curinst.param(pnum).is_mapvar())
+					curinst.set_mapvar(pnum, mapvar[curinst.param(pnum).mapvar() - MAPVAR_M0]);
+	}
+}
+
+
+//-------------------------------------------------
+//  eliminate_dead_flags - compute which flags are
+//  live after each instruction and only produce
+//  those
+//-------------------------------------------------
+
+void drcuml_optimizer::eliminate_dead_flags(instruction *inst, UINT32 numinst)
+{
+	// find where each local label lives
+	std::unordered_map<UINT32, UINT32> labels;
+	for (int instnum = 0; instnum < numinst; instnum++)
+		if (inst[instnum].opcode() == OP_LABEL)
+			labels[inst[instnum].param(0).label()] = instnum;
+
+	// flags live after an instruction come from wherever control can go next;
+	// flags are not passed to other blocks or back to the caller of a subroutine
+	auto liveout = [&](int instnum) -> UINT8
+	{
+		const instruction &curinst = inst[instnum];
+		UINT8 next = (curinst.condition() == COND_ALWAYS) ? 0 : m_livein[instnum + 1];
+		switch (curinst.opcode())
+		{
+			case OP_JMP:
+			{
+				auto target = labels.find(curinst.param(0).label());
+				return next | ((target != labels.end()) ? m_livein[target->second] : ALL_FLAGS);
+			}
+
+			case OP_EXIT:
+			case OP_HASHJMP:
+			case OP_RET:
+				return next;
+
+			default:
+				return m_livein[instnum + 1];
+		}
+	};
+
+	// iterate to a fixed point, since backward branches feed earlier code
+	m_livein.assign(numinst + 1, 0);
+	bool changed;
+	do
+	{
+		changed = false;
+		for (int instnum = numinst - 1; instnum >= 0; instnum--)
+		{
+			const instruction &curinst = inst[instnum];
+			UINT8 live = liveout(instnum);
+			if (curinst.condition() == COND_ALWAYS)
+				live &= ~curinst.modified_flags();
+			live |= curinst.input_flags();
+			if (live != m_livein[instnum])
+			{
+				m_livein[instnum] = live;
+				changed = true;
+			}
+		}
+	} while (changed);
+
+	// now only produce what is consumed
+	for (int instnum = 0; instnum < numinst; instnum++)
+	{
+		instruction &curinst = inst[instnum];
+		UINT8 produced = curinst.output_flags();
+		UINT8 needed = liveout(instnum) & produced;
+		if (needed != produced)
+			m_block.flags_trimmed++;
+		curinst.set_flags(needed);
+	}
+}
+
+
+//-------------------------------------------------
+//  propagate_constants - substitute registers
+//  holding known constants and simplify each
+//  instruction
+//-------------------------------------------------
+
+void drcuml_optimizer::propagate_constants(instruction *inst, UINT32 numinst)
+{
+	// bytes of each register known to hold a constant: 0, 4 (low half) or 8
+	UINT8 known[REG_I_COUNT] = { 0 };
+	UINT64 value[REG_I_COUNT];
+
+	for (int instnum = 0; instnum < numinst; instnum++)
+	{
+		instruction &curinst = inst[instnum];
+
+		// replace read-only register operands with their values
+		for (int pnum = 0; pnum < curinst.numparams(); pnum++)
+		{
+			const parameter &param = curinst.param(pnum);
+			if (!param.is_int_register() || curinst.param_is_output(pnum) || !curinst.param_allows(pnum, parameter::PTYPE_IMMEDIATE))
+				continue;
+			int regnum = param.ireg() - REG_I0;
+			if (known[regnum] == 0 || known[regnum] < curinst.param_size(pnum))
+				continue;
+			if (!can_propagate_into(curinst, pnum, value[regnum]))
+				continue;
+			curinst.set_param(pnum, value[regnum]);
+			m_block.consts_propagated++;
+		}
+
+		// simplify, noting anything that folded away to a constant
+		opcode_t origop = curinst.opcode();
+		curinst.simplify();
+		if (origop != OP_MOV && curinst.opcode() == OP_MOV && curinst.param(1).is_immediate())
+			m_block.consts_folded++;
+
+		// nothing is known about registers past a barrier
+		if (is_barrier(curinst))
+		{
+			memset(known, 0, sizeof(known));
+			continue;
+		}
+
+		// record constants moved into registers and forget anything else written
+		for (int pnum = 0; pnum < curinst.numparams(); pnum++)
+		{
+			const parameter &param = curinst.param(pnum);
+			if (!param.is_int_register() || !curinst.param_is_output(pnum))
+				continue;
+			int regnum = param.ireg() - REG_I0;
+			if (curinst.opcode() == OP_MOV && curinst.condition() == COND_ALWAYS && curinst.param(1).is_immediate())
+			{
+				known[regnum] = curinst.size();
+				value[regnum] = (curinst.size() == 4) ? UINT32(curinst.param(1).immediate()) : curinst.param(1).immediate();
+			}
+			else
+				known[regnum] = 0;
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  forward_memory - replace loads of memory slots
+//  whose contents are known, and drop stores that
+//  would not change them
+//-------------------------------------------------
+
+void drcuml_optimizer::forward_memory(instruction *inst, UINT32 numinst)
+{
+	m_memory.clear();
+
+	for (int instnum = 0; instnum < numinst; instnum++)
+	{
+		instruction &curinst = inst[instnum];
+
+		// calls and memory space accesses may touch anything
+		switch (curinst.opcode())
+		{
+			case OP_READ:
+			case OP_READM:
+			case OP_WRITE:
+			case OP_WRITEM:
+			case OP_STORE:
+			case OP_FSTORE:
+			case OP_FREAD:
+			case OP_FWRITE:
+				m_memory.clear();
+				break;
+
+			default:
+				if (is_barrier(curinst))
+					m_memory.clear();
+				break;
+		}
+
+		// unconditional integer moves between registers and memory
+		if (curinst.opcode() == OP_MOV && curinst.condition() == COND_ALWAYS)
+		{
+			const parameter dstp = curinst.param(0);
+			const parameter srcp = curinst.param(1);
+			UINT8 size = curinst.size();
+
+			// store: drop it if the slot already holds the value
+			if (dstp.is_memory() && (srcp.is_int_register() || srcp.is_immediate()))
+			{
+				const UINT8 *base = reinterpret_cast<const UINT8 *>(dstp.memory());
+				bool redundant = false;
+				for (const memory_value &slot : m_memory)
+					if (slot.base == base && slot.size == size && slot.value == srcp)
+						redundant = true;
+				if (redundant)
+				{
+					curinst.nop();
+					m_block.stores_removed++;
+					continue;
+				}
+				forget_memory(base, size);
+				m_memory.push_back(memory_value{ base, size, srcp });
+				continue;
+			}
+
+			// load: use the known value instead
+			if (dstp.is_int_register() && srcp.is_memory())
+			{
+				const UINT8 *base = reinterpret_cast<const UINT8 *>(srcp.memory());
+				for (const memory_value &slot : m_memory)
+					if (slot.base == base && slot.size == size)
+					{
+						curinst.set_param(1, slot.value);
+						curinst.simplify();
+						m_block.loads_forwarded++;
+						break;
+					}
+				forget_register(dstp);
+				if (curinst.opcode() == OP_MOV && curinst.param(1).is_memory())
+					m_memory.push_back(memory_value{ base, size, dstp });
+				continue;
+			}
+		}
+
+		// forget anything this instruction writes
+		for (int pnum = 0; pnum < curinst.numparams(); pnum++)
+		{
+			if (!curinst.param_is_output(pnum))
+				continue;
+			const parameter &param = curinst.param(pnum);
+			if (param.is_memory())
+				forget_memory(param.memory(), curinst.param_size(pnum));
+			else if (param.is_int_register())
+				forget_register(param);
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  remove_dead_moves - drop moves into registers
+//  that are overwritten before being read
+//-------------------------------------------------
+
+void drcuml_optimizer::remove_dead_moves(instruction *inst, UINT32 numinst)
+{
+	// every register is live at the end of the block
+	UINT32 live = ALL_IREGS;
+	for (int instnum = numinst - 1; instnum >= 0; instnum--)
+	{
+		instruction &curinst = inst[instnum];
+
+		// anything can be read past a barrier
+		if (is_barrier(curinst))
+		{
+			live = ALL_IREGS;
+			continue;
+		}
+
+		// drop unconditional moves to dead registers
+		if (curinst.opcode() == OP_MOV && curinst.condition() == COND_ALWAYS && curinst.param(0).is_int_register() &&
+			(live & (1 << (curinst.param(0).ireg() - REG_I0))) == 0)
+		{
+			curinst.nop();
+			m_block.moves_removed++;
+			continue;
+		}
+
+		// update liveness; a division by zero leaves its destinations alone
+		bool mayskip = (curinst.opcode() == OP_DIVU || curinst.opcode() == OP_DIVS);
+		UINT32 uses = 0, defs = 0;
+		for (int pnum = 0; pnum < curinst.numparams(); pnum++)
+		{
+			const parameter &param = curinst.param(pnum);
+			if (!param.is_int_register())
+				continue;
+			UINT32 bit = 1 << (param.ireg() - REG_I0);
+			if (curinst.param_is_input(pnum))
+				uses |= bit;
+			if (curinst.param_is_output(pnum) && curinst.condition() == COND_ALWAYS && !mayskip)
+				defs |= bit;
+		}
+		live = (live & ~defs) | uses;
+	}
+}
+
+
+//-------------------------------------------------
+//  remove_nops - compact the block, dropping any
+//  instructions that became no-ops
+//-------------------------------------------------
+
+UINT32 drcuml_optimizer::remove_nops(instruction *inst, UINT32 numinst)
+{
+	UINT32 outnum = 0;
+	for (int instnum = 0; instnum < numinst; instnum++)
+		if (inst[instnum].opcode() != OP_NOP)
+		{
+			if (outnum != instnum)
+				inst[outnum] = inst[instnum];
+			outnum++;
+		}
+	m_block.removed = numinst - outnum;
+	return outnum;
+}
+
+
+//-------------------------------------------------
+//  forget_memory - drop any knowledge of memory
+//  overlapping the given range
+//-------------------------------------------------
+
+void drcuml_optimizer::forget_memory(const void *base, UINT8 size)
+{
+	const UINT8 *start = reinterpret_cast<const UINT8 *>(base);
+	const UINT8 *end = start + size;
+	for (auto it = m_memory.begin(); it != m_memory.end(); )
+		if (it->base < end && start < it->base + it->size)
+			it = m_memory.erase(it);
+		else
+			++it;
+}
+
+
+//-------------------------------------------------
+//  forget_register - drop any memory slots known
+//  to match the given register
+//-------------------------------------------------
+
+void drcuml_optimizer::forget_register(const parameter &reg)
+{
+	for (auto it = m_memory.begin(); it != m_memory.end(); )
+		if (it->value == reg)
+			it = m_memory.erase(it);
+		else
+			++it;
+}
@@ -0,0 +1,90 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    drcumlopt.h
+
+    Block-level optimizer for the universal machine language.
+
+***************************************************************************/
+
+#pragma once
+
+#ifndef __DRCUMLOPT_H__
+#define __DRCUMLOPT_H__
+
+#include "uml.h"
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// ======================> drcuml_optimizer_stats
+
+// counts of what each optimizer pass changed
+struct drcuml_optimizer_stats
+{
+	drcuml_optimizer_stats() { reset(); }
+
+	void reset();
+	drcuml_optimizer_stats &operator+=(const drcuml_optimizer_stats &rhs);
+
+	UINT32              blocks;             // blocks optimized
+	UINT32              instructions;       // instructions seen
+	UINT32              flags_trimmed;      // instructions that stopped producing some flags
+	UINT32              consts_propagated;  // register operands replaced with immediates
+	UINT32              consts_folded;      // instructions folded down to an immediate move
+	UINT32              loads_forwarded;    // memory loads replaced with a register or immediate
+	UINT32              stores_removed;     // stores of a value already in memory
+	UINT32              moves_removed;      // moves whose result was never used
+	UINT32              removed;            // instructions dropped from the block
+};
+
+
+// ======================> drcuml_optimizer
+
+// applies a series of passes to a block of UML instructions
+class drcuml_optimizer
+{
+public:
+	// construction
+	drcuml_optimizer() { }
+
+	// getters
+	const drcuml_optimizer_stats &block_stats() const { return m_block; }
+	const drcuml_optimizer_stats &total_stats() const { return m_total; }
+
+	// optimize a block in place, returning the new instruction count
+	UINT32 optimize(uml::instruction *inst, UINT32 numinst);
+
+private:
+	// individual passes
+	void resolve_mapvars(uml::instruction *inst, UINT32 numinst);
+	void eliminate_dead_flags(uml::instruction *inst, UINT32 numinst);
+	void propagate_constants(uml::instruction *inst, UINT32 numinst);
+	void forward_memory(uml::instruction *inst, UINT32 numinst);
+	void remove_dead_moves(uml::instruction *inst, UINT32 numinst);
+	UINT32 remove_nops(uml::instruction *inst, UINT32 numinst);
+
+	// a remembered value of a memory slot
+	struct memory_value
+	{
+		const UINT8 *       base;               // start of the slot
+		UINT8               size;               // size of the slot
+		uml::parameter      value;              // register or immediate it holds
+	};
+
+	// internal helpers
+	void forget_memory(const void *base, UINT8 size);
+	void forget_register(const uml::parameter &reg);
+
+	// internal state
+	drcuml_optimizer_stats  m_block;            // stats for the most recent block
+	drcuml_optimizer_stats  m_total;            // stats over all blocks
+	std::vector<memory_value> m_memory;         // memory slots with known contents
+	std::vector<UINT8>      m_livein;           // scratch live-in flags per instruction
+};
+
+
+#endif /* __DRCUMLOPT_H__ */
@@ -0,0 +1,416 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    drcverify.cpp
+
+    Lockstep verification of a recompiler against its interpreter.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "emuopts.h"
+#include "drcverify.h"
+
+#include <algorithm>
+
+using namespace uml;
+
+
+
+//**************************************************************************
+//  GLOBAL VARIABLES
+//**************************************************************************
+
+std::vector<drc_verifier *> drc_verifier::s_verifiers;
+
+
+
+//**************************************************************************
+//  DRC VERIFIER
+//**************************************************************************
+
+//-------------------------------------------------
+//  drc_verifier - constructor
+//-------------------------------------------------
+
+drc_verifier::drc_verifier(device_t &cpu, drcuml_state &drcuml, address_space &space)
+	: m_cpu(cpu),
+		m_drcuml(drcuml),
+		m_space(space),
+		m_icount(nullptr),
+		m_params(nullptr),
+		m_mode(MODE_IDLE),
+		m_recording(false),
+		m_interrupted(false),
+		m_startpc(0),
+		m_replay_read(0),
+		m_compared(0)
+{
+	m_params = (callout_params *)m_drcuml.cache().alloc_near(sizeof(callout_params));
+	memset(m_params, 0, sizeof(*m_params));
+
+	s_verifiers.push_back(this);
+	m_drcuml.set_verifier(this);
+}
+
+
+//-------------------------------------------------
+//  ~drc_verifier - destructor
+//-------------------------------------------------
+
+drc_verifier::~drc_verifier()
+{
+	m_drcuml.set_verifier(nullptr);
+	s_verifiers.erase(std::remove(s_verifiers.begin(), s_verifiers.end(), this), s_verifiers.end());
+}
+
+
+//-------------------------------------------------
+//  requested - return true if verification is
+//  enabled; the debugger's breakpoints and
+//  memory edits would break the replay, so it
+//  is off while debugging
+//-------------------------------------------------
+
+bool drc_verifier::requested(device_t &cpu)
+{
+	return cpu.machine().options().drc_verify() && (cpu.machine().debug_flags & DEBUG_FLAG_ENABLED) == 0;
+}
+
+
+//-------------------------------------------------
+//  accessors - fill in a set of data accessors
+//  that route through the verifier, for
+//  interpreters that use them
+//-------------------------------------------------
+
+void drc_verifier::accessors(data_accessors &accessors)
+{
+	accessors.read_byte = &drc_verifier::read_byte;
+	accessors.read_word = &drc_verifier::read_word;
+	accessors.read_word_masked = &drc_verifier::read_word_masked;
+	accessors.read_dword = &drc_verifier::read_dword;
+	accessors.read_dword_masked = &drc_verifier::read_dword_masked;
+	accessors.read_qword = &drc_verifier::read_qword;
+	accessors.read_qword_masked = &drc_verifier::read_qword_masked;
+	accessors.write_byte = &drc_verifier::write_byte;
+	accessors.write_word = &drc_verifier::write_word;
+	accessors.write_word_masked = &drc_verifier::write_word_masked;
+	accessors.write_dword = &drc_verifier::write_dword;
+	accessors.write_dword_masked = &drc_verifier::write_dword_masked;
+	accessors.write_qword = &drc_verifier::write_qword;
+	accessors.write_qword_masked = &drc_verifier::write_qword_masked;
+}
+
+
+//-------------------------------------------------
+//  access_callout - return the callout that
+//  performs an access of the given kind
+//-------------------------------------------------
+
+c_function drc_verifier::access_callout(int size, bool write, bool masked)
+{
+	static const c_function callouts[4][2][2] =
+	{
+		{ { &static_access<1, false, false>, &static_access<1, false, true> }, { &static_access<1, true, false>, &static_access<1, true, true> } },
+		{ { &static_access<2, false, false>, &static_access<2, false, true> }, { &static_access<2, true, false>, &static_access<2, true, true> } },
+		{ { &static_access<4, false, false>, &static_access<4, false, true> }, { &static_access<4, true, false>, &static_access<4, true, true> } },
+		{ { &static_access<8, false, false>, &static_access<8, false, true> }, { &static_access<8, true, false>, &static_access<8, true, true> } }
+	};
+	int sizeindex = (size == 1) ? 0 : (size == 2) ? 1 : (size == 4) ? 2 : 3;
+	return callouts[sizeindex][write ? 1 : 0][masked ? 1 : 0];
+}
+
+
+//-------------------------------------------------
+//  block_start - called at the start of every
+//  recompiled code sequence
+//-------------------------------------------------
+
+void drc_verifier::block_start()
+{
+	// recompiled code doesn't keep the PC in memory, so set it from the boundary
+	set_pc(m_params->boundary_pc);
+
+	// check the stretch that just ended, unless an interrupt made it unrepeatable
+	if (m_recording && !m_interrupted)
+		verify();
+
+	// take the starting state for the next stretch
+	save_state(m_before);
+	m_startpc = m_params->boundary_pc;
+	m_reads.clear();
+	m_writes.clear();
+	m_recording = true;
+	m_interrupted = false;
+	m_mode = MODE_RECORD;
+}
+
+
+//-------------------------------------------------
+//  discard - drop the current stretch; accesses
+//  go straight to memory until the next boundary
+//-------------------------------------------------
+
+void drc_verifier::discard()
+{
+	m_interrupted = true;
+	m_mode = MODE_IDLE;
+	m_reads.clear();
+	m_writes.clear();
+}
+
+
+//-------------------------------------------------
+//  read - perform or replay a memory read
+//-------------------------------------------------
+
+UINT64 drc_verifier::read(int size, offs_t address, UINT64 mask)
+{
+	// the interpreter gets the recompiled code's reads back in order
+	if (m_mode == MODE_REPLAY && m_replay_read < m_reads.size())
+	{
+		const access &logged = m_reads[m_replay_read];
+		if (logged.size == size && logged.address == address && logged.mask == mask)
+		{
+			m_replay_read++;
+			return logged.data;
+		}
+	}
+
+	// anything else, such as an interpreter's instruction fetch, goes to memory
+	UINT64 data = memory_read(size, address, mask);
+
+	if (m_mode == MODE_RECORD)
+	{
+		access entry = { UINT8(size), address, data, mask };
+		m_reads.push_back(entry);
+	}
+	return data;
+}
+
+
+//-------------------------------------------------
+//  write - perform or capture a memory write
+//-------------------------------------------------
+
+void drc_verifier::write(int size, offs_t address, UINT64 data, UINT64 mask)
+{
+	access entry = { UINT8(size), address, data, mask };
+
+	// the interpreter's writes are only captured, so they don't happen twice
+	if (m_mode == MODE_REPLAY)
+	{
+		m_replay_writes.push_back(entry);
+		return;
+	}
+	if (m_mode == MODE_RECORD)
+		m_writes.push_back(entry);
+
+	memory_write(size, address, data, mask);
+}
+
+
+//-------------------------------------------------
+//  memory_read - read from the address space
+//-------------------------------------------------
+
+UINT64 drc_verifier::memory_read(int size, offs_t address, UINT64 mask)
+{
+	switch (size)
+	{
+		case 1:     return m_space.read_byte(address);
+		case 2:     return (mask == 0xffff) ? m_space.read_word(address) : m_space.read_word(address, mask);
+		case 4:     return (mask == 0xffffffff) ? m_space.read_dword(address) : m_space.read_dword(address, mask);
+		default:    return (mask == ~UINT64(0)) ? m_space.read_qword(address) : m_space.read_qword(address, mask);
+	}
+}
+
+
+//-------------------------------------------------
+//  memory_write - write to the address space
+//-------------------------------------------------
+
+void drc_verifier::memory_write(int size, offs_t address, UINT64 data, UINT64 mask)
+{
+	switch (size)
+	{
+		case 1:     m_space.write_byte(address, data);                                                                          break;
+		case 2:     if (mask == 0xffff) m_space.write_word(address, data); else m_space.write_word(address, data, mask);         break;
+		case 4:     if (mask == 0xffffffff) m_space.write_dword(address, data); else m_space.write_dword(address, data, mask);   break;
+		default:    if (mask == ~UINT64(0)) m_space.write_qword(address, data); else m_space.write_qword(address, data, mask);  break;
+	}
+}
+
+
+//-------------------------------------------------
+//  block_generated - remember the UML and native
+//  code of a block for mismatch reports
+//-------------------------------------------------
+
+void drc_verifier::block_generated(const instruction *instlist, UINT32 numinst, std::string &&disasm, drccodeptr codestart, drccodeptr codeend)
+{
+	auto record = std::make_shared<block_record>();
+	record->disasm = std::move(disasm);
+	record->codestart = codestart;
+	record->codeend = codeend;
+
+	// file it under every PC the block can be entered at
+	for (UINT32 inum = 0; inum < numinst; inum++)
+		if (instlist[inum].opcode() == OP_HASH)
+			m_blocks[instlist[inum].param(1).immediate()] = record;
+}
+
+
+//-------------------------------------------------
+//  cache_reset - forget all generated blocks
+//-------------------------------------------------
+
+void drc_verifier::cache_reset()
+{
+	m_blocks.clear();
+}
+
+
+//-------------------------------------------------
+//  verify - replay the stretch that just ended on
+//  the interpreter and compare the results
+//-------------------------------------------------
+
+void drc_verifier::verify()
+{
+	std::vector<UINT64> drcregs, intregs;
+
+	// put the recompiled state aside and rewind to the start of the stretch
+	capture_registers(drcregs);
+	save_state(m_after);
+	restore_state(m_before);
+
+	// step the interpreter until it reaches the same boundary
+	m_mode = MODE_REPLAY;
+	m_replay_read = 0;
+	m_replay_writes.clear();
+	int steps = 0;
+	do
+	{
+		step();
+		steps++;
+	} while (pc() != m_params->boundary_pc && steps < MAX_STEPS);
+	m_mode = MODE_IDLE;
+	capture_registers(intregs);
+
+	// any difference in registers, writes, or reads consumed is a mismatch
+	if (pc() != m_params->boundary_pc || intregs != drcregs || m_replay_writes != m_writes || m_replay_read != m_reads.size())
+		report(steps, drcregs, intregs);
+
+	// carry on from the recompiled state
+	restore_state(m_after);
+	m_compared++;
+}
+
+
+//-------------------------------------------------
+//  compared - return true if a state entry takes
+//  part in the comparison: everything the
+//  debugger shows, less the ignored registers,
+//  plus any hidden ones asked for
+//-------------------------------------------------
+
+bool drc_verifier::compared(const device_state_entry &entry) const
+{
+	if (entry.divider())
+		return false;
+	if (std::find(m_extra.begin(), m_extra.end(), entry.index()) != m_extra.end())
+		return true;
+	return entry.visible() && std::find(m_ignored.begin(), m_ignored.end(), entry.index()) == m_ignored.end();
+}
+
+
+//-------------------------------------------------
+//  capture_registers - read every compared
+//  register through the state interface
+//-------------------------------------------------
+
+void drc_verifier::capture_registers(std::vector<UINT64> &values)
+{
+	values.clear();
+	for (auto &entry : m_cpu.state().state_entries())
+		if (compared(*entry))
+			values.push_back(m_cpu.state().state_int(entry->index()));
+	if (m_icount != nullptr)
+		values.push_back(*m_icount);
+}
+
+
+//-------------------------------------------------
+//  report - write out everything known about a
+//  mismatch and stop
+//-------------------------------------------------
+
+void drc_verifier::report(int steps, const std::vector<UINT64> &drcregs, const std::vector<UINT64> &intregs)
+{
+	FILE *file = fopen("drcverify.log", "w");
+	if (file != nullptr)
+	{
+		fputs(string_format("%s: recompiler and interpreter differ between %08X and %08X\n", m_cpu.tag(), m_startpc, m_params->boundary_pc).c_str(), file);
+		fputs(string_format("the interpreter stopped at %08X after %d steps; %d earlier stretches matched\n\n", pc(), steps, m_compared).c_str(), file);
+
+		// registers, flagging the ones that differ
+		fputs(string_format("%-12s%-20s%-20s\n", "register", "recompiler", "interpreter").c_str(), file);
+		int regnum = 0;
+		for (auto &entry : m_cpu.state().state_entries())
+			if (compared(*entry))
+			{
+				fputs(string_format("%-12s%016X    %016X%s\n", entry->symbol(), drcregs[regnum], intregs[regnum], (drcregs[regnum] != intregs[regnum]) ? "    <--" : "").c_str(), file);
+				regnum++;
+			}
+		if (m_icount != nullptr)
+			fputs(string_format("%-12s%-20d%-20d%s\n", "cycles left", int(drcregs[regnum]), int(intregs[regnum]), (drcregs[regnum] != intregs[regnum]) ? "<--" : "").c_str(), file);
+
+		// both write logs
+		const std::vector<access> *logs[2] = { &m_writes, &m_replay_writes };
+		for (int lognum = 0; lognum < 2; lognum++)
+		{
+			fputs(string_format("\n%s writes:\n", (lognum == 0) ? "recompiler" : "interpreter").c_str(), file);
+			for (const access &entry : *logs[lognum])
+				fputs(string_format("  %08X  %d bytes  data=%016X  mask=%016X\n", entry.address, entry.size, entry.data, entry.mask).c_str(), file);
+		}
+		fputs(string_format("\nthe interpreter consumed %d of %d logged reads\n", int(m_replay_read), int(m_reads.size())).c_str(), file);
+
+		// the UML and native code of the block the stretch started in
+		auto found = m_blocks.find(m_startpc);
+		if (found != m_blocks.end())
+		{
+			const block_record &record = *found->second;
+			fputs("\nUML:\n", file);
+			fputs(record.disasm.c_str(), file);
+			fputs(string_format("\nnative code (%d bytes at %p):\n", int(record.codeend - record.codestart), record.codestart).c_str(), file);
+			for (drccodeptr ptr = record.codestart; ptr < record.codeend; ptr += 16)
+			{
+				std::string line = string_format("  %p:", ptr);
+				for (drccodeptr byte = ptr; byte < ptr + 16 && byte < record.codeend; byte++)
+					line.append(string_format(" %02X", *byte));
+				fputs(line.append("\n").c_str(), file);
+			}
+		}
+		else
+			fputs(string_format("\nno generated block starts at %08X\n", m_startpc).c_str(), file);
+		fclose(file);
+	}
+
+	fatalerror("%s: recompiler and interpreter differ between %08X and %08X; see drcverify.log\n", m_cpu.tag(), m_startpc, m_params->boundary_pc);
+}
+
+
+//-------------------------------------------------
+//  find - find the verifier for an address space
+//-------------------------------------------------
+
+drc_verifier &drc_verifier::find(address_space &space)
+{
+	for (drc_verifier *verifier : s_verifiers)
+		if (&verifier->m_space == &space)
+			return *verifier;
+	fatalerror("No DRC verifier for address space %s\n", space.name());
+}
@@ -0,0 +1,242 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    drcverify.h
+
+    Lockstep verification of a recompiler against its interpreter.
+
+****************************************************************************
+
+    Concepts:
+
+    When verification is enabled, the recompiler calls block_start() at
+    the start of every code sequence it generates, and routes all of its
+    memory accesses through the verifier.  Between two boundaries, the
+    verifier records every read and write the recompiled code makes.
+
+    At the next boundary, the state left by the recompiled code is put
+    aside, the state from the previous boundary is restored, and the
+    interpreter is stepped until it reaches the same PC.  While it runs,
+    its reads are answered from the log in order and its writes are
+    captured rather than performed, so no memory side effects happen
+    twice.  The two register sets (as seen through device_state_interface)
+    and the two write logs are then compared, and the recompiled state is
+    put back.
+
+    The first mismatch writes a report containing both register sets,
+    both write logs, and the UML and native code of the block that ran,
+    and then stops emulation.
+
+    Interrupts are asynchronous, so a stretch in which the recompiled
+    code took one is not compared; the core reports these through
+    interrupt().  Cores that hand the rest of a timeslice to their plain
+    interpreter drop the current stretch through discard(), since that
+    can run for longer than a replay is allowed to.
+
+    Cores whose recompiler charges cycles exactly as the interpreter
+    does can have the cycles left compared too, through
+    compare_cycles().  The scheduler refills the cycle count between
+    timeslices, so such cores discard() at the start of each one.
+
+***************************************************************************/
+
+#pragma once
+
+#ifndef __DRCVERIFY_H__
+#define __DRCVERIFY_H__
+
+#include "drcuml.h"
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// ======================> drc_verifier
+
+// cores derive from this to provide state snapshots and interpreter stepping
+class drc_verifier
+{
+public:
+	// construction/destruction
+	drc_verifier(device_t &cpu, drcuml_state &drcuml, address_space &space);
+	virtual ~drc_verifier();
+
+	// true if verification was asked for and can run
+	static bool requested(device_t &cpu);
+
+	// configuration
+	void ignore_register(int index) { m_ignored.push_back(index); }
+	void compare_register(int index) { m_extra.push_back(index); }
+	void compare_cycles(const int &icount) { m_icount = &icount; }
+	void accessors(data_accessors &accessors);
+
+	// parameters written by generated code before calling out
+	UINT32 *boundary_pc() { return &m_params->boundary_pc; }
+	UINT32 *access_address() { return &m_params->access_address; }
+	UINT64 *access_data() { return &m_params->access_data; }
+	UINT64 *access_mask() { return &m_params->access_mask; }
+
+	// callouts from generated code
+	static void static_block_start(void *param) { reinterpret_cast<drc_verifier *>(param)->block_start(); }
+	static void static_interrupt(void *param) { reinterpret_cast<drc_verifier *>(param)->interrupt(); }
+	template<int Size, bool Write, bool Masked> static void static_access(void *param);
+	static uml::c_function access_callout(int size, bool write, bool masked);
+
+	// boundaries and interrupts
+	void block_start();
+	void interrupt() { m_interrupted = true; }
+	void discard();
+
+	// memory accesses from either side
+	UINT64 read(int size, offs_t address, UINT64 mask);
+	void write(int size, offs_t address, UINT64 data, UINT64 mask);
+
+	// notifications from drcuml_state
+	void block_generated(const uml::instruction *instlist, UINT32 numinst, std::string &&disasm, drccodeptr codestart, drccodeptr codeend);
+	void cache_reset();
+
+protected:
+	// core-specific overrides
+	virtual void save_state(std::vector<UINT8> &buffer) = 0;
+	virtual void restore_state(const std::vector<UINT8> &buffer) = 0;
+	virtual offs_t pc() = 0;
+	virtual void set_pc(offs_t pc) = 0;
+	virtual void step() = 0;
+
+	// accesses that reach memory; cores whose interpreter doesn't make
+	// plain address space accesses override these
+	virtual UINT64 memory_read(int size, offs_t address, UINT64 mask);
+	virtual void memory_write(int size, offs_t address, UINT64 data, UINT64 mask);
+
+	// helpers for derived classes
+	template<typename T> static void save_item(std::vector<UINT8> &buffer, const T &item)
+	{
+		const UINT8 *data = reinterpret_cast<const UINT8 *>(&item);
+		buffer.insert(buffer.end(), data, data + sizeof(item));
+	}
+	template<typename T> static void restore_item(const UINT8 *&data, T &item)
+	{
+		memcpy(&item, data, sizeof(item));
+		data += sizeof(item);
+	}
+
+private:
+	// the most interpreter steps allowed to reach the next boundary
+	static const int MAX_STEPS = 100000;
+
+	// what memory accesses are doing right now
+	enum access_mode
+	{
+		MODE_IDLE,                                      // accesses go straight to memory
+		MODE_RECORD,                                    // recompiled code: perform and log
+		MODE_REPLAY                                     // interpreter: reads from the log, writes captured
+	};
+
+	// parameters shared with generated code; these live in the near part of
+	// the code cache, where back-ends can address them directly
+	struct callout_params
+	{
+		UINT32              boundary_pc;                // PC of the boundary being crossed
+		UINT32              access_address;             // address of a generated-code access
+		UINT64              access_data;                // data of a generated-code access
+		UINT64              access_mask;                // mask of a generated-code access
+	};
+
+	// a logged memory access
+	struct access
+	{
+		UINT8               size;                       // size in bytes
+		offs_t              address;                    // byte address
+		UINT64              data;                       // data read or written
+		UINT64              mask;                       // access mask
+
+		bool operator==(const access &rhs) const { return size == rhs.size && address == rhs.address && data == rhs.data && mask == rhs.mask; }
+		bool operator!=(const access &rhs) const { return !(*this == rhs); }
+	};
+
+	// a generated block, kept for mismatch reports
+	struct block_record
+	{
+		std::string         disasm;                     // UML disassembly
+		drccodeptr          codestart;                  // start of the native code
+		drccodeptr          codeend;                    // end of the native code
+	};
+
+	// internal helpers
+	void verify();
+	bool compared(const device_state_entry &entry) const;
+	void capture_registers(std::vector<UINT64> &values);
+	void report(int steps, const std::vector<UINT64> &drcregs, const std::vector<UINT64> &intregs);
+	static UINT64 size_mask(int size) { return (size == 8) ? ~UINT64(0) : ((UINT64(1) << (size * 8)) - 1); }
+	static drc_verifier &find(address_space &space);
+
+	// data_accessors thunks for interpreters that go through them
+	static UINT8 read_byte(address_space &space, offs_t address) { return find(space).read(1, address, 0xff); }
+	static UINT16 read_word(address_space &space, offs_t address) { return find(space).read(2, address, 0xffff); }
+	static UINT16 read_word_masked(address_space &space, offs_t address, UINT16 mask) { return find(space).read(2, address, mask); }
+	static UINT32 read_dword(address_space &space, offs_t address) { return find(space).read(4, address, 0xffffffff); }
+	static UINT32 read_dword_masked(address_space &space, offs_t address, UINT32 mask) { return find(space).read(4, address, mask); }
+	static UINT64 read_qword(address_space &space, offs_t address) { return find(space).read(8, address, ~UINT64(0)); }
+	static UINT64 read_qword_masked(address_space &space, offs_t address, UINT64 mask) { return find(space).read(8, address, mask); }
+	static void write_byte(address_space &space, offs_t address, UINT8 data) { find(space).write(1, address, data, 0xff); }
+	static void write_word(address_space &space, offs_t address, UINT16 data) { find(space).write(2, address, data, 0xffff); }
+	static void write_word_masked(address_space &space, offs_t address, UINT16 data, UINT16 mask) { find(space).write(2, address, data, mask); }
+	static void write_dword(address_space &space, offs_t address, UINT32 data) { find(space).write(4, address, data, 0xffffffff); }
+	static void write_dword_masked(address_space &space, offs_t address, UINT32 data, UINT32 mask) { find(space).write(4, address, data, mask); }
+	static void write_qword(address_space &space, offs_t address, UINT64 data) { find(space).write(8, address, data, ~UINT64(0)); }
+	static void write_qword_masked(address_space &space, offs_t address, UINT64 data, UINT64 mask) { find(space).write(8, address, data, mask); }
+
+	// internal state
+	device_t &                  m_cpu;                  // CPU device being verified
+	drcuml_state &              m_drcuml;               // UML state of its recompiler
+	address_space &             m_space;                // address space accesses are made in
+	std::vector<int>            m_ignored;              // state indices not compared
+	std::vector<int>            m_extra;                // hidden state indices that are compared
+	const int *                 m_icount;               // cycle count compared, if any
+
+	callout_params *            m_params;               // parameters written by generated code
+
+	access_mode                 m_mode;                 // current memory access mode
+	bool                        m_recording;            // true once a starting state is held
+	bool                        m_interrupted;          // true if the recompiled code took an interrupt
+	offs_t                      m_startpc;              // PC of the starting boundary
+	std::vector<UINT8>          m_before;               // state at the starting boundary
+	std::vector<UINT8>          m_after;                // recompiled state at the ending boundary
+	std::vector<access>         m_reads;                // reads made by the recompiled code
+	std::vector<access>         m_writes;               // writes made by the recompiled code
+	std::vector<access>         m_replay_writes;        // writes made by the interpreter
+	size_t                      m_replay_read;          // next logged read to hand to the interpreter
+	UINT64                      m_compared;             // number of stretches compared
+
+	std::unordered_map<offs_t, std::shared_ptr<block_record>> m_blocks; // generated blocks by entry PC
+
+	static std::vector<drc_verifier *> s_verifiers;     // live verifiers, for the accessor thunks
+};
+
+
+//**************************************************************************
+//  INLINE FUNCTIONS
+//**************************************************************************
+
+//-------------------------------------------------
+//  static_access - perform a memory access on
+//  behalf of generated code, which has stored
+//  the operands in the access_* parameters
+//-------------------------------------------------
+
+template<int Size, bool Write, bool Masked>
+void drc_verifier::static_access(void *param)
+{
+	drc_verifier &verifier = *reinterpret_cast<drc_verifier *>(param);
+	callout_params &params = *verifier.m_params;
+	UINT64 mask = Masked ? (params.access_mask & size_mask(Size)) : size_mask(Size);
+	if (Write)
+		verifier.write(Size, params.access_address, params.access_data & size_mask(Size), mask);
+	else
+		params.access_data = verifier.read(Size, params.access_address, mask);
+}
+
+
+#endif /* __DRCVERIFY_H__ */
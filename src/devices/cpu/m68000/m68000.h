@@ -10,6 +10,10 @@
 
 #include "softfloat/milieu.h"
 #include "softfloat/softfloat.h"
+#include "cpu/drcfe.h"
+#include "cpu/drcuml.h"
+#include "cpu/drcumlsh.h"
+#include "cpu/drcverify.h"
 
 
 /* MMU constants */
@@ -116,6 +120,7 @@ enum
 unsigned int m68k_disassemble_raw(char* str_buff, unsigned int pc, const unsigned char* opdata, const unsigned char* argdata, unsigned int cpu_type);
 
 class m68000_base_device;
+class m68k_frontend;
 
 
 extern const device_type M68K;
@@ -395,6 +400,93 @@ public:
 
 	// device_memory_interface overrides
 	virtual bool memory_translate(address_spacenum space, int intention, offs_t &address) override;
+
+private:
+	friend class m68k_frontend;
+
+	/* registers and flags the recompiled code works on; kept in the DRC cache so the backend can reach them */
+	struct drc_state
+	{
+		UINT32  dar[16];
+		UINT32  pc;
+		UINT32  x_flag;
+		UINT32  n_flag;
+		UINT32  not_z_flag;
+		UINT32  v_flag;
+		UINT32  c_flag;
+		INT32   icount;
+		UINT32  runend;         /* end of the run of instructions handed to the interpreter */
+		UINT32  exit;           /* set by interpreted instructions that need to leave the recompiler */
+	};
+
+	/* internal compiler state */
+	struct compiler_state
+	{
+		UINT32          cycles;                     /* accumulated cycles */
+		uml::code_label labelnum;                   /* index for local labels */
+		offs_t          runstart;                   /* start of the last run of interpreted instructions */
+		offs_t          runend;                     /* end of the last run of interpreted instructions */
+	};
+
+	bool                            m_isdrc;
+	std::unique_ptr<drc_cache>      m_drccache;     /* DRC code cache, allocated only when the recompiler is in use */
+	std::unique_ptr<drcuml_state>   m_drcuml;       /* DRC UML generator state */
+	std::unique_ptr<m68k_frontend>  m_drcfe;        /* DRC front-end state */
+	bool                            m_drc_dirty;    /* true if we need to flush the cache */
+	drc_state *                     m_drcstate;     /* state shared with the recompiled code */
+
+	uml::code_handle *              m_entry;        /* entry point */
+	uml::code_handle *              m_nocode;       /* nocode exception handler */
+	uml::code_handle *              m_out_of_cycles; /* out of cycles exception handler */
+
+	void drc_init();
+	bool drc_can_run() const;
+	bool execute_run_drc();
+	void drc_capture_state(drc_state &state) const;
+	void drc_restore_state(const drc_state &state);
+	offs_t drc_disassemble(char *buffer, offs_t pc, const UINT16 *words);
+
+public:
+	void func_interpret();
+
+	/* lockstep verification against the interpreter; the memory helpers in m68kcpu.h route through it */
+	class verifier : public drc_verifier
+	{
+	public:
+		verifier(m68000_base_device &cpu);
+
+	protected:
+		virtual void save_state(std::vector<UINT8> &buffer) override;
+		virtual void restore_state(const std::vector<UINT8> &buffer) override;
+		virtual offs_t pc() override { return m_m68k.pc; }
+		virtual void set_pc(offs_t pc) override;
+		virtual void step() override;
+		virtual UINT64 memory_read(int size, offs_t address, UINT64 mask) override;
+		virtual void memory_write(int size, offs_t address, UINT64 data, UINT64 mask) override;
+
+	private:
+		m68000_base_device &    m_m68k;
+	};
+	std::unique_ptr<verifier> m_verifier;
+
+private:
+	void code_flush_cache();
+	void code_compile_block(offs_t pc);
+	void alloc_handle(uml::code_handle **handleptr, const char *name);
+	void static_generate_entry_point();
+	void static_generate_nocode_handler();
+	void static_generate_out_of_cycles();
+	void log_opcode_desc(const opcode_desc *desclist);
+	void log_add_disasm_comment(drcuml_block *block, const opcode_desc *desc);
+	void generate_update_cycles(drcuml_block *block, compiler_state *compiler, uml::parameter param, bool allow_exception);
+	void generate_checksum_block(drcuml_block *block, compiler_state *compiler, const opcode_desc *seqhead, const opcode_desc *seqlast);
+	void generate_sequence_instruction(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
+	void generate_interpret(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
+	void generate_condition(drcuml_block *block, int cond);
+	void generate_logic_flags(drcuml_block *block);
+	void generate_arith_flags(drcuml_block *block, bool setx);
+	void generate_branch(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
+	void generate_opcode(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
 };
 
 
@@ -762,6 +854,25 @@ public:
 };
 
 
+class m68k_frontend : public drc_frontend
+{
+public:
+	m68k_frontend(m68000_base_device *device, UINT32 window_start, UINT32 window_end, UINT32 max_sequence);
+
+	/* userflags for instructions that are compiled rather than handed to the interpreter */
+	static const UINT32 USERFLAG_NATIVE = 0x0001;
+
+protected:
+	virtual bool describe(opcode_desc &desc, const opcode_desc *prev) override;
+
+private:
+	bool describe_native(opcode_desc &desc, UINT16 opcode);
+	bool code_is_fixed(offs_t start, offs_t end);
+
+	m68000_base_device *m_m68k;
+};
+
+
 extern const device_type M68000;
 extern const device_type M68301;
 extern const device_type M68008;
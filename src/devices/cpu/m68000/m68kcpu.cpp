@@ -995,6 +995,7 @@ void m68000_base_device::init_cpu_common(void)
 	m_icountptr = &remaining_cycles;
 	remaining_cycles = 0;
 
+	drc_init();
 }
 
 void m68000_base_device::reset_cpu(void)
@@ -2224,6 +2225,10 @@ void m68000_base_device::m68ki_exception_interrupt(m68000_base_device *m68k, UIN
 	else if(vector > 255)
 		return;
 
+	/* a taken interrupt can't be replayed, so tell the verifier */
+	if (m_verifier != nullptr)
+		m_verifier->interrupt();
+
 	/* Start exception processing */
 	sr = m68ki_init_exception(m68k);
 
@@ -2420,6 +2425,13 @@ void m68000_base_device::clear_all()
 
 void m68000_base_device::execute_run()
 {
+	/* the recompiler hands anything it can't run back to the interpreter */
+	if (m_isdrc && execute_run_drc())
+		return;
+
+	/* nor can the verifier replay a whole timeslice */
+	if (m_verifier != nullptr)
+		m_verifier->discard();
 	cpu_execute();
 }
 
@@ -2434,6 +2446,7 @@ void m68000_base_device::device_reset()
 
 void m68000_base_device::device_stop()
 {
+	m_verifier = nullptr;
 }
 
 
@@ -793,6 +793,8 @@ static inline UINT32 m68ki_read_8_fc(m68000_base_device *m68k, UINT32 address, U
 {
 	m68k->mmu_tmp_fc = fc;
 	m68k->mmu_tmp_rw = 1;
+	if (m68k->m_verifier != nullptr)
+		return m68k->m_verifier->read(1, address, 0xff);
 	return m68k->/*memory.*/read8(address);
 }
 static inline UINT32 m68ki_read_16_fc(m68000_base_device *m68k, UINT32 address, UINT32 fc)
@@ -803,6 +805,8 @@ static inline UINT32 m68ki_read_16_fc(m68000_base_device *m68k, UINT32 address,
 	}
 	m68k->mmu_tmp_fc = fc;
 	m68k->mmu_tmp_rw = 1;
+	if (m68k->m_verifier != nullptr)
+		return m68k->m_verifier->read(2, address, 0xffff);
 	return m68k->/*memory.*/read16(address);
 }
 static inline UINT32 m68ki_read_32_fc(m68000_base_device *m68k, UINT32 address, UINT32 fc)
@@ -813,6 +817,8 @@ static inline UINT32 m68ki_read_32_fc(m68000_base_device *m68k, UINT32 address,
 	}
 	m68k->mmu_tmp_fc = fc;
 	m68k->mmu_tmp_rw = 1;
+	if (m68k->m_verifier != nullptr)
+		return m68k->m_verifier->read(4, address, 0xffffffff);
 	return m68k->/*memory.*/read32(address);
 }
 
@@ -820,7 +826,10 @@ static inline void m68ki_write_8_fc(m68000_base_device *m68k, UINT32 address, UI
 {
 	m68k->mmu_tmp_fc = fc;
 	m68k->mmu_tmp_rw = 0;
-	m68k->/*memory.*/write8(address, value);
+	if (m68k->m_verifier != nullptr)
+		m68k->m_verifier->write(1, address, value & 0xff, 0xff);
+	else
+		m68k->/*memory.*/write8(address, value);
 }
 static inline void m68ki_write_16_fc(m68000_base_device *m68k, UINT32 address, UINT32 fc, UINT32 value)
 {
@@ -830,7 +839,10 @@ static inline void m68ki_write_16_fc(m68000_base_device *m68k, UINT32 address, U
 	}
 	m68k->mmu_tmp_fc = fc;
 	m68k->mmu_tmp_rw = 0;
-	m68k->/*memory.*/write16(address, value);
+	if (m68k->m_verifier != nullptr)
+		m68k->m_verifier->write(2, address, value & 0xffff, 0xffff);
+	else
+		m68k->/*memory.*/write16(address, value);
 }
 static inline void m68ki_write_32_fc(m68000_base_device *m68k, UINT32 address, UINT32 fc, UINT32 value)
 {
@@ -840,7 +852,10 @@ static inline void m68ki_write_32_fc(m68000_base_device *m68k, UINT32 address, U
 	}
 	m68k->mmu_tmp_fc = fc;
 	m68k->mmu_tmp_rw = 0;
-	m68k->/*memory.*/write32(address, value);
+	if (m68k->m_verifier != nullptr)
+		m68k->m_verifier->write(4, address, value, 0xffffffff);
+	else
+		m68k->/*memory.*/write32(address, value);
 }
 
 /* Special call to simulate undocumented 68k behavior when move.l with a
@@ -856,6 +871,12 @@ static inline void m68ki_write_32_pd_fc(m68000_base_device *m68k, UINT32 address
 	}
 	m68k->mmu_tmp_fc = fc;
 	m68k->mmu_tmp_rw = 0;
+	if (m68k->m_verifier != nullptr)
+	{
+		m68k->m_verifier->write(2, address+2, value>>16, 0xffff);
+		m68k->m_verifier->write(2, address, value&0xffff, 0xffff);
+		return;
+	}
 	m68k->/*memory.*/write16(address+2, value>>16);
 	m68k->/*memory.*/write16(address, value&0xffff);
 }
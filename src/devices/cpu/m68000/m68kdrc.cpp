@@ -0,0 +1,1197 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    m68kdrc.cpp
+
+    Universal machine language-based 680x0 recompiler.
+
+    The recompiler runs alongside the interpreter rather than replacing
+    it: the instructions the front end marks as native are compiled to
+    UML, and each run of other instructions is handed to the interpreter's
+    own handlers in a single call.  Whenever the CPU is in a state the
+    recompiler doesn't model (stopped, tracing, an MMU enabled, an address
+    error pending, or the debugger active) the rest of the timeslice is
+    left to the interpreter.
+
+    It is still experimental, so it is only used with -drc_experimental.
+
+    With -drc_verify, every stretch between sequence heads is replayed
+    on the interpreter by a drc_verifier, as for the MIPS III and SH-2
+    recompilers.  Interpreted runs go through the memory helpers, so
+    their accesses are logged and replayed like those of native code.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "emuopts.h"
+#include "debugger.h"
+#include "m68kcpu.h"
+
+using namespace uml;
+
+
+/***************************************************************************
+    CONSTANTS
+***************************************************************************/
+
+/* size of the execution code cache; most code is handed to the interpreter, so this is plenty */
+#define CACHE_SIZE                      (4 * 1024 * 1024)
+
+/* compilation boundaries -- how far back/forward does the analysis extend? */
+#define COMPILE_BACKWARDS_BYTES         128
+#define COMPILE_FORWARDS_BYTES          512
+#define COMPILE_MAX_SEQUENCE            64
+
+/* exit codes */
+#define EXECUTE_OUT_OF_CYCLES           0
+#define EXECUTE_MISSING_CODE            1
+#define EXECUTE_INTERPRET               2
+
+
+/***************************************************************************
+    MACROS
+***************************************************************************/
+
+#define DAR32(reg)      mem(&m_drcstate->dar[reg])
+#define D32(reg)        DAR32(reg)
+#define A32(reg)        DAR32(8 + (reg))
+#define FLAG(name)      mem(&m_drcstate->name)
+
+
+/***************************************************************************
+    C CALLBACKS
+***************************************************************************/
+
+static void cfunc_interpret(void *param)
+{
+	((m68000_base_device *)param)->func_interpret();
+}
+
+
+
+/***************************************************************************
+    CORE CALLBACKS
+***************************************************************************/
+
+/*-------------------------------------------------
+    drc_init - set up the recompiler if it is
+    enabled for this CPU
+-------------------------------------------------*/
+
+void m68000_base_device::drc_init()
+{
+	/* the 8-bit bus of the 68008 splits opcodes, so code validation can't use direct pointers */
+	m_isdrc = allow_drc() && mconfig().options().drc_experimental() && program->data_width() >= 16;
+	m_drc_dirty = true;
+	m_entry = nullptr;
+	m_nocode = nullptr;
+	m_out_of_cycles = nullptr;
+	if (!m_isdrc)
+		return;
+
+	/* allocate the cache and the state the generated code works on */
+	m_drccache = std::make_unique<drc_cache>(CACHE_SIZE + sizeof(drc_state));
+	m_drcstate = (drc_state *)m_drccache->alloc_near(sizeof(drc_state));
+	memset(m_drcstate, 0, sizeof(*m_drcstate));
+
+	/* initialize the UML generator */
+	m_drcuml = std::make_unique<drcuml_state>(*this, *m_drccache, 0, 1, 32, 0);
+
+	/* add symbols for our stuff */
+	m_drcuml->symbol_add(&m_drcstate->pc, sizeof(m_drcstate->pc), "pc");
+	m_drcuml->symbol_add(&m_drcstate->icount, sizeof(m_drcstate->icount), "icount");
+	for (int regnum = 0; regnum < 16; regnum++)
+	{
+		char buf[10];
+		sprintf(buf, "%c%d", (regnum < 8) ? 'd' : 'a', regnum & 7);
+		m_drcuml->symbol_add(&m_drcstate->dar[regnum], sizeof(m_drcstate->dar[regnum]), buf);
+	}
+	m_drcuml->symbol_add(&m_drcstate->x_flag, sizeof(m_drcstate->x_flag), "x_flag");
+	m_drcuml->symbol_add(&m_drcstate->n_flag, sizeof(m_drcstate->n_flag), "n_flag");
+	m_drcuml->symbol_add(&m_drcstate->not_z_flag, sizeof(m_drcstate->not_z_flag), "not_z_flag");
+	m_drcuml->symbol_add(&m_drcstate->v_flag, sizeof(m_drcstate->v_flag), "v_flag");
+	m_drcuml->symbol_add(&m_drcstate->c_flag, sizeof(m_drcstate->c_flag), "c_flag");
+
+	/* initialize the front-end helper */
+	m_drcfe = std::make_unique<m68k_frontend>(this, COMPILE_BACKWARDS_BYTES, COMPILE_FORWARDS_BYTES, COMPILE_MAX_SEQUENCE);
+
+	/* check against the interpreter if asked to */
+	if (drc_verifier::requested(*this))
+		m_verifier = std::make_unique<verifier>(*this);
+}
+
+
+/*-------------------------------------------------
+    drc_can_run - return true if the CPU is in a
+    state the recompiled code can handle
+-------------------------------------------------*/
+
+bool m68000_base_device::drc_can_run() const
+{
+	return !stopped && !m_address_error && !reset_cycles &&
+			!t1_flag && !t0_flag && !pmmu_enabled && !hmmu_enabled &&
+			instruction_hook.isnull() &&
+			!(machine().debug_flags & DEBUG_FLAG_ENABLED);
+}
+
+
+/*-------------------------------------------------
+    execute_run_drc - run recompiled code until
+    out of cycles; returns false if the
+    interpreter must run the rest of the timeslice
+-------------------------------------------------*/
+
+bool m68000_base_device::execute_run_drc()
+{
+	if (!drc_can_run())
+		return false;
+
+	initial_cycles = remaining_cycles;
+
+	/* see if interrupts came in */
+	m68ki_check_interrupts(this);
+	if (!drc_can_run())
+		return false;
+
+	/* reset the cache if dirty */
+	if (m_drc_dirty)
+		code_flush_cache();
+
+	/* execute */
+	int execute_result;
+	drc_capture_state(*m_drcstate);
+	m_drcstate->exit = 0;
+	do
+	{
+		/* run as much as we can */
+		execute_result = m_drcuml->execute(*m_entry);
+
+		/* if we need to recompile, do it */
+		if (execute_result == EXECUTE_MISSING_CODE)
+			code_compile_block(m_drcstate->pc);
+	} while (execute_result == EXECUTE_MISSING_CODE);
+	drc_restore_state(*m_drcstate);
+
+	return (execute_result == EXECUTE_OUT_OF_CYCLES);
+}
+
+
+/*-------------------------------------------------
+    drc_capture_state - copy the registers the
+    recompiled code uses out of the CPU
+-------------------------------------------------*/
+
+void m68000_base_device::drc_capture_state(drc_state &state) const
+{
+	memcpy(state.dar, dar, sizeof(state.dar));
+	state.pc = pc;
+	state.x_flag = x_flag;
+	state.n_flag = n_flag;
+	state.not_z_flag = not_z_flag;
+	state.v_flag = v_flag;
+	state.c_flag = c_flag;
+	state.icount = remaining_cycles;
+}
+
+
+/*-------------------------------------------------
+    drc_restore_state - copy the registers the
+    recompiled code uses back into the CPU
+-------------------------------------------------*/
+
+void m68000_base_device::drc_restore_state(const drc_state &state)
+{
+	memcpy(dar, state.dar, sizeof(dar));
+	pc = state.pc;
+	ppc = state.pc;
+	x_flag = state.x_flag;
+	n_flag = state.n_flag;
+	not_z_flag = state.not_z_flag;
+	v_flag = state.v_flag;
+	c_flag = state.c_flag;
+	remaining_cycles = state.icount;
+}
+
+
+/*-------------------------------------------------
+    drc_disassemble - disassemble an instruction
+    from its opcode words
+-------------------------------------------------*/
+
+offs_t m68000_base_device::drc_disassemble(char *buffer, offs_t pc, const UINT16 *words)
+{
+	UINT8 bytes[32];
+	for (int wordnum = 0; wordnum < ARRAY_LENGTH(bytes) / 2; wordnum++)
+	{
+		bytes[wordnum * 2 + 0] = (wordnum < 11) ? words[wordnum] >> 8 : 0;
+		bytes[wordnum * 2 + 1] = (wordnum < 11) ? words[wordnum] & 0xff : 0;
+	}
+	return disasm_disassemble(buffer, pc, bytes, bytes, 0);
+}
+
+
+/*-------------------------------------------------
+    func_interpret - run instructions through the
+    interpreter from the PC until execution leaves
+    the run of interpreted code ending at runend
+-------------------------------------------------*/
+
+void m68000_base_device::func_interpret()
+{
+	const UINT32 start = m_drcstate->pc;
+	const UINT32 end = m_drcstate->runend;
+
+	/* a loop inside the run would pass sequence heads without the verifier seeing them */
+	const bool loops = (m_verifier == nullptr);
+
+	/* the state is only exchanged once per run, not once per instruction */
+	drc_restore_state(*m_drcstate);
+
+	run_mode = RUN_MODE_NORMAL;
+	try
+	{
+		do
+		{
+			/* exceptions stack the PPC, so keep it current as execute_run does */
+			REG_PPC(this) = REG_PC(this);
+			ir = m68ki_read_imm_16(this);
+			jump_table[ir](this);
+			remaining_cycles -= cyc_instruction[ir];
+		} while (pc >= start && pc < end && remaining_cycles > 0 && drc_can_run() && (loops || pc > ppc));
+	}
+	catch (int error)
+	{
+		/* the interpreter raises the exception on its next entry */
+		if (error == 10)
+			m_address_error = 1;
+		else
+			throw;
+	}
+
+	drc_capture_state(*m_drcstate);
+	m_drcstate->exit = !drc_can_run();
+}
+
+
+/***************************************************************************
+    CACHE MANAGEMENT
+***************************************************************************/
+
+/*-------------------------------------------------
+    code_flush_cache - flush the cache and
+    regenerate static code
+-------------------------------------------------*/
+
+void m68000_base_device::code_flush_cache()
+{
+	drcuml_state *drcuml = m_drcuml.get();
+
+	/* empty the transient cache contents */
+	drcuml->reset();
+
+	/* describe everything that affects generated code to the persistent block cache */
+	drcuml->persist_signature(cpu_type);
+	drcuml->persist_signature(m_verifier != nullptr);
+	drcuml->persist_region(this, sizeof(*this));
+	drcuml->persist_region(m_drcstate, sizeof(*m_drcstate));
+
+	try
+	{
+		/* generate the entry point and exception handlers */
+		static_generate_nocode_handler();
+		static_generate_out_of_cycles();
+		static_generate_entry_point();
+	}
+	catch (drcuml_block::abort_compilation &)
+	{
+		fatalerror("Unable to generate M68K static code\n");
+	}
+
+	m_drc_dirty = false;
+}
+
+
+/*-------------------------------------------------
+    code_compile_block - compile a block of code
+    starting at the specified pc
+-------------------------------------------------*/
+
+void m68000_base_device::code_compile_block(offs_t pc)
+{
+	drcuml_state *drcuml = m_drcuml.get();
+	compiler_state compiler = { 0 };
+	const opcode_desc *seqhead, *seqlast;
+	const opcode_desc *desclist = nullptr;
+	bool override = false;
+	drcuml_block *block;
+
+	g_profiler.start(PROFILER_DRC_COMPILE);
+
+	bool succeeded = false;
+	while (!succeeded)
+	{
+		try
+		{
+			/* reuse the persisted block if the code hasn't changed */
+			if (drcuml->persist_restore(0, pc))
+			{
+				g_profiler.stop();
+				return;
+			}
+
+			/* get a description of this sequence */
+			if (desclist == nullptr)
+			{
+				desclist = m_drcfe->describe_code(pc);
+				if (drcuml->logging() || drcuml->logging_native())
+					log_opcode_desc(desclist);
+			}
+
+			/* start the block */
+			block = drcuml->begin_block(4096);
+
+			/* loop until we get through all instruction sequences */
+			for (seqhead = desclist; seqhead != nullptr; seqhead = seqlast->next())
+			{
+				const opcode_desc *curdesc;
+				UINT32 nextpc;
+
+				/* add a code log entry */
+				if (drcuml->logging())
+					block->append_comment("-------------------------");                 // comment
+
+				/* determine the last instruction in this sequence */
+				for (seqlast = seqhead; seqlast != nullptr; seqlast = seqlast->next())
+					if (seqlast->flags & OPFLAG_END_SEQUENCE)
+						break;
+				assert(seqlast != nullptr);
+
+				/* if we don't have a hash for this PC, or if we are overriding all, add one */
+				if (override || !drcuml->hash_exists(0, seqhead->pc))
+					UML_HASH(block, 0, seqhead->pc);                                        // hash    0,pc
+
+				/* if we already have a hash, and this is the first sequence, assume that we */
+				/* are recompiling due to being out of sync and allow future overrides */
+				else if (seqhead == desclist)
+				{
+					override = true;
+					UML_HASH(block, 0, seqhead->pc);                                        // hash    0,pc
+				}
+
+				/* otherwise, redispatch to that fixed PC and skip the rest of the processing */
+				else
+				{
+					UML_LABEL(block, seqhead->pc | 0x80000000);                             // label   seqhead->pc | 0x80000000
+					UML_HASHJMP(block, 0, seqhead->pc, *m_nocode);                          // hashjmp 0,seqhead->pc,nocode
+					continue;
+				}
+
+				/* validate this code block if we're not pointing into ROM */
+				if (oprogram->get_write_ptr(seqhead->physpc) != nullptr)
+					generate_checksum_block(block, &compiler, seqhead, seqlast);
+
+				/* label this instruction, if it may be jumped to locally */
+				if (seqhead->flags & OPFLAG_IS_BRANCH_TARGET)
+					UML_LABEL(block, seqhead->pc | 0x80000000);                             // label   seqhead->pc | 0x80000000
+
+				/* let the verifier check everything since the last sequence */
+				if (m_verifier != nullptr)
+				{
+					UML_MOV(block, mem(m_verifier->boundary_pc()), seqhead->pc);            // mov     [boundary_pc],seqhead->pc
+					UML_CALLC(block, drc_verifier::static_block_start, m_verifier.get());   // callc   block_start,verifier
+				}
+
+				/* iterate over instructions in the sequence and compile them */
+				for (curdesc = seqhead; curdesc != seqlast->next(); curdesc = curdesc->next())
+					generate_sequence_instruction(block, &compiler, curdesc);
+
+				/* note the guest code covered */
+				for (curdesc = seqhead; curdesc != seqlast->next(); curdesc = curdesc->next())
+					block->add_code_range(curdesc->pc, curdesc->pc + curdesc->length - 1);
+
+				/* if we need to return to the start, do it */
+				if (seqlast->flags & OPFLAG_RETURN_TO_START)
+					nextpc = pc;
+
+				/* otherwise we just go to the next instruction */
+				else
+					nextpc = seqlast->pc + seqlast->length;
+
+				/* count off cycles and go there */
+				generate_update_cycles(block, &compiler, nextpc, true);                     // <subtract cycles>
+				if (seqlast->next() == nullptr || seqlast->next()->pc != nextpc)
+					UML_HASHJMP(block, 0, nextpc, *m_nocode);                               // hashjmp 0,nextpc,nocode
+			}
+
+			/* end the sequence */
+			block->end();
+			g_profiler.stop();
+			succeeded = true;
+		}
+		catch (drcuml_block::abort_compilation &)
+		{
+			code_flush_cache();
+		}
+	}
+}
+
+
+/***************************************************************************
+    STATIC CODEGEN
+***************************************************************************/
+
+/*-------------------------------------------------
+    alloc_handle - allocate a handle if not
+    already allocated
+-------------------------------------------------*/
+
+void m68000_base_device::alloc_handle(code_handle **handleptr, const char *name)
+{
+	if (*handleptr == nullptr)
+		*handleptr = m_drcuml->handle_alloc(name);
+}
+
+
+/*-------------------------------------------------
+    static_generate_entry_point - generate a
+    static entry point
+-------------------------------------------------*/
+
+void m68000_base_device::static_generate_entry_point()
+{
+	drcuml_block *block;
+
+	/* begin generating */
+	block = m_drcuml->begin_block(20);
+
+	/* forward references */
+	alloc_handle(&m_nocode, "nocode");
+
+	alloc_handle(&m_entry, "entry");
+	UML_HANDLE(block, *m_entry);                                                        // handle  entry
+
+	/* generate a hash jump via the current PC */
+	UML_HASHJMP(block, 0, mem(&m_drcstate->pc), *m_nocode);                             // hashjmp 0,<pc>,nocode
+
+	block->end();
+}
+
+
+/*-------------------------------------------------
+    static_generate_nocode_handler - generate an
+    exception handler for "out of code"
+-------------------------------------------------*/
+
+void m68000_base_device::static_generate_nocode_handler()
+{
+	drcuml_block *block;
+
+	/* begin generating */
+	block = m_drcuml->begin_block(10);
+
+	/* generate a hash jump via the current mode and PC */
+	alloc_handle(&m_nocode, "nocode");
+	UML_HANDLE(block, *m_nocode);                                                       // handle  nocode
+	UML_GETEXP(block, I0);                                                              // getexp  i0
+	UML_MOV(block, mem(&m_drcstate->pc), I0);                                           // mov     [pc],i0
+	UML_EXIT(block, EXECUTE_MISSING_CODE);                                              // exit    EXECUTE_MISSING_CODE
+
+	block->end();
+}
+
+
+/*-------------------------------------------------
+    static_generate_out_of_cycles - generate an
+    out of cycles exception handler
+-------------------------------------------------*/
+
+void m68000_base_device::static_generate_out_of_cycles()
+{
+	drcuml_block *block;
+
+	/* begin generating */
+	block = m_drcuml->begin_block(10);
+
+	/* generate a hash jump via the current mode and PC */
+	alloc_handle(&m_out_of_cycles, "out_of_cycles");
+	UML_HANDLE(block, *m_out_of_cycles);                                                // handle  out_of_cycles
+	UML_GETEXP(block, I0);                                                              // getexp  i0
+	UML_MOV(block, mem(&m_drcstate->pc), I0);                                           // mov     [pc],i0
+	UML_EXIT(block, EXECUTE_OUT_OF_CYCLES);                                             // exit    EXECUTE_OUT_OF_CYCLES
+
+	block->end();
+}
+
+
+/***************************************************************************
+    CODE LOGGING HELPERS
+***************************************************************************/
+
+/*-------------------------------------------------
+    log_opcode_desc - log a list of descriptions
+-------------------------------------------------*/
+
+void m68000_base_device::log_opcode_desc(const opcode_desc *desclist)
+{
+	m_drcuml->log_printf("\nDescriptor list @ %08X\n", desclist->pc);
+
+	/* output each descriptor */
+	for ( ; desclist != nullptr; desclist = desclist->next())
+	{
+		char buffer[256];
+		drc_disassemble(buffer, desclist->pc, desclist->opptr.w);
+		m_drcuml->log_printf("%08X t:%08X f:%08X %c %s\n", desclist->pc, desclist->targetpc, desclist->flags,
+				(desclist->userflags & m68k_frontend::USERFLAG_NATIVE) ? 'N' : 'I', buffer);
+
+		/* at the end of a sequence add a dividing line */
+		if (desclist->flags & OPFLAG_END_SEQUENCE)
+			m_drcuml->log_printf("-----\n");
+	}
+}
+
+
+/*-------------------------------------------------
+    log_add_disasm_comment - add a comment
+    including disassembly of an instruction
+-------------------------------------------------*/
+
+void m68000_base_device::log_add_disasm_comment(drcuml_block *block, const opcode_desc *desc)
+{
+	if (m_drcuml->logging())
+	{
+		char buffer[256];
+		drc_disassemble(buffer, desc->pc, desc->opptr.w);
+		block->append_comment("%08X: %s", desc->pc, buffer);                             // comment
+	}
+}
+
+
+/***************************************************************************
+    INSTRUCTION CODEGEN
+***************************************************************************/
+
+/*-------------------------------------------------
+    generate_update_cycles - generate code to
+    subtract cycles from the icount and generate
+    an exception if out
+-------------------------------------------------*/
+
+void m68000_base_device::generate_update_cycles(drcuml_block *block, compiler_state *compiler, uml::parameter param, bool allow_exception)
+{
+	if (compiler->cycles != 0)
+	{
+		UML_SUB(block, mem(&m_drcstate->icount), mem(&m_drcstate->icount), compiler->cycles); // sub     icount,icount,cycles
+		if (allow_exception)
+			UML_EXHc(block, COND_LE, *m_out_of_cycles, param);                          // exh     out_of_cycles,nextpc
+	}
+	compiler->cycles = 0;
+}
+
+
+/*-------------------------------------------------
+    generate_checksum_block - generate code to
+    validate the natively compiled instructions
+    in a sequence
+-------------------------------------------------*/
+
+void m68000_base_device::generate_checksum_block(drcuml_block *block, compiler_state *compiler, const opcode_desc *seqhead, const opcode_desc *seqlast)
+{
+	const opcode_desc *curdesc;
+	UINT32 sum = 0;
+	bool first = true;
+
+	if (m_drcuml->logging())
+		block->append_comment("[Validation for %08X]", seqhead->pc);                    // comment
+
+	/* interpreted instructions always fetch what is in memory, so only native ones need checking */
+	for (curdesc = seqhead; curdesc != seqlast->next(); curdesc = curdesc->next())
+		if (curdesc->userflags & m68k_frontend::USERFLAG_NATIVE)
+			for (int wordnum = 0; wordnum < curdesc->length / 2; wordnum++)
+			{
+				void *base = m_odirect->read_ptr(curdesc->physpc + wordnum * 2, opcode_xor);
+				UML_LOAD(block, first ? I0 : I1, base, 0, SIZE_WORD, SCALE_x2);           // load    i0/i1,base,word
+				if (!first)
+					UML_ADD(block, I0, I0, I1);                                         // add     i0,i0,i1
+				sum += curdesc->opptr.w[wordnum];
+				first = false;
+			}
+
+	if (!first)
+	{
+		UML_CMP(block, I0, sum);                                                        // cmp     i0,sum
+		UML_EXHc(block, COND_NE, *m_nocode, seqhead->pc);                               // exne    nocode,seqhead->pc
+	}
+}
+
+
+/*-------------------------------------------------
+    generate_sequence_instruction - generate code
+    for a single instruction in a sequence
+-------------------------------------------------*/
+
+void m68000_base_device::generate_sequence_instruction(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc)
+{
+	/* add an entry for the log */
+	log_add_disasm_comment(block, desc);
+
+	/* everything outside the native set goes to the interpreter, which counts its own cycles; */
+	/* instructions after the first in a run were handled along with it */
+	if (!(desc->userflags & m68k_frontend::USERFLAG_NATIVE))
+	{
+		if (desc->pc >= compiler->runstart && desc->pc < compiler->runend)
+			return;
+		generate_interpret(block, compiler, desc);
+		return;
+	}
+
+	/* accumulate total cycles */
+	compiler->cycles += desc->cycles;
+
+	generate_opcode(block, compiler, desc);
+}
+
+
+/*-------------------------------------------------
+    generate_interpret - generate code to run the
+    run of interpreted instructions starting with
+    the given one through the interpreter
+-------------------------------------------------*/
+
+void m68000_base_device::generate_interpret(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc)
+{
+	/* find the end of the run; sequences end at branch targets, so nothing jumps into it */
+	const opcode_desc *last = desc;
+	while (!(last->flags & OPFLAG_END_SEQUENCE) && last->next() != nullptr && !(last->next()->userflags & m68k_frontend::USERFLAG_NATIVE))
+		last = last->next();
+	compiler->runstart = desc->pc;
+	compiler->runend = last->pc + last->length;
+
+	/* the interpreter counts its own cycles, so settle ours first */
+	generate_update_cycles(block, compiler, desc->pc, true);                            // <subtract cycles>
+
+	UML_MOV(block, mem(&m_drcstate->pc), desc->pc);                                     // mov     [pc],desc->pc
+	UML_MOV(block, mem(&m_drcstate->runend), compiler->runend);                         // mov     [runend],runend
+	UML_CALLC(block, cfunc_interpret, this);                                            // callc   interpret,this
+	UML_CMP(block, mem(&m_drcstate->exit), 0);                                          // cmp     [exit],0
+	UML_EXITc(block, COND_NE, EXECUTE_INTERPRET);                                       // exitne  EXECUTE_INTERPRET
+	UML_CMP(block, mem(&m_drcstate->icount), 0);                                        // cmp     [icount],0
+	UML_EXITc(block, COND_LE, EXECUTE_OUT_OF_CYCLES);                                   // exitle  EXECUTE_OUT_OF_CYCLES
+
+	/* go wherever the run went, carrying on inline if it fell through the end */
+	if (!(last->flags & OPFLAG_IS_UNCONDITIONAL_BRANCH))
+	{
+		code_label skip = compiler->labelnum++;
+		UML_CMP(block, mem(&m_drcstate->pc), compiler->runend);                        // cmp     [pc],runend
+		UML_JMPc(block, COND_E, skip);                                                  // je      skip
+		UML_HASHJMP(block, 0, mem(&m_drcstate->pc), *m_nocode);                         // hashjmp 0,[pc],nocode
+		UML_LABEL(block, skip);                                                         // skip:
+	}
+	else
+		UML_HASHJMP(block, 0, mem(&m_drcstate->pc), *m_nocode);                         // hashjmp 0,[pc],nocode
+}
+
+
+/*-------------------------------------------------
+    generate_condition - generate code to set I0
+    to 1 if the given condition holds, 0 if not
+-------------------------------------------------*/
+
+void m68000_base_device::generate_condition(drcuml_block *block, int cond)
+{
+	switch (cond & ~1)
+	{
+		case 0:     // T/F
+			UML_MOV(block, I0, (cond & 1) ^ 1);                                         // mov     i0,!cond
+			return;
+
+		case 2:     // HI/LS
+			UML_TEST(block, FLAG(c_flag), 0x100);                                       // test    [c_flag],0x100
+			UML_SETc(block, COND_NZ, I0);                                               // setnz   i0
+			UML_CMP(block, FLAG(not_z_flag), 0);                                        // cmp     [not_z_flag],0
+			UML_SETc(block, COND_Z, I1);                                                // setz    i1
+			UML_OR(block, I0, I0, I1);                                                  // or      i0,i0,i1
+			break;
+
+		case 4:     // CC/CS
+			UML_TEST(block, FLAG(c_flag), 0x100);                                       // test    [c_flag],0x100
+			UML_SETc(block, COND_NZ, I0);                                               // setnz   i0
+			break;
+
+		case 6:     // NE/EQ
+			UML_CMP(block, FLAG(not_z_flag), 0);                                        // cmp     [not_z_flag],0
+			UML_SETc(block, COND_Z, I0);                                                // setz    i0
+			break;
+
+		case 8:     // VC/VS
+			UML_TEST(block, FLAG(v_flag), 0x80);                                        // test    [v_flag],0x80
+			UML_SETc(block, COND_NZ, I0);                                               // setnz   i0
+			break;
+
+		case 10:    // PL/MI
+			UML_TEST(block, FLAG(n_flag), 0x80);                                        // test    [n_flag],0x80
+			UML_SETc(block, COND_NZ, I0);                                               // setnz   i0
+			break;
+
+		case 12:    // GE/LT
+			UML_XOR(block, I0, FLAG(n_flag), FLAG(v_flag));                             // xor     i0,[n_flag],[v_flag]
+			UML_TEST(block, I0, 0x80);                                                  // test    i0,0x80
+			UML_SETc(block, COND_NZ, I0);                                               // setnz   i0
+			break;
+
+		case 14:    // GT/LE
+			UML_XOR(block, I0, FLAG(n_flag), FLAG(v_flag));                             // xor     i0,[n_flag],[v_flag]
+			UML_TEST(block, I0, 0x80);                                                  // test    i0,0x80
+			UML_SETc(block, COND_NZ, I0);                                               // setnz   i0
+			UML_CMP(block, FLAG(not_z_flag), 0);                                        // cmp     [not_z_flag],0
+			UML_SETc(block, COND_Z, I1);                                                // setz    i1
+			UML_OR(block, I0, I0, I1);                                                  // or      i0,i0,i1
+			break;
+	}
+
+	/* the code above computes the odd-numbered condition of each pair */
+	if (!(cond & 1))
+		UML_XOR(block, I0, I0, 1);                                                      // xor     i0,i0,1
+}
+
+
+/*-------------------------------------------------
+    generate_logic_flags - set N and Z from the
+    32-bit result in I0 and clear V and C
+-------------------------------------------------*/
+
+void m68000_base_device::generate_logic_flags(drcuml_block *block)
+{
+	UML_SHR(block, FLAG(n_flag), I0, 24);                                               // shr     [n_flag],i0,24
+	UML_MOV(block, FLAG(not_z_flag), I0);                                               // mov     [not_z_flag],i0
+	UML_MOV(block, FLAG(v_flag), 0);                                                    // mov     [v_flag],0
+	UML_MOV(block, FLAG(c_flag), 0);                                                    // mov     [c_flag],0
+}
+
+
+/*-------------------------------------------------
+    generate_arith_flags - set all flags from the
+    32-bit result in I0 of the UML add or sub
+    just generated
+-------------------------------------------------*/
+
+void m68000_base_device::generate_arith_flags(drcuml_block *block, bool setx)
+{
+	UML_SETc(block, COND_C, I1);                                                        // setc    i1
+	UML_SETc(block, COND_V, I2);                                                        // setv    i2
+	UML_SHL(block, I1, I1, 8);                                                          // shl     i1,i1,8
+	UML_MOV(block, FLAG(c_flag), I1);                                                   // mov     [c_flag],i1
+	if (setx)
+		UML_MOV(block, FLAG(x_flag), I1);                                               // mov     [x_flag],i1
+	UML_SHL(block, FLAG(v_flag), I2, 7);                                                // shl     [v_flag],i2,7
+	UML_SHR(block, FLAG(n_flag), I0, 24);                                               // shr     [n_flag],i0,24
+	UML_MOV(block, FLAG(not_z_flag), I0);                                               // mov     [not_z_flag],i0
+}
+
+
+/*-------------------------------------------------
+    generate_branch - generate code for Bcc, BRA
+    and DBcc
+-------------------------------------------------*/
+
+void m68000_base_device::generate_branch(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc)
+{
+	UINT16 op = desc->opptr.w[0];
+	int cond = (op >> 8) & 15;
+	code_label skip = compiler->labelnum++;
+
+	if ((op & 0xf000) == 0x6000)
+	{
+		/* BRA */
+		if (cond == 0)
+		{
+			generate_update_cycles(block, compiler, desc->targetpc, true);              // <subtract cycles>
+			UML_HASHJMP(block, 0, desc->targetpc, *m_nocode);                           // hashjmp 0,targetpc,nocode
+			return;
+		}
+
+		/* Bcc */
+		generate_condition(block, cond);                                                // <i0 = condition>
+		UML_TEST(block, I0, 1);                                                         // test    i0,1
+		UML_JMPc(block, COND_Z, skip);                                                  // jz      skip
+
+		compiler_state taken = *compiler;
+		generate_update_cycles(block, &taken, desc->targetpc, true);                    // <subtract cycles>
+		UML_HASHJMP(block, 0, desc->targetpc, *m_nocode);                               // hashjmp 0,targetpc,nocode
+
+		UML_LABEL(block, skip);                                                         // skip:
+		compiler->cycles += (op & 0xff) ? cyc_bcc_notake_b : cyc_bcc_notake_w;
+		return;
+	}
+
+	/* DBcc: nothing happens when the condition is true */
+	if (cond == 0)
+		return;
+	if (cond != 1)
+	{
+		generate_condition(block, cond);                                                // <i0 = condition>
+		UML_TEST(block, I0, 1);                                                         // test    i0,1
+		UML_JMPc(block, COND_NZ, skip);                                                 // jnz     skip
+	}
+
+	/* decrement the low word of the counter */
+	UML_SUB(block, I0, D32(op & 7), 1);                                                 // sub     i0,dy,1
+	UML_AND(block, I0, I0, 0xffff);                                                     // and     i0,i0,0xffff
+	UML_AND(block, I1, D32(op & 7), 0xffff0000);                                        // and     i1,dy,0xffff0000
+	UML_OR(block, D32(op & 7), I1, I0);                                                 // or      dy,i1,i0
+
+	/* loop unless it expired */
+	code_label expired = compiler->labelnum++;
+	UML_CMP(block, I0, 0xffff);                                                         // cmp     i0,0xffff
+	UML_JMPc(block, COND_E, expired);                                                   // je      expired
+
+	compiler_state taken = *compiler;
+	taken.cycles += cyc_dbcc_f_noexp;
+	generate_update_cycles(block, &taken, desc->targetpc, true);                        // <subtract cycles>
+	UML_HASHJMP(block, 0, desc->targetpc, *m_nocode);                                   // hashjmp 0,targetpc,nocode
+
+	UML_LABEL(block, expired);                                                          // expired:
+	UML_SUB(block, mem(&m_drcstate->icount), mem(&m_drcstate->icount), cyc_dbcc_f_exp); // sub     icount,icount,cyc_dbcc_f_exp
+	UML_LABEL(block, skip);                                                             // skip:
+}
+
+
+/*-------------------------------------------------
+    generate_opcode - generate code for a
+    natively compiled instruction
+-------------------------------------------------*/
+
+void m68000_base_device::generate_opcode(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc)
+{
+	UINT16 op = desc->opptr.w[0];
+	int rx = (op >> 9) & 7;
+	int ry = op & 7;
+	UINT32 quick = (rx == 0) ? 8 : rx;
+
+	if (desc->flags & OPFLAG_IS_BRANCH)
+		generate_branch(block, compiler, desc);
+
+	else if (op == 0x4e71)                  // NOP
+		return;
+
+	else if ((op & 0xf100) == 0x7000)       // MOVEQ   #imm,Dx
+	{
+		UML_MOV(block, I0, (UINT32)(INT32)(INT8)op);                                    // mov     i0,imm
+		UML_MOV(block, D32(rx), I0);                                                    // mov     dx,i0
+		generate_logic_flags(block);
+	}
+
+	else if ((op & 0xf1f0) == 0x2000)       // MOVE.L  Ry,Dx
+	{
+		UML_MOV(block, I0, DAR32(op & 15));                                             // mov     i0,ry
+		UML_MOV(block, D32(rx), I0);                                                    // mov     dx,i0
+		generate_logic_flags(block);
+	}
+
+	else if ((op & 0xf1f0) == 0x2040)       // MOVEA.L Ry,Ax
+		UML_MOV(block, A32(rx), DAR32(op & 15));                                        // mov     ax,ry
+
+	else if ((op & 0xf1f0) == 0xd080)       // ADD.L   Ry,Dx
+	{
+		UML_ADD(block, I0, D32(rx), DAR32(op & 15));                                    // add     i0,dx,ry
+		UML_MOV(block, D32(rx), I0);                                                    // mov     dx,i0
+		generate_arith_flags(block, true);
+	}
+
+	else if ((op & 0xf1f0) == 0x9080)       // SUB.L   Ry,Dx
+	{
+		UML_SUB(block, I0, D32(rx), DAR32(op & 15));                                    // sub     i0,dx,ry
+		UML_MOV(block, D32(rx), I0);                                                    // mov     dx,i0
+		generate_arith_flags(block, true);
+	}
+
+	else if ((op & 0xf1f0) == 0xb080)       // CMP.L   Ry,Dx
+	{
+		UML_SUB(block, I0, D32(rx), DAR32(op & 15));                                    // sub     i0,dx,ry
+		generate_arith_flags(block, false);
+	}
+
+	else if ((op & 0xf1f8) == 0xc080)       // AND.L   Dy,Dx
+	{
+		UML_AND(block, I0, D32(rx), D32(ry));                                           // and     i0,dx,dy
+		UML_MOV(block, D32(rx), I0);                                                    // mov     dx,i0
+		generate_logic_flags(block);
+	}
+
+	else if ((op & 0xf1f8) == 0x8080)       // OR.L    Dy,Dx
+	{
+		UML_OR(block, I0, D32(rx), D32(ry));                                            // or      i0,dx,dy
+		UML_MOV(block, D32(rx), I0);                                                    // mov     dx,i0
+		generate_logic_flags(block);
+	}
+
+	else if ((op & 0xf1f8) == 0xb180)       // EOR.L   Dx,Dy
+	{
+		UML_XOR(block, I0, D32(ry), D32(rx));                                           // xor     i0,dy,dx
+		UML_MOV(block, D32(ry), I0);                                                    // mov     dy,i0
+		generate_logic_flags(block);
+	}
+
+	else if ((op & 0xf0f8) == 0x5080)       // ADDQ.L/SUBQ.L #q,Dy
+	{
+		if (op & 0x0100)
+			UML_SUB(block, I0, D32(ry), quick);                                         // sub     i0,dy,q
+		else
+			UML_ADD(block, I0, D32(ry), quick);                                         // add     i0,dy,q
+		UML_MOV(block, D32(ry), I0);                                                    // mov     dy,i0
+		generate_arith_flags(block, true);
+	}
+
+	else if ((op & 0xf0f8) == 0x5048 || (op & 0xf0f8) == 0x5088)    // ADDQ/SUBQ #q,Ay
+	{
+		if (op & 0x0100)
+			UML_SUB(block, A32(ry), A32(ry), quick);                                    // sub     ay,ay,q
+		else
+			UML_ADD(block, A32(ry), A32(ry), quick);                                    // add     ay,ay,q
+	}
+
+	else if ((op & 0xfff8) == 0x4a80)       // TST.L   Dy
+	{
+		UML_MOV(block, I0, D32(ry));                                                    // mov     i0,dy
+		generate_logic_flags(block);
+	}
+
+	else if ((op & 0xfff8) == 0x4280)       // CLR.L   Dy
+	{
+		UML_MOV(block, I0, 0);                                                          // mov     i0,0
+		UML_MOV(block, D32(ry), I0);                                                    // mov     dy,i0
+		generate_logic_flags(block);
+	}
+
+	else if ((op & 0xfff8) == 0x4840)       // SWAP    Dy
+	{
+		UML_ROL(block, I0, D32(ry), 16);                                                // rol     i0,dy,16
+		UML_MOV(block, D32(ry), I0);                                                    // mov     dy,i0
+		generate_logic_flags(block);
+	}
+
+	else if ((op & 0xf1f8) == 0x41d0)       // LEA     (Ay),Ax
+		UML_MOV(block, A32(rx), A32(ry));                                               // mov     ax,ay
+
+	else if ((op & 0xf1f8) == 0x41e8)       // LEA     (d16,Ay),Ax
+		UML_ADD(block, A32(rx), A32(ry), (UINT32)(INT32)(INT16)desc->opptr.w[1]);       // add     ax,ay,d16
+
+	else if ((op & 0xf1ff) == 0x41f8)       // LEA     (xxx).W,Ax
+		UML_MOV(block, A32(rx), (UINT32)(INT32)(INT16)desc->opptr.w[1]);                // mov     ax,xxx
+
+	else if ((op & 0xf1ff) == 0x41f9)       // LEA     (xxx).L,Ax
+		UML_MOV(block, A32(rx), (desc->opptr.w[1] << 16) | desc->opptr.w[2]);           // mov     ax,xxx
+
+	else
+		fatalerror("M68KDRC: no code for native opcode %04X\n", op);
+}
+
+
+
+/***************************************************************************
+    LOCKSTEP VERIFICATION
+***************************************************************************/
+
+/*-------------------------------------------------
+    verifier - constructor
+-------------------------------------------------*/
+
+m68000_base_device::verifier::verifier(m68000_base_device &cpu)
+	: drc_verifier(cpu, *cpu.m_drcuml, *cpu.program),
+		m_m68k(cpu)
+{
+	/* the recompiled code doesn't keep the prefetch queue up to date */
+	ignore_register(M68K_PREF_ADDR);
+	ignore_register(M68K_PREF_DATA);
+
+	/* the status register isn't shown, but is the point of most instructions */
+	compare_register(STATE_GENFLAGS);
+}
+
+
+/*-------------------------------------------------
+    save_state - snapshot everything the
+    interpreter and recompiler can change
+-------------------------------------------------*/
+
+void m68000_base_device::verifier::save_state(std::vector<UINT8> &buffer)
+{
+	m68000_base_device &m68k = m_m68k;
+
+	buffer.clear();
+	save_item(buffer, m68k.dar);
+	save_item(buffer, m68k.ppc);
+	save_item(buffer, m68k.pc);
+	save_item(buffer, m68k.sp);
+	save_item(buffer, m68k.vbr);
+	save_item(buffer, m68k.sfc);
+	save_item(buffer, m68k.dfc);
+	save_item(buffer, m68k.cacr);
+	save_item(buffer, m68k.caar);
+	save_item(buffer, m68k.ir);
+	save_item(buffer, m68k.fpr);
+	save_item(buffer, m68k.fpiar);
+	save_item(buffer, m68k.fpsr);
+	save_item(buffer, m68k.fpcr);
+	save_item(buffer, m68k.t1_flag);
+	save_item(buffer, m68k.t0_flag);
+	save_item(buffer, m68k.s_flag);
+	save_item(buffer, m68k.m_flag);
+	save_item(buffer, m68k.x_flag);
+	save_item(buffer, m68k.n_flag);
+	save_item(buffer, m68k.not_z_flag);
+	save_item(buffer, m68k.v_flag);
+	save_item(buffer, m68k.c_flag);
+	save_item(buffer, m68k.int_mask);
+	save_item(buffer, m68k.stopped);
+	save_item(buffer, m68k.pref_addr);
+	save_item(buffer, m68k.pref_data);
+	save_item(buffer, m68k.instr_mode);
+	save_item(buffer, m68k.run_mode);
+	save_item(buffer, m68k.pmmu_enabled);
+	save_item(buffer, m68k.hmmu_enabled);
+	save_item(buffer, m68k.fpu_just_reset);
+	save_item(buffer, m68k.remaining_cycles);
+	save_item(buffer, m68k.reset_cycles);
+	save_item(buffer, m68k.m_address_error);
+	save_item(buffer, m68k.aerr_address);
+	save_item(buffer, m68k.aerr_write_mode);
+	save_item(buffer, m68k.aerr_fc);
+	save_item(buffer, m68k.nmi_pending);
+	save_item(buffer, m68k.mmu_tmp_fc);
+	save_item(buffer, m68k.mmu_tmp_rw);
+	save_item(buffer, m68k.ic_address);
+	save_item(buffer, m68k.ic_data);
+	save_item(buffer, m68k.ic_valid);
+}
+
+
+/*-------------------------------------------------
+    restore_state - restore a snapshot, and hand
+    it to the recompiled code as well
+-------------------------------------------------*/
+
+void m68000_base_device::verifier::restore_state(const std::vector<UINT8> &buffer)
+{
+	m68000_base_device &m68k = m_m68k;
+
+	const UINT8 *data = &buffer[0];
+	restore_item(data, m68k.dar);
+	restore_item(data, m68k.ppc);
+	restore_item(data, m68k.pc);
+	restore_item(data, m68k.sp);
+	restore_item(data, m68k.vbr);
+	restore_item(data, m68k.sfc);
+	restore_item(data, m68k.dfc);
+	restore_item(data, m68k.cacr);
+	restore_item(data, m68k.caar);
+	restore_item(data, m68k.ir);
+	restore_item(data, m68k.fpr);
+	restore_item(data, m68k.fpiar);
+	restore_item(data, m68k.fpsr);
+	restore_item(data, m68k.fpcr);
+	restore_item(data, m68k.t1_flag);
+	restore_item(data, m68k.t0_flag);
+	restore_item(data, m68k.s_flag);
+	restore_item(data, m68k.m_flag);
+	restore_item(data, m68k.x_flag);
+	restore_item(data, m68k.n_flag);
+	restore_item(data, m68k.not_z_flag);
+	restore_item(data, m68k.v_flag);
+	restore_item(data, m68k.c_flag);
+	restore_item(data, m68k.int_mask);
+	restore_item(data, m68k.stopped);
+	restore_item(data, m68k.pref_addr);
+	restore_item(data, m68k.pref_data);
+	restore_item(data, m68k.instr_mode);
+	restore_item(data, m68k.run_mode);
+	restore_item(data, m68k.pmmu_enabled);
+	restore_item(data, m68k.hmmu_enabled);
+	restore_item(data, m68k.fpu_just_reset);
+	restore_item(data, m68k.remaining_cycles);
+	restore_item(data, m68k.reset_cycles);
+	restore_item(data, m68k.m_address_error);
+	restore_item(data, m68k.aerr_address);
+	restore_item(data, m68k.aerr_write_mode);
+	restore_item(data, m68k.aerr_fc);
+	restore_item(data, m68k.nmi_pending);
+	restore_item(data, m68k.mmu_tmp_fc);
+	restore_item(data, m68k.mmu_tmp_rw);
+	restore_item(data, m68k.ic_address);
+	restore_item(data, m68k.ic_data);
+	restore_item(data, m68k.ic_valid);
+
+	m68k.drc_capture_state(*m68k.m_drcstate);
+}
+
+
+/*-------------------------------------------------
+    set_pc - set the PC at a sequence boundary;
+    the recompiled code only keeps its registers
+    in the DRC state, so copy them back first
+-------------------------------------------------*/
+
+void m68000_base_device::verifier::set_pc(offs_t pc)
+{
+	m_m68k.m_drcstate->pc = pc;
+	m_m68k.drc_restore_state(*m_m68k.m_drcstate);
+}
+
+
+/*-------------------------------------------------
+    step - run one instruction on the interpreter,
+    as func_interpret does
+-------------------------------------------------*/
+
+void m68000_base_device::verifier::step()
+{
+	m68000_base_device *m68k = &m_m68k;
+
+	m68k->run_mode = RUN_MODE_NORMAL;
+	REG_PPC(m68k) = REG_PC(m68k);
+	try
+	{
+		m68k->ir = m68ki_read_imm_16(m68k);
+		m68k->jump_table[m68k->ir](m68k);
+		m68k->remaining_cycles -= m68k->cyc_instruction[m68k->ir];
+	}
+	catch (int error)
+	{
+		if (error == 10)
+			m68k->m_address_error = 1;
+		else
+			throw;
+	}
+}
+
+
+/*-------------------------------------------------
+    memory_read - perform a read through the
+    core's own handlers, which know the bus width
+-------------------------------------------------*/
+
+UINT64 m68000_base_device::verifier::memory_read(int size, offs_t address, UINT64 mask)
+{
+	switch (size)
+	{
+		case 1:     return m_m68k.read8(address);
+		case 2:     return m_m68k.read16(address);
+		default:    return m_m68k.read32(address);
+	}
+}
+
+
+/*-------------------------------------------------
+    memory_write - perform a write through the
+    core's own handlers
+-------------------------------------------------*/
+
+void m68000_base_device::verifier::memory_write(int size, offs_t address, UINT64 data, UINT64 mask)
+{
+	switch (size)
+	{
+		case 1:     m_m68k.write8(address, data);    break;
+		case 2:     m_m68k.write16(address, data);   break;
+		default:    m_m68k.write32(address, data);   break;
+	}
+}
@@ -0,0 +1,192 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    m68kfe.cpp
+
+    Front end for the 680x0 recompiler.
+
+    Only a handful of common register-to-register instructions and
+    PC-relative branches are marked for native compilation; everything
+    else is described just well enough (length and whether flow can
+    continue past it) for the recompiler to hand it to the interpreter.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "m68000.h"
+
+
+/***************************************************************************
+    CONSTANTS
+***************************************************************************/
+
+/* longest 680x0 instruction, in words */
+#define MAX_INSTRUCTION_WORDS       11
+
+
+/***************************************************************************
+    INSTRUCTION PARSERS
+***************************************************************************/
+
+m68k_frontend::m68k_frontend(m68000_base_device *device, UINT32 window_start, UINT32 window_end, UINT32 max_sequence)
+	: drc_frontend(*device, window_start, window_end, max_sequence)
+	, m_m68k(device)
+{
+}
+
+
+/*-------------------------------------------------
+    describe - build a description of a single
+    instruction
+-------------------------------------------------*/
+
+bool m68k_frontend::describe(opcode_desc &desc, const opcode_desc *prev)
+{
+	UINT16 words[MAX_INSTRUCTION_WORDS];
+	char buffer[256];
+
+	/* an odd PC raises an address error as soon as it is fetched */
+	if (desc.pc & 1)
+	{
+		desc.length = 2;
+		desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE | OPFLAG_WILL_CAUSE_EXCEPTION;
+		return true;
+	}
+
+	/* fetch the opcode and as many extension words as the disassembler says it needs */
+	int numwords = 1;
+	words[0] = m_m68k->readimm16(desc.physpc);
+	for (;;)
+	{
+		for (int wordnum = numwords; wordnum < MAX_INSTRUCTION_WORDS; wordnum++)
+			words[wordnum] = 0;
+		int length = m_m68k->drc_disassemble(buffer, desc.pc, words) & DASMFLAG_LENGTHMASK;
+		if (length < 2)
+			length = 2;
+		if (length / 2 <= numwords || numwords == MAX_INSTRUCTION_WORDS)
+		{
+			desc.length = length;
+			break;
+		}
+		for ( ; numwords < length / 2 && numwords < MAX_INSTRUCTION_WORDS; numwords++)
+			words[numwords] = m_m68k->readimm16(desc.physpc + numwords * 2);
+	}
+	for (int wordnum = 0; wordnum < ARRAY_LENGTH(desc.opptr.w); wordnum++)
+		desc.opptr.w[wordnum] = words[wordnum];
+
+	UINT16 opcode = words[0];
+	desc.cycles = m_m68k->cyc_instruction[opcode];
+
+	/* compile natively only where the code can't be swapped out from under us */
+	if (code_is_fixed(desc.physpc, desc.physpc + desc.length - 1) && describe_native(desc, opcode))
+	{
+		desc.userflags |= USERFLAG_NATIVE;
+		return true;
+	}
+
+	/* interpreted instructions that never continue to the next one */
+	if (opcode == 0x4e72 ||                 // STOP
+		opcode == 0x4e73 ||                 // RTE
+		opcode == 0x4e74 ||                 // RTD
+		opcode == 0x4e75 ||                 // RTS
+		opcode == 0x4e77 ||                 // RTR
+		opcode == 0x4afc ||                 // ILLEGAL
+		(opcode & 0xffc0) == 0x4ec0 ||      // JMP
+		(opcode & 0xff00) == 0x6000)        // BRA
+	{
+		desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+	}
+	desc.flags |= OPFLAG_CAN_CAUSE_EXCEPTION;
+	return true;
+}
+
+
+/*-------------------------------------------------
+    describe_native - check whether an instruction
+    is one the recompiler generates code for, and
+    describe its flow if so
+-------------------------------------------------*/
+
+bool m68k_frontend::describe_native(opcode_desc &desc, UINT16 opcode)
+{
+	/* register-only instructions with no flow change */
+	if (opcode == 0x4e71 ||                 // NOP
+		(opcode & 0xf100) == 0x7000 ||      // MOVEQ   #imm,Dx
+		(opcode & 0xf1f0) == 0x2000 ||      // MOVE.L  Ry,Dx
+		(opcode & 0xf1f0) == 0x2040 ||      // MOVEA.L Ry,Ax
+		(opcode & 0xf1f0) == 0xd080 ||      // ADD.L   Ry,Dx
+		(opcode & 0xf1f0) == 0x9080 ||      // SUB.L   Ry,Dx
+		(opcode & 0xf1f0) == 0xb080 ||      // CMP.L   Ry,Dx
+		(opcode & 0xf1f8) == 0xc080 ||      // AND.L   Dy,Dx
+		(opcode & 0xf1f8) == 0x8080 ||      // OR.L    Dy,Dx
+		(opcode & 0xf1f8) == 0xb180 ||      // EOR.L   Dx,Dy
+		(opcode & 0xf0f8) == 0x5080 ||      // ADDQ.L/SUBQ.L #q,Dy
+		(opcode & 0xf0f8) == 0x5048 ||      // ADDQ.W/SUBQ.W #q,Ay
+		(opcode & 0xf0f8) == 0x5088 ||      // ADDQ.L/SUBQ.L #q,Ay
+		(opcode & 0xfff8) == 0x4a80 ||      // TST.L   Dy
+		(opcode & 0xfff8) == 0x4280 ||      // CLR.L   Dy
+		(opcode & 0xfff8) == 0x4840 ||      // SWAP    Dy
+		(opcode & 0xf1f8) == 0x41d0 ||      // LEA     (Ay),Ax
+		(opcode & 0xf1f8) == 0x41e8 ||      // LEA     (d16,Ay),Ax
+		(opcode & 0xf1ff) == 0x41f8 ||      // LEA     (xxx).W,Ax
+		(opcode & 0xf1ff) == 0x41f9)        // LEA     (xxx).L,Ax
+		return true;
+
+	/* Bcc/BRA with an 8 or 16-bit displacement; BSR pushes, so it is interpreted */
+	if ((opcode & 0xf000) == 0x6000 && (opcode & 0x0f00) != 0x0100)
+	{
+		UINT8 disp = opcode & 0xff;
+		if (disp == 0xff)
+			return false;
+		desc.targetpc = desc.pc + 2 + ((disp == 0) ? (INT16)desc.opptr.w[1] : (INT8)disp);
+
+		/* odd targets fault, and BRA to itself is the idle loop the interpreter skips */
+		if ((desc.targetpc & 1) || ((opcode & 0x0f00) == 0x0000 && desc.targetpc == desc.pc))
+			return false;
+
+		if ((opcode & 0x0f00) == 0x0000)
+			desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+		else
+			desc.flags |= OPFLAG_IS_CONDITIONAL_BRANCH;
+		return true;
+	}
+
+	/* DBcc */
+	if ((opcode & 0xf0f8) == 0x50c8)
+	{
+		desc.targetpc = desc.pc + 2 + (INT16)desc.opptr.w[1];
+		if (desc.targetpc & 1)
+			return false;
+		desc.flags |= OPFLAG_IS_CONDITIONAL_BRANCH;
+		return true;
+	}
+
+	return false;
+}
+
+
+/*-------------------------------------------------
+    code_is_fixed - return true if the given range
+    of code can only change by being written,
+    which the recompiler can check for; switchable
+    banks and handler-backed memory are left to
+    the interpreter
+-------------------------------------------------*/
+
+bool m68k_frontend::code_is_fixed(offs_t start, offs_t end)
+{
+	address_space &space = *m_m68k->oprogram;
+
+	/* every word must be directly readable */
+	for (offs_t address = start & ~1; address <= end; address += 2)
+		if (m_m68k->m_odirect->read_ptr(address, m_m68k->opcode_xor) == nullptr)
+			return false;
+
+	/* and not part of a bank that can be pointed elsewhere */
+	for (auto &bank : m_m68k->machine().memory().banks())
+		if (!bank.second->anonymous() && bank.second->references_space(space, ROW_READ) && bank.second->straddles((start > 0) ? start - 1 : 0, end + 1))
+			return false;
+
+	return true;
+}
@@ -201,6 +201,7 @@ mips3_device::mips3_device(const machine_config &mconfig, device_type type, cons
 
 void mips3_device::device_stop()
 {
+	m_verifier = nullptr;
 	if (m_drcfe != nullptr)
 	{
 		m_drcfe = nullptr;
@@ -341,6 +342,13 @@ void mips3_device::device_start()
 	/* initialize the UML generator */
 	m_drcuml = std::make_unique<drcuml_state>(*this, m_cache, flags, 8, 32, 2);
 
+	/* check the recompiler against the interpreter if requested */
+	if (m_isdrc && drc_verifier::requested(*this))
+	{
+		m_verifier = std::make_unique<verifier>(*this);
+		m_verifier->accessors(m_memory);
+	}
+
 	/* add symbols for our stuff */
 	m_drcuml->symbol_add(&m_core->pc, sizeof(m_core->pc), "pc");
 	m_drcuml->symbol_add(&m_core->icount, sizeof(m_core->icount), "icount");
@@ -398,7 +406,8 @@ void mips3_device::device_start()
 	}
 
 	/* if we have registers to spare, assign r2, r3, r4 to leftovers */
-	if (!DISABLE_FAST_REGISTERS)
+	/* (not when verifying, since the interpreter only sees registers in memory) */
+	if (!DISABLE_FAST_REGISTERS && m_verifier == nullptr)
 	{
 		drcbe_info beinfo;
 
@@ -943,8 +952,14 @@ void mips3_device::device_reset()
 	vtlb_load(2 * m_tlbentries + 1, (0xc0000000 - 0xa0000000) >> MIPS3_MIN_PAGE_SHIFT, 0xa0000000, 0x00000000 | VTLB_READ_ALLOWED | VTLB_WRITE_ALLOWED | VTLB_FETCH_ALLOWED | VTLB_FLAG_VALID);
 
 	m_core->mode = (MODE_KERNEL << 1) | 0;
-	m_cache_dirty = TRUE;
 	m_interrupt_cycles = 0;
+
+	/* code compiled from ROM survives a reset; anything in RAM may be reloaded */
+	if (m_isdrc && m_drcuml != nullptr)
+		m_drcuml->invalidate_code_pages([this](offs_t start, offs_t end)
+		{
+			return !code_page_is_rom(start) || !code_page_is_rom(end);
+		});
 }
 
 
@@ -963,6 +978,22 @@ bool mips3_device::memory_translate(address_spacenum spacenum, int intention, of
 }
 
 
+/*-------------------------------------------------
+    code_page_is_rom - determine whether code at
+    the given PC comes from unmapped ROM
+-------------------------------------------------*/
+
+bool mips3_device::code_page_is_rom(offs_t pc)
+{
+	/* TLB-mapped code may be remapped after a reset */
+	if (pc < 0x80000000 || pc >= 0xc0000000)
+		return false;
+	if (!memory_translate(AS_PROGRAM, TRANSLATE_FETCH, pc))
+		return false;
+	return m_program->get_read_ptr(pc) != nullptr && m_program->get_write_ptr(pc) == nullptr;
+}
+
+
 offs_t mips3_device::disasm_disassemble(char *buffer, offs_t pc, const UINT8 *oprom, const UINT8 *opram, UINT32 options)
 {
 	extern unsigned dasmmips3(char *, unsigned, UINT32);
@@ -2745,15 +2776,19 @@ void mips3_device::execute_run()
 		return;
 	}
 
-	/* count cycles and interrupt cycles */
-	m_core->icount -= m_interrupt_cycles;
-	m_interrupt_cycles = 0;
+	/* a verification step replays recompiled code, so leave timers and IRQs alone */
+	if (m_verifier == nullptr)
+	{
+		/* count cycles and interrupt cycles */
+		m_core->icount -= m_interrupt_cycles;
+		m_interrupt_cycles = 0;
 
-	/* update timers & such */
-	mips3com_update_cycle_counting();
+		/* update timers & such */
+		mips3com_update_cycle_counting();
 
-	/* check for IRQs */
-	check_irqs();
+		/* check for IRQs */
+		check_irqs();
+	}
 
 	/* core execution loop */
 	do
@@ -19,6 +19,7 @@
 #include "cpu/drcfe.h"
 #include "cpu/drcuml.h"
 #include "cpu/drcumlsh.h"
+#include "cpu/drcverify.h"
 
 
 // NEC VR4300 series is MIPS III with 32-bit address bus and slightly custom COP0/TLB
@@ -281,6 +282,7 @@ public:
 	void clear_fastram(UINT32 select_start);
 	void mips3drc_set_options(UINT32 options);
 	void mips3drc_add_hotspot(offs_t pc, UINT32 opcode, UINT32 cycles);
+	void mips3drc_invalidate_code(offs_t start, offs_t end);
 	void burn_cycles(INT32 cycles);
 
 protected:
@@ -451,6 +453,24 @@ private:
 	}       m_hotspot[MIPS3_MAX_HOTSPOTS];
 	bool m_isdrc;
 
+	/* lockstep verification against the interpreter */
+	class verifier : public drc_verifier
+	{
+	public:
+		verifier(mips3_device &cpu);
+
+	protected:
+		virtual void save_state(std::vector<UINT8> &buffer) override;
+		virtual void restore_state(const std::vector<UINT8> &buffer) override;
+		virtual offs_t pc() override { return m_mips.m_core->pc; }
+		virtual void set_pc(offs_t pc) override;
+		virtual void step() override;
+
+	private:
+		mips3_device &      m_mips;
+	};
+	std::unique_ptr<verifier> m_verifier;
+
 
 	void generate_exception(int exception, int backup);
 	void generate_tlb_exception(int exception, offs_t address);
@@ -463,6 +483,7 @@ public:
 	void mips3com_tlbwi();
 	void mips3com_tlbwr();
 	void mips3com_tlbp();
+	void mips3com_icache_hit_invalidate();
 private:
 	UINT32 compute_config_register();
 	UINT32 compute_prid_register();
@@ -528,6 +549,7 @@ private:
 	void load_fast_iregs(drcuml_block *block);
 	void save_fast_iregs(drcuml_block *block);
 	void code_flush_cache();
+	bool code_page_is_rom(offs_t pc);
 	void code_compile_block(UINT8 mode, offs_t pc);
 public:
 	void func_get_cycles();
@@ -185,6 +185,19 @@ void mips3_device::mips3com_tlbp()
 }
 
 
+/*-------------------------------------------------
+    mips3com_icache_hit_invalidate - drop any
+    compiled code in the instruction cache line
+    addressed by a CACHE Hit_Invalidate_I
+-------------------------------------------------*/
+
+void mips3_device::mips3com_icache_hit_invalidate()
+{
+	offs_t start = m_core->arg0 & ~31;
+	m_drcuml->invalidate_code(start, start + 31);
+}
+
+
 
 /***************************************************************************
     INTERNAL HELPERS
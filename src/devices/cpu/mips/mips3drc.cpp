@@ -170,6 +170,7 @@ void mips3_device::mips3drc_set_options(UINT32 options)
 {
 	if (!allow_drc()) return;
 	m_drcoptions = options;
+	m_cache_dirty = TRUE;
 }
 
 /*-------------------------------------------------
@@ -196,6 +197,10 @@ void mips3_device::clear_fastram(UINT32 select_start)
 
 void mips3_device::add_fastram(offs_t start, offs_t end, UINT8 readonly, void *base)
 {
+	/* the verifier needs to see every access */
+	if (m_verifier != nullptr)
+		return;
+
 	if (m_fastram_select < ARRAY_LENGTH(m_fastram))
 	{
 		m_fastram[m_fastram_select].start = start;
@@ -206,6 +211,7 @@ void mips3_device::add_fastram(offs_t start, offs_t end, UINT8 readonly, void *b
 		m_fastram[m_fastram_select].offset_base16 = (UINT16*)((UINT8*)base - start);
 		m_fastram[m_fastram_select].offset_base32 = (UINT32*)((UINT8*)base - start);
 		m_fastram_select++;
+		m_cache_dirty = TRUE;
 	}
 }
 
@@ -223,10 +229,23 @@ void mips3_device::mips3drc_add_hotspot(offs_t pc, UINT32 opcode, UINT32 cycles)
 		m_hotspot[m_hotspot_select].opcode = opcode;
 		m_hotspot[m_hotspot_select].cycles = cycles;
 		m_hotspot_select++;
+		m_cache_dirty = TRUE;
 	}
 }
 
 
+/*-------------------------------------------------
+    mips3drc_invalidate_code - drop any compiled
+    blocks covering the given range of code
+-------------------------------------------------*/
+
+void mips3_device::mips3drc_invalidate_code(offs_t start, offs_t end)
+{
+	if (!allow_drc()) return;
+	m_drcuml->invalidate_code(start, end);
+}
+
+
 
 /***************************************************************************
     CACHE MANAGEMENT
@@ -244,6 +263,31 @@ void mips3_device::code_flush_cache()
 	/* empty the transient cache contents */
 	m_drcuml->reset();
 
+	/* describe everything that affects generated code to the persistent block cache */
+	m_drcuml->persist_signature(m_flavor);
+	m_drcuml->persist_signature(m_bigendian);
+	m_drcuml->persist_signature(m_drcoptions);
+	m_drcuml->persist_signature(m_tlbentries);
+	m_drcuml->persist_signature(m_verifier != nullptr);
+	m_drcuml->persist_signature(machine().debug_flags & DEBUG_FLAG_ENABLED);
+	m_drcuml->persist_signature(PROBE_ADDRESS);
+	for (int ramnum = 0; ramnum < m_fastram_select; ramnum++)
+	{
+		m_drcuml->persist_signature(m_fastram[ramnum].start);
+		m_drcuml->persist_signature(m_fastram[ramnum].end);
+		m_drcuml->persist_signature(m_fastram[ramnum].readonly);
+	}
+	for (int hotnum = 0; hotnum < m_hotspot_select; hotnum++)
+	{
+		m_drcuml->persist_signature(m_hotspot[hotnum].pc);
+		m_drcuml->persist_signature(m_hotspot[hotnum].opcode);
+		m_drcuml->persist_signature(m_hotspot[hotnum].cycles);
+	}
+	m_drcuml->persist_region(this, sizeof(*this));
+	m_drcuml->persist_region(vtlb_table(), vtlb_table_size() * sizeof(vtlb_entry));
+	for (int ramnum = 0; ramnum < m_fastram_select; ramnum++)
+		m_drcuml->persist_region(m_fastram[ramnum].base, m_fastram[ramnum].end + 1 - m_fastram[ramnum].start);
+
 	try
 	{
 		/* generate the entry point and out-of-cycles handlers */
@@ -303,23 +347,33 @@ void mips3_device::code_compile_block(UINT8 mode, offs_t pc)
 	drcuml_state *drcuml = m_drcuml.get();
 	compiler_state compiler = { 0 };
 	const opcode_desc *seqhead, *seqlast;
-	const opcode_desc *desclist;
+	const opcode_desc *desclist = nullptr;
 	int override = FALSE;
 	drcuml_block *block;
 
 	g_profiler.start(PROFILER_DRC_COMPILE);
 
-	/* get a description of this sequence */
-	desclist = m_drcfe->describe_code(pc);
-	if (drcuml->logging() || drcuml->logging_native())
-		log_opcode_desc(drcuml, desclist, 0);
-
 	/* if we get an error back, flush the cache and try again */
 	bool succeeded = false;
 	while (!succeeded)
 	{
 		try
 		{
+			/* reuse the persisted block if the code hasn't changed */
+			if (drcuml->persist_restore(mode, pc))
+			{
+				g_profiler.stop();
+				return;
+			}
+
+			/* get a description of this sequence */
+			if (desclist == nullptr)
+			{
+				desclist = m_drcfe->describe_code(pc);
+				if (drcuml->logging() || drcuml->logging_native())
+					log_opcode_desc(drcuml, desclist, 0);
+			}
+
 			/* start the block */
 			block = drcuml->begin_block(4096);
 
@@ -368,10 +422,25 @@ void mips3_device::code_compile_block(UINT8 mode, offs_t pc)
 				if (seqhead->flags & OPFLAG_IS_BRANCH_TARGET)
 					UML_LABEL(block, seqhead->pc | 0x80000000);                             // label   seqhead->pc | 0x80000000
 
+				/* let the verifier check everything since the last sequence */
+				if (m_verifier != nullptr)
+				{
+					UML_MOV(block, mem(m_verifier->boundary_pc()), seqhead->pc);            // mov     [boundary_pc],seqhead->pc
+					UML_CALLC(block, drc_verifier::static_block_start, m_verifier.get());   // callc   block_start,verifier
+				}
+
 				/* iterate over instructions in the sequence and compile them */
 				for (curdesc = seqhead; curdesc != seqlast->next(); curdesc = curdesc->next())
 					generate_sequence_instruction(block, &compiler, curdesc);
 
+				/* note the guest code covered, including any delay slots */
+				for (curdesc = seqhead; curdesc != seqlast->next(); curdesc = curdesc->next())
+				{
+					block->add_code_range(curdesc->pc, curdesc->pc + curdesc->length - 1);
+					if (curdesc->delay.first() != nullptr)
+						block->add_code_range(curdesc->delay.first()->pc, curdesc->delay.first()->pc + curdesc->delay.first()->length - 1);
+				}
+
 				/* if we need to return to the start, do it */
 				if (seqlast->flags & OPFLAG_RETURN_TO_START)
 					nextpc = pc;
@@ -420,6 +489,11 @@ static void cfunc_mips3com_asid_changed(void *param)
 	((mips3_device *)param)->mips3com_asid_changed();
 }
 
+static void cfunc_mips3com_icache_hit_invalidate(void *param)
+{
+	((mips3_device *)param)->mips3com_icache_hit_invalidate();
+}
+
 static void cfunc_mips3com_tlbr(void *param)
 {
 	((mips3_device *)param)->mips3com_tlbr();
@@ -765,6 +839,10 @@ void mips3_device::static_generate_exception(UINT8 exception, int recover, const
 		UML_RECOVER(block, I1, MAPVAR_CYCLES);                                  // recover i1,CYCLES
 	}
 
+	/* an interrupt can't be replayed, so tell the verifier */
+	if (exception == EXCEPTION_INTERRUPT && m_verifier != nullptr)
+		UML_CALLC(block, drc_verifier::static_interrupt, m_verifier.get());        // callc   interrupt,verifier
+
 	UML_AND(block, I2, CPR032(COP0_Cause), ~0x800000ff);                    // and     i2,[Cause],~0x800000ff
 	UML_TEST(block, I0, 1);                                             // test    i0,1
 	UML_JMPc(block, COND_Z, next);                                                  // jz      <next>
@@ -953,7 +1031,20 @@ void mips3_device::static_generate_memory_accessor(int mode, int size, int iswri
 				UML_LABEL(block, skip);                                             // skip:
 			}
 
-	switch (size)
+	/* when verifying, the verifier performs the access so it can log it */
+	if (m_verifier != nullptr)
+	{
+		UML_MOV(block, mem(m_verifier->access_address()), I0);                      // mov     [access_address],i0
+		if (iswrite)
+			UML_DMOV(block, mem(m_verifier->access_data()), I1);                    // dmov    [access_data],i1
+		if (ismasked)
+			UML_DMOV(block, mem(m_verifier->access_mask()), I2);                    // dmov    [access_mask],i2
+		UML_CALLC(block, drc_verifier::access_callout(size, iswrite, ismasked), m_verifier.get());
+																					// callc   access,verifier
+		if (!iswrite)
+			UML_DMOV(block, I0, mem(m_verifier->access_data()));                    // dmov    i0,[access_data]
+	}
+	else switch (size)
 	{
 		case 1:
 			if (iswrite)
@@ -1235,6 +1326,7 @@ void mips3_device::generate_sequence_instruction(drcuml_block *block, compiler_s
 	{
 		if (PRINTF_MMU)
 		{
+			block->persist_exclude();
 			static const char text[] = "Compiler page fault @ %08X";
 			UML_MOV(block, mem(&m_core->format), (FPTR)text);          // mov     [format],text
 			UML_MOV(block, mem(&m_core->arg0), desc->pc);              // mov     [arg0],desc->pc
@@ -1253,6 +1345,7 @@ void mips3_device::generate_sequence_instruction(drcuml_block *block, compiler_s
 		{
 			if (PRINTF_MMU)
 			{
+				block->persist_exclude();
 				static const char text[] = "Checking TLB at @ %08X\n";
 				UML_MOV(block, mem(&m_core->format), (FPTR)text);      // mov     [format],text
 				UML_MOV(block, mem(&m_core->arg0), desc->pc);          // mov     [arg0],desc->pc
@@ -1268,6 +1361,7 @@ void mips3_device::generate_sequence_instruction(drcuml_block *block, compiler_s
 		{
 			if (PRINTF_MMU)
 			{
+				block->persist_exclude();
 				static const char text[] = "No valid TLB @ %08X\n";
 				UML_MOV(block, mem(&m_core->format), (FPTR)text);      // mov     [format],text
 				UML_MOV(block, mem(&m_core->arg0), desc->pc);          // mov     [arg0],desc->pc
@@ -1844,10 +1938,18 @@ int mips3_device::generate_opcode(drcuml_block *block, compiler_state *compiler,
 
 		/* ----- effective no-ops ----- */
 
-		case 0x2f:  /* CACHE - MIPS II */
 		case 0x33:  /* PREF - MIPS IV */
 			return TRUE;
 
+		case 0x2f:  /* CACHE - MIPS II */
+			/* Hit_Invalidate_I drops compiled code for the line; the rest are effective no-ops */
+			if (RTREG == 0x10)
+			{
+				UML_ADD(block, mem(&m_core->arg0), R32(RSREG), SIMMVAL);                   // add     [arg0],<rsreg>,SIMMVAL
+				UML_CALLC(block, cfunc_mips3com_icache_hit_invalidate, this);              // callc   icache_hit_invalidate,mips3
+			}
+			return TRUE;
+
 
 		/* ----- coprocessor instructions ----- */
 
@@ -4107,3 +4209,86 @@ void mips3_device::log_opcode_desc(drcuml_state *drcuml, const opcode_desc *desc
 			drcuml->log_printf("-----\n");
 	}
 }
+
+
+
+/***************************************************************************
+    LOCKSTEP VERIFICATION
+***************************************************************************/
+
+/*-------------------------------------------------
+    verifier - constructor
+-------------------------------------------------*/
+
+mips3_device::verifier::verifier(mips3_device &cpu)
+	: drc_verifier(cpu, *cpu.m_drcuml, *cpu.m_program),
+		m_mips(cpu)
+{
+	/* COUNT is derived from the total cycles, which the interpreter doesn't reproduce */
+	ignore_register(MIPS3_COUNT);
+}
+
+
+/*-------------------------------------------------
+    save_state - snapshot everything the
+    interpreter and recompiler can change
+-------------------------------------------------*/
+
+void mips3_device::verifier::save_state(std::vector<UINT8> &buffer)
+{
+	buffer.clear();
+	save_item(buffer, *m_mips.m_core);
+	save_item(buffer, m_mips.m_ppc);
+	save_item(buffer, m_mips.m_nextpc);
+	save_item(buffer, m_mips.m_delayslot);
+	save_item(buffer, m_mips.m_interrupt_cycles);
+	save_item(buffer, m_mips.m_ll_value);
+	save_item(buffer, m_mips.m_lld_value);
+	save_item(buffer, m_mips.m_badcop_value);
+	save_item(buffer, m_mips.m_tlb);
+}
+
+
+/*-------------------------------------------------
+    restore_state - restore a snapshot
+-------------------------------------------------*/
+
+void mips3_device::verifier::restore_state(const std::vector<UINT8> &buffer)
+{
+	const UINT8 *data = &buffer[0];
+	restore_item(data, *m_mips.m_core);
+	restore_item(data, m_mips.m_ppc);
+	restore_item(data, m_mips.m_nextpc);
+	restore_item(data, m_mips.m_delayslot);
+	restore_item(data, m_mips.m_interrupt_cycles);
+	restore_item(data, m_mips.m_ll_value);
+	restore_item(data, m_mips.m_lld_value);
+	restore_item(data, m_mips.m_badcop_value);
+	restore_item(data, m_mips.m_tlb);
+}
+
+
+/*-------------------------------------------------
+    set_pc - set the PC at a sequence boundary,
+    which is never in a delay slot
+-------------------------------------------------*/
+
+void mips3_device::verifier::set_pc(offs_t pc)
+{
+	m_mips.m_core->pc = pc;
+	m_mips.m_nextpc = ~0;
+}
+
+
+/*-------------------------------------------------
+    step - run one instruction, plus its delay
+    slot, on the interpreter
+-------------------------------------------------*/
+
+void mips3_device::verifier::step()
+{
+	m_mips.m_isdrc = false;
+	m_mips.m_core->icount = 1;
+	m_mips.execute_run();
+	m_mips.m_isdrc = true;
+}
@@ -216,9 +216,12 @@ bool mips3_frontend::describe(opcode_desc &desc, const opcode_desc *prev)
 		case 0x33:  // PREF
 			if (m_mips3->m_flavor < mips3_device::MIPS3_TYPE_MIPS_IV)
 				return false;
-		case 0x2f:  // CACHE
 			// effective no-op
 			return true;
+
+		case 0x2f:  // CACHE
+			desc.regin[0] |= REGFLAG_R(RSREG);
+			return true;
 	}
 
 	return false;
@@ -220,6 +220,7 @@ public:
 	void ppcdrc_set_options(UINT32 options);
 	void ppcdrc_add_fastram(offs_t start, offs_t end, UINT8 readonly, void *base);
 	void ppcdrc_add_hotspot(offs_t pc, UINT32 opcode, UINT32 cycles);
+	void ppcdrc_invalidate_code(offs_t start, offs_t end);
 
 	TIMER_CALLBACK_MEMBER(decrementer_int_callback);
 	TIMER_CALLBACK_MEMBER(ppc4xx_buffered_dma_callback);
@@ -234,6 +235,7 @@ public:
 	void ppccom_tlb_fill();
 	void ppccom_update_fprf();
 	void ppccom_dcstore_callback();
+	void ppccom_execute_icbi();
 	void ppccom_execute_tlbie();
 	void ppccom_execute_tlbia();
 	void ppccom_execute_tlbl();
@@ -645,6 +647,7 @@ protected:
 	UINT32 compute_crf_mask(UINT8 crm);
 	UINT32 compute_spr(UINT32 spr);
 	void code_flush_cache();
+	bool code_page_is_rom(offs_t pc);
 	void code_compile_block(UINT8 mode, offs_t pc);
 	void static_generate_entry_point();
 	void static_generate_nocode_handler();
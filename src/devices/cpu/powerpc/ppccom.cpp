@@ -1220,9 +1220,14 @@ void ppc_device::device_reset()
 		}
 	}
 
-	/* Mark the cache dirty */
 	m_core->mode = 0;
-	m_cache_dirty = TRUE;
+
+	/* code compiled from ROM survives a reset; anything in RAM may be reloaded */
+	if (m_drcuml != nullptr)
+		m_drcuml->invalidate_code_pages([this](offs_t start, offs_t end)
+		{
+			return !code_page_is_rom(start) || !code_page_is_rom(end);
+		});
 }
 
 
@@ -1254,6 +1259,19 @@ void ppc_device::ppccom_dcstore_callback()
 }
 
 
+/*-------------------------------------------------
+    ppccom_execute_icbi - drop any compiled code
+    in the instruction cache block being
+    invalidated
+-------------------------------------------------*/
+
+void ppc_device::ppccom_execute_icbi()
+{
+	offs_t start = m_core->param0 & ~(m_cache_line_size - 1);
+	m_drcuml->invalidate_code(start, start + m_cache_line_size - 1);
+}
+
+
 /***************************************************************************
     TLB HANDLING
 ***************************************************************************/
@@ -1471,6 +1489,19 @@ bool ppc_device::memory_translate(address_spacenum spacenum, int intention, offs
 }
 
 
+/*-------------------------------------------------
+    code_page_is_rom - determine whether code at
+    the given PC comes from ROM
+-------------------------------------------------*/
+
+bool ppc_device::code_page_is_rom(offs_t pc)
+{
+	if (!memory_translate(AS_PROGRAM, TRANSLATE_FETCH, pc))
+		return false;
+	return m_program->get_read_ptr(pc) != nullptr && m_program->get_write_ptr(pc) == nullptr;
+}
+
+
 /*-------------------------------------------------
     ppccom_tlb_fill - handle a missing TLB entry
 -------------------------------------------------*/
@@ -260,6 +260,7 @@ void ppc_device::execute_run()
 void ppc_device::ppcdrc_set_options(UINT32 options)
 {
 	m_drcoptions = options;
+	m_cache_dirty = TRUE;
 }
 
 
@@ -277,6 +278,7 @@ void ppc_device::ppcdrc_add_fastram(offs_t start, offs_t end, UINT8 readonly, vo
 		m_fastram[m_fastram_select].readonly = readonly;
 		m_fastram[m_fastram_select].base = base;
 		m_fastram_select++;
+		m_cache_dirty = TRUE;
 	}
 }
 
@@ -293,10 +295,22 @@ void ppc_device::ppcdrc_add_hotspot(offs_t pc, UINT32 opcode, UINT32 cycles)
 		m_hotspot[m_hotspot_select].opcode = opcode;
 		m_hotspot[m_hotspot_select].cycles = cycles;
 		m_hotspot_select++;
+		m_cache_dirty = TRUE;
 	}
 }
 
 
+/*-------------------------------------------------
+    ppcdrc_invalidate_code - drop any compiled
+    blocks covering the given range of code
+-------------------------------------------------*/
+
+void ppc_device::ppcdrc_invalidate_code(offs_t start, offs_t end)
+{
+	m_drcuml->invalidate_code(start, end);
+}
+
+
 
 /***************************************************************************
     CACHE MANAGEMENT
@@ -312,6 +326,31 @@ void ppc_device::code_flush_cache()
 	/* empty the transient cache contents */
 	m_drcuml->reset();
 
+	/* describe everything that affects generated code to the persistent block cache */
+	m_drcuml->persist_signature(m_flavor);
+	m_drcuml->persist_signature(m_cap);
+	m_drcuml->persist_signature(m_cache_line_size);
+	m_drcuml->persist_signature(m_tb_divisor);
+	m_drcuml->persist_signature(m_drcoptions);
+	m_drcuml->persist_signature(machine().debug_flags & DEBUG_FLAG_ENABLED);
+	m_drcuml->persist_signature(PROBE_ADDRESS);
+	for (int ramnum = 0; ramnum < m_fastram_select; ramnum++)
+	{
+		m_drcuml->persist_signature(m_fastram[ramnum].start);
+		m_drcuml->persist_signature(m_fastram[ramnum].end);
+		m_drcuml->persist_signature(m_fastram[ramnum].readonly);
+	}
+	for (int hotnum = 0; hotnum < m_hotspot_select; hotnum++)
+	{
+		m_drcuml->persist_signature(m_hotspot[hotnum].pc);
+		m_drcuml->persist_signature(m_hotspot[hotnum].opcode);
+		m_drcuml->persist_signature(m_hotspot[hotnum].cycles);
+	}
+	m_drcuml->persist_region(this, sizeof(*this));
+	m_drcuml->persist_region(vtlb_table(), vtlb_table_size() * sizeof(vtlb_entry));
+	for (int ramnum = 0; ramnum < m_fastram_select; ramnum++)
+		m_drcuml->persist_region(m_fastram[ramnum].base, m_fastram[ramnum].end + 1 - m_fastram[ramnum].start);
+
 	try
 	{
 		/* generate the entry point and out-of-cycles handlers */
@@ -382,22 +421,32 @@ void ppc_device::code_compile_block(UINT8 mode, offs_t pc)
 {
 	compiler_state compiler = { 0 };
 	const opcode_desc *seqhead, *seqlast;
-	const opcode_desc *desclist;
+	const opcode_desc *desclist = nullptr;
 	int override = FALSE;
 	drcuml_block *block;
 
 	g_profiler.start(PROFILER_DRC_COMPILE);
 
-	/* get a description of this sequence */
-	desclist = m_drcfe->describe_code(pc);
-	if (m_drcuml->logging() || m_drcuml->logging_native())
-		log_opcode_desc(m_drcuml.get(), desclist, 0);
-
 	bool succeeded = false;
 	while (!succeeded)
 	{
 		try
 		{
+			/* reuse the persisted block if the code hasn't changed */
+			if (m_drcuml->persist_restore(mode, pc))
+			{
+				g_profiler.stop();
+				return;
+			}
+
+			/* get a description of this sequence */
+			if (desclist == nullptr)
+			{
+				desclist = m_drcfe->describe_code(pc);
+				if (m_drcuml->logging() || m_drcuml->logging_native())
+					log_opcode_desc(m_drcuml.get(), desclist, 0);
+			}
+
 			/* start the block */
 			block = m_drcuml->begin_block(4096);
 
@@ -450,6 +499,14 @@ void ppc_device::code_compile_block(UINT8 mode, offs_t pc)
 				for (curdesc = seqhead; curdesc != seqlast->next(); curdesc = curdesc->next())
 					generate_sequence_instruction(block, &compiler, curdesc);                  // <instruction>
 
+				/* note the guest code covered, including any delay slots */
+				for (curdesc = seqhead; curdesc != seqlast->next(); curdesc = curdesc->next())
+				{
+					block->add_code_range(curdesc->pc, curdesc->pc + curdesc->length - 1);
+					if (curdesc->delay.first() != nullptr)
+						block->add_code_range(curdesc->delay.first()->pc, curdesc->delay.first()->pc + curdesc->delay.first()->length - 1);
+				}
+
 				/* if we need to return to the start, do it */
 				if (seqlast->flags & OPFLAG_RETURN_TO_START)
 					nextpc = pc;
@@ -590,6 +647,12 @@ static void cfunc_ppccom_dcstore_callback(void *param)
 	ppc->ppccom_dcstore_callback();
 }
 
+static void cfunc_ppccom_execute_icbi(void *param)
+{
+	ppc_device *ppc = (ppc_device *)param;
+	ppc->ppccom_execute_icbi();
+}
+
 static void cfunc_ppccom_execute_tlbie(void *param)
 {
 	ppc_device *ppc = (ppc_device *)param;
@@ -1695,6 +1758,7 @@ void ppc_device::generate_sequence_instruction(drcuml_block *block, compiler_sta
 	{
 		UML_MOV(block, mem(&m_core->pc), desc->pc);                                        // mov     [pc],desc->pc
 		UML_CALLC(block, cfunc_printf_probe, (void *)(FPTR)desc->pc);                                       // callc   cfunc_printf_probe,desc->pc
+		block->persist_exclude();
 	}
 
 	/* if we are debugging, call the debugger */
@@ -1720,6 +1784,7 @@ void ppc_device::generate_sequence_instruction(drcuml_block *block, compiler_sta
 	{
 		if (PRINTF_MMU)
 		{
+			block->persist_exclude();
 			const char *text = "Compiler page fault @ %08X\n";
 			UML_MOV(block, mem(&m_core->format), (FPTR)text);                    // mov     [format],text
 			UML_MOV(block, mem(&m_core->arg0), desc->pc);                        // mov     [arg0],desc->pc
@@ -1738,6 +1803,7 @@ void ppc_device::generate_sequence_instruction(drcuml_block *block, compiler_sta
 		{
 			if (PRINTF_MMU)
 			{
+				block->persist_exclude();
 				const char *text = "Checking TLB at @ %08X\n";
 				UML_MOV(block, mem(&m_core->format), (FPTR)text);                // mov     [format],text
 				UML_MOV(block, mem(&m_core->arg0), desc->pc);                    // mov     [arg0],desc->pc
@@ -1753,6 +1819,7 @@ void ppc_device::generate_sequence_instruction(drcuml_block *block, compiler_sta
 		{
 			if (PRINTF_MMU)
 			{
+				block->persist_exclude();
 				const char *text = "No valid TLB @ %08X\n";
 				UML_MOV(block, mem(&m_core->format), (FPTR)text);                // mov     [format],text
 				UML_MOV(block, mem(&m_core->arg0), desc->pc);                    // mov     [arg0],desc->pc
@@ -3213,10 +3280,15 @@ int ppc_device::generate_instruction_1f(drcuml_block *block, compiler_state *com
 			UML_CALLC(block, (c_function)cfunc_ppccom_dcstore_callback, this);
 			return TRUE;
 
+		case 0x3d6: /* ICBI */
+			UML_ADD(block, I0, R32Z(G_RA(op)), R32(G_RB(op)));                          // add     i0,ra,rb
+			UML_MOV(block, mem(&m_core->param0), I0);                                      // mov     [param0],i0
+			UML_CALLC(block, (c_function)cfunc_ppccom_execute_icbi, this);             // callc   execute_icbi,ppc
+			return TRUE;
+
 		case 0x056: /* DCBF */
 		case 0x0f6: /* DCBTST */
 		case 0x116: /* DCBT */
-		case 0x3d6: /* ICBI */
 		case 0x256: /* SYNC */
 		case 0x356: /* EIEIO */
 		case 0x1d6: /* DCBI */
@@ -199,6 +199,7 @@ sh2_device::sh2_device(const machine_config &mconfig, const char *tag, device_t
 
 void sh2_device::device_stop()
 {
+	m_verifier = nullptr;
 }
 
 
@@ -265,16 +266,20 @@ offs_t sh2_device::disasm_disassemble(char *buffer, offs_t pc, const UINT8 *opro
 UINT8 sh2_device::RB(offs_t A)
 {
 	if((A & 0xf0000000) == 0 || (A & 0xf0000000) == 0x20000000)
-		return m_program->read_byte(A & AM);
+		A &= AM;
 
+	if (m_verifier != nullptr)
+		return m_verifier->read(1, A, 0xff);
 	return m_program->read_byte(A);
 }
 
 UINT16 sh2_device::RW(offs_t A)
 {
 	if((A & 0xf0000000) == 0 || (A & 0xf0000000) == 0x20000000)
-		return m_program->read_word(A & AM);
+		A &= AM;
 
+	if (m_verifier != nullptr)
+		return m_verifier->read(2, A, 0xffff);
 	return m_program->read_word(A);
 }
 
@@ -283,44 +288,46 @@ UINT32 sh2_device::RL(offs_t A)
 	/* 0x20000000 no Cache */
 	/* 0x00000000 read thru Cache if CE bit is 1 */
 	if((A & 0xf0000000) == 0 || (A & 0xf0000000) == 0x20000000)
-		return m_program->read_dword(A & AM);
+		A &= AM;
 
+	if (m_verifier != nullptr)
+		return m_verifier->read(4, A, 0xffffffff);
 	return m_program->read_dword(A);
 }
 
 void sh2_device::WB(offs_t A, UINT8 V)
 {
 	if((A & 0xf0000000) == 0 || (A & 0xf0000000) == 0x20000000)
-	{
-		m_program->write_byte(A & AM,V);
-		return;
-	}
+		A &= AM;
 
-	m_program->write_byte(A,V);
+	if (m_verifier != nullptr)
+		m_verifier->write(1, A, V, 0xff);
+	else
+		m_program->write_byte(A,V);
 }
 
 void sh2_device::WW(offs_t A, UINT16 V)
 {
 	if((A & 0xf0000000) == 0 || (A & 0xf0000000) == 0x20000000)
-	{
-		m_program->write_word(A & AM,V);
-		return;
-	}
+		A &= AM;
 
-	m_program->write_word(A,V);
+	if (m_verifier != nullptr)
+		m_verifier->write(2, A, V, 0xffff);
+	else
+		m_program->write_word(A,V);
 }
 
 void sh2_device::WL(offs_t A, UINT32 V)
 {
-	if((A & 0xf0000000) == 0 || (A & 0xf0000000) == 0x20000000)
-	{
-		m_program->write_dword(A & AM,V);
-		return;
-	}
-
 	/* 0x20000000 no Cache */
 	/* 0x00000000 read thru Cache if CE bit is 1 */
-	m_program->write_dword(A,V);
+	if((A & 0xf0000000) == 0 || (A & 0xf0000000) == 0x20000000)
+		A &= AM;
+
+	if (m_verifier != nullptr)
+		m_verifier->write(4, A, V, 0xffffffff);
+	else
+		m_program->write_dword(A,V);
 }
 
 /*  code                 cycles  t-bit
@@ -2284,7 +2291,13 @@ void sh2_device::device_reset()
 
 	m_sh2_state->internal_irq_level = -1;
 
-	m_cache_dirty = TRUE;
+	/* code compiled from ROM survives a reset; anything in RAM may be reloaded */
+	if (m_isdrc && m_drcuml != nullptr)
+		m_drcuml->invalidate_code_pages([this](offs_t start, offs_t end)
+		{
+			return m_program->get_write_ptr(start & AM) != nullptr || m_program->get_read_ptr(start & AM) == nullptr
+				|| m_program->get_write_ptr(end & AM) != nullptr || m_program->get_read_ptr(end & AM) == nullptr;
+		});
 }
 
 
@@ -2533,6 +2546,10 @@ void sh2_device::device_start()
 	UINT32 flags = 0;
 	m_drcuml = std::make_unique<drcuml_state>(*this, m_cache, flags, 1, 32, 1);
 
+	/* check the recompiler against the interpreter if requested */
+	if (m_isdrc && drc_verifier::requested(*this))
+		m_verifier = std::make_unique<verifier>(*this);
+
 	/* add symbols for our stuff */
 	m_drcuml->symbol_add(&m_sh2_state->pc, sizeof(m_sh2_state->pc), "pc");
 	m_drcuml->symbol_add(&m_sh2_state->icount, sizeof(m_sh2_state->icount), "icount");
@@ -2560,7 +2577,8 @@ void sh2_device::device_start()
 
 	/* if we have registers to spare, assign r0, r1, r2 to leftovers */
 	/* WARNING: do not use synthetic registers that are mapped here! */
-	if (!DISABLE_FAST_REGISTERS)
+	/* (not when verifying, since the interpreter only sees registers in memory) */
+	if (!DISABLE_FAST_REGISTERS && m_verifier == nullptr)
 	{
 		drcbe_info beinfo;
 		m_drcuml->get_backend_info(beinfo);
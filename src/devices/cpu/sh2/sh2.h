@@ -19,6 +19,7 @@
 
 #include "cpu/drcfe.h"
 #include "cpu/drcuml.h"
+#include "cpu/drcverify.h"
 
 
 #define SH2_INT_NONE    -1
@@ -108,6 +109,7 @@ public:
 	void sh2drc_set_options(UINT32 options);
 	void sh2drc_add_pcflush(offs_t address);
 	void sh2drc_add_fastram(offs_t start, offs_t end, UINT8 readonly, void *base);
+	void sh2drc_invalidate_code(offs_t start, offs_t end);
 
 	void sh2_notify_dma_data_available();
 
@@ -225,6 +227,24 @@ private:
 
 	internal_sh2_state *m_sh2_state;
 
+	/* lockstep verification against the interpreter */
+	class verifier : public drc_verifier
+	{
+	public:
+		verifier(sh2_device &cpu);
+
+	protected:
+		virtual void save_state(std::vector<UINT8> &buffer) override;
+		virtual void restore_state(const std::vector<UINT8> &buffer) override;
+		virtual offs_t pc() override { return m_sh2.m_sh2_state->pc; }
+		virtual void set_pc(offs_t pc) override;
+		virtual void step() override;
+
+	private:
+		sh2_device &        m_sh2;
+	};
+	std::unique_ptr<verifier> m_verifier;
+
 	/* internal stuff */
 	UINT8               m_cache_dirty;                /* true if we need to flush the cache */
 
@@ -852,6 +852,10 @@ void sh2_device::sh2_exception(const char *message, int irqline)
 		LOG(("SH-2 '%s' nmi exception (autovector: $%x) after [%s]\n", tag(), vector, message));
 	}
 
+	/* a taken interrupt can't be replayed, so tell the verifier */
+	if (m_verifier != nullptr)
+		m_verifier->interrupt();
+
 	if (m_isdrc)
 	{
 		m_sh2_state->evec = RL( m_sh2_state->vbr + vector * 4 );
@@ -590,6 +590,24 @@ void sh2_device::code_flush_cache()
 	/* empty the transient cache contents */
 	drcuml->reset();
 
+	/* describe everything that affects generated code to the persistent block cache */
+	drcuml->persist_signature(m_cpu_type);
+	drcuml->persist_signature(m_drcoptions);
+	drcuml->persist_signature(m_verifier != nullptr);
+	drcuml->persist_signature(machine().debug_flags & DEBUG_FLAG_ENABLED);
+	drcuml->persist_signature(PROBE_ADDRESS);
+	for (int ramnum = 0; ramnum < m_fastram_select; ramnum++)
+	{
+		drcuml->persist_signature(m_fastram[ramnum].start);
+		drcuml->persist_signature(m_fastram[ramnum].end);
+		drcuml->persist_signature(m_fastram[ramnum].readonly);
+	}
+	for (int flushnum = 0; flushnum < m_pcfsel; flushnum++)
+		drcuml->persist_signature(m_pcflushes[flushnum]);
+	drcuml->persist_region(this, sizeof(*this));
+	for (int ramnum = 0; ramnum < m_fastram_select; ramnum++)
+		drcuml->persist_region(m_fastram[ramnum].base, m_fastram[ramnum].end + 1 - m_fastram[ramnum].start);
+
 	try
 	{
 		/* generate the entry point and out-of-cycles handlers */
@@ -667,22 +685,32 @@ void sh2_device::code_compile_block(UINT8 mode, offs_t pc)
 	drcuml_state *drcuml = m_drcuml.get();
 	compiler_state compiler = { 0 };
 	const opcode_desc *seqhead, *seqlast;
-	const opcode_desc *desclist;
+	const opcode_desc *desclist = nullptr;
 	int override = FALSE;
 	drcuml_block *block;
 
 	g_profiler.start(PROFILER_DRC_COMPILE);
 
-	/* get a description of this sequence */
-	desclist = m_drcfe->describe_code(pc);
-	if (drcuml->logging() || drcuml->logging_native())
-		log_opcode_desc(drcuml, desclist, 0);
-
 	bool succeeded = false;
 	while (!succeeded)
 	{
 		try
 		{
+			/* reuse the persisted block if the code hasn't changed */
+			if (drcuml->persist_restore(mode, pc))
+			{
+				g_profiler.stop();
+				return;
+			}
+
+			/* get a description of this sequence */
+			if (desclist == nullptr)
+			{
+				desclist = m_drcfe->describe_code(pc);
+				if (drcuml->logging() || drcuml->logging_native())
+					log_opcode_desc(drcuml, desclist, 0);
+			}
+
 			/* start the block */
 			block = drcuml->begin_block(4096);
 
@@ -733,12 +761,27 @@ void sh2_device::code_compile_block(UINT8 mode, offs_t pc)
 					UML_LABEL(block, seqhead->pc | 0x80000000);                             // label   seqhead->pc | 0x80000000
 				}
 
+				/* let the verifier check everything since the last sequence */
+				if (m_verifier != nullptr)
+				{
+					UML_MOV(block, mem(m_verifier->boundary_pc()), seqhead->pc);            // mov     [boundary_pc],seqhead->pc
+					UML_CALLC(block, drc_verifier::static_block_start, m_verifier.get());   // callc   block_start,verifier
+				}
+
 				/* iterate over instructions in the sequence and compile them */
 				for (curdesc = seqhead; curdesc != seqlast->next(); curdesc = curdesc->next())
 				{
 					generate_sequence_instruction(block, &compiler, curdesc, 0xffffffff);
 				}
 
+				/* note the guest code covered, including any delay slots */
+				for (curdesc = seqhead; curdesc != seqlast->next(); curdesc = curdesc->next())
+				{
+					block->add_code_range(curdesc->pc, curdesc->pc + curdesc->length - 1);
+					if (curdesc->delay.first() != nullptr)
+						block->add_code_range(curdesc->delay.first()->pc, curdesc->delay.first()->pc + curdesc->delay.first()->length - 1);
+				}
+
 				/* if we need to return to the start, do it */
 				if (seqlast->flags & OPFLAG_RETURN_TO_START)
 				{
@@ -992,7 +1035,18 @@ void sh2_device::static_generate_memory_accessor(int size, int iswrite, const ch
 		}
 	}
 
-	if (iswrite)
+	/* when verifying, the verifier performs the access so it can log it */
+	if (m_verifier != nullptr)
+	{
+		UML_MOV(block, mem(m_verifier->access_address()), I0);                      // mov     [access_address],i0
+		if (iswrite)
+			UML_DMOV(block, mem(m_verifier->access_data()), I1);                    // dmov    [access_data],i1
+		UML_CALLC(block, drc_verifier::access_callout(size, iswrite, false), m_verifier.get());
+																					// callc   access,verifier
+		if (!iswrite)
+			UML_DMOV(block, I0, mem(m_verifier->access_data()));                    // dmov    i0,[access_data]
+	}
+	else if (iswrite)
 	{
 		switch (size)
 		{
@@ -2947,6 +3001,7 @@ void sh2_device::sh2drc_set_options(UINT32 options)
 {
 	if (!allow_drc()) return;
 	m_drcoptions = options;
+	m_cache_dirty = TRUE;
 }
 
 
@@ -2961,6 +3016,19 @@ void sh2_device::sh2drc_add_pcflush(offs_t address)
 
 	if (m_pcfsel < ARRAY_LENGTH(m_pcflushes))
 		m_pcflushes[m_pcfsel++] = address;
+	m_cache_dirty = TRUE;
+}
+
+
+/*-------------------------------------------------
+    sh2drc_invalidate_code - drop any compiled
+    blocks covering the given range of code
+-------------------------------------------------*/
+
+void sh2_device::sh2drc_invalidate_code(offs_t start, offs_t end)
+{
+	if (!allow_drc()) return;
+	m_drcuml->invalidate_code(start, end);
 }
 
 
@@ -2971,6 +3039,10 @@ void sh2_device::sh2drc_add_pcflush(offs_t address)
 
 void sh2_device::sh2drc_add_fastram(offs_t start, offs_t end, UINT8 readonly, void *base)
 {
+	/* the verifier needs to see every access */
+	if (m_verifier != nullptr)
+		return;
+
 	if (m_fastram_select < ARRAY_LENGTH(m_fastram))
 	{
 		m_fastram[m_fastram_select].start = start;
@@ -2978,5 +3050,82 @@ void sh2_device::sh2drc_add_fastram(offs_t start, offs_t end, UINT8 readonly, vo
 		m_fastram[m_fastram_select].readonly = readonly;
 		m_fastram[m_fastram_select].base = base;
 		m_fastram_select++;
+		m_cache_dirty = TRUE;
 	}
 }
+
+
+
+/***************************************************************************
+    LOCKSTEP VERIFICATION
+***************************************************************************/
+
+/*-------------------------------------------------
+    verifier - constructor
+-------------------------------------------------*/
+
+sh2_device::verifier::verifier(sh2_device &cpu)
+	: drc_verifier(cpu, *cpu.m_drcuml, *cpu.m_program),
+		m_sh2(cpu)
+{
+	/* EA is only maintained by the interpreter */
+	ignore_register(SH2_EA);
+}
+
+
+/*-------------------------------------------------
+    save_state - snapshot everything the
+    interpreter and recompiler can change
+-------------------------------------------------*/
+
+void sh2_device::verifier::save_state(std::vector<UINT8> &buffer)
+{
+	buffer.clear();
+	save_item(buffer, *m_sh2.m_sh2_state);
+	save_item(buffer, m_sh2.m_delay);
+	save_item(buffer, m_sh2.m_cpu_off);
+	save_item(buffer, m_sh2.m_test_irq);
+}
+
+
+/*-------------------------------------------------
+    restore_state - restore a snapshot
+-------------------------------------------------*/
+
+void sh2_device::verifier::restore_state(const std::vector<UINT8> &buffer)
+{
+	const UINT8 *data = &buffer[0];
+	restore_item(data, *m_sh2.m_sh2_state);
+	restore_item(data, m_sh2.m_delay);
+	restore_item(data, m_sh2.m_cpu_off);
+	restore_item(data, m_sh2.m_test_irq);
+}
+
+
+/*-------------------------------------------------
+    set_pc - set the PC at a sequence boundary,
+    which is never in a delay slot
+-------------------------------------------------*/
+
+void sh2_device::verifier::set_pc(offs_t pc)
+{
+	m_sh2.m_sh2_state->pc = pc;
+	m_sh2.m_delay = 0;
+}
+
+
+/*-------------------------------------------------
+    step - run one instruction, plus its delay
+    slot, on the interpreter
+-------------------------------------------------*/
+
+void sh2_device::verifier::step()
+{
+	m_sh2.m_isdrc = false;
+	do
+	{
+		m_sh2.m_sh2_state->icount = 1;
+		m_sh2.execute_run();
+	} while (m_sh2.m_delay != 0);
+	m_sh2.m_isdrc = true;
+}
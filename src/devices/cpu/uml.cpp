@@ -849,6 +849,59 @@ UINT8 uml::instruction::modified_flags() const
 }
 
 
+//-------------------------------------------------
+//  param_is_input - return true if the given
+//  parameter is read by the instruction
+//-------------------------------------------------
+
+bool uml::instruction::param_is_input(int pnum) const
+{
+	assert(pnum < m_numparams);
+	return (s_opcode_info_table[m_opcode].param[pnum].output & PIO_IN) != 0;
+}
+
+
+//-------------------------------------------------
+//  param_is_output - return true if the given
+//  parameter is written by the instruction
+//-------------------------------------------------
+
+bool uml::instruction::param_is_output(int pnum) const
+{
+	assert(pnum < m_numparams);
+	return (s_opcode_info_table[m_opcode].param[pnum].output & PIO_OUT) != 0;
+}
+
+
+//-------------------------------------------------
+//  param_allows - return true if the given
+//  parameter may be of the given type
+//-------------------------------------------------
+
+bool uml::instruction::param_allows(int pnum, parameter::parameter_type type) const
+{
+	assert(pnum < m_numparams);
+	return ((s_opcode_info_table[m_opcode].param[pnum].typemask >> type) & 1) != 0;
+}
+
+
+//-------------------------------------------------
+//  param_size - return the size in bytes of the
+//  given parameter
+//-------------------------------------------------
+
+UINT8 uml::instruction::param_size(int pnum) const
+{
+	assert(pnum < m_numparams);
+	UINT8 size = s_opcode_info_table[m_opcode].param[pnum].size;
+	if (size == PSIZE_OP)
+		return m_size;
+	if (size >= PSIZE_P1 && size <= PSIZE_P4)
+		return 1 << m_param[size - PSIZE_P1].size();
+	return 1 << size;
+}
+
+
 //-------------------------------------------------
 //  disasm - disassemble an instruction to the
 //  given buffer
@@ -277,6 +277,8 @@ namespace uml
 	// a parameter for a UML instructon is encoded like this
 	class parameter
 	{
+		friend class ::drcuml_state;
+
 	public:
 		// opcode parameter types
 		enum parameter_type
@@ -395,6 +397,8 @@ namespace uml
 	// a single UML instructon is encoded like this
 	class instruction
 	{
+		friend class ::drcuml_state;
+
 	public:
 		// construction/destruction
 		instruction();
@@ -410,12 +414,17 @@ namespace uml
 		// setters
 		void set_flags(UINT8 flags) { m_flags = flags; }
 		void set_mapvar(int paramnum, UINT32 value) { assert(paramnum < m_numparams); assert(m_param[paramnum].is_mapvar()); m_param[paramnum] = value; }
+		void set_param(int paramnum, const parameter &param) { assert(paramnum < m_numparams); m_param[paramnum] = param; }
 
 		// misc
 		std::string disasm(drcuml_state *drcuml = nullptr) const;
 		UINT8 input_flags() const;
 		UINT8 output_flags() const;
 		UINT8 modified_flags() const;
+		bool param_is_input(int pnum) const;
+		bool param_is_output(int pnum) const;
+		bool param_allows(int pnum, parameter::parameter_type type) const;
+		UINT8 param_size(int pnum) const;
 		void simplify();
 
 		// compile-time opcodes
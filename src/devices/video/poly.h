@@ -6,6 +6,27 @@
 
     Polygon helper routines.
 
+****************************************************************************
+
+    Work distribution:
+
+    By default, each polygon is split into work units of up to
+    SCANLINES_PER_BUCKET scanlines, which are queued as soon as they are
+    built.  Units covering the same band of scanlines are chained so
+    that they are drawn in order.
+
+    With POLYFLAG_TILE_BINNED, units are not queued when they are built.
+    Instead they are binned into screen tiles PIXELS_PER_TILE wide and
+    SCANLINES_PER_BUCKET tall, and the next wait() queues one work item
+    per tile.  Each item draws everything that touches its tile, in
+    submission order, with each extent clipped to the tile.  Each
+    worker therefore owns whole tiles and never shares framebuffer or
+    depth buffer lines with another worker.  Render callbacks are
+    unchanged, but clipping an extent moves its start by
+    (newstartx - startx) * dpdx, so a driver should only opt in if its
+    extent parameters are linear in X.  Reversed extents (stopx <
+    startx) are not clipped; they go to the tile holding startx.
+
 ****************************************************************************
 
     Pixel model:
@@ -62,11 +83,14 @@
 #define POLYFLAG_INCLUDE_BOTTOM_EDGE        0x01
 #define POLYFLAG_INCLUDE_RIGHT_EDGE         0x02
 #define POLYFLAG_NO_WORK_QUEUE              0x04
+#define POLYFLAG_TILE_BINNED                0x08
 
 #define SCANLINES_PER_BUCKET                8
 #define CACHE_LINE_SIZE                     64          // this is a general guess
 #define TOTAL_BUCKETS                       (512 / SCANLINES_PER_BUCKET)
 #define UNITS_PER_POLY                      (100 / SCANLINES_PER_BUCKET)
+#define PIXELS_PER_TILE                     64
+#define TOTAL_TILE_COLUMNS                  (1024 / PIXELS_PER_TILE)
 
 
 
@@ -176,6 +200,14 @@ private:
 		extent_t            extent[SCANLINES_PER_BUCKET]; // array of scanline extents
 	};
 
+	// a screen tile and the units that touch it, for binned rendering
+	struct tile_bin
+	{
+		poly_manager *      owner;                  // pointer back to the poly manager
+		INT32               column;                 // tile column, modulo TOTAL_TILE_COLUMNS
+		std::vector<UINT32> units;                  // indexes of units to draw, in order
+	};
+
 	// class for managing an array of items
 	template<class _Type, int _Count>
 	class poly_array
@@ -252,6 +284,9 @@ private:
 	}
 
 	static void *work_item_callback(void *param, int threadid);
+	static void *tile_item_callback(void *param, int threadid);
+	void queue_units(UINT32 startunit);
+	void bin_units(UINT32 startunit);
 	void presave() { wait("pre-save"); }
 
 	// queue management
@@ -270,6 +305,10 @@ private:
 	// buckets
 	UINT16              m_unit_bucket[TOTAL_BUCKETS]; // buckets for tracking unit usage
 
+	// tiles
+	std::vector<tile_bin> m_tile_bin;               // bins by bucket and column, in binned mode
+	std::vector<tile_bin *> m_tile_active;          // bins with units waiting to be drawn
+
 	// statistics
 	UINT32              m_tiles;                    // number of tiles queued
 	UINT32              m_triangles;                // number of triangles queued
@@ -308,6 +347,17 @@ poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::poly_manager(runnin
 	if (!(flags & POLYFLAG_NO_WORK_QUEUE))
 		m_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI | WORK_QUEUE_FLAG_HIGH_FREQ);
 
+	// set up the tile bins if requested
+	if (flags & POLYFLAG_TILE_BINNED)
+	{
+		m_tile_bin.resize(TOTAL_BUCKETS * TOTAL_TILE_COLUMNS);
+		for (int binnum = 0; binnum < TOTAL_BUCKETS * TOTAL_TILE_COLUMNS; binnum++)
+		{
+			m_tile_bin[binnum].owner = this;
+			m_tile_bin[binnum].column = binnum % TOTAL_TILE_COLUMNS;
+		}
+	}
+
 	// request a pre-save callback for synchronization
 	machine.save().register_presave(save_prepost_delegate(FUNC(poly_manager::presave), this));
 }
@@ -335,6 +385,17 @@ poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::poly_manager(screen
 	if (!(flags & POLYFLAG_NO_WORK_QUEUE))
 		m_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI | WORK_QUEUE_FLAG_HIGH_FREQ);
 
+	// set up the tile bins if requested
+	if (flags & POLYFLAG_TILE_BINNED)
+	{
+		m_tile_bin.resize(TOTAL_BUCKETS * TOTAL_TILE_COLUMNS);
+		for (int binnum = 0; binnum < TOTAL_BUCKETS * TOTAL_TILE_COLUMNS; binnum++)
+		{
+			m_tile_bin[binnum].owner = this;
+			m_tile_bin[binnum].column = binnum % TOTAL_TILE_COLUMNS;
+		}
+	}
+
 	// request a pre-save callback for synchronization
 	machine().save().register_presave(save_prepost_delegate(FUNC(poly_manager::presave), this));
 }
@@ -440,6 +501,121 @@ void *poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::work_item_cal
 }
 
 
+//-------------------------------------------------
+//  tile_item_callback - draw everything binned
+//  into a tile, clipped to the tile
+//-------------------------------------------------
+
+template<typename _BaseType, class _ObjectData, int _MaxParams, int _MaxPolys>
+void *poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::tile_item_callback(void *param, int threadid)
+{
+	tile_bin &bin = **(tile_bin **)param;
+	poly_manager &owner = *bin.owner;
+
+	for (UINT32 unitnum : bin.units)
+	{
+		work_unit &unit = owner.m_unit[unitnum];
+		polygon_info &polygon = *unit.polygon;
+		int count = unit.count_next & 0xffff;
+
+		for (int curscan = 0; curscan < count; curscan++)
+		{
+			const extent_t &extent = unit.extent[curscan];
+
+			// reversed extents go whole to the tile holding their start
+			if (extent.stopx < extent.startx)
+			{
+				if ((extent.startx / PIXELS_PER_TILE) % TOTAL_TILE_COLUMNS == bin.column)
+					polygon.m_callback(unit.scanline + curscan, extent, *polygon.m_object, threadid);
+				continue;
+			}
+
+			// visit each tile this bin stands for, since columns wrap around
+			for (INT32 tilex = (extent.startx / PIXELS_PER_TILE) * PIXELS_PER_TILE; tilex < extent.stopx; tilex += PIXELS_PER_TILE)
+			{
+				if ((tilex / PIXELS_PER_TILE) % TOTAL_TILE_COLUMNS != bin.column)
+					continue;
+
+				// clip the extent to the tile and move its parameters to match
+				extent_t clipped = extent;
+				if (clipped.startx < tilex)
+				{
+					for (int paramnum = 0; paramnum < _MaxParams; paramnum++)
+						clipped.param[paramnum].start += _BaseType(tilex - extent.startx) * extent.param[paramnum].dpdx;
+					clipped.startx = tilex;
+				}
+				if (clipped.stopx > tilex + PIXELS_PER_TILE)
+					clipped.stopx = tilex + PIXELS_PER_TILE;
+				polygon.m_callback(unit.scanline + curscan, clipped, *polygon.m_object, threadid);
+			}
+		}
+	}
+	return nullptr;
+}
+
+
+//-------------------------------------------------
+//  queue_units - hand newly built work units to
+//  the workers, or bin them by tile
+//-------------------------------------------------
+
+template<typename _BaseType, class _ObjectData, int _MaxParams, int _MaxPolys>
+void poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::queue_units(UINT32 startunit)
+{
+	if (m_flags & POLYFLAG_TILE_BINNED)
+		bin_units(startunit);
+	else if (m_queue != nullptr)
+		osd_work_item_queue_multiple(m_queue, work_item_callback, m_unit.count() - startunit, &m_unit[startunit], m_unit.itemsize(), WORK_ITEM_FLAG_AUTO_RELEASE);
+}
+
+
+//-------------------------------------------------
+//  bin_units - add newly built work units to the
+//  bins of every tile they touch
+//-------------------------------------------------
+
+template<typename _BaseType, class _ObjectData, int _MaxParams, int _MaxPolys>
+void poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::bin_units(UINT32 startunit)
+{
+	for (UINT32 unitnum = startunit; unitnum < m_unit.count(); unitnum++)
+	{
+		work_unit &unit = m_unit[unitnum];
+		int count = unit.count_next & 0xffff;
+
+		// find the horizontal range the unit covers
+		INT32 minx = INT_MAX, maxx = INT_MIN;
+		for (int curscan = 0; curscan < count; curscan++)
+		{
+			const extent_t &extent = unit.extent[curscan];
+			if (extent.startx < extent.stopx)
+			{
+				minx = MIN(minx, extent.startx);
+				maxx = MAX(maxx, extent.stopx - 1);
+			}
+			else if (extent.stopx < extent.startx)
+			{
+				minx = MIN(minx, extent.startx);
+				maxx = MAX(maxx, extent.startx);
+			}
+		}
+		if (minx > maxx)
+			continue;
+
+		// add it to each column's bin once, even if the range wraps
+		INT32 firstcol = minx / PIXELS_PER_TILE;
+		INT32 numcols = MIN(maxx / PIXELS_PER_TILE - firstcol + 1, TOTAL_TILE_COLUMNS);
+		UINT32 bucketnum = ((UINT32)unit.scanline / SCANLINES_PER_BUCKET) % TOTAL_BUCKETS;
+		for (INT32 colnum = firstcol; colnum < firstcol + numcols; colnum++)
+		{
+			tile_bin &bin = m_tile_bin[bucketnum * TOTAL_TILE_COLUMNS + colnum % TOTAL_TILE_COLUMNS];
+			if (bin.units.empty())
+				m_tile_active.push_back(&bin);
+			bin.units.push_back(unitnum);
+		}
+	}
+}
+
+
 //-------------------------------------------------
 //  wait - stall until all work is complete
 //-------------------------------------------------
@@ -453,12 +629,22 @@ void poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::wait(const cha
 	if (LOG_WAITS)
 		time = get_profile_ticks();
 
+	// in binned mode, hand out one work item per tile now
+	if (!m_tile_active.empty())
+	{
+		if (m_queue != nullptr)
+			osd_work_item_queue_multiple(m_queue, tile_item_callback, m_tile_active.size(), &m_tile_active[0], sizeof(m_tile_active[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+		else
+			for (auto &bin : m_tile_active)
+				tile_item_callback(&bin, 0);
+	}
+
 	// wait for all pending work items to complete
 	if (m_queue != nullptr)
 		osd_work_queue_wait(m_queue, osd_ticks_per_second() * 100);
 
 	// if we don't have a queue, just run the whole list now
-	else
+	else if (!(m_flags & POLYFLAG_TILE_BINNED))
 		for (int unitnum = 0; unitnum < m_unit.count(); unitnum++)
 			work_item_callback(&m_unit[unitnum], 0);
 
@@ -474,6 +660,9 @@ void poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::wait(const cha
 	m_polygon.reset();
 	m_unit.reset();
 	memset(m_unit_bucket, 0xff, sizeof(m_unit_bucket));
+	for (auto bin : m_tile_active)
+		bin->units.clear();
+	m_tile_active.clear();
 
 	// we need to preserve the last object data that was supplied
 	if (m_object.count() > 0)
@@ -621,8 +810,7 @@ UINT32 poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::render_tile(
 	}
 
 	// enqueue the work items
-	if (m_queue != nullptr)
-		osd_work_item_queue_multiple(m_queue, work_item_callback, m_unit.count() - startunit, &m_unit[startunit], m_unit.itemsize(), WORK_ITEM_FLAG_AUTO_RELEASE);
+	queue_units(startunit);
 
 	// return the total number of pixels in the triangle
 	m_tiles++;
@@ -809,8 +997,7 @@ UINT32 poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::render_trian
 	}
 
 	// enqueue the work items
-	if (m_queue != nullptr)
-		osd_work_item_queue_multiple(m_queue, work_item_callback, m_unit.count() - startunit, &m_unit[startunit], m_unit.itemsize(), WORK_ITEM_FLAG_AUTO_RELEASE);
+	queue_units(startunit);
 
 	// return the total number of pixels in the triangle
 	m_triangles++;
@@ -925,8 +1112,7 @@ UINT32 poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::render_trian
 	}
 
 	// enqueue the work items
-	if (m_queue != nullptr)
-		osd_work_item_queue_multiple(m_queue, work_item_callback, m_unit.count() - startunit, &m_unit[startunit], m_unit.itemsize(), WORK_ITEM_FLAG_AUTO_RELEASE);
+	queue_units(startunit);
 
 	// return the total number of pixels in the object
 	m_triangles++;
@@ -1124,8 +1310,7 @@ UINT32 poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::render_polyg
 	}
 
 	// enqueue the work items
-	if (m_queue != nullptr)
-		osd_work_item_queue_multiple(m_queue, work_item_callback, m_unit.count() - startunit, &m_unit[startunit], m_unit.itemsize(), WORK_ITEM_FLAG_AUTO_RELEASE);
+	queue_units(startunit);
 
 	// return the total number of pixels in the triangle
 	m_quads++;
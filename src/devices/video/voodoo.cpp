@@ -143,6 +143,8 @@ bits(7:4) and bit(24)), X, and Y:
 
 
 #include "emu.h"
+#include "emuopts.h"
+#include "coreutil.h"
 
 #include "video/rgbutil.h"
 #include "voodoo.h"
@@ -242,11 +244,15 @@ static const raster_info predef_raster_table[] =
 
 int voodoo_device::voodoo_update(bitmap_rgb32 &bitmap, const rectangle &cliprect)
 {
-	int changed = fbi.video_changed;
-	int drawbuf = fbi.frontbuf;
+	int changed, drawbuf;
 	int statskey;
 	int x, y;
 
+	/* let the render thread finish drawing first */
+	render_sync(this);
+	changed = fbi.video_changed;
+	drawbuf = fbi.frontbuf;
+
 	/* reset the video changed flag */
 	fbi.video_changed = FALSE;
 
@@ -569,6 +575,8 @@ static void init_save_state(voodoo_device *vd)
 {
 	int index, subindex;
 
+	vd->machine().save().register_presave(save_prepost_delegate(FUNC(voodoo_device::render_presave), vd));
+	vd->machine().save().register_preload(save_prepost_delegate(FUNC(voodoo_device::render_preload), vd));
 	vd->machine().save().register_postload(save_prepost_delegate(FUNC(voodoo_device::voodoo_postload), vd));
 
 	/* register states: core */
@@ -784,6 +792,9 @@ void voodoo_device::swap_buffers(voodoo_device *vd)
 
 	if (LOG_VBLANK_SWAP) vd->device->logerror("--- swap_buffers @ %d\n", vd->screen->vpos());
 
+	/* the render thread must not be drawing while the buffers move */
+	render_sync(vd);
+
 	/* force a partial update */
 	vd->screen->update_partial(vd->screen->vpos());
 	vd->fbi.video_changed = TRUE;
@@ -814,6 +825,10 @@ void voodoo_device::swap_buffers(voodoo_device *vd)
 	else
 		vd->fbi.rgboffs[0] = vd->reg[leftOverlayBuf].u & vd->fbi.mask & ~0x0f;
 
+	/* hash the new front buffer if asked */
+	if (!vd->hash_path.empty())
+		frame_hash(vd);
+
 	/* decrement the pending count and reset our state */
 	if (vd->fbi.swaps_pending)
 		vd->fbi.swaps_pending--;
@@ -3485,6 +3500,9 @@ void voodoo_device::flush_fifos(voodoo_device *vd, attotime current_time)
 		return;
 	in_flush = TRUE;
 
+	/* anything handed to the render thread comes first */
+	render_sync(vd);
+
 	if (!vd->pci.op_pending) fatalerror("flush_fifos called with no pending operation\n");
 
 	if (LOG_FIFO_VERBOSE) vd->device->logerror("VOODOO.%d.FIFO:flush_fifos start -- pending=%d.%08X%08X cur=%d.%08X%08X\n", vd->index,
@@ -3598,6 +3616,192 @@ void voodoo_device::flush_fifos(voodoo_device *vd, attotime current_time)
 
 
 
+/*************************************
+ *
+ *  Render thread
+ *
+ *************************************/
+
+/*
+    With -voodoo_thread, Voodoo 1 and 2 register and texture writes that
+    would have been executed immediately are instead collected into
+    batches and run in order on a dedicated thread, so triangle setup,
+    texture updates and the waits on the rasterizer no longer happen on
+    the emulation thread.  Those commands are treated as taking no
+    emulated time.  Anything that has effects outside the chip or
+    observes its state waits for the thread to drain first: register
+    and LFB reads, LFB writes, swaps, the video timing, init and
+    CMDFIFO registers, screen updates, resets and save states.  While a
+    timed operation such as a vsync'ed swap is pending, everything runs
+    on the emulation thread through the normal FIFO path.
+*/
+
+bool voodoo_device::render_deferrable(voodoo_device *vd, offs_t offset)
+{
+	UINT8 regnum;
+
+	/* nothing is deferred without a render thread, or in CMDFIFO mode */
+	if (vd->render_queue == nullptr || vd->fbi.cmdfifo[0].enable || vd->fbi.cmdfifo[1].enable)
+		return false;
+
+	/* texture writes can always go; LFB writes cannot */
+	if (offset & (0x800000/4))
+		return true;
+	if (offset & (0x400000/4))
+		return false;
+
+	/* registers can, unless they reach outside the chip */
+	if ((offset & 0x800c0) == 0x80000 && vd->alt_regmap)
+		regnum = register_alias_map[offset & 0x3f];
+	else
+		regnum = offset & 0xff;
+	switch (regnum)
+	{
+		case swapbufferCMD:
+		case userIntrCMD:
+		case clutData:
+		case dacData:
+		case hSync:
+		case vSync:
+		case backPorch:
+		case videoDimensions:
+		case fbiInit0:
+		case fbiInit1:
+		case fbiInit2:
+		case fbiInit3:
+		case fbiInit4:
+		case fbiInit5:
+		case fbiInit6:
+		case fbiInit7:
+		case cmdFifoBaseAddr:
+		case cmdFifoBump:
+		case cmdFifoRdPtr:
+		case cmdFifoAMin:
+		case cmdFifoAMax:
+		case cmdFifoDepth:
+		case cmdFifoHoles:
+			return false;
+
+		default:
+			return true;
+	}
+}
+
+
+void voodoo_device::render_defer(voodoo_device *vd, offs_t offset, UINT32 data)
+{
+	deferred_command command = { offset, data };
+	vd->render_batch->commands.push_back(command);
+
+	/* hand full batches to the render thread */
+	if (vd->render_batch->commands.size() >= RENDER_BATCH_SIZE)
+	{
+		osd_work_item_queue(vd->render_queue, render_execute, vd->render_batch, WORK_ITEM_FLAG_AUTO_RELEASE);
+		vd->render_batch = new deferred_batch;
+		vd->render_batch->vd = vd;
+		vd->render_batch->commands.reserve(RENDER_BATCH_SIZE);
+	}
+}
+
+
+void voodoo_device::render_sync(voodoo_device *vd)
+{
+	if (vd->render_queue == nullptr)
+		return;
+
+	/* wait for the thread, then run whatever it was never handed here */
+	osd_work_queue_wait(vd->render_queue, osd_ticks_per_second() * 100);
+	for (const deferred_command &command : vd->render_batch->commands)
+	{
+		if (command.offset & (0x800000/4))
+			texture_w(vd, command.offset, command.data);
+		else
+			register_w(vd, command.offset, command.data);
+	}
+	vd->render_batch->commands.clear();
+}
+
+
+void voodoo_device::render_presave(voodoo_device *vd)
+{
+	render_sync(vd);
+}
+
+
+void voodoo_device::render_preload(voodoo_device *vd)
+{
+	if (vd->render_queue == nullptr)
+		return;
+
+	/* let the thread finish before the state under it is replaced, and drop
+	   what it was never handed, which belongs to the state being left */
+	osd_work_queue_wait(vd->render_queue, osd_ticks_per_second() * 100);
+	vd->render_batch->commands.clear();
+}
+
+
+void *voodoo_device::render_execute(void *param, int threadid)
+{
+	deferred_batch *batch = (deferred_batch *)param;
+	voodoo_device *vd = batch->vd;
+
+	for (const deferred_command &command : batch->commands)
+	{
+		if (command.offset & (0x800000/4))
+			texture_w(vd, command.offset, command.data);
+		else
+			register_w(vd, command.offset, command.data);
+	}
+	delete batch;
+	return nullptr;
+}
+
+
+/*-------------------------------------------------
+    frame_hash - with -voodoo_framehash, record
+    or check a CRC of each newly displayed frame
+-------------------------------------------------*/
+
+void voodoo_device::frame_hash(voodoo_device *vd)
+{
+	UINT32 offs = vd->fbi.rgboffs[vd->fbi.frontbuf];
+	UINT32 crc = 0;
+	UINT32 frame = vd->hash_frames++;
+	int y;
+
+	/* hash the visible part of the new front buffer */
+	if (offs != ~0)
+		for (y = 0; y < vd->fbi.height; y++)
+		{
+			UINT32 rowoffs = offs + y * vd->fbi.rowpixels * 2;
+			if (rowoffs + vd->fbi.width * 2 > vd->fbi.mask + 1)
+				break;
+			crc = core_crc32(crc, vd->fbi.ram + rowoffs, vd->fbi.width * 2);
+		}
+
+	/* compare against the recording, reporting only the first difference */
+	if (vd->hash_compare)
+	{
+		if (frame < vd->hash_expected.size() && crc != vd->hash_expected[frame])
+		{
+			osd_printf_error("%s: frame %u hash %08X differs from %08X recorded in %s\n", vd->tag(), frame, crc, vd->hash_expected[frame], vd->hash_path.c_str());
+			vd->hash_expected.clear();
+		}
+		return;
+	}
+
+	/* otherwise append to it, opening it the first time through */
+	if (vd->hash_file == nullptr)
+		vd->hash_file = fopen(vd->hash_path.c_str(), "a");
+	if (vd->hash_file != nullptr)
+	{
+		fprintf(vd->hash_file, "%s %u %08X\n", vd->tag(), frame, crc);
+		fflush(vd->hash_file);
+	}
+}
+
+
+
 /*************************************
  *
  *  Handle a write to the Voodoo
@@ -3636,6 +3840,7 @@ WRITE32_MEMBER( voodoo_device::voodoo_w )
 					/* check for byte swizzling (bit 18) */
 					if (offset & 0x40000/4)
 						data = FLIPENDIAN_INT32(data);
+					render_sync(this);
 					cmdfifo_w(this, &fbi.cmdfifo[0], offset & 0xffff, data);
 					g_profiler.stop();
 					return;
@@ -3673,6 +3878,7 @@ WRITE32_MEMBER( voodoo_device::voodoo_w )
 
 		// if this is non-FIFO command, execute immediately
 		if (!(access & REGISTER_FIFO)) {
+			render_sync(this);
 			register_w(this, offset, data);
 			g_profiler.stop();
 			return;
@@ -3688,6 +3894,15 @@ WRITE32_MEMBER( voodoo_device::voodoo_w )
 	{
 		int cycles;
 
+		/* drawing commands go to the render thread if we have one */
+		if (!pci.op_pending && render_deferrable(this, offset))
+		{
+			render_defer(this, offset, data);
+			g_profiler.stop();
+			return;
+		}
+		render_sync(this);
+
 		/* target the appropriate location */
 		if ((offset & (0xc00000/4)) == 0)
 			cycles = register_w(this, offset, data);
@@ -4054,6 +4269,9 @@ static UINT32 lfb_r(voodoo_device *vd, offs_t offset, bool lfb_3d)
 
 READ32_MEMBER( voodoo_device::voodoo_r )
 {
+	/* reads see the results of everything written so far */
+	render_sync(this);
+
 	/* if we have something pending, flush the FIFOs up to the current time */
 	if (pci.op_pending)
 		flush_fifos(this, machine().time());
@@ -4947,6 +5165,35 @@ void voodoo_device::common_start_voodoo(UINT8 type)
 	poly = poly_alloc(machine(), 64, sizeof(poly_extra_data), 0);
 	thread_stats = auto_alloc_array(machine(), stats_block, WORK_MAX_THREADS);
 
+	/* Voodoo 1 and 2 FIFO commands can run on their own thread */
+	render_queue = nullptr;
+	if (vd_type <= TYPE_VOODOO_2 && machine().options().voodoo_thread())
+		render_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_IO);
+	render_batch = new deferred_batch;
+	render_batch->vd = this;
+	render_batch->commands.reserve(RENDER_BATCH_SIZE);
+
+	/* compare frame hashes against an existing file, or record a new one */
+	hash_path = machine().options().voodoo_framehash();
+	hash_file = nullptr;
+	hash_compare = false;
+	hash_frames = 0;
+	if (!hash_path.empty())
+	{
+		FILE *file = fopen(hash_path.c_str(), "r");
+		if (file != nullptr)
+		{
+			char tag[256];
+			UINT32 frame, crc;
+
+			hash_compare = true;
+			while (fscanf(file, "%255s %u %x", tag, &frame, &crc) == 3)
+				if (strcmp(tag, this->tag()) == 0 && frame == hash_expected.size())
+					hash_expected.push_back(crc);
+			fclose(file);
+		}
+	}
+
 	/* create a table of precomputed 1/n and log2(n) values */
 	/* n ranges from 1.0000 to 2.0000 */
 	for (val = 0; val <= (1 << RECIPLOG_LOOKUP_BITS); val++)
@@ -5684,9 +5931,22 @@ raster_info *voodoo_device::find_rasterizer(voodoo_device *vd, int texcount)
 			return info;
 		}
 
+#if USE_SPECIALIZED_RASTERIZERS
+	/* generate a new one from the template matching our feature bits */
+	curinfo.callback = specialized_rasterizer(texcount,
+			(FBZMODE_ENABLE_DEPTHBUF(curinfo.eff_fbz_mode) ? SPECIALIZE_DEPTH : 0) |
+			(FBZMODE_ENABLE_DITHERING(curinfo.eff_fbz_mode) ? SPECIALIZE_DITHER : 0) |
+			(FBZMODE_RGB_BUFFER_MASK(curinfo.eff_fbz_mode) ? SPECIALIZE_RGB_WRITE : 0) |
+			(ALPHAMODE_ALPHABLEND(curinfo.eff_alpha_mode) ? SPECIALIZE_BLEND : 0) |
+			(FOGMODE_ENABLE_FOG(curinfo.eff_fog_mode) ? SPECIALIZE_FOG : 0));
+	curinfo.is_generic = FALSE;
+	curinfo.is_specialized = TRUE;
+#else
 	/* generate a new one using the generic entry */
 	curinfo.callback = (texcount == 0) ? raster_generic_0tmu : (texcount == 1) ? raster_generic_1tmu : raster_generic_2tmu;
 	curinfo.is_generic = TRUE;
+	curinfo.is_specialized = FALSE;
+#endif
 	curinfo.display = 0;
 	curinfo.polys = 0;
 	curinfo.hits = 0;
@@ -5734,7 +5994,7 @@ void voodoo_device::dump_rasterizer_stats(voodoo_device *vd)
 			best->eff_fbz_mode,
 			best->eff_tex_mode_0,
 			best->eff_tex_mode_1,
-			best->is_generic ? '*' : ' ',
+			best->is_generic ? '*' : best->is_specialized ? '+' : ' ',
 			best->hash,
 			best->polys,
 			best->hits);
@@ -5742,6 +6002,42 @@ void voodoo_device::dump_rasterizer_stats(voodoo_device *vd)
 		/* reset */
 		best->display = display_index;
 	}
+
+	printf("%s\n", rasterizer_usage(vd).c_str());
+}
+
+
+/*-------------------------------------------------
+    rasterizer_usage - summarize how many
+    scanlines went to each kind of rasterizer
+-------------------------------------------------*/
+
+std::string voodoo_device::rasterizer_usage(voodoo_device *vd)
+{
+	UINT64 predef = 0, specialized = 0, generic = 0, total;
+	int specialized_count = 0;
+	raster_info *cur;
+	int hash;
+
+	for (hash = 0; hash < RASTER_HASH_SIZE; hash++)
+		for (cur = vd->raster_hash[hash]; cur; cur = cur->next)
+		{
+			if (cur->is_generic)
+				generic += cur->hits;
+			else if (cur->is_specialized)
+			{
+				specialized += cur->hits;
+				specialized_count++;
+			}
+			else
+				predef += cur->hits;
+		}
+
+	total = predef + specialized + generic;
+	if (total == 0)
+		total = 1;
+	return string_format("Rasterizer scanlines: %.1f%% predefined, %.1f%% specialized (%d modes), %.1f%% generic",
+			predef * 100.0 / total, specialized * 100.0 / total, specialized_count, generic * 100.0 / total);
 }
 
 voodoo_device::voodoo_device(const machine_config &mconfig, device_type type, const char *name, const char *tag, device_t *owner, UINT32 clock, const char *shortname, const char *source)
@@ -5752,7 +6048,10 @@ voodoo_device::voodoo_device(const machine_config &mconfig, device_type type, co
 		m_screen(nullptr),
 		m_cputag(nullptr),
 		m_vblank(*this),
-		m_stall(*this)
+		m_stall(*this),
+		render_queue(nullptr),
+		render_batch(nullptr),
+		hash_file(nullptr)
 {
 }
 
@@ -5776,6 +6075,7 @@ void voodoo_device::device_config_complete()
 
 void voodoo_device::device_reset()
 {
+	render_sync(this);
 	soft_reset(this);
 }
 
@@ -5785,6 +6085,24 @@ void voodoo_device::device_reset()
 
 void voodoo_device::device_stop()
 {
+	/* finish and release the render thread */
+	if (render_queue != nullptr)
+	{
+		render_sync(this);
+		osd_work_queue_free(render_queue);
+		render_queue = nullptr;
+	}
+	delete render_batch;
+	render_batch = nullptr;
+
+	/* report how much drawing missed the predefined rasterizers */
+	logerror("%s\n", rasterizer_usage(this).c_str());
+
+	/* close the frame hash file */
+	if (hash_file != nullptr)
+		fclose(hash_file);
+	hash_file = nullptr;
+
 	/* release the work queue, ensuring all work is finished */
 	if (poly != nullptr)
 		poly_free(poly);
@@ -5943,3 +6261,38 @@ RASTERIZER(generic_1tmu, 1, vd->reg[fbzColorPath].u, vd->reg[fbzMode].u, vd->reg
 
 RASTERIZER(generic_2tmu, 2, vd->reg[fbzColorPath].u, vd->reg[fbzMode].u, vd->reg[alphaMode].u,
 			vd->reg[fogMode].u, vd->tmu[0].reg[textureMode].u, vd->tmu[1].reg[textureMode].u)
+
+
+/*-------------------------------------------------
+    specialized - generic rasterizer with the
+    SPECIALIZE_* feature bits fixed at compile
+    time, so the paths they select fold away
+-------------------------------------------------*/
+
+template<int _Tmus, UINT32 _Features>
+void voodoo_device::raster_specialized(void *destbase, INT32 y, const poly_extent *extent, const void *extradata, int threadid)
+	RASTERIZER_BODY(_Tmus, vd->reg[fbzColorPath].u, SPECIALIZED_FBZ_MODE(vd->reg[fbzMode].u, _Features),
+			SPECIALIZED_ALPHA_MODE(vd->reg[alphaMode].u, _Features), SPECIALIZED_FOG_MODE(vd->reg[fogMode].u, _Features),
+			(_Tmus >= 1) ? vd->tmu[0].reg[textureMode].u : 0, (_Tmus >= 2) ? vd->tmu[1].reg[textureMode].u : 0)
+
+
+template<int _Tmus, UINT32... _Features>
+static const poly_draw_scanline_func *specialized_table(std::integer_sequence<UINT32, _Features...>)
+{
+	static const poly_draw_scanline_func table[] = { voodoo_device::raster_specialized<_Tmus, _Features>... };
+	return table;
+}
+
+
+poly_draw_scanline_func voodoo_device::specialized_rasterizer(int texcount, UINT32 features)
+{
+	static const poly_draw_scanline_func *const tables[3] =
+	{
+		specialized_table<0>(std::make_integer_sequence<UINT32, SPECIALIZE_COUNT>()),
+		specialized_table<1>(std::make_integer_sequence<UINT32, SPECIALIZE_COUNT>()),
+		specialized_table<2>(std::make_integer_sequence<UINT32, SPECIALIZE_COUNT>())
+	};
+
+	assert(texcount >= 0 && texcount <= 2 && features < SPECIALIZE_COUNT);
+	return tables[texcount][features];
+}
@@ -50,6 +50,26 @@ enum
 /* size of the rasterizer hash table */
 #define RASTER_HASH_SIZE        97
 
+/* build rasterizers for modes not in voodoo_rast.hxx from templates */
+/* specialized on the feature bits below, instead of the generic ones */
+#define USE_SPECIALIZED_RASTERIZERS 1
+
+/* feature bits that specialized rasterizers are compiled for */
+#define SPECIALIZE_DEPTH        0x01        /* fbzMode: depth buffering */
+#define SPECIALIZE_DITHER       0x02        /* fbzMode: dithering */
+#define SPECIALIZE_RGB_WRITE    0x04        /* fbzMode: RGB buffer writes */
+#define SPECIALIZE_BLEND        0x08        /* alphaMode: alpha blending */
+#define SPECIALIZE_FOG          0x10        /* fogMode: fog */
+#define SPECIALIZE_COUNT        0x20        /* number of feature combinations */
+
+/* replace the specialized bits of a register with those from a feature set */
+#define SPECIALIZED_FBZ_MODE(val, f)    (((val) & ~0x310) | (((f) & SPECIALIZE_DEPTH) ? 0x010 : 0) | (((f) & SPECIALIZE_DITHER) ? 0x100 : 0) | (((f) & SPECIALIZE_RGB_WRITE) ? 0x200 : 0))
+#define SPECIALIZED_ALPHA_MODE(val, f)  (((val) & ~0x010) | (((f) & SPECIALIZE_BLEND) ? 0x010 : 0))
+#define SPECIALIZED_FOG_MODE(val, f)    (((val) & ~0x001) | (((f) & SPECIALIZE_FOG) ? 0x001 : 0))
+
+/* number of FIFO commands handed to the render thread at once */
+#define RENDER_BATCH_SIZE       512
+
 /* flags for LFB writes */
 #define LFB_RGB_PRESENT         1
 #define LFB_ALPHA_PRESENT       2
@@ -1448,6 +1468,20 @@ struct cmdfifo_info
 };
 
 
+struct deferred_command
+{
+	UINT32              offset;                 /* register or texture offset */
+	UINT32              data;                   /* data written */
+};
+
+
+struct deferred_batch
+{
+	voodoo_device *     vd;                     /* device the commands belong to */
+	std::vector<deferred_command> commands;     /* commands, in order */
+};
+
+
 struct pci_state
 {
 	fifo_state          fifo;                   /* PCI FIFO */
@@ -1625,6 +1659,7 @@ struct raster_info
 	UINT32              eff_tex_mode_0;         /* effective textureMode value for TMU #0 */
 	UINT32              eff_tex_mode_1;         /* effective textureMode value for TMU #1 */
 	UINT32              hash;
+	UINT8               is_specialized;         /* TRUE if this uses a specialized rasterizer */
 };
 
 
@@ -1813,9 +1848,17 @@ public:
 	static raster_info *add_rasterizer(voodoo_device *vd, const raster_info *cinfo);
 	static raster_info *find_rasterizer(voodoo_device *vd, int texcount);
 	static void dump_rasterizer_stats(voodoo_device *vd);
+	static std::string rasterizer_usage(voodoo_device *vd);
 	static void init_tmu_shared(tmu_shared_state *s);
 
 	static void swap_buffers(voodoo_device *vd);
+	static void frame_hash(voodoo_device *vd);
+	static bool render_deferrable(voodoo_device *vd, offs_t offset);
+	static void render_defer(voodoo_device *vd, offs_t offset, UINT32 data);
+	static void render_sync(voodoo_device *vd);
+	static void render_presave(voodoo_device *vd);
+	static void render_preload(voodoo_device *vd);
+	static void *render_execute(void *param, int threadid);
 	static UINT32 cmdfifo_execute(voodoo_device *vd, cmdfifo_info *f);
 	static INT32 cmdfifo_execute_if_ready(voodoo_device* vd, cmdfifo_info *f);
 	static void cmdfifo_w(voodoo_device *vd, cmdfifo_info *f, offs_t offset, UINT32 data);
@@ -1824,6 +1867,8 @@ public:
 	static void raster_generic_0tmu(void *dest, INT32 scanline, const poly_extent *extent, const void *extradata, int threadid);
 	static void raster_generic_1tmu(void *dest, INT32 scanline, const poly_extent *extent, const void *extradata, int threadid);
 	static void raster_generic_2tmu(void *dest, INT32 scanline, const poly_extent *extent, const void *extradata, int threadid);
+	template<int _Tmus, UINT32 _Features> static void raster_specialized(void *dest, INT32 scanline, const poly_extent *extent, const void *extradata, int threadid);
+	static poly_draw_scanline_func specialized_rasterizer(int texcount, UINT32 features);
 
 #define RASTERIZER_HEADER(name) \
 	static void raster_##name(void *destbase, INT32 y, const poly_extent *extent, const void *extradata, int threadid);
@@ -1881,6 +1926,15 @@ public:
 	bool                send_config;
 	UINT32              tmu_config;
 
+	osd_work_queue *    render_queue;           /* queue running FIFO commands on their own thread, or nullptr */
+	deferred_batch *    render_batch;           /* commands not yet handed to the render thread */
+
+	std::string         hash_path;              /* frame hash file, or empty */
+	FILE *              hash_file;              /* frame hash file being recorded */
+	bool                hash_compare;           /* true if comparing against hash_expected */
+	std::vector<UINT32> hash_expected;          /* previously recorded frame hashes */
+	UINT32              hash_frames;            /* number of frames hashed so far */
+
 };
 
 class voodoo_1_device : public voodoo_device
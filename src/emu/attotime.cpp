@@ -39,19 +39,21 @@ attotime &attotime::operator*=(UINT32 factor)
 	if (factor == 0)
 		return *this = zero;
 
-	// split attoseconds into upper and lower halves which fit into 32 bits
-	UINT32 attolo;
-	UINT32 attohi = divu_64x32_rem(m_attoseconds, ATTOSECONDS_PER_SECOND_SQRT, &attolo);
+	// split attoseconds into upper and lower halves which fit into 32 bits;
+	// all divisions here are by a constant, which the compiler turns into a
+	// multiply rather than a hardware divide
+	UINT32 attolo = UINT64(m_attoseconds) % ATTOSECONDS_PER_SECOND_SQRT;
+	UINT32 attohi = UINT64(m_attoseconds) / ATTOSECONDS_PER_SECOND_SQRT;
 
 	// scale the lower half, then split into high/low parts
 	UINT64 temp = mulu_32x32(attolo, factor);
-	UINT32 reslo;
-	temp = divu_64x32_rem(temp, ATTOSECONDS_PER_SECOND_SQRT, &reslo);
+	UINT32 reslo = temp % ATTOSECONDS_PER_SECOND_SQRT;
+	temp /= ATTOSECONDS_PER_SECOND_SQRT;
 
 	// scale the upper half, then split into high/low parts
 	temp += mulu_32x32(attohi, factor);
-	UINT32 reshi;
-	temp = divu_64x32_rem(temp, ATTOSECONDS_PER_SECOND_SQRT, &reshi);
+	UINT32 reshi = temp % ATTOSECONDS_PER_SECOND_SQRT;
+	temp /= ATTOSECONDS_PER_SECOND_SQRT;
 
 	// scale the seconds
 	temp += mulu_32x32(m_seconds, factor);
@@ -80,8 +82,8 @@ attotime &attotime::operator/=(UINT32 factor)
 		return *this;
 
 	// split attoseconds into upper and lower halves which fit into 32 bits
-	UINT32 attolo;
-	UINT32 attohi = divu_64x32_rem(m_attoseconds, ATTOSECONDS_PER_SECOND_SQRT, &attolo);
+	UINT32 attolo = UINT64(m_attoseconds) % ATTOSECONDS_PER_SECOND_SQRT;
+	UINT32 attohi = UINT64(m_attoseconds) / ATTOSECONDS_PER_SECOND_SQRT;
 
 	// divide the seconds and get the remainder
 	UINT32 remainder;
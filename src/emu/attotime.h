@@ -88,16 +88,16 @@ class attotime
 {
 public:
 	// construction/destruction
-	attotime()
+	constexpr attotime()
 		: m_seconds(0),
 			m_attoseconds(0) { }
 
 	/** Constructs with @p secs seconds and @p attos attoseconds. */
-	attotime(seconds_t secs, attoseconds_t attos)
+	constexpr attotime(seconds_t secs, attoseconds_t attos)
 		: m_seconds(secs),
 			m_attoseconds(attos) { }
 
-	attotime(const attotime& that)
+	constexpr attotime(const attotime& that)
 		: m_seconds(that.m_seconds),
 			m_attoseconds(that.m_attoseconds) { }
 
@@ -110,32 +110,32 @@ public:
 	}
 
 	// queries
-	bool is_zero() const { return (m_seconds == 0 && m_attoseconds == 0); }
+	constexpr bool is_zero() const { return (m_seconds == 0 && m_attoseconds == 0); }
 	/** Test if value is above @ref ATTOTIME_MAX_SECONDS (considered an overflow) */
-	bool is_never() const { return (m_seconds >= ATTOTIME_MAX_SECONDS); }
+	constexpr bool is_never() const { return (m_seconds >= ATTOTIME_MAX_SECONDS); }
 
 	// conversion to other forms
-	double as_double() const { return double(m_seconds) + ATTOSECONDS_TO_DOUBLE(m_attoseconds); }
-	attoseconds_t as_attoseconds() const;
+	constexpr double as_double() const { return double(m_seconds) + ATTOSECONDS_TO_DOUBLE(m_attoseconds); }
+	constexpr attoseconds_t as_attoseconds() const;
 	UINT64 as_ticks(UINT32 frequency) const;
 	/** Convert to string using at @p precision */
 	const char *as_string(int precision = 9) const;
 
 	/** @return the attoseconds portion. */
-	attoseconds_t attoseconds() const { return m_attoseconds; }
+	constexpr attoseconds_t attoseconds() const { return m_attoseconds; }
 	/** @return the seconds portion. */
-	seconds_t seconds() const { return m_seconds; }
+	constexpr seconds_t seconds() const { return m_seconds; }
 
 	static attotime from_double(double _time);
 	static attotime from_ticks(UINT64 ticks, UINT32 frequency);
 	/** Create an attotime from a integer count of seconds @seconds */
-	static attotime from_seconds(INT32 seconds) { return attotime(seconds, 0); }
+	static constexpr attotime from_seconds(INT32 seconds) { return attotime(seconds, 0); }
 	/** Create an attotime from a integer count of milliseconds @msec */
-	static attotime from_msec(INT64 msec) { return attotime(msec / 1000, (msec % 1000) * (ATTOSECONDS_PER_SECOND / 1000)); }
+	static constexpr attotime from_msec(INT64 msec) { return attotime(msec / 1000, (msec % 1000) * (ATTOSECONDS_PER_SECOND / 1000)); }
 	/** Create an attotime from a integer count of microseconds @usec */
-	static attotime from_usec(INT64 usec) { return attotime(usec / 1000000, (usec % 1000000) * (ATTOSECONDS_PER_SECOND / 1000000)); }
+	static constexpr attotime from_usec(INT64 usec) { return attotime(usec / 1000000, (usec % 1000000) * (ATTOSECONDS_PER_SECOND / 1000000)); }
 	/** Create an attotime from a integer count of nanoseconds @nsec */
-	static attotime from_nsec(INT64 nsec) { return attotime(nsec / 1000000000, (nsec % 1000000000) * (ATTOSECONDS_PER_SECOND / 1000000000)); }
+	static constexpr attotime from_nsec(INT64 nsec) { return attotime(nsec / 1000000000, (nsec % 1000000000) * (ATTOSECONDS_PER_SECOND / 1000000000)); }
 	/** Create an attotime from at the given frequency @frequency */
 	static attotime from_hz(double frequency) { assert(frequency > 0); double d = 1 / frequency; return attotime(floor(d), modf(d, &d) * ATTOSECONDS_PER_SECOND); }
 
@@ -277,32 +277,32 @@ inline attotime operator/(const attotime &left, UINT32 factor)
 
 
 /** handle comparisons between attotimes */
-inline bool operator==(const attotime &left, const attotime &right)
+inline constexpr bool operator==(const attotime &left, const attotime &right)
 {
 	return (left.m_seconds == right.m_seconds && left.m_attoseconds == right.m_attoseconds);
 }
 
-inline bool operator!=(const attotime &left, const attotime &right)
+inline constexpr bool operator!=(const attotime &left, const attotime &right)
 {
 	return (left.m_seconds != right.m_seconds || left.m_attoseconds != right.m_attoseconds);
 }
 
-inline bool operator<(const attotime &left, const attotime &right)
+inline constexpr bool operator<(const attotime &left, const attotime &right)
 {
 	return (left.m_seconds < right.m_seconds || (left.m_seconds == right.m_seconds && left.m_attoseconds < right.m_attoseconds));
 }
 
-inline bool operator<=(const attotime &left, const attotime &right)
+inline constexpr bool operator<=(const attotime &left, const attotime &right)
 {
 	return (left.m_seconds < right.m_seconds || (left.m_seconds == right.m_seconds && left.m_attoseconds <= right.m_attoseconds));
 }
 
-inline bool operator>(const attotime &left, const attotime &right)
+inline constexpr bool operator>(const attotime &left, const attotime &right)
 {
 	return (left.m_seconds > right.m_seconds || (left.m_seconds == right.m_seconds && left.m_attoseconds > right.m_attoseconds));
 }
 
-inline bool operator>=(const attotime &left, const attotime &right)
+inline constexpr bool operator>=(const attotime &left, const attotime &right)
 {
 	return (left.m_seconds > right.m_seconds || (left.m_seconds == right.m_seconds && left.m_attoseconds >= right.m_attoseconds));
 }
@@ -312,15 +312,9 @@ inline bool operator>=(const attotime &left, const attotime &right)
 //  min - return the minimum of two attotimes
 //-------------------------------------------------
 
-inline attotime min(const attotime &left, const attotime &right)
+inline constexpr attotime min(const attotime &left, const attotime &right)
 {
-	if (left.m_seconds > right.m_seconds)
-		return right;
-	if (left.m_seconds < right.m_seconds)
-		return left;
-	if (left.m_attoseconds > right.m_attoseconds)
-		return right;
-	return left;
+	return (right < left) ? right : left;
 }
 
 
@@ -328,42 +322,38 @@ inline attotime min(const attotime &left, const attotime &right)
 //  max - return the maximum of two attotimes
 //-------------------------------------------------
 
-inline attotime max(const attotime &left, const attotime &right)
+inline constexpr attotime max(const attotime &left, const attotime &right)
 {
-	if (left.m_seconds > right.m_seconds)
-		return left;
-	if (left.m_seconds < right.m_seconds)
-		return right;
-	if (left.m_attoseconds > right.m_attoseconds)
-		return left;
-	return right;
+	return (left > right) ? left : right;
 }
 
 /** Convert to an attoseconds value, clamping to +/- 1 second */
-inline attoseconds_t attotime::as_attoseconds() const
+inline constexpr attoseconds_t attotime::as_attoseconds() const
 {
-	// positive values between 0 and 1 second
-	if (m_seconds == 0)
-		return m_attoseconds;
+	return
+		// positive values between 0 and 1 second
+		(m_seconds == 0) ? m_attoseconds :
 
-	// negative values between -1 and 0 seconds
-	else if (m_seconds == -1)
-		return m_attoseconds - ATTOSECONDS_PER_SECOND;
+		// negative values between -1 and 0 seconds
+		(m_seconds == -1) ? (m_attoseconds - ATTOSECONDS_PER_SECOND) :
 
-	// out-of-range positive values
-	else if (m_seconds > 0)
-		return ATTOSECONDS_PER_SECOND;
+		// out-of-range positive values
+		(m_seconds > 0) ? ATTOSECONDS_PER_SECOND :
 
-	// out-of-range negative values
-	else
-		return -ATTOSECONDS_PER_SECOND;
+		// out-of-range negative values
+		-ATTOSECONDS_PER_SECOND;
 }
 
 
 /** as_ticks - convert to ticks at @p frequency */
 inline UINT64 attotime::as_ticks(UINT32 frequency) const
 {
-	UINT32 fracticks = (attotime(0, m_attoseconds) * frequency).m_seconds;
+	// scale each 30-bit half of the attoseconds separately so that no
+	// intermediate overflows 64 bits; dividing by a constant lets the
+	// compiler use a multiply instead of a hardware divide
+	UINT64 attohi = UINT64(m_attoseconds) / ATTOSECONDS_PER_SECOND_SQRT;
+	UINT64 attolo = UINT64(m_attoseconds) % ATTOSECONDS_PER_SECOND_SQRT;
+	UINT64 fracticks = (attohi * frequency + attolo * frequency / ATTOSECONDS_PER_SECOND_SQRT) / ATTOSECONDS_PER_SECOND_SQRT;
 	return mulu_32x32(m_seconds, frequency) + fracticks;
 }
 
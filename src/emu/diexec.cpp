@@ -44,6 +44,7 @@ const int TRIGGER_SUSPENDTIME   = -4000;
 device_execute_interface::device_execute_interface(const machine_config &mconfig, device_t &device)
 	: device_interface(device, "execute"),
 		m_disabled(false),
+		m_parallel_group(0),
 		m_vblank_interrupt_screen(nullptr),
 		m_timed_interrupt_period(attotime::zero),
 		m_nextexec(nullptr),
@@ -94,6 +95,23 @@ void device_execute_interface::static_set_disable(device_t &device)
 }
 
 
+//-------------------------------------------------
+//  static_set_parallel_group - configuration
+//  helper to place a device in a group that is
+//  only loosely coupled to the rest of the system;
+//  each non-zero group may be run on its own host
+//  thread until the next synchronization point
+//-------------------------------------------------
+
+void device_execute_interface::static_set_parallel_group(device_t &device, int group)
+{
+	device_execute_interface *exec;
+	if (!device.interface(exec))
+		throw emu_fatalerror("MCFG_DEVICE_PARALLEL_GROUP called on device '%s' with no execute interface", device.tag());
+	exec->m_parallel_group = group;
+}
+
+
 //-------------------------------------------------
 //  static_set_vblank_int - configuration helper
 //  to set up VBLANK interrupts on the device
@@ -238,7 +256,8 @@ void device_execute_interface::suspend_resume_changed()
 void device_execute_interface::suspend(UINT32 reason, bool eatcycles)
 {
 if (TEMPLOG) printf("suspend %s (%X)\n", device().tag(), reason);
-	// set the suspend reason and eat cycles flag
+	// set the suspend reason and eat cycles flag; another execute group may be doing the same
+	device_scheduler::parallel_sync sync(*m_scheduler, device_scheduler::parallel_sync::SYNC_LOCK);
 	m_nextsuspend |= reason;
 	m_nexteatcycles = eatcycles;
 	suspend_resume_changed();
@@ -254,6 +273,7 @@ void device_execute_interface::resume(UINT32 reason)
 {
 if (TEMPLOG) printf("resume %s (%X)\n", device().tag(), reason);
 	// clear the suspend reason and eat cycles flag
+	device_scheduler::parallel_sync sync(*m_scheduler, device_scheduler::parallel_sync::SYNC_LOCK);
 	m_nextsuspend &= ~reason;
 	suspend_resume_changed();
 }
@@ -458,6 +478,9 @@ void device_execute_interface::interface_validity_check(validity_checker &valid)
 		osd_printf_error("Timed interrupt handler specified with 0 period\n");
 	else if (m_timed_interrupt.isnull() && m_timed_interrupt_period != attotime::zero)
 		osd_printf_error("No timer interrupt handler specified, but has a non-0 period given\n");
+
+	if (m_parallel_group < 0)
+		osd_printf_error("Invalid parallel group %d specified\n", m_parallel_group);
 }
 
 
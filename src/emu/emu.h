@@ -18,9 +18,12 @@
 #ifndef __EMU_H__
 #define __EMU_H__
 
+#include <deque>
 #include <list>
 #include <vector>
 #include <memory>
+#include <mutex>
+#include <atomic>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -176,6 +176,7 @@
 
 ***************************************************************************/
 
+#include <atomic>
 #include <list>
 #include <map>
 
@@ -274,6 +275,7 @@ public:
 	offs_t bytemask() const { return m_bytemask; }
 	virtual const char *name() const = 0;
 	virtual const char *subunit_name(int entry) const = 0;
+	virtual void bound_objects(std::vector<const void *> &objects) const { }
 	void description(char *buffer) const;
 
 	virtual void copy(handler_entry *entry);
@@ -388,6 +390,7 @@ public:
 	// getters
 	virtual const char *name() const override;
 	virtual const char *subunit_name(int entry) const override;
+	virtual void bound_objects(std::vector<const void *> &objects) const override;
 
 	// configure delegate callbacks
 	void set_delegate(read8_delegate delegate, UINT64 mask = 0);
@@ -451,6 +454,7 @@ public:
 	// getters
 	virtual const char *name() const override;
 	virtual const char *subunit_name(int entry) const override;
+	virtual void bound_objects(std::vector<const void *> &objects) const override;
 
 	// configure delegate callbacks
 	void set_delegate(write8_delegate delegate, UINT64 mask = 0);
@@ -543,6 +547,22 @@ private:
 };
 
 
+// ======================> parallel_reach
+
+// host memory or a handler object reached through an address table entry
+struct parallel_reach
+{
+	const UINT8 *           m_start;                    // first host byte reached
+	const UINT8 *           m_end;                      // last host byte reached
+	address_space *         m_space;                    // space the table belongs to
+	address_table *         m_table;                    // table holding the entry
+	UINT16                  m_entry;                    // the entry
+	int                     m_group;                    // execute group of the space's device
+	bool                    m_handler;                  // reached through a handler, which may have side effects
+	bool                    m_write;                    // reached through a write table
+};
+
+
 // ======================> address_table
 
 // address_table contains information about read/write accesses within an address space
@@ -565,7 +585,12 @@ public:
 
 	// getters
 	virtual handler_entry &handler(UINT32 index) const = 0;
-	bool watchpoints_enabled() const { return (m_live_lookup == s_watchpoint_table); }
+	bool watchpoints_enabled() const { return m_watchpoints; }
+	memory_trace *trace() const { return m_trace; }
+	UINT64 trace_key() const { return m_trace_key; }
+
+	// true if every access is routed through the watchpoint/trace handler
+	bool hooked() const { return (m_watchpoints || m_trace != nullptr); }
 
 	// address lookups
 	UINT32 lookup_live(offs_t byteaddress) const { return m_large ? lookup_live_large(byteaddress) : lookup_live_small(byteaddress); }
@@ -598,8 +623,9 @@ public:
 		return entry;
 	}
 
-	// enable watchpoints by swapping in the watchpoint table
-	void enable_watchpoints(bool enable = true) { m_live_lookup = enable ? s_watchpoint_table : &m_table[0]; }
+	// enable watchpoints or tracing by swapping in the watchpoint table
+	void enable_watchpoints(bool enable = true) { m_watchpoints = enable; update_live_lookup(); }
+	void enable_tracing(memory_trace *trace, UINT64 key) { m_trace = trace; m_trace_key = key; update_live_lookup(); }
 
 	// table mapping helpers
 	void map_range(offs_t bytestart, offs_t byteend, offs_t bytemask, offs_t bytemirror, UINT16 staticentry);
@@ -610,7 +636,37 @@ public:
 	void mask_all_handlers(offs_t mask);
 	const char *handler_name(UINT16 entry) const;
 
+	// true if the entry reaches handlers or RAM that another execute group reaches too
+	bool parallel_shared(UINT32 entry) const { return m_parallel_shared[entry]; }
+	void set_parallel_shared(UINT16 entry) { m_parallel_shared[entry] = true; }
+	void clear_parallel_shared() { memset(m_parallel_shared, 0, sizeof(m_parallel_shared)); }
+	void add_parallel_reach(std::vector<parallel_reach> &reached, int group, bool write);
+
+	// how an access through the entry must sync while execute groups run in parallel
+	device_scheduler::parallel_sync::sync_mode parallel_mode(UINT32 entry) const
+	{
+		if (EXPECTED(m_space.m_parallel_group < 0))
+			return device_scheduler::parallel_sync::SYNC_NONE;
+		if (m_parallel_shared[entry] || device_scheduler::current_parallel_group() != m_space.m_parallel_group)
+			return device_scheduler::parallel_sync::SYNC_ALWAYS;
+		return device_scheduler::parallel_sync::SYNC_NONE;
+	}
+
 protected:
+	// select the table used for live lookups
+	void update_live_lookup() { m_live_lookup = hooked() ? s_watchpoint_table : &m_table[0]; }
+
+	// count a traced access, returning true if it should be timed
+	template<typename _UintType>
+	bool trace_count(offs_t byteaddress, _UintType mask, UINT32 &id)
+	{
+		int bytes = 0;
+		for (int shift = 0; shift < 8 * sizeof(_UintType); shift += 8)
+			if (((mask >> shift) & 0xff) != 0)
+				bytes++;
+		return m_trace->count(*this, lookup_live_nowp(byteaddress), byteaddress, bytes, id);
+	}
+
 	// determine table indexes based on the address
 	UINT32 level1_index_large(offs_t address) const { return address >> LEVEL2_BITS; }
 	UINT32 level2_index_large(UINT16 l1entry, offs_t address) const { return (1 << LEVEL1_BITS) + ((l1entry - SUBTABLE_BASE) << LEVEL2_BITS) + (address & ((1 << LEVEL2_BITS) - 1)); }
@@ -635,6 +691,10 @@ protected:
 	UINT16 *                m_live_lookup;              // current lookup
 	address_space &         m_space;                    // pointer back to the space
 	bool                    m_large;                    // large memory model?
+	bool                    m_watchpoints;              // are watchpoints enabled?
+	memory_trace *          m_trace;                    // trace recording our accesses, or nullptr
+	UINT64                  m_trace_key;                // identifies this table within the trace
+	bool                    m_parallel_shared[SUBTABLE_BASE]; // entries reaching anything another execute group reaches
 
 	// subtable_data is an internal class with information about each subtable
 	class subtable_data
@@ -734,20 +794,30 @@ private:
 		return m_space.unmap();
 	}
 
-	// internal watchpoint handler
+	// internal watchpoint and trace handler
 	template<typename _UintType>
 	_UintType watchpoint_r(address_space &space, offs_t offset, _UintType mask)
 	{
-		m_space.device().debug()->memory_read_hook(m_space, offset * sizeof(_UintType), mask);
-
-		UINT16 *oldtable = m_live_lookup;
-		m_live_lookup = &m_table[0];
+		offs_t byteaddress = offset * sizeof(_UintType);
+		if (m_watchpoints)
+			m_space.device().debug()->memory_read_hook(m_space, byteaddress, mask);
+
+		// dispatch through the real table, leaving the live one hooked for other threads
+		UINT32 entry = lookup_live_nowp(byteaddress);
+		const handler_entry_read &handler = handler_read(entry);
+		device_scheduler::parallel_sync sync(m_space.machine().scheduler(), parallel_mode(entry));
+		UINT32 traceid;
+		bool timed = (m_trace != nullptr && trace_count(byteaddress, mask, traceid));
+		osd_ticks_t start = timed ? osd_ticks() : 0;
+		offset = handler.byteoffset(byteaddress);
 		_UintType result;
-		if (sizeof(_UintType) == 1) result = m_space.read_byte(offset);
-		if (sizeof(_UintType) == 2) result = m_space.read_word(offset << 1, mask);
-		if (sizeof(_UintType) == 4) result = m_space.read_dword(offset << 2, mask);
-		if (sizeof(_UintType) == 8) result = m_space.read_qword(offset << 3, mask);
-		m_live_lookup = oldtable;
+		if (entry <= STATIC_BANKMAX) result = *reinterpret_cast<_UintType *>(handler.ramptr(offset));
+		else if (sizeof(_UintType) == 1) result = handler.read8(m_space, offset, mask);
+		else if (sizeof(_UintType) == 2) result = handler.read16(m_space, offset >> 1, mask);
+		else if (sizeof(_UintType) == 4) result = handler.read32(m_space, offset >> 2, mask);
+		else if (sizeof(_UintType) == 8) result = handler.read64(m_space, offset >> 3, mask);
+		if (timed)
+			m_trace->sample(traceid, byteaddress, osd_ticks() - start);
 		return result;
 	}
 
@@ -806,15 +876,29 @@ private:
 	template<typename _UintType>
 	void watchpoint_w(address_space &space, offs_t offset, _UintType data, _UintType mask)
 	{
-		m_space.device().debug()->memory_write_hook(m_space, offset * sizeof(_UintType), data, mask);
-
-		UINT16 *oldtable = m_live_lookup;
-		m_live_lookup = &m_table[0];
-		if (sizeof(_UintType) == 1) m_space.write_byte(offset, data);
-		if (sizeof(_UintType) == 2) m_space.write_word(offset << 1, data, mask);
-		if (sizeof(_UintType) == 4) m_space.write_dword(offset << 2, data, mask);
-		if (sizeof(_UintType) == 8) m_space.write_qword(offset << 3, data, mask);
-		m_live_lookup = oldtable;
+		offs_t byteaddress = offset * sizeof(_UintType);
+		if (m_watchpoints)
+			m_space.device().debug()->memory_write_hook(m_space, byteaddress, data, mask);
+
+		// dispatch through the real table, leaving the live one hooked for other threads
+		UINT32 entry = lookup_live_nowp(byteaddress);
+		const handler_entry_write &handler = handler_write(entry);
+		device_scheduler::parallel_sync sync(m_space.machine().scheduler(), parallel_mode(entry));
+		UINT32 traceid;
+		bool timed = (m_trace != nullptr && trace_count(byteaddress, mask, traceid));
+		osd_ticks_t start = timed ? osd_ticks() : 0;
+		offset = handler.byteoffset(byteaddress);
+		if (entry <= STATIC_BANKMAX)
+		{
+			_UintType *dest = reinterpret_cast<_UintType *>(handler.ramptr(offset));
+			*dest = (*dest & ~mask) | (data & mask);
+		}
+		else if (sizeof(_UintType) == 1) handler.write8(m_space, offset, data, mask);
+		else if (sizeof(_UintType) == 2) handler.write16(m_space, offset >> 1, data, mask);
+		else if (sizeof(_UintType) == 4) handler.write32(m_space, offset >> 2, data, mask);
+		else if (sizeof(_UintType) == 8) handler.write64(m_space, offset >> 3, data, mask);
+		if (timed)
+			m_trace->sample(traceid, byteaddress, osd_ticks() - start);
 	}
 
 	// internal state
@@ -1041,8 +1125,17 @@ public:
 	virtual address_table_setoffset &setoffset() override { return m_setoffset; }
 
 	// watchpoint control
-	virtual void enable_read_watchpoints(bool enable = true) override { m_read.enable_watchpoints(enable); }
-	virtual void enable_write_watchpoints(bool enable = true) override { m_write.enable_watchpoints(enable); }
+	virtual void enable_read_watchpoints(bool enable = true) override { m_read.enable_watchpoints(enable); m_read_cache.force_update(); }
+	virtual void enable_write_watchpoints(bool enable = true) override { m_write.enable_watchpoints(enable); m_write_cache.force_update(); }
+
+	// trace control
+	virtual void enable_tracing(memory_trace *trace) override
+	{
+		m_read.enable_tracing(trace, (trace != nullptr) ? trace->table_key(*this, ROW_READ) : 0);
+		m_write.enable_tracing(trace, (trace != nullptr) ? trace->table_key(*this, ROW_WRITE) : 0);
+		m_read_cache.force_update();
+		m_write_cache.force_update();
+	}
 
 	// generate accessor table
 	virtual void accessors(data_accessors &accessors) const override
@@ -1094,19 +1187,24 @@ public:
 	// native read
 	_NativeType read_native(offs_t offset, _NativeType mask)
 	{
+		// RAM/ROM within the most recently used range can be read directly
+		offs_t byteaddress = offset & m_bytemask;
+		if (EXPECTED(m_read_cache.contains(byteaddress)))
+			return *reinterpret_cast<_NativeType *>(m_read_cache.ptr(byteaddress));
+
 		g_profiler.start(PROFILER_MEMREAD);
 
 		if (TEST_HANDLER) printf("[r%X,%s]", offset, core_i64_hex_format(mask, sizeof(_NativeType) * 2));
 
-		// look up the handler
-		offs_t byteaddress = offset & m_bytemask;
+		// look up the handler; anything another execute group reaches is accessed under the scheduler lock
 		UINT32 entry = read_lookup(byteaddress);
 		const handler_entry_read &handler = m_read.handler_read(entry);
+		device_scheduler::parallel_sync sync(machine().scheduler(), m_read.parallel_mode(entry));
 
 		// either read directly from RAM, or call the delegate
 		offset = handler.byteoffset(byteaddress);
 		_NativeType result;
-		if (entry <= STATIC_BANKMAX) result = *reinterpret_cast<_NativeType *>(handler.ramptr(offset));
+		if (entry <= STATIC_BANKMAX) { result = *reinterpret_cast<_NativeType *>(handler.ramptr(offset)); if (!sync.locked()) m_read_cache.update(byteaddress); }
 		else if (sizeof(_NativeType) == 1) result = handler.read8(*this, offset, mask);
 		else if (sizeof(_NativeType) == 2) result = handler.read16(*this, offset >> 1, mask);
 		else if (sizeof(_NativeType) == 4) result = handler.read32(*this, offset >> 2, mask);
@@ -1119,19 +1217,24 @@ public:
 	// mask-less native read
 	_NativeType read_native(offs_t offset)
 	{
+		// RAM/ROM within the most recently used range can be read directly
+		offs_t byteaddress = offset & m_bytemask;
+		if (EXPECTED(m_read_cache.contains(byteaddress)))
+			return *reinterpret_cast<_NativeType *>(m_read_cache.ptr(byteaddress));
+
 		g_profiler.start(PROFILER_MEMREAD);
 
 		if (TEST_HANDLER) printf("[r%X]", offset);
 
-		// look up the handler
-		offs_t byteaddress = offset & m_bytemask;
+		// look up the handler; anything another execute group reaches is accessed under the scheduler lock
 		UINT32 entry = read_lookup(byteaddress);
 		const handler_entry_read &handler = m_read.handler_read(entry);
+		device_scheduler::parallel_sync sync(machine().scheduler(), m_read.parallel_mode(entry));
 
 		// either read directly from RAM, or call the delegate
 		offset = handler.byteoffset(byteaddress);
 		_NativeType result;
-		if (entry <= STATIC_BANKMAX) result = *reinterpret_cast<_NativeType *>(handler.ramptr(offset));
+		if (entry <= STATIC_BANKMAX) { result = *reinterpret_cast<_NativeType *>(handler.ramptr(offset)); if (!sync.locked()) m_read_cache.update(byteaddress); }
 		else if (sizeof(_NativeType) == 1) result = handler.read8(*this, offset, 0xff);
 		else if (sizeof(_NativeType) == 2) result = handler.read16(*this, offset >> 1, 0xffff);
 		else if (sizeof(_NativeType) == 4) result = handler.read32(*this, offset >> 2, 0xffffffff);
@@ -1144,12 +1247,21 @@ public:
 	// native write
 	void write_native(offs_t offset, _NativeType data, _NativeType mask)
 	{
+		// RAM within the most recently used range can be written directly
+		offs_t byteaddress = offset & m_bytemask;
+		if (EXPECTED(m_write_cache.contains(byteaddress)))
+		{
+			_NativeType *dest = reinterpret_cast<_NativeType *>(m_write_cache.ptr(byteaddress));
+			*dest = (*dest & ~mask) | (data & mask);
+			return;
+		}
+
 		g_profiler.start(PROFILER_MEMWRITE);
 
-		// look up the handler
-		offs_t byteaddress = offset & m_bytemask;
+		// look up the handler; anything another execute group reaches is accessed under the scheduler lock
 		UINT32 entry = write_lookup(byteaddress);
 		const handler_entry_write &handler = m_write.handler_write(entry);
+		device_scheduler::parallel_sync sync(machine().scheduler(), m_write.parallel_mode(entry));
 
 		// either write directly to RAM, or call the delegate
 		offset = handler.byteoffset(byteaddress);
@@ -1157,6 +1269,8 @@ public:
 		{
 			_NativeType *dest = reinterpret_cast<_NativeType *>(handler.ramptr(offset));
 			*dest = (*dest & ~mask) | (data & mask);
+			if (!sync.locked())
+				m_write_cache.update(byteaddress);
 		}
 		else if (sizeof(_NativeType) == 1) handler.write8(*this, offset, data, mask);
 		else if (sizeof(_NativeType) == 2) handler.write16(*this, offset >> 1, data, mask);
@@ -1169,16 +1283,24 @@ public:
 	// mask-less native write
 	void write_native(offs_t offset, _NativeType data)
 	{
+		// RAM within the most recently used range can be written directly
+		offs_t byteaddress = offset & m_bytemask;
+		if (EXPECTED(m_write_cache.contains(byteaddress)))
+		{
+			*reinterpret_cast<_NativeType *>(m_write_cache.ptr(byteaddress)) = data;
+			return;
+		}
+
 		g_profiler.start(PROFILER_MEMWRITE);
 
-		// look up the handler
-		offs_t byteaddress = offset & m_bytemask;
+		// look up the handler; anything another execute group reaches is accessed under the scheduler lock
 		UINT32 entry = write_lookup(byteaddress);
 		const handler_entry_write &handler = m_write.handler_write(entry);
+		device_scheduler::parallel_sync sync(machine().scheduler(), m_write.parallel_mode(entry));
 
 		// either write directly to RAM, or call the delegate
 		offset = handler.byteoffset(byteaddress);
-		if (entry <= STATIC_BANKMAX) *reinterpret_cast<_NativeType *>(handler.ramptr(offset)) = data;
+		if (entry <= STATIC_BANKMAX) { *reinterpret_cast<_NativeType *>(handler.ramptr(offset)) = data; if (!sync.locked()) m_write_cache.update(byteaddress); }
 		else if (sizeof(_NativeType) == 1) handler.write8(*this, offset, data, 0xff);
 		else if (sizeof(_NativeType) == 2) handler.write16(*this, offset >> 1, data, 0xffff);
 		else if (sizeof(_NativeType) == 4) handler.write32(*this, offset >> 2, data, 0xffffffff);
@@ -1449,31 +1571,38 @@ public:
 		handler.setoffset(*this, offset / sizeof(_NativeType));
 	}
 
-	// virtual access to these functions
-	UINT8 read_byte(offs_t address) override { return (NATIVE_BITS == 8) ? read_native(address & ~NATIVE_MASK) : read_direct<UINT8, true>(address, 0xff); }
-	UINT16 read_word(offs_t address) override { return (NATIVE_BITS == 16) ? read_native(address & ~NATIVE_MASK) : read_direct<UINT16, true>(address, 0xffff); }
+	// virtual access to these functions; the unmasked forms are reached via the inline wrappers in address_space
+	using address_space::read_word;
+	using address_space::read_dword;
+	using address_space::read_qword;
+	using address_space::write_word;
+	using address_space::write_dword;
+	using address_space::write_qword;
+
+	UINT8 read_byte_dispatch(offs_t address) override { return (NATIVE_BITS == 8) ? read_native(address & ~NATIVE_MASK) : read_direct<UINT8, true>(address, 0xff); }
+	UINT16 read_word_dispatch(offs_t address) override { return (NATIVE_BITS == 16) ? read_native(address & ~NATIVE_MASK) : read_direct<UINT16, true>(address, 0xffff); }
 	UINT16 read_word(offs_t address, UINT16 mask) override { return read_direct<UINT16, true>(address, mask); }
 	UINT16 read_word_unaligned(offs_t address) override { return read_direct<UINT16, false>(address, 0xffff); }
 	UINT16 read_word_unaligned(offs_t address, UINT16 mask) override { return read_direct<UINT16, false>(address, mask); }
-	UINT32 read_dword(offs_t address) override { return (NATIVE_BITS == 32) ? read_native(address & ~NATIVE_MASK) : read_direct<UINT32, true>(address, 0xffffffff); }
+	UINT32 read_dword_dispatch(offs_t address) override { return (NATIVE_BITS == 32) ? read_native(address & ~NATIVE_MASK) : read_direct<UINT32, true>(address, 0xffffffff); }
 	UINT32 read_dword(offs_t address, UINT32 mask) override { return read_direct<UINT32, true>(address, mask); }
 	UINT32 read_dword_unaligned(offs_t address) override { return read_direct<UINT32, false>(address, 0xffffffff); }
 	UINT32 read_dword_unaligned(offs_t address, UINT32 mask) override { return read_direct<UINT32, false>(address, mask); }
-	UINT64 read_qword(offs_t address) override { return (NATIVE_BITS == 64) ? read_native(address & ~NATIVE_MASK) : read_direct<UINT64, true>(address, U64(0xffffffffffffffff)); }
+	UINT64 read_qword_dispatch(offs_t address) override { return (NATIVE_BITS == 64) ? read_native(address & ~NATIVE_MASK) : read_direct<UINT64, true>(address, U64(0xffffffffffffffff)); }
 	UINT64 read_qword(offs_t address, UINT64 mask) override { return read_direct<UINT64, true>(address, mask); }
 	UINT64 read_qword_unaligned(offs_t address) override { return read_direct<UINT64, false>(address, U64(0xffffffffffffffff)); }
 	UINT64 read_qword_unaligned(offs_t address, UINT64 mask) override { return read_direct<UINT64, false>(address, mask); }
 
-	void write_byte(offs_t address, UINT8 data) override { if (NATIVE_BITS == 8) write_native(address & ~NATIVE_MASK, data); else write_direct<UINT8, true>(address, data, 0xff); }
-	void write_word(offs_t address, UINT16 data) override { if (NATIVE_BITS == 16) write_native(address & ~NATIVE_MASK, data); else write_direct<UINT16, true>(address, data, 0xffff); }
+	void write_byte_dispatch(offs_t address, UINT8 data) override { if (NATIVE_BITS == 8) write_native(address & ~NATIVE_MASK, data); else write_direct<UINT8, true>(address, data, 0xff); }
+	void write_word_dispatch(offs_t address, UINT16 data) override { if (NATIVE_BITS == 16) write_native(address & ~NATIVE_MASK, data); else write_direct<UINT16, true>(address, data, 0xffff); }
 	void write_word(offs_t address, UINT16 data, UINT16 mask) override { write_direct<UINT16, true>(address, data, mask); }
 	void write_word_unaligned(offs_t address, UINT16 data) override { write_direct<UINT16, false>(address, data, 0xffff); }
 	void write_word_unaligned(offs_t address, UINT16 data, UINT16 mask) override { write_direct<UINT16, false>(address, data, mask); }
-	void write_dword(offs_t address, UINT32 data) override { if (NATIVE_BITS == 32) write_native(address & ~NATIVE_MASK, data); else write_direct<UINT32, true>(address, data, 0xffffffff); }
+	void write_dword_dispatch(offs_t address, UINT32 data) override { if (NATIVE_BITS == 32) write_native(address & ~NATIVE_MASK, data); else write_direct<UINT32, true>(address, data, 0xffffffff); }
 	void write_dword(offs_t address, UINT32 data, UINT32 mask) override { write_direct<UINT32, true>(address, data, mask); }
 	void write_dword_unaligned(offs_t address, UINT32 data) override { write_direct<UINT32, false>(address, data, 0xffffffff); }
 	void write_dword_unaligned(offs_t address, UINT32 data, UINT32 mask) override { write_direct<UINT32, false>(address, data, mask); }
-	void write_qword(offs_t address, UINT64 data) override { if (NATIVE_BITS == 64) write_native(address & ~NATIVE_MASK, data); else write_direct<UINT64, true>(address, data, U64(0xffffffffffffffff)); }
+	void write_qword_dispatch(offs_t address, UINT64 data) override { if (NATIVE_BITS == 64) write_native(address & ~NATIVE_MASK, data); else write_direct<UINT64, true>(address, data, U64(0xffffffffffffffff)); }
 	void write_qword(offs_t address, UINT64 data, UINT64 mask) override { write_direct<UINT64, true>(address, data, mask); }
 	void write_qword_unaligned(offs_t address, UINT64 data) override { write_direct<UINT64, false>(address, data, U64(0xffffffffffffffff)); }
 	void write_qword_unaligned(offs_t address, UINT64 data, UINT64 mask) override { write_direct<UINT64, false>(address, data, mask); }
@@ -1548,7 +1677,10 @@ static void generate_memdump(running_machine &machine);
 memory_manager::memory_manager(running_machine &machine)
 	: m_machine(machine),
 		m_initialized(false),
-		m_banknext(STATIC_BANK1)
+		m_banknext(STATIC_BANK1),
+		m_parallel_enabled(false),
+		m_parallel_dirty(false),
+		m_parallel_ram_shared(false)
 {
 	memset(m_bank_ptr, 0, sizeof(m_bank_ptr));
 }
@@ -1594,6 +1726,16 @@ void memory_manager::initialize()
 			space->set_log_unmap(false);
 	}
 
+	// route handler accesses through the trace if requested
+	const char *tracefile = machine().options().memtrace();
+	if (tracefile != nullptr && tracefile[0] != 0)
+	{
+		m_trace = std::make_unique<memory_trace>(machine(), tracefile);
+		for (auto &space : m_spacelist)
+			space->enable_tracing(m_trace.get());
+		machine().add_notifier(MACHINE_NOTIFY_EXIT, machine_notify_delegate(FUNC(memory_trace::write), m_trace.get()));
+	}
+
 	// register a callback to reset banks when reloading state
 	machine().save().register_postload(save_prepost_delegate(FUNC(memory_manager::bank_reattach), this));
 
@@ -1711,6 +1853,72 @@ void memory_manager::bank_reattach()
 }
 
 
+//-------------------------------------------------
+//  update_parallel_sharing - work out which
+//  entries reach handlers that a space of another
+//  execute group reaches too, so that accesses
+//  through them sync while the groups run in
+//  parallel; groups whose spaces reach the same
+//  writable memory are not run in parallel at
+//  all, as opcode fetches and other direct
+//  accesses to it cannot be trapped
+//-------------------------------------------------
+
+void memory_manager::update_parallel_sharing()
+{
+	m_parallel_dirty = false;
+	bool ram_shared = false;
+
+	// gather everything reached from spaces of execute devices
+	std::vector<parallel_reach> reached;
+	for (auto &space : m_spacelist)
+	{
+		device_execute_interface *exec;
+		space->m_parallel_group = (m_parallel_enabled && space->device().interface(exec)) ? exec->parallel_group() : -1;
+		space->m_read_cache.set_parallel_group(space->m_parallel_group);
+		space->m_write_cache.set_parallel_group(space->m_parallel_group);
+		for (int write = 0; write < 2; write++)
+		{
+			address_table &table = write ? static_cast<address_table &>(space->write()) : static_cast<address_table &>(space->read());
+			table.clear_parallel_shared();
+			if (space->m_parallel_group >= 0)
+				table.add_parallel_reach(reached, space->m_parallel_group, write);
+		}
+	}
+
+	// overlapping reaches from different groups are shared, unless both only read memory
+	std::sort(reached.begin(), reached.end(), [](const parallel_reach &a, const parallel_reach &b) { return a.m_start < b.m_start; });
+	for (size_t first = 0; first < reached.size(); first++)
+		for (size_t second = first + 1; second < reached.size() && reached[second].m_start <= reached[first].m_end; second++)
+		{
+			const parallel_reach &a = reached[first];
+			const parallel_reach &b = reached[second];
+			if (a.m_group != b.m_group && (a.m_handler || b.m_handler || a.m_write || b.m_write))
+			{
+				if (!a.m_handler && !b.m_handler)
+				{
+					if (!ram_shared && !m_parallel_ram_shared)
+						osd_printf_warning("Execute groups of '%s' and '%s' share memory; running them in order\n", a.m_space->device().tag(), b.m_space->device().tag());
+					ram_shared = true;
+				}
+				else
+				{
+					a.m_table->set_parallel_shared(a.m_entry);
+					b.m_table->set_parallel_shared(b.m_entry);
+				}
+			}
+		}
+	m_parallel_ram_shared = ram_shared;
+
+	// cached RAM must not hide the shared ranges
+	for (auto &space : m_spacelist)
+	{
+		space->m_read_cache.force_update();
+		space->m_write_cache.force_update();
+	}
+}
+
+
 
 //**************************************************************************
 //  ADDRESS SPACE
@@ -1732,9 +1940,12 @@ address_space::address_space(memory_manager &manager, device_memory_interface &m
 		m_debugger_access(false),
 		m_log_unmap(true),
 		m_direct(std::make_unique<direct_read_data>(*this)),
+		m_read_cache(*this, ROW_READ),
+		m_write_cache(*this, ROW_WRITE),
 		m_name(memory.space_config(spacenum)->name()),
 		m_addrchars((m_config.m_addrbus_width + 3) / 4),
 		m_logaddrchars((m_config.m_logaddr_width + 3) / 4),
+		m_parallel_group(-1),
 		m_manager(manager),
 		m_machine(memory.device().machine())
 {
@@ -2921,10 +3132,14 @@ address_table::address_table(address_space &space, bool large)
 	: m_table(1 << LEVEL1_BITS),
 		m_space(space),
 		m_large(large),
+		m_watchpoints(false),
+		m_trace(nullptr),
+		m_trace_key(0),
 		m_subtable(SUBTABLE_COUNT),
 		m_subtable_alloc(0)
 {
 	m_live_lookup = &m_table[0];
+	clear_parallel_shared();
 
 	// make our static table all watchpoints
 	if (s_watchpoint_table[0] != STATIC_WATCHPOINT)
@@ -2984,6 +3199,11 @@ void address_table::map_range(offs_t addrstart, offs_t addrend, offs_t addrmask,
 
 	// recompute any direct access on this space if it is a read modification
 	m_space.m_direct->force_update(entry);
+	m_space.m_read_cache.force_update(entry);
+	m_space.m_write_cache.force_update(entry);
+
+	// the entry may now reach something another execute group does
+	m_space.manager().parallel_sharing_changed();
 
 	//  verify_reference_counts();
 }
@@ -3110,6 +3330,8 @@ void address_table::setup_range_masked(offs_t addrstart, offs_t addrend, offs_t
 
 		// recompute any direct access on this space if it is a read modification
 		m_space.m_direct->force_update(entry);
+		m_space.m_read_cache.force_update(entry);
+		m_space.m_write_cache.force_update(entry);
 	}
 
 	// Ranges in range_partial must be duplicated then partially changed
@@ -3152,6 +3374,8 @@ void address_table::setup_range_masked(offs_t addrstart, offs_t addrend, offs_t
 
 			// recompute any direct access on this space if it is a read modification
 			m_space.m_direct->force_update(entry);
+			m_space.m_read_cache.force_update(entry);
+			m_space.m_write_cache.force_update(entry);
 		}
 	}
 
@@ -3222,6 +3446,10 @@ void address_table::populate_range(offs_t bytestart, offs_t byteend, UINT16 hand
 	if (bytestart > byteend)
 		return;
 
+	// drop any data accesses cached over the range
+	m_space.m_read_cache.remove_intersecting_ranges(bytestart, byteend);
+	m_space.m_write_cache.remove_intersecting_ranges(bytestart, byteend);
+
 	// handle the starting edge if it's not on a block boundary
 	if (l2start != 0)
 	{
@@ -3727,6 +3955,44 @@ const char *address_table::handler_name(UINT16 entry) const
 }
 
 
+//-------------------------------------------------
+//  add_parallel_reach - add the host memory and
+//  handler objects reached through our entries
+//-------------------------------------------------
+
+void address_table::add_parallel_reach(std::vector<parallel_reach> &reached, int group, bool write)
+{
+	std::vector<const void *> objects;
+	for (UINT16 entry = STATIC_BANK1; entry < SUBTABLE_BASE; entry++)
+	{
+		// skip the unmap/nop/watchpoint entries and anything not in use
+		const handler_entry &curentry = handler(entry);
+		if ((entry > STATIC_BANKMAX && entry < STATIC_COUNT) || !curentry.populated())
+			continue;
+
+		// banks reach the memory from their current base to the end of the range
+		if (entry <= STATIC_BANKMAX)
+		{
+			const UINT8 *base = curentry.ramptr();
+			if (base != nullptr)
+				reached.push_back({ base, base + std::min(curentry.byteend() - curentry.bytestart(), curentry.bytemask()), &m_space, this, entry, group, false, write });
+		}
+
+		// handlers reach the objects their delegates are bound to
+		else
+		{
+			objects.clear();
+			curentry.bound_objects(objects);
+			for (const void *object : objects)
+			{
+				const UINT8 *start = reinterpret_cast<const UINT8 *>(object);
+				reached.push_back({ start, start, &m_space, this, entry, group, true, write });
+			}
+		}
+	}
+}
+
+
 //-------------------------------------------------
 //  address_table_read - constructor
 //-------------------------------------------------
@@ -4023,6 +4289,349 @@ void direct_read_data::explicit_configure(offs_t bytestart, offs_t byteend, offs
 
 
 
+//**************************************************************************
+//  DIRECT DATA CACHE
+//**************************************************************************
+
+//-------------------------------------------------
+//  direct_data_cache - constructor
+//-------------------------------------------------
+
+direct_data_cache::direct_data_cache(address_space &space, read_or_write readorwrite)
+	: m_space(space),
+		m_readorwrite(readorwrite),
+		m_nativemask(space.data_width() / 8 - 1),
+		m_xormask((space.endianness() == ENDIANNESS_NATIVE) ? 0 : m_nativemask)
+{
+	m_live.m_baseptr = m_spare.m_baseptr = nullptr;
+	m_live.m_handlerstart = m_spare.m_handlerstart = 0;
+	m_live.m_bytemask = m_spare.m_bytemask = 0;
+	m_live.m_entry = m_spare.m_entry = STATIC_UNMAP;
+	m_parallel_group = -1;
+	force_update();
+}
+
+
+//-------------------------------------------------
+//  parallel_owner - return true if the calling
+//  host thread may use the cache: always, unless
+//  groups are running in parallel and the thread
+//  runs a group other than the space's own
+//-------------------------------------------------
+
+bool direct_data_cache::parallel_owner() const
+{
+	return !m_space.machine().scheduler().parallel_active() || device_scheduler::current_parallel_group() == m_parallel_group;
+}
+
+
+//-------------------------------------------------
+//  table - return the address table whose
+//  accesses we cache
+//-------------------------------------------------
+
+address_table &direct_data_cache::table() const
+{
+	if (m_readorwrite == ROW_WRITE)
+		return m_space.write();
+	return m_space.read();
+}
+
+
+//-------------------------------------------------
+//  update - after an access to RAM/ROM/bank
+//  memory missed the cache, make the range
+//  around it the cached one
+//-------------------------------------------------
+
+void direct_data_cache::update(offs_t byteaddress)
+{
+	// watchpoints and traces need to see every access
+	address_table &tab = table();
+	if (tab.hooked())
+		return;
+
+	// the live range becomes the spare one
+	std::swap(m_live, m_spare);
+	if (byteaddress >= m_live.m_bytestart && byteaddress <= m_live.m_byteend)
+		return;
+
+	// find or allocate a matching range; only banks have a stable backing pointer
+	UINT16 entry;
+	direct_read_data::direct_range *range = find_range(byteaddress, entry);
+	if (entry < STATIC_BANK1 || entry > STATIC_BANKMAX || tab.parallel_shared(entry))
+	{
+		m_live.invalidate();
+		return;
+	}
+
+	// the bank base pointer is followed on each access, so bank switches need no update
+	const handler_entry &handler = tab.handler(entry);
+	m_live.m_baseptr = m_space.manager().bank_pointer_addr(entry);
+	m_live.m_handlerstart = handler.bytestart();
+	m_live.m_bytemask = handler.bytemask();
+	m_live.m_bytestart = range->m_bytestart;
+	m_live.m_byteend = range->m_byteend;
+	m_live.m_entry = entry;
+}
+
+
+//-------------------------------------------------
+//  find_range - find a byte address in a range
+//-------------------------------------------------
+
+direct_read_data::direct_range *direct_data_cache::find_range(offs_t byteaddress, UINT16 &entry)
+{
+	// determine which entry
+	address_table &tab = table();
+	entry = tab.lookup_live_nowp(byteaddress);
+
+	// scan our table
+	for (auto &range : m_rangelist[entry])
+		if (byteaddress >= range.m_bytestart && byteaddress <= range.m_byteend)
+			return &range;
+
+	// didn't find out; create a new one
+	direct_read_data::direct_range range;
+	tab.derive_range(byteaddress, range.m_bytestart, range.m_byteend);
+	m_rangelist[entry].push_front(range);
+
+	return &m_rangelist[entry].front();
+}
+
+
+//-------------------------------------------------
+//  remove_intersecting_ranges - remove all cached
+//  ranges that intersect the given address range
+//-------------------------------------------------
+
+void direct_data_cache::remove_intersecting_ranges(offs_t bytestart, offs_t byteend)
+{
+	// the live and spare ranges may be among them
+	if (m_live.intersects(bytestart, byteend))
+		m_live.invalidate();
+	if (m_spare.intersects(bytestart, byteend))
+		m_spare.invalidate();
+
+	// loop over all entries
+	for (auto &elem : m_rangelist)
+	{
+		// loop over all ranges in this entry's list
+		for (auto range = elem.begin(); range != elem.end(); )
+		{
+			// if we intersect, remove
+			if (bytestart <= range->m_byteend && byteend >= range->m_bytestart)
+				range = elem.erase(range);
+			else
+				range++;
+		}
+	}
+}
+
+
+
+//**************************************************************************
+//  MEMORY TRACE
+//**************************************************************************
+
+// The trace file is little-endian throughout:
+//
+//   header:   char[8] "MEMTRACE", UINT32 version, UINT32 handler count,
+//             UINT64 samples, UINT64 ticks per second
+//   handlers: UINT32 id, UINT8 flags (1 = write), UINT8 access bytes,
+//             UINT16 name length, UINT32 byte start, UINT32 byte end,
+//             UINT64 access count, name characters
+//   samples:  UINT32 id, UINT32 byte address, UINT32 ticks
+
+static std::atomic<UINT32> s_memory_trace_serial(0);
+
+static void trace_write_bytes(FILE *file, UINT64 value, int bytes)
+{
+	UINT8 buffer[8];
+	for (int index = 0; index < bytes; index++)
+		buffer[index] = value >> (8 * index);
+	fwrite(buffer, 1, bytes, file);
+}
+
+
+//-------------------------------------------------
+//  memory_trace - constructor
+//-------------------------------------------------
+
+memory_trace::memory_trace(running_machine &machine, const char *filename)
+	: m_machine(machine),
+		m_filename(filename),
+		m_serial(++s_memory_trace_serial)
+{
+}
+
+
+//-------------------------------------------------
+//  table_key - return the bits identifying a
+//  space's read or write table in handler keys
+//-------------------------------------------------
+
+UINT64 memory_trace::table_key(address_space &space, read_or_write readorwrite)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	auto table = std::make_pair(&space, readorwrite);
+	auto found = std::find(m_tables.begin(), m_tables.end(), table);
+	if (found == m_tables.end())
+		found = m_tables.insert(m_tables.end(), table);
+	return UINT64(found - m_tables.begin()) << 51;
+}
+
+
+//-------------------------------------------------
+//  count - count an access to a handler entry
+//  and decide whether to time it
+//-------------------------------------------------
+
+bool memory_trace::count(address_table &table, UINT16 entry, offs_t byteaddress, int bytes, UINT32 &id)
+{
+	thread_buffer &buffer = local_buffer();
+
+	// handlers are keyed by table, width, entry and the mirror of the range that was hit
+	offs_t bytestart, byteend;
+	table.handler(entry).mirrored_start_end(byteaddress, bytestart, byteend);
+	UINT64 key = table.trace_key() | (UINT64(bytes - 1) << 48) | (UINT64(entry) << 32) | bytestart;
+
+	// look up the id locally first, so only the first access on each thread locks
+	auto found = buffer.m_ids.find(key);
+	if (found != buffer.m_ids.end())
+		id = found->second;
+	else
+	{
+		id = register_handler(key, table, entry, bytestart, byteend, bytes);
+		buffer.m_ids.emplace(key, id);
+	}
+
+	if (id >= buffer.m_counts.size())
+		buffer.m_counts.resize(id + 1, 0);
+	return ((buffer.m_counts[id]++ % SAMPLE_INTERVAL) == 0 && buffer.m_samples.size() < MAX_SAMPLES_PER_THREAD);
+}
+
+
+//-------------------------------------------------
+//  sample - record the time taken by an access
+//-------------------------------------------------
+
+void memory_trace::sample(UINT32 id, offs_t byteaddress, osd_ticks_t ticks)
+{
+	trace_sample sample;
+	sample.m_id = id;
+	sample.m_byteaddress = byteaddress;
+	sample.m_ticks = (ticks > 0xffffffff) ? 0xffffffff : ticks;
+	local_buffer().m_samples.push_back(sample);
+}
+
+
+//-------------------------------------------------
+//  local_buffer - return the calling thread's
+//  buffer, creating it on first use
+//-------------------------------------------------
+
+memory_trace::thread_buffer &memory_trace::local_buffer()
+{
+	static thread_local UINT32 s_serial = 0;
+	static thread_local thread_buffer *s_buffer = nullptr;
+	if (EXPECTED(s_serial == m_serial))
+		return *s_buffer;
+
+	std::lock_guard<std::mutex> lock(m_lock);
+	m_buffers.push_back(std::make_unique<thread_buffer>());
+	s_buffer = m_buffers.back().get();
+	s_serial = m_serial;
+	return *s_buffer;
+}
+
+
+//-------------------------------------------------
+//  register_handler - assign a global id to a
+//  handler key the first time any thread sees it
+//-------------------------------------------------
+
+UINT32 memory_trace::register_handler(UINT64 key, address_table &table, UINT16 entry, offs_t bytestart, offs_t byteend, int bytes)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	auto found = m_ids.find(key);
+	if (found != m_ids.end())
+		return found->second;
+
+	const std::pair<address_space *, read_or_write> &owner = m_tables[key >> 51];
+	handler_info info;
+	info.m_name = string_format("%s:%s:%s", owner.first->device().tag(), owner.first->name(), table.handler_name(entry));
+	info.m_readorwrite = owner.second;
+	info.m_bytes = bytes;
+	info.m_bytestart = bytestart;
+	info.m_byteend = byteend;
+
+	UINT32 id = m_handlers.size();
+	m_handlers.push_back(std::move(info));
+	m_ids.emplace(key, id);
+	return id;
+}
+
+
+//-------------------------------------------------
+//  write - merge the thread buffers and write
+//  the trace file
+//-------------------------------------------------
+
+void memory_trace::write()
+{
+	FILE *file = fopen(m_filename.c_str(), "wb");
+	if (file == nullptr)
+	{
+		osd_printf_error("Unable to open memory trace file %s\n", m_filename.c_str());
+		return;
+	}
+
+	// sum the counts from each thread
+	std::vector<UINT64> counts(m_handlers.size(), 0);
+	UINT64 samples = 0;
+	for (auto &buffer : m_buffers)
+	{
+		for (size_t id = 0; id < buffer->m_counts.size(); id++)
+			counts[id] += buffer->m_counts[id];
+		samples += buffer->m_samples.size();
+	}
+
+	// header
+	fwrite("MEMTRACE", 1, 8, file);
+	trace_write_bytes(file, 1, 4);
+	trace_write_bytes(file, m_handlers.size(), 4);
+	trace_write_bytes(file, samples, 8);
+	trace_write_bytes(file, osd_ticks_per_second(), 8);
+
+	// handlers
+	for (size_t id = 0; id < m_handlers.size(); id++)
+	{
+		const handler_info &info = m_handlers[id];
+		trace_write_bytes(file, id, 4);
+		trace_write_bytes(file, (info.m_readorwrite == ROW_WRITE) ? 1 : 0, 1);
+		trace_write_bytes(file, info.m_bytes, 1);
+		trace_write_bytes(file, info.m_name.length(), 2);
+		trace_write_bytes(file, info.m_bytestart, 4);
+		trace_write_bytes(file, info.m_byteend, 4);
+		trace_write_bytes(file, counts[id], 8);
+		fwrite(info.m_name.c_str(), 1, info.m_name.length(), file);
+	}
+
+	// samples
+	for (auto &buffer : m_buffers)
+		for (const trace_sample &sample : buffer->m_samples)
+		{
+			trace_write_bytes(file, sample.m_id, 4);
+			trace_write_bytes(file, sample.m_byteaddress, 4);
+			trace_write_bytes(file, sample.m_ticks, 4);
+		}
+
+	fclose(file);
+}
+
+
+
 //**************************************************************************
 //  MEMORY BLOCK
 //**************************************************************************
@@ -4162,6 +4771,9 @@ void memory_bank::invalidate_references()
 	// invalidate all the direct references to any referenced address spaces
 	for (auto &ref : m_reflist)
 		ref->space().direct().force_update();
+
+	// the bank may now overlap memory another execute group reaches
+	m_machine.memory().parallel_sharing_changed();
 }
 
 
@@ -4550,6 +5162,33 @@ const char *handler_entry_read::subunit_name(int entry) const
 }
 
 
+//-------------------------------------------------
+//  bound_objects - add the objects the delegates
+//  are bound to; width and I/O port stubs are
+//  bound to us, so look through them
+//-------------------------------------------------
+
+void handler_entry_read::bound_objects(std::vector<const void *> &objects) const
+{
+	for (int entry = 0; entry < std::max<int>(m_subunits, 1); entry++)
+	{
+		const access_handler &handler = (m_subunits != 0) ? m_subread[entry] : m_read;
+		const void *object = nullptr;
+		switch ((m_subunits != 0) ? m_subunit_infos[entry].m_size : m_datawidth)
+		{
+			case 8:     object = handler.r8.object();    break;
+			case 16:    object = handler.r16.object();   break;
+			case 32:    object = handler.r32.object();   break;
+			case 64:    object = handler.r64.object();   break;
+		}
+		if (object == this)
+			object = m_ioport;
+		if (object != nullptr)
+			objects.push_back(object);
+	}
+}
+
+
 //-------------------------------------------------
 //  remove_subunit - delete a subunit specific
 //  information and shift up the following ones
@@ -4864,6 +5503,33 @@ const char *handler_entry_write::subunit_name(int entry) const
 }
 
 
+//-------------------------------------------------
+//  bound_objects - add the objects the delegates
+//  are bound to; width and I/O port stubs are
+//  bound to us, so look through them
+//-------------------------------------------------
+
+void handler_entry_write::bound_objects(std::vector<const void *> &objects) const
+{
+	for (int entry = 0; entry < std::max<int>(m_subunits, 1); entry++)
+	{
+		const access_handler &handler = (m_subunits != 0) ? m_subwrite[entry] : m_write;
+		const void *object = nullptr;
+		switch ((m_subunits != 0) ? m_subunit_infos[entry].m_size : m_datawidth)
+		{
+			case 8:     object = handler.w8.object();    break;
+			case 16:    object = handler.w16.object();   break;
+			case 32:    object = handler.w32.object();   break;
+			case 64:    object = handler.w64.object();   break;
+		}
+		if (object == this)
+			object = m_ioport;
+		if (object != nullptr)
+			objects.push_back(object);
+	}
+}
+
+
 //-------------------------------------------------
 //  remove_subunit - delete a subunit specific
 //  information and shift up the following ones
@@ -65,6 +65,7 @@ struct game_driver;
 class address_map;
 class address_map_entry;
 class memory_manager;
+class memory_trace;
 class memory_bank;
 class memory_block;
 class memory_share;
@@ -203,6 +204,74 @@ private:
 };
 
 
+// ======================> direct_data_cache
+
+// direct_data_cache remembers the most recent RAM, ROM or bank range hit by
+// data reads or writes, so that further accesses to it can skip the table
+// lookup and handler dispatch
+class direct_data_cache
+{
+	friend class address_table;
+
+public:
+	// construction/destruction
+	direct_data_cache(address_space &space, read_or_write readorwrite);
+
+	// see if an address is within the cached range, and get a pointer to its backing memory
+	bool contains(offs_t byteaddress) const { return (byteaddress >= m_live.m_bytestart && byteaddress <= m_live.m_byteend); }
+	UINT8 *ptr(offs_t byteaddress) const { return *m_live.m_baseptr + ((byteaddress - m_live.m_handlerstart) & m_live.m_bytemask); }
+
+	// get a pointer for an aligned access of up to the native width, or nullptr if it must go through the handlers
+	template<typename _UintType> _UintType *access_ptr(offs_t byteaddress) const
+	{
+		if (sizeof(_UintType) > m_nativemask + 1 || (byteaddress & (sizeof(_UintType) - 1)) != 0 || !contains(byteaddress) || (m_parallel_group >= 0 && !parallel_owner()))
+			return nullptr;
+		return reinterpret_cast<_UintType *>(ptr(byteaddress ^ (m_xormask & ~(sizeof(_UintType) - 1))));
+	}
+
+	// attempt to cache the range around an address after a miss
+	void update(offs_t byteaddress);
+
+	// force a recomputation on the next access
+	void force_update() { m_live.invalidate(); m_spare.invalidate(); }
+	void force_update(UINT16 if_match) { if (m_live.m_entry == if_match) m_live.invalidate(); if (m_spare.m_entry == if_match) m_spare.invalidate(); }
+
+	// only the execute group owning the space may hit the cache while groups run in parallel
+	void set_parallel_group(int group) { m_parallel_group = group; }
+
+private:
+	// a single cached range
+	struct cached_range
+	{
+		void invalidate() { m_byteend = 0; m_bytestart = 1; }
+		bool intersects(offs_t bytestart, offs_t byteend) const { return (bytestart <= m_byteend && byteend >= m_bytestart); }
+
+		UINT8 **                m_baseptr;              // pointer to the bank base pointer
+		offs_t                  m_handlerstart;         // start address of the handler
+		offs_t                  m_bytemask;             // byte address mask of the handler
+		offs_t                  m_bytestart;            // minimum valid byte address
+		offs_t                  m_byteend;              // maximum valid byte address
+		UINT16                  m_entry;                // entry for this range
+	};
+
+	// internal helpers
+	address_table &table() const;
+	bool parallel_owner() const;
+	direct_read_data::direct_range *find_range(offs_t byteaddress, UINT16 &entry);
+	void remove_intersecting_ranges(offs_t bytestart, offs_t byteend);
+
+	// internal state
+	address_space &             m_space;
+	read_or_write               m_readorwrite;          // which table we cache
+	offs_t                      m_nativemask;           // byte mask of a native word
+	offs_t                      m_xormask;              // address xor to reach subunits of a host-ordered native word
+	cached_range                m_live;                 // range checked on every access
+	cached_range                m_spare;                // previous range, swapped in when code alternates between two
+	int                         m_parallel_group;       // execute group of the space while groups may run in parallel, or -1
+	std::list<direct_read_data::direct_range> m_rangelist[TOTAL_MEMORY_BANKS];  // list of ranges for each entry
+};
+
+
 // ======================> address_space_config
 
 // describes an address space and provides basic functions to map addresses to bytes
@@ -250,11 +319,13 @@ public:
 // address_space holds live information about an address space
 class address_space
 {
+	friend class memory_manager;
 	friend class address_table;
 	friend class address_table_read;
 	friend class address_table_write;
 	friend class address_table_setoffset;
 	friend class direct_read_data;
+	friend class direct_data_cache;
 
 protected:
 	// construction/destruction
@@ -300,37 +371,40 @@ public:
 	virtual void enable_read_watchpoints(bool enable = true) = 0;
 	virtual void enable_write_watchpoints(bool enable = true) = 0;
 
+	// route all handler accesses through the trace, or stop doing so
+	virtual void enable_tracing(memory_trace *trace) = 0;
+
 	// general accessors
 	virtual void accessors(data_accessors &accessors) const = 0;
 	virtual void *get_read_ptr(offs_t byteaddress) = 0;
 	virtual void *get_write_ptr(offs_t byteaddress) = 0;
 
 	// read accessors
-	virtual UINT8 read_byte(offs_t byteaddress) = 0;
-	virtual UINT16 read_word(offs_t byteaddress) = 0;
+	UINT8 read_byte(offs_t byteaddress) { UINT8 *ptr = m_read_cache.access_ptr<UINT8>(byteaddress & m_bytemask); return (ptr != nullptr) ? *ptr : read_byte_dispatch(byteaddress); }
+	UINT16 read_word(offs_t byteaddress) { UINT16 *ptr = m_read_cache.access_ptr<UINT16>(byteaddress & m_bytemask); return (ptr != nullptr) ? *ptr : read_word_dispatch(byteaddress); }
 	virtual UINT16 read_word(offs_t byteaddress, UINT16 mask) = 0;
 	virtual UINT16 read_word_unaligned(offs_t byteaddress) = 0;
 	virtual UINT16 read_word_unaligned(offs_t byteaddress, UINT16 mask) = 0;
-	virtual UINT32 read_dword(offs_t byteaddress) = 0;
+	UINT32 read_dword(offs_t byteaddress) { UINT32 *ptr = m_read_cache.access_ptr<UINT32>(byteaddress & m_bytemask); return (ptr != nullptr) ? *ptr : read_dword_dispatch(byteaddress); }
 	virtual UINT32 read_dword(offs_t byteaddress, UINT32 mask) = 0;
 	virtual UINT32 read_dword_unaligned(offs_t byteaddress) = 0;
 	virtual UINT32 read_dword_unaligned(offs_t byteaddress, UINT32 mask) = 0;
-	virtual UINT64 read_qword(offs_t byteaddress) = 0;
+	UINT64 read_qword(offs_t byteaddress) { UINT64 *ptr = m_read_cache.access_ptr<UINT64>(byteaddress & m_bytemask); return (ptr != nullptr) ? *ptr : read_qword_dispatch(byteaddress); }
 	virtual UINT64 read_qword(offs_t byteaddress, UINT64 mask) = 0;
 	virtual UINT64 read_qword_unaligned(offs_t byteaddress) = 0;
 	virtual UINT64 read_qword_unaligned(offs_t byteaddress, UINT64 mask) = 0;
 
 	// write accessors
-	virtual void write_byte(offs_t byteaddress, UINT8 data) = 0;
-	virtual void write_word(offs_t byteaddress, UINT16 data) = 0;
+	void write_byte(offs_t byteaddress, UINT8 data) { UINT8 *ptr = m_write_cache.access_ptr<UINT8>(byteaddress & m_bytemask); if (ptr != nullptr) *ptr = data; else write_byte_dispatch(byteaddress, data); }
+	void write_word(offs_t byteaddress, UINT16 data) { UINT16 *ptr = m_write_cache.access_ptr<UINT16>(byteaddress & m_bytemask); if (ptr != nullptr) *ptr = data; else write_word_dispatch(byteaddress, data); }
 	virtual void write_word(offs_t byteaddress, UINT16 data, UINT16 mask) = 0;
 	virtual void write_word_unaligned(offs_t byteaddress, UINT16 data) = 0;
 	virtual void write_word_unaligned(offs_t byteaddress, UINT16 data, UINT16 mask) = 0;
-	virtual void write_dword(offs_t byteaddress, UINT32 data) = 0;
+	void write_dword(offs_t byteaddress, UINT32 data) { UINT32 *ptr = m_write_cache.access_ptr<UINT32>(byteaddress & m_bytemask); if (ptr != nullptr) *ptr = data; else write_dword_dispatch(byteaddress, data); }
 	virtual void write_dword(offs_t byteaddress, UINT32 data, UINT32 mask) = 0;
 	virtual void write_dword_unaligned(offs_t byteaddress, UINT32 data) = 0;
 	virtual void write_dword_unaligned(offs_t byteaddress, UINT32 data, UINT32 mask) = 0;
-	virtual void write_qword(offs_t byteaddress, UINT64 data) = 0;
+	void write_qword(offs_t byteaddress, UINT64 data) { UINT64 *ptr = m_write_cache.access_ptr<UINT64>(byteaddress & m_bytemask); if (ptr != nullptr) *ptr = data; else write_qword_dispatch(byteaddress, data); }
 	virtual void write_qword(offs_t byteaddress, UINT64 data, UINT64 mask) = 0;
 	virtual void write_qword_unaligned(offs_t byteaddress, UINT64 data) = 0;
 	virtual void write_qword_unaligned(offs_t byteaddress, UINT64 data, UINT64 mask) = 0;
@@ -429,6 +503,17 @@ public:
 	void allocate_memory();
 	void locate_memory();
 
+protected:
+	// out-of-line accessors taken when an access misses the RAM/ROM caches
+	virtual UINT8 read_byte_dispatch(offs_t byteaddress) = 0;
+	virtual UINT16 read_word_dispatch(offs_t byteaddress) = 0;
+	virtual UINT32 read_dword_dispatch(offs_t byteaddress) = 0;
+	virtual UINT64 read_qword_dispatch(offs_t byteaddress) = 0;
+	virtual void write_byte_dispatch(offs_t byteaddress, UINT8 data) = 0;
+	virtual void write_word_dispatch(offs_t byteaddress, UINT16 data) = 0;
+	virtual void write_dword_dispatch(offs_t byteaddress, UINT32 data) = 0;
+	virtual void write_qword_dispatch(offs_t byteaddress, UINT64 data) = 0;
+
 private:
 	// internal helpers
 	virtual address_table_read &read() = 0;
@@ -465,9 +550,12 @@ protected:
 	bool                    m_debugger_access;  // treat accesses as coming from the debugger
 	bool                    m_log_unmap;        // log unmapped accesses in this space?
 	std::unique_ptr<direct_read_data> m_direct;    // fast direct-access read info
+	direct_data_cache       m_read_cache;       // last RAM/ROM/bank range hit by a data read
+	direct_data_cache       m_write_cache;      // last RAM/bank range hit by a data write
 	const char *            m_name;             // friendly name of the address space
 	UINT8                   m_addrchars;        // number of characters to use for physical addresses
 	UINT8                   m_logaddrchars;     // number of characters to use for logical addresses
+	int                     m_parallel_group;   // execute group of the owning device while groups run in parallel, or -1
 
 private:
 	memory_manager &        m_manager;          // reference to the owning manager
@@ -675,6 +763,78 @@ private:
 
 
 
+// ======================> memory_trace
+
+// memory_trace counts accesses that reach address space handlers and samples
+// their latency; each thread records into its own buffer without locking
+class memory_trace
+{
+	DISABLE_COPYING(memory_trace);
+
+public:
+	// every Nth access to a handler on a given thread is timed
+	static const UINT32 SAMPLE_INTERVAL = 64;
+	static const UINT32 MAX_SAMPLES_PER_THREAD = 1 << 22;
+
+	// construction/destruction
+	memory_trace(running_machine &machine, const char *filename);
+
+	// getters
+	running_machine &machine() const { return m_machine; }
+
+	// get the key bits identifying one table of a space
+	UINT64 table_key(address_space &space, read_or_write readorwrite);
+
+	// record an access; returns true if it should be timed and passed to sample()
+	bool count(address_table &table, UINT16 entry, offs_t byteaddress, int bytes, UINT32 &id);
+	void sample(UINT32 id, offs_t byteaddress, osd_ticks_t ticks);
+
+	// write out the trace file
+	void write();
+
+private:
+	// a handler, range and width combination that has been accessed
+	struct handler_info
+	{
+		std::string         m_name;                 // "device:space:handler"
+		read_or_write       m_readorwrite;          // read or write
+		UINT8               m_bytes;                // access width in bytes
+		offs_t              m_bytestart;            // start of the range
+		offs_t              m_byteend;              // end of the range
+	};
+
+	// a timed access
+	struct trace_sample
+	{
+		UINT32              m_id;                   // handler id
+		offs_t              m_byteaddress;          // address accessed
+		UINT32              m_ticks;                // osd ticks spent in the handler
+	};
+
+	// per-thread state
+	struct thread_buffer
+	{
+		std::unordered_map<UINT64, UINT32> m_ids;   // handler key to id
+		std::vector<UINT64>         m_counts;       // accesses per handler id
+		std::vector<trace_sample>   m_samples;      // timed accesses
+	};
+
+	// internal helpers
+	thread_buffer &local_buffer();
+	UINT32 register_handler(UINT64 key, address_table &table, UINT16 entry, offs_t bytestart, offs_t byteend, int bytes);
+
+	// internal state
+	running_machine &           m_machine;              // reference to the owning machine
+	std::string                 m_filename;             // trace file to write
+	UINT32                      m_serial;               // distinguishes traces across machine resets
+	std::mutex                  m_lock;                 // guards new handlers and buffers only
+	std::vector<std::pair<address_space *, read_or_write>> m_tables;  // tables being traced
+	std::unordered_map<UINT64, UINT32> m_ids;           // handler key to id
+	std::vector<handler_info>   m_handlers;             // information about each handler id
+	std::vector<std::unique_ptr<thread_buffer>> m_buffers;  // one buffer per recording thread
+};
+
+
 // ======================> memory_manager
 
 // holds internal state for the memory system
@@ -692,6 +852,7 @@ public:
 	const std::unordered_map<std::string, std::unique_ptr<memory_bank>> &banks() const { return m_banklist; }
 	const std::unordered_map<std::string, std::unique_ptr<memory_region>> &regions() const { return m_regionlist; }
 	const std::unordered_map<std::string, std::unique_ptr<memory_share>> &shares() const { return m_sharelist; }
+	const std::vector<std::unique_ptr<memory_block>> &blocks() const { return m_blocklist; }
 
 	// dump the internal memory tables to the given file
 	void dump(FILE *file);
@@ -699,6 +860,16 @@ public:
 	// pointers to a bank pointer (internal usage only)
 	UINT8 **bank_pointer_addr(UINT8 index) { return &m_bank_ptr[index]; }
 
+	// access tracing, if enabled
+	memory_trace *trace() const { return m_trace.get(); }
+
+	// tracking of what execute groups running in parallel share
+	void enable_parallel_sharing(bool enable) { if (enable != m_parallel_enabled) { m_parallel_enabled = enable; update_parallel_sharing(); } }
+	void parallel_sharing_changed() { m_parallel_dirty = true; }
+	bool parallel_sharing_dirty() const { return m_parallel_dirty; }
+	bool parallel_sharing_allowed() const { return !m_parallel_ram_shared; }
+	void update_parallel_sharing();
+
 	// regions
 	memory_region *region_alloc(const char *name, UINT32 length, UINT8 width, endianness_t endian);
 	void region_free(const char *name);
@@ -723,6 +894,12 @@ private:
 	std::unordered_map<std::string, std::unique_ptr<memory_share>>   m_sharelist;            // map for share lookups
 
 	std::unordered_map<std::string, std::unique_ptr<memory_region>>  m_regionlist;           // list of memory regions
+
+	std::unique_ptr<memory_trace> m_trace;              // handler access trace, if enabled
+
+	bool                        m_parallel_enabled;     // are execute groups run in parallel?
+	std::atomic<bool>           m_parallel_dirty;       // has the mapping changed since sharing was last worked out?
+	bool                        m_parallel_ram_shared;  // do spaces of different groups reach the same writable memory?
 };
 
 
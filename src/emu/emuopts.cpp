@@ -54,6 +54,9 @@ const options_entry emu_options::s_option_entries[] =
 	{ nullptr,                                              nullptr,        OPTION_HEADER,     "CORE STATE/PLAYBACK OPTIONS" },
 	{ OPTION_STATE,                                      nullptr,        OPTION_STRING,     "saved state to load" },
 	{ OPTION_AUTOSAVE,                                   "0",         OPTION_BOOLEAN,    "enable automatic restore at startup, and automatic save at exit time" },
+	{ OPTION_REWIND,                                     "0",         OPTION_BOOLEAN,    "keep a ring of in-memory snapshots that can be stepped back through" },
+	{ OPTION_REWIND_CAPACITY "(1-2048)",                 "100",       OPTION_INTEGER,    "size of the rewind ring in megabytes" },
+	{ OPTION_REWIND_INTERVAL "(1-3600)",                 "10",        OPTION_INTEGER,    "number of frames between rewind snapshots" },
 	{ OPTION_PLAYBACK ";pb",                             nullptr,        OPTION_STRING,     "playback an input file" },
 	{ OPTION_RECORD ";rec",                              nullptr,        OPTION_STRING,     "record an input file" },
 	{ OPTION_RECORD_TIMECODE,                            "0",            OPTION_BOOLEAN,    "record an input timecode file (requires -record option)" },
@@ -81,6 +84,7 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_SLEEP,                                      "1",         OPTION_BOOLEAN,    "enable sleeping, which gives time back to other applications when idle" },
 	{ OPTION_SPEED "(0.01-100)",                         "1.0",       OPTION_FLOAT,      "controls the speed of gameplay, relative to realtime; smaller numbers are slower" },
 	{ OPTION_REFRESHSPEED ";rs",                         "0",         OPTION_BOOLEAN,    "automatically adjusts the speed of gameplay to keep the refresh rate lower than the screen" },
+	{ OPTION_RUNAHEAD "(0-8)",                           "0",         OPTION_INTEGER,    "number of frames to emulate ahead of the displayed frame to hide input latency" },
 
 	// render options
 	{ nullptr,                                              nullptr,        OPTION_HEADER,     "CORE RENDER OPTIONS" },
@@ -169,6 +173,7 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_DEBUG ";d",                                 "0",         OPTION_BOOLEAN,    "enable/disable debugger" },
 	{ OPTION_UPDATEINPAUSE,                              "0",         OPTION_BOOLEAN,    "keep calling video updates while in pause" },
 	{ OPTION_DEBUGSCRIPT,                                nullptr,        OPTION_STRING,     "script for debugger" },
+	{ OPTION_MEMTRACE,                                   nullptr,        OPTION_STRING,     "write a binary trace of memory handler accesses to the given file" },
 
 	// comm options
 	{ nullptr,                                              nullptr,        OPTION_HEADER,     "CORE COMM OPTIONS" },
@@ -183,6 +188,12 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_DRC_USE_C,                                  "0",         OPTION_BOOLEAN,    "force DRC use C backend" },
 	{ OPTION_DRC_LOG_UML,                                "0",         OPTION_BOOLEAN,    "write DRC UML disassembly log" },
 	{ OPTION_DRC_LOG_NATIVE,                             "0",         OPTION_BOOLEAN,    "write DRC native disassembly log" },
+	{ OPTION_DRC_CACHE,                                  "",          OPTION_STRING,     "directory for the persistent DRC block cache (disabled if empty)" },
+	{ OPTION_DRC_VERIFY,                                 "0",         OPTION_BOOLEAN,    "check DRC results against the interpreter in lockstep" },
+	{ OPTION_DRC_EXPERIMENTAL,                           "0",         OPTION_BOOLEAN,    "also enable DRC cpu cores that are still experimental" },
+	{ OPTION_VOODOO_THREAD,                              "0",         OPTION_BOOLEAN,    "run Voodoo 1/2 drawing commands on a dedicated thread" },
+	{ OPTION_VOODOO_FRAMEHASH,                           "",          OPTION_STRING,     "file to record Voodoo frame hashes to, or compare them against if it exists" },
+	{ OPTION_N64_RDP_THREAD,                             "0",         OPTION_BOOLEAN,    "process N64 RDP command lists on a dedicated thread" },
 	{ OPTION_BIOS,                                       nullptr,        OPTION_STRING,     "select the system BIOS to use" },
 	{ OPTION_CHEAT ";c",                                 "0",         OPTION_BOOLEAN,    "enable cheat subsystem" },
 	{ OPTION_SKIP_GAMEINFO,                              "0",         OPTION_BOOLEAN,    "skip displaying the information screen at startup" },
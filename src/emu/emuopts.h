@@ -49,6 +49,9 @@
 // core state/playback options
 #define OPTION_STATE                "state"
 #define OPTION_AUTOSAVE             "autosave"
+#define OPTION_REWIND               "rewind"
+#define OPTION_REWIND_CAPACITY      "rewind_capacity"
+#define OPTION_REWIND_INTERVAL      "rewind_interval"
 #define OPTION_PLAYBACK             "playback"
 #define OPTION_RECORD               "record"
 #define OPTION_RECORD_TIMECODE      "record_timecode"
@@ -74,6 +77,7 @@
 #define OPTION_SLEEP                "sleep"
 #define OPTION_SPEED                "speed"
 #define OPTION_REFRESHSPEED         "refreshspeed"
+#define OPTION_RUNAHEAD             "runahead"
 
 // core render options
 #define OPTION_KEEPASPECT           "keepaspect"
@@ -153,12 +157,19 @@
 #define OPTION_OSLOG                "oslog"
 #define OPTION_UPDATEINPAUSE        "update_in_pause"
 #define OPTION_DEBUGSCRIPT          "debugscript"
+#define OPTION_MEMTRACE             "memtrace"
 
 // core misc options
 #define OPTION_DRC                  "drc"
 #define OPTION_DRC_USE_C            "drc_use_c"
 #define OPTION_DRC_LOG_UML          "drc_log_uml"
 #define OPTION_DRC_LOG_NATIVE       "drc_log_native"
+#define OPTION_DRC_CACHE            "drc_cache"
+#define OPTION_DRC_VERIFY           "drc_verify"
+#define OPTION_DRC_EXPERIMENTAL     "drc_experimental"
+#define OPTION_VOODOO_THREAD        "voodoo_thread"
+#define OPTION_VOODOO_FRAMEHASH     "voodoo_framehash"
+#define OPTION_N64_RDP_THREAD       "n64_rdp_thread"
 #define OPTION_BIOS                 "bios"
 #define OPTION_CHEAT                "cheat"
 #define OPTION_SKIP_GAMEINFO        "skip_gameinfo"
@@ -235,6 +246,9 @@ public:
 	// core state/playback options
 	const char *state() const { return value(OPTION_STATE); }
 	bool autosave() const { return bool_value(OPTION_AUTOSAVE); }
+	bool rewind() const { return bool_value(OPTION_REWIND); }
+	int rewind_capacity() const { return int_value(OPTION_REWIND_CAPACITY); }
+	int rewind_interval() const { return int_value(OPTION_REWIND_INTERVAL); }
 	const char *playback() const { return value(OPTION_PLAYBACK); }
 	const char *record() const { return value(OPTION_RECORD); }
 	bool record_timecode() const { return bool_value(OPTION_RECORD_TIMECODE); }
@@ -260,6 +274,7 @@ public:
 	bool sleep() const { return m_sleep; }
 	float speed() const { return float_value(OPTION_SPEED); }
 	bool refresh_speed() const { return m_refresh_speed; }
+	int runahead() const { return int_value(OPTION_RUNAHEAD); }
 
 	// core render options
 	bool keep_aspect() const { return bool_value(OPTION_KEEPASPECT); }
@@ -337,12 +352,19 @@ public:
 	bool oslog() const { return bool_value(OPTION_OSLOG); }
 	const char *debug_script() const { return value(OPTION_DEBUGSCRIPT); }
 	bool update_in_pause() const { return bool_value(OPTION_UPDATEINPAUSE); }
+	const char *memtrace() const { return value(OPTION_MEMTRACE); }
 
 	// core misc options
 	bool drc() const { return bool_value(OPTION_DRC); }
 	bool drc_use_c() const { return bool_value(OPTION_DRC_USE_C); }
 	bool drc_log_uml() const { return bool_value(OPTION_DRC_LOG_UML); }
 	bool drc_log_native() const { return bool_value(OPTION_DRC_LOG_NATIVE); }
+	const char *drc_cache() const { return value(OPTION_DRC_CACHE); }
+	bool drc_verify() const { return bool_value(OPTION_DRC_VERIFY); }
+	bool drc_experimental() const { return bool_value(OPTION_DRC_EXPERIMENTAL); }
+	bool voodoo_thread() const { return bool_value(OPTION_VOODOO_THREAD); }
+	const char *voodoo_framehash() const { return value(OPTION_VOODOO_FRAMEHASH); }
+	bool n64_rdp_thread() const { return bool_value(OPTION_N64_RDP_THREAD); }
 	const char *bios() const { return value(OPTION_BIOS); }
 	bool cheat() const { return bool_value(OPTION_CHEAT); }
 	bool skip_gameinfo() const { return bool_value(OPTION_SKIP_GAMEINFO); }
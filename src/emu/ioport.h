@@ -356,6 +356,7 @@ enum ioport_type
 		IPT_UI_PASTE,
 		IPT_UI_SAVE_STATE,
 		IPT_UI_LOAD_STATE,
+		IPT_UI_REWIND_SINGLE,
 		IPT_UI_TAPE_START,
 		IPT_UI_TAPE_STOP,
 		IPT_UI_DATS,
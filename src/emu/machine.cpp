@@ -124,6 +124,7 @@ running_machine::running_machine(const machine_config &_config, machine_manager
 		m_saveload_schedule(SLS_NONE),
 		m_saveload_schedule_time(attotime::zero),
 		m_saveload_searchpath(nullptr),
+		m_rewind_pending(0),
 
 		m_save(*this),
 		m_memory(*this),
@@ -234,6 +235,15 @@ void running_machine::start()
 	// save the random seed or save states might be broken in drivers that use the rand() method
 	save().save_item(NAME(m_rand_seed));
 
+	// set up the in-memory rewind ring if requested and the driver supports save states
+	if (options().rewind() && !(m_system.flags & MACHINE_SUPPORTS_SAVE))
+		osd_printf_warning("Rewind disabled: save states are not supported for this machine\n");
+	else if (options().rewind())
+	{
+		m_rewind = std::make_unique<rewinder>(m_save, UINT64(MAX(options().rewind_capacity(), 0)) * 1024 * 1024, options().rewind_interval());
+		add_notifier(MACHINE_NOTIFY_FRAME, machine_notify_delegate(FUNC(running_machine::rewind_frame_update), this));
+	}
+
 	// initialize image devices
 	m_image = std::make_unique<image_manager>(*this);
 	m_tilemap = std::make_unique<tilemap_manager>(*this);
@@ -340,6 +350,10 @@ int running_machine::run(bool quiet)
 			{
 				m_scheduler.timeslice();
 				emulator_info::periodic_check();
+
+				// speculatively run ahead after each real frame
+				if (m_video->runahead_pending())
+					run_ahead();
 			}
 			// otherwise, just pump video updates through
 			else
@@ -349,6 +363,10 @@ int running_machine::run(bool quiet)
 			if (m_saveload_schedule != SLS_NONE)
 				handle_saveload();
 
+			// handle rewind snapshots and restores
+			else if (m_rewind != nullptr)
+				handle_rewind();
+
 			g_profiler.stop();
 		}
 
@@ -668,6 +686,25 @@ void running_machine::immediate_load(const char *filename)
 }
 
 
+//-------------------------------------------------
+//  schedule_rewind - schedule stepping back the
+//  given number of in-memory snapshots
+//-------------------------------------------------
+
+void running_machine::schedule_rewind(int count)
+{
+	if (m_rewind == nullptr)
+	{
+		if (!(m_system.flags & MACHINE_SUPPORTS_SAVE))
+			popmessage("Error: Rewind is not supported for this machine.");
+		else
+			popmessage("Error: Rewind is not enabled (use -rewind).");
+		return;
+	}
+	m_rewind_pending += count;
+}
+
+
 //-------------------------------------------------
 //  pause - pause the system
 //-------------------------------------------------
@@ -904,6 +941,99 @@ void running_machine::handle_saveload()
 }
 
 
+//-------------------------------------------------
+//  handle_rewind - restore a pending rewind
+//  request, or take a snapshot if one is due
+//-------------------------------------------------
+
+void running_machine::handle_rewind()
+{
+	// anonymous timers can't be captured, so wait them out
+	if (!m_scheduler.can_save())
+		return;
+
+	if (m_rewind_pending != 0)
+	{
+		int const count = m_rewind_pending;
+		m_rewind_pending = 0;
+
+		attotime snaptime;
+		switch (m_rewind->step_back(count, snaptime))
+		{
+		case STATERR_NONE:
+			popmessage("Rewound to %s (%d snapshots left).", snaptime.as_string(2), m_rewind->slot_count());
+			break;
+
+		case STATERR_ILLEGAL_REGISTRATIONS:
+			popmessage("Error: Unable to rewind due to illegal registrations. See error.log for details.");
+			break;
+
+		default:
+			popmessage("Error: No rewind snapshot available.");
+			break;
+		}
+	}
+	else if (m_rewind->capture_pending())
+		m_rewind->capture();
+}
+
+
+//-------------------------------------------------
+//  run_ahead - emulate speculative frames with
+//  the current inputs, present the last one, and
+//  return to the end of the real frame
+//-------------------------------------------------
+
+void running_machine::run_ahead()
+{
+	// anonymous timers can't be captured; present without speculating
+	if (!m_scheduler.can_save())
+	{
+		m_video->end_runahead();
+		return;
+	}
+
+	// snapshot the real state; the buffer still holds the previous frame, so only changed pages need copying
+	save_error err;
+	if (m_runahead_state.empty())
+	{
+		m_runahead_state.resize(MAX(m_save.binary_size(), 1));
+		err = m_save.save_binary(&m_runahead_state[0], m_runahead_state.size());
+	}
+	else
+		err = m_save.save_binary_dirty(&m_runahead_state[0], m_runahead_state.size(), m_runahead_dirty);
+	if (err != STATERR_NONE)
+	{
+		m_runahead_state.clear();
+		m_video->end_runahead();
+		return;
+	}
+
+	// emulate ahead without producing sound
+	sound().suppress_output(true);
+	m_video->begin_runahead();
+	while (m_video->runahead_active() && !m_exit_pending && !m_hard_reset_pending)
+		m_scheduler.timeslice();
+	m_video->end_runahead();
+	sound().suppress_output(false);
+
+	// and roll back
+	m_save.load_binary(&m_runahead_state[0], m_runahead_state.size());
+}
+
+
+//-------------------------------------------------
+//  rewind_frame_update - count frames towards
+//  the next rewind snapshot
+//-------------------------------------------------
+
+void running_machine::rewind_frame_update()
+{
+	if (!paused())
+		m_rewind->frame_update();
+}
+
+
 //-------------------------------------------------
 //  soft_reset - actually perform a soft-reset
 //  of the system
@@ -161,6 +161,7 @@ public:
 	resource_pool &respool() { return m_respool; }
 	device_scheduler &scheduler() { return m_scheduler; }
 	save_manager &save() { return m_save; }
+	rewinder *rewind() const { return m_rewind.get(); }
 	memory_manager &memory() { return m_memory; }
 	ioport_manager &ioport() { return m_ioport; }
 	parameters_manager &parameters() { return m_parameters; }
@@ -222,6 +223,7 @@ public:
 	void schedule_soft_reset();
 	void schedule_save(const char *filename);
 	void schedule_load(const char *filename);
+	void schedule_rewind(int count = 1);
 
 	// date & time
 	void base_datetime(system_time &systime);
@@ -255,6 +257,9 @@ private:
 	void set_saveload_filename(const char *filename);
 	std::string get_statename(const char *statename_opt) const;
 	void handle_saveload();
+	void handle_rewind();
+	void run_ahead();
+	void rewind_frame_update();
 	void soft_reset(void *ptr = nullptr, INT32 param = 0);
 	std::string nvram_filename(device_t &device) const;
 	void nvram_load();
@@ -322,6 +327,14 @@ private:
 	std::string             m_saveload_pending_file;
 	const char *            m_saveload_searchpath;
 
+	// in-memory rewind
+	std::unique_ptr<rewinder> m_rewind;             // snapshot ring, or nullptr if disabled
+	int                     m_rewind_pending;       // number of snapshots to step back
+
+	// run-ahead
+	std::vector<UINT8>      m_runahead_state;       // state of the last real frame
+	std::vector<UINT32>     m_runahead_dirty;       // pages that changed since the previous real frame
+
 	// notifier callbacks
 	struct notifier_callback_item
 	{
@@ -391,6 +404,9 @@ inline void running_machine::logerror(Format &&fmt, Params &&... args) const
 	{
 		g_profiler.start(PROFILER_LOGERROR);
 
+		// execute groups running in parallel share the buffer and the log targets
+		device_scheduler::parallel_sync sync(const_cast<device_scheduler &>(m_scheduler), device_scheduler::parallel_sync::SYNC_LOCK);
+
 		// dump to the buffer
 		m_string_buffer.clear();
 		m_string_buffer.seekp(0);
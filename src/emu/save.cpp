@@ -11,11 +11,20 @@
     Save state file format:
 
     00..07  'MAMESAVE'
-    08      Format version (this is format 2)
+    08      Format version (this is format 3)
     09      Flags
     0A..1B  Game name padded with \0
     1C..1F  Signature
-    20..end Save game data (compressed)
+    20..23  Uncompressed size of each chunk
+    24..27  Number of chunks (N)
+    28..    N x compressed size of each chunk
+    ...     Save game data, as N independently zlib-compressed chunks
+
+    All sizes are little-endian. The save game data is the concatenation
+    of all registered entries in order; the last chunk may be short.
+
+    Format 2 is identical up to 1F, followed by the save game data as a
+    single compressed stream. It can still be loaded.
 
     Data is always written as native-endian.
     Data is converted from the endiannness it was written upon load.
@@ -24,6 +33,7 @@
 
 #include "emu.h"
 #include "coreutil.h"
+#include <zlib.h>
 
 
 //**************************************************************************
@@ -40,9 +50,13 @@
 //  CONSTANTS
 //**************************************************************************
 
-const int SAVE_VERSION      = 2;
+const int SAVE_VERSION      = 3;
+const int SAVE_VERSION_STREAM = 2;
 const int HEADER_SIZE       = 32;
 
+// chunks are compressed in parallel, and only re-compressed when they change
+const UINT32 FILE_CHUNK_SIZE = 64 * save_manager::DIRTY_PAGE_SIZE;
+
 // Available flags
 enum
 {
@@ -62,8 +76,22 @@ enum
 save_manager::save_manager(running_machine &machine)
 	: m_machine(machine),
 		m_reg_allowed(true),
-		m_illegal_regs(0)
+		m_illegal_regs(0),
+		m_binary_size(0),
+		m_queue(nullptr),
+		m_file_chunk_size(0)
+{
+}
+
+
+//-------------------------------------------------
+//  ~save_manager - destructor
+//-------------------------------------------------
+
+save_manager::~save_manager()
 {
+	if (m_queue != nullptr)
+		osd_work_queue_free(m_queue);
 }
 
 
@@ -77,7 +105,17 @@ void save_manager::allow_registration(bool allowed)
 	// allow/deny registration
 	m_reg_allowed = allowed;
 	if (!allowed)
+	{
+		// lay out all entries back-to-back for in-memory snapshots
+		m_binary_size = 0;
+		for (auto &entry : m_entry_list)
+		{
+			entry->m_offset = m_binary_size;
+			m_binary_size += entry->m_typesize * entry->m_typecount;
+		}
+
 		dump_registry();
+	}
 }
 
 
@@ -121,6 +159,27 @@ void save_manager::register_presave(save_prepost_delegate func)
 }
 
 
+//-------------------------------------------------
+//  register_preload - register a pre-load
+//  function callback
+//-------------------------------------------------
+
+void save_manager::register_preload(save_prepost_delegate func)
+{
+	// check for invalid timing
+	if (!m_reg_allowed)
+		fatalerror("Attempt to register callback function after state registration is closed!\n");
+
+	// scan for duplicates and push through to the end
+	for (auto &cb : m_preload_list)
+		if (cb->m_func == func)
+			fatalerror("Duplicate save state function (%s/%s)\n", cb->m_func.name(), func.name());
+
+	// allocate a new entry
+	m_preload_list.push_back(std::make_unique<state_callback>(func));
+}
+
+
 //-------------------------------------------------
 //  state_save_register_postload -
 //  register a post-load function callback
@@ -213,6 +272,18 @@ save_error save_manager::check_file(running_machine &machine, emu_file &file, co
 	return validate_header(header, gamename, sig, errormsg, "");
 }
 
+//-------------------------------------------------
+//  dispatch_preload - invoke all registered
+//  preload callbacks before the data is replaced
+//-------------------------------------------------
+
+
+void save_manager::dispatch_preload()
+{
+	for (auto &func : m_preload_list)
+		func->m_func();
+}
+
 //-------------------------------------------------
 //  dispatch_postload - invoke all registered
 //  postload callbacks for updates
@@ -235,13 +306,12 @@ save_error save_manager::read_file(emu_file &file)
 	if (m_illegal_regs > 0)
 		return STATERR_ILLEGAL_REGISTRATIONS;
 
-	// read the header and turn on compression for the rest of the file
+	// read the header
 	file.compress(FCOMPRESS_NONE);
 	file.seek(0, SEEK_SET);
 	UINT8 header[HEADER_SIZE];
 	if (file.read(header, sizeof(header)) != sizeof(header))
 		return STATERR_READ_ERROR;
-	file.compress(FCOMPRESS_MEDIUM);
 
 	// verify the header and report an error if it doesn't match
 	UINT32 sig = signature();
@@ -251,6 +321,34 @@ save_error save_manager::read_file(emu_file &file)
 	// determine whether or not to flip the data when done
 	bool flip = NATIVE_ENDIAN_VALUE_LE_BE((header[9] & SS_MSB_FIRST) != 0, (header[9] & SS_MSB_FIRST) == 0);
 
+	// call the pre-load functions
+	dispatch_preload();
+
+	// read the data in whichever layout the file uses
+	save_error err = (header[8] == SAVE_VERSION_STREAM) ? read_file_legacy(file, flip) : read_file_chunked(file, flip);
+	if (err != STATERR_NONE)
+		return err;
+
+	// call the post-load functions
+	dispatch_postload();
+
+	return STATERR_NONE;
+}
+
+
+//-------------------------------------------------
+//  read_file_legacy - read the data from a file
+//  written as a single compressed stream
+//-------------------------------------------------
+
+save_error save_manager::read_file_legacy(emu_file &file, bool flip)
+{
+	// the cached image no longer matches what is in memory
+	m_file_image.clear();
+
+	// turn on compression for the rest of the file
+	file.compress(FCOMPRESS_MEDIUM);
+
 	// read all the data, flipping if necessary
 	for (auto &entry : m_entry_list)
 	{
@@ -262,10 +360,72 @@ save_error save_manager::read_file(emu_file &file)
 		if (flip)
 			entry->flip_data();
 	}
+	return STATERR_NONE;
+}
 
-	// call the post-load functions
-	dispatch_postload();
 
+//-------------------------------------------------
+//  read_file_chunked - read the data from a file
+//  written as independently compressed chunks,
+//  decompressing them in parallel
+//-------------------------------------------------
+
+save_error save_manager::read_file_chunked(emu_file &file, bool flip)
+{
+	// read and sanity check the chunk layout
+	UINT32 layout[2];
+	if (file.read(layout, sizeof(layout)) != sizeof(layout))
+		return STATERR_READ_ERROR;
+	UINT32 const chunksize = LITTLE_ENDIANIZE_INT32(layout[0]);
+	UINT32 const chunks = LITTLE_ENDIANIZE_INT32(layout[1]);
+	if (chunksize == 0 || chunks != (m_binary_size + chunksize - 1) / chunksize)
+		return STATERR_INVALID_HEADER;
+
+	// read the compressed sizes followed by the compressed data
+	setup_file_chunks(chunksize);
+	std::vector<UINT32> lengths(chunks);
+	if (chunks != 0 && file.read(&lengths[0], chunks * 4) != chunks * 4)
+		return STATERR_READ_ERROR;
+	UINT64 remaining = file.size() - file.tell();
+	for (UINT32 chunknum = 0; chunknum < chunks; chunknum++)
+	{
+		file_chunk &chunk = m_file_chunks[chunknum];
+		UINT32 const length = LITTLE_ENDIANIZE_INT32(lengths[chunknum]);
+
+		// don't trust the length any further than the file goes
+		if (length == 0 || length > remaining)
+		{
+			m_file_image.clear();
+			return STATERR_READ_ERROR;
+		}
+		remaining -= length;
+
+		chunk.m_compressed.resize(length);
+		if (file.read(&chunk.m_compressed[0], length) != length)
+		{
+			m_file_image.clear();
+			return STATERR_READ_ERROR;
+		}
+	}
+
+	// decompress everything into the image
+	if (!process_file_chunks(decompress_chunk))
+	{
+		m_file_image.clear();
+		return STATERR_READ_ERROR;
+	}
+
+	// copy the data into place, flipping if necessary
+	for (auto &entry : m_entry_list)
+	{
+		memcpy(entry->m_data, &m_file_image[entry->m_offset], entry->m_typesize * entry->m_typecount);
+		if (flip)
+			entry->flip_data();
+	}
+
+	// a flipped image can't seed the next save; otherwise keep it and its chunks as a cache
+	if (flip || chunksize != FILE_CHUNK_SIZE)
+		m_file_image.clear();
 	return STATERR_NONE;
 }
 
@@ -300,22 +460,247 @@ save_error save_manager::write_file(emu_file &file)
 	UINT32 sig = signature();
 	*(UINT32 *)&header[0x1c] = LITTLE_ENDIANIZE_INT32(sig);
 
-	// write the header and turn on compression for the rest of the file
+	// write the header
 	file.compress(FCOMPRESS_NONE);
 	file.seek(0, SEEK_SET);
 	if (file.write(header, sizeof(header)) != sizeof(header))
 		return STATERR_WRITE_ERROR;
-	file.compress(FCOMPRESS_MEDIUM);
+
+	// gather the data; if we still hold the image from the last save or load, only
+	// chunks covering changed pages need to be compressed again
+	save_error err;
+	if (m_file_image.size() == m_binary_size && m_file_chunk_size == FILE_CHUNK_SIZE && !m_file_chunks.empty())
+	{
+		err = save_binary_dirty(&m_file_image[0], m_binary_size, m_file_dirty);
+		for (UINT32 page : m_file_dirty)
+			m_file_chunks[(page << DIRTY_PAGE_SHIFT) / FILE_CHUNK_SIZE].m_dirty = true;
+	}
+	else
+	{
+		setup_file_chunks(FILE_CHUNK_SIZE);
+		err = save_binary(m_file_image.data(), m_binary_size);
+	}
+	if (err != STATERR_NONE)
+	{
+		m_file_image.clear();
+		return err;
+	}
+
+	// compress the changed chunks in parallel
+	if (!process_file_chunks(compress_chunk))
+	{
+		m_file_image.clear();
+		return STATERR_WRITE_ERROR;
+	}
+
+	// write the chunk layout and sizes
+	UINT32 const chunks = m_file_chunks.size();
+	std::vector<UINT32> layout(2 + chunks);
+	layout[0] = LITTLE_ENDIANIZE_INT32(FILE_CHUNK_SIZE);
+	layout[1] = LITTLE_ENDIANIZE_INT32(chunks);
+	for (UINT32 chunknum = 0; chunknum < chunks; chunknum++)
+		layout[2 + chunknum] = LITTLE_ENDIANIZE_INT32(UINT32(m_file_chunks[chunknum].m_compressed.size()));
+	if (file.write(&layout[0], layout.size() * 4) != layout.size() * 4)
+		return STATERR_WRITE_ERROR;
+
+	// then write all the data
+	for (file_chunk &chunk : m_file_chunks)
+		if (file.write(&chunk.m_compressed[0], chunk.m_compressed.size()) != chunk.m_compressed.size())
+			return STATERR_WRITE_ERROR;
+	return STATERR_NONE;
+}
+
+
+//-------------------------------------------------
+//  setup_file_chunks - size the image and split
+//  it into chunks of the given size, all of which
+//  need processing
+//-------------------------------------------------
+
+void save_manager::setup_file_chunks(UINT32 chunksize)
+{
+	m_file_image.resize(m_binary_size);
+	m_file_chunk_size = chunksize;
+	m_file_chunks.resize((m_binary_size + chunksize - 1) / chunksize);
+	for (UINT32 chunknum = 0; chunknum < m_file_chunks.size(); chunknum++)
+	{
+		file_chunk &chunk = m_file_chunks[chunknum];
+		chunk.m_data = &m_file_image[chunknum * chunksize];
+		chunk.m_length = MIN(chunksize, m_binary_size - chunknum * chunksize);
+		chunk.m_dirty = true;
+	}
+}
+
+
+//-------------------------------------------------
+//  process_file_chunks - run the given callback
+//  over all dirty chunks on the work queue and
+//  report whether they all succeeded
+//-------------------------------------------------
+
+bool save_manager::process_file_chunks(osd_work_callback callback)
+{
+	// allocate the queue on first use
+	if (m_queue == nullptr)
+		m_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+
+	// queue up each dirty chunk; clean ones keep their previous result
+	for (file_chunk &chunk : m_file_chunks)
+	{
+		chunk.m_success = !chunk.m_dirty;
+		if (chunk.m_dirty)
+		{
+			if (m_queue != nullptr)
+				osd_work_item_queue(m_queue, callback, &chunk, WORK_ITEM_FLAG_AUTO_RELEASE);
+			else
+				(*callback)(&chunk, 0);
+		}
+	}
+	if (m_queue != nullptr)
+		osd_work_queue_wait(m_queue, osd_ticks_per_second() * 100);
+
+	// check the results
+	bool success = true;
+	for (file_chunk &chunk : m_file_chunks)
+	{
+		success = success && chunk.m_success;
+		chunk.m_dirty = false;
+	}
+	return success;
+}
+
+
+//-------------------------------------------------
+//  compress_chunk - work item callback to
+//  compress one chunk of the image
+//-------------------------------------------------
+
+void *save_manager::compress_chunk(void *param, int threadid)
+{
+	file_chunk &chunk = *reinterpret_cast<file_chunk *>(param);
+
+	chunk.m_compressed.resize(compressBound(chunk.m_length));
+	uLongf length = chunk.m_compressed.size();
+	chunk.m_success = (compress2(&chunk.m_compressed[0], &length, chunk.m_data, chunk.m_length, FCOMPRESS_MEDIUM) == Z_OK);
+	chunk.m_compressed.resize(chunk.m_success ? length : 0);
+	return nullptr;
+}
+
+
+//-------------------------------------------------
+//  decompress_chunk - work item callback to
+//  decompress one chunk into the image
+//-------------------------------------------------
+
+void *save_manager::decompress_chunk(void *param, int threadid)
+{
+	file_chunk &chunk = *reinterpret_cast<file_chunk *>(param);
+
+	uLongf length = chunk.m_length;
+	chunk.m_success = (uncompress(chunk.m_data, &length, &chunk.m_compressed[0], chunk.m_compressed.size()) == Z_OK && length == chunk.m_length);
+	return nullptr;
+}
+
+
+//-------------------------------------------------
+//  save_binary - snapshot the state into a
+//  flat, uncompressed memory buffer
+//-------------------------------------------------
+
+save_error save_manager::save_binary(void *buf, UINT32 size)
+{
+	// if we have illegal registrations, return an error
+	if (m_illegal_regs > 0)
+		return STATERR_ILLEGAL_REGISTRATIONS;
+
+	// the buffer must be able to hold everything
+	if (size < m_binary_size)
+		return STATERR_WRITE_ERROR;
 
 	// call the pre-save functions
 	dispatch_presave();
 
-	// then write all the data
+	// then copy all the data
+	UINT8 *dest = reinterpret_cast<UINT8 *>(buf);
+	for (auto &entry : m_entry_list)
+		memcpy(&dest[entry->m_offset], entry->m_data, entry->m_typesize * entry->m_typecount);
+	return STATERR_NONE;
+}
+
+
+//-------------------------------------------------
+//  load_binary - restore the state from a
+//  buffer filled by save_binary
+//-------------------------------------------------
+
+save_error save_manager::load_binary(const void *buf, UINT32 size)
+{
+	// if we have illegal registrations, return an error
+	if (m_illegal_regs > 0)
+		return STATERR_ILLEGAL_REGISTRATIONS;
+
+	// the buffer must hold everything
+	if (size < m_binary_size)
+		return STATERR_READ_ERROR;
+
+	// call the pre-load functions
+	dispatch_preload();
+
+	// copy all the data; no flipping is needed as the buffer never leaves this machine
+	const UINT8 *src = reinterpret_cast<const UINT8 *>(buf);
+	for (auto &entry : m_entry_list)
+		memcpy(entry->m_data, &src[entry->m_offset], entry->m_typesize * entry->m_typecount);
+
+	// call the post-load functions
+	dispatch_postload();
+
+	return STATERR_NONE;
+}
+
+
+//-------------------------------------------------
+//  save_binary_dirty - bring a buffer previously
+//  filled by save_binary up to date, copying
+//  only the pages that changed; the indexes of
+//  those pages are returned in ascending order
+//-------------------------------------------------
+
+save_error save_manager::save_binary_dirty(void *buf, UINT32 size, std::vector<UINT32> &dirty)
+{
+	// if we have illegal registrations, return an error
+	if (m_illegal_regs > 0)
+		return STATERR_ILLEGAL_REGISTRATIONS;
+
+	// the buffer must be able to hold everything
+	if (size < m_binary_size)
+		return STATERR_WRITE_ERROR;
+
+	// call the pre-save functions
+	dispatch_presave();
+
+	// compare each entry against the buffer a page at a time; entries are laid
+	// out in order, so the pages come out sorted
+	dirty.clear();
+	UINT8 *dest = reinterpret_cast<UINT8 *>(buf);
 	for (auto &entry : m_entry_list)
 	{
-		UINT32 totalsize = entry->m_typesize * entry->m_typecount;
-		if (file.write(entry->m_data, totalsize) != totalsize)
-			return STATERR_WRITE_ERROR;
+		const UINT8 *src = reinterpret_cast<const UINT8 *>(entry->m_data);
+		UINT32 offset = entry->m_offset;
+		UINT32 remaining = entry->m_typesize * entry->m_typecount;
+		while (remaining != 0)
+		{
+			UINT32 const page = offset >> DIRTY_PAGE_SHIFT;
+			UINT32 const chunk = MIN(remaining, ((page + 1) << DIRTY_PAGE_SHIFT) - offset);
+			if (memcmp(&dest[offset], src, chunk) != 0)
+			{
+				memcpy(&dest[offset], src, chunk);
+				if (dirty.empty() || dirty.back() != page)
+					dirty.push_back(page);
+			}
+			src += chunk;
+			offset += chunk;
+			remaining -= chunk;
+		}
 	}
 	return STATERR_NONE;
 }
@@ -374,7 +759,7 @@ save_error save_manager::validate_header(const UINT8 *header, const char *gamena
 	}
 
 	// check save state version
-	if (header[8] != SAVE_VERSION)
+	if (header[8] != SAVE_VERSION && header[8] != SAVE_VERSION_STREAM)
 	{
 		if (errormsg != nullptr)
 			(*errormsg)("%sWrong version in save file (version %d, expected %d)", error_prefix, header[8], SAVE_VERSION);
@@ -465,3 +850,282 @@ void state_entry::flip_data()
 			break;
 	}
 }
+
+
+//**************************************************************************
+//  REWINDER
+//**************************************************************************
+
+//-------------------------------------------------
+//  rewinder - constructor
+//-------------------------------------------------
+
+rewinder::rewinder(save_manager &save, UINT64 capacity, int interval)
+	: m_save(save),
+		m_interval(MAX(interval, 1)),
+		m_frames(0),
+		m_capture_pending(false),
+		m_restored(false),
+		m_valid(false),
+		m_head_time(attotime::zero),
+		m_ring(MIN(capacity / 4, UINT64(0x7fffffff)))  // ring offsets are 32-bit word counts
+{
+}
+
+
+//-------------------------------------------------
+//  used - return the number of bytes currently
+//  occupied by stored deltas
+//-------------------------------------------------
+
+UINT64 rewinder::used() const
+{
+	UINT64 total = 0;
+	for (const rewind_slot &slot : m_slots)
+		total += slot.m_length;
+	return total * 4;
+}
+
+
+//-------------------------------------------------
+//  frame_update - count emulated frames and
+//  flag when a snapshot is due
+//-------------------------------------------------
+
+void rewinder::frame_update()
+{
+	if (++m_frames >= m_interval)
+	{
+		m_frames = 0;
+		m_capture_pending = true;
+	}
+}
+
+
+//-------------------------------------------------
+//  capture - take a snapshot, storing the delta
+//  that leads back to the previous one
+//-------------------------------------------------
+
+save_error rewinder::capture()
+{
+	m_capture_pending = false;
+
+	// size the buffers on first use; the layout is fixed once registration closes
+	UINT32 const words = (m_save.binary_size() + 3) / 4;
+	if (words == 0)
+		return STATERR_NONE;
+	if (m_head.size() != words)
+	{
+		m_head.assign(words, 0);
+		m_scratch.assign(words, 0);
+		m_delta.resize(words * 2 + 2);
+		m_slots.clear();
+		m_valid = false;
+	}
+
+	// the first snapshot is taken in full
+	if (!m_valid)
+	{
+		save_error err = m_save.save_binary(&m_head[0], words * 4);
+		if (err != STATERR_NONE)
+			return err;
+		m_scratch = m_head;
+	}
+
+	// later ones only copy the pages that changed since the head
+	else
+	{
+		save_error err = m_save.save_binary_dirty(&m_scratch[0], words * 4, m_dirty);
+		if (err != STATERR_NONE)
+			return err;
+
+		// store the delta from the new snapshot back to the previous head
+		UINT32 const length = encode_delta(&m_scratch[0], &m_head[0], words);
+		UINT32 offset;
+		if (allocate(length, offset))
+		{
+			memcpy(&m_ring[offset], &m_delta[0], length * 4);
+			m_slots.push_back(rewind_slot{ offset, length, m_head_time });
+		}
+		else
+		{
+			// older deltas can no longer be reached without this one
+			m_slots.clear();
+		}
+
+		// the new snapshot becomes the head
+		sync_dirty_pages();
+	}
+	m_head_time = m_save.machine().time();
+	m_valid = true;
+	m_restored = false;
+	return STATERR_NONE;
+}
+
+
+//-------------------------------------------------
+//  step_back - restore the snapshot taken the
+//  given number of captures ago
+//-------------------------------------------------
+
+save_error rewinder::step_back(int count, attotime &snaptime)
+{
+	if (!m_valid)
+		return STATERR_READ_ERROR;
+
+	// the first step returns to the head itself, unless we are already sitting on it
+	int deltas = count - (m_restored ? 0 : 1);
+	if (deltas > slot_count())
+		deltas = slot_count();
+
+	// walk the head backwards, consuming deltas newest first
+	while (deltas-- > 0)
+	{
+		apply_delta(m_slots.back());
+		m_head_time = m_slots.back().m_time;
+		m_slots.pop_back();
+	}
+
+	// push it into the machine; the scratch buffer must track the head again
+	save_error err = m_save.load_binary(&m_head[0], m_head.size() * 4);
+	m_scratch = m_head;
+	m_restored = true;
+	m_capture_pending = false;
+	m_frames = 0;
+	snaptime = m_head_time;
+	return err;
+}
+
+
+//-------------------------------------------------
+//  encode_delta - XOR the dirty pages of two
+//  snapshots and run-length encode the result
+//  into m_delta as pairs of (unchanged words,
+//  changed words) followed by the changed words;
+//  returns the length in words
+//-------------------------------------------------
+
+UINT32 rewinder::encode_delta(const UINT32 *newer, const UINT32 *older, UINT32 words)
+{
+	UINT32 const pagewords = save_manager::DIRTY_PAGE_SIZE / 4;
+	UINT32 *dest = &m_delta[0];
+	UINT32 last = 0;
+	for (UINT32 page : m_dirty)
+	{
+		UINT32 pos = page * pagewords;
+		UINT32 const end = MIN(pos + pagewords, words);
+		while (pos < end)
+		{
+			// skip over unchanged words
+			while (pos < end && newer[pos] == older[pos])
+				pos++;
+			if (pos == end)
+				break;
+
+			// gather changed words, absorbing single unchanged words to avoid tiny runs
+			UINT32 const runstart = pos;
+			while (pos < end && (newer[pos] != older[pos] || (pos + 1 < end && newer[pos + 1] != older[pos + 1])))
+				pos++;
+
+			*dest++ = runstart - last;
+			*dest++ = pos - runstart;
+			for (UINT32 index = runstart; index < pos; index++)
+				*dest++ = newer[index] ^ older[index];
+			last = pos;
+		}
+	}
+
+	// always emit at least one pair so that every delta occupies space in the ring
+	if (dest == &m_delta[0])
+	{
+		*dest++ = 0;
+		*dest++ = 0;
+	}
+	return dest - &m_delta[0];
+}
+
+
+//-------------------------------------------------
+//  sync_dirty_pages - copy the pages changed by
+//  the incoming snapshot into the head
+//-------------------------------------------------
+
+void rewinder::sync_dirty_pages()
+{
+	UINT32 const pagewords = save_manager::DIRTY_PAGE_SIZE / 4;
+	UINT32 const words = m_head.size();
+	for (UINT32 page : m_dirty)
+	{
+		UINT32 const start = page * pagewords;
+		memcpy(&m_head[start], &m_scratch[start], MIN(pagewords, words - start) * 4);
+	}
+}
+
+
+//-------------------------------------------------
+//  apply_delta - XOR a stored delta into the head
+//  snapshot
+//-------------------------------------------------
+
+void rewinder::apply_delta(const rewind_slot &slot)
+{
+	const UINT32 *src = &m_ring[slot.m_offset];
+	const UINT32 *const end = src + slot.m_length;
+	UINT32 *dest = &m_head[0];
+	while (src < end)
+	{
+		dest += *src++;
+		UINT32 count = *src++;
+		while (count-- != 0)
+			*dest++ ^= *src++;
+	}
+}
+
+
+//-------------------------------------------------
+//  allocate - find room in the ring for a delta
+//  of the given length, evicting the oldest
+//  deltas as needed
+//-------------------------------------------------
+
+bool rewinder::allocate(UINT32 length, UINT32 &offset)
+{
+	UINT32 const capacity = m_ring.size();
+	if (length > capacity)
+		return false;
+
+	while (!m_slots.empty())
+	{
+		UINT32 const oldest = m_slots.front().m_offset;
+		UINT32 const end = m_slots.back().m_offset + m_slots.back().m_length;
+
+		// unwrapped: free space is after the newest and before the oldest
+		if (m_slots.back().m_offset >= oldest)
+		{
+			if (end + length <= capacity)
+			{
+				offset = end;
+				return true;
+			}
+			if (length <= oldest)
+			{
+				offset = 0;
+				return true;
+			}
+		}
+
+		// wrapped: free space is between the newest and the oldest
+		else if (end + length <= oldest)
+		{
+			offset = end;
+			return true;
+		}
+
+		// no room; drop the oldest delta and try again
+		m_slots.pop_front();
+	}
+
+	offset = 0;
+	return true;
+}
@@ -86,8 +86,13 @@ class save_manager
 	template<typename _ItemType> struct type_checker<_ItemType*> { static const bool is_atom = false; static const bool is_pointer = true; };
 
 public:
+	// incremental snapshots are compared and copied in pages of this size
+	static const UINT32 DIRTY_PAGE_SHIFT = 12;
+	static const UINT32 DIRTY_PAGE_SIZE = 1 << DIRTY_PAGE_SHIFT;
+
 	// construction/destruction
 	save_manager(running_machine &machine);
+	~save_manager();
 
 	// getters
 	running_machine &machine() const { return m_machine; }
@@ -100,10 +105,12 @@ public:
 
 	// function registration
 	void register_presave(save_prepost_delegate func);
+	void register_preload(save_prepost_delegate func);
 	void register_postload(save_prepost_delegate func);
 
 	// callback dispatching
 	void dispatch_presave();
+	void dispatch_preload();
 	void dispatch_postload();
 
 	// generic memory registration
@@ -153,11 +160,33 @@ public:
 	save_error write_file(emu_file &file);
 	save_error read_file(emu_file &file);
 
+	// in-memory processing
+	UINT32 binary_size() const { return m_binary_size; }
+	save_error save_binary(void *buf, UINT32 size);
+	save_error load_binary(const void *buf, UINT32 size);
+	save_error save_binary_dirty(void *buf, UINT32 size, std::vector<UINT32> &dirty);
+
 private:
 	// internal helpers
 	UINT32 signature() const;
 	void dump_registry() const;
 	static save_error validate_header(const UINT8 *header, const char *gamename, UINT32 signature, void (CLIB_DECL *errormsg)(const char *fmt, ...), const char *error_prefix);
+	save_error read_file_legacy(emu_file &file, bool flip);
+	save_error read_file_chunked(emu_file &file, bool flip);
+	void setup_file_chunks(UINT32 chunksize);
+	bool process_file_chunks(osd_work_callback callback);
+	static void *compress_chunk(void *param, int threadid);
+	static void *decompress_chunk(void *param, int threadid);
+
+	// a piece of the state image that is compressed independently
+	struct file_chunk
+	{
+		UINT8 *                 m_data;             // uncompressed data within the image
+		UINT32                  m_length;           // uncompressed length
+		std::vector<UINT8>      m_compressed;       // compressed data
+		bool                    m_dirty;            // does this chunk need processing?
+		bool                    m_success;          // did processing succeed?
+	};
 
 	// state callback item
 	class state_callback
@@ -173,13 +202,76 @@ private:
 	running_machine &       m_machine;              // reference to our machine
 	bool                    m_reg_allowed;          // are registrations allowed?
 	int                     m_illegal_regs;         // number of illegal registrations
+	UINT32                  m_binary_size;          // total size of all registered entries
+
+	// save file compression
+	osd_work_queue *        m_queue;                // work queue for chunk compression
+	UINT32                  m_file_chunk_size;      // uncompressed size of each chunk
+	std::vector<UINT8>      m_file_image;           // image matching the cached compressed chunks
+	std::vector<file_chunk> m_file_chunks;          // compressed chunks of the image
+	std::vector<UINT32>     m_file_dirty;           // pages that changed since the last file operation
 
 	std::vector<std::unique_ptr<state_entry>> m_entry_list;          // list of reigstered entries
 	std::vector<std::unique_ptr<state_callback>> m_presave_list;     // list of pre-save functions
+	std::vector<std::unique_ptr<state_callback>> m_preload_list;     // list of pre-load functions
 	std::vector<std::unique_ptr<state_callback>> m_postload_list;    // list of post-load functions
 };
 
 
+// ======================> rewinder
+
+// in-memory ring of state snapshots, stored as deltas against each other
+class rewinder
+{
+public:
+	// construction/destruction
+	rewinder(save_manager &save, UINT64 capacity, int interval);
+
+	// getters
+	int slot_count() const { return m_slots.size(); }
+	UINT64 capacity() const { return UINT64(m_ring.size()) * 4; }
+	UINT64 used() const;
+	bool capture_pending() const { return m_capture_pending; }
+
+	// frame counting
+	void frame_update();
+
+	// snapshot operations
+	save_error capture();
+	save_error step_back(int count, attotime &snaptime);
+
+private:
+	// a single stored delta
+	struct rewind_slot
+	{
+		UINT32      m_offset;                       // offset of the delta within the ring, in words
+		UINT32      m_length;                       // length of the encoded delta, in words
+		attotime    m_time;                         // machine time of the snapshot it reconstructs
+	};
+
+	// internal helpers
+	UINT32 encode_delta(const UINT32 *newer, const UINT32 *older, UINT32 words);
+	void sync_dirty_pages();
+	void apply_delta(const rewind_slot &slot);
+	bool allocate(UINT32 length, UINT32 &offset);
+
+	// internal state
+	save_manager &          m_save;                 // reference to the save manager
+	int                     m_interval;             // frames between snapshots
+	int                     m_frames;               // frames since the last snapshot
+	bool                    m_capture_pending;      // is a snapshot due?
+	bool                    m_restored;             // has the head snapshot just been restored?
+	bool                    m_valid;                // does the head buffer hold a snapshot?
+	attotime                m_head_time;            // machine time of the head snapshot
+	std::vector<UINT32>     m_head;                 // most recent full snapshot
+	std::vector<UINT32>     m_scratch;              // incoming snapshot, equal to the head between captures
+	std::vector<UINT32>     m_dirty;                // pages changed by the incoming snapshot
+	std::vector<UINT32>     m_delta;                // encoded delta before it lands in the ring
+	std::vector<UINT32>     m_ring;                 // ring buffer of encoded deltas
+	std::deque<rewind_slot> m_slots;                // deltas, oldest first
+};
+
+
 // template specializations to enumerate the fundamental atomic types you are allowed to save
 ALLOW_SAVE_TYPE_AND_ARRAY(char)
 ALLOW_SAVE_TYPE          (bool); // std::vector<bool> may be packed internally
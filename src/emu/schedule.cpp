@@ -48,6 +48,8 @@ emu_timer::emu_timer()
 	: m_machine(nullptr),
 		m_next(nullptr),
 		m_prev(nullptr),
+		m_heap_index(-1),
+		m_heap_order(0),
 		m_param(0),
 		m_ptr(nullptr),
 		m_enabled(false),
@@ -81,6 +83,8 @@ emu_timer &emu_timer::init(running_machine &machine, timer_expired_delegate call
 	m_machine = &machine;
 	m_next = nullptr;
 	m_prev = nullptr;
+	m_heap_index = -1;
+	m_heap_order = 0;
 	m_callback = callback;
 	m_param = 0;
 	m_ptr = ptr;
@@ -113,6 +117,8 @@ emu_timer &emu_timer::init(device_t &device, device_timer_id id, void *ptr, bool
 	m_machine = &device.machine();
 	m_next = nullptr;
 	m_prev = nullptr;
+	m_heap_index = -1;
+	m_heap_order = 0;
 	m_callback = timer_expired_delegate();
 	m_param = 0;
 	m_ptr = ptr;
@@ -158,11 +164,11 @@ bool emu_timer::enable(bool enable)
 	if (old != enable)
 	{
 		// set the enable flag
+		device_scheduler::parallel_sync sync(machine().scheduler());
 		m_enabled = enable;
 
-		// remove the timer and insert back into the list
-		machine().scheduler().timer_list_remove(*this);
-		machine().scheduler().timer_list_insert(*this);
+		// move the timer to its new position in the queue
+		machine().scheduler().timer_heap_update(*this);
 	}
 	return old;
 }
@@ -178,6 +184,7 @@ void emu_timer::adjust(attotime start_delay, INT32 param, const attotime &period
 {
 	// if this is the callback timer, mark it modified
 	device_scheduler &scheduler = machine().scheduler();
+	device_scheduler::parallel_sync sync(scheduler);
 	if (scheduler.m_callback_timer == this)
 		scheduler.m_callback_timer_modified = true;
 
@@ -194,12 +201,11 @@ void emu_timer::adjust(attotime start_delay, INT32 param, const attotime &period
 	m_expire = m_start + start_delay;
 	m_period = period;
 
-	// remove and re-insert the timer in its new order
-	scheduler.timer_list_remove(*this);
-	scheduler.timer_list_insert(*this);
+	// move the timer to its new position in the queue
+	scheduler.timer_heap_update(*this);
 
-	// if this was inserted as the head, abort the current timeslice and resync
-	if (this == scheduler.first_timer())
+	// if this is now the next to expire, abort the current timeslice and resync
+	if (this == scheduler.next_timer())
 		scheduler.abort_timeslice();
 }
 
@@ -283,10 +289,8 @@ inline void emu_timer::schedule_next_period()
 	m_start = m_expire;
 	m_expire += m_period;
 
-	// remove and re-insert us
-	device_scheduler &scheduler = machine().scheduler();
-	scheduler.timer_list_remove(*this);
-	scheduler.timer_list_insert(*this);
+	// move us to our new position in the queue
+	machine().scheduler().timer_heap_update(*this);
 }
 
 
@@ -310,6 +314,9 @@ void emu_timer::dump() const
 //  DEVICE SCHEDULER
 //**************************************************************************
 
+// the execute group being run by the calling host thread, if any
+thread_local device_scheduler::parallel_group *device_scheduler::s_current_group = nullptr;
+
 //-------------------------------------------------
 //  device_scheduler - constructor
 //-------------------------------------------------
@@ -320,15 +327,18 @@ device_scheduler::device_scheduler(running_machine &machine) :
 	m_execute_list(nullptr),
 	m_basetime(attotime::zero),
 	m_timer_list(nullptr),
+	m_timer_order(0),
 	m_callback_timer(nullptr),
 	m_callback_timer_modified(false),
 	m_callback_timer_expire_time(attotime::zero),
 	m_suspend_changes_pending(true),
+	m_parallel_queue(nullptr),
+	m_parallel_active(false),
+	m_parallel_target(attotime::zero),
 	m_quantum_minimum(ATTOSECONDS_IN_NSEC(1) / 1000)
 {
-	// append a single never-expiring timer so there is always one in the list
-	m_timer_list = &m_timer_allocator.alloc()->init(machine, timer_expired_delegate(), nullptr, true);
-	m_timer_list->adjust(attotime::never);
+	// append a single never-expiring timer so there is always one in the queue
+	m_timer_allocator.alloc()->init(machine, timer_expired_delegate(), nullptr, true).adjust(attotime::never);
 
 	// register global states
 	machine.save().save_item(NAME(m_basetime));
@@ -346,6 +356,10 @@ device_scheduler::~device_scheduler()
 	// remove all timers
 	while (m_timer_list != nullptr)
 		m_timer_allocator.reclaim(m_timer_list->release());
+
+	// free the work queue for parallel groups
+	if (m_parallel_queue != nullptr)
+		osd_work_queue_free(m_parallel_queue);
 }
 
 
@@ -410,6 +424,80 @@ inline void device_scheduler::apply_suspend_changes()
 }
 
 
+//-------------------------------------------------
+//  execute_device - execute a single device up
+//  to the target time, moving the target earlier
+//  if the device stops short of it
+//-------------------------------------------------
+
+inline void device_scheduler::execute_device(device_execute_interface &exec, attotime &target, device_execute_interface *&executing, bool call_debugger, bool profile)
+{
+	// only process if this CPU is executing or truly halted (not yielding)
+	// and if our target is later than the CPU's current time (coarse check)
+	if (EXPECTED((exec.m_suspend == 0 || exec.m_eatcycles) && target.seconds() >= exec.m_localtime.seconds()))
+	{
+		// compute how many attoseconds to execute this CPU
+		attoseconds_t delta = target.attoseconds() - exec.m_localtime.attoseconds();
+		if (delta < 0 && target.seconds() > exec.m_localtime.seconds())
+			delta += ATTOSECONDS_PER_SECOND;
+		assert(delta == (target - exec.m_localtime).as_attoseconds());
+
+		// if we have enough for at least 1 cycle, do the math
+		if (delta >= exec.m_attoseconds_per_cycle)
+		{
+			// compute how many cycles we want to execute
+			int ran = exec.m_cycles_running = divu_64x32((UINT64)delta >> exec.m_divshift, exec.m_divisor);
+			LOG(("  cpu '%s': %d (%d cycles)\n", exec.device().tag(), delta, exec.m_cycles_running));
+
+			// if we're not suspended, actually execute
+			if (exec.m_suspend == 0)
+			{
+				if (profile)
+					g_profiler.start(exec.m_profiler);
+
+				// note that this global variable cycles_stolen can be modified
+				// via the call to cpu_execute
+				exec.m_cycles_stolen = 0;
+				executing = &exec;
+				*exec.m_icountptr = exec.m_cycles_running;
+				if (!call_debugger)
+					exec.run();
+				else
+				{
+					debugger_start_cpu_hook(&exec.device(), target);
+					exec.run();
+					debugger_stop_cpu_hook(&exec.device());
+				}
+
+				// adjust for any cycles we took back
+				assert(ran >= *exec.m_icountptr);
+				ran -= *exec.m_icountptr;
+				assert(ran >= exec.m_cycles_stolen);
+				ran -= exec.m_cycles_stolen;
+				if (profile)
+					g_profiler.stop();
+			}
+
+			// account for these cycles
+			exec.m_totalcycles += ran;
+
+			// update the local time for this CPU
+			attotime deltatime(0, exec.m_attoseconds_per_cycle * ran);
+			assert(deltatime >= attotime::zero);
+			exec.m_localtime += deltatime;
+			LOG(("         %d ran, %d total, time = %s\n", ran, (INT32)exec.m_totalcycles, exec.m_localtime.as_string(PRECISION)));
+
+			// if the new local CPU time is less than our target, move the target up, but not before the base
+			if (exec.m_localtime < target)
+			{
+				target = max(exec.m_localtime, m_basetime);
+				LOG(("         (new target)\n"));
+			}
+		}
+	}
+}
+
+
 //-------------------------------------------------
 //  timeslice - execute all devices for a single
 //  timeslice
@@ -428,14 +516,14 @@ void device_scheduler::timeslice()
 		m_quantum_allocator.reclaim(m_quantum_list.detach_head());
 
 	// loop until we hit the next timer
-	while (m_basetime < m_timer_list->m_expire)
+	while (m_basetime < m_timer_heap[0]->m_expire)
 	{
 		// by default, assume our target is the end of the next quantum
 		attotime target(m_basetime + attotime(0, m_quantum_list.first()->m_actual));
 
 		// however, if the next timer is going to fire before then, override
-		if (m_timer_list->m_expire < target)
-			target = m_timer_list->m_expire;
+		if (m_timer_heap[0]->m_expire < target)
+			target = m_timer_heap[0]->m_expire;
 
 		LOG(("------------------\n"));
 		LOG(("cpu_timeslice: target = %s\n", target.as_string(PRECISION)));
@@ -444,73 +532,42 @@ void device_scheduler::timeslice()
 		if (m_suspend_changes_pending)
 			apply_suspend_changes();
 
-		// loop over all CPUs
-		for (device_execute_interface *exec = m_execute_list; exec != nullptr; exec = exec->m_nextexec)
+		// if we have loosely coupled groups, run them on their own threads; handlers
+		// reached from more than one group trap while they run, and groups sharing
+		// memory are run in order instead
+		bool parallel = !m_parallel_groups.empty();
+		if (parallel && machine().memory().parallel_sharing_dirty())
+			machine().memory().update_parallel_sharing();
+		parallel = parallel && machine().memory().parallel_sharing_allowed();
+		if (parallel)
 		{
-			// only process if this CPU is executing or truly halted (not yielding)
-			// and if our target is later than the CPU's current time (coarse check)
-			if (EXPECTED((exec->m_suspend == 0 || exec->m_eatcycles) && target.seconds() >= exec->m_localtime.seconds()))
+			m_parallel_target = target;
+			m_parallel_active = true;
+			for (parallel_group &group : m_parallel_groups)
 			{
-				// compute how many attoseconds to execute this CPU
-				attoseconds_t delta = target.attoseconds() - exec->m_localtime.attoseconds();
-				if (delta < 0 && target.seconds() > exec->m_localtime.seconds())
-					delta += ATTOSECONDS_PER_SECOND;
-				assert(delta == (target - exec->m_localtime).as_attoseconds());
-
-				// if we have enough for at least 1 cycle, do the math
-				if (delta >= exec->m_attoseconds_per_cycle)
-				{
-					// compute how many cycles we want to execute
-					int ran = exec->m_cycles_running = divu_64x32((UINT64)delta >> exec->m_divshift, exec->m_divisor);
-					LOG(("  cpu '%s': %d (%d cycles)\n", exec->device().tag(), delta, exec->m_cycles_running));
-
-					// if we're not suspended, actually execute
-					if (exec->m_suspend == 0)
-					{
-						g_profiler.start(exec->m_profiler);
-
-						// note that this global variable cycles_stolen can be modified
-						// via the call to cpu_execute
-						exec->m_cycles_stolen = 0;
-						m_executing_device = exec;
-						*exec->m_icountptr = exec->m_cycles_running;
-						if (!call_debugger)
-							exec->run();
-						else
-						{
-							debugger_start_cpu_hook(&exec->device(), target);
-							exec->run();
-							debugger_stop_cpu_hook(&exec->device());
-						}
-
-						// adjust for any cycles we took back
-						assert(ran >= *exec->m_icountptr);
-						ran -= *exec->m_icountptr;
-						assert(ran >= exec->m_cycles_stolen);
-						ran -= exec->m_cycles_stolen;
-						g_profiler.stop();
-					}
-
-					// account for these cycles
-					exec->m_totalcycles += ran;
-
-					// update the local time for this CPU
-					attotime deltatime(0, exec->m_attoseconds_per_cycle * ran);
-					assert(deltatime >= attotime::zero);
-					exec->m_localtime += deltatime;
-					LOG(("         %d ran, %d total, time = %s\n", ran, (INT32)exec->m_totalcycles, exec->m_localtime.as_string(PRECISION)));
-
-					// if the new local CPU time is less than our target, move the target up, but not before the base
-					if (exec->m_localtime < target)
-					{
-						target = max(exec->m_localtime, m_basetime);
-						LOG(("         (new target)\n"));
-					}
-				}
+				group.m_target = target;
+				osd_work_item_queue(m_parallel_queue, execute_group, &group, WORK_ITEM_FLAG_AUTO_RELEASE);
 			}
 		}
+
+		// loop over all CPUs not running on a group thread
+		for (device_execute_interface *exec = m_execute_list; exec != nullptr; exec = exec->m_nextexec)
+			if (!parallel || exec->m_parallel_group == 0)
+				execute_device(*exec, target, m_executing_device, call_debugger, true);
 		m_executing_device = nullptr;
 
+		// wait for the groups to reach their targets, and stop at the earliest; they
+		// work on live machine state, so there is no going on without them
+		if (parallel)
+		{
+			while (!osd_work_queue_wait(m_parallel_queue, osd_ticks_per_second() * 10))
+				osd_printf_warning("Still waiting for execute groups to reach %s\n", target.as_string(PRECISION));
+			m_parallel_active = false;
+			for (parallel_group &group : m_parallel_groups)
+				if (group.m_target < target)
+					target = group.m_target;
+		}
+
 		// update the base time
 		m_basetime = target;
 	}
@@ -520,6 +577,36 @@ void device_scheduler::timeslice()
 }
 
 
+//-------------------------------------------------
+//  execute_group - work callback to run all the
+//  devices in a loosely coupled group on a host
+//  thread up to the group's target time
+//-------------------------------------------------
+
+void *device_scheduler::execute_group(void *param, int threadid)
+{
+	parallel_group &group = *reinterpret_cast<parallel_group *>(param);
+	s_current_group = &group;
+	for (device_execute_interface *exec : group.m_execs)
+		group.m_scheduler->execute_device(*exec, group.m_target, group.m_executing, false, false);
+	group.m_executing = nullptr;
+	s_current_group = nullptr;
+	return nullptr;
+}
+
+
+//-------------------------------------------------
+//  parallel_executing - return the device that
+//  is executing on the calling host thread while
+//  groups are running in parallel
+//-------------------------------------------------
+
+device_execute_interface *device_scheduler::parallel_executing() const
+{
+	return (s_current_group != nullptr) ? s_current_group->m_executing : m_executing_device;
+}
+
+
 //-------------------------------------------------
 //  abort_timeslice - abort execution for the
 //  current timeslice
@@ -527,8 +614,9 @@ void device_scheduler::timeslice()
 
 void device_scheduler::abort_timeslice()
 {
-	if (m_executing_device != nullptr)
-		m_executing_device->abort_timeslice();
+	device_execute_interface *executing = currently_executing();
+	if (executing != nullptr)
+		executing->abort_timeslice();
 }
 
 
@@ -538,6 +626,8 @@ void device_scheduler::abort_timeslice()
 
 void device_scheduler::trigger(int trigid, const attotime &after)
 {
+	parallel_sync sync(*this, parallel_sync::SYNC_ALWAYS);
+
 	// ensure we have a list of executing devices
 	if (m_execute_list == nullptr)
 		rebuild_execute_list();
@@ -563,6 +653,7 @@ void device_scheduler::boost_interleave(const attotime &timeslice_time, const at
 	// ignore timeslices > 1 second
 	if (timeslice_time.seconds() > 0)
 		return;
+	parallel_sync sync(*this, parallel_sync::SYNC_ALWAYS);
 	add_scheduling_quantum(timeslice_time, boost_duration);
 }
 
@@ -574,6 +665,7 @@ void device_scheduler::boost_interleave(const attotime &timeslice_time, const at
 
 emu_timer *device_scheduler::timer_alloc(timer_expired_delegate callback, void *ptr)
 {
+	parallel_sync sync(*this);
 	return &m_timer_allocator.alloc()->init(machine(), callback, ptr, false);
 }
 
@@ -586,6 +678,7 @@ emu_timer *device_scheduler::timer_alloc(timer_expired_delegate callback, void *
 
 void device_scheduler::timer_set(const attotime &duration, timer_expired_delegate callback, int param, void *ptr)
 {
+	parallel_sync sync(*this);
 	m_timer_allocator.alloc()->init(machine(), callback, ptr, true).adjust(duration, param);
 }
 
@@ -598,6 +691,7 @@ void device_scheduler::timer_set(const attotime &duration, timer_expired_delegat
 
 void device_scheduler::timer_pulse(const attotime &period, timer_expired_delegate callback, int param, void *ptr)
 {
+	parallel_sync sync(*this);
 	m_timer_allocator.alloc()->init(machine(), callback, ptr, false).adjust(period, param, period);
 }
 
@@ -609,6 +703,7 @@ void device_scheduler::timer_pulse(const attotime &period, timer_expired_delegat
 
 emu_timer *device_scheduler::timer_alloc(device_t &device, device_timer_id id, void *ptr)
 {
+	parallel_sync sync(*this);
 	return &m_timer_allocator.alloc()->init(device, id, ptr, false);
 }
 
@@ -621,6 +716,7 @@ emu_timer *device_scheduler::timer_alloc(device_t &device, device_timer_id id, v
 
 void device_scheduler::timer_set(const attotime &duration, device_t &device, device_timer_id id, int param, void *ptr)
 {
+	parallel_sync sync(*this);
 	m_timer_allocator.alloc()->init(device, id, ptr, true).adjust(duration, param);
 }
 
@@ -666,25 +762,17 @@ void device_scheduler::presave()
 
 void device_scheduler::postload()
 {
-	// remove all timers and make a private list of permanent ones
-	simple_list<emu_timer> private_list;
-	while (m_timer_list != nullptr)
+	// temporary timers go away entirely (except our special never-expiring one)
+	emu_timer *next;
+	for (emu_timer *timer = m_timer_list; timer != nullptr; timer = next)
 	{
-		emu_timer &timer = *m_timer_list;
-
-		// temporary timers go away entirely (except our special never-expiring one)
-		if (timer.m_temporary && !timer.expire().is_never())
-			m_timer_allocator.reclaim(timer.release());
-
-		// permanent ones get added to our private list
-		else
-			private_list.append(timer_list_remove(timer));
+		next = timer->next();
+		if (timer->m_temporary && !timer->expire().is_never())
+			m_timer_allocator.reclaim(timer->release());
 	}
 
-	// now re-insert them; this effectively re-sorts them by time
-	emu_timer *timer;
-	while ((timer = private_list.detach_head()) != nullptr)
-		timer_list_insert(*timer);
+	// the expiration times of the rest have changed, so reorder the queue
+	timer_heap_rebuild();
 
 	m_suspend_changes_pending = true;
 	rebuild_execute_list();
@@ -804,55 +892,111 @@ void device_scheduler::rebuild_execute_list()
 
 	// append the suspend list to the end of the active list
 	*active_tailptr = suspend_list;
+
+	// sort devices into their loosely coupled groups; these are always run
+	// in order on the main thread when debugging
+	m_parallel_groups.clear();
+	if ((machine().debug_flags & DEBUG_FLAG_ENABLED) == 0)
+		for (device_execute_interface *exec = m_execute_list; exec != nullptr; exec = exec->m_nextexec)
+			if (exec->m_parallel_group != 0)
+			{
+				auto group = std::find_if(m_parallel_groups.begin(), m_parallel_groups.end(), [exec](const parallel_group &group) { return group.m_group == exec->m_parallel_group; });
+				if (group == m_parallel_groups.end())
+				{
+					m_parallel_groups.emplace_back();
+					group = m_parallel_groups.end() - 1;
+					group->m_scheduler = this;
+					group->m_group = exec->m_parallel_group;
+					group->m_executing = nullptr;
+				}
+				group->m_execs.push_back(exec);
+			}
+
+	// allocate a queue to run them on the first time we need it
+	if (!m_parallel_groups.empty() && m_parallel_queue == nullptr)
+		m_parallel_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI | WORK_QUEUE_FLAG_HIGH_FREQ);
+
+	// have the memory system work out what the groups share
+	machine().memory().enable_parallel_sharing(!m_parallel_groups.empty());
 }
 
 
 //-------------------------------------------------
-//  timer_list_insert - insert a new timer into
-//  the list at the appropriate location
+//  parallel_sync - take the scheduler lock if
+//  groups are currently running in parallel
 //-------------------------------------------------
 
-emu_timer &device_scheduler::timer_list_insert(emu_timer &timer)
+device_scheduler::parallel_sync::parallel_sync(device_scheduler &scheduler, sync_mode mode)
+	: m_scheduler(scheduler),
+		m_locked(mode != SYNC_NONE && scheduler.m_parallel_active),
+		m_mode(mode)
 {
-	// disabled timers sort to the end
-	const attotime &expire = timer.m_enabled ? timer.m_expire : attotime::never;
+	if (m_locked)
+		m_scheduler.m_parallel_lock.lock();
+}
 
-	// loop over the timer list
-	emu_timer *prevtimer = nullptr;
-	for (emu_timer *curtimer = m_timer_list; curtimer != nullptr; prevtimer = curtimer, curtimer = curtimer->next())
-	{
-		// if the current list entry expires after us, we should be inserted before it
-		if (curtimer->m_expire > expire)
-		{
-			// link the new guy in before the current list entry
-			timer.m_prev = curtimer->m_prev;
-			timer.m_next = curtimer;
 
-			if (curtimer->m_prev != nullptr)
-				curtimer->m_prev->m_next = &timer;
-			else
-				m_timer_list = &timer;
+//-------------------------------------------------
+//  ~parallel_sync - release the lock, and stop
+//  the calling device at its current time if the
+//  change must be seen before the slice ends
+//-------------------------------------------------
 
-			curtimer->m_prev = &timer;
-			return timer;
-		}
+device_scheduler::parallel_sync::~parallel_sync()
+{
+	if (m_locked)
+	{
+		bool sync = (m_mode == SYNC_ALWAYS) || (m_mode == SYNC_IF_DUE && m_scheduler.m_timer_heap[0]->m_expire < m_scheduler.m_parallel_target);
+		m_scheduler.m_parallel_lock.unlock();
+		if (sync)
+			m_scheduler.abort_timeslice();
 	}
+}
 
-	// need to insert after the last one
-	if (prevtimer != nullptr)
-		prevtimer->m_next = &timer;
-	else
-		m_timer_list = &timer;
 
-	timer.m_prev = prevtimer;
-	timer.m_next = nullptr;
+//-------------------------------------------------
+//  timer_heap_before - return true if timer1
+//  should fire before timer2; disabled timers
+//  sort to the end, and ties go to the timer
+//  that was queued first
+//-------------------------------------------------
+
+inline bool device_scheduler::timer_heap_before(const emu_timer &timer1, const emu_timer &timer2)
+{
+	const attotime &expire1 = timer1.m_enabled ? timer1.m_expire : attotime::never;
+	const attotime &expire2 = timer2.m_enabled ? timer2.m_expire : attotime::never;
+	if (expire1 != expire2)
+		return expire1 < expire2;
+	return timer1.m_heap_order < timer2.m_heap_order;
+}
+
+
+//-------------------------------------------------
+//  timer_list_insert - add a new timer to the
+//  list and to the expiration queue
+//-------------------------------------------------
+
+emu_timer &device_scheduler::timer_list_insert(emu_timer &timer)
+{
+	// link in at the head of the list
+	timer.m_prev = nullptr;
+	timer.m_next = m_timer_list;
+	if (m_timer_list != nullptr)
+		m_timer_list->m_prev = &timer;
+	m_timer_list = &timer;
+
+	// add to the bottom of the heap and let it bubble up
+	timer.m_heap_order = m_timer_order++;
+	timer.m_heap_index = m_timer_heap.size();
+	m_timer_heap.push_back(&timer);
+	timer_heap_sift_up(timer.m_heap_index);
 	return timer;
 }
 
 
 //-------------------------------------------------
 //  timer_list_remove - remove a timer from the
-//  linked list
+//  list and from the expiration queue
 //-------------------------------------------------
 
 emu_timer &device_scheduler::timer_list_remove(emu_timer &timer)
@@ -866,23 +1010,118 @@ emu_timer &device_scheduler::timer_list_remove(emu_timer &timer)
 	if (timer.m_next != nullptr)
 		timer.m_next->m_prev = timer.m_prev;
 
+	timer.m_prev = timer.m_next = nullptr;
+
+	// replace it in the heap with the last entry and restore the ordering
+	int index = timer.m_heap_index;
+	emu_timer *last = m_timer_heap.back();
+	m_timer_heap.pop_back();
+	if (last != &timer)
+	{
+		m_timer_heap[index] = last;
+		last->m_heap_index = index;
+		timer_heap_sift_up(index);
+		timer_heap_sift_down(last->m_heap_index);
+	}
+	timer.m_heap_index = -1;
 	return timer;
 }
 
 
+//-------------------------------------------------
+//  timer_heap_update - reposition a timer in the
+//  queue after its expiration time or enabled
+//  state has changed
+//-------------------------------------------------
+
+void device_scheduler::timer_heap_update(emu_timer &timer)
+{
+	// a changed timer sorts after any others with the same expiration time
+	timer.m_heap_order = m_timer_order++;
+	timer_heap_sift_up(timer.m_heap_index);
+	timer_heap_sift_down(timer.m_heap_index);
+}
+
+
+//-------------------------------------------------
+//  timer_heap_rebuild - restore the heap ordering
+//  after many expiration times have changed at
+//  once
+//-------------------------------------------------
+
+void device_scheduler::timer_heap_rebuild()
+{
+	for (int index = m_timer_heap.size() / 2 - 1; index >= 0; index--)
+		timer_heap_sift_down(index);
+}
+
+
+//-------------------------------------------------
+//  timer_heap_sift_up - move a heap entry towards
+//  the root until its parent expires before it
+//-------------------------------------------------
+
+void device_scheduler::timer_heap_sift_up(int index)
+{
+	emu_timer *timer = m_timer_heap[index];
+	while (index > 0)
+	{
+		int parent = (index - 1) / 2;
+		if (!timer_heap_before(*timer, *m_timer_heap[parent]))
+			break;
+		m_timer_heap[index] = m_timer_heap[parent];
+		m_timer_heap[index]->m_heap_index = index;
+		index = parent;
+	}
+	m_timer_heap[index] = timer;
+	timer->m_heap_index = index;
+}
+
+
+//-------------------------------------------------
+//  timer_heap_sift_down - move a heap entry away
+//  from the root until both children expire after
+//  it
+//-------------------------------------------------
+
+void device_scheduler::timer_heap_sift_down(int index)
+{
+	emu_timer *timer = m_timer_heap[index];
+	const int count = m_timer_heap.size();
+	while (true)
+	{
+		// pick the earlier of the two children
+		int child = index * 2 + 1;
+		if (child >= count)
+			break;
+		if (child + 1 < count && timer_heap_before(*m_timer_heap[child + 1], *m_timer_heap[child]))
+			child++;
+
+		// stop once we expire before it
+		if (!timer_heap_before(*m_timer_heap[child], *timer))
+			break;
+		m_timer_heap[index] = m_timer_heap[child];
+		m_timer_heap[index]->m_heap_index = index;
+		index = child;
+	}
+	m_timer_heap[index] = timer;
+	timer->m_heap_index = index;
+}
+
+
 //-------------------------------------------------
 //  execute_timers - execute timers that are due
 //-------------------------------------------------
 
 inline void device_scheduler::execute_timers()
 {
-	LOG(("execute_timers: new=%s head->expire=%s\n", m_basetime.as_string(PRECISION), m_timer_list->m_expire.as_string(PRECISION)));
+	LOG(("execute_timers: new=%s head->expire=%s\n", m_basetime.as_string(PRECISION), m_timer_heap[0]->m_expire.as_string(PRECISION)));
 
 	// now process any timers that are overdue
-	while (m_timer_list->m_expire <= m_basetime)
+	while (m_timer_heap[0]->m_expire <= m_basetime)
 	{
 		// if this is a one-shot timer, disable it now
-		emu_timer &timer = *m_timer_list;
+		emu_timer &timer = *m_timer_heap[0];
 		bool was_enabled = timer.m_enabled;
 		if (timer.m_period.is_zero() || timer.m_period.is_never())
 			timer.m_enabled = false;
@@ -982,7 +1221,11 @@ void device_scheduler::dump_timers() const
 {
 	machine().logerror("=============================================\n");
 	machine().logerror("Timer Dump: Time = %15s\n", time().as_string(PRECISION));
-	for (emu_timer *timer = first_timer(); timer != nullptr; timer = timer->next())
+
+	// dump in expiration order, which is the order they will fire in
+	std::vector<emu_timer *> sorted(m_timer_heap);
+	std::sort(sorted.begin(), sorted.end(), [](const emu_timer *timer1, const emu_timer *timer2) { return timer_heap_before(*timer1, *timer2); });
+	for (emu_timer *timer : sorted)
 		timer->dump();
 	machine().logerror("=============================================\n");
 }
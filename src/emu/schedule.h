@@ -90,8 +90,10 @@ private:
 
 	// internal state
 	running_machine *   m_machine;      // reference to the owning machine
-	emu_timer *         m_next;         // next timer in order in the list
-	emu_timer *         m_prev;         // previous timer in order in the list
+	emu_timer *         m_next;         // next timer in the list of all timers
+	emu_timer *         m_prev;         // previous timer in the list of all timers
+	int                 m_heap_index;   // index within the scheduler's expiration heap
+	UINT64              m_heap_order;   // insertion order, used to break ties in the heap
 	timer_expired_delegate m_callback;  // callback function
 	INT32               m_param;        // integer parameter
 	void *              m_ptr;          // pointer parameter
@@ -117,12 +119,42 @@ public:
 	device_scheduler(running_machine &machine);
 	~device_scheduler();
 
+	// guards scheduler and other shared machine state while execute groups
+	// run in parallel; depending on the mode, the calling device is forced
+	// to sync when another group may need to see its changes before the
+	// end of the slice
+	class parallel_sync
+	{
+	public:
+		enum sync_mode
+		{
+			SYNC_NONE,          // neither lock nor sync
+			SYNC_LOCK,          // lock only
+			SYNC_IF_DUE,        // lock, and sync if a timer is now due within the slice
+			SYNC_ALWAYS         // lock, and always sync
+		};
+
+		parallel_sync(device_scheduler &scheduler, sync_mode mode = SYNC_IF_DUE);
+		~parallel_sync();
+
+		// did this guard take the lock?
+		bool locked() const { return m_locked; }
+
+	private:
+		device_scheduler &          m_scheduler;            // reference to the scheduler
+		bool                        m_locked;               // did we take the lock?
+		sync_mode                   m_mode;                 // what to do when the guard is released
+	};
+
 	// getters
 	running_machine &machine() const { return m_machine; }
 	attotime time() const;
 	emu_timer *first_timer() const { return m_timer_list; }
-	device_execute_interface *currently_executing() const { return m_executing_device; }
+	emu_timer *next_timer() const { return m_timer_heap[0]; }
+	device_execute_interface *currently_executing() const { return m_parallel_active ? parallel_executing() : m_executing_device; }
 	bool can_save() const;
+	bool parallel_active() const { return m_parallel_active; }
+	static int current_parallel_group() { return (s_current_group != nullptr) ? s_current_group->m_group : 0; }
 
 	// execution
 	void timeslice();
@@ -148,6 +180,16 @@ public:
 	void eat_all_cycles();
 
 private:
+	// a group of loosely coupled devices executed on a host thread of its own
+	struct parallel_group
+	{
+		device_scheduler *          m_scheduler;            // back-pointer to the scheduler
+		int                         m_group;                // group number from the configuration
+		std::vector<device_execute_interface *> m_execs;    // devices in the group, in execution order
+		device_execute_interface *  m_executing;            // device currently executing within the group; only touched by the group's thread
+		attotime                    m_target;               // target time, lowered as devices stop early
+	};
+
 	// callbacks
 	void timed_trigger(void *ptr, INT32 param);
 	void presave();
@@ -158,10 +200,18 @@ private:
 	void rebuild_execute_list();
 	void apply_suspend_changes();
 	void add_scheduling_quantum(const attotime &quantum, const attotime &duration);
+	void execute_device(device_execute_interface &exec, attotime &target, device_execute_interface *&executing, bool call_debugger, bool profile);
+	device_execute_interface *parallel_executing() const;
+	static void *execute_group(void *param, int threadid);
 
 	// timer helpers
 	emu_timer &timer_list_insert(emu_timer &timer);
 	emu_timer &timer_list_remove(emu_timer &timer);
+	void timer_heap_update(emu_timer &timer);
+	void timer_heap_rebuild();
+	void timer_heap_sift_up(int index);
+	void timer_heap_sift_down(int index);
+	static bool timer_heap_before(const emu_timer &timer1, const emu_timer &timer2);
 	void execute_timers();
 
 	// internal state
@@ -171,7 +221,9 @@ private:
 	attotime                    m_basetime;                 // global basetime; everything moves forward from here
 
 	// list of active timers
-	emu_timer *                 m_timer_list;               // head of the active list
+	emu_timer *                 m_timer_list;               // head of the list of all timers, unordered
+	std::vector<emu_timer *>    m_timer_heap;               // binary min-heap of timers ordered by expiration
+	UINT64                      m_timer_order;              // insertion counter for stable heap ordering
 	fixed_allocator<emu_timer>  m_timer_allocator;          // allocator for timers
 
 	// other internal states
@@ -180,6 +232,14 @@ private:
 	attotime                    m_callback_timer_expire_time; // the original expiration time
 	bool                        m_suspend_changes_pending;  // suspend/resume changes are pending
 
+	// parallel execution of loosely coupled groups
+	std::vector<parallel_group> m_parallel_groups;          // groups that run on their own threads
+	osd_work_queue *            m_parallel_queue;           // work queue for running the groups
+	std::recursive_mutex        m_parallel_lock;            // lock for scheduler state while groups run
+	std::atomic<bool>           m_parallel_active;          // true while groups are running
+	attotime                    m_parallel_target;          // the target time for the groups
+	static thread_local parallel_group *s_current_group;    // group run by the calling host thread, if any
+
 	// scheduling quanta
 	class quantum_slot
 	{
@@ -282,7 +282,9 @@ void sound_stream::update()
 		update_sampindex -= m_sample_rate;
 	}
 
-	// generate samples to get us up to the appropriate time
+	// generate samples to get us up to the appropriate time; execute groups
+	// running in parallel can reach the same streams through their handlers
+	device_scheduler::parallel_sync sync(m_device.machine().scheduler(), device_scheduler::parallel_sync::SYNC_LOCK);
 	g_profiler.start(PROFILER_SOUND);
 	assert(m_output_sampindex - m_output_base_sampindex >= 0);
 	assert(update_sampindex - m_output_base_sampindex <= m_output_bufalloc);
@@ -814,6 +816,8 @@ sound_manager::sound_manager(running_machine &machine)
 		m_leftmix(machine.sample_rate()),
 		m_rightmix(machine.sample_rate()),
 		m_muted(0),
+		m_output_suppressed(false),
+		m_suppressed_leftover(0),
 		m_attenuation(0),
 		m_nosound_mode(machine.osd().no_sound()),
 		m_wavfile(nullptr),
@@ -937,6 +941,23 @@ bool sound_manager::indexed_mixer_input(int index, mixer_input &info) const
 }
 
 
+//-------------------------------------------------
+//  suppress_output - discard mixed samples
+//  instead of sending them anywhere; used while
+//  emulating speculative frames that will be
+//  rolled back
+//-------------------------------------------------
+
+void sound_manager::suppress_output(bool suppress)
+{
+	if (suppress && !m_output_suppressed)
+		m_suppressed_leftover = m_finalmix_leftover;
+	else if (!suppress && m_output_suppressed)
+		m_finalmix_leftover = m_suppressed_leftover;
+	m_output_suppressed = suppress;
+}
+
+
 //-------------------------------------------------
 //  mute - mute sound output
 //-------------------------------------------------
@@ -1090,7 +1111,7 @@ void sound_manager::update(void *ptr, int param)
 	m_finalmix_leftover = sample - samples_this_update * 1000;
 
 	// play the result
-	if (finalmix_offset > 0)
+	if (finalmix_offset > 0 && !m_output_suppressed)
 	{
 		if (!m_nosound_mode)
 			machine().osd().update_audio_stream(finalmix, finalmix_offset / 2);
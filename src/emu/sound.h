@@ -213,6 +213,7 @@ public:
 	void debugger_mute(bool turn_off = true) { mute(turn_off, MUTE_REASON_DEBUGGER); }
 	void system_mute(bool turn_off = true) { mute(turn_off, MUTE_REASON_SYSTEM); }
 	void system_enable(bool turn_on = true) { mute(!turn_on, MUTE_REASON_SYSTEM); }
+	void suppress_output(bool suppress = true);
 
 	// user gain controls
 	bool indexed_mixer_input(int index, mixer_input &info) const;
@@ -238,6 +239,8 @@ private:
 	std::vector<INT32>       m_rightmix;
 
 	UINT8               m_muted;
+	bool                m_output_suppressed;
+	UINT32              m_suppressed_leftover;
 	int                 m_attenuation;
 	int                 m_nosound_mode;
 
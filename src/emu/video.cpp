@@ -96,6 +96,10 @@ video_manager::video_manager(running_machine &machine)
 		m_frameskip_adjust(0),
 		m_skipping_this_frame(false),
 		m_average_oversleep(0),
+		m_runahead_frames(machine.options().runahead()),
+		m_runahead_remaining(0),
+		m_runahead_pending(false),
+		m_runahead_skip(false),
 		m_snap_target(nullptr),
 		m_snap_native(true),
 		m_snap_width(0),
@@ -122,6 +126,17 @@ video_manager::video_manager(running_machine &machine)
 	// extract initial execution state from global configuration settings
 	update_refresh_speed();
 
+	// speculative frames would trip breakpoints, so no run-ahead under the debugger
+	if (machine.debug_flags & DEBUG_FLAG_ENABLED)
+		m_runahead_frames = 0;
+
+	// run-ahead restores a save state every frame, so it needs a driver that supports them
+	if (m_runahead_frames > 0 && !(machine.system().flags & MACHINE_SUPPORTS_SAVE))
+	{
+		osd_printf_warning("Run-ahead disabled: save states are not supported for this machine\n");
+		m_runahead_frames = 0;
+	}
+
 	// create a render target for snapshots
 	const char *viewname = machine.options().snap_view();
 	m_snap_native = (machine.first_screen() != nullptr && (viewname[0] == 0 || strcmp(viewname, "native") == 0));
@@ -205,9 +220,19 @@ void video_manager::set_frameskip(int frameskip)
 
 void video_manager::frame_update(bool from_debugger)
 {
+	// speculative frames are handled separately
+	if (m_runahead_remaining != 0 && !from_debugger)
+	{
+		runahead_frame_update();
+		return;
+	}
+
 	// only render sound and video if we're in the running phase
 	int phase = machine().phase();
-	bool skipped_it = m_skipping_this_frame;
+
+	// with run-ahead, real frames are throttled but the last speculative frame is shown in their place
+	bool const deferred = !from_debugger && m_runahead_frames > 0 && phase == MACHINE_PHASE_RUNNING && !machine().paused();
+	bool skipped_it = deferred ? m_runahead_skip : m_skipping_this_frame;
 	if (phase == MACHINE_PHASE_RUNNING && (!machine().paused() || machine().options().update_in_pause()))
 	{
 		bool anything_changed = finish_screen_updates();
@@ -215,24 +240,30 @@ void video_manager::frame_update(bool from_debugger)
 		// if none of the screens changed and we haven't skipped too many frames in a row,
 		// mark this frame as skipped to prevent throttling; this helps for games that
 		// don't update their screen at the monitor refresh rate
-		if (!anything_changed && !m_auto_frameskip && m_frameskip_level == 0 && m_empty_skip_count++ < 3)
+		if (!deferred && !anything_changed && !m_auto_frameskip && m_frameskip_level == 0 && m_empty_skip_count++ < 3)
 			skipped_it = true;
 		else
 			m_empty_skip_count = 0;
 	}
 
 	// draw the user interface
-	emulator_info::draw_user_interface(machine());
+	if (!deferred)
+		emulator_info::draw_user_interface(machine());
 
 	// if we're throttling, synchronize before rendering
 	attotime current_time = machine().time();
 	if (!from_debugger && !skipped_it && effective_throttle())
 		update_throttle(current_time);
 
-	// ask the OSD to update
-	g_profiler.start(PROFILER_BLIT);
-	machine().osd().update(!from_debugger && skipped_it);
-	g_profiler.stop();
+	// ask the OSD to update, or leave it to the speculative frame
+	if (!deferred)
+	{
+		g_profiler.start(PROFILER_BLIT);
+		machine().osd().update(!from_debugger && skipped_it);
+		g_profiler.stop();
+	}
+	else
+		m_runahead_pending = true;
 
 	emulator_info::periodic_check();
 
@@ -261,6 +292,73 @@ void video_manager::frame_update(bool from_debugger)
 }
 
 
+//-------------------------------------------------
+//  begin_runahead - start emulating speculative
+//  frames after a real frame has completed
+//-------------------------------------------------
+
+void video_manager::begin_runahead()
+{
+	m_runahead_pending = false;
+	m_runahead_remaining = m_runahead_frames;
+
+	// only the last speculative frame needs to be drawn
+	m_skipping_this_frame = (m_runahead_remaining > 1) || m_runahead_skip;
+}
+
+
+//-------------------------------------------------
+//  end_runahead - finish speculation; if no
+//  speculative frame was presented, present what
+//  we have so the OSD still gets its update
+//-------------------------------------------------
+
+void video_manager::end_runahead()
+{
+	if (m_runahead_pending || m_runahead_remaining != 0)
+	{
+		emulator_info::draw_user_interface(machine());
+		g_profiler.start(PROFILER_BLIT);
+		machine().osd().update(true);
+		g_profiler.stop();
+	}
+	m_runahead_pending = false;
+	m_runahead_remaining = 0;
+
+	// real frames are never shown while running ahead
+	m_skipping_this_frame = true;
+}
+
+
+//-------------------------------------------------
+//  runahead_frame_update - handle the end of a
+//  speculative frame; inputs are not polled and
+//  frame notifiers are not called
+//-------------------------------------------------
+
+void video_manager::runahead_frame_update()
+{
+	// intermediate frames are emulated but never shown
+	if (m_runahead_remaining > 1)
+	{
+		m_runahead_remaining--;
+		m_skipping_this_frame = (m_runahead_remaining > 1) || m_runahead_skip;
+		return;
+	}
+
+	// the last one is presented in place of the real frame
+	finish_screen_updates();
+	emulator_info::draw_user_interface(machine());
+
+	g_profiler.start(PROFILER_BLIT);
+	machine().osd().update(m_runahead_skip);
+	g_profiler.stop();
+
+	emulator_info::periodic_check();
+	m_runahead_remaining = 0;
+}
+
+
 //-------------------------------------------------
 //  speed_text - print the text to be displayed
 //  into a string buffer
@@ -712,7 +810,7 @@ bool video_manager::finish_screen_updates()
 	anything_changed |= emulator_info::frame_hook();
 
 	// update our movie recording and burn-in state
-	if (!machine().paused())
+	if (!machine().paused() && m_runahead_remaining == 0)
 	{
 		record_frame();
 
@@ -988,6 +1086,13 @@ void video_manager::update_frameskip()
 	// increment the frameskip counter and determine if we will skip the next frame
 	m_frameskip_counter = (m_frameskip_counter + 1) % FRAMESKIP_LEVELS;
 	m_skipping_this_frame = s_skiptable[effective_frameskip()][m_frameskip_counter];
+
+	// when running ahead, the frameskip decision applies to the presented frame instead
+	if (m_runahead_frames > 0 && !machine().paused())
+	{
+		m_runahead_skip = m_skipping_this_frame;
+		m_skipping_this_frame = true;
+	}
 }
 
 
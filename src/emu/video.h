@@ -67,6 +67,9 @@ public:
 	float throttle_rate() const { return m_throttle_rate; }
 	bool fastforward() const { return m_fastforward; }
 	bool is_recording() const { return (m_mng_file || m_avi_file); }
+	int runahead_frames() const { return m_runahead_frames; }
+	bool runahead_pending() const { return m_runahead_pending; }
+	bool runahead_active() const { return m_runahead_remaining != 0; }
 
 	// setters
 	void set_frameskip(int frameskip);
@@ -83,6 +86,10 @@ public:
 	// render a frame
 	void frame_update(bool from_debugger = false);
 
+	// speculative run-ahead
+	void begin_runahead();
+	void end_runahead();
+
 	// current speed helpers
 	std::string speed_text();
 	double speed_percent() const { return m_speed_percent; }
@@ -127,6 +134,7 @@ private:
 	void update_frameskip();
 	void update_refresh_speed();
 	void recompute_speed(const attotime &emutime);
+	void runahead_frame_update();
 
 	// snapshot/movie helpers
 	void create_snapshot_bitmap(screen_device *screen);
@@ -172,6 +180,12 @@ private:
 	bool                m_skipping_this_frame;      // flag: TRUE if we are skipping the current frame
 	osd_ticks_t         m_average_oversleep;        // average number of ticks the OSD oversleeps
 
+	// run-ahead
+	int                 m_runahead_frames;          // number of frames to emulate ahead (0 == off)
+	int                 m_runahead_remaining;       // speculative frames left in the current run
+	bool                m_runahead_pending;         // flag: TRUE if a real frame awaits speculation
+	bool                m_runahead_skip;            // flag: TRUE if the presented frame should be skipped
+
 	// snapshot stuff
 	render_target *     m_snap_target;              // screen shapshot target
 	bitmap_rgb32        m_snap_bitmap;              // screen snapshot bitmap
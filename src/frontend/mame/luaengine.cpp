@@ -2330,6 +2330,7 @@ void lua_engine::initialize()
 				.addFunction ("soft_reset", &running_machine::schedule_soft_reset)
 				.addFunction ("save", &running_machine::schedule_save)
 				.addFunction ("load", &running_machine::schedule_load)
+				.addFunction ("rewind", &running_machine::schedule_rewind)
 				.addFunction ("system", &running_machine::system)
 				.addFunction ("video", &running_machine::video)
 				.addFunction ("render", &running_machine::render)
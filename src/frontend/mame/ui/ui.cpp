@@ -1431,6 +1431,10 @@ UINT32 mame_ui_manager::handler_ingame(render_container &container)
 		return LOADSAVE_LOAD;
 	}
 
+	// handle a rewind request
+	if (machine().ui_input().pressed(IPT_UI_REWIND_SINGLE))
+		machine().schedule_rewind();
+
 	// handle a save snapshot request
 	if (machine().ui_input().pressed(IPT_UI_SNAPSHOT))
 		machine().video().save_active_screen_snapshots();
@@ -517,6 +517,9 @@ public:
 	bool has_object() const { return (object() != nullptr); }
 	const char *name() const { return m_name; }
 
+	// return the actual object (not the one we use for calling)
+	delegate_generic_class *object() const { return is_mfp() ? m_raw_mfp.real_object(m_object) : m_object; }
+
 	// helpers
 	bool isnull() const { return (m_raw_function == nullptr && m_raw_mfp.isnull()); }
 	bool is_mfp() const { return !m_raw_mfp.isnull(); }
@@ -525,9 +528,6 @@ public:
 	void late_bind(delegate_late_bind &object) { bind((*m_latebinder)(object)); }
 
 protected:
-	// return the actual object (not the one we use for calling)
-	delegate_generic_class *object() const { return is_mfp() ? m_raw_mfp.real_object(m_object) : m_object; }
-
 	// late binding function
 	typedef delegate_generic_class *(*late_bind_func)(delegate_late_bind &object);
 
@@ -1437,6 +1437,7 @@ void n64_periphs::pi_dma_tick()
 
 		if (pi_dram_addr != 0xffffffff)
 		{
+			m_n64->rdp()->render_sync(); // RDRAM may hold what the RDP is still drawing
 			for(int i = 0; i < dma_length / 2; i++)
 			{
 				cart16[BYTE_XOR_BE(cart_addr + i)] = dram16[BYTE_XOR_BE(dram_addr + i)];
@@ -41,7 +41,7 @@ class model3_renderer : public poly_manager<float, model3_polydata, 6, 50000>
 {
 public:
 	model3_renderer(model3_state &state, int width, int height)
-		: poly_manager<float, model3_polydata, 6, 50000>(state.machine())
+		: poly_manager<float, model3_polydata, 6, 50000>(state.machine(), POLYFLAG_TILE_BINNED)
 	{
 		m_fb = std::make_unique<bitmap_rgb32>(width, height);
 		m_zb = std::make_unique<bitmap_ind32>(width, height);
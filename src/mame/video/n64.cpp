@@ -25,6 +25,7 @@ TODO:
 *******************************************************************************/
 
 #include "emu.h"
+#include "emuopts.h"
 #include "video/n64.h"
 #include "video/rdpblend.h"
 #include "video/rdptpipe.h"
@@ -107,6 +108,10 @@ void n64_state::video_start()
 	{
 		rdp_exec = fopen("rdp_execute.txt", "wt");
 	}
+	else if (machine().options().n64_rdp_thread())
+	{
+		m_rdp->start_render_thread();
+	}
 }
 
 UINT32 n64_state::screen_update_n64(screen_device &screen, bitmap_rgb32 &bitmap, const rectangle &cliprect)
@@ -157,6 +162,7 @@ UINT32 n64_state::screen_update_n64(screen_device &screen, bitmap_rgb32 &bitmap,
 		return 0;
 	}
 
+	m_rdp->render_sync();
 	n64->video_update(bitmap);
 
 	return 0;
@@ -3014,6 +3020,12 @@ void n64_rdp::cmd_noop(UINT32 w1, UINT32 w2)
 
 void n64_rdp::process_command_list()
 {
+	if (m_render_queue != nullptr)
+	{
+		queue_command_list();
+		return;
+	}
+
 	INT32 length = m_end - m_current;
 
 	if(length < 0)
@@ -3041,13 +3053,23 @@ void n64_rdp::process_command_list()
 		return;
 	}
 
+	if (!execute_command_list())
+	{
+		return;
+	}
+
+	m_start = m_current = m_end;
+}
+
+bool n64_rdp::execute_command_list()
+{
 	while (m_cmd_cur < m_cmd_ptr)
 	{
-		cmd = (m_cmd_data[m_cmd_cur] >> 24) & 0x3f;
+		const UINT32 cmd = (m_cmd_data[m_cmd_cur] >> 24) & 0x3f;
 
 		if (((m_cmd_ptr - m_cmd_cur) * 4) < s_rdp_command_length[cmd])
 		{
-			return;
+			return false;
 			//fatalerror("rdp_process_list: not enough rdp command data: cur = %d, ptr = %d, expected = %d\n", m_cmd_cur, m_cmd_ptr, s_rdp_command_length[cmd]);
 		}
 
@@ -3118,8 +3140,133 @@ void n64_rdp::process_command_list()
 	};
 	m_cmd_ptr = 0;
 	m_cmd_cur = 0;
+	return true;
+}
 
-	m_start = m_current = m_end;
+void n64_rdp::queue_command_list()
+{
+	INT32 length = m_end - m_current;
+
+	if(length < 0)
+	{
+		m_current = m_end;
+		return;
+	}
+
+	// load command data here, so it is read in order with the CPU and RSP
+	for(INT32 i = 0; i < length; i += 4)
+	{
+		m_render_pending.push_back(read_data((m_current & 0x1fffffff) + i));
+	}
+
+	m_current = m_end;
+
+	set_status(get_status() &~ DP_STATUS_FREEZE);
+
+	// hand each complete command to the render thread, except SYNC_FULL,
+	// which waits for it here and then raises the interrupt
+	command_batch* batch = nullptr;
+	size_t cur = 0;
+	while (cur < m_render_pending.size())
+	{
+		const UINT32 cmd = (m_render_pending[cur] >> 24) & 0x3f;
+		const size_t cmd_words = s_rdp_command_length[cmd] / 4;
+
+		if (m_render_pending.size() - cur < cmd_words)
+		{
+			break;
+		}
+
+		if (cmd == 0x29)
+		{
+			queue_batch(batch);
+			batch = nullptr;
+			render_sync();
+			cmd_sync_full(m_render_pending[cur], m_render_pending[cur + 1]);
+		}
+		else
+		{
+			if (batch != nullptr && batch->m_data.size() + cmd_words > ARRAY_LENGTH(m_cmd_data))
+			{
+				queue_batch(batch);
+				batch = nullptr;
+			}
+			if (batch == nullptr)
+			{
+				batch = new command_batch;
+				batch->m_rdp = this;
+			}
+			batch->m_data.insert(batch->m_data.end(), m_render_pending.begin() + cur, m_render_pending.begin() + cur + cmd_words);
+		}
+
+		cur += cmd_words;
+	}
+	queue_batch(batch);
+
+	// keep a partial command for the next DP_END
+	m_render_pending.erase(m_render_pending.begin(), m_render_pending.begin() + cur);
+	if (m_render_pending.empty())
+	{
+		m_start = m_end;
+	}
+}
+
+void n64_rdp::queue_batch(command_batch* batch)
+{
+	if (batch != nullptr)
+	{
+		osd_work_item_queue(m_render_queue, render_execute, batch, WORK_ITEM_FLAG_AUTO_RELEASE);
+	}
+}
+
+void *n64_rdp::render_execute(void *param, int threadid)
+{
+	command_batch* batch = (command_batch*)param;
+	n64_rdp* rdp = batch->m_rdp;
+
+	memcpy(rdp->m_cmd_data, &batch->m_data[0], batch->m_data.size() * sizeof(UINT32));
+	rdp->m_cmd_ptr = batch->m_data.size();
+	rdp->m_cmd_cur = 0;
+	rdp->execute_command_list();
+
+	delete batch;
+	return nullptr;
+}
+
+void n64_rdp::start_render_thread()
+{
+	m_render_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_IO);
+	machine().add_notifier(MACHINE_NOTIFY_EXIT, machine_notify_delegate(FUNC(n64_rdp::render_stop), this));
+
+	// RDRAM and the RDP state must not change under the render thread while saving or loading
+	machine().save().register_presave(save_prepost_delegate(FUNC(n64_rdp::render_sync), this));
+	machine().save().register_preload(save_prepost_delegate(FUNC(n64_rdp::render_preload), this));
+}
+
+void n64_rdp::render_sync()
+{
+	if (m_render_queue != nullptr)
+	{
+		osd_work_queue_wait(m_render_queue, osd_ticks_per_second() * 100);
+	}
+}
+
+void n64_rdp::render_preload()
+{
+	// let the thread finish, then drop the partial command it was never
+	// handed, which belongs to the state being left
+	render_sync();
+	m_render_pending.clear();
+}
+
+void n64_rdp::render_stop()
+{
+	if (m_render_queue != nullptr)
+	{
+		render_sync();
+		osd_work_queue_free(m_render_queue);
+		m_render_queue = nullptr;
+	}
 }
 
 /*****************************************************************************/
@@ -3141,6 +3288,8 @@ n64_rdp::n64_rdp(n64_state &state, UINT32* rdram, UINT32* dmem) : poly_manager<U
 	m_cmd_ptr = 0;
 	m_cmd_cur = 0;
 
+	m_render_queue = nullptr;
+
 	m_start = 0;
 	m_end = 0;
 	m_current = 0;
@@ -3264,9 +3413,8 @@ void n64_rdp::render_spans(INT32 start, INT32 end, INT32 tilenum, bool flip, ext
 	wait("render spans");
 }
 
-void n64_rdp::rgbaz_clip(INT32 sr, INT32 sg, INT32 sb, INT32 sa, INT32* sz, rdp_span_aux* userdata)
+void n64_rdp::rgbaz_clip(INT32* sz, rdp_span_aux* userdata)
 {
-	userdata->m_shade_color.set(sa, sr, sg, sb);
 	userdata->m_shade_color.clamp_and_clear(0xfffffe00);
 	UINT32 a = userdata->m_shade_color.get_a();
 	userdata->m_shade_alpha.set(a, a, a, a);
@@ -3283,34 +3431,31 @@ void n64_rdp::rgbaz_clip(INT32 sr, INT32 sg, INT32 sb, INT32 sa, INT32* sz, rdp_
 	}
 }
 
-void n64_rdp::rgbaz_correct_triangle(INT32 offx, INT32 offy, INT32* r, INT32* g, INT32* b, INT32* a, INT32* z, rdp_span_aux* userdata, const rdp_poly_state &object)
+void n64_rdp::rgbaz_correct_triangle(INT32 offx, INT32 offy, const rgbaint_t& shade, const rgbaint_t& shade_dx, const rgbaint_t& shade_dy, INT32* z, rdp_span_aux* userdata, const rdp_poly_state &object)
 {
+	color_t& color = userdata->m_shade_color;
+	color = shade;
+	color.sra_imm(14);
+
 	if (userdata->m_current_pix_cvg == 8)
 	{
-		*r >>= 2;
-		*g >>= 2;
-		*b >>= 2;
-		*a >>= 2;
+		color.sra_imm(2);
 		*z = (*z >> 3) & 0x7ffff;
 	}
 	else
 	{
-		INT32 summand_xr = offx * SIGN13(object.m_span_base.m_span_dr >> 14);
-		INT32 summand_yr = offy * SIGN13(object.m_span_base.m_span_drdy >> 14);
-		INT32 summand_xb = offx * SIGN13(object.m_span_base.m_span_db >> 14);
-		INT32 summand_yb = offy * SIGN13(object.m_span_base.m_span_dbdy >> 14);
-		INT32 summand_xg = offx * SIGN13(object.m_span_base.m_span_dg >> 14);
-		INT32 summand_yg = offy * SIGN13(object.m_span_base.m_span_dgdy >> 14);
-		INT32 summand_xa = offx * SIGN13(object.m_span_base.m_span_da >> 14);
-		INT32 summand_ya = offy * SIGN13(object.m_span_base.m_span_dady >> 14);
+		rgbaint_t summand_x(shade_dx);
+		rgbaint_t summand_y(shade_dy);
+		summand_x.mul_imm(offx);
+		summand_y.mul_imm(offy);
 
 		INT32 summand_xz = offx * SIGN22(object.m_span_base.m_span_dz >> 10);
 		INT32 summand_yz = offy * SIGN22(object.m_span_base.m_span_dzdy >> 10);
 
-		*r = ((*r << 2) + summand_xr + summand_yr) >> 4;
-		*g = ((*g << 2) + summand_xg + summand_yg) >> 4;
-		*b = ((*b << 2) + summand_xb + summand_yb) >> 4;
-		*a = ((*a << 2) + summand_xa + summand_ya) >> 4;
+		color.shl_imm(2);
+		color.add(summand_x);
+		color.add(summand_y);
+		color.sra_imm(4);
 		*z = (((*z << 2) + summand_xz + summand_yz) >> 5) & 0x7ffff;
 	}
 }
@@ -3500,10 +3645,7 @@ void n64_rdp::span_draw_1cycle(INT32 scanline, const extent_t &extent, const rdp
 	const INT32 tilenum = object.tilenum;
 	const bool flip = object.flip;
 
-	span_param_t r; r.w = extent.param[SPAN_R].start;
-	span_param_t g; g.w = extent.param[SPAN_G].start;
-	span_param_t b; b.w = extent.param[SPAN_B].start;
-	span_param_t a; a.w = extent.param[SPAN_A].start;
+	rgbaint_t shade(extent.param[SPAN_A].start, extent.param[SPAN_R].start, extent.param[SPAN_G].start, extent.param[SPAN_B].start);
 	span_param_t z; z.w = extent.param[SPAN_Z].start;
 	span_param_t s; s.w = extent.param[SPAN_S].start;
 	span_param_t t; t.w = extent.param[SPAN_T].start;
@@ -3554,6 +3696,11 @@ void n64_rdp::span_draw_1cycle(INT32 scanline, const extent_t &extent, const rdp
 		xinc = 1;
 	}
 
+	// shade is stepped and corrected as one vector, in A, R, G, B order
+	const rgbaint_t shade_inc(dainc, drinc, dginc, dbinc);
+	const rgbaint_t shade_dx(SIGN13(object.m_span_base.m_span_da >> 14), SIGN13(object.m_span_base.m_span_dr >> 14), SIGN13(object.m_span_base.m_span_dg >> 14), SIGN13(object.m_span_base.m_span_db >> 14));
+	const rgbaint_t shade_dy(SIGN13(object.m_span_base.m_span_dady >> 14), SIGN13(object.m_span_base.m_span_drdy >> 14), SIGN13(object.m_span_base.m_span_dgdy >> 14), SIGN13(object.m_span_base.m_span_dbdy >> 14));
+
 	const INT32 fb_index = object.m_misc_state.m_fb_width * scanline;
 
 	const INT32 xstart = extent.startx;
@@ -3596,10 +3743,6 @@ void n64_rdp::span_draw_1cycle(INT32 scanline, const extent_t &extent, const rdp
 	userdata->m_start_span = true;
 	for (INT32 j = 0; j <= length; j++)
 	{
-		INT32 sr = r.w >> 14;
-		INT32 sg = g.w >> 14;
-		INT32 sb = b.w >> 14;
-		INT32 sa = a.w >> 14;
 		INT32 sz = (z.w >> 10) & 0x3fffff;
 		const bool valid_x = (flip) ? (x >= xend_scissored) : (x <= xend_scissored);
 
@@ -3610,8 +3753,8 @@ void n64_rdp::span_draw_1cycle(INT32 scanline, const extent_t &extent, const rdp
 
 			m_tex_pipe.lod_1cycle(&sss, &sst, s.w, t.w, w.w, dsinc, dtinc, dwinc, userdata, object);
 
-			rgbaz_correct_triangle(offx, offy, &sr, &sg, &sb, &sa, &sz, userdata, object);
-			rgbaz_clip(sr, sg, sb, sa, &sz, userdata);
+			rgbaz_correct_triangle(offx, offy, shade, shade_dx, shade_dy, &sz, userdata, object);
+			rgbaz_clip(&sz, userdata);
 
 			((m_tex_pipe).*(m_tex_pipe.m_cycle[cycle0]))(&userdata->m_texel0_color, &userdata->m_texel0_color, sss, sst, tilenum, 0, userdata, object);
 			UINT32 t0a = userdata->m_texel0_color.get_a();
@@ -3676,10 +3819,7 @@ void n64_rdp::span_draw_1cycle(INT32 scanline, const extent_t &extent, const rdp
 			sst = userdata->m_precomp_t;
 		}
 
-		r.w += drinc;
-		g.w += dginc;
-		b.w += dbinc;
-		a.w += dainc;
+		shade.add(shade_inc);
 		s.w += dsinc;
 		t.w += dtinc;
 		w.w += dwinc;
@@ -3698,10 +3838,7 @@ void n64_rdp::span_draw_2cycle(INT32 scanline, const extent_t &extent, const rdp
 	const INT32 tilenum = object.tilenum;
 	const bool flip = object.flip;
 
-	span_param_t r; r.w = extent.param[SPAN_R].start;
-	span_param_t g; g.w = extent.param[SPAN_G].start;
-	span_param_t b; b.w = extent.param[SPAN_B].start;
-	span_param_t a; a.w = extent.param[SPAN_A].start;
+	rgbaint_t shade(extent.param[SPAN_A].start, extent.param[SPAN_R].start, extent.param[SPAN_G].start, extent.param[SPAN_B].start);
 	span_param_t z; z.w = extent.param[SPAN_Z].start;
 	span_param_t s; s.w = extent.param[SPAN_S].start;
 	span_param_t t; t.w = extent.param[SPAN_T].start;
@@ -3761,6 +3898,11 @@ void n64_rdp::span_draw_2cycle(INT32 scanline, const extent_t &extent, const rdp
 		xinc = 1;
 	}
 
+	// shade is stepped and corrected as one vector, in A, R, G, B order
+	const rgbaint_t shade_inc(dainc, drinc, dginc, dbinc);
+	const rgbaint_t shade_dx(SIGN13(object.m_span_base.m_span_da >> 14), SIGN13(object.m_span_base.m_span_dr >> 14), SIGN13(object.m_span_base.m_span_dg >> 14), SIGN13(object.m_span_base.m_span_db >> 14));
+	const rgbaint_t shade_dy(SIGN13(object.m_span_base.m_span_dady >> 14), SIGN13(object.m_span_base.m_span_drdy >> 14), SIGN13(object.m_span_base.m_span_dgdy >> 14), SIGN13(object.m_span_base.m_span_dbdy >> 14));
+
 	const INT32 fb_index = object.m_misc_state.m_fb_width * scanline;
 
 	INT32 cdith = 0;
@@ -3807,10 +3949,6 @@ void n64_rdp::span_draw_2cycle(INT32 scanline, const extent_t &extent, const rdp
 	userdata->m_start_span = true;
 	for (INT32 j = 0; j <= length; j++)
 	{
-		INT32 sr = r.w >> 14;
-		INT32 sg = g.w >> 14;
-		INT32 sb = b.w >> 14;
-		INT32 sa = a.w >> 14;
 		INT32 sz = (z.w >> 10) & 0x3fffff;
 
 		const bool valid_x = (flip) ? (x >= xend_scissored) : (x <= xend_scissored);
@@ -3830,8 +3968,8 @@ void n64_rdp::span_draw_2cycle(INT32 scanline, const extent_t &extent, const rdp
 			newt = userdata->m_precomp_t;
 			m_tex_pipe.lod_2cycle_limited(&news, &newt, s.w + dsinc, t.w + dtinc, w.w + dwinc, dsinc, dtinc, dwinc, prim_tile, &newtile1, object);
 
-			rgbaz_correct_triangle(offx, offy, &sr, &sg, &sb, &sa, &sz, userdata, object);
-			rgbaz_clip(sr, sg, sb, sa, &sz, userdata);
+			rgbaz_correct_triangle(offx, offy, shade, shade_dx, shade_dy, &sz, userdata, object);
+			rgbaz_clip(&sz, userdata);
 
 			((m_tex_pipe).*(m_tex_pipe.m_cycle[cycle0]))(&userdata->m_texel0_color, &userdata->m_texel0_color, sss, sst, tile1, 0, userdata, object);
 			((m_tex_pipe).*(m_tex_pipe.m_cycle[cycle1]))(&userdata->m_texel1_color, &userdata->m_texel0_color, sss, sst, tile2, 1, userdata, object);
@@ -3932,10 +4070,7 @@ void n64_rdp::span_draw_2cycle(INT32 scanline, const extent_t &extent, const rdp
 			sst = userdata->m_precomp_t;
 		}
 
-		r.w += drinc;
-		g.w += dginc;
-		b.w += dbinc;
-		a.w += dainc;
+		shade.add(shade_inc);
 		s.w += dsinc;
 		t.w += dtinc;
 		w.w += dwinc;
@@ -163,6 +163,8 @@ public:
 	}
 
 	void        process_command_list();
+	void        start_render_thread();
+	void        render_sync();
 	UINT32      read_data(UINT32 address);
 	void        disassemble(char* buffer);
 
@@ -262,8 +264,8 @@ public:
 	void        cmd_set_mask_image(UINT32 w1, UINT32 w2);
 	void        cmd_set_color_image(UINT32 w1, UINT32 w2);
 
-	void        rgbaz_clip(INT32 sr, INT32 sg, INT32 sb, INT32 sa, INT32* sz, rdp_span_aux* userdata);
-	void        rgbaz_correct_triangle(INT32 offx, INT32 offy, INT32* r, INT32* g, INT32* b, INT32* a, INT32* z, rdp_span_aux* userdata, const rdp_poly_state &object);
+	void        rgbaz_clip(INT32* sz, rdp_span_aux* userdata);
+	void        rgbaz_correct_triangle(INT32 offx, INT32 offy, const rgbaint_t& shade, const rgbaint_t& shade_dx, const rgbaint_t& shade_dy, INT32* z, rdp_span_aux* userdata, const rdp_poly_state &object);
 
 	void        triangle(bool shade, bool texture, bool zbuffer);
 
@@ -316,6 +318,20 @@ public:
 	n64_tile_t      m_tiles[8];
 
 private:
+	// a run of complete commands handed to the render thread
+	struct command_batch
+	{
+		n64_rdp*            m_rdp;
+		std::vector<UINT32> m_data;
+	};
+
+	bool    execute_command_list();
+	void    queue_command_list();
+	void    queue_batch(command_batch* batch);
+	void    render_stop();
+	void    render_preload();
+	static void *render_execute(void *param, int threadid);
+
 	void    compute_cvg_noflip(extent_t* spans, INT32* majorx, INT32* minorx, INT32* majorxint, INT32* minorxint, INT32 scanline, INT32 yh, INT32 yl, INT32 base);
 	void    compute_cvg_flip(extent_t* spans, INT32* majorx, INT32* minorx, INT32* majorxint, INT32* minorxint, INT32 scanline, INT32 yh, INT32 yl, INT32 base);
 
@@ -350,6 +366,9 @@ private:
 	INT32   m_cmd_ptr;
 	INT32   m_cmd_cur;
 
+	osd_work_queue*     m_render_queue;     // render thread, or nullptr to execute on DP_END
+	std::vector<UINT32> m_render_pending;   // loaded words not yet handed to the render thread
+
 	UINT32  m_start;
 	UINT32  m_end;
 	UINT32  m_current;
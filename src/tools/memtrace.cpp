@@ -0,0 +1,205 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    memtrace.cpp
+
+    Summarize a memory handler trace written with -memtrace.
+
+****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "osdcomm.h"
+
+
+/***************************************************************************
+    CONSTANTS & DEFINES
+***************************************************************************/
+
+#define TRACE_VERSION       1
+
+
+
+/***************************************************************************
+    TYPE DEFINITIONS
+***************************************************************************/
+
+struct trace_handler
+{
+	std::string     name;           /* "device:space:handler" */
+	bool            write;          /* write rather than read */
+	UINT8           bytes;          /* access width in bytes */
+	UINT32          bytestart;      /* start of the address range */
+	UINT32          byteend;        /* end of the address range */
+	UINT64          count;          /* total accesses */
+	UINT64          samples;        /* timed accesses */
+	UINT64          ticks;          /* total ticks over timed accesses */
+	UINT32          maxticks;       /* slowest timed access */
+};
+
+struct trace_total
+{
+	UINT64          count;          /* total accesses */
+	UINT64          samples;        /* timed accesses */
+	UINT64          ticks;          /* total ticks over timed accesses */
+};
+
+
+
+/***************************************************************************
+    CORE IMPLEMENTATION
+***************************************************************************/
+
+/*-------------------------------------------------
+    read_value - read a little-endian value of
+    the given size
+-------------------------------------------------*/
+
+static bool read_value(FILE *file, int bytes, UINT64 &value)
+{
+	UINT8 buffer[8];
+	if (fread(buffer, 1, bytes, file) != bytes)
+		return false;
+	value = 0;
+	for (int index = bytes - 1; index >= 0; index--)
+		value = (value << 8) | buffer[index];
+	return true;
+}
+
+
+/*-------------------------------------------------
+    estimated_ns - scale the mean sampled time up
+    to every access, in nanoseconds
+-------------------------------------------------*/
+
+static double estimated_ns(UINT64 count, UINT64 samples, UINT64 ticks, UINT64 ticks_per_second)
+{
+	if (samples == 0)
+		return 0;
+	return (double)ticks * 1e9 / (double)ticks_per_second * (double)count / (double)samples;
+}
+
+
+/*-------------------------------------------------
+    main - main entry point
+-------------------------------------------------*/
+
+int main(int argc, char *argv[])
+{
+	if (argc != 2)
+	{
+		fprintf(stderr, "Usage:\n  memtrace <tracefile>\n");
+		return 1;
+	}
+
+	FILE *file = fopen(argv[1], "rb");
+	if (file == nullptr)
+	{
+		fprintf(stderr, "Error opening trace file '%s'\n", argv[1]);
+		return 1;
+	}
+
+	// validate the header
+	char magic[8];
+	UINT64 version, handlers, samples, ticks_per_second;
+	if (fread(magic, 1, 8, file) != 8 || memcmp(magic, "MEMTRACE", 8) != 0
+		|| !read_value(file, 4, version) || !read_value(file, 4, handlers)
+		|| !read_value(file, 8, samples) || !read_value(file, 8, ticks_per_second))
+	{
+		fprintf(stderr, "'%s' is not a memory trace\n", argv[1]);
+		fclose(file);
+		return 1;
+	}
+	if (version != TRACE_VERSION)
+	{
+		fprintf(stderr, "Unsupported trace version %d\n", (int)version);
+		fclose(file);
+		return 1;
+	}
+
+	// read the handlers
+	std::vector<trace_handler> handlerlist(handlers);
+	for (UINT64 index = 0; index < handlers; index++)
+	{
+		UINT64 id, flags, bytes, namelength, bytestart, byteend, count;
+		if (!read_value(file, 4, id) || !read_value(file, 1, flags) || !read_value(file, 1, bytes)
+			|| !read_value(file, 2, namelength) || !read_value(file, 4, bytestart)
+			|| !read_value(file, 4, byteend) || !read_value(file, 8, count) || id >= handlers)
+		{
+			fprintf(stderr, "Truncated handler list\n");
+			fclose(file);
+			return 1;
+		}
+
+		trace_handler &handler = handlerlist[id];
+		handler.name.resize(namelength);
+		if (namelength != 0 && fread(&handler.name[0], 1, namelength, file) != namelength)
+		{
+			fprintf(stderr, "Truncated handler list\n");
+			fclose(file);
+			return 1;
+		}
+		handler.write = (flags & 1) != 0;
+		handler.bytes = bytes;
+		handler.bytestart = bytestart;
+		handler.byteend = byteend;
+		handler.count = count;
+		handler.samples = handler.ticks = handler.maxticks = 0;
+	}
+
+	// accumulate the samples
+	for (UINT64 index = 0; index < samples; index++)
+	{
+		UINT64 id, address, ticks;
+		if (!read_value(file, 4, id) || !read_value(file, 4, address) || !read_value(file, 4, ticks) || id >= handlers)
+		{
+			fprintf(stderr, "Truncated sample list\n");
+			break;
+		}
+		trace_handler &handler = handlerlist[id];
+		handler.samples++;
+		handler.ticks += ticks;
+		handler.maxticks = std::max<UINT32>(handler.maxticks, ticks);
+	}
+	fclose(file);
+
+	// report by handler, range and width, most accesses first
+	std::sort(handlerlist.begin(), handlerlist.end(), [](const trace_handler &a, const trace_handler &b) { return a.count > b.count; });
+	printf("%-12s %-5s %-17s %-3s %10s %10s %10s  %s\n", "Accesses", "Width", "Range", "R/W", "Mean ns", "Max ns", "Est. ms", "Handler");
+	for (const trace_handler &handler : handlerlist)
+	{
+		double mean = (handler.samples == 0) ? 0 : (double)handler.ticks * 1e9 / (double)ticks_per_second / (double)handler.samples;
+		double max = (double)handler.maxticks * 1e9 / (double)ticks_per_second;
+		printf("%-12llu %-5d %08X-%08X %-3s %10.1f %10.1f %10.3f  %s\n",
+				(unsigned long long)handler.count, handler.bytes, handler.bytestart, handler.byteend, handler.write ? "W" : "R",
+				mean, max, estimated_ns(handler.count, handler.samples, handler.ticks, ticks_per_second) / 1e6, handler.name.c_str());
+	}
+
+	// report by handler alone, most estimated time first
+	std::map<std::string, trace_total> totals;
+	for (const trace_handler &handler : handlerlist)
+	{
+		trace_total &total = totals[handler.name];
+		total.count += handler.count;
+		total.samples += handler.samples;
+		total.ticks += handler.ticks;
+	}
+	std::vector<std::pair<std::string, trace_total>> sorted(totals.begin(), totals.end());
+	std::sort(sorted.begin(), sorted.end(), [ticks_per_second](const std::pair<std::string, trace_total> &a, const std::pair<std::string, trace_total> &b)
+	{
+		return estimated_ns(a.second.count, a.second.samples, a.second.ticks, ticks_per_second) > estimated_ns(b.second.count, b.second.samples, b.second.ticks, ticks_per_second);
+	});
+	printf("\n%-12s %10s  %s\n", "Accesses", "Est. ms", "Handler");
+	for (auto &total : sorted)
+		printf("%-12llu %10.3f  %s\n", (unsigned long long)total.second.count,
+				estimated_ns(total.second.count, total.second.samples, total.second.ticks, ticks_per_second) / 1e6, total.first.c_str());
+
+	return 0;
+}
@@ -0,0 +1,96 @@
+#include "gtest/gtest.h"
+#include "testmachine.h"
+#include "cpu/arm7/arm7.h"
+#include "cpu/arm7/arm7core.h"
+
+// Runs a small ARM program on the recompiler with -drc_verify, so every
+// stretch of recompiled and interpreted code is replayed on the
+// interpreter and the registers and cycles left are compared.  The loop
+// mixes native data processing with interpreted loads, stores and SWIs.
+
+// an ARM7 the test can start and run without the scheduler
+class test_arm7_device : public arm7_cpu_device
+{
+public:
+	test_arm7_device(const machine_config &mconfig, const char *tag, device_t *owner, UINT32 clock)
+		: arm7_cpu_device(mconfig, tag, owner, clock) { }
+
+	using device_t::start;
+
+	void run(int cycles)
+	{
+		m_icount = cycles;
+		execute_run();
+	}
+};
+
+static const device_type TEST_ARM7 = &device_creator<test_arm7_device>;
+
+static ADDRESS_MAP_START( test_map, AS_PROGRAM, 32, driver_device )
+	AM_RANGE(0x00000000, 0x0000ffff) AM_RAM
+ADDRESS_MAP_END
+
+static MACHINE_CONFIG_START( test_arm7drc, driver_device )
+	MCFG_CPU_ADD("maincpu", TEST_ARM7, 50000000)
+	MCFG_CPU_PROGRAM_MAP(test_map)
+MACHINE_CONFIG_END
+
+ROM_START( testarm7 )
+ROM_END
+
+GAME( 2016, testarm7, 0, test_arm7drc, 0, driver_device, 0, ROT0, "MAME", "ARM7 recompiler tests", MACHINE_NO_SOUND_HW )
+
+struct program_word
+{
+	offs_t  address;
+	UINT32  data;
+};
+
+static const program_word s_program[] =
+{
+	// vectors: reset, SWI
+	{ 0x0000, 0xea00000e },                 // b       $40
+	{ 0x0008, 0xea00003c },                 // b       $100
+
+	// main loop; the loads, stores and SWI are interpreted, the rest is native
+	{ 0x0040, 0xe3a00000 },                 // mov     r0,#0
+	{ 0x0044, 0xe3a01a01 },                 // mov     r1,#$1000
+	{ 0x0048, 0xe2800001 },                 // add     r0,r0,#1
+	{ 0x004c, 0xe4810004 },                 // str     r0,[r1],#4
+	{ 0x0050, 0xe5112004 },                 // ldr     r2,[r1,#-4]
+	{ 0x0054, 0xe1520000 },                 // cmp     r2,r0
+	{ 0x0058, 0xef000000 },                 // swi     0
+	{ 0x005c, 0xe0933002 },                 // adds    r3,r3,r2
+	{ 0x0060, 0xe3310a02 },                 // teq     r1,#$2000
+	{ 0x0064, 0x03a01a01 },                 // moveq   r1,#$1000
+	{ 0x0068, 0xeafffff6 },                 // b       $48
+
+	// SWI handler: count and return
+	{ 0x0100, 0xe2844001 },                 // add     r4,r4,#1
+	{ 0x0104, 0xe1b0f00e }                  // movs    pc,r14
+};
+
+TEST(arm7drc,verified_loop)
+{
+	test_machine machine(GAME_NAME(testarm7));
+	std::string error;
+	machine.m_options.set_value(OPTION_DRC_EXPERIMENTAL, 1, OPTION_PRIORITY_CMDLINE, error);
+	machine.m_options.set_value(OPTION_DRC_VERIFY, 1, OPTION_PRIORITY_CMDLINE, error);
+
+	test_arm7_device &cpu = downcast<test_arm7_device &>(*machine.m_machine.root_device().subdevice("maincpu"));
+	address_space &space = cpu.space(AS_PROGRAM);
+	for (const program_word &word : s_program)
+		space.write_dword(word.address, word.data);
+
+	// a mismatch against the interpreter is a fatal error
+	cpu.start();
+	cpu.reset();
+	for (int slice = 0; slice < 100; slice++)
+		cpu.run(1000);
+
+	// every pass through the loop stores, reloads and takes one SWI
+	UINT32 passes = cpu.state_int(ARM7_R0);
+	EXPECT_GT(passes, 100U);
+	EXPECT_LE(passes - cpu.state_int(ARM7_R4), 1U);
+	EXPECT_LE(passes - cpu.state_int(ARM7_R2), 1U);
+}
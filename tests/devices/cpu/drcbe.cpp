@@ -0,0 +1,928 @@
+#include "gtest/gtest.h"
+#include "testmachine.h"
+#include "machine/bankdev.h"
+#include "cpu/drcuml.h"
+#include <functional>
+
+using namespace uml;
+
+// Runs the same UML blocks through the native back-end (drcbe_x64,
+// drcbe_arm64, ...) and through drcbe_c, and compares everything they
+// store.  The generated code only sees its inputs through memory, so the
+// optimizer can't fold them away, and operands are rotated through
+// registers kept in host registers, registers kept in memory, memory and
+// immediates.  Without a native back-end both runs use drcbe_c.
+
+static const int MAX_INPUTS = 0x8000;
+static const int MAX_OUTPUTS = 0x8000;
+static const offs_t RAM_BYTES = 0x10000;
+static const UINT64 SENTINEL = U64(0xa5a5a5a55a5a5a5a);
+
+// memory operands, allocated from the code cache because back-ends may
+// address them relative to it (drcbe_x64 uses rbp-relative accesses)
+struct test_data
+{
+	UINT64 input[MAX_INPUTS];
+	UINT64 output[MAX_OUTPUTS];
+	UINT64 table[64];
+	drcuml_machine_state saved;         // for SAVE and RESTORE
+	drcuml_machine_state restored;
+};
+
+static test_data *s_data;
+
+
+//-------------------------------------------------
+//  a machine with a CPU-less RAM space for the
+//  generated code to read and write
+//-------------------------------------------------
+
+static ADDRESS_MAP_START( test_map32, AS_PROGRAM, 32, address_map_bank_device )
+	AM_RANGE(0x0000, 0xffff) AM_RAM
+ADDRESS_MAP_END
+
+static MACHINE_CONFIG_START( test_drc, driver_device )
+	MCFG_DEVICE_ADD("ram", ADDRESS_MAP_BANK, 0)
+	MCFG_DEVICE_PROGRAM_MAP(test_map32)
+	MCFG_ADDRESS_MAP_BANK_ENDIANNESS(ENDIANNESS_LITTLE)
+	MCFG_ADDRESS_MAP_BANK_DATABUS_WIDTH(32)
+	MCFG_ADDRESS_MAP_BANK_ADDRBUS_WIDTH(16)
+MACHINE_CONFIG_END
+
+ROM_START( testdrc )
+ROM_END
+
+GAME( 2016, testdrc, 0, test_drc, 0, driver_device, 0, ROT0, "MAME", "DRC back-end tests", MACHINE_NO_SOUND_HW )
+
+static test_machine &get_machine()
+{
+	static test_machine machine(GAME_NAME(testdrc));
+	return machine;
+}
+
+
+//-------------------------------------------------
+//  test blocks
+//-------------------------------------------------
+
+// where an operand lives
+enum
+{
+	FORM_REG,       // a register the back-ends keep in a host register
+	FORM_MEMREG,    // a register a back-end may keep in memory
+	FORM_MEM,       // a memory operand
+	FORM_IMM,       // an immediate; as a destination, the first source
+	FORM_COUNT
+};
+
+static const char *const s_form_names[FORM_COUNT] = { "r", "rm", "m", "i" };
+
+// registers for the destination and each source, by form; I7 holds flags
+static const parameter s_iregs[4][2] = { { I0, I9 }, { I1, I9 }, { I2, I8 }, { I3, I3 } };
+static const parameter s_fregs[4][2] = { { F0, F9 }, { F1, F9 }, { F2, F8 }, { F3, F3 } };
+
+class test_block
+{
+public:
+	test_block(drcuml_state &drcuml, drcuml_block &block, std::vector<std::string> &labels)
+		: m_drcuml(drcuml), m_block(block), m_labels(labels), m_inputs(0), m_nextlabel(0) { }
+
+	instruction &append() { return m_block.append(); }
+	code_handle &handle(const char *name) { return *m_drcuml.handle_alloc(name); }
+	code_label label() { return code_label(++m_nextlabel); }
+
+	// a memory operand holding the given value
+	parameter input(UINT64 value)
+	{
+		assert(m_inputs < MAX_INPUTS);
+		s_data->input[m_inputs] = value;
+		return parameter::make_memory(&s_data->input[m_inputs++]);
+	}
+
+	// store a result of the given kind for comparison
+	void output(parameter src, char kind, const std::string &label)
+	{
+		assert(m_labels.size() < MAX_OUTPUTS);
+		parameter dst = parameter::make_memory(&s_data->output[m_labels.size()]);
+		switch (kind)
+		{
+			case 'l':   append().mov(dst, src);     break;
+			case 'q':   append().dmov(dst, src);    break;
+			case 's':   append().fsmov(dst, src);   break;
+			case 'd':   append().fdmov(dst, src);   break;
+		}
+		m_labels.push_back(label);
+	}
+
+	void output_flags(UINT8 flags, const std::string &label)
+	{
+		if (flags == 0)
+			return;
+		append().getflgs(I7, flags);
+		output(I7, 'l', label + " flags");
+	}
+
+	// run an operation over every combination of source values; kinds
+	// gives the destination then the sources: 'l'/'q' for 32/64-bit
+	// integers, 's'/'d' for single/double floats, '-' for none, and an
+	// upper case second letter for a second destination, passed last;
+	// without flags nothing reads them, so back-ends may skip computing them
+	void operation(const char *name, const char *kinds, const std::vector<std::vector<UINT64>> &values,
+					std::function<void (instruction &, const parameter *)> emit, bool carry = false, bool flags = true)
+	{
+		char dstkind = kinds[0];
+		char edstkind = isupper(UINT8(kinds[1])) ? tolower(UINT8(kinds[1])) : 0;
+		const char *srckinds = kinds + (edstkind ? 2 : 1);
+		int sources = strlen(srckinds);
+		assert(sources == values.size() && sources + (edstkind ? 1 : 0) <= 3);
+
+		std::vector<size_t> index(sources, 0);
+		for (int casenum = 0; ; casenum++)
+		{
+			for (int carryin = 0; carryin <= (carry ? 1 : 0); carryin++)
+			{
+				int formnum = casenum * (carry ? 2 : 1) + carryin;
+				std::string label = string_format("%s.%d", name, formnum);
+				parameter params[4];
+
+				// the destination is initialized unless it is the first source
+				int forms[4];
+				for (int slot = 0; slot < 4; slot++)
+					forms[slot] = (formnum >> (2 * slot)) % FORM_COUNT;
+				bool aliased = (forms[0] == FORM_IMM && sources > 0 && dstkind == srckinds[0] && forms[1] != FORM_IMM);
+				if (forms[0] == FORM_IMM && !aliased)
+					forms[0] = FORM_REG;
+				if (dstkind != '-' && !aliased)
+				{
+					params[0] = operand(0, forms[0], dstkind, SENTINEL);
+					label.append(" ").append(s_form_names[forms[0]]);
+				}
+				if (edstkind)
+				{
+					params[3] = operand(3, (forms[3] & 1) ? FORM_MEM : FORM_REG, edstkind, SENTINEL);
+					label.append(" ").append(s_form_names[(forms[3] & 1) ? FORM_MEM : FORM_REG]);
+				}
+
+				// then the sources
+				for (int srcnum = 1; srcnum <= sources; srcnum++)
+				{
+					UINT64 value = values[srcnum - 1][index[srcnum - 1]];
+					params[srcnum] = operand(srcnum, forms[srcnum], srckinds[srcnum - 1], value);
+					label.append(string_format(" %s:%X", s_form_names[forms[srcnum]], value));
+				}
+				if (aliased)
+				{
+					params[0] = params[1];
+					label.append(" =src1");
+				}
+
+				if (carry)
+					append().carry(input(carryin), 0);
+
+				instruction &inst = append();
+				emit(inst, params);
+				UINT8 outflags = flags ? inst.output_flags() : 0;
+				if (dstkind != '-')
+					output(params[0], dstkind, label);
+				if (edstkind)
+					output(params[3], edstkind, label + " second");
+				output_flags(outflags, label);
+			}
+
+			// advance to the next combination
+			int srcnum;
+			for (srcnum = sources - 1; srcnum >= 0; srcnum--)
+			{
+				if (++index[srcnum] < values[srcnum].size())
+					break;
+				index[srcnum] = 0;
+			}
+			if (srcnum < 0)
+				break;
+		}
+	}
+
+private:
+	// place a value in the given operand slot according to its form
+	parameter operand(int slot, int form, char kind, UINT64 value)
+	{
+		bool isint = (kind == 'l' || kind == 'q');
+
+		// floats have no immediates, and the third source has no memory-backed register
+		if (!isint && form == FORM_IMM)
+			form = FORM_MEM;
+		if (slot == 3 && form == FORM_MEMREG)
+			form = FORM_MEM;
+
+		switch (form)
+		{
+			case FORM_REG:
+			case FORM_MEMREG:
+			{
+				parameter reg = (isint ? s_iregs : s_fregs)[slot][form];
+				switch (kind)
+				{
+					case 'l':
+					case 'q':   append().dmov(reg, input(value));   break;
+					case 's':   append().fsmov(reg, input(value));  break;
+					case 'd':   append().fdmov(reg, input(value));  break;
+				}
+				return reg;
+			}
+
+			case FORM_MEM:
+				return input(value);
+
+			default:
+				return (kind == 'l') ? UINT64(UINT32(value)) : value;
+		}
+	}
+
+	drcuml_state &              m_drcuml;
+	drcuml_block &              m_block;
+	std::vector<std::string> &  m_labels;
+	int                         m_inputs;
+	UINT32                      m_nextlabel;
+};
+
+
+//-------------------------------------------------
+//  compare_backends - generate a block with both
+//  back-ends, run each, and compare the outputs,
+//  the return value and the memory they wrote
+//-------------------------------------------------
+
+static void compare_backends(std::function<void (test_block &)> generate)
+{
+	test_machine &machine = get_machine();
+	device_t &device = *machine.m_machine.root_device().subdevice("ram");
+	address_space &space = device.memory().space(AS_PROGRAM);
+
+	std::vector<std::string> labels[2];
+	std::vector<UINT64> results[2];
+	for (int native = 0; native < 2; native++)
+	{
+		std::string error;
+		machine.m_options.set_value(OPTION_DRC_USE_C, native ? 0 : 1, OPTION_PRIORITY_CMDLINE, error);
+
+		drc_cache cache(16 * 1024 * 1024);
+		s_data = reinterpret_cast<test_data *>(cache.alloc(sizeof(test_data)));
+		drcuml_state drcuml(device, cache, 0, 2, 32, 0);
+		drcuml.reset();
+
+		code_handle &entry = *drcuml.handle_alloc("entry");
+		drcuml_block &block = *drcuml.begin_block(0x20000);
+		block.append().handle(entry);
+		test_block test(drcuml, block, labels[native]);
+		generate(test);
+		block.append().exit(0);
+		block.end();
+
+		for (offs_t address = 0; address < RAM_BYTES; address++)
+			space.write_byte(address, address * 0x9d);
+		for (int index = 0; index < ARRAY_LENGTH(s_data->table); index++)
+			s_data->table[index] = index * U64(0x0123456789abcdef);
+		memset(s_data->output, 0, sizeof(s_data->output));
+
+		UINT32 exitcode = drcuml.execute(entry);
+
+		results[native].assign(s_data->output, s_data->output + labels[native].size());
+		results[native].push_back(exitcode);
+		for (offs_t address = 0; address < RAM_BYTES; address += 8)
+			results[native].push_back(space.read_qword(address));
+		results[native].insert(results[native].end(), s_data->table, s_data->table + ARRAY_LENGTH(s_data->table));
+	}
+
+	ASSERT_EQ(results[0].size(), results[1].size());
+	int mismatches = 0;
+	for (size_t index = 0; index < results[0].size() && mismatches < 20; index++)
+		if (results[0][index] != results[1][index])
+		{
+			std::string what;
+			if (index < labels[0].size())
+				what = labels[0][index];
+			else if (index == labels[0].size())
+				what = "exit code";
+			else if (index <= labels[0].size() + RAM_BYTES / 8)
+				what = string_format("RAM %04X", (index - labels[0].size() - 1) * 8);
+			else
+				what = string_format("table %d", index - labels[0].size() - 1 - RAM_BYTES / 8);
+			ADD_FAILURE() << what << ": drcbe_c " << std::hex << results[0][index] << ", native " << results[1][index];
+			mismatches++;
+		}
+}
+
+
+//-------------------------------------------------
+//  operand values
+//-------------------------------------------------
+
+static const std::vector<UINT64> s_ints =
+{
+	0, 1, 2, 0x7f, 0x80, 0xff, 0x7fff, 0x8000, 0x7fffffff, 0x80000000, 0xfffffffe, 0xffffffff,
+	U64(0x100000000), U64(0x7fffffffffffffff), U64(0x8000000000000000), U64(0xfffffffffffffffe),
+	U64(0xffffffffffffffff), U64(0x0123456789abcdef), U64(0xfedcba9876543210)
+};
+
+static const std::vector<UINT64> s_counts = { 0, 1, 7, 31, 32, 33, 63, 64, 0xff };
+
+// shifts and rotates by a count that masks to zero leave the flags as they
+// were, and GETFLGS itself may change them, so those counts are left out
+static const std::vector<UINT64> s_shifts32 = { 1, 7, 31, 33, 63, 0xff };
+static const std::vector<UINT64> s_shifts64 = { 1, 7, 31, 32, 33, 63, 0xff };
+
+static const std::vector<UINT64> s_singles =
+{
+	0x00000000, 0x80000000, 0x3f800000, 0xbf800000, 0x3fc00000, 0xc0200000,
+	0x4f32d05e, 0x0da24260, 0x7f7fffff, 0x00000001, 0x42f6e979
+};
+
+static const std::vector<UINT64> s_doubles =
+{
+	U64(0x0000000000000000), U64(0x8000000000000000), U64(0x3ff0000000000000), U64(0xbff0000000000000),
+	U64(0x3ff8000000000000), U64(0xc004000000000000), U64(0x41e65a0bc0000000), U64(0x01a56e1fc2f8f359),
+	U64(0x7fefffffffffffff), U64(0x0000000000000001), U64(0x405edd2f1a9fbe77)
+};
+
+// infinities and NaNs only for comparisons, since NaN results may differ in their payload
+static const std::vector<UINT64> s_singles_cmp = { 0x00000000, 0x3f800000, 0xbf800000, 0x7f800000, 0xff800000, 0x7fc00000 };
+static const std::vector<UINT64> s_doubles_cmp =
+{
+	U64(0x0000000000000000), U64(0x3ff0000000000000), U64(0xbff0000000000000),
+	U64(0x7ff0000000000000), U64(0xfff0000000000000), U64(0x7ff8000000000000)
+};
+
+// values every integer conversion can represent
+static const std::vector<UINT64> s_singles_int = { 0x00000000, 0x3fc00000, 0xbfc00000, 0x40200000, 0xc0200000, 0x3effffff, 0x406ccccd, 0x4e6e6b28, 0xce6e6b28 };
+static const std::vector<UINT64> s_doubles_int =
+{
+	U64(0x0000000000000000), U64(0x3ff8000000000000), U64(0xbff8000000000000), U64(0x4004000000000000),
+	U64(0xc004000000000000), U64(0x3fdffffffffffffe), U64(0x400d99999999999a), U64(0x41cdcd6500000000), U64(0xc1cdcd6500000000)
+};
+
+static const std::vector<UINT64> s_singles_positive = { 0x3f800000, 0x3fc00000, 0x40800000, 0x4f32d05e, 0x0da24260, 0x42f6e979 };
+static const std::vector<UINT64> s_doubles_positive =
+{
+	U64(0x3ff0000000000000), U64(0x3ff8000000000000), U64(0x4010000000000000),
+	U64(0x41e65a0bc0000000), U64(0x01a56e1fc2f8f359), U64(0x405edd2f1a9fbe77)
+};
+
+// integer comparisons leave U undefined, so COND_U and COND_NU are only
+// tested after floating point comparisons
+static const condition_t s_conditions[] =
+{
+	COND_Z, COND_NZ, COND_S, COND_NS, COND_C, COND_NC, COND_V, COND_NV,
+	COND_A, COND_BE, COND_G, COND_LE, COND_L, COND_GE
+};
+
+#define OP2(op)     [](instruction &inst, const parameter *p) { inst.op(p[0], p[1]); }
+#define OP3(op)     [](instruction &inst, const parameter *p) { inst.op(p[0], p[1], p[2]); }
+#define OP4(op)     [](instruction &inst, const parameter *p) { inst.op(p[0], p[1], p[2], p[3]); }
+#define CMP(op)     [](instruction &inst, const parameter *p) { inst.op(p[1], p[2]); }
+
+
+//-------------------------------------------------
+//  integer operations
+//-------------------------------------------------
+
+TEST(drcbe,add_sub)
+{
+	compare_backends([](test_block &test) {
+		test.operation("ADD", "lll", { s_ints, s_ints }, OP3(add));
+		test.operation("SUB", "lll", { s_ints, s_ints }, OP3(sub));
+		test.operation("CMP", "-ll", { s_ints, s_ints }, CMP(cmp));
+		test.operation("DADD", "qqq", { s_ints, s_ints }, OP3(dadd));
+		test.operation("DSUB", "qqq", { s_ints, s_ints }, OP3(dsub));
+		test.operation("DCMP", "-qq", { s_ints, s_ints }, CMP(dcmp));
+	});
+}
+
+TEST(drcbe,add_sub_carry)
+{
+	compare_backends([](test_block &test) {
+		test.operation("ADDC", "lll", { s_ints, s_ints }, OP3(addc), true);
+		test.operation("SUBB", "lll", { s_ints, s_ints }, OP3(subb), true);
+		test.operation("DADDC", "qqq", { s_ints, s_ints }, OP3(daddc), true);
+		test.operation("DSUBB", "qqq", { s_ints, s_ints }, OP3(dsubb), true);
+	});
+}
+
+TEST(drcbe,logical)
+{
+	compare_backends([](test_block &test) {
+		test.operation("AND", "lll", { s_ints, s_ints }, OP3(_and));
+		test.operation("OR", "lll", { s_ints, s_ints }, OP3(_or));
+		test.operation("XOR", "lll", { s_ints, s_ints }, OP3(_xor));
+		test.operation("TEST", "-ll", { s_ints, s_ints }, CMP(test));
+		test.operation("DAND", "qqq", { s_ints, s_ints }, OP3(dand));
+		test.operation("DOR", "qqq", { s_ints, s_ints }, OP3(dor));
+		test.operation("DXOR", "qqq", { s_ints, s_ints }, OP3(dxor));
+		test.operation("DTEST", "-qq", { s_ints, s_ints }, CMP(dtest));
+	});
+}
+
+TEST(drcbe,multiply)
+{
+	compare_backends([](test_block &test) {
+		test.operation("MULU", "lLll", { s_ints, s_ints }, [](instruction &inst, const parameter *p) { inst.mulu(p[0], p[3], p[1], p[2]); });
+		test.operation("MULS", "lLll", { s_ints, s_ints }, [](instruction &inst, const parameter *p) { inst.muls(p[0], p[3], p[1], p[2]); });
+		test.operation("MULS.low", "lll", { s_ints, s_ints }, [](instruction &inst, const parameter *p) { inst.muls(p[0], p[0], p[1], p[2]); });
+		test.operation("MULU.low", "lll", { s_ints, s_ints }, [](instruction &inst, const parameter *p) { inst.mulu(p[0], p[0], p[1], p[2]); });
+		test.operation("DMULU", "qQqq", { s_ints, s_ints }, [](instruction &inst, const parameter *p) { inst.dmulu(p[0], p[3], p[1], p[2]); });
+		test.operation("DMULS", "qQqq", { s_ints, s_ints }, [](instruction &inst, const parameter *p) { inst.dmuls(p[0], p[3], p[1], p[2]); });
+		test.operation("DMULU.low", "qqq", { s_ints, s_ints }, [](instruction &inst, const parameter *p) { inst.dmulu(p[0], p[0], p[1], p[2]); });
+		test.operation("DMULS.low", "qqq", { s_ints, s_ints }, [](instruction &inst, const parameter *p) { inst.dmuls(p[0], p[0], p[1], p[2]); });
+	});
+}
+
+TEST(drcbe,divide)
+{
+	// the most negative value divided by -1 overflows, which UML leaves undefined
+	std::vector<UINT64> divisors;
+	for (UINT64 value : s_ints)
+		if (UINT32(value) != 0xffffffff)
+			divisors.push_back(value);
+	std::vector<UINT64> ddivisors;
+	for (UINT64 value : s_ints)
+		if (value != U64(0xffffffffffffffff))
+			ddivisors.push_back(value);
+
+	compare_backends([&](test_block &test) {
+		test.operation("DIVU", "lLll", { s_ints, s_ints }, [](instruction &inst, const parameter *p) { inst.divu(p[0], p[3], p[1], p[2]); });
+		test.operation("DIVS", "lLll", { s_ints, divisors }, [](instruction &inst, const parameter *p) { inst.divs(p[0], p[3], p[1], p[2]); });
+		test.operation("DIVU.quot", "lll", { s_ints, s_ints }, [](instruction &inst, const parameter *p) { inst.divu(p[0], p[0], p[1], p[2]); });
+		test.operation("DDIVU", "qQqq", { s_ints, s_ints }, [](instruction &inst, const parameter *p) { inst.ddivu(p[0], p[3], p[1], p[2]); });
+		test.operation("DDIVS", "qQqq", { s_ints, ddivisors }, [](instruction &inst, const parameter *p) { inst.ddivs(p[0], p[3], p[1], p[2]); });
+		test.operation("DDIVS.quot", "qqq", { s_ints, ddivisors }, [](instruction &inst, const parameter *p) { inst.ddivs(p[0], p[0], p[1], p[2]); });
+	});
+}
+
+TEST(drcbe,shifts)
+{
+	compare_backends([](test_block &test) {
+		test.operation("SHL", "lll", { s_ints, s_shifts32 }, OP3(shl));
+		test.operation("SHR", "lll", { s_ints, s_shifts32 }, OP3(shr));
+		test.operation("SAR", "lll", { s_ints, s_shifts32 }, OP3(sar));
+		test.operation("ROL", "lll", { s_ints, s_shifts32 }, OP3(rol));
+		test.operation("ROR", "lll", { s_ints, s_shifts32 }, OP3(ror));
+		test.operation("DSHL", "qqq", { s_ints, s_shifts64 }, OP3(dshl));
+		test.operation("DSHR", "qqq", { s_ints, s_shifts64 }, OP3(dshr));
+		test.operation("DSAR", "qqq", { s_ints, s_shifts64 }, OP3(dsar));
+		test.operation("DROL", "qqq", { s_ints, s_shifts64 }, OP3(drol));
+		test.operation("DROR", "qqq", { s_ints, s_shifts64 }, OP3(dror));
+		test.operation("DROL.noflags", "qqq", { s_ints, s_shifts64 }, OP3(drol), false, false);
+	});
+}
+
+TEST(drcbe,rotates_through_carry)
+{
+	compare_backends([](test_block &test) {
+		test.operation("ROLC", "lll", { s_ints, s_shifts32 }, OP3(rolc), true);
+		test.operation("RORC", "lll", { s_ints, s_shifts32 }, OP3(rorc), true);
+		test.operation("DROLC", "qqq", { s_ints, s_shifts64 }, OP3(drolc), true);
+		test.operation("DRORC", "qqq", { s_ints, s_shifts64 }, OP3(drorc), true);
+		test.operation("RORC.noflags", "lll", { s_ints, s_shifts32 }, OP3(rorc), true, false);
+		test.operation("DROLC.noflags", "qqq", { s_ints, s_shifts64 }, OP3(drolc), true, false);
+	});
+}
+
+TEST(drcbe,bit_fields)
+{
+	static const std::vector<UINT64> masks = { 0, 0xff, 0xffff0000, 0x80000001, U64(0xffffffff00000000), U64(0x00ffff00ff0000ff), U64(0xffffffffffffffff) };
+	compare_backends([](test_block &test) {
+		test.operation("ROLAND", "llll", { s_ints, s_counts, masks }, OP4(roland));
+		test.operation("ROLINS", "llll", { s_ints, s_counts, masks }, OP4(rolins));
+		test.operation("DROLAND", "qqqq", { s_ints, s_counts, masks }, OP4(droland));
+		test.operation("DROLINS", "qqqq", { s_ints, s_counts, masks }, OP4(drolins));
+	});
+}
+
+TEST(drcbe,unary)
+{
+	compare_backends([](test_block &test) {
+		test.operation("MOV", "ll", { s_ints }, OP2(mov));
+		test.operation("LZCNT", "ll", { s_ints }, OP2(lzcnt));
+		test.operation("TZCNT", "ll", { s_ints }, OP2(tzcnt));
+		test.operation("BSWAP", "ll", { s_ints }, OP2(bswap));
+		test.operation("DMOV", "qq", { s_ints }, OP2(dmov));
+		test.operation("DLZCNT", "qq", { s_ints }, OP2(dlzcnt));
+		test.operation("DTZCNT", "qq", { s_ints }, OP2(dtzcnt));
+		test.operation("DBSWAP", "qq", { s_ints }, OP2(dbswap));
+		for (operand_size size = SIZE_BYTE; size <= SIZE_DWORD; size = operand_size(size + 1))
+		{
+			if (size != SIZE_DWORD)
+				test.operation("SEXT", "ll", { s_ints }, [size](instruction &inst, const parameter *p) { inst.sext(p[0], p[1], size); });
+			test.operation("DSEXT", "qq", { s_ints }, [size](instruction &inst, const parameter *p) { inst.dsext(p[0], p[1], size); });
+		}
+	});
+}
+
+TEST(drcbe,conditions)
+{
+	compare_backends([](test_block &test) {
+		// conditional sets, moves and jumps after every comparison
+		for (UINT64 value1 : s_ints)
+			for (UINT64 value2 : s_ints)
+			{
+				test.append().dmov(I1, test.input(value1));
+				test.append().dmov(I2, test.input(value2));
+				for (condition_t cond : s_conditions)
+				{
+					code_label skip = test.label();
+					test.append().dmov(I0, SENTINEL);
+					test.append().mov(I9, test.input(SENTINEL));
+					test.append().dcmp(I1, I2);
+					test.append().dmov(cond, I0, I1);
+					test.append().dset(cond, I3);
+					test.append().jmp(cond, skip);
+					test.append().dadd(I3, I3, 0x100);
+					test.append().label(skip);
+					test.append().cmp(I1, test.input(value2));
+					test.append().mov(cond, I9, I2);
+					test.append().set(cond, I4);
+					test.output(I0, 'q', string_format("DMOV %X %X,%X", cond, value1, value2));
+					test.output(I3, 'q', string_format("DSET/JMP %X %X,%X", cond, value1, value2));
+					test.output(I9, 'l', string_format("MOV %X %X,%X", cond, value1, value2));
+					test.output(I4, 'l', string_format("SET %X %X,%X", cond, value1, value2));
+				}
+			}
+		test.operation("CARRY", "-ll", { s_ints, s_counts }, [](instruction &inst, const parameter *p) { inst.carry(p[1], p[2]); });
+		test.operation("DCARRY", "-qq", { s_ints, s_counts }, [](instruction &inst, const parameter *p) { inst.dcarry(p[1], p[2]); });
+	});
+}
+
+
+//-------------------------------------------------
+//  memory operations
+//-------------------------------------------------
+
+TEST(drcbe,load_store)
+{
+	static const std::vector<UINT64> indexes = { 0, 1, 3, 7 };
+	static const std::vector<UINT64> data = { U64(0x0123456789abcdef), U64(0xfedcba9876543210), 0x80 };
+	compare_backends([](test_block &test) {
+		for (operand_size size = SIZE_BYTE; size <= SIZE_QWORD; size = operand_size(size + 1))
+			for (memory_scale scale = SCALE_x1; scale <= SCALE_x8; scale = memory_scale(scale + 1))
+			{
+				std::string name = string_format("%d.x%d", 1 << size, 1 << scale);
+				if (size != SIZE_QWORD)
+				{
+					test.operation(("LOAD" + name).c_str(), "ll", { indexes }, [size, scale](instruction &inst, const parameter *p) { inst.load(p[0], s_data->table, p[1], size, scale); });
+					test.operation(("LOADS" + name).c_str(), "ll", { indexes }, [size, scale](instruction &inst, const parameter *p) { inst.loads(p[0], s_data->table, p[1], size, scale); });
+				}
+				test.operation(("DLOAD" + name).c_str(), "qq", { indexes }, [size, scale](instruction &inst, const parameter *p) { inst.dload(p[0], s_data->table, p[1], size, scale); });
+				test.operation(("DLOADS" + name).c_str(), "qq", { indexes }, [size, scale](instruction &inst, const parameter *p) { inst.dloads(p[0], s_data->table, p[1], size, scale); });
+				if (size != SIZE_QWORD)
+					test.operation(("STORE" + name).c_str(), "-ll", { indexes, data }, [size, scale](instruction &inst, const parameter *p) { inst.store(&s_data->table[16], p[1], p[2], size, scale); });
+				test.operation(("DSTORE" + name).c_str(), "-qq", { indexes, data }, [size, scale](instruction &inst, const parameter *p) { inst.dstore(&s_data->table[32], p[1], p[2], size, scale); });
+			}
+	});
+}
+
+TEST(drcbe,read_write)
+{
+	static const std::vector<UINT64> addresses = { 0x0000, 0x0008, 0x1230, 0xfff0 };
+	static const std::vector<UINT64> data = { U64(0x0123456789abcdef), U64(0xfedcba9876543210) };
+	static const std::vector<UINT64> masks = { U64(0xffffffffffffffff), U64(0x00ff00ff00ff00ff), 0xffff0000 };
+	compare_backends([](test_block &test) {
+		for (operand_size size = SIZE_BYTE; size <= SIZE_QWORD; size = operand_size(size + 1))
+		{
+			std::string name = string_format("%d", 1 << size);
+			// there are no masked byte accesses
+			if (size != SIZE_QWORD)
+				test.operation(("READ" + name).c_str(), "ll", { addresses }, [size](instruction &inst, const parameter *p) { inst.read(p[0], p[1], size); });
+			if (size != SIZE_QWORD && size != SIZE_BYTE)
+				test.operation(("READM" + name).c_str(), "lll", { addresses, masks }, [size](instruction &inst, const parameter *p) { inst.readm(p[0], p[1], p[2], size); });
+			test.operation(("DREAD" + name).c_str(), "qq", { addresses }, [size](instruction &inst, const parameter *p) { inst.dread(p[0], p[1], size); });
+			if (size != SIZE_BYTE)
+				test.operation(("DREADM" + name).c_str(), "qqq", { addresses, masks }, [size](instruction &inst, const parameter *p) { inst.dreadm(p[0], p[1], p[2], size); });
+		}
+
+		// the writes go to separate pages so each one can be seen in the RAM afterwards
+		for (operand_size size = SIZE_BYTE; size <= SIZE_QWORD; size = operand_size(size + 1))
+		{
+			std::vector<UINT64> targets;
+			for (UINT64 address : addresses)
+				targets.push_back((address & 0x0fff) | ((size + 1) << 12));
+			std::vector<UINT64> mtargets;
+			for (UINT64 address : addresses)
+				mtargets.push_back((address & 0x0fff) | ((size + 8) << 12));
+
+			std::string name = string_format("%d", 1 << size);
+			if (size != SIZE_QWORD)
+				test.operation(("WRITE" + name).c_str(), "-ll", { targets, data }, [size](instruction &inst, const parameter *p) { inst.write(p[1], p[2], size); });
+			if (size != SIZE_QWORD && size != SIZE_BYTE)
+				test.operation(("WRITEM" + name).c_str(), "-lll", { mtargets, data, masks }, [size](instruction &inst, const parameter *p) { inst.writem(p[1], p[2], p[3], size); });
+			test.operation(("DWRITE" + name).c_str(), "-qq", { targets, data }, [size](instruction &inst, const parameter *p) { inst.dwrite(p[1], p[2], size); });
+			if (size != SIZE_BYTE)
+				test.operation(("DWRITEM" + name).c_str(), "-qqq", { mtargets, data, masks }, [size](instruction &inst, const parameter *p) { inst.dwritem(p[1], p[2], p[3], size); });
+		}
+
+		// floats through memory
+		test.operation("FSREAD", "sl", { addresses }, [](instruction &inst, const parameter *p) { inst.fsread(p[0], p[1], SPACE_PROGRAM); });
+		test.operation("FDREAD", "dl", { addresses }, [](instruction &inst, const parameter *p) { inst.fdread(p[0], p[1], SPACE_PROGRAM); });
+		test.operation("FSWRITE", "-ls", { { 0xe000, 0xe010 }, s_singles }, [](instruction &inst, const parameter *p) { inst.fswrite(p[1], p[2], SPACE_PROGRAM); });
+		test.operation("FDWRITE", "-ld", { { 0xe100, 0xe110 }, s_doubles }, [](instruction &inst, const parameter *p) { inst.fdwrite(p[1], p[2], SPACE_PROGRAM); });
+	});
+}
+
+
+//-------------------------------------------------
+//  floating point operations
+//-------------------------------------------------
+
+TEST(drcbe,float_arithmetic)
+{
+	compare_backends([](test_block &test) {
+		test.operation("FSADD", "sss", { s_singles, s_singles }, OP3(fsadd));
+		test.operation("FSSUB", "sss", { s_singles, s_singles }, OP3(fssub));
+		test.operation("FSMUL", "sss", { s_singles, s_singles }, OP3(fsmul));
+		test.operation("FSDIV", "sss", { s_singles, s_singles_positive }, OP3(fsdiv));
+		test.operation("FDADD", "ddd", { s_doubles, s_doubles }, OP3(fdadd));
+		test.operation("FDSUB", "ddd", { s_doubles, s_doubles }, OP3(fdsub));
+		test.operation("FDMUL", "ddd", { s_doubles, s_doubles }, OP3(fdmul));
+		test.operation("FDDIV", "ddd", { s_doubles, s_doubles_positive }, OP3(fddiv));
+	});
+}
+
+TEST(drcbe,float_unary)
+{
+	compare_backends([](test_block &test) {
+		test.operation("FSMOV", "ss", { s_singles }, OP2(fsmov));
+		test.operation("FSNEG", "ss", { s_singles }, OP2(fsneg));
+		test.operation("FSABS", "ss", { s_singles }, OP2(fsabs));
+		test.operation("FSSQRT", "ss", { s_singles_positive }, OP2(fssqrt));
+		test.operation("FSRECIP", "ss", { s_singles_positive }, OP2(fsrecip));
+		test.operation("FSRSQRT", "ss", { s_singles_positive }, OP2(fsrsqrt));
+		test.operation("FDMOV", "dd", { s_doubles }, OP2(fdmov));
+		test.operation("FDNEG", "dd", { s_doubles }, OP2(fdneg));
+		test.operation("FDABS", "dd", { s_doubles }, OP2(fdabs));
+		test.operation("FDSQRT", "dd", { s_doubles_positive }, OP2(fdsqrt));
+		test.operation("FDRECIP", "dd", { s_doubles_positive }, OP2(fdrecip));
+		test.operation("FDRSQRT", "dd", { s_doubles_positive }, OP2(fdrsqrt));
+		test.operation("FDRNDS", "dd", { s_doubles }, OP2(fdrnds));
+	});
+}
+
+TEST(drcbe,float_compare)
+{
+	compare_backends([](test_block &test) {
+		test.operation("FSCMP", "-ss", { s_singles_cmp, s_singles_cmp }, CMP(fscmp));
+		test.operation("FDCMP", "-dd", { s_doubles_cmp, s_doubles_cmp }, CMP(fdcmp));
+
+		// conditional moves on the result
+		for (UINT64 value1 : s_doubles_cmp)
+			for (UINT64 value2 : s_doubles_cmp)
+				for (condition_t cond : { COND_Z, COND_NZ, COND_C, COND_NC, COND_U, COND_NU, COND_A, COND_BE })
+				{
+					test.append().fdmov(F1, test.input(value1));
+					test.append().fdmov(F2, test.input(value2));
+					test.append().fdmov(F0, test.input(SENTINEL));
+					test.append().fsmov(F9, test.input(SENTINEL));
+					test.append().fdcmp(F1, F2);
+					test.append().fdmov(cond, F0, F1);
+					test.append().fsmov(cond, F9, F2);
+					test.output(F0, 'd', string_format("FDMOV %X %X,%X", cond, value1, value2));
+					test.output(F9, 's', string_format("FSMOV %X %X,%X", cond, value1, value2));
+				}
+	});
+}
+
+TEST(drcbe,float_conversions)
+{
+	static const std::vector<UINT64> ints = { 0, 1, 0x7fffffff, 0x80000000, 0xffffffff, U64(0x7fffffffffffffff), U64(0x8000000000000000), U64(0x0123456789abcdef), U64(0xfffffffffffffffe) };
+	compare_backends([](test_block &test) {
+		// the back-ends don't agree on the mode before the first SETFMOD
+		test.append().setfmod(ROUND_ROUND);
+		for (float_rounding_mode round = ROUND_TRUNC; round <= ROUND_DEFAULT; round = float_rounding_mode(round + 1))
+		{
+			test.operation(string_format("FSTOINT4.r%d", round).c_str(), "ls", { s_singles_int }, [round](instruction &inst, const parameter *p) { inst.fstoint(p[0], p[1], SIZE_DWORD, round); });
+			test.operation(string_format("FSTOINT8.r%d", round).c_str(), "qs", { s_singles_int }, [round](instruction &inst, const parameter *p) { inst.fstoint(p[0], p[1], SIZE_QWORD, round); });
+			test.operation(string_format("FDTOINT4.r%d", round).c_str(), "ld", { s_doubles_int }, [round](instruction &inst, const parameter *p) { inst.fdtoint(p[0], p[1], SIZE_DWORD, round); });
+			test.operation(string_format("FDTOINT8.r%d", round).c_str(), "qd", { s_doubles_int }, [round](instruction &inst, const parameter *p) { inst.fdtoint(p[0], p[1], SIZE_QWORD, round); });
+		}
+
+		// the default rounding follows the mode register
+		for (int mode = ROUND_TRUNC; mode <= ROUND_FLOOR; mode++)
+		{
+			test.append().setfmod(test.input(mode));
+			test.append().getfmod(I4);
+			test.output(I4, 'l', string_format("GETFMOD %d", mode));
+			test.operation("FDTOINT4.fmod", "ld", { s_doubles_int }, [](instruction &inst, const parameter *p) { inst.fdtoint(p[0], p[1], SIZE_DWORD, ROUND_DEFAULT); });
+			test.operation("FSTOINT8.fmod", "qs", { s_singles_int }, [](instruction &inst, const parameter *p) { inst.fstoint(p[0], p[1], SIZE_QWORD, ROUND_DEFAULT); });
+		}
+
+		// conversions without a rounding operand round to nearest; native
+		// back-ends also flush denormals, so those are left out
+		test.append().setfmod(ROUND_ROUND);
+		std::vector<UINT64> normals;
+		for (UINT64 value : s_singles)
+			if ((value & 0x7f800000) != 0 || (value & 0x007fffff) == 0)
+				normals.push_back(value);
+
+		test.operation("FSFRINT4", "sl", { ints }, [](instruction &inst, const parameter *p) { inst.fsfrint(p[0], p[1], SIZE_DWORD); });
+		test.operation("FSFRINT8", "sq", { ints }, [](instruction &inst, const parameter *p) { inst.fsfrint(p[0], p[1], SIZE_QWORD); });
+		test.operation("FDFRINT4", "dl", { ints }, [](instruction &inst, const parameter *p) { inst.fdfrint(p[0], p[1], SIZE_DWORD); });
+		test.operation("FDFRINT8", "dq", { ints }, [](instruction &inst, const parameter *p) { inst.fdfrint(p[0], p[1], SIZE_QWORD); });
+		test.operation("FSFRFLT", "sd", { s_doubles_int }, [](instruction &inst, const parameter *p) { inst.fsfrflt(p[0], p[1], SIZE_QWORD); });
+		test.operation("FDFRFLT", "ds", { normals }, [](instruction &inst, const parameter *p) { inst.fdfrflt(p[0], p[1], SIZE_DWORD); });
+		test.operation("FSCOPYI", "sl", { s_singles }, OP2(fscopyi));
+		test.operation("ICOPYFS", "ls", { s_singles }, OP2(icopyfs));
+		test.operation("FDCOPYI", "dq", { s_doubles }, OP2(fdcopyi));
+		test.operation("ICOPYFD", "qd", { s_doubles }, OP2(icopyfd));
+	});
+}
+
+
+//-------------------------------------------------
+//  control flow
+//-------------------------------------------------
+
+static void cfunc_clobber(void *param)
+{
+	// use enough of the host's caller-saved registers to clobber mapped ones
+	UINT64 *data = reinterpret_cast<UINT64 *>(param);
+	UINT64 sum[8] = { 0 };
+	for (int index = 0; index < 64; index++)
+		sum[index & 7] = sum[(index + 3) & 7] * 31 + data[index & 3] + index;
+	volatile double scale = 1.5;
+	for (int index = 0; index < 8; index++)
+		data[index & 3] += sum[index] + UINT64(scale * index);
+}
+
+TEST(drcbe,calls)
+{
+	compare_backends([](test_block &test) {
+		code_handle &sub = test.handle("sub");
+		code_handle &condsub = test.handle("condsub");
+		code_handle &exception = test.handle("exception");
+		parameter data = test.input(5);
+		test.input(6);
+		test.input(7);
+		test.input(8);
+
+		// every register survives calls out to C
+		for (int regnum = 0; regnum < REG_I_COUNT; regnum++)
+			test.append().dmov(parameter::make_ireg(REG_I0 + regnum), test.input(U64(0x0101010101010101) * (regnum + 1)));
+		for (int regnum = 0; regnum < REG_F_COUNT; regnum++)
+			test.append().fdmov(parameter::make_freg(REG_F0 + regnum), test.input(s_doubles[regnum]));
+		test.append().callc(cfunc_clobber, data.memory());
+		test.append().cmp(I0, I0);
+		test.append().callc(COND_NZ, cfunc_clobber, data.memory());
+		test.append().callc(COND_Z, cfunc_clobber, data.memory());
+		for (int regnum = 0; regnum < REG_I_COUNT; regnum++)
+			test.output(parameter::make_ireg(REG_I0 + regnum), 'q', string_format("I%d after CALLC", regnum));
+		for (int regnum = 0; regnum < REG_F_COUNT; regnum++)
+			test.output(parameter::make_freg(REG_F0 + regnum), 'd', string_format("F%d after CALLC", regnum));
+		for (int index = 0; index < 4; index++)
+			test.output(parameter::make_memory(reinterpret_cast<UINT64 *>(data.memory()) + index), 'q', string_format("CALLC data %d", index));
+
+		// registers used between calls, through a loop and past a branch
+		code_label loop = test.label();
+		code_label skip = test.label();
+		test.append().dmov(I5, test.input(U64(0x1111222233334444)));
+		test.append().dmov(I6, test.input(3));
+		test.append().dmov(I7, test.input(U64(0x5555666677778888)));
+		test.append().label(loop);
+		test.append().callc(cfunc_clobber, data.memory());
+		test.append().dadd(I5, I5, I6);
+		test.append().dread(I4, test.input(0x1230), SIZE_DWORD);
+		test.append().dxor(I7, I7, I4);
+		test.append().dsub(I6, I6, 1);
+		test.append().jmp(COND_NZ, loop);
+		test.append().dadd(I7, I7, I5);
+		test.append().dcmp(I7, I7);
+		test.append().jmp(COND_Z, skip);
+		test.append().dread(I6, test.input(0x0008), SIZE_WORD);     // skipped, but leaves registers in memory at the label
+		test.append().dadd(I7, I7, I6);
+		test.append().label(skip);
+		test.append().dsub(I5, I5, I7);
+		test.append().dwrite(0xe200, I5, SIZE_QWORD);
+		for (int regnum = 4; regnum < 8; regnum++)
+			test.output(parameter::make_ireg(REG_I0 + regnum), 'q', string_format("I%d after the call loop", regnum));
+
+		// subroutines, conditional calls and returns, and exceptions
+		test.append().mov(I0, 1);
+		test.append().mapvar(M0, 0x1234);
+		test.append().callh(sub);
+		test.output(I0, 'l', "after CALLH");
+		test.append().mapvar(M0, 0x5678);
+		test.append().cmp(I0, 2);
+		test.append().callh(COND_Z, condsub);
+		test.append().callh(COND_NZ, condsub);
+		test.output(I0, 'l', "after conditional CALLH");
+		test.output(I1, 'l', "RECOVER in conditional CALLH");
+		test.append().mov(I0, 0);
+		test.append().exh(exception, test.input(0xabcd));
+		test.append().cmp(I0, 1);
+		test.append().exh(COND_Z, exception, 0x1111);
+		test.append().exh(COND_NZ, exception, 0x2222);
+		test.append().getexp(I2);
+		test.output(I0, 'l', "EXH count");
+		test.output(I2, 'l', "EXP");
+
+		// conditional exits pick the return value
+		test.append().cmp(I0, 2);
+		test.append().exit(COND_NZ, 0x99);
+		test.append().exit(COND_Z, test.input(0x77));
+
+		test.append().handle(sub);
+		test.append().add(I0, I0, 1);
+		test.append().recover(I1, M0);
+		test.output(I1, 'l', "RECOVER in CALLH");
+		test.append().ret();
+
+		test.append().handle(condsub);
+		test.append().add(I0, I0, 0x10);
+		test.append().recover(I1, M0);
+		test.append().cmp(I0, 0x12);
+		test.append().ret(COND_Z);
+		test.append().add(I0, I0, 0x100);
+		test.append().ret();
+
+		test.append().handle(exception);
+		test.append().add(I0, I0, 1);
+		test.append().getexp(I3);
+		test.output(I3, 'l', "EXP in handler");
+		test.append().ret();
+	});
+}
+
+TEST(drcbe,hash_jumps)
+{
+	compare_backends([](test_block &test) {
+		code_handle &nocode = test.handle("nocode");
+		code_handle &next = test.handle("next");
+		code_handle &done = test.handle("done");
+
+		// jump through the hash tables with the mode and PC in registers and memory
+		test.append().mov(I5, 0);
+		test.append().dmov(I1, test.input(1));
+		test.append().dmov(I2, test.input(0x1000));
+		test.append().hashjmp(I1, I2, nocode);
+
+		test.append().hash(0, 0x1000);
+		test.append().add(I5, I5, 1);
+		test.append().hashjmp(1, test.input(0x2000), nocode);
+
+		test.append().hash(1, 0x1000);
+		test.append().add(I5, I5, 0x10);
+		test.append().hashjmp(0, 0x1000, nocode);
+
+		test.append().hash(1, 0x2000);
+		test.append().add(I5, I5, 0x100);
+		test.append().hashjmp(test.input(0), 0x3000, nocode);
+
+		// a PC with no code calls the handle with the PC in EXP
+		test.append().handle(nocode);
+		test.append().getexp(I3);
+		test.output(I3, 'l', "EXP from HASHJMP");
+		test.output(I5, 'l', "blocks run");
+		test.append().callh(next);
+		test.append().handle(next);
+		test.append().callh(done);
+		test.append().handle(done);
+		test.append().exit(I5);
+	});
+}
+
+TEST(drcbe,state)
+{
+	compare_backends([](test_block &test) {
+		for (int regnum = 0; regnum < REG_I_COUNT; regnum++)
+			test.append().dmov(parameter::make_ireg(REG_I0 + regnum), test.input(U64(0x1111111111111111) * regnum));
+		for (int regnum = 0; regnum < REG_F_COUNT; regnum++)
+			test.append().fdmov(parameter::make_freg(REG_F0 + regnum), test.input(s_doubles[regnum]));
+		test.append().setfmod(2);
+		test.append().cmp(I1, I2);
+		test.append().save(&s_data->saved);
+		for (int regnum = 0; regnum < REG_I_COUNT; regnum++)
+			test.output(parameter::make_memory(&s_data->saved.r[regnum].d), 'q', string_format("SAVE I%d", regnum));
+		for (int regnum = 0; regnum < REG_F_COUNT; regnum++)
+			test.output(parameter::make_memory(&s_data->saved.f[regnum].d), 'd', string_format("SAVE F%d", regnum));
+		test.append().load(I0, &s_data->saved.flags, 0, SIZE_BYTE, SCALE_x1);
+		test.output(I0, 'l', "SAVE flags");
+		test.append().load(I0, &s_data->saved.fmod, 0, SIZE_BYTE, SCALE_x1);
+		test.output(I0, 'l', "SAVE fmod");
+
+		// restore a state written by C
+		test.append().callc([](void *param) {
+			memset(&s_data->restored, 0, sizeof(s_data->restored));
+			for (int regnum = 0; regnum < REG_I_COUNT; regnum++)
+				s_data->restored.r[regnum].d = U64(0x0f0f0f0f0f0f0f0f) + regnum;
+			for (int regnum = 0; regnum < REG_F_COUNT; regnum++)
+				s_data->restored.f[regnum].d = 0.5 * regnum;
+			s_data->restored.flags = FLAG_C | FLAG_S;
+			s_data->restored.fmod = ROUND_FLOOR;
+			s_data->restored.exp = 0x4321;
+		}, nullptr);
+		test.append().restore(&s_data->restored);
+		for (int regnum = 0; regnum < REG_I_COUNT; regnum++)
+			test.output(parameter::make_ireg(REG_I0 + regnum), 'q', string_format("RESTORE I%d", regnum));
+		for (int regnum = 0; regnum < REG_F_COUNT; regnum++)
+			test.output(parameter::make_freg(REG_F0 + regnum), 'd', string_format("RESTORE F%d", regnum));
+		test.output_flags(FLAG_C | FLAG_V | FLAG_Z | FLAG_S | FLAG_U, "RESTORE");
+		test.append().getfmod(I0);
+		test.output(I0, 'l', "RESTORE fmod");
+	});
+}
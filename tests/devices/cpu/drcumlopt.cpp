@@ -0,0 +1,150 @@
+#include "gtest/gtest.h"
+#include "emu.h"
+#include "cpu/drcuml.h"
+#include "cpu/drcumlopt.h"
+
+using namespace uml;
+
+static UINT32 optimize(std::vector<instruction> &block)
+{
+	drcuml_optimizer optimizer;
+	return optimizer.optimize(&block[0], block.size());
+}
+
+TEST(drcumlopt,dead_flags_trimmed)
+{
+	std::vector<instruction> block(4);
+	block[0].add(I0, I0, I1);
+	block[1].sub(I2, I2, 1);
+	block[2].exit(COND_Z, 0);
+	block[3].exit(0);
+	optimize(block);
+
+	// the add's flags are overwritten by the sub before anyone reads them
+	EXPECT_EQ(0, block[0].flags());
+	EXPECT_EQ(FLAG_Z, block[1].flags());
+}
+
+TEST(drcumlopt,flags_follow_backward_branches)
+{
+	code_label loop(1);
+	std::vector<instruction> block(5);
+	block[0].jmp(loop);
+	block[1].sub(I0, I0, 1);
+	block[2].label(loop);
+	block[3].jmp(COND_C, loop);
+	block[4].exit(0);
+	optimize(block);
+
+	// the carry is read at the label, which is reached from the sub
+	EXPECT_EQ(FLAG_C, block[1].flags());
+}
+
+TEST(drcumlopt,constants_fold)
+{
+	std::vector<instruction> block(4);
+	block[0].mov(I0, 5);
+	block[1].add(I1, I0, 3);
+	block[2].shl(I2, I1, 2);
+	block[3].exit(I2);
+	UINT32 count = optimize(block);
+
+	ASSERT_EQ(4, count);
+	EXPECT_EQ(OP_MOV, block[2].opcode());
+	EXPECT_TRUE(block[2].param(1).is_immediate_value(32));
+	EXPECT_TRUE(block[3].param(0).is_int_register());
+}
+
+TEST(drcumlopt,constants_respect_size)
+{
+	std::vector<instruction> block(3);
+	block[0].mov(I0, 5);
+	block[1].dadd(I1, I0, 3);
+	block[2].exit(I1);
+	optimize(block);
+
+	// only the low half of I0 is known, so the 64-bit add must stay
+	EXPECT_EQ(OP_ADD, block[1].opcode());
+	EXPECT_TRUE(block[1].param(1).is_int_register());
+}
+
+TEST(drcumlopt,constants_stop_at_labels)
+{
+	code_label target(1);
+	std::vector<instruction> block(4);
+	block[0].mov(I0, 5);
+	block[1].label(target);
+	block[2].add(I1, I0, 3);
+	block[3].exit(I1);
+	optimize(block);
+
+	EXPECT_EQ(OP_ADD, block[2].opcode());
+}
+
+TEST(drcumlopt,loads_forwarded)
+{
+	UINT32 slot;
+	std::vector<instruction> block(4);
+	block[0].mov(mem(&slot), I0);
+	block[1].mov(I1, mem(&slot));
+	block[2].mov(mem(&slot), I0);
+	block[3].exit(I1);
+	UINT32 count = optimize(block);
+
+	// the load becomes a register move and the second store goes away
+	ASSERT_EQ(3, count);
+	EXPECT_EQ(OP_MOV, block[1].opcode());
+	EXPECT_TRUE(block[1].param(1).is_int_register());
+	EXPECT_EQ(OP_EXIT, block[2].opcode());
+}
+
+TEST(drcumlopt,loads_not_forwarded_past_calls)
+{
+	UINT32 slot;
+	std::vector<instruction> block(4);
+	block[0].mov(mem(&slot), I0);
+	block[1].callc([](void *) { }, nullptr);
+	block[2].mov(I1, mem(&slot));
+	block[3].exit(I1);
+	optimize(block);
+
+	EXPECT_TRUE(block[2].param(1).is_memory());
+}
+
+TEST(drcumlopt,dead_moves_removed)
+{
+	std::vector<instruction> block(3);
+	block[0].mov(I0, I1);
+	block[1].mov(I0, I2);
+	block[2].exit(I0);
+	UINT32 count = optimize(block);
+
+	ASSERT_EQ(2, count);
+	EXPECT_TRUE(block[0].param(1) == I2);
+}
+
+TEST(drcumlopt,moves_kept_before_divide)
+{
+	std::vector<instruction> block(3);
+	block[0].mov(I0, I1);
+	block[1].divu(I0, I0, I2, I3);
+	block[2].exit(I0);
+	UINT32 count = optimize(block);
+
+	// a zero divisor leaves I0 as the move set it
+	EXPECT_EQ(3, count);
+}
+
+TEST(drcumlopt,stats_counted)
+{
+	std::vector<instruction> block(3);
+	block[0].mov(I0, 7);
+	block[1].add(I1, I0, 1);
+	block[2].exit(I1);
+
+	drcuml_optimizer optimizer;
+	optimizer.optimize(&block[0], block.size());
+	EXPECT_EQ(1, optimizer.block_stats().consts_propagated);
+	EXPECT_EQ(1, optimizer.block_stats().consts_folded);
+	EXPECT_EQ(1, optimizer.total_stats().blocks);
+}
@@ -0,0 +1,104 @@
+#include "gtest/gtest.h"
+#include "testmachine.h"
+#include "cpu/m68000/m68000.h"
+
+// Runs a small 68000 program on the recompiler with -drc_verify, so every
+// stretch of recompiled and interpreted code is replayed on the
+// interpreter.  The program takes Line-A and illegal instruction
+// exceptions in the middle of runs the recompiler hands to the
+// interpreter, and the handlers record the PC they find stacked.
+
+// a 68000 the test can start and run without the scheduler
+class test_m68000_device : public m68000_device
+{
+public:
+	test_m68000_device(const machine_config &mconfig, const char *tag, device_t *owner, UINT32 clock)
+		: m68000_device(mconfig, tag, owner, clock, "test_m68000", __FILE__) { }
+
+	using device_t::start;
+
+	void run(int cycles)
+	{
+		remaining_cycles = cycles;
+		execute_run();
+	}
+};
+
+static const device_type TEST_M68000 = &device_creator<test_m68000_device>;
+
+static ADDRESS_MAP_START( test_map, AS_PROGRAM, 16, driver_device )
+	AM_RANGE(0x000000, 0x00ffff) AM_RAM
+ADDRESS_MAP_END
+
+static MACHINE_CONFIG_START( test_m68kdrc, driver_device )
+	MCFG_CPU_ADD("maincpu", TEST_M68000, 8000000)
+	MCFG_CPU_PROGRAM_MAP(test_map)
+MACHINE_CONFIG_END
+
+ROM_START( testm68k )
+ROM_END
+
+GAME( 2016, testm68k, 0, test_m68kdrc, 0, driver_device, 0, ROT0, "MAME", "680x0 recompiler tests", MACHINE_NO_SOUND_HW )
+
+struct program_word
+{
+	offs_t  address;
+	UINT16  data;
+};
+
+static const program_word s_program[] =
+{
+	// vectors: stack, reset, illegal instruction, Line-A
+	{ 0x0000, 0x0000 }, { 0x0002, 0x8000 },
+	{ 0x0004, 0x0000 }, { 0x0006, 0x0400 },
+	{ 0x0010, 0x0000 }, { 0x0012, 0x0700 },
+	{ 0x0028, 0x0000 }, { 0x002a, 0x0600 },
+
+	// main loop; ABCD and the exceptions are interpreted, the rest is native
+	{ 0x0400, 0x7001 },                     // moveq   #1,d0
+	{ 0x0402, 0x7200 },                     // moveq   #0,d1
+	{ 0x0404, 0xc300 },                     // abcd    d0,d1
+	{ 0x0406, 0xa123 },                     // Line-A
+	{ 0x0408, 0xc300 },                     // abcd    d0,d1
+	{ 0x040a, 0x5282 },                     // addq.l  #1,d2
+	{ 0x040c, 0x4afc },                     // illegal
+	{ 0x040e, 0x5283 },                     // addq.l  #1,d3
+	{ 0x0410, 0x60ee },                     // bra.s   $400
+
+	// Line-A handler: note the stacked PC and step over the instruction
+	{ 0x0600, 0x2e2f }, { 0x0602, 0x0002 }, // move.l  2(a7),d7
+	{ 0x0604, 0x54af }, { 0x0606, 0x0002 }, // addq.l  #2,2(a7)
+	{ 0x0608, 0x5286 },                     // addq.l  #1,d6
+	{ 0x060a, 0x4e73 },                     // rte
+
+	// illegal instruction handler, likewise
+	{ 0x0700, 0x2a2f }, { 0x0702, 0x0002 }, // move.l  2(a7),d5
+	{ 0x0704, 0x54af }, { 0x0706, 0x0002 }, // addq.l  #2,2(a7)
+	{ 0x0708, 0x5284 },                     // addq.l  #1,d4
+	{ 0x070a, 0x4e73 }                      // rte
+};
+
+TEST(m68kdrc,exceptions_in_interpreted_runs)
+{
+	test_machine machine(GAME_NAME(testm68k));
+	std::string error;
+	machine.m_options.set_value(OPTION_DRC_EXPERIMENTAL, 1, OPTION_PRIORITY_CMDLINE, error);
+	machine.m_options.set_value(OPTION_DRC_VERIFY, 1, OPTION_PRIORITY_CMDLINE, error);
+
+	test_m68000_device &cpu = downcast<test_m68000_device &>(*machine.m_machine.root_device().subdevice("maincpu"));
+	address_space &space = cpu.space(AS_PROGRAM);
+	for (const program_word &word : s_program)
+		space.write_word(word.address, word.data);
+
+	// a mismatch against the interpreter is a fatal error
+	cpu.start();
+	cpu.reset();
+	for (int slice = 0; slice < 100; slice++)
+		cpu.run(1000);
+
+	// both exceptions stack the address of the instruction that caused them
+	EXPECT_EQ(0x0406, cpu.state_int(M68K_D7));
+	EXPECT_EQ(0x040c, cpu.state_int(M68K_D5));
+	EXPECT_NE(0, cpu.state_int(M68K_D6));
+	EXPECT_NE(0, cpu.state_int(M68K_D4));
+}
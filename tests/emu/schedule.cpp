@@ -0,0 +1,201 @@
+#include "gtest/gtest.h"
+#include "testmachine.h"
+#include "cpu/m68000/m68000.h"
+
+// Runs two 68000s through the scheduler, once in order and once with the
+// second in its own execute group, and checks that both ways end up in the
+// same place.  Groups whose spaces share RAM must not run in parallel.
+
+// a 68000 the test can start without the rest of the machine
+class sched_m68000_device : public m68000_device
+{
+public:
+	sched_m68000_device(const machine_config &mconfig, const char *tag, device_t *owner, UINT32 clock)
+		: m68000_device(mconfig, tag, owner, clock, "sched_m68000", __FILE__) { }
+
+	using device_t::start;
+};
+
+static const device_type SCHED_M68000 = &device_creator<sched_m68000_device>;
+
+static ADDRESS_MAP_START( test_map, AS_PROGRAM, 16, driver_device )
+	AM_RANGE(0x000000, 0x00ffff) AM_RAM
+ADDRESS_MAP_END
+
+static MACHINE_CONFIG_START( test_sched, driver_device )
+	MCFG_CPU_ADD("cpu1", SCHED_M68000, 8000000)
+	MCFG_CPU_PROGRAM_MAP(test_map)
+	MCFG_CPU_ADD("cpu2", SCHED_M68000, 10000000)
+	MCFG_CPU_PROGRAM_MAP(test_map)
+MACHINE_CONFIG_END
+
+ROM_START( testsched )
+ROM_END
+
+GAME( 2016, testsched, 0, test_sched, 0, driver_device, 0, ROT0, "MAME", "Scheduler tests", MACHINE_NO_SOUND_HW )
+
+static const UINT16 s_program[] =
+{
+	0x0000, 0x8000,                         // initial stack
+	0x0000, 0x0400,                         // reset vector
+};
+
+static const UINT16 s_loop[] =
+{
+	0x5280,                                 // addq.l  #1,d0
+	0x21c0, 0x1000,                         // move.l  d0,($1000).w
+	0x60f8                                  // bra.s   $400
+};
+
+struct sched_test
+{
+	sched_test(int group)
+		: m_machine(GAME_NAME(testsched)),
+			m_cpu1(downcast<sched_m68000_device &>(*m_machine.m_machine.root_device().subdevice("cpu1"))),
+			m_cpu2(downcast<sched_m68000_device &>(*m_machine.m_machine.root_device().subdevice("cpu2")))
+	{
+		for (sched_m68000_device *cpu : { &m_cpu1, &m_cpu2 })
+		{
+			address_space &space = cpu->space(AS_PROGRAM);
+			for (int index = 0; index < ARRAY_LENGTH(s_program); index++)
+				space.write_word(index * 2, s_program[index]);
+			for (int index = 0; index < ARRAY_LENGTH(s_loop); index++)
+				space.write_word(0x400 + index * 2, s_loop[index]);
+		}
+		device_execute_interface::static_set_parallel_group(m_cpu2, group);
+
+		// a periodic timer ends each timeslice
+		m_machine.m_machine.scheduler().timer_alloc(timer_expired_delegate())->adjust(attotime::from_hz(1000), 0, attotime::from_hz(1000));
+		m_cpu1.start();
+		m_cpu2.start();
+		m_cpu1.reset();
+		m_cpu2.reset();
+	}
+
+	void run(int slices)
+	{
+		for (int slice = 0; slice < slices; slice++)
+			m_machine.m_machine.scheduler().timeslice();
+	}
+
+	test_machine            m_machine;
+	sched_m68000_device &   m_cpu1;
+	sched_m68000_device &   m_cpu2;
+};
+
+TEST(schedule,parallel_matches_serial)
+{
+	sched_test serial(0);
+	serial.run(100);
+
+	sched_test parallel(1);
+	parallel.run(100);
+	EXPECT_TRUE(parallel.m_machine.m_machine.memory().parallel_sharing_allowed());
+
+	EXPECT_NE(0, serial.m_cpu1.state_int(M68K_D0));
+	EXPECT_EQ(serial.m_cpu1.state_int(M68K_D0), parallel.m_cpu1.state_int(M68K_D0));
+	EXPECT_EQ(serial.m_cpu2.state_int(M68K_D0), parallel.m_cpu2.state_int(M68K_D0));
+	EXPECT_EQ(serial.m_cpu1.total_cycles(), parallel.m_cpu1.total_cycles());
+	EXPECT_EQ(serial.m_cpu2.total_cycles(), parallel.m_cpu2.total_cycles());
+	EXPECT_EQ(serial.m_machine.m_machine.time(), parallel.m_machine.m_machine.time());
+}
+
+TEST(schedule,shared_ram_runs_in_order)
+{
+	sched_test test(1);
+
+	// the same RAM in both spaces; opcode fetches from it could not be trapped
+	std::vector<UINT16> shared(0x800);
+	test.m_cpu1.space(AS_PROGRAM).install_ram(0x20000, 0x20fff, &shared[0]);
+	test.m_cpu2.space(AS_PROGRAM).install_ram(0x20000, 0x20fff, &shared[0]);
+	test.run(10);
+	EXPECT_FALSE(test.m_machine.m_machine.memory().parallel_sharing_allowed());
+	EXPECT_NE(0, test.m_cpu2.state_int(M68K_D0));
+}
+
+// Timers are kept in a heap ordered by expiration time.  Timers that expire
+// together fire in the order they were last queued, and disabled timers sort
+// after every enabled one.
+
+struct timer_log
+{
+	void fired(void *ptr, INT32 param) { m_order.push_back(param); }
+
+	emu_timer *alloc(device_scheduler &scheduler) { return scheduler.timer_alloc(timer_expired_delegate(FUNC(timer_log::fired), this)); }
+
+	std::vector<int> m_order;
+};
+
+TEST(schedule,timers_equal_expiry_in_queue_order)
+{
+	sched_test test(0);
+	device_scheduler &scheduler = test.m_machine.m_machine.scheduler();
+	timer_log log;
+
+	// allocated in one order, queued in another, with other times mixed in
+	emu_timer *timers[8];
+	for (auto &timer : timers)
+		timer = log.alloc(scheduler);
+	for (int index = 7; index >= 0; index--)
+	{
+		timers[index]->adjust(attotime::from_usec(100), 7 - index);
+		log.alloc(scheduler)->adjust(attotime::from_usec(50 + 100 * (index & 1)), 10 + index);
+	}
+	test.run(10);
+
+	std::vector<int> const expected = { 16, 14, 12, 10, 0, 1, 2, 3, 4, 5, 6, 7, 17, 15, 13, 11 };
+	EXPECT_EQ(expected, log.m_order);
+}
+
+TEST(schedule,timers_adjust_requeues)
+{
+	sched_test test(0);
+	device_scheduler &scheduler = test.m_machine.m_machine.scheduler();
+	timer_log log;
+
+	emu_timer *timers[4];
+	for (int index = 0; index < 4; index++)
+		(timers[index] = log.alloc(scheduler))->adjust(attotime::from_usec((index == 3) ? 50 : 100), index);
+	EXPECT_EQ(timers[3], scheduler.next_timer());
+
+	// the same expiration again moves a timer behind its equals
+	timers[0]->adjust(attotime::from_usec(100), 0);
+
+	// a later one moves it behind everything else
+	timers[3]->adjust(attotime::from_usec(200), 3);
+	EXPECT_EQ(timers[1], scheduler.next_timer());
+
+	// and an earlier one to the front
+	timers[2]->adjust(attotime::from_usec(80), 2);
+	EXPECT_EQ(timers[2], scheduler.next_timer());
+	test.run(10);
+
+	std::vector<int> const expected = { 2, 1, 0, 3 };
+	EXPECT_EQ(expected, log.m_order);
+}
+
+TEST(schedule,timers_disabled_at_back)
+{
+	sched_test test(0);
+	device_scheduler &scheduler = test.m_machine.m_machine.scheduler();
+	timer_log log;
+
+	emu_timer *timers[4];
+	for (int index = 0; index < 4; index++)
+		(timers[index] = log.alloc(scheduler))->adjust(attotime::from_usec(10 * (index + 1)), index);
+
+	// disabling the earliest timers leaves the first enabled one at the front
+	timers[0]->enable(false);
+	timers[1]->enable(false);
+	EXPECT_EQ(timers[2], scheduler.next_timer());
+
+	// re-enabling one brings it back, still at its own expiration time
+	timers[1]->enable(true);
+	EXPECT_EQ(timers[1], scheduler.next_timer());
+	test.run(10);
+
+	std::vector<int> const expected = { 1, 2, 3 };
+	EXPECT_EQ(expected, log.m_order);
+	EXPECT_FALSE(timers[0]->enabled());
+	EXPECT_NE(timers[0], scheduler.next_timer());
+}
@@ -0,0 +1,36 @@
+#include "testmachine.h"
+#include "drivenum.h"
+#include "xmlfile.h"
+
+GAME_EXTERN(testarm7);
+GAME_EXTERN(testdrc);
+GAME_EXTERN(testm68k);
+GAME_EXTERN(testsched);
+
+// the test binary's driver list, normally generated by makelist.py; keep
+// it sorted by name
+const game_driver * const driver_list::s_drivers_sorted[4] =
+{
+	&GAME_NAME(testarm7),
+	&GAME_NAME(testdrc),
+	&GAME_NAME(testm68k),
+	&GAME_NAME(testsched)
+};
+
+int driver_list::s_driver_count = 4;
+
+// the test binary stands alone, with no frontend
+int emulator_info::start_frontend(emu_options &options, osd_interface &osd, int argc, char *argv[]) { return 0; }
+const char * emulator_info::get_bare_build_version() { return nullptr; }
+const char * emulator_info::get_build_version() { return nullptr; }
+void emulator_info::display_ui_chooser(running_machine& machine) { }
+void emulator_info::draw_user_interface(running_machine& machine) { }
+void emulator_info::periodic_check() { }
+bool emulator_info::frame_hook() { return false; }
+void emulator_info::layout_file_cb(xml_data_node &layout) { }
+const char * emulator_info::get_appname() { return nullptr; }
+const char * emulator_info::get_appname_lower() { return "mametests"; }
+const char * emulator_info::get_configname() { return nullptr; }
+const char * emulator_info::get_copyright() { return nullptr; }
+const char * emulator_info::get_copyright_info() { return nullptr; }
+bool emulator_info::standalone() { return true; }
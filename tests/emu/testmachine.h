@@ -0,0 +1,57 @@
+#pragma once
+
+#ifndef __TESTMACHINE_H__
+#define __TESTMACHINE_H__
+
+#include "emu.h"
+#include "emuopts.h"
+#include "osdepend.h"
+#include "main.h"
+
+// A running_machine for tests that need devices.  Only the memory system
+// is brought up; tests start and run the devices they use themselves.
+
+// nothing here talks to the OSD; the devices only need the machine
+class test_osd : public osd_interface
+{
+public:
+	virtual void init(running_machine &machine) override { }
+	virtual void update(bool skip_redraw) override { }
+	virtual void init_debugger() override { }
+	virtual void wait_for_debugger(device_t &device, bool firststop) override { }
+	virtual void update_audio_stream(const INT16 *buffer, int samples_this_frame) override { }
+	virtual void set_mastervolume(int attenuation) override { }
+	virtual bool no_sound() override { return true; }
+	virtual void customize_input_type_list(simple_list<input_type_entry> &typelist) override { }
+	virtual void add_audio_to_recording(const INT16 *buffer, int samples_this_frame) override { }
+	virtual std::vector<ui::menu_item> get_slider_list() override { return std::vector<ui::menu_item>(); }
+	virtual osd_font::ptr font_alloc() override { return nullptr; }
+	virtual bool get_font_families(std::string const &font_path, std::vector<std::pair<std::string, std::string> > &result) override { return false; }
+	virtual bool execute_command(const char *command) override { return false; }
+	virtual osd_midi_device *create_midi_device() override { return nullptr; }
+};
+
+class test_manager : public machine_manager
+{
+public:
+	test_manager(emu_options &options, osd_interface &osd) : machine_manager(options, osd) { }
+};
+
+struct test_machine
+{
+	test_machine(const game_driver &driver)
+		: m_manager(m_options, m_osd),
+			m_config(driver, m_options),
+			m_machine(m_config, m_manager)
+	{
+		m_machine.memory().initialize();
+	}
+
+	test_osd            m_osd;
+	emu_options         m_options;
+	test_manager        m_manager;
+	machine_config      m_config;
+	running_machine     m_machine;
+};
+
+#endif  /* __TESTMACHINE_H__ */